@@ -0,0 +1,634 @@
+#include "bench.h"
+#include "kernels.h"  // Para os kernels e o motor de ponto flutuante
+#include "metrics.h"  // Para detect_cpu_count
+#include "utils.h"    // Para now_sec, thread_create, thread_pin_self
+#include "pages.h"    // Para region_alloc, region_free
+#include "topology.h" // Para topology_detect, topology_place
+
+/**
+ * @struct bench_case_t
+ * @brief Um caso da suíte: kernel, conjunto de trabalho por thread e métrica.
+ */
+typedef struct {
+    const char *name;       ///< Nome estável do caso, usado para casar com a base.
+    int kernel;             ///< `kernel_id_t`.
+    size_t bytes;           ///< Conjunto de trabalho por thread (0 = só registradores).
+    int param;              ///< FPU: 1 = bloco em cache; STREAM: `stream_op_t`; PTR: número de cadeias.
+    const char *unit;       ///< Unidade da métrica.
+    int higher_is_better;   ///< 1 para vazões; 0 para latências.
+    double scale;           ///< Vazão: unidade por trabalho/s; latência: unidade por segundo/trabalho.
+} bench_case_t;
+
+/** @brief A suíte, em ordem de execução; os nomes são estáveis entre versões. */
+static const bench_case_t BENCH_CASES[] = {
+    { "fpu.reg",           KERNEL_FPU,    0,            0,            "GFLOP/s",   1, 1e-9 },
+    { "fpu.l1",            KERNEL_FPU,    16u << 10,    1,            "GFLOP/s",   1, 1e-9 },
+    { "fpu.l2",            KERNEL_FPU,    512u << 10,   1,            "GFLOP/s",   1, 1e-9 },
+    { "int.l1",            KERNEL_INT,    32u << 10,    0,            "Gops/s",    1, 1e-9 },
+    { "int.l2",            KERNEL_INT,    512u << 10,   0,            "Gops/s",    1, 1e-9 },
+    { "stream.triad.l2",   KERNEL_STREAM, 768u << 10,   STREAM_TRIAD, "GB/s",      1, 1e-9 },
+    { "stream.copy.dram",  KERNEL_STREAM, 192u << 20,   STREAM_COPY,  "GB/s",      1, 1e-9 },
+    { "stream.triad.dram", KERNEL_STREAM, 192u << 20,   STREAM_TRIAD, "GB/s",      1, 1e-9 },
+    { "ptr.lat.l2",        KERNEL_PTR,    256u << 10,   1,            "ns/carga",  0, 1e9 },
+    { "ptr.lat.dram",      KERNEL_PTR,    128u << 20,   1,            "ns/carga",  0, 1e9 },
+    { "ptr.mlp.dram",      KERNEL_PTR,    128u << 20,   8,            "Mcargas/s", 1, 1e-6 },
+};
+#define BENCH_CASE_COUNT ((int)(sizeof(BENCH_CASES) / sizeof(BENCH_CASES[0])))
+
+/** @brief Repetições do `kernel_int` por unidade de trabalho, como no worker. */
+#define BENCH_INT_ITERS 4
+
+/**
+ * @struct bench_run_t
+ * @brief Estado compartilhado entre a thread principal e as threads de um caso.
+ */
+typedef struct {
+    const bench_case_t *bc; ///< O caso em execução.
+    const fp_engine_t *fp;  ///< Motor de ponto flutuante.
+    GMutex mutex;           ///< Protege a barreira.
+    GCond cond;             ///< Libera as threads que esperam na barreira.
+    unsigned generation;    ///< Incrementado a cada abertura da barreira.
+    int arrived;            ///< Threads que já chegaram à barreira corrente.
+    int parties;            ///< Threads do caso mais a principal.
+    int quit;               ///< 1 quando as threads devem terminar (lido após a barreira).
+    unsigned long long units; ///< Unidades de trabalho por repetição (lido após a barreira).
+} bench_run_t;
+
+/**
+ * @struct bench_thread_t
+ * @brief Os buffers e o resultado de uma thread de um caso.
+ */
+typedef struct {
+    bench_run_t *run;       ///< Estado compartilhado.
+    int cpu;                ///< CPU em que a thread é fixada (-1 = livre).
+    mem_region_t region;    ///< Conjunto de trabalho.
+    double *x, *y;          ///< Bloco do FPU.
+    double *a, *b, *c;      ///< Arrays do STREAM.
+    uint64_t *ints;         ///< Buffer do kernel INT.
+    uint32_t *idx;          ///< Ciclo da perseguição de ponteiro.
+    size_t n;               ///< Elementos de cada vetor acima (nós, no caso do ciclo).
+    int passes;             ///< Passagens sobre o bloco do FPU por unidade.
+    uint32_t pos[PTR_MAX_CHAINS]; ///< Posições das cadeias.
+    double fp_state[FP_CHAINS * 8]; ///< Estado das cadeias de FMA em registradores.
+    int failed;             ///< 1 se a preparação falhou.
+    uint64_t work;          ///< Trabalho da última repetição (FLOPs, operações, bytes ou passos).
+    double end;             ///< Instante em que a thread terminou a última repetição.
+} bench_thread_t;
+
+/* --- Static Function Prototypes --- */
+static void print_usage(const char *prog);
+static int parse_int_opt(const char *s, int min, int max, int *out);
+static int parse_thread_counts(bench_opts_t *o, const char *list);
+static int cmp_double(const void *a, const void *b);
+static void barrier_wait(bench_run_t *r);
+static int setup_thread(bench_thread_t *t);
+static uint64_t run_unit(bench_thread_t *t);
+static thread_return_t THREAD_CALL bench_thread_main(void *arg);
+static double run_rep(bench_run_t *r, bench_thread_t *th, int threads, double *value);
+static int run_case(const bench_case_t *bc, const fp_engine_t *fp, int threads, const int *cpus,
+                    const bench_opts_t *o, bench_score_t *out);
+static const char *json_value(const char *line, const char *key);
+static const bench_score_t *find_score(const bench_score_t *s, int n, const char *name, int threads);
+static int compare_baseline(const bench_opts_t *o, const bench_score_t *cur, int n);
+
+/* --- Análise de Argumentos --- */
+
+int bench_requested(int argc, char **argv){
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench") == 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Imprime a ajuda do modo `--bench` e a lista de casos.
+ */
+static void print_usage(const char *prog){
+    printf("Uso: %s --bench [opções]\n"
+           "      --reps N         Repetições medidas por caso (padrão 10)\n"
+           "      --warmup N       Repetições de aquecimento por caso (padrão 2)\n"
+           "      --rep-ms MS      Duração alvo de cada repetição (padrão 100)\n"
+           "      --threads LISTA  Contagens de threads, por exemplo 1,4,all (padrão 1,all)\n"
+           "      --filter TEXTO   Executa só os casos cujo nome contém TEXTO\n"
+           "      --quick          Atalho para --reps 5 --warmup 1 --rep-ms 50\n"
+           "      --out ARQUIVO    Grava as pontuações em JSON Lines\n"
+           "      --baseline ARQ   Compara com um arquivo de pontuação anterior\n"
+           "      --threshold PCT  Piora, em %%, marcada como regressão (padrão 5)\n"
+           "  -h, --help           Mostra esta ajuda\n"
+           "Casos:", prog);
+    for (int i = 0; i < BENCH_CASE_COUNT; i++) printf(" %s", BENCH_CASES[i].name);
+    printf("\n");
+}
+
+/**
+ * @brief Converte uma string decimal em `int` dentro de [min, max].
+ * @return 0 em caso de sucesso, -1 se a string for inválida ou estiver fora do intervalo.
+ */
+static int parse_int_opt(const char *s, int min, int max, int *out){
+    if (!s || *s == '\0') return -1;
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (*end != '\0' || v < min || v > max) return -1;
+    *out = (int)v;
+    return 0;
+}
+
+/**
+ * @brief Lê uma lista de contagens de threads separadas por vírgula ("all" = todas as CPUs).
+ * @return 0 em caso de sucesso, -1 se a lista for inválida.
+ */
+static int parse_thread_counts(bench_opts_t *o, const char *list){
+    if (!list || *list == '\0') return -1;
+    o->thread_count_n = 0;
+    const char *p = list;
+    while (*p) {
+        const char *comma = strchr(p, ',');
+        size_t len = comma ? (size_t)(comma - p) : strlen(p);
+        char tok[16];
+        int v;
+        if (len == 0 || len >= sizeof(tok) || o->thread_count_n == BENCH_MAX_THREAD_COUNTS) return -1;
+        memcpy(tok, p, len);
+        tok[len] = '\0';
+        if (strcmp(tok, "all") == 0) v = 0;
+        else if (parse_int_opt(tok, 1, 65536, &v) != 0) return -1;
+        o->thread_counts[o->thread_count_n++] = v;
+        p += len;
+        if (*p == ',') p++;
+    }
+    return 0;
+}
+
+int bench_parse_args(bench_opts_t *o, int argc, char **argv){
+    memset(o, 0, sizeof(*o));
+    o->reps = 10;
+    o->warmup = 2;
+    o->rep_ms = 100;
+    o->thread_counts[0] = 1;
+    o->thread_counts[1] = 0;
+    o->thread_count_n = 2;
+    o->threshold_pct = 5.0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        int ok = 0;
+
+        if (strcmp(a, "--bench") == 0) {
+            continue;
+        } else if (strcmp(a, "-h") == 0 || strcmp(a, "--help") == 0) {
+            return 1;
+        } else if (strcmp(a, "--quick") == 0) {
+            o->reps = 5;
+            o->warmup = 1;
+            o->rep_ms = 50;
+            continue;
+        } else if (strcmp(a, "--reps") == 0) {
+            ok = parse_int_opt(val, 1, 1000, &o->reps) == 0;
+        } else if (strcmp(a, "--warmup") == 0) {
+            ok = parse_int_opt(val, 0, 100, &o->warmup) == 0;
+        } else if (strcmp(a, "--rep-ms") == 0) {
+            ok = parse_int_opt(val, 10, 10000, &o->rep_ms) == 0;
+        } else if (strcmp(a, "--threads") == 0) {
+            ok = parse_thread_counts(o, val) == 0;
+        } else if (strcmp(a, "--filter") == 0) {
+            ok = val && strlen(val) < sizeof(o->filter);
+            if (ok) snprintf(o->filter, sizeof(o->filter), "%s", val);
+        } else if (strcmp(a, "--out") == 0) {
+            ok = val && *val && strlen(val) < sizeof(o->out_path);
+            if (ok) snprintf(o->out_path, sizeof(o->out_path), "%s", val);
+        } else if (strcmp(a, "--baseline") == 0) {
+            ok = val && *val && strlen(val) < sizeof(o->baseline_path);
+            if (ok) snprintf(o->baseline_path, sizeof(o->baseline_path), "%s", val);
+        } else if (strcmp(a, "--threshold") == 0) {
+            char *end;
+            o->threshold_pct = val ? strtod(val, &end) : -1.0;
+            ok = val && *val && *end == '\0' && o->threshold_pct >= 0.0 && o->threshold_pct < 100.0;
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", a);
+            return -1;
+        }
+        if (!ok) {
+            fprintf(stderr, "Valor inválido para %s\n", a);
+            return -1;
+        }
+        i++;
+    }
+    return 0;
+}
+
+/* --- Estatísticas --- */
+
+static int cmp_double(const void *a, const void *b){
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+void bench_stats(double *v, int n, int higher_is_better, bench_stats_t *out){
+    memset(out, 0, sizeof(*out));
+    if (n <= 0) return;
+    qsort(v, (size_t)n, sizeof(double), cmp_double);
+    out->min = v[0];
+    out->max = v[n - 1];
+    out->median = (n % 2) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+    // Posto mais próximo: o p95 é o valor na posição ceil(0.95 n), contada a partir da cauda boa.
+    int k = (95 * n + 99) / 100 - 1;
+    out->p95 = higher_is_better ? v[n - 1 - k] : v[k];
+}
+
+/* --- Execução dos Casos --- */
+
+/**
+ * @brief Barreira para as threads do caso e a principal.
+ */
+static void barrier_wait(bench_run_t *r){
+    g_mutex_lock(&r->mutex);
+    unsigned gen = r->generation;
+    if (++r->arrived == r->parties) {
+        r->arrived = 0;
+        r->generation++;
+        g_cond_broadcast(&r->cond);
+    } else {
+        while (gen == r->generation) g_cond_wait(&r->cond, &r->mutex);
+    }
+    g_mutex_unlock(&r->mutex);
+}
+
+/**
+ * @brief Aloca e inicializa o conjunto de trabalho da thread, já na sua CPU.
+ * @return 0 em caso de sucesso, -1 se a alocação falhar.
+ */
+static int setup_thread(bench_thread_t *t){
+    const bench_case_t *bc = t->run->bc;
+    uint64_t seed = 0xBE0C0000 + (uint64_t)t->cpu;
+    fp_state_init(t->fp_state);
+    if (bc->bytes == 0) return 0;
+    // Folga de uma linha de cache: os kernels vetoriais fazem cargas alinhadas.
+    uint8_t *raw = region_alloc(&t->region, bc->bytes + CACHE_LINE_SIZE, PAGE_MODE_DEFAULT);
+    if (!raw) return -1;
+    uint8_t *buf = (uint8_t*)(((uintptr_t)raw + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1));
+
+    switch (bc->kernel) {
+    case KERNEL_FPU:
+        t->n = bc->bytes / (2 * sizeof(double));
+        t->n -= t->n % FP_BLOCK_ALIGN_ELEMS;
+        t->x = (double*)buf;
+        t->y = t->x + t->n;
+        fill_random_unit(t->x, t->n, seed);
+        memset(t->y, 0, t->n * sizeof(double));
+        t->passes = t->n < FP_BLOCK_QUANTUM_ELEMS ? (int)(FP_BLOCK_QUANTUM_ELEMS / t->n) : 1;
+        break;
+    case KERNEL_INT:
+        t->ints = (uint64_t*)buf;
+        t->n = bc->bytes / sizeof(uint64_t);
+        fill_random_u64(t->ints, t->n, seed, 0);
+        break;
+    case KERNEL_STREAM: {
+        size_t per_array = (bc->bytes / 3) & ~(size_t)(CACHE_LINE_SIZE - 1);
+        t->n = per_array / sizeof(double);
+        t->a = (double*)buf;
+        t->b = (double*)(buf + per_array);
+        t->c = (double*)(buf + 2 * per_array);
+        for (size_t i = 0; i < t->n; i++) { t->a[i] = 1.0; t->b[i] = 2.0; t->c[i] = 0.0; }
+        break;
+    }
+    case KERNEL_PTR:
+        t->idx = (uint32_t*)buf;
+        t->n = bc->bytes / CACHE_LINE_SIZE;
+        ptrchase_build(t->idx, t->n, bc->param, t->pos, &seed);
+        break;
+    }
+    return 0;
+}
+
+/**
+ * @brief Executa uma unidade de trabalho (~1 ms) do caso.
+ * @return O trabalho realizado, na grandeza contada pelo caso.
+ */
+static uint64_t run_unit(bench_thread_t *t){
+    const bench_case_t *bc = t->run->bc;
+    switch (bc->kernel) {
+    case KERNEL_FPU:
+        if (!t->x) return t->run->fp->chain(t->fp_state);
+        return t->run->fp->block(t->x, t->y, t->n, t->passes);
+    case KERNEL_INT:
+        return kernel_int(t->ints, t->n, BENCH_INT_ITERS);
+    case KERNEL_STREAM:
+        return kernel_stream(bc->param, t->a, t->b, t->c, t->n, 0, 0);
+    case KERNEL_PTR:
+        kernel_ptrchase(t->idx, t->pos, bc->param, PTR_STEPS_PER_QUANTUM);
+        return (uint64_t)PTR_STEPS_PER_QUANTUM * (uint64_t)bc->param;
+    }
+    return 0;
+}
+
+/**
+ * @brief Thread de um caso: prepara os buffers e executa uma repetição por abertura da barreira.
+ */
+static thread_return_t THREAD_CALL bench_thread_main(void *arg){
+    bench_thread_t *t = (bench_thread_t*)arg;
+    bench_run_t *r = t->run;
+    if (t->cpu >= 0) thread_pin_self(t->cpu);
+    t->failed = setup_thread(t) != 0;
+    barrier_wait(r);
+    for (;;) {
+        barrier_wait(r);
+        if (r->quit) break;
+        uint64_t work = 0;
+        for (unsigned long long u = 0; u < r->units; u++) work += run_unit(t);
+        t->work = work;
+        t->end = now_sec();
+        barrier_wait(r);
+    }
+    region_free(&t->region);
+    return 0;
+}
+
+/**
+ * @brief Executa uma repetição em todas as threads.
+ * @param value Recebe a métrica da repetição.
+ * @return A duração da repetição, da abertura da barreira até a última thread terminar.
+ */
+static double run_rep(bench_run_t *r, bench_thread_t *th, int threads, double *value){
+    double start = now_sec();
+    barrier_wait(r);
+    barrier_wait(r);
+    double end = start;
+    uint64_t work = 0;
+    for (int i = 0; i < threads; i++) {
+        if (th[i].end > end) end = th[i].end;
+        work += th[i].work;
+    }
+    double dt = end - start;
+    const bench_case_t *bc = r->bc;
+    if (bc->higher_is_better) *value = dt > 0.0 ? (double)work / dt * bc->scale : 0.0;
+    // Latência: tempo de cada thread dividido pelos seus passos, na média das threads.
+    else *value = work > 0 ? dt * threads / (double)work * bc->scale : 0.0;
+    return dt;
+}
+
+/**
+ * @brief Executa um caso com `threads` threads fixadas em `cpus`.
+ * @return 0 em caso de sucesso, -1 se a preparação falhou.
+ */
+static int run_case(const bench_case_t *bc, const fp_engine_t *fp, int threads, const int *cpus,
+                    const bench_opts_t *o, bench_score_t *out){
+    bench_run_t r = { .bc = bc, .fp = fp, .parties = threads + 1 };
+    bench_thread_t *th = calloc((size_t)threads, sizeof(bench_thread_t));
+    thread_handle_t *handles = calloc((size_t)threads, sizeof(thread_handle_t));
+    double *values = calloc((size_t)o->reps, sizeof(double));
+    if (!th || !handles || !values) {
+        free(th); free(handles); free(values);
+        return -1;
+    }
+    g_mutex_init(&r.mutex);
+    g_cond_init(&r.cond);
+
+    int started = 0, failed = 0;
+    for (; started < threads; started++) {
+        th[started].run = &r;
+        th[started].cpu = cpus ? cpus[started] : -1;
+        if (thread_create(&handles[started], bench_thread_main, &th[started]) != 0) break;
+    }
+    if (started < threads) {
+        // As threads já criadas esperam por `parties` chegadas; a barreira passa a contar só elas.
+        g_mutex_lock(&r.mutex);
+        r.parties = started + 1;
+        g_mutex_unlock(&r.mutex);
+        failed = 1;
+    }
+    barrier_wait(&r); // preparação concluída
+    for (int i = 0; i < started; i++) failed |= th[i].failed;
+
+    if (!failed) {
+        // Aquecimento: as repetições curtas demais calibram as unidades por repetição e não contam.
+        double target = o->rep_ms / 1000.0, value;
+        r.units = 1;
+        for (int warm = 0, tries = 0; tries < 32; tries++) {
+            double dt = run_rep(&r, th, threads, &value);
+            if (dt < 0.5 * target) {
+                double f = dt > 0.0 ? target / dt : 1000.0;
+                if (f > 1000.0) f = 1000.0;
+                r.units = (unsigned long long)((double)r.units * f) + 1;
+                continue;
+            }
+            if (++warm >= o->warmup) break;
+        }
+        for (int i = 0; i < o->reps; i++) run_rep(&r, th, threads, &values[i]);
+    }
+    r.quit = 1;
+    barrier_wait(&r);
+    for (int i = 0; i < started; i++) thread_join(handles[i]);
+
+    if (!failed) {
+        memset(out, 0, sizeof(*out));
+        snprintf(out->name, sizeof(out->name), "%s", bc->name);
+        snprintf(out->unit, sizeof(out->unit), "%s", bc->unit);
+        out->threads = threads;
+        out->higher_is_better = bc->higher_is_better;
+        bench_stats(values, o->reps, bc->higher_is_better, &out->stats);
+    }
+    g_cond_clear(&r.cond);
+    g_mutex_clear(&r.mutex);
+    free(th);
+    free(handles);
+    free(values);
+    return failed ? -1 : 0;
+}
+
+/* --- Arquivo de Pontuação --- */
+
+int bench_write_scores(const char *path, const bench_opts_t *o, const bench_score_t *s, int n){
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+    const fp_engine_t *fp = fp_engine_select();
+    fprintf(f, "{\"type\":\"host\",\"version\":1,\"cpus\":%d,\"engine\":\"%s\",\"reps\":%d,\"warmup\":%d,\"rep_ms\":%d,\"time\":%lld}\n",
+            detect_cpu_count(), fp->name, o->reps, o->warmup, o->rep_ms, (long long)time(NULL));
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "{\"type\":\"case\",\"case\":\"%s\",\"threads\":%d,\"unit\":\"%s\",\"higher_is_better\":%d,"
+                   "\"median\":%.6g,\"p95\":%.6g,\"min\":%.6g,\"max\":%.6g}\n",
+                s[i].name, s[i].threads, s[i].unit, s[i].higher_is_better,
+                s[i].stats.median, s[i].stats.p95, s[i].stats.min, s[i].stats.max);
+    }
+    int rc = ferror(f) ? -1 : 0;
+    if (fclose(f) != 0) rc = -1;
+    return rc;
+}
+
+/**
+ * @brief Localiza o valor do campo `key` em uma linha JSON plana gravada por `bench_write_scores`.
+ * @return O primeiro caractere do valor, ou NULL se o campo não existe.
+ */
+static const char *json_value(const char *line, const char *key){
+    char pat[40];
+    snprintf(pat, sizeof(pat), "\"%s\":", key);
+    const char *p = strstr(line, pat);
+    return p ? p + strlen(pat) : NULL;
+}
+
+int bench_load_scores(const char *path, bench_score_t **out){
+    *out = NULL;
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    int n = 0, cap = 0;
+    bench_score_t *v = NULL;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (!strstr(line, "\"type\":\"case\"")) continue;
+        const char *name = json_value(line, "case"), *unit = json_value(line, "unit");
+        const char *threads = json_value(line, "threads"), *hib = json_value(line, "higher_is_better");
+        const char *median = json_value(line, "median"), *p95 = json_value(line, "p95");
+        if (!name || !unit || !threads || !hib || !median || !p95 || *name != '"' || *unit != '"') continue;
+        if (n == cap) {
+            cap = cap ? cap * 2 : 32;
+            bench_score_t *p = realloc(v, (size_t)cap * sizeof(*v));
+            if (!p) break;
+            v = p;
+        }
+        bench_score_t *s = &v[n];
+        memset(s, 0, sizeof(*s));
+        size_t len = strcspn(name + 1, "\"");
+        snprintf(s->name, sizeof(s->name), "%.*s", (int)len, name + 1);
+        len = strcspn(unit + 1, "\"");
+        snprintf(s->unit, sizeof(s->unit), "%.*s", (int)len, unit + 1);
+        s->threads = atoi(threads);
+        s->higher_is_better = atoi(hib);
+        s->stats.median = strtod(median, NULL);
+        s->stats.p95 = strtod(p95, NULL);
+        const char *mn = json_value(line, "min"), *mx = json_value(line, "max");
+        if (mn) s->stats.min = strtod(mn, NULL);
+        if (mx) s->stats.max = strtod(mx, NULL);
+        n++;
+    }
+    fclose(f);
+    *out = v;
+    return n;
+}
+
+int bench_compare(const bench_score_t *cur, const bench_score_t *base, double threshold_pct, double *delta_pct){
+    double d = 0.0;
+    if (base->stats.median > 0.0) d = (cur->stats.median - base->stats.median) / base->stats.median * 100.0;
+    if (!cur->higher_is_better) d = -d;
+    *delta_pct = d;
+    return d < -threshold_pct;
+}
+
+/**
+ * @brief Procura o caso `name` com `threads` threads em `s`.
+ */
+static const bench_score_t *find_score(const bench_score_t *s, int n, const char *name, int threads){
+    for (int i = 0; i < n; i++) {
+        if (s[i].threads == threads && strcmp(s[i].name, name) == 0) return &s[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Imprime a comparação de cada caso com a base.
+ * @return O número de regressões, ou -1 se a base não puder ser lida.
+ */
+static int compare_baseline(const bench_opts_t *o, const bench_score_t *cur, int n){
+    bench_score_t *base = NULL;
+    int nb = bench_load_scores(o->baseline_path, &base);
+    if (nb < 0) {
+        fprintf(stderr, "ERRO: Não foi possível ler a base '%s'.\n", o->baseline_path);
+        return -1;
+    }
+    printf("\n=== Comparação com %s (limiar %.1f%%) ===\n", o->baseline_path, o->threshold_pct);
+    int regressions = 0;
+    for (int i = 0; i < n; i++) {
+        const bench_score_t *b = find_score(base, nb, cur[i].name, cur[i].threads);
+        if (!b) {
+            printf("  %-18s T=%-4d %10.3f %-9s   sem base\n", cur[i].name, cur[i].threads, cur[i].stats.median, cur[i].unit);
+            continue;
+        }
+        double d;
+        int reg = bench_compare(&cur[i], b, o->threshold_pct, &d);
+        regressions += reg;
+        printf("  %-18s T=%-4d %10.3f %-9s base %10.3f  %+6.1f%%  %s\n", cur[i].name, cur[i].threads,
+               cur[i].stats.median, cur[i].unit, b->stats.median, d,
+               reg ? "REGRESSÃO" : (d > o->threshold_pct ? "melhora" : "ok"));
+    }
+    printf("%d regressão(ões) em %d caso(s)\n", regressions, n);
+    free(base);
+    return regressions;
+}
+
+/* --- Ponto de Entrada --- */
+
+int bench_main(int argc, char **argv){
+#ifdef _WIN32
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        freopen("CONOUT$", "w", stdout);
+        freopen("CONOUT$", "w", stderr);
+    }
+#endif
+    bench_opts_t o;
+    int rc = bench_parse_args(&o, argc, argv);
+    if (rc != 0) {
+        print_usage(argv[0]);
+        return rc > 0 ? 0 : 1;
+    }
+
+    int cpu_count = detect_cpu_count();
+    cpu_topology_t *topo = topology_detect(cpu_count);
+    const fp_engine_t *fp = fp_engine_select();
+    unsigned long long total_mem = get_total_system_memory();
+    bench_score_t *scores = calloc((size_t)BENCH_CASE_COUNT * BENCH_MAX_THREAD_COUNTS, sizeof(bench_score_t));
+    int *cpus = calloc(65536, sizeof(int));
+    if (!scores || !cpus) {
+        fprintf(stderr, "ERRO: Falha ao alocar os resultados.\n");
+        free(scores); free(cpus); topology_free(topo);
+        return 1;
+    }
+    printf("[BENCH] %d CPU(s), motor FPU %s; %d aquecimento(s) e %d repetição(ões) de ~%d ms por caso\n",
+           cpu_count, fp->name, o.warmup, o.reps, o.rep_ms);
+
+    int n = 0, failures = 0;
+    for (int k = 0; k < o.thread_count_n; k++) {
+        int threads = o.thread_counts[k] > 0 ? o.thread_counts[k] : cpu_count;
+        int dup = 0;
+        for (int j = 0; j < k; j++) dup |= (o.thread_counts[j] > 0 ? o.thread_counts[j] : cpu_count) == threads;
+        if (dup) continue;
+        // As threads ocupam um núcleo físico cada antes dos irmãos SMT, como a política padrão dos workers.
+        if (!topo || topology_place(topo, AFFINITY_PHYSICAL_FIRST, NULL, 0, threads, cpus) != 0) {
+            for (int i = 0; i < threads; i++) cpus[i] = i % cpu_count;
+        }
+        for (int c = 0; c < BENCH_CASE_COUNT; c++) {
+            const bench_case_t *bc = &BENCH_CASES[c];
+            if (o.filter[0] && !strstr(bc->name, o.filter)) continue;
+            if (total_mem > 0 && (unsigned long long)bc->bytes * threads > total_mem / 2) {
+                printf("[BENCH] %-18s T=%-4d pulado: %d x %zu MiB excede metade da memória\n",
+                       bc->name, threads, threads, bc->bytes >> 20);
+                continue;
+            }
+            fflush(stdout);
+            if (run_case(bc, fp, threads, cpus, &o, &scores[n]) != 0) {
+                printf("[BENCH] %-18s T=%-4d FALHOU: não foi possível preparar as threads\n", bc->name, threads);
+                failures++;
+                continue;
+            }
+            const bench_score_t *s = &scores[n++];
+            printf("[BENCH] %-18s T=%-4d mediana %10.3f %-9s p95 %10.3f  (min %.3f, max %.3f)\n",
+                   s->name, s->threads, s->stats.median, s->unit, s->stats.p95, s->stats.min, s->stats.max);
+        }
+    }
+
+    rc = failures > 0 ? 2 : 0;
+    if (o.out_path[0]) {
+        if (bench_write_scores(o.out_path, &o, scores, n) != 0) {
+            fprintf(stderr, "ERRO: Não foi possível gravar '%s'.\n", o.out_path);
+            rc = 1;
+        } else {
+            printf("[BENCH] %d caso(s) gravado(s) em %s\n", n, o.out_path);
+        }
+    }
+    if (o.baseline_path[0]) {
+        int regressions = compare_baseline(&o, scores, n);
+        if (regressions < 0) rc = 1;
+        else if (regressions > 0 && rc == 0) rc = 2;
+    }
+    free(scores);
+    free(cpus);
+    topology_free(topo);
+    return rc;
+}
@@ -0,0 +1,103 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * @file bench.h
+ * @brief Declara a suíte de benchmarks reprodutíveis (`--bench`, `make bench`).
+ *
+ * Cada caso executa um kernel com um conjunto de trabalho fixo por thread
+ * (registradores, L1, L2 ou DRAM) e um número fixo de threads fixadas nas CPUs.
+ * Após repetições de aquecimento, que também calibram a quantidade de trabalho
+ * de cada repetição, as repetições medidas produzem a mediana e o p95 da métrica
+ * do caso. Os resultados vão para um arquivo de pontuação em JSON Lines, que pode
+ * servir de base para uma execução futura: casos piores que a base além de um
+ * limiar são marcados como regressão.
+ */
+
+#include "hardstress.h"
+
+/** @brief Número máximo de contagens de threads por execução. */
+#define BENCH_MAX_THREAD_COUNTS 8
+
+/**
+ * @struct bench_opts_t
+ * @brief Opções da linha de comando do modo `--bench`.
+ */
+typedef struct {
+    int reps;               ///< Repetições medidas por caso.
+    int warmup;             ///< Repetições de aquecimento (e calibração) por caso.
+    int rep_ms;             ///< Duração alvo de cada repetição, em milissegundos.
+    int thread_counts[BENCH_MAX_THREAD_COUNTS]; ///< Contagens de threads; 0 = todas as CPUs.
+    int thread_count_n;     ///< Entradas válidas em `thread_counts`.
+    char filter[64];        ///< Executa só os casos cujo nome contém este texto (vazio = todos).
+    char out_path[512];     ///< Arquivo de pontuação a gravar (vazio = nenhum).
+    char baseline_path[512];///< Arquivo de pontuação de referência (vazio = sem comparação).
+    double threshold_pct;   ///< Piora relativa à base, em %, a partir da qual um caso é regressão.
+} bench_opts_t;
+
+/**
+ * @struct bench_stats_t
+ * @brief Estatísticas das repetições medidas de um caso.
+ */
+typedef struct {
+    double median;          ///< Mediana.
+    double p95;             ///< Valor que 95% das repetições igualam ou superam (a cauda ruim).
+    double min, max;        ///< Extremos.
+} bench_stats_t;
+
+/**
+ * @struct bench_score_t
+ * @brief O resultado de um caso, como gravado no arquivo de pontuação.
+ */
+typedef struct {
+    char name[48];          ///< Nome do caso (por exemplo, "stream.triad.dram").
+    int threads;            ///< Threads usadas.
+    char unit[16];          ///< Unidade da métrica (por exemplo, "GB/s").
+    int higher_is_better;   ///< 1 para vazões, 0 para latências.
+    bench_stats_t stats;    ///< Estatísticas das repetições.
+} bench_score_t;
+
+/**
+ * @brief Verifica se `--bench` foi passado na linha de comando (antes de `gtk_init`).
+ */
+int bench_requested(int argc, char **argv);
+
+/**
+ * @brief Preenche `o` com os padrões e aplica as opções de `argv`.
+ * @return 0 em caso de sucesso, 1 se a ajuda foi solicitada, -1 em caso de argumento inválido.
+ */
+int bench_parse_args(bench_opts_t *o, int argc, char **argv);
+
+/**
+ * @brief Calcula as estatísticas de `n` valores (a ordem de `v` é alterada).
+ * @param higher_is_better Define a cauda ruim usada no p95.
+ */
+void bench_stats(double *v, int n, int higher_is_better, bench_stats_t *out);
+
+/**
+ * @brief Grava o arquivo de pontuação.
+ * @return 0 em caso de sucesso, -1 se o arquivo não puder ser escrito.
+ */
+int bench_write_scores(const char *path, const bench_opts_t *o, const bench_score_t *s, int n);
+
+/**
+ * @brief Lê os casos de um arquivo de pontuação.
+ * @param out Recebe um array alocado com `malloc` (liberado por quem chama).
+ * @return O número de casos lidos, ou -1 se o arquivo não puder ser aberto.
+ */
+int bench_load_scores(const char *path, bench_score_t **out);
+
+/**
+ * @brief Compara um caso com a base.
+ * @param delta_pct Recebe a variação da mediana em %, com sinal (positiva = melhor).
+ * @return 1 se a piora excede `threshold_pct`, 0 caso contrário.
+ */
+int bench_compare(const bench_score_t *cur, const bench_score_t *base, double threshold_pct, double *delta_pct);
+
+/**
+ * @brief Ponto de entrada do modo `--bench`.
+ * @return 0 sem regressões, 1 em caso de uso inválido ou erro de E/S, 2 se houve regressão ou caso com falha.
+ */
+int bench_main(int argc, char **argv);
+
+#endif // BENCH_H
@@ -0,0 +1,175 @@
+#include "coherence.h"
+#include "utils.h"   // Para now_sec, cpu_relax, thread_yield e as threads
+#include <string.h>
+
+/**
+ * @brief Estado da thread que responde ao ping-pong da matriz de latência.
+ */
+typedef struct {
+    shared_line_t line;     ///< A linha que vai e volta: ímpar = vez do respondedor, par = vez de quem mede.
+    shared_line_t quit;     ///< Não-zero pede o fim do respondedor (em outra linha, para não perturbar a medida).
+    int cpu;                ///< CPU do respondedor.
+} c2c_peer_t;
+
+/* --- Static Function Prototypes --- */
+static int wait_turn(shared_line_t *line, int side, unsigned long long *v);
+static thread_return_t THREAD_CALL c2c_responder(void *arg);
+static int c2c_wait(c2c_peer_t *p, unsigned long long target, atomic_int *running);
+
+/**
+ * @brief Espera a vez de `side` na linha do par, com espera limitada.
+ * @param v Recebe o valor da linha quando a vez chega.
+ * @return 0 na vez de `side`, -1 se o parceiro não respondeu em `ATOMIC_SPIN_LIMIT` voltas.
+ */
+static int wait_turn(shared_line_t *line, int side, unsigned long long *v){
+    for (unsigned spins = 1; ; spins++) {
+        *v = atomic_load_explicit(&line->v, memory_order_acquire);
+        if ((int)(*v & 1u) == side) return 0;
+        if (spins >= ATOMIC_SPIN_LIMIT) return -1;
+        if (spins % ATOMIC_YIELD_SPINS == 0) thread_yield();
+        else cpu_relax();
+    }
+}
+
+void kernel_atomic(shared_line_t *add, shared_line_t *cas, shared_line_t *pair, int side, unsigned ops,
+                   atomic_counts_t *out){
+    unsigned n_cas = ops / 4, n_pp = pair ? ops / 4 : 0;
+    unsigned n_add = ops - n_cas - n_pp;
+
+    for (unsigned i = 0; i < n_add; i++) atomic_fetch_add_explicit(&add->v, 1, memory_order_relaxed);
+    out->ops += n_add;
+
+    unsigned long long fails = 0;
+    for (unsigned i = 0; i < n_cas; i++) {
+        unsigned long long old = atomic_load_explicit(&cas->v, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&cas->v, &old, old + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) fails++;
+    }
+    out->ops += n_cas;
+    out->cas_fails += fails;
+
+    if (n_pp == 0) return;
+    // A primeira vez só sincroniza os dois lados; o tempo conta a partir dela.
+    unsigned long long v;
+    if (wait_turn(pair, side, &v) != 0) return;
+    atomic_store_explicit(&pair->v, v + 1, memory_order_release);
+    out->ops++;
+    double start = now_sec();
+    unsigned done = 0;
+    for (unsigned i = 1; i < n_pp; i++) {
+        if (wait_turn(pair, side, &v) != 0) break;
+        atomic_store_explicit(&pair->v, v + 1, memory_order_release);
+        done++;
+    }
+    // Cada passagem de vez depois da primeira implica uma do parceiro: uma ida e volta completa.
+    if (done > 0) {
+        out->ops += done;
+        out->rounds += done;
+        out->round_ns += (unsigned long long)((now_sec() - start) * 1e9);
+    }
+}
+
+c2c_result_t *c2c_create(const int *cpus, const int *package, int n){
+    if (n < 1 || n > C2C_MAX_CPUS) return NULL;
+    c2c_result_t *r = calloc(1, sizeof(*r) + (size_t)n * n * sizeof(double));
+    if (!r) return NULL;
+    r->n = n;
+    for (int i = 0; i < n; i++) {
+        r->cpus[i] = cpus[i];
+        r->package[i] = package ? package[i] : 0;
+    }
+    return r;
+}
+
+/**
+ * @brief Laço do respondedor: devolve a linha sempre que ela fica ímpar.
+ */
+static thread_return_t THREAD_CALL c2c_responder(void *arg){
+    c2c_peer_t *p = (c2c_peer_t*)arg;
+    if (p->cpu >= 0) thread_pin_self(p->cpu);
+    for (unsigned spins = 1; ; spins++) {
+        unsigned long long v = atomic_load_explicit(&p->line.v, memory_order_acquire);
+        if (v & 1u) {
+            atomic_store_explicit(&p->line.v, v + 1, memory_order_release);
+            spins = 0;
+            continue;
+        }
+        if (atomic_load_explicit(&p->quit.v, memory_order_relaxed)) break;
+        if (spins % ATOMIC_YIELD_SPINS == 0) thread_yield();
+        else cpu_relax();
+    }
+    return 0;
+}
+
+/**
+ * @brief Espera a resposta `target` do respondedor.
+ * @return 0 quando ela chega, -1 se `running` foi zerado.
+ */
+static int c2c_wait(c2c_peer_t *p, unsigned long long target, atomic_int *running){
+    for (unsigned spins = 1; atomic_load_explicit(&p->line.v, memory_order_acquire) != target; spins++) {
+        if (spins % ATOMIC_YIELD_SPINS == 0) {
+            if (running && !atomic_load(running)) return -1;
+            thread_yield();
+        } else {
+            cpu_relax();
+        }
+    }
+    return 0;
+}
+
+double c2c_round_trip(int cpu_a, int cpu_b, int rounds, atomic_int *running){
+    if (rounds < 1) rounds = 1;
+    c2c_peer_t *p = aligned_calloc(1, sizeof(*p), WORKER_ALIGN);
+    if (!p) return -1.0;
+    p->cpu = cpu_b;
+    thread_handle_t t;
+    if (cpu_a >= 0) thread_pin_self(cpu_a);
+    if (thread_create(&t, c2c_responder, p) != 0) {
+        aligned_free(p);
+        return -1.0;
+    }
+
+    double best = -1.0;
+    unsigned long long v = 0;
+    // Um primeiro lote não medido espera o respondedor se fixar e traz a linha para o par.
+    for (int rep = -1; rep < C2C_REPS; rep++) {
+        double start = now_sec();
+        int k;
+        for (k = 0; k < rounds; k++) {
+            atomic_store_explicit(&p->line.v, v + 1, memory_order_release);
+            v += 2;
+            if (c2c_wait(p, v, running) != 0) break;
+        }
+        if (k < rounds) { best = -1.0; break; }
+        double ns = (now_sec() - start) * 1e9 / rounds;
+        if (rep >= 0 && (best < 0.0 || ns < best)) best = ns;
+    }
+
+    atomic_store(&p->quit.v, 1);
+    thread_join(t);
+    aligned_free(p);
+    return best;
+}
+
+void c2c_summarize(const c2c_result_t *r, c2c_stats_t *out){
+    memset(out, 0, sizeof(*out));
+    out->worst_a = out->worst_b = -1;
+    double same = 0.0, cross = 0.0;
+    int same_n = 0, cross_n = 0;
+    for (int i = 0; r && i < r->n; i++) {
+        for (int j = i + 1; j < r->n; j++) {
+            double ns = r->ns[i * r->n + j];
+            if (ns <= 0.0) continue;
+            if (same_n + cross_n == 0 || ns < out->min) out->min = ns;
+            if (same_n + cross_n == 0 || ns > out->max) {
+                out->max = ns;
+                out->worst_a = r->cpus[i];
+                out->worst_b = r->cpus[j];
+            }
+            if (r->package[i] == r->package[j]) { same += ns; same_n++; }
+            else { cross += ns; cross_n++; }
+        }
+    }
+    if (same_n) out->same_socket = same / same_n;
+    if (cross_n) out->cross_socket = cross / cross_n;
+}
@@ -0,0 +1,123 @@
+#ifndef COHERENCE_H
+#define COHERENCE_H
+
+/**
+ * @file coherence.h
+ * @brief Declara o kernel de contenção atômica e a medição de latência entre núcleos.
+ *
+ * Os demais kernels tocam apenas o buffer privado de cada worker. O kernel
+ * ATOMIC faz o contrário: todos os workers que o executam disputam as mesmas
+ * linhas de cache, com fetch-add em um contador comum, laços de CAS em uma
+ * segunda linha e, entre pares de workers, um ping-pong em que cada lado espera
+ * a vez do outro. Cada operação obriga o protocolo de coerência a migrar a linha
+ * entre núcleos (e entre sockets), o que estressa a interconexão.
+ *
+ * A matriz de latência entre núcleos (`--c2c`) usa o mesmo ping-pong, um par de
+ * CPUs por vez, para medir o tempo de ida e volta de uma linha entre cada par.
+ */
+
+#include "hardstress.h"
+
+/** @brief Operações atômicas de cada worker em uma iteração. */
+#define ATOMIC_OPS_PER_ITER (1u << 16)
+/** @brief Operações atômicas por quantum de trabalho (~1 ms com linhas disputadas). */
+#define ATOMIC_OPS_PER_QUANTUM (1u << 12)
+/** @brief Voltas de espera pela vez no ping-pong antes de desistir do quantum (parceiro ocioso ou parado). */
+#define ATOMIC_SPIN_LIMIT (1u << 20)
+/** @brief Voltas de espera entre cessões da CPU, para que um par na mesma CPU ainda avance. */
+#define ATOMIC_YIELD_SPINS (1u << 10)
+/** @brief Idas e voltas medidas em cada repetição da matriz de latência. */
+#define C2C_ROUNDS 2000
+/** @brief Repetições de cada par da matriz; vale a menor, já que o ruído só soma. */
+#define C2C_REPS 3
+/** @brief Máximo de CPUs na matriz de latência. */
+#define C2C_MAX_CPUS 256
+
+/**
+ * @struct shared_line_t
+ * @brief Uma palavra atômica sozinha em um bloco de `WORKER_ALIGN` bytes (o prefetch adjacente traz pares de linhas).
+ */
+typedef struct {
+    _Alignas(WORKER_ALIGN) atomic_ullong v; ///< O valor disputado.
+} shared_line_t;
+
+/** @brief Linha do contador comum do fetch-add, em `AppContext::atomic_lines`. */
+#define ATOMIC_LINE_ADD 0
+/** @brief Linha disputada pelos laços de CAS. */
+#define ATOMIC_LINE_CAS 1
+/** @brief Primeira linha de ping-pong; o par `p` usa `ATOMIC_LINE_PAIRS + p`. */
+#define ATOMIC_LINE_PAIRS 2
+
+/**
+ * @struct atomic_counts_t
+ * @brief Resultado de um quantum do kernel ATOMIC.
+ */
+typedef struct {
+    unsigned long long ops;         ///< Operações atômicas concluídas (fetch-adds, CAS bem-sucedidos e passagens de vez).
+    unsigned long long cas_fails;   ///< CAS que falharam porque outro núcleo alterou a linha.
+    unsigned long long rounds;      ///< Idas e voltas completas do ping-pong.
+    unsigned long long round_ns;    ///< Tempo gasto nessas idas e voltas, em ns.
+} atomic_counts_t;
+
+/**
+ * @brief Executa um quantum do kernel ATOMIC.
+ *
+ * Metade das operações é fetch-add em `add`, um quarto é incremento por CAS em
+ * `cas` e o quarto restante é ping-pong em `pair` (NULL = worker sem par). No
+ * ping-pong, o lado 0 avança a linha de valores pares para ímpares e o lado 1 de
+ * ímpares para pares; se o parceiro não responder em `ATOMIC_SPIN_LIMIT` voltas,
+ * o resto do ping-pong do quantum é abandonado.
+ *
+ * @param side A vez deste worker no par (0 ou 1).
+ * @param out Acumula as contagens do quantum.
+ */
+void kernel_atomic(shared_line_t *add, shared_line_t *cas, shared_line_t *pair, int side, unsigned ops,
+                   atomic_counts_t *out);
+
+/**
+ * @struct c2c_result_t
+ * @brief A matriz de latência entre núcleos.
+ */
+struct c2c_result_t {
+    int n;                  ///< CPUs na matriz.
+    int done;               ///< Pares já medidos.
+    int cpus[C2C_MAX_CPUS]; ///< CPU de cada linha/coluna.
+    int package[C2C_MAX_CPUS]; ///< Socket de cada CPU.
+    double ns[];            ///< Ida e volta, em ns, do par (i, j) em `ns[i * n + j]` (0 = não medido).
+};
+
+/**
+ * @struct c2c_stats_t
+ * @brief Resumo da matriz.
+ */
+typedef struct {
+    double min, max;        ///< Menor e maior ida e volta medidas.
+    double same_socket;     ///< Média dos pares no mesmo socket (0 se não houver).
+    double cross_socket;    ///< Média dos pares em sockets diferentes (0 se não houver).
+    int worst_a, worst_b;   ///< CPUs do par mais lento.
+} c2c_stats_t;
+
+/**
+ * @brief Aloca uma matriz vazia para as `n` CPUs de `cpus`.
+ * @param package Socket de cada CPU, ou NULL para tratar todas como de um socket.
+ * @return A matriz (liberada com `free`), ou NULL se `n` for inválido ou faltar memória.
+ */
+c2c_result_t *c2c_create(const int *cpus, const int *package, int n);
+
+/**
+ * @brief Mede a ida e volta de uma linha entre as CPUs `cpu_a` e `cpu_b`.
+ *
+ * A thread chamadora é fixada em `cpu_a` e uma thread auxiliar em `cpu_b`; o
+ * resultado é a menor de `C2C_REPS` repetições de `rounds` idas e voltas.
+ *
+ * @param running Interrompe a medição quando zerado (NULL = nunca).
+ * @return A ida e volta em ns, ou -1 se a medição foi interrompida ou a thread não pôde ser criada.
+ */
+double c2c_round_trip(int cpu_a, int cpu_b, int rounds, atomic_int *running);
+
+/**
+ * @brief Resume os pares medidos da matriz.
+ */
+void c2c_summarize(const c2c_result_t *r, c2c_stats_t *out);
+
+#endif // COHERENCE_H
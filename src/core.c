@@ -2,14 +2,163 @@
 #include "metrics.h" // Para cpu_sampler_thread_func
 #include "utils.h"   // Para now_sec, shuffle32, etc.
 #include "ui.h"      // Para gui_log
+#include "topology.h" // Para topology_detect, topology_remote_cpu
+#include "pages.h"    // Para region_alloc, region_free
+#include "kernels.h"  // Para os kernels de estresse e o motor de ponto flutuante
+#include "perfctr.h"  // Para os contadores de hardware por worker
+#include "history.h"  // Para history_archive_create, history_archive_free
+#include "telemetry.h" // Para a exportação das amostras
+#include "profile.h"   // Para os perfis de carga
+#include "roles.h"     // Para os papéis dos workers
+#include "sweep.h"     // Para a varredura de caches
+#include "coherence.h" // Para o kernel ATOMIC e a matriz de latência entre núcleos
+#include "storage.h"   // Para o motor de E/S de armazenamento
+#include "jitter.h"    // Para a sonda de latência de escalonamento
+#include "verify.h"    // Para a verificação de memória do kernel STREAM
+
+#include <math.h>
+#include <limits.h>
+#include <stddef.h>
+
+// O layout de worker_t depende destes invariantes para evitar falso compartilhamento entre workers vizinhos.
+_Static_assert(sizeof(worker_t) % WORKER_ALIGN == 0, "worker_t deve ocupar um múltiplo de WORKER_ALIGN");
+_Static_assert(offsetof(worker_t, iters) % WORKER_ALIGN == 0, "o estado quente de worker_t deve começar em um novo bloco");
+
+/** @brief Kernels de um worker, como bits de `work_cursor_t::pending`. */
+enum { WORK_FPU = 1u << KERNEL_FPU, WORK_INT = 1u << KERNEL_INT, WORK_STREAM = 1u << KERNEL_STREAM, WORK_PTR = 1u << KERNEL_PTR,
+       WORK_ATOMIC = 1u << KERNEL_ATOMIC };
+
+/** @brief Palavras do início do buffer regravadas pelo kernel INT a cada iteração. */
+#define INT_KERNEL_WORDS 1024
+
+/** @brief Quanta entre leituras dos contadores de hardware quando o worker executa um único kernel. */
+#define PERF_READ_QUANTA 64
+
+/**
+ * @brief A posição de um worker dentro da iteração corrente.
+ *
+ * Uma iteração é uma passagem de cada kernel habilitado sobre seu conjunto de
+ * dados. Ela é dividida em quanta de ~1 ms e o cursor guarda onde cada kernel
+ * parou, de modo que a flag `running` é verificada entre quanta, e não apenas a
+ * cada iteração, qualquer que seja o tamanho do buffer.
+ */
+typedef struct {
+    unsigned pending;           ///< Kernels que ainda não completaram a iteração corrente (bits `WORK_*`).
+    int fp_pass;                ///< Passagem corrente sobre o bloco FPU.
+    size_t fp_off;              ///< Próximo elemento do bloco FPU, quando ele não cabe em um quantum.
+    int stream_op;              ///< Operação STREAM corrente.
+    size_t stream_off;          ///< Próximo elemento da operação STREAM corrente.
+    unsigned ptr_steps;         ///< Passos do kernel ptr já dados na iteração corrente.
+    unsigned atomic_ops;        ///< Operações do kernel atomic já feitas na iteração corrente.
+    unsigned long long done;    ///< Quanta concluídos na iteração corrente.
+} work_cursor_t;
 
 /* --- Static Function Prototypes --- */
 static thread_return_t THREAD_CALL worker_main(void *arg);
-static void kernel_fpu(float *A, float *B, float *C, size_t n, int iters);
-static inline uint64_t mix64(uint64_t x);
-static void kernel_int(uint64_t *dst, size_t n, int iters);
-static void kernel_stream(uint8_t *buf, size_t n);
-static void kernel_ptrchase(uint32_t *idx, size_t n, int rounds);
+static unsigned long long work_quanta_per_iter(const worker_t *w, unsigned kernels);
+static uint64_t fp_block_quantum(const fp_engine_t *fp, worker_t *w, work_cursor_t *c);
+static void stream_quantum(worker_t *w, work_cursor_t *c, unsigned long long *bytes, unsigned long long *ns);
+static void verify_quantum(worker_t *w, work_cursor_t *c, unsigned long long *bytes, unsigned long long *ns);
+static void log_verify_mismatches(worker_t *w, const verify_mismatch_t *bad, size_t nbad);
+static int init_verify_buffer(worker_t *w, uint8_t *base, size_t usable);
+static void assign_worker_cpus(AppContext *app);
+static int assign_worker_roles(AppContext *app);
+static void place_workers(AppContext *app, int *cpus);
+static void log_worker_placement(AppContext *app, const int *cpus);
+static void report_init_summary(AppContext *app, double elapsed);
+static void report_numa_summary(AppContext *app, double elapsed);
+static void touch_pages(void *p, size_t bytes);
+static void log_worker_pages(worker_t *w);
+static int alloc_fp_block(worker_t *w);
+static void report_fp_summary(AppContext *app);
+static void report_int_summary(AppContext *app);
+static void report_ptr_summary(AppContext *app);
+static void report_stream_summary(AppContext *app);
+static void report_verify_summary(AppContext *app);
+static void report_perf_summary(AppContext *app);
+static void perf_attribute(worker_t *w, const perf_group_t *g, unsigned long long *last, int kernel);
+static void run_load_profile(AppContext *app, const load_profile_t *p, double end_time);
+static int profile_wait_until(AppContext *app, double t, double end_time);
+static void report_profile_summary(AppContext *app);
+static double worker_idle(worker_t *w);
+static void run_cache_sweep(AppContext *app);
+static int assign_atomic_pairs(AppContext *app);
+static void report_atomic_summary(AppContext *app);
+static void run_c2c_matrix(AppContext *app);
+static int open_io_engine(AppContext *app);
+static void report_io_summary(AppContext *app);
+static int start_jitter_probes(AppContext *app);
+static void report_jitter_summary(AppContext *app);
+static int wait_start_at(AppContext *app);
+
+/* --- Contexto da Aplicação --- */
+
+AppContext *app_context_create(void){
+    // Allocate and zero out the main application structure
+    AppContext *app = calloc(1, sizeof(AppContext));
+    if (!app) return NULL;
+
+    // Initialize mutexes
+    g_mutex_init(&app->cpu_mutex);
+    g_mutex_init(&app->history_mutex);
+    g_mutex_init(&app->temp_mutex);
+    g_mutex_init(&app->system_history_mutex);
+
+    // Set default configuration
+    app->mem_mib_per_thread = DEFAULT_MEM_MIB;
+    app->duration_sec = DEFAULT_DURATION_SEC;
+    app->sample_interval_ms = CPU_SAMPLE_INTERVAL_MS;
+    app->degrade_baseline_sec = DEFAULT_DEGRADE_BASELINE_SEC;
+    app->degrade_pct = DEFAULT_DEGRADE_PCT;
+    app->pin_affinity = 1;
+    app->ptr_chains = 1;
+    app->io_file_mib = IO_DEFAULT_FILE_MIB;
+    app->io_block_kib = IO_DEFAULT_BLOCK_KIB;
+    app->io_qd = IO_DEFAULT_QD;
+    app->io_read_pct = IO_DEFAULT_READ_PCT;
+    app->jitter_interval_us = JITTER_DEFAULT_INTERVAL_US;
+    app->history_len = HISTORY_SAMPLES;
+    app->temp_celsius = TEMP_UNAVAILABLE;
+    app->temp_visibility_state = -1; // -1 = unknown
+
+    // Allocate and initialize system metrics history buffers
+    app->system_history_len = CPU_HISTORY_SAMPLES;
+    app->temp_history = calloc(app->system_history_len, sizeof(double));
+    app->avg_cpu_history = calloc(app->system_history_len, sizeof(double));
+    app->avg_freq_history = calloc(app->system_history_len, sizeof(double));
+    app->throttle_thermal_history = calloc(app->system_history_len, sizeof(int));
+    app->throttle_power_history = calloc(app->system_history_len, sizeof(int));
+    app->io_mbps_history = calloc(app->system_history_len, sizeof(double));
+    if (!app->temp_history || !app->avg_cpu_history || !app->avg_freq_history ||
+        !app->throttle_thermal_history || !app->throttle_power_history || !app->io_mbps_history) {
+        app_context_free(app);
+        return NULL;
+    }
+    return app;
+}
+
+void app_context_free(AppContext *app){
+    if (!app) return;
+    if (app->core_temp_labels) {
+        for (int i = 0; i < app->core_temp_count; ++i) g_free(app->core_temp_labels[i]);
+        g_free(app->core_temp_labels);
+    }
+    g_free(app->core_temps);
+    g_mutex_clear(&app->cpu_mutex);
+    g_mutex_clear(&app->history_mutex);
+    g_mutex_clear(&app->temp_mutex);
+    g_mutex_clear(&app->system_history_mutex);
+    free(app->temp_history);
+    free(app->avg_cpu_history);
+    free(app->avg_freq_history);
+    free(app->throttle_thermal_history);
+    free(app->throttle_power_history);
+    free(app->io_mbps_history);
+    free(app->sweep);
+    free(app->c2c);
+    free(app->jitter_live);
+    free(app);
+}
 
 /* --- Implementação da Thread Controladora --- */
 
@@ -33,6 +182,12 @@ thread_return_t THREAD_CALL controller_thread_func(void *arg){
     atomic_store(&app->running, 1);
     atomic_store(&app->errors, 0);
     atomic_store(&app->total_iters, 0);
+    atomic_store(&app->workers_ready, 0);
+    atomic_store(&app->workers_go, 0);
+    atomic_store(&app->load_gate, 1u);
+    app->profile_active = 0;
+    app->iters_per_sec = 0.0;
+    app->gflops = 0.0;
     app->start_time = now_sec();
 
     int sampler_started = 0;
@@ -40,6 +195,11 @@ thread_return_t THREAD_CALL controller_thread_func(void *arg){
     int thread_history_allocated = 0;
 
     app->cpu_count = detect_cpu_count();
+    app->topology = topology_detect(app->cpu_count);
+    if (!app->topology) {
+        gui_log(app, "[Controller] Falha ao alocar topologia de CPUs.\n");
+        goto cleanup;
+    }
     app->cpu_usage = calloc(app->cpu_count, sizeof(double));
     if (!app->cpu_usage) {
         gui_log(app, "[Controller] Falha ao alocar buffer de uso de CPU.\n");
@@ -61,6 +221,19 @@ thread_return_t THREAD_CALL controller_thread_func(void *arg){
             goto cleanup;
         }
     }
+    app->cpu_freq_mhz = calloc(app->cpu_count, sizeof(double));
+    app->freq_history = calloc(app->cpu_count, sizeof(double*));
+    if (!app->cpu_freq_mhz || !app->freq_history) {
+        gui_log(app, "[Controller] Falha ao alocar histórico de frequência.\n");
+        goto cleanup;
+    }
+    for (int c = 0; c < app->cpu_count; c++) {
+        app->freq_history[c] = calloc(app->cpu_history_len, sizeof(double));
+        if (!app->freq_history[c]) {
+            gui_log(app, "[Controller] Falha ao alocar histórico de frequência para CPU %d.\n", c);
+            goto cleanup;
+        }
+    }
 #ifndef _WIN32
     app->prev_cpu_samples = calloc(app->cpu_count, sizeof(cpu_sample_t));
     app->curr_cpu_samples = calloc(app->cpu_count, sizeof(cpu_sample_t));
@@ -77,46 +250,136 @@ thread_return_t THREAD_CALL controller_thread_func(void *arg){
     }
 #endif
 
-    int history_span = HISTORY_SAMPLES;
-    if (app->duration_sec > 0) {
-        history_span = app->duration_sec;
-    }
-    if (history_span <= 0) {
-        history_span = HISTORY_SAMPLES;
-    }
-    app->history_len = history_span;
+    // A janela em resolução total tem tamanho fixo; amostras mais antigas ficam no arquivo agregado.
+    app->history_len = HISTORY_SAMPLES;
     app->history_pos = 0;
-    app->thread_history = calloc(app->threads, sizeof(unsigned*));
+    app->history_seq = 0;
+    app->thread_history = calloc(app->threads, sizeof(thread_sample_t*));
     if (!app->thread_history) {
         gui_log(app, "[Controller] Falha ao alocar histórico de threads.\n");
         goto cleanup;
     }
     for (int t=0; t<app->threads; t++) {
-        app->thread_history[t] = calloc(app->history_len, sizeof(unsigned));
+        app->thread_history[t] = calloc(app->history_len, sizeof(thread_sample_t));
         if (!app->thread_history[t]) {
             gui_log(app, "[Controller] Falha ao alocar histórico para thread %d.\n", t);
             goto cleanup;
         }
         thread_history_allocated++;
     }
+    app->history_time = calloc(app->history_len, sizeof(double));
+    if (!app->history_time) {
+        gui_log(app, "[Controller] Falha ao alocar os instantes do histórico.\n");
+        goto cleanup;
+    }
+    app->history_archive = history_archive_create(app->threads);
+    if (!app->history_archive) {
+        gui_log(app, "[Controller] Falha ao alocar o arquivo do histórico.\n");
+        goto cleanup;
+    }
+
+    app->thread_gflops = calloc(app->threads, sizeof(double));
+    app->thread_flops_last = calloc(app->threads, sizeof(unsigned long long));
+    if (!app->thread_gflops || !app->thread_flops_last) {
+        gui_log(app, "[Controller] Falha ao alocar contadores de FLOP/s.\n");
+        goto cleanup;
+    }
+
+    app->fp_engine = fp_engine_select();
 
-    app->workers = calloc(app->threads, sizeof(worker_t));
+    app->workers = aligned_calloc(app->threads, sizeof(worker_t), WORKER_ALIGN);
     app->worker_threads = calloc(app->threads, sizeof(thread_handle_t));
     if (!app->workers || !app->worker_threads) {
         gui_log(app, "[Controller] Falha ao alocar estruturas de worker.\n");
         goto cleanup;
     }
+    if (app->ptr_chains < 1) app->ptr_chains = 1;
+    if (app->ptr_chains > PTR_MAX_CHAINS) app->ptr_chains = PTR_MAX_CHAINS;
+    app->ptr_ns_per_load = 0.0;
+    app->ptr_steps_last = app->ptr_ns_last = 0;
+    app->ptr_mloads = 0.0;
+    app->ptr_loads_last = 0;
+    app->atomic_mops = 0.0;
+    app->atomic_ops_last = 0;
+    app->io_iops = app->io_mbps = 0.0;
+    app->io_p50_us = app->io_p99_us = app->io_p999_us = 0.0;
+    atomic_store(&app->verify_logged, 0);
+    g_mutex_lock(&app->history_mutex);
+    free(app->jitter_live);
+    app->jitter_live = NULL;
+    g_mutex_unlock(&app->history_mutex);
+    app->int_gops = 0.0;
+    app->int_ops_last = 0;
+    app->stream_gbps = 0.0;
+    app->stream_bytes_last = app->stream_ns_last = 0;
+    memset(app->perf_last, 0, sizeof(app->perf_last));
+    memset(app->perf_interval, 0, sizeof(app->perf_interval));
     for (int i=0; i<app->threads; i++){
-        app->workers[i] = (worker_t){ .tid = i, .app = app };
+        app->workers[i] = (worker_t){ .tid = i, .app = app, .ptr_chains = app->ptr_chains };
         app->workers[i].buf_bytes = app->mem_mib_per_thread * 1024ULL * 1024ULL;
         atomic_init(&app->workers[i].status, WORKER_OK);
     }
+    assign_worker_cpus(app);
+    if (assign_worker_roles(app) != 0) {
+        atomic_fetch_add(&app->errors, 1);
+        goto cleanup;
+    }
+    if (app->export_path[0]) {
+        app->telemetry = telemetry_open(app->export_path, app->export_format);
+        if (!app->telemetry) {
+            gui_log(app, "[EXPORT] Falha ao criar o arquivo de exportação '%s'.\n", app->export_path);
+            atomic_fetch_add(&app->errors, 1);
+            goto cleanup;
+        }
+        gui_log(app, "[EXPORT] Exportando cada amostra (%s) para %s\n",
+                app->export_format == TELEMETRY_JSONL ? "JSON Lines" : "CSV", app->export_path);
+    }
 
-    if (thread_create(&app->cpu_sampler_thread, cpu_sampler_thread_func, app) != 0){
-        gui_log(app, "[Controller] Falha ao iniciar thread de métricas.\n");
+    if (app->sweep_max_mib > 0) {
+        // A varredura substitui o teste de estresse: nenhum worker nem amostrador é criado.
+        run_cache_sweep(app);
         goto cleanup;
     }
-    sampler_started = 1;
+    if (app->c2c_en) {
+        run_c2c_matrix(app);
+        goto cleanup;
+    }
+    if (app->kernel_atomic_en && assign_atomic_pairs(app) != 0) {
+        atomic_fetch_add(&app->errors, 1);
+        goto cleanup;
+    }
+    if (app->io_path[0] && open_io_engine(app) != 0) goto cleanup;
+    if (app->kernel_fpu_en) {
+        if (app->fp_block_kib > 0) {
+            gui_log(app, "[FPU] Motor %s (%d double(s) por vetor), bloco de %zu KiB em cache\n",
+                    app->fp_engine->name, app->fp_engine->lanes, app->fp_block_kib);
+        } else {
+            gui_log(app, "[FPU] Motor %s (%d double(s) por vetor), %d cadeias de FMA em registradores\n",
+                    app->fp_engine->name, app->fp_engine->lanes, FP_CHAINS);
+        }
+    }
+    // Na verificação o kernel STREAM lê o que regrava; stores não-temporais e prefetch não se aplicam.
+    if (app->kernel_stream_en && !app->verify_en) {
+        if (app->stream_nt && !stream_nt_supported()) {
+            gui_log(app, "[STREAM] Stores não-temporais indisponíveis nesta arquitetura; usando stores comuns.\n");
+        }
+        gui_log(app, "[STREAM] Stores %s, prefetch de software %s\n",
+                (app->stream_nt && stream_nt_supported()) ? "não-temporais" : "comuns",
+                app->stream_prefetch ? "ligado" : "desligado");
+    }
+
+    load_profile_t profile = { .kind = PROFILE_NONE };
+    if (app->load_profile[0]) {
+        if (profile_parse(app->load_profile, &profile) != 0) {
+            gui_log(app, "[PROFILE] Perfil de carga inválido: '%s'.\n", app->load_profile);
+            atomic_fetch_add(&app->errors, 1);
+            goto cleanup;
+        }
+        char desc[256];
+        profile_describe(&profile, desc, sizeof(desc));
+        gui_log(app, "[PROFILE] Carga modulada: %s, com bordas simultâneas em todos os workers\n", desc);
+        app->profile_active = 1;
+    }
 
     for (int i=0; i<app->threads; i++){
         if (thread_create(&app->worker_threads[i], worker_main, &app->workers[i]) != 0){
@@ -125,24 +388,57 @@ thread_return_t THREAD_CALL controller_thread_func(void *arg){
             goto cleanup;
         }
         workers_started++;
-        if (app->pin_affinity){
-#ifdef _WIN32
-            if(app->worker_threads[i]) SetThreadAffinityMask(app->worker_threads[i], (DWORD_PTR)(1ULL << (i % app->cpu_count)));
-#else
-            cpu_set_t set; CPU_ZERO(&set); CPU_SET(i % app->cpu_count, &set);
-            pthread_setaffinity_np(app->worker_threads[i], sizeof(cpu_set_t), &set);
-#endif
+        // A fixação de CPU é feita pelo próprio worker antes de alocar seus buffers (ver worker_main).
+    }
+
+    // Aguarda todos os workers inicializarem; a duração, o amostrador e o histórico
+    // partem daqui, sem amostras frias do período de preenchimento dos buffers.
+    double init_start = now_sec();
+    while (atomic_load(&app->workers_ready) < app->threads && atomic_load(&app->running)) {
+        struct timespec r = {0, 1000000}; nanosleep(&r, NULL);
+    }
+    if (!atomic_load(&app->running)) goto cleanup;
+    report_init_summary(app, now_sec() - init_start);
+    if (app->start_at > 0.0 && wait_start_at(app) != 0) goto cleanup;
+    app->start_time = now_sec();
+    if (app->profile_active) {
+        // A primeira janela começa na largada; os workers já a encontram publicada.
+        atomic_store(&app->load_rise_ns, (unsigned long long)(app->start_time * 1e9));
+        atomic_store(&app->load_gate, profile_level(&profile, 0.0) > 0.0 ? 1u : 0u);
+    }
+    if (app->verify_en && app->kernel_stream_en) {
+        // Os contadores do EDAC são lidos na largada, para que o resumo mostre só os erros do teste.
+        app->verify_edac = verify_edac_read(NULL);
+        if (app->verify_edac) {
+            gui_log(app, "[VERIFY] Verificação de memória no kernel STREAM (%s); EDAC com %d DIMM(s)\n",
+                    verify_impl_name(), app->verify_edac->n);
+        } else {
+            gui_log(app, "[VERIFY] Verificação de memória no kernel STREAM (%s); EDAC indisponível\n", verify_impl_name());
         }
     }
+    atomic_store(&app->workers_go, 1);
+    if (app->io && io_engine_start(app->io) != 0) {
+        gui_log(app, "[IO] Falha ao iniciar a thread de E/S.\n");
+        atomic_fetch_add(&app->errors, 1);
+        goto cleanup;
+    }
+    if (app->jitter_en && start_jitter_probes(app) != 0) goto cleanup;
+
+    if (thread_create(&app->cpu_sampler_thread, cpu_sampler_thread_func, app) != 0){
+        gui_log(app, "[Controller] Falha ao iniciar thread de métricas.\n");
+        goto cleanup;
+    }
+    sampler_started = 1;
 
     double end_time = (app->duration_sec > 0) ? app->start_time + app->duration_sec : 0;
+    if (app->profile_active) run_load_profile(app, &profile, end_time);
     while (atomic_load(&app->running)){
         if (end_time > 0 && now_sec() >= end_time){
              gui_log(app, "[GUI] Duração de %d s atingida. Parando...\n", app->duration_sec);
              atomic_store(&app->running, 0);
              break;
         }
-        struct timespec r = {0, 200*1000000}; nanosleep(&r,NULL);
+        struct timespec r = {0, 50*1000000}; nanosleep(&r,NULL);
     }
 
 cleanup:
@@ -156,17 +452,75 @@ cleanup:
         }
     }
 
+    // As operações em voo terminam depois de running ser zerado; a thread de E/S sai em seguida.
+    io_engine_join(app->io);
+    jitter_join(app->jitter);
     if (sampler_started){
         thread_join(app->cpu_sampler_thread);
     }
 
+    if (app->workers && workers_started == app->threads && app->numa_mode != NUMA_MODE_OFF) {
+        report_numa_summary(app, now_sec() - app->start_time);
+    }
+    if (app->workers && workers_started == app->threads && app->kernel_fpu_en) {
+        report_fp_summary(app);
+    }
+    if (app->workers && workers_started == app->threads && app->kernel_int_en) {
+        report_int_summary(app);
+    }
+    if (app->workers && workers_started == app->threads && app->kernel_ptr_en) {
+        report_ptr_summary(app);
+    }
+    if (app->workers && workers_started == app->threads && app->kernel_stream_en) {
+        if (app->verify_en) report_verify_summary(app);
+        else report_stream_summary(app);
+    }
+    if (app->workers && workers_started == app->threads && app->kernel_atomic_en) {
+        report_atomic_summary(app);
+    }
+    if (app->workers && workers_started == app->threads && app->perf_en) {
+        report_perf_summary(app);
+    }
+    if (app->io) {
+        report_io_summary(app);
+    }
+    if (app->jitter && app->jitter_live) {
+        report_jitter_summary(app);
+    }
+    if (app->workers && workers_started == app->threads && app->profile_active) {
+        report_profile_summary(app);
+    }
+    free(app->verify_edac);
+    app->verify_edac = NULL;
+    if (app->telemetry) {
+        // O amostrador já terminou: a controladora é a única a enfileirar registros agora.
+        if (!app->sweep_max_mib && !app->c2c_en) telemetry_summary(app->telemetry, app);
+        unsigned long long samples = app->telemetry->samples, dropped = app->telemetry->dropped;
+        if (telemetry_close(app->telemetry) != 0) {
+            gui_log(app, "[EXPORT] Erro de escrita em '%s'; o arquivo pode estar incompleto.\n", app->export_path);
+        } else {
+            gui_log(app, "[EXPORT] %llu amostra(s) gravada(s) em %s, %llu descartada(s) por falta de espaço no buffer\n",
+                    samples, app->export_path, dropped);
+        }
+        app->telemetry = NULL;
+    }
+
     // Limpeza final dos buffers, mas NÃO da estrutura 'app'
     if (app->thread_history) {
         for (int i=0; i<thread_history_allocated; i++) free(app->thread_history[i]);
         free(app->thread_history);
         app->thread_history = NULL;
     }
-    free(app->workers); app->workers = NULL;
+    free(app->history_time); app->history_time = NULL;
+    g_mutex_lock(&app->history_mutex);
+    history_archive_free(app->history_archive); app->history_archive = NULL;
+    free(app->thread_gflops); app->thread_gflops = NULL;
+    g_mutex_unlock(&app->history_mutex);
+    free(app->thread_flops_last); app->thread_flops_last = NULL;
+    aligned_free(app->workers); app->workers = NULL;
+    aligned_free(app->atomic_lines); app->atomic_lines = NULL;
+    io_engine_close(app->io); app->io = NULL;
+    jitter_destroy(app->jitter); app->jitter = NULL;
     free(app->worker_threads); app->worker_threads = NULL;
 
     g_mutex_lock(&app->cpu_mutex);
@@ -177,22 +531,888 @@ cleanup:
         free(app->cpu_history);
         app->cpu_history = NULL;
     }
+    if (app->freq_history) {
+        for (int i = 0; i < app->cpu_count; i++) {
+            free(app->freq_history[i]);
+        }
+        free(app->freq_history);
+        app->freq_history = NULL;
+    }
+    free(app->cpu_freq_mhz); app->cpu_freq_mhz = NULL;
+    app->freq_max_mhz = 0.0;
     app->cpu_history_len = 0;
     app->cpu_history_filled = 0;
     app->cpu_history_pos = -1;
     free(app->cpu_usage); app->cpu_usage = NULL;
     g_mutex_unlock(&app->cpu_mutex);
+    topology_free(app->topology); app->topology = NULL;
 #ifndef _WIN32
     free(app->prev_cpu_samples); app->prev_cpu_samples = NULL;
     free(app->curr_cpu_samples); app->curr_cpu_samples = NULL;
 #endif
 
     // Sinaliza para a UI que o teste terminou
-    g_idle_add((GSourceFunc)gui_update_stopped, app);
+    if (!app->headless) g_idle_add((GSourceFunc)gui_update_stopped, app);
+    return 0;
+}
+
+/**
+ * @brief Escolhe a CPU de cada worker pela política configurada.
+ *
+ * Uma lista de CPUs que não cabe nesta máquina é substituída pela política
+ * padrão; se nem assim houver memória para ordenar as CPUs, usa a ordem linear.
+ */
+static void place_workers(AppContext *app, int *cpus){
+    const cpu_topology_t *topo = app->topology;
+    if (app->affinity_policy == AFFINITY_LIST) {
+        int *list = calloc(topo->cpu_count, sizeof(int));
+        int n = list ? parse_cpu_list(app->affinity_list, list, topo->cpu_count) : -1;
+        int rc = topology_place(topo, AFFINITY_LIST, list, n, app->threads, cpus);
+        free(list);
+        if (rc == 0) return;
+        gui_log(app, "[AFFINITY] Lista de CPUs '%s' inválida nesta máquina (%d CPUs); usando %s.\n",
+                app->affinity_list, topo->cpu_count, affinity_policy_name(AFFINITY_PHYSICAL_FIRST));
+        app->affinity_policy = AFFINITY_PHYSICAL_FIRST;
+    }
+    if (topology_place(topo, app->affinity_policy, NULL, 0, app->threads, cpus) == 0) return;
+    for (int i = 0; i < app->threads; i++) cpus[i] = i % app->cpu_count;
+}
+
+/**
+ * @brief Registra a topologia e o mapeamento worker -> CPU, oito workers por linha.
+ *
+ * Também conta os workers que dividem um núcleo físico com outro worker, o que
+ * explica vazões por thread menores quando há mais workers do que núcleos.
+ */
+static void log_worker_placement(AppContext *app, const int *cpus){
+    const cpu_topology_t *topo = app->topology;
+    gui_log(app, "[TOPO] %d socket(s), %d domínio(s) de L3, %d núcleo(s) físico(s), %d CPU(s) lógica(s)\n",
+            topo->package_count, topo->l3_count, topo->core_count, topo->cpu_count);
+    gui_log(app, "[AFFINITY] Política: %s\n", affinity_policy_name(app->affinity_policy));
+
+    char line[512];
+    size_t n = 0;
+    int shared = 0;
+    for (int i = 0; i < app->threads; i++) {
+        int c = cpus[i];
+        for (int j = 0; j < i; j++) {
+            if (topo->cpu_core[cpus[j]] == topo->cpu_core[c]) { shared++; break; }
+        }
+        if (n < sizeof(line)) {
+            n += snprintf(line + n, sizeof(line) - n, "%sT%d→CPU %d (núcleo %d, L3 %d, socket %d)",
+                          n ? " | " : "", i, c, topo->cpu_core[c], topo->cpu_l3[c], topo->cpu_package[c]);
+        }
+        if ((i + 1) % 8 == 0 || i + 1 == app->threads) {
+            gui_log(app, "[AFFINITY] %s\n", line);
+            n = 0;
+        }
+    }
+    if (shared > 0) {
+        gui_log(app, "[AFFINITY] %d worker(s) dividem um núcleo físico (SMT) com outro worker.\n", shared);
+    }
+}
+
+/**
+ * @brief Define a CPU de execução e a CPU de posicionamento de memória de cada worker.
+ *
+ * Sem fixação, os workers ficam livres (`cpu = -1`). Com fixação, a política de
+ * posicionamento (`affinity_policy_t`) decide a CPU de cada worker. Com um modo NUMA
+ * ativo a fixação é obrigatória, pois o posicionamento depende de saber em que nó a
+ * thread está quando toca seus buffers pela primeira vez.
+ */
+static void assign_worker_cpus(AppContext *app){
+    if (app->numa_mode != NUMA_MODE_OFF && !app->pin_affinity) {
+        gui_log(app, "[NUMA] O modo NUMA requer fixação de CPU; fixando as threads.\n");
+        app->pin_affinity = 1;
+    }
+    if (app->c2c_en && !app->pin_affinity) {
+        gui_log(app, "[C2C] A matriz de latência requer fixação de CPU; fixando as threads.\n");
+        app->pin_affinity = 1;
+    }
+    if (app->numa_mode == NUMA_MODE_REMOTE && app->topology->node_count <= 1) {
+        gui_log(app, "[NUMA] Apenas um nó NUMA detectado; o modo remoto se comporta como local.\n");
+    }
+    if (app->numa_mode != NUMA_MODE_OFF) {
+        gui_log(app, "[NUMA] %d nó(s) detectado(s), modo %s.\n", app->topology->node_count,
+                app->numa_mode == NUMA_MODE_REMOTE ? "remoto" : "local");
+    }
+
+    int *cpus = app->pin_affinity ? calloc(app->threads, sizeof(int)) : NULL;
+    if (app->pin_affinity && !cpus) {
+        gui_log(app, "[AFFINITY] Falha ao alocar o mapa de CPUs; usando ordem linear.\n");
+    } else if (cpus) {
+        place_workers(app, cpus);
+        log_worker_placement(app, cpus);
+    }
+
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        w->cpu = app->pin_affinity ? (cpus ? cpus[i] : i % app->cpu_count) : -1;
+        w->mem_cpu = w->cpu;
+        if (app->numa_mode == NUMA_MODE_REMOTE && w->cpu >= 0) {
+            int remote = topology_remote_cpu(app->topology, w->cpu);
+            if (remote >= 0) w->mem_cpu = remote;
+        }
+        w->node = topology_cpu_node(app->topology, w->cpu);
+        w->mem_node = topology_cpu_node(app->topology, w->mem_cpu);
+        if (app->numa_mode != NUMA_MODE_OFF) {
+            gui_log(app, "[NUMA] T%d: CPU %d (nó %d), memória no nó %d\n", i, w->cpu, w->node, w->mem_node);
+        }
+    }
+    free(cpus);
+}
+
+/**
+ * @brief Define os kernels de cada worker a partir dos papéis configurados.
+ *
+ * Os kernels habilitados (`kernel_*_en`) são os dos workers sem papel; ao final,
+ * eles passam a refletir a união dos kernels de todos os workers, para que as
+ * taxas e os resumos mostrem exatamente os kernels em execução.
+ * @return 0 em caso de sucesso, -1 se os papéis forem inválidos ou faltar memória.
+ */
+static int assign_worker_roles(AppContext *app){
+    unsigned defaults = (app->kernel_fpu_en ? WORK_FPU : 0) | (app->kernel_int_en ? WORK_INT : 0) |
+                        (app->kernel_stream_en ? WORK_STREAM : 0) | (app->kernel_ptr_en ? WORK_PTR : 0) |
+                        (app->kernel_atomic_en ? WORK_ATOMIC : 0);
+    for (int i = 0; i < app->threads; i++) app->workers[i].kernels = defaults;
+    if (!app->worker_roles[0]) return 0;
+
+    unsigned *masks = calloc(app->threads, sizeof(unsigned));
+    int *cpus = calloc(app->threads, sizeof(int));
+    if (!masks || !cpus) {
+        gui_log(app, "[ROLES] Falha ao alocar os papéis dos workers.\n");
+        free(masks);
+        free(cpus);
+        return -1;
+    }
+    for (int i = 0; i < app->threads; i++) cpus[i] = app->workers[i].cpu;
+    char err[160];
+    int rc = roles_assign(app->worker_roles, defaults, app->topology, cpus, app->threads, masks, err, sizeof(err));
+    if (rc != 0) {
+        gui_log(app, "[ROLES] Papéis inválidos '%s': %s.\n", app->worker_roles, err);
+    } else {
+        unsigned all = 0;
+        for (int i = 0; i < app->threads; i++) {
+            app->workers[i].kernels = masks[i];
+            all |= masks[i];
+        }
+        app->kernel_fpu_en = (all & WORK_FPU) != 0;
+        app->kernel_int_en = (all & WORK_INT) != 0;
+        app->kernel_stream_en = (all & WORK_STREAM) != 0;
+        app->kernel_ptr_en = (all & WORK_PTR) != 0;
+        app->kernel_atomic_en = (all & WORK_ATOMIC) != 0;
+        char line[512];
+        roles_format(masks, app->threads, line, sizeof(line));
+        gui_log(app, "[ROLES] %s\n", line);
+    }
+    free(masks);
+    free(cpus);
+    return rc;
+}
+
+/**
+ * @brief Forma os pares de ping-pong do kernel ATOMIC e aloca as linhas compartilhadas.
+ *
+ * Os workers que executam o kernel são pareados na ordem dos índices (o 1º com o
+ * 2º, o 3º com o 4º...), de modo que a afinidade e os papéis decidem quais núcleos
+ * trocam a linha; com um número ímpar, o último fica só com o fetch-add e o CAS.
+ * @return 0 em caso de sucesso, -1 se faltar memória.
+ */
+static int assign_atomic_pairs(AppContext *app){
+    int count = 0, pairs = 0;
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        w->atomic_pair = -1;
+        w->atomic_side = 0;
+        if (!(w->kernels & WORK_ATOMIC)) continue;
+        if (count % 2 == 1) {
+            w->atomic_pair = pairs++;
+            w->atomic_side = 1;
+            for (int j = i - 1; j >= 0; j--) {
+                if (app->workers[j].kernels & WORK_ATOMIC) { app->workers[j].atomic_pair = w->atomic_pair; break; }
+            }
+        }
+        count++;
+    }
+    app->atomic_lines = aligned_calloc(ATOMIC_LINE_PAIRS + (size_t)pairs, sizeof(shared_line_t), WORKER_ALIGN);
+    if (!app->atomic_lines) {
+        gui_log(app, "[ATOMIC] Falha ao alocar as linhas compartilhadas.\n");
+        return -1;
+    }
+
+    char line[512];
+    size_t n = (size_t)snprintf(line, sizeof(line), "[ATOMIC] %d worker(s) disputando as linhas de fetch-add e CAS; "
+                                "%d par(es) de ping-pong:", count, pairs);
+    for (int i = 0; i < app->threads && n < sizeof(line); i++) {
+        worker_t *w = &app->workers[i];
+        if (w->atomic_pair < 0 || w->atomic_side != 0) continue;
+        for (int j = i + 1; j < app->threads; j++) {
+            worker_t *o = &app->workers[j];
+            if (o->atomic_pair != w->atomic_pair) continue;
+            n += (size_t)snprintf(line + n, sizeof(line) - n, " T%d-T%d", i, j);
+            if (w->cpu >= 0 && o->cpu >= 0 && n < sizeof(line)) {
+                n += (size_t)snprintf(line + n, sizeof(line) - n, " (CPU %d-%d)", w->cpu, o->cpu);
+            }
+            break;
+        }
+    }
+    if (pairs == 0 && n < sizeof(line)) snprintf(line + n, sizeof(line) - n, " nenhum");
+    gui_log(app, "%s\n", line);
+    return 0;
+}
+
+/**
+ * @brief Registra quanto tempo os workers levaram para alocar e preencher seus buffers.
+ *
+ * `elapsed` é a espera da controladora na barreira de partida; o worker mais
+ * lento é informado porque é ele quem atrasa a largada de todos.
+ */
+static void report_init_summary(AppContext *app, double elapsed){
+    int slowest = -1;
+    for (int i = 0; i < app->threads; i++) {
+        if (atomic_load(&app->workers[i].status) != WORKER_OK) continue;
+        if (slowest < 0 || app->workers[i].init_sec > app->workers[slowest].init_sec) slowest = i;
+    }
+    if (slowest < 0) return;
+    gui_log(app, "[INIT] %d worker(s) prontos em %.3f s (mais lento: T%d, %.3f s, %zu MiB por thread)\n",
+            app->threads, elapsed, slowest, app->workers[slowest].init_sec, app->mem_mib_per_thread);
+}
+
+/**
+ * @brief Segura a largada até `start_at`, o instante combinado com os demais nós da frota.
+ *
+ * Os buffers já estão prontos, de modo que todos os nós partem juntos; um nó
+ * que terminou a inicialização depois do instante parte na hora e registra o atraso.
+ *
+ * @return 0 na largada, -1 se o teste foi parado durante a espera.
+ */
+static int wait_start_at(AppContext *app){
+    double late = now_sec() - app->start_at;
+    if (late > 0.0) {
+        gui_log(app, "[FLEET] A inicialização terminou %.0f ms depois da largada combinada.\n", late * 1e3);
+        return 0;
+    }
+    gui_log(app, "[FLEET] Aguardando a largada combinada em %.1f s\n", -late);
+    // Em fatias, para que a parada durante a espera seja atendida logo; a última vai até o instante exato.
+    while (atomic_load(&app->running) && now_sec() < app->start_at - 0.1) {
+        struct timespec r = {0, 50 * 1000000}; nanosleep(&r, NULL);
+    }
+    if (!atomic_load(&app->running)) return -1;
+    sleep_until(app->start_at);
+    return 0;
+}
+
+/* --- Perfis de Carga --- */
+
+/**
+ * @brief Espera até o instante `t`: dorme até `PROFILE_SPIN_SEC` antes e espera ativamente o resto.
+ *
+ * O sono é feito em passos de no máximo `PROFILE_POLL_SEC`, para notar uma parada.
+ * @return 1 no instante `t`, 0 se o teste parou ou a duração terminou antes dele.
+ */
+static int profile_wait_until(AppContext *app, double t, double end_time){
+    int reach = !(end_time > 0 && t >= end_time);
+    double target = reach ? t : end_time;
+    for (;;) {
+        if (!atomic_load(&app->running)) return 0;
+        double now = now_sec();
+        if (now >= target - PROFILE_SPIN_SEC) break;
+        double wake = target - PROFILE_SPIN_SEC;
+        if (wake > now + PROFILE_POLL_SEC) wake = now + PROFILE_POLL_SEC;
+        sleep_until(wake);
+    }
+    while (now_sec() < target) cpu_relax();
+    return reach;
+}
+
+/**
+ * @brief Publica as bordas do perfil de carga até o fim do teste.
+ *
+ * Cada janela começa com a subida da carga (se o nível for positivo), e a descida
+ * vem após a fração `nível` da janela. A controladora dorme até pouco antes de cada
+ * borda e espera ativamente o resto, para publicá-la no instante previsto; todos os
+ * workers a observam pela mesma palavra, `load_gate`. As subidas são simultâneas;
+ * as descidas acontecem ao fim do quantum em curso de cada worker (~1 ms).
+ */
+static void run_load_profile(AppContext *app, const load_profile_t *p, double end_time){
+    unsigned gate = atomic_load(&app->load_gate);
+    unsigned long long edges = 0;
+    double lag_sum = 0.0, lag_max = 0.0, logged = -1.0;
+    for (unsigned long long k = 0; atomic_load(&app->running); k++) {
+        double w0 = app->start_time + (double)k * p->period;
+        double level = profile_level(p, (double)k * p->period);
+        for (int fall = 0; fall < 2; fall++) {
+            if (fall && (level <= 0.0 || level >= 1.0)) break;
+            double edge = fall ? w0 + level * p->period : w0;
+            unsigned busy = (!fall && level > 0.0) ? 1u : 0u;
+            if (!profile_wait_until(app, edge, end_time)) goto done;
+            // Quem ficar ocioso a partir daqui espera a próxima janela.
+            atomic_store_explicit(&app->load_rise_ns, (unsigned long long)((w0 + p->period) * 1e9), memory_order_relaxed);
+            if ((gate & 1u) != busy) {
+                gate = ((gate & ~1u) + 2u) | busy;
+                atomic_store_explicit(&app->load_gate, gate, memory_order_release);
+                double lag = now_sec() - edge;
+                lag_sum += lag;
+                if (lag > lag_max) lag_max = lag;
+                edges++;
+            }
+            // A rampa é registrada a cada 10 pontos percentuais; os demais perfis, a cada mudança.
+            if (!fall && level != logged &&
+                (p->kind != PROFILE_RAMP || fabs(level - logged) >= 0.1 || level == p->to)) {
+                gui_log(app, "[PROFILE] %7.1fs: nível %.0f%%\n", w0 - app->start_time, level * 100.0);
+                logged = level;
+            }
+        }
+    }
+done:
+    if (edges > 0) {
+        gui_log(app, "[PROFILE] %llu borda(s) publicada(s), atraso médio de %.1f µs, máximo de %.1f µs\n",
+                edges, lag_sum / edges * 1e6, lag_max * 1e6);
+    }
+}
+
+/**
+ * @brief Registra a ocupação medida de cada worker sob o perfil de carga.
+ *
+ * A ocupação é a fração do laço de estresse fora da espera imposta pelo perfil e
+ * é comparada com a média dos níveis das janelas decorridas.
+ */
+static void report_profile_summary(AppContext *app){
+    load_profile_t p;
+    if (profile_parse(app->load_profile, &p) != 0) return;
+    int lo = -1, hi = -1, n = 0;
+    double sum = 0.0, lag_max = 0.0, span = 0.0, lo_busy = 0.0, hi_busy = 0.0;
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        double run = w->run_end - w->run_start;
+        if (atomic_load(&w->status) != WORKER_OK || run <= 0.0) continue;
+        double busy = 1.0 - w->idle_sec / run;
+        if (lo < 0 || busy < lo_busy) { lo = i; lo_busy = busy; }
+        if (hi < 0 || busy > hi_busy) { hi = i; hi_busy = busy; }
+        if (w->edge_lag_max > lag_max) lag_max = w->edge_lag_max;
+        if (run > span) span = run;
+        sum += busy;
+        n++;
+    }
+    if (n == 0) return;
+    double expected = 0.0;
+    for (unsigned long long k = 0; (double)k * p.period < span; k++) {
+        double t = (double)k * p.period;
+        double win = span - t < p.period ? span - t : p.period;
+        double on = profile_level(&p, t) * p.period;
+        expected += on < win ? on : win;
+    }
+    gui_log(app, "[PROFILE] Ocupação medida: %.1f%% em média (T%d %.1f%% a T%d %.1f%%), esperada %.1f%%; "
+            "retomada até %.0f µs após cada subida\n", sum / n * 100.0, lo, lo_busy * 100.0, hi, hi_busy * 100.0,
+            expected / span * 100.0, lag_max * 1e6);
+}
+
+/**
+ * @brief Registra a vazão agregada por nó NUMA ao final do teste.
+ *
+ * Os workers são agrupados pelo nó em que executaram; o nó da memória é
+ * informado junto para distinguir execuções locais de remotas. Além das
+ * iterações, cada nó traz a banda do STREAM (soma dos workers, que executam
+ * concorrentemente) e a latência média por carga dependente do kernel PTR.
+ */
+static void report_numa_summary(AppContext *app, double elapsed){
+    if (elapsed <= 0.0) return;
+    for (int node = 0; node < app->topology->node_count; node++) {
+        int count = 0, mem_node = -1;
+        unsigned long long iters = 0, ptr_steps = 0, ptr_ns = 0;
+        double stream_gbps = 0.0;
+        for (int i = 0; i < app->threads; i++) {
+            worker_t *w = &app->workers[i];
+            if (w->node != node) continue;
+            count++;
+            iters += atomic_load(&w->iters);
+            unsigned long long ns = atomic_load(&w->stream_ns);
+            if (ns > 0) stream_gbps += (double)atomic_load(&w->stream_bytes) / (double)ns;
+            ptr_steps += atomic_load(&w->ptr_steps);
+            ptr_ns += atomic_load(&w->ptr_ns);
+            if (mem_node < 0) mem_node = w->mem_node;
+        }
+        if (count == 0) continue;
+        char mem[96] = "";
+        int n = 0;
+        if (stream_gbps > 0.0) n += snprintf(mem + n, sizeof(mem) - n, ", STREAM %.2f GB/s", stream_gbps);
+        if (ptr_steps > 0) snprintf(mem + n, sizeof(mem) - n, ", PTR %.1f ns por carga dependente", (double)ptr_ns / (double)ptr_steps);
+        gui_log(app, "[NUMA] Nó %d (memória no nó %d): %d worker(s), %.1f iters/s (%.1f por worker)%s\n",
+                node, mem_node, count, iters / elapsed, iters / elapsed / count, mem);
+    }
+}
+
+/**
+ * @brief Registra os GFLOP/s obtidos por cada worker e o total ao final do teste.
+ *
+ * Cada taxa usa o intervalo em que o próprio worker esteve no laço de estresse,
+ * de modo que o tempo de inicialização dos buffers não a dilui.
+ */
+static void report_fp_summary(AppContext *app){
+    double total = 0.0;
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        double dt = w->run_end - w->run_start;
+        if (dt <= 0.0 || !(w->kernels & WORK_FPU)) continue;
+        double gflops = (double)atomic_load(&w->flops) / dt / 1e9;
+        total += gflops;
+        gui_log(app, "[FPU] T%d: %.2f GFLOP/s\n", i, gflops);
+    }
+    gui_log(app, "[FPU] Total: %.2f GFLOP/s (%s)\n", total, app->fp_engine ? app->fp_engine->name : "n/d");
+}
+
+/**
+ * @brief Registra as operações de inteiros por segundo de cada worker e o total ao final do teste.
+ */
+static void report_int_summary(AppContext *app){
+    double total = 0.0;
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        double dt = w->run_end - w->run_start;
+        if (dt <= 0.0 || !(w->kernels & WORK_INT)) continue;
+        double gops = (double)atomic_load(&w->int_ops) / dt / 1e9;
+        total += gops;
+        gui_log(app, "[INT] T%d: %.2f Gops/s\n", i, gops);
+    }
+    gui_log(app, "[INT] Total: %.2f Gops/s\n", total);
+}
+
+/**
+ * @brief Registra a latência por carga dependente de cada worker ao final do teste.
+ *
+ * O tempo por passo de uma cadeia é a latência de uma carga dependente; dividido
+ * pelo número de cadeias, dá o custo efetivo por carga quando há paralelismo de memória.
+ */
+static void report_ptr_summary(AppContext *app){
+    unsigned long long steps_sum = 0, ns_sum = 0;
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        unsigned long long steps = atomic_load(&w->ptr_steps);
+        unsigned long long ns = atomic_load(&w->ptr_ns);
+        if (steps == 0) continue;
+        steps_sum += steps;
+        ns_sum += ns;
+        double per_step = (double)ns / (double)steps;
+        gui_log(app, "[PTR] T%d: %.1f ns por carga dependente (%d cadeia(s), %.2f ns por carga efetiva, %.1f MiB)\n",
+                i, per_step, w->ptr_chains, per_step / w->ptr_chains,
+                (double)(w->ptr_nodes * CACHE_LINE_SIZE) / (1024.0 * 1024.0));
+    }
+    if (steps_sum > 0) {
+        gui_log(app, "[PTR] Média: %.1f ns por carga dependente\n", (double)ns_sum / (double)steps_sum);
+    }
+}
+
+/**
+ * @brief Registra a banda sustentada de cada operação STREAM, por worker e do sistema.
+ *
+ * A banda de cada worker usa apenas o tempo passado dentro da operação; a do
+ * sistema é a soma dos workers, que executam concorrentemente.
+ */
+static void report_stream_summary(AppContext *app){
+    double system[STREAM_OPS] = {0};
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        if (!(w->kernels & WORK_STREAM)) continue;
+        double gbps[STREAM_OPS] = {0};
+        for (int op = 0; op < STREAM_OPS; op++) {
+            if (w->stream_op_ns[op] > 0) gbps[op] = (double)w->stream_op_bytes[op] / (double)w->stream_op_ns[op];
+            system[op] += gbps[op];
+        }
+        gui_log(app, "[STREAM] T%d: Copy %.2f | Scale %.2f | Add %.2f | Triad %.2f GB/s\n",
+                i, gbps[STREAM_COPY], gbps[STREAM_SCALE], gbps[STREAM_ADD], gbps[STREAM_TRIAD]);
+    }
+    gui_log(app, "[STREAM] Sistema: Copy %.2f | Scale %.2f | Add %.2f | Triad %.2f GB/s\n",
+            system[STREAM_COPY], system[STREAM_SCALE], system[STREAM_ADD], system[STREAM_TRIAD]);
+}
+
+/**
+ * @brief Registra a banda e as divergências da verificação de memória, por worker e do sistema.
+ *
+ * Compara também os contadores do EDAC com os da largada: um DIMM cujos erros
+ * corrigidos ou não corrigidos subiram durante o teste é nomeado pelo rótulo, e
+ * esses erros entram em `errors`.
+ */
+static void report_verify_summary(AppContext *app){
+    double system = 0.0;
+    unsigned long long mismatches = 0;
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        if (!w->vf_base) continue;
+        unsigned long long ns = atomic_load(&w->stream_ns);
+        double gbps = ns > 0 ? (double)atomic_load(&w->stream_bytes) / (double)ns : 0.0;
+        system += gbps;
+        mismatches += w->verify_mismatches;
+        gui_log(app, "[VERIFY] T%d: %.2f GB/s, %llu passagem(ns) completa(s) por %.0f MiB, %llu divergência(s)\n",
+                i, gbps, w->verify_passes, (double)(w->vf_n * sizeof(uint64_t)) / (1024.0 * 1024.0), w->verify_mismatches);
+    }
+    int logged = atomic_load(&app->verify_logged);
+    gui_log(app, "[VERIFY] Sistema: %.2f GB/s, %llu divergência(s)%s\n", system, mismatches,
+            mismatches > 0 ? (logged > VERIFY_LOG_MAX ? ", apenas as primeiras detalhadas no log" : "") : ", memória íntegra");
+
+    if (!app->verify_edac) return;
+    verify_edac_t *now = verify_edac_read(NULL);
+    if (!now) return;
+    for (int i = 0; i < app->verify_edac->n; i++) {
+        const verify_dimm_t *a = &app->verify_edac->dimm[i];
+        for (int j = 0; j < now->n; j++) {
+            const verify_dimm_t *b = &now->dimm[j];
+            if (strcmp(a->name, b->name) != 0) continue;
+            unsigned long long ce = b->ce > a->ce ? b->ce - a->ce : 0;
+            unsigned long long ue = b->ue > a->ue ? b->ue - a->ue : 0;
+            if (ce || ue) {
+                gui_log(app, "[VERIFY] EDAC %s (%s): %llu erro(s) corrigido(s), %llu não corrigido(s) durante o teste\n",
+                        b->label, b->name, ce, ue);
+                atomic_fetch_add(&app->errors, (int)((ce + ue) > INT_MAX ? INT_MAX : (ce + ue)));
+            }
+            break;
+        }
+    }
+    free(now);
+}
+
+/**
+ * @brief Registra as operações atômicas de cada worker, a taxa de falhas do CAS e a ida e volta do ping-pong.
+ *
+ * A taxa do sistema é a soma dos workers; como todos disputam as mesmas linhas, ela
+ * mostra o custo de coerência, e não a capacidade de cada núcleo.
+ */
+static void report_atomic_summary(AppContext *app){
+    double total = 0.0;
+    unsigned long long rounds = 0, ns = 0;
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        double dt = w->run_end - w->run_start;
+        if (dt <= 0.0 || !(w->kernels & WORK_ATOMIC)) continue;
+        unsigned long long ops = atomic_load(&w->atomic_ops);
+        double mops = (double)ops / dt / 1e6;
+        total += mops;
+        // Um quarto das operações é CAS; uma falha é uma tentativa a mais sobre elas.
+        double cas = (double)(ATOMIC_OPS_PER_QUANTUM / 4) * (double)(ops / ATOMIC_OPS_PER_QUANTUM);
+        double fail_pct = cas > 0.0 ? 100.0 * (double)w->cas_fails / (cas + (double)w->cas_fails) : 0.0;
+        if (w->pp_rounds > 0) {
+            gui_log(app, "[ATOMIC] T%d: %.1f Mops/s, %.1f%% dos CAS falharam, ping-pong %.0f ns por ida e volta (par %d)\n",
+                    i, mops, fail_pct, (double)w->pp_ns / (double)w->pp_rounds, w->atomic_pair);
+            rounds += w->pp_rounds;
+            ns += w->pp_ns;
+        } else {
+            gui_log(app, "[ATOMIC] T%d: %.1f Mops/s, %.1f%% dos CAS falharam%s\n",
+                    i, mops, fail_pct, w->atomic_pair < 0 ? ", sem par de ping-pong" : "");
+        }
+    }
+    if (rounds > 0) {
+        gui_log(app, "[ATOMIC] Total: %.1f Mops/s, ping-pong médio %.0f ns por ida e volta\n", total, (double)ns / (double)rounds);
+    } else {
+        gui_log(app, "[ATOMIC] Total: %.1f Mops/s\n", total);
+    }
+}
+
+/**
+ * @brief Registra IPC e falhas por mil instruções (MPKI) de cada worker e de cada kernel.
+ *
+ * Os contadores medem apenas o modo usuário, então o tempo gasto em chamadas de
+ * sistema (inclusive as leituras dos próprios contadores) não entra nas razões.
+ */
+static void report_perf_summary(AppContext *app){
+    unsigned long long kernels[KERNEL_COUNT][PERF_COUNTER_COUNT] = {{0}};
+    int counted = 0;
+    for (int i = 0; i < app->threads; i++) {
+        worker_t *w = &app->workers[i];
+        if (!w->perf_mask) continue;
+        unsigned long long total[PERF_COUNTER_COUNT] = {0};
+        for (int k = 0; k < KERNEL_COUNT; k++) {
+            for (int e = 0; e < PERF_COUNTER_COUNT; e++) {
+                unsigned long long v = atomic_load(&w->perf[k][e]);
+                kernels[k][e] += v;
+                total[e] += v;
+            }
+        }
+        gui_log(app, "[PERF] T%d: IPC %.2f | LLC %.2f | dTLB %.2f | desvios %.2f MPKI\n", i, perf_ipc(total),
+                perf_mpki(total, PERF_LLC_MISSES), perf_mpki(total, PERF_DTLB_MISSES), perf_mpki(total, PERF_BRANCH_MISSES));
+        counted++;
+    }
+    if (counted == 0) return;
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        if (kernels[k][PERF_CYCLES] == 0) continue;
+        gui_log(app, "[PERF] %s: IPC %.2f | LLC %.2f | dTLB %.2f | desvios %.2f MPKI\n", kernel_name(k), perf_ipc(kernels[k]),
+                perf_mpki(kernels[k], PERF_LLC_MISSES), perf_mpki(kernels[k], PERF_DTLB_MISSES), perf_mpki(kernels[k], PERF_BRANCH_MISSES));
+    }
+}
+
+/**
+ * @brief Atribui a `kernel` os contadores de hardware acumulados desde a leitura anterior.
+ *
+ * Apenas a própria thread escreve `w->perf`, então a soma é um load e um store relaxados.
+ * @param last Os valores da leitura anterior, regravados com a leitura atual.
+ */
+static void perf_attribute(worker_t *w, const perf_group_t *g, unsigned long long *last, int kernel){
+    unsigned long long now[PERF_COUNTER_COUNT];
+    if (perf_group_read(g, now) != 0) return;
+    for (int e = 0; e < PERF_COUNTER_COUNT; e++) {
+        // A correção de multiplexação pode fazer um valor escalado recuar um pouco.
+        if (now[e] > last[e]) {
+            unsigned long long v = atomic_load_explicit(&w->perf[kernel][e], memory_order_relaxed);
+            atomic_store_explicit(&w->perf[kernel][e], v + (now[e] - last[e]), memory_order_relaxed);
+        }
+        last[e] = now[e];
+    }
+}
+
+/**
+ * @brief Escreve um byte em cada página de `p`, forçando a alocação física (first-touch).
+ *
+ * Chamado com a thread já fixada na CPU de posicionamento, de modo que o kernel
+ * aloque as páginas no nó NUMA dessa CPU.
+ */
+static void touch_pages(void *p, size_t bytes){
+    if (!p) return;
+#ifdef _WIN32
+    SYSTEM_INFO si; GetSystemInfo(&si);
+    size_t page = si.dwPageSize;
+#else
+    long ps = sysconf(_SC_PAGESIZE);
+    size_t page = ps > 0 ? (size_t)ps : 4096;
+#endif
+    volatile uint8_t *b = (volatile uint8_t*)p;
+    for (size_t off = 0; off < bytes; off += page) b[off] = 0;
+}
+
+/**
+ * @brief Registra o tamanho de página obtido para os buffers de um worker.
+ *
+ * Indica explicitamente quando o modo solicitado não pôde ser atendido, para que
+ * resultados com e sem faltas de TLB não sejam confundidos.
+ */
+static void log_worker_pages(worker_t *w){
+    AppContext *app = w->app;
+    char size[32];
+    format_page_size(w->buf_region.page_size, size, sizeof(size));
+    if (w->buf_region.mode != app->page_mode) {
+        gui_log(app, "[T%d] Páginas %s indisponíveis; usando %s (%s)\n", w->tid,
+                page_mode_name(app->page_mode), page_mode_name(w->buf_region.mode), size);
+    } else {
+        gui_log(app, "[T%d] Buffer com páginas %s (%s)\n", w->tid, page_mode_name(w->buf_region.mode), size);
+    }
+}
+
+/**
+ * @brief Aloca o bloco residente em cache do motor de ponto flutuante, se configurado.
+ * @return 0 em caso de sucesso (ou se não houver bloco), -1 se a alocação falhar.
+ */
+static int alloc_fp_block(worker_t *w){
+    AppContext *app = w->app;
+    if (app->fp_block_kib == 0) return 0;
+    size_t len = app->fp_block_kib * 1024 / (2 * sizeof(double));
+    len -= len % FP_BLOCK_ALIGN_ELEMS;
+    if (len == 0) len = FP_BLOCK_ALIGN_ELEMS;
+    w->fp_x = aligned_calloc(2 * len, sizeof(double), CACHE_LINE_SIZE);
+    if (!w->fp_x) return -1;
+    w->fp_y = w->fp_x + len;
+    w->fp_len = len;
+    fill_random_unit(w->fp_x, len, 0xF00D0000 + (uint64_t)w->tid);
     return 0;
 }
 
-/* --- Implementação da Thread Worker e Kernels --- */
+/* --- Quanta de Trabalho --- */
+
+/**
+ * @brief Conta quantos quanta uma iteração completa dos kernels `kernels` exige.
+ *
+ * Usado para publicar o progresso dentro da iteração corrente em milésimos de
+ * iteração (`ITER_PROGRESS_SCALE`).
+ */
+static unsigned long long work_quanta_per_iter(const worker_t *w, unsigned kernels){
+    unsigned long long q = 0;
+    if (kernels & WORK_FPU) {
+        if (!w->fp_x) q += 1;
+        else if (w->fp_len <= FP_BLOCK_QUANTUM_ELEMS) {
+            size_t per_quantum = FP_BLOCK_QUANTUM_ELEMS / w->fp_len;
+            q += (FP_BLOCK_PASSES + per_quantum - 1) / per_quantum;
+        } else {
+            q += (unsigned long long)FP_BLOCK_PASSES * ((w->fp_len + FP_BLOCK_QUANTUM_ELEMS - 1) / FP_BLOCK_QUANTUM_ELEMS);
+        }
+    }
+    if (kernels & WORK_INT) q += 1;
+    if ((kernels & WORK_STREAM) && w->vf_base) q += (w->vf_n + STREAM_QUANTUM_ELEMS - 1) / STREAM_QUANTUM_ELEMS;
+    else if (kernels & WORK_STREAM) q += (unsigned long long)STREAM_OPS * ((w->st_n + STREAM_QUANTUM_ELEMS - 1) / STREAM_QUANTUM_ELEMS);
+    if (kernels & WORK_PTR) q += PTR_STEPS_PER_ITER / PTR_STEPS_PER_QUANTUM;
+    if (kernels & WORK_ATOMIC) q += ATOMIC_OPS_PER_ITER / ATOMIC_OPS_PER_QUANTUM;
+    return q;
+}
+
+/**
+ * @brief Executa um quantum do kernel FPU no modo de bloco em cache.
+ *
+ * Blocos pequenos recebem várias passagens inteiras por quantum; blocos maiores
+ * que `FP_BLOCK_QUANTUM_ELEMS` são percorridos em fatias, na mesma ordem de uma
+ * passagem única, preservando o tamanho do conjunto de trabalho escolhido.
+ * @return O número de operações de ponto flutuante executadas.
+ */
+static uint64_t fp_block_quantum(const fp_engine_t *fp, worker_t *w, work_cursor_t *c){
+    uint64_t flops;
+    if (w->fp_len <= FP_BLOCK_QUANTUM_ELEMS) {
+        int passes = (int)(FP_BLOCK_QUANTUM_ELEMS / w->fp_len);
+        if (passes > FP_BLOCK_PASSES - c->fp_pass) passes = FP_BLOCK_PASSES - c->fp_pass;
+        flops = fp->block(w->fp_x, w->fp_y, w->fp_len, passes);
+        c->fp_pass += passes;
+    } else {
+        size_t n = w->fp_len - c->fp_off;
+        if (n > FP_BLOCK_QUANTUM_ELEMS) n = FP_BLOCK_QUANTUM_ELEMS;
+        flops = fp->block(w->fp_x + c->fp_off, w->fp_y + c->fp_off, n, 1);
+        c->fp_off += n;
+        if (c->fp_off == w->fp_len) { c->fp_off = 0; c->fp_pass++; }
+    }
+    if (c->fp_pass >= FP_BLOCK_PASSES) { c->fp_pass = 0; c->pending &= ~WORK_FPU; }
+    return flops;
+}
+
+/**
+ * @brief Executa um quantum da operação STREAM corrente e avança o cursor.
+ *
+ * Cada operação percorre os arrays inteiros antes de a próxima começar, como no
+ * STREAM, para que uma operação não encontre no cache os dados da anterior.
+ * @param bytes, ns Totais do worker, acumulados com os bytes e o tempo do quantum.
+ */
+static void stream_quantum(worker_t *w, work_cursor_t *c, unsigned long long *bytes, unsigned long long *ns){
+    AppContext *app = w->app;
+    if (w->vf_base) {
+        verify_quantum(w, c, bytes, ns);
+        return;
+    }
+    int op = c->stream_op;
+    size_t off = c->stream_off;
+    size_t n = w->st_n - off;
+    if (n > STREAM_QUANTUM_ELEMS) n = STREAM_QUANTUM_ELEMS;
+
+    double t0 = now_sec();
+    unsigned long long b = kernel_stream(op, w->st_a + off, w->st_b + off, w->st_c + off, n,
+                                         app->stream_nt, app->stream_prefetch);
+    unsigned long long t = (unsigned long long)((now_sec() - t0) * 1e9);
+    w->stream_op_bytes[op] += b;
+    w->stream_op_ns[op] += t;
+    *bytes += b;
+    *ns += t;
+
+    c->stream_off = off + n;
+    if (c->stream_off == w->st_n) {
+        c->stream_off = 0;
+        if (++c->stream_op == STREAM_OPS) { c->stream_op = 0; c->pending &= ~WORK_STREAM; }
+    }
+}
+
+/**
+ * @brief Executa um quantum da verificação de memória e avança o cursor.
+ *
+ * Cada quantum confere o padrão da passagem corrente e grava o da seguinte; a
+ * iteração termina quando o buffer inteiro foi percorrido, e a passagem
+ * seguinte passa a conferir o padrão que esta gravou.
+ * @param bytes, ns Totais do worker, acumulados com os bytes e o tempo do quantum.
+ */
+static void verify_quantum(worker_t *w, work_cursor_t *c, unsigned long long *bytes, unsigned long long *ns){
+    size_t off = c->stream_off;
+    size_t n = w->vf_n - off;
+    if (n > STREAM_QUANTUM_ELEMS) n = STREAM_QUANTUM_ELEMS;
+
+    verify_mismatch_t bad[VERIFY_QUANTUM_RECORDS];
+    double t0 = now_sec();
+    size_t nbad = verify_pass(w->vf_base, off, n, &w->vf_pat[0], &w->vf_pat[1], bad, VERIFY_QUANTUM_RECORDS);
+    // Cada palavra é lida e regravada: 16 bytes, como um elemento do Copy.
+    *bytes += (unsigned long long)n * 2 * sizeof(uint64_t);
+    *ns += (unsigned long long)((now_sec() - t0) * 1e9);
+    if (nbad) log_verify_mismatches(w, bad, nbad);
+
+    c->stream_off = off + n;
+    if (c->stream_off == w->vf_n) {
+        c->stream_off = 0;
+        w->verify_passes++;
+        w->vf_pat[0] = w->vf_pat[1];
+        verify_pattern_init(&w->vf_pat[1], w->verify_passes + 1, w->vf_pat[0].seed);
+        c->pending &= ~WORK_STREAM;
+    }
+}
+
+/**
+ * @brief Conta as divergências de um quantum em `errors` e detalha as primeiras no log.
+ *
+ * O log recebe no máximo `VERIFY_LOG_MAX` registros por teste, somando todos os
+ * workers, para que um pente defeituoso não inunde a saída.
+ */
+static void log_verify_mismatches(worker_t *w, const verify_mismatch_t *bad, size_t nbad){
+    AppContext *app = w->app;
+    w->verify_mismatches += nbad;
+    atomic_fetch_add(&app->errors, (int)(nbad > INT_MAX ? INT_MAX : nbad));
+    size_t shown = nbad < VERIFY_QUANTUM_RECORDS ? nbad : VERIFY_QUANTUM_RECORDS;
+    for (size_t i = 0; i < shown; i++) {
+        if (atomic_fetch_add(&app->verify_logged, 1) >= VERIFY_LOG_MAX) return;
+        const uint64_t *addr = w->vf_base + bad[i].index;
+        uint64_t phys;
+        char where[32] = "indisponível";
+        if (verify_phys_addr(addr, &phys) == 0) snprintf(where, sizeof(where), "0x%llx", (unsigned long long)phys);
+        gui_log(app, "[VERIFY] T%d: divergência no padrão %s%s, passagem %llu: endereço %p, físico %s, nó %d; "
+                "esperado 0x%016llx, lido 0x%016llx (%d bit(s))\n",
+                w->tid, verify_kind_name(w->vf_pat[0].kind), w->vf_pat[0].inverted ? " complementado" : "",
+                w->verify_passes, (const void*)addr, where, w->mem_node,
+                (unsigned long long)bad[i].expected, (unsigned long long)bad[i].actual,
+                __builtin_popcountll(bad[i].expected ^ bad[i].actual));
+    }
+}
+
+/**
+ * @brief Prepara o buffer da verificação de memória e grava nele o primeiro padrão.
+ *
+ * As primeiras palavras do buffer são regravadas pelo kernel INT a cada
+ * iteração; a verificação começa depois delas.
+ * @return 0 em caso de sucesso, -1 se o buffer é pequeno demais ou a alocação dos padrões falhar.
+ */
+static int init_verify_buffer(worker_t *w, uint8_t *base, size_t usable){
+    size_t skip = INT_KERNEL_WORDS * sizeof(uint64_t);
+    if (usable <= skip) return -1;
+    size_t n = (usable - skip) / sizeof(uint64_t);
+    n -= n % VERIFY_BLOCK_ELEMS;
+    if (n == 0) return -1;
+    w->vf_pat = aligned_calloc(2, sizeof(verify_pattern_t), CACHE_LINE_SIZE);
+    if (!w->vf_pat) return -1;
+    w->vf_base = (uint64_t*)(base + skip);
+    w->vf_n = n;
+    verify_pattern_init(&w->vf_pat[0], 0, 0x5EED0000 + (uint64_t)w->tid);
+    verify_pass(w->vf_base, 0, n, NULL, &w->vf_pat[0], NULL, 0);
+    verify_pattern_init(&w->vf_pat[1], 1, w->vf_pat[0].seed);
+    return 0;
+}
+
+/**
+ * @brief Mantém o worker ocioso enquanto o perfil de carga estiver em baixa.
+ *
+ * Dorme até pouco antes da próxima subida prevista (`load_rise_ns`) e espera
+ * ativamente a borda, para retomar no mesmo instante que os demais workers. Se a
+ * subida não vier (janela de nível zero ou controladora atrasada), volta a dormir
+ * em passos curtos até a dica ser renovada.
+ * @return O tempo ocioso, em segundos.
+ */
+static double worker_idle(worker_t *w){
+    AppContext *app = w->app;
+    double start = now_sec(), rise = 0.0;
+    int resumed = 0;
+    for (;;) {
+        if (atomic_load_explicit(&app->load_gate, memory_order_acquire) & 1u) { resumed = 1; break; }
+        if (!atomic_load_explicit(&w->running, memory_order_relaxed) || !atomic_load_explicit(&app->running, memory_order_relaxed)) break;
+        rise = (double)atomic_load_explicit(&app->load_rise_ns, memory_order_relaxed) / 1e9;
+        double now = now_sec();
+        if (now < rise - PROFILE_SPIN_SEC) {
+            double wake = rise - PROFILE_SPIN_SEC;
+            if (wake > now + PROFILE_POLL_SEC) wake = now + PROFILE_POLL_SEC;
+            sleep_until(wake);
+        } else if (now < rise + PROFILE_SPIN_SEC) {
+            cpu_relax();
+        } else {
+            sleep_until(now + PROFILE_SPIN_SEC / 2);
+        }
+    }
+    double end = now_sec();
+    if (resumed && rise > 0.0 && end - rise > w->edge_lag_max) w->edge_lag_max = end - rise;
+    return end - start;
+}
+
+/* --- Implementação da Thread Worker --- */
 
 /**
  * @brief Função principal para cada thread de trabalho.
@@ -205,137 +1425,566 @@ cleanup:
 static thread_return_t THREAD_CALL worker_main(void *arg){
     worker_t *w = (worker_t*)arg;
     AppContext *app = w->app;
+    double init_start = now_sec();
     
     atomic_store(&w->status, WORKER_OK);
+
+    // Fixa a thread antes de qualquer alocação: o first-touch posiciona as páginas
+    // no nó NUMA da CPU em que a thread está ao tocá-las pela primeira vez.
+    if (w->mem_cpu >= 0 && thread_pin_self(w->mem_cpu) != 0) {
+        gui_log(app, "[T%d] Failed to pin to CPU %d\n", w->tid, w->mem_cpu);
+    }
+
     if (w->buf_bytes > 0) {
-        w->buf = malloc(w->buf_bytes);
+        w->buf = region_alloc(&w->buf_region, w->buf_bytes, app->page_mode);
         if (!w->buf){
             gui_log(app, "[T%d] Buffer allocation failed (%zu bytes)\n", w->tid, w->buf_bytes);
             atomic_fetch_add(&app->errors, 1);
             atomic_store(&w->status, WORKER_ALLOC_FAIL);
+            atomic_fetch_add(&app->workers_ready, 1);
             return 0;
         }
     }
 
-    // Configura ponteiros e semente aleatória
-    size_t floats = w->buf_bytes / sizeof(float);
-    size_t floats_per_vec = floats / 3;
-    float *A = (float*)w->buf;
-    float *B = NULL;
-    float *C = NULL;
-    if (A && floats_per_vec > 0) {
-        B = A + floats_per_vec;
-        C = B + floats_per_vec;
+    // Aloca o array do ciclo para o kernel Pointer Chasing (um nó por linha de cache;
+    // os deslocamentos são de 32 bits, o que limita o ciclo a UINT32_MAX elementos).
+    if ((w->kernels & WORK_PTR) && w->buf) {
+        w->ptr_nodes = w->buf_bytes / CACHE_LINE_SIZE;
+        if (w->ptr_nodes > UINT32_MAX / PTR_STRIDE) w->ptr_nodes = UINT32_MAX / PTR_STRIDE;
+        w->idx_len = w->ptr_nodes * PTR_STRIDE;
+        if (w->idx_len > 0) {
+            w->idx = region_alloc(&w->idx_region, w->idx_len * sizeof(uint32_t), app->page_mode);
+            if (!w->idx){
+                gui_log(app, "[T%d] Index allocation failed\n", w->tid);
+                atomic_fetch_add(&app->errors, 1);
+                atomic_store(&w->status, WORKER_ALLOC_FAIL);
+                region_free(&w->buf_region);
+                w->buf = NULL;
+                atomic_fetch_add(&app->workers_ready, 1);
+                return 0;
+            }
+        }
+    }
+    if (app->page_mode != PAGE_MODE_DEFAULT) log_worker_pages(w);
+
+    if (app->numa_mode != NUMA_MODE_OFF) {
+        touch_pages(w->buf, w->buf_bytes);
+        touch_pages(w->idx, w->idx_len * sizeof(uint32_t));
+    }
+    // No modo remoto a memória foi tocada a partir de outro nó; agora migra a thread para sua CPU.
+    if (w->cpu >= 0 && w->cpu != w->mem_cpu && thread_pin_self(w->cpu) != 0) {
+        gui_log(app, "[T%d] Failed to pin to CPU %d\n", w->tid, w->cpu);
     }
+
+    // Configura ponteiros e semente aleatória
     uint64_t *I64 = (uint64_t*)w->buf;
     uint64_t seed = 0x12340000 + (uint64_t)w->tid;
 
-    // Inicializa o buffer para o kernel FPU
-    if (app->kernel_fpu_en && A && B && C && floats_per_vec > 0) {
-        for (size_t i=0; i < floats_per_vec; i++){
-            A[i] = (float)(splitmix64(&seed) & 0xFFFF) / 65535.0f;
-            B[i] = (float)(splitmix64(&seed) & 0xFFFF) / 65535.0f;
-            C[i] = (float)(splitmix64(&seed) & 0xFFFF) / 65535.0f;
-        }
+    // Prepara o motor de ponto flutuante: estado das cadeias e bloco opcional em cache
+    const fp_engine_t *fp = app->fp_engine;
+    double fp_state[FP_CHAINS * 8];
+    fp_state_init(fp_state);
+    if ((w->kernels & WORK_FPU) && alloc_fp_block(w) != 0) {
+        gui_log(app, "[T%d] FPU block allocation failed\n", w->tid);
+        atomic_fetch_add(&app->errors, 1);
     }
+
     // Inicializa o buffer para o kernel de Inteiros
-    if (app->kernel_int_en && w->buf) {
+    if ((w->kernels & WORK_INT) && w->buf) {
         size_t ints64 = w->buf_bytes / sizeof(uint64_t);
-        for (size_t i=0;i<ints64;i++) I64[i] = splitmix64(&seed);
+        fill_random_u64(I64, ints64, seed, 0);
     }
-    
-    // Inicializa o array de índices para o kernel Pointer Chasing
-    if(app->kernel_ptr_en && w->buf) {
-        w->idx_len = (w->buf_bytes / sizeof(uint32_t));
-        if (w->idx_len > 0) {
-            w->idx = malloc(w->idx_len * sizeof(uint32_t));
-            if (!w->idx){
-                gui_log(app, "[T%d] Index allocation failed\n", w->tid);
-                atomic_fetch_add(&app->errors, 1);
-                atomic_store(&w->status, WORKER_ALLOC_FAIL);
-                free(w->buf);
-                return 0;
-            }
-            for (uint32_t i=0; i<w->idx_len; i++) w->idx[i] = i;
-            shuffle32(w->idx, w->idx_len, &seed);
-            w->idx[w->idx_len-1] = 0; // Garante que a perseguição seja um ciclo
+
+    // Divide o buffer nos três arrays do STREAM, inicializados como no benchmark original;
+    // na verificação de memória, o buffer inteiro recebe o primeiro padrão.
+    if ((w->kernels & WORK_STREAM) && w->buf && app->verify_en) {
+        uint8_t *base = (uint8_t*)(((uintptr_t)w->buf + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1));
+        if (init_verify_buffer(w, base, w->buf_bytes - (size_t)(base - w->buf)) != 0) {
+            gui_log(app, "[T%d] Buffer de verificação indisponível\n", w->tid);
+            atomic_fetch_add(&app->errors, 1);
+        }
+    } else if ((w->kernels & WORK_STREAM) && w->buf) {
+        uint8_t *base = (uint8_t*)(((uintptr_t)w->buf + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1));
+        size_t usable = w->buf_bytes - (size_t)(base - w->buf);
+        size_t per_array = (usable / 3) & ~(size_t)(CACHE_LINE_SIZE - 1);
+        w->st_n = per_array / sizeof(double);
+        if (w->st_n > 0) {
+            w->st_a = (double*)base;
+            w->st_b = (double*)(base + per_array);
+            w->st_c = (double*)(base + 2 * per_array);
+            for (size_t i = 0; i < w->st_n; i++) { w->st_a[i] = 1.0; w->st_b[i] = 2.0; w->st_c[i] = 0.0; }
         }
     }
 
+    // Inicializa o array de índices para o kernel Pointer Chasing
+    if (w->idx && w->ptr_nodes > 0) {
+        ptrchase_build(w->idx, w->ptr_nodes, w->ptr_chains, w->ptr_pos, &seed);
+    }
+
     atomic_store(&w->running, 1u);
 
-    // Loop principal de estresse
-    while (atomic_load(&w->running) && atomic_load(&app->running)){
-        if (w->buf) {
-            if(app->kernel_fpu_en && floats_per_vec > 0 && A && B && C) kernel_fpu(A,B,C, floats_per_vec, 4);
-            if(app->kernel_int_en) kernel_int(I64, (w->buf_bytes / sizeof(uint64_t)) > 1024 ? 1024 : (w->buf_bytes / sizeof(uint64_t)), 4);
-            if(app->kernel_stream_en) kernel_stream(w->buf, w->buf_bytes);
-            if(app->kernel_ptr_en && w->idx) kernel_ptrchase(w->idx, w->idx_len, 4);
-        }
-        
-        atomic_fetch_add(&w->iters, 1u);
-        atomic_fetch_add(&app->total_iters, 1u);
-        
-        // Registra a contagem de iterações para o gráfico de histórico
-        g_mutex_lock(&app->history_mutex);
-        if (app->thread_history) app->thread_history[w->tid][app->history_pos] = atomic_load(&w->iters);
-        g_mutex_unlock(&app->history_mutex);
+    // Barreira de partida: o laço só começa quando todos os workers terminaram de
+    // inicializar, para que nenhum meça enquanto outros ainda preenchem a memória.
+    w->init_sec = now_sec() - init_start;
+    atomic_fetch_add(&app->workers_ready, 1);
+    while (!atomic_load(&app->workers_go) && atomic_load(&app->running)) {
+        struct timespec r = {0, 1000000}; nanosleep(&r, NULL);
+    }
+
+    unsigned kernels = 0;
+    if (w->buf) {
+        if ((w->kernels & WORK_FPU) && fp) kernels |= WORK_FPU;
+        if (w->kernels & WORK_INT) kernels |= WORK_INT;
+        if ((w->kernels & WORK_STREAM) && (w->st_n > 0 || w->vf_base)) kernels |= WORK_STREAM;
+        if ((w->kernels & WORK_PTR) && w->idx) kernels |= WORK_PTR;
+    }
+    shared_line_t *lines = (shared_line_t*)app->atomic_lines;
+    shared_line_t *pair = (lines && w->atomic_pair >= 0) ? &lines[ATOMIC_LINE_PAIRS + w->atomic_pair] : NULL;
+    if ((w->kernels & WORK_ATOMIC) && lines) kernels |= WORK_ATOMIC;
+    unsigned long long quanta_per_iter = work_quanta_per_iter(w, kernels);
+    work_cursor_t cur = { .pending = kernels };
+
+    // Os contadores de hardware são abertos só agora, para não contar a inicialização.
+    // Com vários kernels, lê-se o grupo após cada quantum para atribuir os eventos ao
+    // kernel que os gerou; com um só, a cada PERF_READ_QUANTA quanta.
+    perf_group_t perf = { .leader = -1 };
+    unsigned long long perf_last[PERF_COUNTER_COUNT] = {0};
+    unsigned perf_every = 0, perf_since = 0;
+    int perf_kernel = -1;
+    w->perf_mask = 0;
+    if (app->perf_en && kernels) {
+        w->perf_mask = perf_group_open(&perf);
+        if (!w->perf_mask && w->tid == 0) {
+            gui_log(app, "[PERF] perf_event_open indisponível (%s); verifique /proc/sys/kernel/perf_event_paranoid\n",
+                    strerror(perf.err));
+        }
+        if (w->perf_mask) perf_every = (kernels & (kernels - 1)) ? 1 : PERF_READ_QUANTA;
+    }
+
+    // Loop principal de estresse, um quantum de cada kernel pendente por volta. Os
+    // contadores são privados desta thread: apenas ela os escreve (store relaxado, sem
+    // RMW) e o amostrador os lê uma vez por intervalo, de modo que o laço não toca em
+    // nenhum lock ou linha de cache compartilhada, exceto as do kernel ATOMIC, que
+    // existem justamente para serem disputadas.
+    unsigned long long iters = 0;
+    unsigned long long flops = 0;
+    unsigned long long int_ops = 0;
+    unsigned long long ptr_steps = 0, ptr_ns = 0;
+    unsigned long long stream_bytes = 0, stream_ns = 0;
+    atomic_counts_t atomic = {0};
+    const int profiled = app->profile_active;
+    double idle = 0.0;
+    w->run_start = now_sec();
+    while (atomic_load_explicit(&w->running, memory_order_relaxed) && atomic_load_explicit(&app->running, memory_order_relaxed)){
+        // Sob um perfil de carga, a borda publicada pela controladora é lida entre quanta.
+        if (profiled && !(atomic_load_explicit(&app->load_gate, memory_order_acquire) & 1u)) {
+            idle += worker_idle(w);
+            continue;
+        }
+        if (cur.pending & WORK_FPU) {
+            if (w->fp_x) {
+                flops += fp_block_quantum(fp, w, &cur);
+            } else {
+                flops += fp->chain(fp_state);
+                cur.pending &= ~WORK_FPU;
+            }
+            atomic_store_explicit(&w->flops, flops, memory_order_relaxed);
+            cur.done++;
+            perf_kernel = KERNEL_FPU;
+            if (perf_every && ++perf_since >= perf_every) {
+                perf_attribute(w, &perf, perf_last, perf_kernel);
+                perf_since = 0;
+            }
+        }
+        if (cur.pending & WORK_INT) {
+            int_ops += kernel_int(I64, (w->buf_bytes / sizeof(uint64_t)) > INT_KERNEL_WORDS ? INT_KERNEL_WORDS : (w->buf_bytes / sizeof(uint64_t)), 4);
+            atomic_store_explicit(&w->int_ops, int_ops, memory_order_relaxed);
+            cur.pending &= ~WORK_INT;
+            cur.done++;
+            perf_kernel = KERNEL_INT;
+            if (perf_every && ++perf_since >= perf_every) {
+                perf_attribute(w, &perf, perf_last, perf_kernel);
+                perf_since = 0;
+            }
+        }
+        if (cur.pending & WORK_STREAM) {
+            stream_quantum(w, &cur, &stream_bytes, &stream_ns);
+            atomic_store_explicit(&w->stream_bytes, stream_bytes, memory_order_relaxed);
+            atomic_store_explicit(&w->stream_ns, stream_ns, memory_order_relaxed);
+            cur.done++;
+            perf_kernel = KERNEL_STREAM;
+            if (perf_every && ++perf_since >= perf_every) {
+                perf_attribute(w, &perf, perf_last, perf_kernel);
+                perf_since = 0;
+            }
+        }
+        if (cur.pending & WORK_PTR) {
+            double t0 = now_sec();
+            kernel_ptrchase(w->idx, w->ptr_pos, w->ptr_chains, PTR_STEPS_PER_QUANTUM);
+            ptr_ns += (unsigned long long)((now_sec() - t0) * 1e9);
+            ptr_steps += PTR_STEPS_PER_QUANTUM;
+            cur.ptr_steps += PTR_STEPS_PER_QUANTUM;
+            if (cur.ptr_steps >= PTR_STEPS_PER_ITER) { cur.ptr_steps = 0; cur.pending &= ~WORK_PTR; }
+            atomic_store_explicit(&w->ptr_ns, ptr_ns, memory_order_relaxed);
+            atomic_store_explicit(&w->ptr_steps, ptr_steps, memory_order_relaxed);
+            cur.done++;
+            perf_kernel = KERNEL_PTR;
+            if (perf_every && ++perf_since >= perf_every) {
+                perf_attribute(w, &perf, perf_last, perf_kernel);
+                perf_since = 0;
+            }
+        }
+        if (cur.pending & WORK_ATOMIC) {
+            kernel_atomic(&lines[ATOMIC_LINE_ADD], &lines[ATOMIC_LINE_CAS], pair, w->atomic_side,
+                          ATOMIC_OPS_PER_QUANTUM, &atomic);
+            cur.atomic_ops += ATOMIC_OPS_PER_QUANTUM;
+            if (cur.atomic_ops >= ATOMIC_OPS_PER_ITER) { cur.atomic_ops = 0; cur.pending &= ~WORK_ATOMIC; }
+            atomic_store_explicit(&w->atomic_ops, atomic.ops, memory_order_relaxed);
+            cur.done++;
+            perf_kernel = KERNEL_ATOMIC;
+            if (perf_every && ++perf_since >= perf_every) {
+                perf_attribute(w, &perf, perf_last, perf_kernel);
+                perf_since = 0;
+            }
+        }
+
+        if (cur.pending == 0) {
+            atomic_store_explicit(&w->iters, ++iters, memory_order_relaxed);
+            cur = (work_cursor_t){ .pending = kernels };
+        }
+        unsigned long long progress = iters * ITER_PROGRESS_SCALE;
+        if (quanta_per_iter > 0) progress += cur.done * ITER_PROGRESS_SCALE / quanta_per_iter;
+        atomic_store_explicit(&w->progress, progress, memory_order_relaxed);
+    }
+    w->run_end = now_sec();
+    w->idle_sec = idle;
+    w->cas_fails = atomic.cas_fails;
+    w->pp_rounds = atomic.rounds;
+    w->pp_ns = atomic.round_ns;
+    if (w->perf_mask) {
+        if (perf_kernel >= 0) perf_attribute(w, &perf, perf_last, perf_kernel);
+        perf_group_close(&perf);
     }
 
     // Limpeza
-    if(w->idx) free(w->idx);
-    if(w->buf) free(w->buf);
+    aligned_free(w->fp_x);
+    w->fp_x = w->fp_y = NULL;
+    aligned_free(w->vf_pat);
+    w->vf_pat = NULL;
+    region_free(&w->idx_region);
+    region_free(&w->buf_region);
+    w->idx = NULL;
+    w->buf = NULL;
     return 0;
 }
 
 /**
- * @brief Realiza um cálculo intensivo de ponto flutuante (FMA).
- * Estressa a Unidade de Ponto Flutuante (FPU).
+ * @brief Executa a varredura de caches na thread controladora.
+ *
+ * A thread é fixada na CPU do primeiro worker (com a fixação ligada) e mede os
+ * pontos do menor para o maior conjunto, publicando cada um em `app->sweep` assim
+ * que fica pronto. O maior conjunto é limitado a um quarto da memória física.
  */
-static void kernel_fpu(float *A, float *B, float *C, size_t n, int iters){
-    for (int k = 0; k < iters; ++k)
-        for (size_t i = 0; i < n; ++i) C[i] = A[i]*B[i] + C[i];
+static void run_cache_sweep(AppContext *app){
+    sweep_result_t *r = calloc(1, sizeof(*r));
+    if (!r) {
+        gui_log(app, "[SWEEP] Falha ao alocar o resultado da varredura.\n");
+        atomic_fetch_add(&app->errors, 1);
+        return;
+    }
+    g_mutex_lock(&app->history_mutex);
+    free(app->sweep);
+    app->sweep = r;
+    g_mutex_unlock(&app->history_mutex);
+
+    r->cpu = app->workers[0].cpu;
+    if (r->cpu >= 0 && thread_pin_self(r->cpu) != 0) {
+        gui_log(app, "[SWEEP] Aviso: falha ao fixar a varredura na CPU %d.\n", r->cpu);
+    }
+    r->cache_count = topology_caches(r->cpu >= 0 ? r->cpu : 0, r->caches, CPU_CACHE_MAX);
+    if (r->cache_count > 0) {
+        char line[256], size[32];
+        size_t n = (size_t)snprintf(line, sizeof(line), "[SWEEP] Caches da CPU %d:", r->cpu >= 0 ? r->cpu : 0);
+        for (int c = 0; c < r->cache_count && n < sizeof(line); c++) {
+            format_page_size(r->caches[c].bytes, size, sizeof(size));
+            n += (size_t)snprintf(line + n, sizeof(line) - n, "%s L%d %s", c ? "," : "", r->caches[c].level, size);
+            if (r->caches[c].shared_cpus > 1 && n < sizeof(line)) {
+                n += (size_t)snprintf(line + n, sizeof(line) - n, " (%d CPUs)", r->caches[c].shared_cpus);
+            }
+        }
+        gui_log(app, "%s\n", line);
+    } else {
+        gui_log(app, "[SWEEP] Caches não informados pelo SO; a curva não será anotada.\n");
+        r->cache_count = 0;
+    }
+
+    size_t max_bytes = app->sweep_max_mib << 20;
+    unsigned long long ram = get_total_system_memory();
+    if (ram > 0 && max_bytes > ram / 4) max_bytes = (size_t)(ram / 4);
+    if (max_bytes < SWEEP_MIN_BYTES) max_bytes = SWEEP_MIN_BYTES;
+    size_t sizes[SWEEP_MAX_POINTS];
+    int count = sweep_sizes(max_bytes, sizes, SWEEP_MAX_POINTS);
+
+    mem_region_t region = {0};
+    uint8_t *buf = region_alloc(&region, sizes[count - 1], app->page_mode);
+    if (!buf) {
+        gui_log(app, "[SWEEP] Falha ao alocar %zu MiB para a varredura.\n", sizes[count - 1] >> 20);
+        atomic_fetch_add(&app->errors, 1);
+        return;
+    }
+    char size[32];
+    format_page_size(sizes[count - 1], size, sizeof(size));
+    gui_log(app, "[SWEEP] %d conjunto(s) de trabalho de 4 KiB a %s, %d repetição(ões) de %.0f ms por métrica\n",
+            count, size, SWEEP_REPS, SWEEP_REP_SEC * 1e3);
+
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    double start = now_sec();
+    for (int i = 0; i < count && atomic_load(&app->running); i++) {
+        sweep_point_t p;
+        if (sweep_measure(buf, sizes[i], SWEEP_REPS, SWEEP_REP_SEC, &app->running, &seed, &p) != 0) break;
+        p.level = sweep_expected_level(r->caches, r->cache_count, p.bytes);
+        g_mutex_lock(&app->history_mutex);
+        r->points[r->count++] = p;
+        g_mutex_unlock(&app->history_mutex);
+
+        char where[16];
+        if (p.level > 0) snprintf(where, sizeof(where), "L%d", p.level);
+        else snprintf(where, sizeof(where), "DRAM");
+        format_page_size(p.bytes, size, sizeof(size));
+        gui_log(app, "[SWEEP] %10s  %8.2f ns/carga  %8.2f GB/s  (%s)\n", size, p.ns_per_load, p.gbps, where);
+        telemetry_sweep(app->telemetry, r, r->count - 1);
+        if (!app->headless && app->sweep_drawing) g_idle_add((GSourceFunc)gtk_widget_queue_draw, app->sweep_drawing);
+    }
+    region_free(&region);
+    gui_log(app, "[SWEEP] %d de %d ponto(s) medido(s) em %.1f s\n", r->count, count, now_sec() - start);
 }
 
 /**
- * @brief Uma função de mistura de 64 bits para gerar comportamento pseudoaleatório.
- * Usado pelo kernel de inteiros.
+ * @brief Mede a matriz de latência entre núcleos na thread controladora.
+ *
+ * Os nós da matriz são as CPUs em que os workers seriam fixados, de modo que
+ * `--cpus`, `--affinity` e o número de threads escolhem os núcleos comparados.
+ * Cada par é medido uma vez e publicado em `app->c2c` assim que fica pronto; a
+ * matriz é simétrica.
  */
-static inline uint64_t mix64(uint64_t x){
-    x ^= x >> 33; x *= 0xff51afd7ed558ccdULL; x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL; x ^= x >> 33;
-    return x;
+static void run_c2c_matrix(AppContext *app){
+    int n = app->threads < C2C_MAX_CPUS ? app->threads : C2C_MAX_CPUS;
+    if (n < app->threads) gui_log(app, "[C2C] Limitando a matriz às primeiras %d CPUs.\n", n);
+    int cpus[C2C_MAX_CPUS], package[C2C_MAX_CPUS];
+    for (int i = 0; i < n; i++) {
+        cpus[i] = app->workers[i].cpu;
+        package[i] = (cpus[i] >= 0 && cpus[i] < app->topology->cpu_count) ? app->topology->cpu_package[cpus[i]] : 0;
+    }
+    c2c_result_t *r = c2c_create(cpus, package, n);
+    if (!r) {
+        gui_log(app, "[C2C] Falha ao alocar a matriz de latência.\n");
+        atomic_fetch_add(&app->errors, 1);
+        return;
+    }
+    g_mutex_lock(&app->history_mutex);
+    free(app->c2c);
+    app->c2c = r;
+    g_mutex_unlock(&app->history_mutex);
+    if (n < 2) {
+        gui_log(app, "[C2C] A matriz precisa de pelo menos 2 threads (CPUs).\n");
+        return;
+    }
+
+    int total = n * (n - 1) / 2;
+    gui_log(app, "[C2C] Medindo %d par(es) de CPUs em %d socket(s), %d idas e voltas por repetição\n",
+            total, app->topology->package_count, C2C_ROUNDS);
+    double start = now_sec();
+    for (int i = 0; i < n && atomic_load(&app->running); i++) {
+        for (int j = i + 1; j < n && atomic_load(&app->running); j++) {
+            double ns = c2c_round_trip(cpus[i], cpus[j], C2C_ROUNDS, &app->running);
+            if (ns < 0.0) {
+                if (atomic_load(&app->running)) {
+                    gui_log(app, "[C2C] Falha ao medir o par CPU %d-%d.\n", cpus[i], cpus[j]);
+                    atomic_fetch_add(&app->errors, 1);
+                }
+                continue;
+            }
+            g_mutex_lock(&app->history_mutex);
+            r->ns[i * n + j] = r->ns[j * n + i] = ns;
+            r->done++;
+            g_mutex_unlock(&app->history_mutex);
+            telemetry_c2c(app->telemetry, r, i, j);
+            if (!app->headless && app->c2c_drawing) g_idle_add((GSourceFunc)gtk_widget_queue_draw, app->c2c_drawing);
+        }
+    }
+
+    if (n <= 16) {
+        // A matriz inteira só cabe no log para poucos núcleos; o gráfico e a exportação a trazem sempre.
+        char line[256];
+        size_t len = (size_t)snprintf(line, sizeof(line), "[C2C] ns   ");
+        for (int j = 0; j < n && len < sizeof(line); j++) len += (size_t)snprintf(line + len, sizeof(line) - len, " %6d", cpus[j]);
+        gui_log(app, "%s\n", line);
+        for (int i = 0; i < n; i++) {
+            len = (size_t)snprintf(line, sizeof(line), "[C2C] %4d ", cpus[i]);
+            for (int j = 0; j < n && len < sizeof(line); j++) {
+                double ns = r->ns[i * n + j];
+                if (i == j || ns <= 0.0) len += (size_t)snprintf(line + len, sizeof(line) - len, " %6s", "-");
+                else len += (size_t)snprintf(line + len, sizeof(line) - len, " %6.0f", ns);
+            }
+            gui_log(app, "%s\n", line);
+        }
+    }
+    c2c_stats_t st;
+    c2c_summarize(r, &st);
+    if (r->done > 0) {
+        gui_log(app, "[C2C] Ida e volta: mín. %.0f ns, máx. %.0f ns (CPU %d-%d)\n", st.min, st.max, st.worst_a, st.worst_b);
+        if (st.same_socket > 0.0) gui_log(app, "[C2C] Média no mesmo socket: %.0f ns\n", st.same_socket);
+        if (st.cross_socket > 0.0) {
+            char ratio[48] = "";
+            if (st.same_socket > 0.0) snprintf(ratio, sizeof(ratio), " (%.1fx o mesmo socket)", st.cross_socket / st.same_socket);
+            gui_log(app, "[C2C] Média entre sockets: %.0f ns%s\n", st.cross_socket, ratio);
+        }
+    }
+    gui_log(app, "[C2C] %d de %d par(es) medido(s) em %.1f s\n", r->done, total, now_sec() - start);
 }
 
 /**
- * @brief Realiza uma série de operações complexas de inteiros e bitwise.
- * Estressa as Unidades Lógicas e Aritméticas (ALUs).
+ * @brief Abre o alvo do motor de E/S e registra a configuração obtida.
+ *
+ * O preenchimento de um arquivo novo acontece aqui, antes da largada dos
+ * workers, para que o teste comece com a E/S já em regime.
+ *
+ * @return 0 em caso de sucesso, -1 em caso de erro (já registrado e contado) ou se o teste foi parado.
  */
-static void kernel_int(uint64_t *dst, size_t n, int iters){
-    uint64_t acc = 0xC0FFEE;
-    for (int k=0;k<iters;k++){
-        for (size_t i=0;i<n;i++){
-            acc ^= mix64(dst[i] + i);
-            dst[i] = acc + (dst[i] << 1) + (dst[i] >> 3);
-        }
+static int open_io_engine(AppContext *app){
+    io_options_t o = {
+        .path = app->io_path,
+        .file_mib = app->io_file_mib > 0 ? app->io_file_mib : IO_DEFAULT_FILE_MIB,
+        .block_kib = app->io_block_kib > 0 ? app->io_block_kib : IO_DEFAULT_BLOCK_KIB,
+        .qd = app->io_qd > 0 ? app->io_qd : IO_DEFAULT_QD,
+        .read_pct = app->io_read_pct,
+        .destructive_writes = app->io_destructive,
+    };
+    gui_log(app, "[IO] Preparando %s...\n", app->io_path);
+    char err[640];
+    app->io = io_engine_open(&o, &app->running, err, sizeof(err));
+    if (!app->io) {
+        if (!atomic_load(&app->running)) return -1;
+        gui_log(app, "[IO] Falha ao preparar a E/S: %s.\n", err);
+        atomic_fetch_add(&app->errors, 1);
+        return -1;
+    }
+    io_engine_t *e = app->io;
+    gui_log(app, "[IO] %s em %s (%s, %llu MiB%s), fila de %d, blocos de %zu KiB, %d%% leituras\n",
+            io_backend_name(e->backend), e->path, e->device ? "dispositivo" : e->created ? "arquivo temporário" : "arquivo",
+            e->size >> 20, e->direct ? ", E/S direta" : ", com cache de páginas", e->backend == IO_BACKEND_SYNC ? 1 : e->qd,
+            e->block / 1024, e->read_pct);
+    if (!e->direct) gui_log(app, "[IO] O sistema de arquivos recusou a E/S direta; as leituras podem vir do cache.\n");
+    if (e->backend == IO_BACKEND_SYNC && e->qd > 1) {
+        gui_log(app, "[IO] io_uring indisponível; usando pread/pwrite com uma operação por vez.\n");
+    } else if (e->backend == IO_BACKEND_URING && !e->fixed_bufs) {
+        gui_log(app, "[IO] Buffers não registrados no io_uring (limite de memória travada); usando iovecs.\n");
     }
+    return 0;
 }
 
 /**
- * @brief Realiza grandes operações de cópia de memória.
- * Estressa o barramento de memória e os controladores.
+ * @brief Registra os totais e a distribuição de latência da E/S; falhas de E/S contam como erros do teste.
  */
-static void kernel_stream(uint8_t *buf, size_t n){
-    memset(buf, 0xA5, n/2);
-    memcpy(buf + n/2, buf, n/2);
+static void report_io_summary(AppContext *app){
+    io_totals_t t;
+    io_engine_totals(app->io, &t);
+    gui_log(app, "[IO] %llu leitura(s), %llu escrita(s) em %.1f s: %.0f IOPS, %.1f MB/s\n",
+            t.reads, t.writes, t.seconds, t.rate.iops, t.rate.mbps);
+    if (t.reads + t.writes > 0) {
+        gui_log(app, "[IO] Latência: p50 %.0f µs, p99 %.0f µs, p99.9 %.0f µs, máx. %.0f µs\n",
+                t.rate.p50_us, t.rate.p99_us, t.rate.p999_us, t.max_us);
+    }
+    if (t.errors > 0) {
+        gui_log(app, "[IO] ERRO: %llu operação(ões) de E/S falharam%s%s\n", t.errors,
+                app->io->last_errno ? ": " : "", app->io->last_errno ? strerror(app->io->last_errno) : "");
+        atomic_fetch_add(&app->errors, (int)t.errors);
+    }
 }
 
 /**
- * @brief Percorre um array embaralhado de ponteiros em uma ordem pseudoaleatória.
- * Estressa o cache da CPU e o prefetcher de memória criando uma longa cadeia de dependência.
+ * @brief Cria e inicia uma sonda de jitter em cada CPU do teste.
+ *
+ * As CPUs sondadas são as dos workers fixados, sem repetição, para que a
+ * latência medida seja a de quem divide o núcleo com a carga; sem fixação,
+ * todas as CPUs.
+ *
+ * @return 0 em caso de sucesso, -1 em caso de erro (já contado em `app->errors`).
  */
-static void kernel_ptrchase(uint32_t *idx, size_t n, int rounds){
-    size_t i = 0;
-    for (int r=0;r<rounds;r++)
-        for (size_t s=0;s<n;s++) i = idx[i];
-    (void)i; // Avoid unused variable warning
+static int start_jitter_probes(AppContext *app){
+    int *cpus = calloc(app->cpu_count, sizeof(int));
+    if (!cpus) {
+        gui_log(app, "[JITTER] Falha ao alocar a lista de CPUs.\n");
+        atomic_fetch_add(&app->errors, 1);
+        return -1;
+    }
+    int n = 0;
+    if (app->pin_affinity) {
+        for (int i = 0; i < app->threads; i++) {
+            int cpu = app->workers[i].cpu, seen = 0;
+            if (cpu < 0 || cpu >= app->cpu_count) continue;
+            for (int k = 0; k < n && !seen; k++) seen = cpus[k] == cpu;
+            if (!seen) cpus[n++] = cpu;
+        }
+    }
+    if (n == 0) {
+        for (int c = 0; c < app->cpu_count; c++) cpus[n++] = c;
+    }
+    if (n > JITTER_MAX_CPUS) {
+        gui_log(app, "[JITTER] Limitando a sonda às primeiras %d CPUs.\n", JITTER_MAX_CPUS);
+        n = JITTER_MAX_CPUS;
+    }
+    int interval = app->jitter_interval_us > 0 ? app->jitter_interval_us : JITTER_DEFAULT_INTERVAL_US;
+    app->jitter = jitter_create(cpus, n, interval, &app->running);
+    free(cpus);
+    jitter_result_t *r = app->jitter ? jitter_result_create(app->jitter) : NULL;
+    if (!r) {
+        gui_log(app, "[JITTER] Falha ao alocar as sondas de jitter.\n");
+        atomic_fetch_add(&app->errors, 1);
+        return -1;
+    }
+    g_mutex_lock(&app->history_mutex);
+    app->jitter_live = r;
+    g_mutex_unlock(&app->history_mutex);
+
+    int started = jitter_start(app->jitter);
+    if (started < n) {
+        gui_log(app, "[JITTER] Falha ao iniciar %d de %d sonda(s).\n", n - started, n);
+        atomic_fetch_add(&app->errors, 1);
+        return -1;
+    }
+    gui_log(app, "[JITTER] Sondando a latência de despertar em %d CPU(s), a cada %d µs\n", n, interval);
+    return 0;
+}
+
+/**
+ * @brief Publica e registra a latência de despertar do teste inteiro, por CPU e no total.
+ */
+static void report_jitter_summary(AppContext *app){
+    jitter_t *j = app->jitter;
+    g_mutex_lock(&app->history_mutex);
+    jitter_totals(j, app->jitter_live);
+    g_mutex_unlock(&app->history_mutex);
+    // O amostrador já terminou; só a controladora escreve no resultado daqui em diante.
+    const jitter_result_t *r = app->jitter_live;
+
+    int worst = 0, unpinned = 0;
+    for (int i = 0; i < r->n; i++) {
+        if (r->cpu[i].max_us > r->cpu[worst].max_us) worst = i;
+        if (!atomic_load(&j->probes[i].pinned)) unpinned++;
+    }
+    if (r->n <= 32) {
+        for (int i = 0; i < r->n; i++) {
+            const jitter_stats_t *st = &r->cpu[i];
+            gui_log(app, "[JITTER] CPU %d: p50 %.1f µs, p99 %.1f µs, p99.9 %.1f µs, máx. %.1f µs (%llu despertares)\n",
+                    st->cpu, st->p50_us, st->p99_us, st->p999_us, st->max_us, st->wakeups);
+        }
+    }
+    gui_log(app, "[JITTER] Todas as CPUs: p50 %.1f µs, p99 %.1f µs, p99.9 %.1f µs, máx. %.1f µs (CPU %d)\n",
+            r->all.p50_us, r->all.p99_us, r->all.p999_us, r->all.max_us, r->n > 0 ? r->cpu[worst].cpu : -1);
+    if (r->realtime < r->n) {
+        gui_log(app, "[JITTER] %d de %d sonda(s) sem prioridade de tempo real (requer CAP_SYS_NICE); "
+                "a latência inclui a espera atrás dos workers no escalonador normal.\n", r->n - r->realtime, r->n);
+    }
+    if (unpinned > 0) gui_log(app, "[JITTER] %d sonda(s) não puderam ser fixadas na sua CPU.\n", unpinned);
 }
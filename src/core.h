@@ -28,4 +28,18 @@
  */
 thread_return_t THREAD_CALL controller_thread_func(void *arg);
 
+/**
+ * @brief Aloca um `AppContext` com a configuração padrão, os mutexes e os buffers do histórico do sistema.
+ *
+ * Usado por `main` e pelo agente da frota, que prepara um contexto novo para cada teste.
+ *
+ * @return O contexto, ou NULL se faltar memória.
+ */
+AppContext *app_context_create(void);
+
+/**
+ * @brief Libera um contexto de `app_context_create` (sem widgets GTK) e os resultados mantidos após o teste.
+ */
+void app_context_free(AppContext *app);
+
 #endif // CORE_H
@@ -0,0 +1,319 @@
+#include "degrade.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* --- Static Function Prototypes --- */
+static int cmp_double(const void *a, const void *b);
+static double median_known(const double *v, int n, double unknown, double *scratch);
+static int step(degrade_track_t *tr, int scope, double drop, double threshold);
+static int classify_self(const degrade_track_t *tr, double temp, double mhz, int thermal_cpus, int power_cpus);
+static int classify_peers(double temp, double temp_ref, double mhz, double mhz_ref);
+static void emit(degrade_t *d, int track, int scope, int begin, double t, double ref, double drop,
+                 double temp, double temp_ref, double mhz, double mhz_ref, degrade_event_t *ev, int max, int *n);
+static void group_refs(degrade_t *d);
+static void format_temp(double c, char *buf, size_t len);
+static void format_mhz(double mhz, char *buf, size_t len);
+
+/* --- Criação e Liberação --- */
+
+degrade_t *degrade_create(int threads, double baseline_sec, double drop_pct){
+    if (threads <= 0 || baseline_sec <= 0.0 || drop_pct <= 0.0) return NULL;
+    degrade_t *d = calloc(1, sizeof(*d));
+    if (!d) return NULL;
+    d->threads = threads;
+    d->baseline_sec = baseline_sec;
+    d->drop_pct = drop_pct;
+    d->progress = calloc(threads, sizeof(unsigned long long));
+    d->last_progress = calloc(threads, sizeof(unsigned long long));
+    d->temp_c = calloc(threads, sizeof(double));
+    d->mhz = calloc(threads, sizeof(double));
+    d->group = calloc(threads, sizeof(int));
+    d->scratch = calloc(threads + 1, sizeof(double));
+    d->gather = calloc(threads, sizeof(double));
+    d->peer_rate = calloc(threads, sizeof(double));
+    d->peer_temp = calloc(threads, sizeof(double));
+    d->peer_mhz = calloc(threads, sizeof(double));
+    d->peer_n = calloc(threads, sizeof(int));
+    d->tracks = calloc(threads + 1, sizeof(degrade_track_t));
+    if (!d->progress || !d->last_progress || !d->temp_c || !d->mhz || !d->group || !d->scratch || !d->gather ||
+        !d->peer_rate || !d->peer_temp || !d->peer_mhz || !d->peer_n || !d->tracks) {
+        degrade_free(d);
+        return NULL;
+    }
+    for (int i = 0; i < threads; i++) d->temp_c[i] = TEMP_UNAVAILABLE;
+    return d;
+}
+
+void degrade_free(degrade_t *d){
+    if (!d) return;
+    free(d->progress);
+    free(d->last_progress);
+    free(d->temp_c);
+    free(d->mhz);
+    free(d->group);
+    free(d->scratch);
+    free(d->gather);
+    free(d->peer_rate);
+    free(d->peer_temp);
+    free(d->peer_mhz);
+    free(d->peer_n);
+    free(d->tracks);
+    free(d);
+}
+
+/* --- Análise --- */
+
+static int cmp_double(const void *a, const void *b){
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Mediana dos valores de `v` diferentes de `unknown`.
+ * @return A mediana, ou `unknown` se nenhum valor for conhecido.
+ */
+static double median_known(const double *v, int n, double unknown, double *scratch){
+    int k = 0;
+    for (int i = 0; i < n; i++) if (v[i] != unknown) scratch[k++] = v[i];
+    if (k == 0) return unknown;
+    qsort(scratch, k, sizeof(double), cmp_double);
+    return (k % 2) ? scratch[k / 2] : 0.5 * (scratch[k / 2 - 1] + scratch[k / 2]);
+}
+
+/**
+ * @brief Calcula, para cada worker, as medianas de taxa, temperatura e clock do seu grupo.
+ */
+static void group_refs(degrade_t *d){
+    for (int i = 0; i < d->threads; i++) {
+        int first = 1;
+        for (int j = 0; j < i && first; j++) first = d->group[j] != d->group[i];
+        if (!first) continue;
+        double ref[3];
+        int n = 0;
+        for (int v = 0; v < 3; v++) {
+            n = 0;
+            for (int j = i; j < d->threads; j++) {
+                if (d->group[j] == d->group[i]) d->gather[n++] = v == 0 ? d->tracks[j].ewma : v == 1 ? d->temp_c[j] : d->mhz[j];
+            }
+            ref[v] = median_known(d->gather, n, v == 0 ? -1.0 : v == 1 ? TEMP_UNAVAILABLE : 0.0, d->scratch);
+        }
+        for (int j = i; j < d->threads; j++) {
+            if (d->group[j] != d->group[i]) continue;
+            d->peer_rate[j] = ref[0];
+            d->peer_temp[j] = ref[1];
+            d->peer_mhz[j] = ref[2];
+            d->peer_n[j] = n;
+        }
+    }
+}
+
+/**
+ * @brief Avança a histerese de um episódio com a queda `drop` da amostra.
+ * @return 1 se o episódio abriu, -1 se fechou, 0 caso contrário.
+ */
+static int step(degrade_track_t *tr, int scope, double drop, double threshold){
+    int toward = tr->active[scope] ? (drop < threshold / 2.0) : (drop >= threshold);
+    if (!toward) {
+        tr->streak[scope] = 0;
+        return 0;
+    }
+    if (++tr->streak[scope] < DEGRADE_HOLD_SAMPLES) return 0;
+    tr->streak[scope] = 0;
+    tr->active[scope] = !tr->active[scope];
+    return tr->active[scope] ? 1 : -1;
+}
+
+/**
+ * @brief Causa provável de uma queda em relação à própria linha de base.
+ *
+ * Os contadores de limitação valem para o sistema todo; sem eles, uma queda de
+ * clock ou um aumento de temperatura desde a linha de base apontam a causa.
+ */
+static int classify_self(const degrade_track_t *tr, double temp, double mhz, int thermal_cpus, int power_cpus){
+    if (thermal_cpus > 0) return DEGRADE_CAUSE_THERMAL;
+    if (power_cpus > 0) return DEGRADE_CAUSE_POWER;
+    if (mhz > 0.0 && tr->base_mhz > 0.0 && (tr->base_mhz - mhz) / tr->base_mhz * 100.0 >= DEGRADE_MHZ_DROP_PCT) {
+        return DEGRADE_CAUSE_FREQUENCY;
+    }
+    if (temp > TEMP_UNAVAILABLE && tr->base_temp > TEMP_UNAVAILABLE && temp - tr->base_temp >= DEGRADE_TEMP_RISE_C) {
+        return DEGRADE_CAUSE_THERMAL;
+    }
+    return DEGRADE_CAUSE_UNKNOWN;
+}
+
+/**
+ * @brief Causa provável de um worker mais lento que os pares.
+ *
+ * Mais quente ou com clock menor que a mediana explica a diferença; à mesma
+ * temperatura e clock, o núcleo em si é o suspeito.
+ */
+static int classify_peers(double temp, double temp_ref, double mhz, double mhz_ref){
+    if (temp > TEMP_UNAVAILABLE && temp_ref > TEMP_UNAVAILABLE && temp - temp_ref >= DEGRADE_TEMP_RISE_C) {
+        return DEGRADE_CAUSE_THERMAL;
+    }
+    if (mhz > 0.0 && mhz_ref > 0.0 && (mhz_ref - mhz) / mhz_ref * 100.0 >= DEGRADE_MHZ_DROP_PCT) {
+        return DEGRADE_CAUSE_FREQUENCY;
+    }
+    return DEGRADE_CAUSE_CORE;
+}
+
+/**
+ * @brief Grava um evento da trilha `track` em `ev`, se houver espaço.
+ */
+static void emit(degrade_t *d, int track, int scope, int begin, double t, double ref, double drop,
+                 double temp, double temp_ref, double mhz, double mhz_ref, degrade_event_t *ev, int max, int *n){
+    degrade_track_t *tr = &d->tracks[track];
+    if (begin) {
+        tr->since[scope] = t;
+        d->events++;
+    }
+    if (*n >= max) return;
+    ev[(*n)++] = (degrade_event_t){
+        .t = t, .worker = track < d->threads ? track : -1, .scope = scope, .begin = begin,
+        .cause = tr->cause[scope], .rate = tr->ewma, .ref = ref, .drop_pct = drop,
+        .temp_c = temp, .temp_ref = temp_ref, .mhz = mhz, .mhz_ref = mhz_ref,
+        .duration = begin ? 0.0 : t - tr->since[scope],
+    };
+}
+
+int degrade_update(degrade_t *d, double t, int thermal_cpus, int power_cpus, degrade_event_t *ev, int max){
+    if (!d) return 0;
+    if (!d->primed) {
+        memcpy(d->last_progress, d->progress, d->threads * sizeof(unsigned long long));
+        d->last_t = t;
+        d->primed = 1;
+        return 0;
+    }
+    double dt = t - d->last_t;
+    if (dt <= 0.0) return 0;
+    d->last_t = t;
+
+    // Taxas do intervalo, suavizadas; a trilha extra acompanha a vazão somada.
+    const int sys = d->threads;
+    double total = 0.0;
+    for (int i = 0; i <= d->threads; i++) {
+        double rate;
+        if (i < d->threads) {
+            rate = (double)(d->progress[i] - d->last_progress[i]) / ITER_PROGRESS_SCALE / dt;
+            d->last_progress[i] = d->progress[i];
+            total += rate;
+        } else {
+            rate = total;
+        }
+        degrade_track_t *tr = &d->tracks[i];
+        tr->ewma = (d->primed == 1) ? rate : tr->ewma + DEGRADE_EWMA_ALPHA * (rate - tr->ewma);
+    }
+    d->primed = 2;
+
+    // Referências do instante: as medianas do grupo de cada worker e, para o sistema, de todos.
+    group_refs(d);
+    double peer_temp = median_known(d->temp_c, d->threads, TEMP_UNAVAILABLE, d->scratch);
+    double peer_mhz = median_known(d->mhz, d->threads, 0.0, d->scratch);
+
+    if (!d->ready) {
+        for (int i = 0; i <= d->threads; i++) {
+            degrade_track_t *tr = &d->tracks[i];
+            double temp = i < sys ? d->temp_c[i] : peer_temp;
+            double mhz = i < sys ? d->mhz[i] : peer_mhz;
+            tr->base_sum += tr->ewma;
+            tr->base_n++;
+            if (temp > TEMP_UNAVAILABLE) { tr->base_temp_sum += temp; tr->base_temp_n++; }
+            if (mhz > 0.0) { tr->base_mhz_sum += mhz; tr->base_mhz_n++; }
+        }
+        if (t >= d->baseline_sec) {
+            for (int i = 0; i <= d->threads; i++) {
+                degrade_track_t *tr = &d->tracks[i];
+                tr->base = tr->base_sum / tr->base_n;
+                tr->base_temp = tr->base_temp_n ? tr->base_temp_sum / tr->base_temp_n : TEMP_UNAVAILABLE;
+                tr->base_mhz = tr->base_mhz_n ? tr->base_mhz_sum / tr->base_mhz_n : 0.0;
+            }
+            d->ready = 1;
+        }
+    }
+
+    int n = 0;
+    for (int i = 0; i <= d->threads; i++) {
+        degrade_track_t *tr = &d->tracks[i];
+        double temp = i < sys ? d->temp_c[i] : peer_temp;
+        double mhz = i < sys ? d->mhz[i] : peer_mhz;
+
+        if (d->ready && tr->base > 0.0) {
+            double drop = (tr->base - tr->ewma) / tr->base * 100.0;
+            int s = step(tr, DEGRADE_SELF, drop, d->drop_pct);
+            if (s > 0) tr->cause[DEGRADE_SELF] = classify_self(tr, temp, mhz, thermal_cpus, power_cpus);
+            if (s != 0) {
+                emit(d, i, DEGRADE_SELF, s > 0, t, tr->base, drop, temp, tr->base_temp, mhz, tr->base_mhz, ev, max, &n);
+            }
+        }
+        if (i < sys && d->peer_n[i] >= DEGRADE_MIN_PEERS && d->peer_rate[i] > 0.0) {
+            double ref = d->peer_rate[i];
+            double drop = (ref - tr->ewma) / ref * 100.0;
+            int s = step(tr, DEGRADE_PEERS, drop, d->drop_pct);
+            if (s > 0) tr->cause[DEGRADE_PEERS] = classify_peers(temp, d->peer_temp[i], mhz, d->peer_mhz[i]);
+            if (s != 0) {
+                emit(d, i, DEGRADE_PEERS, s > 0, t, ref, drop, temp, d->peer_temp[i], mhz, d->peer_mhz[i], ev, max, &n);
+            }
+        }
+    }
+    return n;
+}
+
+int degrade_open_count(const degrade_t *d){
+    int n = 0;
+    for (int i = 0; d && i <= d->threads; i++) {
+        for (int s = 0; s < DEGRADE_SCOPE_COUNT; s++) n += d->tracks[i].active[s];
+    }
+    return n;
+}
+
+/* --- Nomes e Formatação --- */
+
+const char *degrade_cause_name(int cause){
+    switch (cause) {
+        case DEGRADE_CAUSE_THERMAL:   return "thermal";
+        case DEGRADE_CAUSE_POWER:     return "power";
+        case DEGRADE_CAUSE_FREQUENCY: return "frequency";
+        case DEGRADE_CAUSE_CORE:      return "core";
+        default:                      return "unknown";
+    }
+}
+
+int degrade_is_throttle(int cause){
+    return cause == DEGRADE_CAUSE_THERMAL || cause == DEGRADE_CAUSE_POWER || cause == DEGRADE_CAUSE_FREQUENCY;
+}
+
+static void format_temp(double c, char *buf, size_t len){
+    if (c > TEMP_UNAVAILABLE) snprintf(buf, len, "%.1f°C", c);
+    else snprintf(buf, len, "n/d");
+}
+
+static void format_mhz(double mhz, char *buf, size_t len){
+    if (mhz > 0.0) snprintf(buf, len, "%.0f MHz", mhz);
+    else snprintf(buf, len, "n/d");
+}
+
+void degrade_format_event(const degrade_event_t *ev, char *buf, size_t len){
+    static const char *causes[DEGRADE_CAUSE_COUNT] = {
+        "desconhecida", "térmica", "limite de potência", "queda de clock", "núcleo lento"
+    };
+    char who[16], temp[16], temp_ref[16], mhz[16], mhz_ref[16];
+    if (ev->worker >= 0) snprintf(who, sizeof(who), "T%d", ev->worker);
+    else snprintf(who, sizeof(who), "Sistema");
+    const char *cause = (ev->cause >= 0 && ev->cause < DEGRADE_CAUSE_COUNT) ? causes[ev->cause] : causes[0];
+    int peers = ev->scope == DEGRADE_PEERS;
+
+    if (!ev->begin) {
+        snprintf(buf, len, "[DEGRADE] %8.1fs %s: recuperado frente %s após %.1f s (%.1f iters/s, referência %.1f; causa %s)\n",
+                 ev->t, who, peers ? "à mediana dos pares" : "à linha de base", ev->duration, ev->rate, ev->ref, cause);
+        return;
+    }
+    format_temp(ev->temp_c, temp, sizeof(temp));
+    format_temp(ev->temp_ref, temp_ref, sizeof(temp_ref));
+    format_mhz(ev->mhz, mhz, sizeof(mhz));
+    format_mhz(ev->mhz_ref, mhz_ref, sizeof(mhz_ref));
+    snprintf(buf, len, "[DEGRADE] %8.1fs %s: %.1f%% abaixo %s (%.1f iters/s, referência %.1f), temp %s (ref. %s), "
+             "clock %s (ref. %s); causa provável: %s\n",
+             ev->t, who, ev->drop_pct, peers ? "da mediana dos pares" : "da linha de base", ev->rate, ev->ref,
+             temp, temp_ref, mhz, mhz_ref, cause);
+}
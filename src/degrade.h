@@ -0,0 +1,158 @@
+#ifndef DEGRADE_H
+#define DEGRADE_H
+
+/**
+ * @file degrade.h
+ * @brief Declara a detecção automática de limitação e degradação ao longo do teste.
+ *
+ * Alimentada pelo amostrador a cada intervalo, a análise suaviza a taxa de cada
+ * worker e a compara com duas referências: a média do próprio worker nos primeiros
+ * `baseline_sec` segundos (queda ao longo do teste) e a mediana dos demais workers
+ * do mesmo grupo no mesmo instante (núcleo mais lento que os pares). Uma queda só vira evento
+ * depois de `DEGRADE_HOLD_SAMPLES` amostras seguidas acima do limiar, e o episódio
+ * só termina quando a queda fica abaixo da metade do limiar pelo mesmo número de
+ * amostras. Cada início de episódio traz a temperatura, o clock e os contadores de
+ * limitação do intervalo, de onde sai a causa provável.
+ */
+
+#include "hardstress.h"
+
+/** @brief Amostras seguidas necessárias para abrir ou fechar um episódio. */
+#define DEGRADE_HOLD_SAMPLES 3
+/** @brief Peso de cada nova amostra na taxa suavizada (média móvel exponencial). */
+#define DEGRADE_EWMA_ALPHA 0.3
+/** @brief Aumento de temperatura, em °C, tratado como aquecimento. */
+#define DEGRADE_TEMP_RISE_C 5.0
+/** @brief Queda de clock, em %, tratada como redução de frequência. */
+#define DEGRADE_MHZ_DROP_PCT 5.0
+/** @brief Mínimo de workers no grupo para comparar um worker com a mediana dos pares. */
+#define DEGRADE_MIN_PEERS 3
+
+/**
+ * @enum degrade_scope_t
+ * @brief A referência contra a qual a queda foi medida.
+ */
+typedef enum {
+    DEGRADE_SELF = 0,       ///< A linha de base do próprio worker (ou do sistema).
+    DEGRADE_PEERS,          ///< A mediana dos workers no mesmo instante.
+    DEGRADE_SCOPE_COUNT
+} degrade_scope_t;
+
+/**
+ * @enum degrade_cause_t
+ * @brief A causa provável de um episódio.
+ */
+typedef enum {
+    DEGRADE_CAUSE_UNKNOWN = 0,  ///< Nada no intervalo explica a queda.
+    DEGRADE_CAUSE_THERMAL,      ///< Contadores de limitação térmica avançaram ou a temperatura subiu.
+    DEGRADE_CAUSE_POWER,        ///< Contadores de limite de potência avançaram.
+    DEGRADE_CAUSE_FREQUENCY,    ///< O clock caiu sem sinal térmico ou de potência.
+    DEGRADE_CAUSE_CORE,         ///< Mais lento que os pares à mesma temperatura e clock.
+    DEGRADE_CAUSE_COUNT
+} degrade_cause_t;
+
+/**
+ * @struct degrade_event_t
+ * @brief O início ou o fim de um episódio de degradação.
+ */
+typedef struct {
+    double t;               ///< Instante do evento, em segundos desde a largada.
+    int worker;             ///< Worker afetado, ou -1 para a vazão total do sistema.
+    int scope;              ///< `degrade_scope_t`.
+    int begin;              ///< 1 no início do episódio, 0 no fim.
+    int cause;              ///< `degrade_cause_t` (atribuída no início e repetida no fim).
+    double rate;            ///< Taxa suavizada, em iterações/s.
+    double ref;             ///< Taxa de referência (linha de base ou mediana dos pares).
+    double drop_pct;        ///< Queda em relação a `ref`, em %.
+    double temp_c, temp_ref;///< Temperatura do worker e a de referência (`TEMP_UNAVAILABLE` se desconhecidas).
+    double mhz, mhz_ref;    ///< Clock do worker e o de referência, em MHz (0 se desconhecidos).
+    double duration;        ///< No fim, a duração do episódio em segundos.
+} degrade_event_t;
+
+/**
+ * @struct degrade_track_t
+ * @brief Estado da análise de um worker (ou do sistema).
+ */
+typedef struct {
+    double ewma;            ///< Taxa suavizada.
+    double base_sum, base_temp_sum, base_mhz_sum; ///< Somas da janela da linha de base.
+    int base_n, base_temp_n, base_mhz_n;          ///< Amostras somadas em cada soma.
+    double base, base_temp, base_mhz;             ///< Linha de base (válida após `ready`).
+    int active[DEGRADE_SCOPE_COUNT];  ///< Episódio aberto em cada referência.
+    int streak[DEGRADE_SCOPE_COUNT];  ///< Amostras seguidas no sentido de mudar `active`.
+    double since[DEGRADE_SCOPE_COUNT];///< Início do episódio aberto.
+    int cause[DEGRADE_SCOPE_COUNT];   ///< Causa do episódio aberto.
+} degrade_track_t;
+
+/**
+ * @struct degrade_t
+ * @brief O analisador; usado apenas pela thread do amostrador.
+ *
+ * Antes de cada `degrade_update`, quem chama preenche `progress`, `temp_c` e
+ * `mhz` com os valores atuais de cada worker. `group` separa workers que executam
+ * trabalhos diferentes, cujas taxas não são comparáveis entre si.
+ */
+typedef struct {
+    int threads;            ///< Número de workers.
+    double baseline_sec;    ///< Duração da janela da linha de base.
+    double drop_pct;        ///< Queda, em %, que abre um episódio.
+    int ready;              ///< Não-zero quando a linha de base está fechada.
+    int primed;             ///< 1 após a primeira amostra (referência das taxas), 2 após a primeira taxa.
+    double last_t;          ///< Instante da amostra anterior.
+    unsigned long long *progress;      ///< Entrada: progresso cumulativo de cada worker.
+    double *temp_c;                    ///< Entrada: temperatura de cada worker (`TEMP_UNAVAILABLE` se desconhecida).
+    double *mhz;                       ///< Entrada: clock da CPU de cada worker (0 se desconhecido).
+    int *group;                        ///< Entrada: grupo de cada worker; só workers do mesmo grupo são pares (0 por padrão).
+    unsigned long long *last_progress; ///< Progresso de cada worker na amostra anterior.
+    double *scratch, *gather;          ///< Espaço para as medianas.
+    double *peer_rate, *peer_temp, *peer_mhz; ///< Medianas do grupo de cada worker na amostra corrente.
+    int *peer_n;                       ///< Tamanho do grupo de cada worker.
+    degrade_track_t *tracks;           ///< `threads` + 1 trilhas; a última é a vazão total.
+    unsigned long long events;         ///< Episódios abertos até agora.
+} degrade_t;
+
+/**
+ * @brief Cria o analisador para `threads` workers.
+ * @param baseline_sec Duração da janela da linha de base, em segundos (> 0).
+ * @param drop_pct Queda, em %, que abre um episódio.
+ * @return O analisador, ou NULL em caso de falha de alocação.
+ */
+degrade_t *degrade_create(int threads, double baseline_sec, double drop_pct);
+
+/**
+ * @brief Libera o analisador; NULL é ignorado.
+ */
+void degrade_free(degrade_t *d);
+
+/**
+ * @brief Processa uma amostra.
+ * @param t Instante da amostra, em segundos desde a largada.
+ * @param thermal_cpus CPUs com limitação térmica no intervalo.
+ * @param power_cpus CPUs com limite de potência no intervalo.
+ * @param ev Recebe os eventos gerados.
+ * @param max Capacidade de `ev`; eventos além dela são descartados.
+ * @return O número de eventos gravados em `ev`.
+ */
+int degrade_update(degrade_t *d, double t, int thermal_cpus, int power_cpus, degrade_event_t *ev, int max);
+
+/**
+ * @brief Conta os episódios ainda abertos.
+ */
+int degrade_open_count(const degrade_t *d);
+
+/**
+ * @brief Nome estável da causa, usado na exportação ("thermal", "power", "frequency", "core", "unknown").
+ */
+const char *degrade_cause_name(int cause);
+
+/**
+ * @brief Indica se a causa é uma limitação do hardware ("throttle") e não uma degradação sem explicação.
+ */
+int degrade_is_throttle(int cause);
+
+/**
+ * @brief Formata o evento como uma linha de log legível.
+ */
+void degrade_format_event(const degrade_event_t *ev, char *buf, size_t len);
+
+#endif // DEGRADE_H
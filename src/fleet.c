@@ -0,0 +1,1372 @@
+#if defined(_WIN32) && (!defined(_WIN32_WINNT) || _WIN32_WINNT < 0x0600)
+#undef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600 // WSAPoll, usado no lugar de select para não depender de FD_SETSIZE.
+#endif
+#include "fleet.h"
+#include "core.h"     // Para app_context_create, app_context_free
+#include "headless.h" // Para headless_parse_args, headless_run
+#include "utils.h"    // Para now_sec
+#include "ui.h"       // Para gui_log, gui_update_stopped
+#include "metrics.h"  // Para detect_cpu_count
+#include "topology.h" // Para affinity_policy_t
+#include <errno.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#define resolve_path(p) _fullpath(NULL, (p), 0)
+#define path_ncmp(a, b, n) _strnicmp((a), (b), (n))
+#define path_is_sep(c) ((c) == '\\' || (c) == '/')
+#define SOCK_ERRNO() WSAGetLastError()
+#define SOCK_WOULD_BLOCK(e) ((e) == WSAEWOULDBLOCK)
+#define SOCK_IN_PROGRESS(e) ((e) == WSAEWOULDBLOCK || (e) == WSAEINPROGRESS)
+typedef WSAPOLLFD sock_pollfd_t;
+#define sock_poll(fds, n, ms) WSAPoll((fds), (ULONG)(n), (ms))
+typedef int sock_len_t;
+#else
+#include <sys/socket.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <fcntl.h>
+#define resolve_path(p) realpath((p), NULL)
+#define path_ncmp(a, b, n) strncmp((a), (b), (n))
+#define path_is_sep(c) ((c) == '/')
+#define SOCK_ERRNO() errno
+#define SOCK_WOULD_BLOCK(e) ((e) == EAGAIN || (e) == EWOULDBLOCK)
+#define SOCK_IN_PROGRESS(e) ((e) == EINPROGRESS)
+typedef struct pollfd sock_pollfd_t;
+#define sock_poll(fds, n, ms) poll((fds), (nfds_t)(n), (ms))
+typedef socklen_t sock_len_t;
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0      // Sem SIGPIPE no Windows; no Linux a escrita em uma conexão fechada só retorna erro.
+#endif
+
+/** @brief Maior número de argumentos aceito em uma configuração. */
+#define FLEET_MAX_ARGS 128
+/** @brief Maior antecedência de largada aceita pelo agente, em segundos. */
+#define FLEET_MAX_LEAD_SEC 600.0
+/** @brief Prazo para o coordenador enviar a configuração depois de conectar, em segundos. */
+#define FLEET_CONFIG_TIMEOUT_SEC 10.0
+/** @brief Diferença de relógio a partir da qual o coordenador avisa que a largada não será simultânea, em ms. */
+#define FLEET_CLOCK_WARN_MS 100.0
+
+/**
+ * @struct agent_session_t
+ * @brief Estado de uma sessão no agente, usado pelo passo de `headless_run`.
+ */
+typedef struct {
+    fleet_socket_t sock;    ///< Conexão com o coordenador.
+    unsigned char rx[FLEET_HEADER_BYTES + FLEET_MAX_PAYLOAD]; ///< Bytes recebidos ainda não consumidos.
+    size_t rx_len;          ///< Bytes válidos em `rx`.
+    unsigned long long last_seq; ///< `history_seq` da última amostra enviada.
+    double started_at;      ///< `now_sec` da largada (0 antes dela).
+    double last_tick;       ///< `now_sec` do último passo com o teste em execução (o fim, sem a finalização).
+    int lost;               ///< 1 se a conexão caiu ou o envio falhou.
+} agent_session_t;
+
+/* --- Static Function Prototypes --- */
+static void put_u16(unsigned char *p, uint16_t v);
+static void put_u32(unsigned char *p, uint32_t v);
+static void put_u64(unsigned char *p, uint64_t v);
+static uint16_t get_u16(const unsigned char *p);
+static uint32_t get_u32(const unsigned char *p);
+static uint64_t get_u64(const unsigned char *p);
+static double wall_now(void);
+static int net_init(void);
+static void net_cleanup(void);
+static void sock_error_text(int code, char *buf, size_t len);
+static int set_nonblocking(fleet_socket_t s, int on);
+static void set_nodelay(fleet_socket_t s);
+static int wait_socket(fleet_socket_t s, int for_write, double timeout_sec);
+static int send_all(fleet_socket_t s, const unsigned char *buf, size_t len);
+static int send_frame(fleet_socket_t s, int type, const void *payload, size_t len);
+static int recv_frame(fleet_socket_t s, unsigned char *buf, double timeout_sec, int *type, size_t *len);
+static int next_node(const char **p, char *host, size_t host_len, int *port, char *err, size_t err_len);
+static int add_arg(char *buf, size_t cap, size_t *len, const char *fmt, ...);
+static void connect_nodes(AppContext *app, fleet_t *f);
+static void node_fail(AppContext *app, fleet_t *f, fleet_node_t *node, const char *fmt, ...);
+static void node_receive(AppContext *app, fleet_t *f, fleet_node_t *node);
+static void handle_frame(AppContext *app, fleet_t *f, fleet_node_t *node, int type, const unsigned char *p, size_t len);
+static void report_fleet_summary(AppContext *app, fleet_t *f);
+static int agent_tick(AppContext *app, void *ctx);
+static int agent_poll(AppContext *app, agent_session_t *s);
+static int agent_collect(AppContext *app, agent_session_t *s, fleet_sample_t *out);
+static void agent_send_error(fleet_socket_t s, const char *msg);
+static int sock_is_loopback(fleet_socket_t s);
+static int token_equal(const char *a, const char *b);
+static int io_target_allowed(const char *dir, const char *target);
+static int agent_check_args(int argc, char **argv, const fleet_agent_policy_t *policy, char *why, size_t why_len);
+static int parse_listen_spec(const char *spec, char *addr, size_t addr_len, int *port);
+
+/* --- Codificação --- */
+
+static void put_u16(unsigned char *p, uint16_t v){
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static void put_u32(unsigned char *p, uint32_t v){
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void put_u64(unsigned char *p, uint64_t v){
+    for (int i = 0; i < 8; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static uint16_t get_u16(const unsigned char *p){
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const unsigned char *p){
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t get_u64(const unsigned char *p){
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+void fleet_frame_header(unsigned char *buf, int type, size_t payload_len){
+    buf[0] = 'H';
+    buf[1] = 'S';
+    buf[2] = FLEET_PROTOCOL_VERSION;
+    buf[3] = (unsigned char)type;
+    put_u32(buf + 4, (uint32_t)payload_len);
+}
+
+long fleet_frame_parse(const unsigned char *buf, size_t len, int *type, size_t *payload_len){
+    if (len < FLEET_HEADER_BYTES) return 0;
+    if (buf[0] != 'H' || buf[1] != 'S' || buf[2] != FLEET_PROTOCOL_VERSION) return -1;
+    if (buf[3] < FLEET_MSG_CONFIG || buf[3] > FLEET_MSG_SUMMARY) return -1;
+    uint32_t n = get_u32(buf + 4);
+    if (n > FLEET_MAX_PAYLOAD) return -1;
+    if (len < FLEET_HEADER_BYTES + (size_t)n) return 0;
+    *type = buf[3];
+    *payload_len = n;
+    return (long)(FLEET_HEADER_BYTES + n);
+}
+
+void fleet_sample_encode(const fleet_sample_t *s, unsigned char *p){
+    put_u32(p, (uint32_t)s->seq);
+    double ms = s->elapsed * 1e3;
+    put_u32(p + 4, ms <= 0.0 ? 0u : (ms >= 4294967295.0 ? UINT32_MAX : (uint32_t)(ms + 0.5)));
+    for (int m = 0; m < THREAD_METRIC_COUNT; m++) {
+        float f = (float)s->rate[m];
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        put_u32(p + 8 + 4 * m, bits);
+    }
+    unsigned char *q = p + 8 + 4 * THREAD_METRIC_COUNT;
+    // Temperatura em décimos de grau; INT16_MIN indica que não há leitura.
+    int16_t temp = INT16_MIN;
+    if (s->temp_c > TEMP_UNAVAILABLE) temp = (int16_t)fmax(-32767.0, fmin(32767.0, round(s->temp_c * 10.0)));
+    put_u16(q, (uint16_t)temp);
+    put_u16(q + 2, (uint16_t)fmax(0.0, fmin(10000.0, round(s->cpu_usage * 10000.0))));
+    put_u16(q + 4, (uint16_t)fmax(0.0, fmin(65535.0, round(s->freq_mhz))));
+    put_u32(q + 6, s->errors);
+}
+
+void fleet_sample_decode(const unsigned char *p, fleet_sample_t *s){
+    s->seq = get_u32(p);
+    s->elapsed = get_u32(p + 4) / 1e3;
+    for (int m = 0; m < THREAD_METRIC_COUNT; m++) {
+        uint32_t bits = get_u32(p + 8 + 4 * m);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        s->rate[m] = f;
+    }
+    const unsigned char *q = p + 8 + 4 * THREAD_METRIC_COUNT;
+    int16_t temp = (int16_t)get_u16(q);
+    s->temp_c = temp == INT16_MIN ? TEMP_UNAVAILABLE : temp / 10.0;
+    s->cpu_usage = get_u16(q + 2) / 10000.0;
+    s->freq_mhz = get_u16(q + 4);
+    s->errors = get_u32(q + 6);
+}
+
+/* --- Sockets --- */
+
+/**
+ * @brief Tempo Unix em segundos, o relógio comum combinado entre os nós.
+ */
+static double wall_now(void){
+    return (double)g_get_real_time() / 1e6;
+}
+
+static int net_init(void){
+#ifdef _WIN32
+    WSADATA wsa;
+    return WSAStartup(MAKEWORD(2, 2), &wsa) == 0 ? 0 : -1;
+#else
+    return 0;
+#endif
+}
+
+static void net_cleanup(void){
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+static void sock_error_text(int code, char *buf, size_t len){
+#ifdef _WIN32
+    snprintf(buf, len, "erro de socket %d", code);
+#else
+    snprintf(buf, len, "%s", strerror(code));
+#endif
+}
+
+void fleet_socket_close(fleet_socket_t s){
+    if (s == FLEET_BAD_SOCKET) return;
+#ifdef _WIN32
+    closesocket(s);
+#else
+    close(s);
+#endif
+}
+
+static int set_nonblocking(fleet_socket_t s, int on){
+#ifdef _WIN32
+    u_long mode = on ? 1 : 0;
+    return ioctlsocket(s, FIONBIO, &mode) == 0 ? 0 : -1;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    if (flags < 0) return -1;
+    return fcntl(s, F_SETFL, on ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK)) == 0 ? 0 : -1;
+#endif
+}
+
+/**
+ * @brief Desliga o algoritmo de Nagle: cada quadro sai assim que é escrito.
+ */
+static void set_nodelay(fleet_socket_t s){
+    int one = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&one, sizeof(one));
+}
+
+/**
+ * @brief Espera até `s` estar pronto para leitura (ou escrita).
+ * @return 1 se pronto, 0 no fim do prazo, -1 em caso de erro.
+ */
+static int wait_socket(fleet_socket_t s, int for_write, double timeout_sec){
+    sock_pollfd_t pfd = { .fd = s, .events = for_write ? POLLOUT : POLLIN };
+    if (timeout_sec < 0.0) timeout_sec = 0.0;
+    // Erro ou desconexão também contam como prontos: a operação seguinte no socket os relata.
+    int r = sock_poll(&pfd, 1, (int)ceil(timeout_sec * 1e3));
+    return r > 0 ? 1 : (r == 0 ? 0 : -1);
+}
+
+/**
+ * @brief Envia `len` bytes, esperando pelo buffer do socket se ele estiver em modo não bloqueante.
+ * @return 0 em caso de sucesso, -1 se a conexão falhou.
+ */
+static int send_all(fleet_socket_t s, const unsigned char *buf, size_t len){
+    while (len > 0) {
+        int n = (int)send(s, (const char*)buf, (int)len, MSG_NOSIGNAL);
+        if (n > 0) {
+            buf += n;
+            len -= (size_t)n;
+            continue;
+        }
+        int e = SOCK_ERRNO();
+        if (n < 0 && SOCK_WOULD_BLOCK(e) && wait_socket(s, 1, 2.0) == 1) continue;
+        if (n < 0 && e == EINTR) continue;
+        return -1;
+    }
+    return 0;
+}
+
+static int send_frame(fleet_socket_t s, int type, const void *payload, size_t len){
+    unsigned char buf[FLEET_HEADER_BYTES + FLEET_MAX_PAYLOAD];
+    if (len > FLEET_MAX_PAYLOAD) return -1;
+    fleet_frame_header(buf, type, len);
+    if (len > 0) memcpy(buf + FLEET_HEADER_BYTES, payload, len);
+    return send_all(s, buf, FLEET_HEADER_BYTES + len);
+}
+
+/**
+ * @brief Lê um quadro inteiro de um socket, bloqueante ou não, em até `timeout_sec`.
+ * @param buf Recebe o quadro; deve ter `FLEET_HEADER_BYTES + FLEET_MAX_PAYLOAD` bytes. A carga começa em `FLEET_HEADER_BYTES`.
+ * @return 0 em caso de sucesso, -1 no fim do prazo, se a conexão caiu ou se o quadro for inválido.
+ */
+static int recv_frame(fleet_socket_t s, unsigned char *buf, double timeout_sec, int *type, size_t *len){
+    double deadline = now_sec() + timeout_sec;
+    size_t have = 0, need = FLEET_HEADER_BYTES;
+    while (have < need) {
+        if (wait_socket(s, 0, deadline - now_sec()) != 1) return -1;
+        int n = (int)recv(s, (char*)buf + have, (int)(need - have), 0);
+        if (n < 0 && SOCK_WOULD_BLOCK(SOCK_ERRNO())) continue;
+        if (n <= 0) return -1;
+        have += (size_t)n;
+        if (have == FLEET_HEADER_BYTES) {
+            long total = fleet_frame_parse(buf, have, type, len);
+            if (total < 0) return -1;
+            // Com a carga vazia o quadro já está completo; senão, o cabeçalho diz quanto falta.
+            need = FLEET_HEADER_BYTES + get_u32(buf + 4);
+        }
+    }
+    return fleet_frame_parse(buf, have, type, len) > 0 ? 0 : -1;
+}
+
+/* --- Frota --- */
+
+/**
+ * @brief Lê o próximo nó ("host[:porta]" ou "[ipv6]:porta") de uma lista separada por vírgulas ou espaços.
+ * @return 1 se leu um nó, 0 no fim da lista, -1 se o nó for inválido.
+ */
+static int next_node(const char **p, char *host, size_t host_len, int *port, char *err, size_t err_len){
+    const char *s = *p;
+    while (*s == ',' || *s == ' ' || *s == '\t') s++;
+    if (*s == '\0') {
+        *p = s;
+        return 0;
+    }
+    const char *end = s;
+    while (*end && *end != ',' && *end != ' ' && *end != '\t') end++;
+    *p = end;
+
+    char tok[300];
+    size_t n = (size_t)(end - s);
+    if (n >= sizeof(tok)) {
+        snprintf(err, err_len, "nó longo demais: '%.40s...'", s);
+        return -1;
+    }
+    memcpy(tok, s, n);
+    tok[n] = '\0';
+
+    const char *h = tok, *port_str = NULL;
+    char *colon = strrchr(tok, ':');
+    if (tok[0] == '[') {
+        char *close_br = strchr(tok, ']');
+        if (!close_br || (close_br[1] != '\0' && close_br[1] != ':')) {
+            snprintf(err, err_len, "endereço IPv6 inválido: '%s'", tok);
+            return -1;
+        }
+        *close_br = '\0';
+        h = tok + 1;
+        if (close_br[1] == ':') port_str = close_br + 2;
+    } else if (colon && strchr(tok, ':') == colon) {
+        // Um único ':' separa a porta; vários formam um IPv6 sem porta.
+        *colon = '\0';
+        port_str = colon + 1;
+    }
+
+    *port = FLEET_DEFAULT_PORT;
+    if (port_str) {
+        char *e;
+        long v = strtol(port_str, &e, 10);
+        if (*port_str == '\0' || *e != '\0' || v < 1 || v > 65535) {
+            snprintf(err, err_len, "porta inválida em '%.*s'", (int)n, s);
+            return -1;
+        }
+        *port = (int)v;
+    }
+    if (*h == '\0' || strlen(h) >= host_len) {
+        snprintf(err, err_len, "nó inválido: '%.*s'", (int)n, s);
+        return -1;
+    }
+    snprintf(host, host_len, "%s", h);
+    return 1;
+}
+
+fleet_t *fleet_create(const char *list, char *err, size_t err_len){
+    if (!list) list = "";
+    char host[256];
+    int port, n = 0, r;
+    const char *p = list;
+    while ((r = next_node(&p, host, sizeof(host), &port, err, err_len)) == 1) n++;
+    if (r < 0) return NULL;
+    if (n == 0) {
+        snprintf(err, err_len, "nenhum nó informado");
+        return NULL;
+    }
+    if (n > FLEET_MAX_NODES) {
+        snprintf(err, err_len, "%d nós; o máximo é %d", n, FLEET_MAX_NODES);
+        return NULL;
+    }
+
+    const char *token = getenv(FLEET_TOKEN_ENV);
+    if (token && strlen(token) >= FLEET_TOKEN_MAX) {
+        snprintf(err, err_len, "token em %s longo demais (máximo de %d bytes)", FLEET_TOKEN_ENV, FLEET_TOKEN_MAX - 1);
+        return NULL;
+    }
+
+    fleet_t *f = calloc(1, sizeof(*f));
+    if (f) f->nodes = calloc((size_t)n, sizeof(fleet_node_t));
+    if (!f || !f->nodes) {
+        free(f);
+        snprintf(err, err_len, "falta de memória");
+        return NULL;
+    }
+    f->n = n;
+    f->lead_sec = FLEET_DEFAULT_LEAD_SEC;
+    if (token) snprintf(f->token, sizeof(f->token), "%s", token);
+    p = list;
+    for (int i = 0; i < n; i++) {
+        fleet_node_t *node = &f->nodes[i];
+        next_node(&p, node->host, sizeof(node->host), &node->port, err, err_len);
+        snprintf(node->name, sizeof(node->name), "%.*s", (int)sizeof(node->name) - 1, node->host);
+        node->sock = FLEET_BAD_SOCKET;
+        node->exit_code = -1;
+    }
+    return f;
+}
+
+void fleet_free(fleet_t *f){
+    if (!f) return;
+    for (int i = 0; i < f->n; i++) fleet_socket_close(f->nodes[i].sock);
+    free(f->nodes);
+    free(f);
+}
+
+/**
+ * @brief Acrescenta um argumento formatado, terminado em NUL, a `buf`.
+ * @return 0 em caso de sucesso, -1 se não couber.
+ */
+static int add_arg(char *buf, size_t cap, size_t *len, const char *fmt, ...){
+    if (*len >= cap) return -1;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf + *len, cap - *len, fmt, ap);
+    va_end(ap);
+    if (n < 0 || (size_t)n + 1 > cap - *len) return -1;
+    *len += (size_t)n + 1;
+    return 0;
+}
+
+int fleet_config_args(const AppContext *app, char *buf, size_t cap){
+    static const char *const affinity[] = {
+        [AFFINITY_PHYSICAL_FIRST] = "physical", [AFFINITY_LINEAR] = "linear", [AFFINITY_SCATTER] = "scatter",
+        [AFFINITY_COMPACT] = "compact", [AFFINITY_SMT_PAIRS] = "smt-pairs",
+    };
+    static const char *const numa[] = { [NUMA_MODE_OFF] = "off", [NUMA_MODE_LOCAL] = "local", [NUMA_MODE_REMOTE] = "remote" };
+    static const char *const pages[] = {
+        [PAGE_MODE_DEFAULT] = "default", [PAGE_MODE_THP] = "thp", [PAGE_MODE_HUGE_2M] = "2m", [PAGE_MODE_HUGE_1G] = "1g",
+    };
+    char kernels[64];
+    snprintf(kernels, sizeof(kernels), "%s%s%s%s%s", app->kernel_fpu_en ? "fpu," : "", app->kernel_int_en ? "int," : "",
+             app->kernel_stream_en ? "stream," : "", app->kernel_ptr_en ? "ptr," : "", app->kernel_atomic_en ? "atomic," : "");
+    size_t klen = strlen(kernels);
+    if (klen == 0) return -1;
+    kernels[klen - 1] = '\0';
+
+    size_t len = 0;
+    int rc = 0;
+    rc |= add_arg(buf, cap, &len, "-t") | add_arg(buf, cap, &len, "%d", app->threads);
+    rc |= add_arg(buf, cap, &len, "-m") | add_arg(buf, cap, &len, "%zu", app->mem_mib_per_thread);
+    rc |= add_arg(buf, cap, &len, "-d") | add_arg(buf, cap, &len, "%d", app->duration_sec);
+    if (app->sample_interval_ms > 0) rc |= add_arg(buf, cap, &len, "--interval") | add_arg(buf, cap, &len, "%d", app->sample_interval_ms);
+    rc |= add_arg(buf, cap, &len, "-k") | add_arg(buf, cap, &len, "%s", kernels);
+    if (!app->pin_affinity) {
+        rc |= add_arg(buf, cap, &len, "--no-pin");
+    } else if (app->affinity_policy == AFFINITY_LIST) {
+        rc |= add_arg(buf, cap, &len, "--cpus") | add_arg(buf, cap, &len, "%s", app->affinity_list);
+    } else {
+        int policy = app->affinity_policy >= AFFINITY_PHYSICAL_FIRST && app->affinity_policy <= AFFINITY_SMT_PAIRS
+                     ? app->affinity_policy : AFFINITY_PHYSICAL_FIRST;
+        rc |= add_arg(buf, cap, &len, "--affinity") | add_arg(buf, cap, &len, "%s", affinity[policy]);
+    }
+    if (app->numa_mode > NUMA_MODE_OFF && app->numa_mode <= NUMA_MODE_REMOTE) {
+        rc |= add_arg(buf, cap, &len, "--numa") | add_arg(buf, cap, &len, "%s", numa[app->numa_mode]);
+    }
+    if (app->page_mode > PAGE_MODE_DEFAULT && app->page_mode <= PAGE_MODE_HUGE_1G) {
+        rc |= add_arg(buf, cap, &len, "--pages") | add_arg(buf, cap, &len, "%s", pages[app->page_mode]);
+    }
+    if (app->ptr_chains > 1) rc |= add_arg(buf, cap, &len, "--ptr-chains") | add_arg(buf, cap, &len, "%d", app->ptr_chains);
+    if (app->fp_block_kib > 0) rc |= add_arg(buf, cap, &len, "--fp-block") | add_arg(buf, cap, &len, "%zu", app->fp_block_kib);
+    if (app->stream_nt) rc |= add_arg(buf, cap, &len, "--stream-nt");
+    if (app->stream_prefetch > 0) rc |= add_arg(buf, cap, &len, "--stream-prefetch") | add_arg(buf, cap, &len, "%zu", app->stream_prefetch);
+    if (app->perf_en) rc |= add_arg(buf, cap, &len, "--perf");
+    rc |= add_arg(buf, cap, &len, "--degrade-baseline") | add_arg(buf, cap, &len, "%d", app->degrade_baseline_sec);
+    if (app->degrade_pct > 0) rc |= add_arg(buf, cap, &len, "--degrade-pct") | add_arg(buf, cap, &len, "%d", app->degrade_pct);
+    if (app->load_profile[0]) rc |= add_arg(buf, cap, &len, "--profile") | add_arg(buf, cap, &len, "%s", app->load_profile);
+    if (app->worker_roles[0]) rc |= add_arg(buf, cap, &len, "--roles") | add_arg(buf, cap, &len, "%s", app->worker_roles);
+    if (app->io_path[0]) {
+        // O alvo é um caminho no próprio nó; --io-destructive não é enviado, pois o agente o recusa.
+        rc |= add_arg(buf, cap, &len, "--io") | add_arg(buf, cap, &len, "%s", app->io_path);
+        rc |= add_arg(buf, cap, &len, "--io-size") | add_arg(buf, cap, &len, "%zu", app->io_file_mib);
+        rc |= add_arg(buf, cap, &len, "--io-qd") | add_arg(buf, cap, &len, "%d", app->io_qd);
+        rc |= add_arg(buf, cap, &len, "--io-bs") | add_arg(buf, cap, &len, "%zu", app->io_block_kib);
+        rc |= add_arg(buf, cap, &len, "--io-read") | add_arg(buf, cap, &len, "%d", app->io_read_pct);
+    }
+    if (app->jitter_en) rc |= add_arg(buf, cap, &len, "--jitter-us") | add_arg(buf, cap, &len, "%d", app->jitter_interval_us);
+    if (app->verify_en) rc |= add_arg(buf, cap, &len, "--verify");
+    return rc == 0 ? (int)len : -1;
+}
+
+/* --- Coordenador --- */
+
+/**
+ * @brief Marca um nó como falho, fecha a sua conexão e conta o erro.
+ */
+static void node_fail(AppContext *app, fleet_t *f, fleet_node_t *node, const char *fmt, ...){
+    char msg[160];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+    fleet_socket_close(node->sock);
+    node->sock = FLEET_BAD_SOCKET;
+    g_mutex_lock(&app->history_mutex);
+    node->state = FLEET_NODE_FAILED;
+    snprintf(node->error, sizeof(node->error), "%s", msg);
+    f->version++;
+    g_mutex_unlock(&app->history_mutex);
+    gui_log(app, "[FLEET] %s: %s.\n", node->name, msg);
+    atomic_fetch_add(&app->errors, 1);
+}
+
+/**
+ * @brief Conecta a todos os nós em paralelo, com conexões não bloqueantes e um prazo comum.
+ */
+static void connect_nodes(AppContext *app, fleet_t *f){
+    char err[128];
+    for (int i = 0; i < f->n; i++) {
+        fleet_node_t *node = &f->nodes[i];
+        char port[16];
+        snprintf(port, sizeof(port), "%d", node->port);
+        struct addrinfo hints, *res = NULL;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        int gai = getaddrinfo(node->host, port, &hints, &res);
+        if (gai != 0 || !res) {
+            node_fail(app, f, node, "falha ao resolver o endereço (%s)", gai_strerror(gai));
+            continue;
+        }
+        fleet_socket_t s = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+        if (s == FLEET_BAD_SOCKET || set_nonblocking(s, 1) != 0) {
+            sock_error_text(SOCK_ERRNO(), err, sizeof(err));
+            fleet_socket_close(s);
+            freeaddrinfo(res);
+            node_fail(app, f, node, "falha ao criar o socket (%s)", err);
+            continue;
+        }
+        int rc = connect(s, res->ai_addr, (sock_len_t)res->ai_addrlen);
+        int e = SOCK_ERRNO();
+        freeaddrinfo(res);
+        if (rc != 0 && !SOCK_IN_PROGRESS(e)) {
+            sock_error_text(e, err, sizeof(err));
+            fleet_socket_close(s);
+            node_fail(app, f, node, "falha ao conectar (%s)", err);
+            continue;
+        }
+        node->sock = s;
+    }
+
+    // As conexões pendentes terminam quando o socket fica pronto para escrita; SO_ERROR diz se deu certo.
+    double deadline = now_sec() + FLEET_CONNECT_TIMEOUT_SEC;
+    for (int i = 0; i < f->n; i++) {
+        fleet_node_t *node = &f->nodes[i];
+        if (node->sock == FLEET_BAD_SOCKET) continue;
+        if (wait_socket(node->sock, 1, deadline - now_sec()) != 1) {
+            node_fail(app, f, node, "sem resposta em %.0f s ao conectar", FLEET_CONNECT_TIMEOUT_SEC);
+            continue;
+        }
+        int so_error = 0;
+        sock_len_t so_len = sizeof(so_error);
+        getsockopt(node->sock, SOL_SOCKET, SO_ERROR, (char*)&so_error, &so_len);
+        if (so_error != 0) {
+            sock_error_text(so_error, err, sizeof(err));
+            node_fail(app, f, node, "falha ao conectar (%s)", err);
+            continue;
+        }
+        set_nodelay(node->sock);
+    }
+}
+
+/**
+ * @brief Trata um quadro recebido de um nó.
+ */
+static void handle_frame(AppContext *app, fleet_t *f, fleet_node_t *node, int type, const unsigned char *p, size_t len){
+    switch (type) {
+    case FLEET_MSG_READY: {
+        if (len < 12) break;
+        int threads = (int)get_u32(p), cpus = (int)get_u32(p + 4);
+        double offset = (double)(int32_t)get_u32(p + 8);
+        size_t name_len = len - 12 < sizeof(node->name) - 1 ? len - 12 : sizeof(node->name) - 1;
+        g_mutex_lock(&app->history_mutex);
+        node->threads = threads;
+        node->cpus = cpus;
+        node->clock_offset_ms = offset;
+        if (name_len > 0) {
+            memcpy(node->name, p + 12, name_len);
+            node->name[name_len] = '\0';
+        }
+        node->state = FLEET_NODE_READY;
+        f->version++;
+        g_mutex_unlock(&app->history_mutex);
+        gui_log(app, "[FLEET] %s (%s:%d): %d thread(s) em %d CPU(s), relógio %+.0f ms em relação ao coordenador\n",
+                node->name, node->host, node->port, threads, cpus, offset);
+        if (fabs(offset) > FLEET_CLOCK_WARN_MS) {
+            gui_log(app, "[FLEET] %s: o relógio difere do coordenador em %+.0f ms; a largada deste nó não será simultânea "
+                    "(sincronize os relógios com NTP/PTP).\n", node->name, offset);
+        }
+        break;
+    }
+    case FLEET_MSG_ERROR: {
+        char msg[160];
+        size_t n = len < sizeof(msg) - 1 ? len : sizeof(msg) - 1;
+        memcpy(msg, p, n);
+        msg[n] = '\0';
+        node_fail(app, f, node, "%s", msg);
+        break;
+    }
+    case FLEET_MSG_STARTED: {
+        if (len < 4) break;
+        double late = (double)(int32_t)get_u32(p);
+        g_mutex_lock(&app->history_mutex);
+        node->start_late_ms = late;
+        node->state = FLEET_NODE_RUNNING;
+        f->version++;
+        g_mutex_unlock(&app->history_mutex);
+        if (late > FLEET_CLOCK_WARN_MS) {
+            gui_log(app, "[FLEET] %s: largada %.0f ms depois do instante combinado (a inicialização levou mais que a "
+                    "antecedência de %.0f s).\n", node->name, late, f->lead_sec);
+        }
+        break;
+    }
+    case FLEET_MSG_SAMPLE: {
+        if (len != FLEET_SAMPLE_PAYLOAD) {
+            node_fail(app, f, node, "quadro de amostra com %zu bytes", len);
+            break;
+        }
+        fleet_sample_t s;
+        fleet_sample_decode(p, &s);
+        g_mutex_lock(&app->history_mutex);
+        node->last = s;
+        node->ring[s.seq % HISTORY_SAMPLES] = s;
+        node->samples++;
+        if (s.seq > f->max_seq) f->max_seq = s.seq;
+        if (node->state == FLEET_NODE_READY) node->state = FLEET_NODE_RUNNING;
+        f->version++;
+        g_mutex_unlock(&app->history_mutex);
+        break;
+    }
+    case FLEET_MSG_SUMMARY: {
+        if (len < 20) break;
+        unsigned long long iters = get_u64(p);
+        double seconds = get_u32(p + 8) / 1e3;
+        unsigned errors = get_u32(p + 12);
+        int rc = (int)get_u32(p + 16);
+        g_mutex_lock(&app->history_mutex);
+        node->total_iters = iters;
+        node->seconds = seconds;
+        node->summary_errors = errors;
+        node->exit_code = rc;
+        node->state = FLEET_NODE_DONE;
+        f->version++;
+        g_mutex_unlock(&app->history_mutex);
+        gui_log(app, "[FLEET] %s: %llu iterações em %.1f s, %u erro(s)\n", node->name, iters, seconds, errors);
+        if (errors > 0) atomic_fetch_add(&app->errors, (int)errors);
+        fleet_socket_close(node->sock);
+        node->sock = FLEET_BAD_SOCKET;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Lê os bytes disponíveis de um nó e trata cada quadro completo.
+ */
+static void node_receive(AppContext *app, fleet_t *f, fleet_node_t *node){
+    int n = (int)recv(node->sock, (char*)node->rx + node->rx_len, (int)(sizeof(node->rx) - node->rx_len), 0);
+    if (n == 0) {
+        node_fail(app, f, node, "conexão encerrada antes do resumo");
+        return;
+    }
+    if (n < 0) {
+        int e = SOCK_ERRNO();
+        if (SOCK_WOULD_BLOCK(e) || e == EINTR) return;
+        char err[128];
+        sock_error_text(e, err, sizeof(err));
+        node_fail(app, f, node, "conexão perdida (%s)", err);
+        return;
+    }
+    node->rx_len += (size_t)n;
+    node->rx_bytes += (unsigned long long)n;
+    size_t off = 0;
+    while (node->sock != FLEET_BAD_SOCKET) {
+        int type;
+        size_t len;
+        long total = fleet_frame_parse(node->rx + off, node->rx_len - off, &type, &len);
+        if (total < 0) {
+            node_fail(app, f, node, "quadro inválido recebido");
+            return;
+        }
+        if (total == 0) break;
+        handle_frame(app, f, node, type, node->rx + off + FLEET_HEADER_BYTES, len);
+        off += (size_t)total;
+    }
+    if (node->sock == FLEET_BAD_SOCKET) return;
+    memmove(node->rx, node->rx + off, node->rx_len - off);
+    node->rx_len -= off;
+}
+
+/**
+ * @brief Registra o resumo da frota: nós concluídos e falhos, iterações e tráfego médio por nó.
+ */
+static void report_fleet_summary(AppContext *app, fleet_t *f){
+    int done = 0, failed = 0;
+    unsigned long long iters = 0, bytes = 0;
+    double seconds = 0.0;
+    g_mutex_lock(&app->history_mutex);
+    for (int i = 0; i < f->n; i++) {
+        const fleet_node_t *node = &f->nodes[i];
+        if (node->state == FLEET_NODE_DONE) {
+            done++;
+            iters += node->total_iters;
+            bytes += node->rx_bytes;
+            seconds += node->seconds;
+        } else if (node->state == FLEET_NODE_FAILED) {
+            failed++;
+        }
+    }
+    g_mutex_unlock(&app->history_mutex);
+    gui_log(app, "[FLEET] Resumo: %d de %d nó(s) concluíram, %d falharam; %llu iterações no total\n",
+            done, f->n, failed, iters);
+    if (done > 0 && seconds > 0.0) {
+        gui_log(app, "[FLEET] Tráfego médio de %.0f B/s por nó\n", (double)bytes / seconds);
+    }
+}
+
+thread_return_t THREAD_CALL fleet_coordinator_thread_func(void *arg){
+    AppContext *app = (AppContext*)arg;
+    fleet_t *f = app->fleet;
+    atomic_store(&app->running, 1);
+    atomic_store(&app->errors, 0);
+    if (!f || f->n <= 0 || f->args_len == 0) {
+        gui_log(app, "[FLEET] Nenhum nó ou configuração para a frota.\n");
+        atomic_fetch_add(&app->errors, 1);
+        goto done;
+    }
+    if (net_init() != 0) {
+        gui_log(app, "[FLEET] Falha ao iniciar a pilha de rede.\n");
+        atomic_fetch_add(&app->errors, 1);
+        goto done;
+    }
+
+    connect_nodes(app, f);
+
+    // A largada é um instante em tempo Unix; cada agente o converte para o seu relógio monotônico.
+    unsigned char cfg[FLEET_MAX_PAYLOAD];
+    double start_wall = wall_now() + f->lead_sec;
+    put_u64(cfg, (uint64_t)(start_wall * 1e3));
+    put_u64(cfg + 8, (uint64_t)(wall_now() * 1e3));
+    size_t token_len = strnlen(f->token, sizeof(f->token) - 1) + 1;
+    memcpy(cfg + 16, f->token, token_len - 1);
+    cfg[16 + token_len - 1] = '\0';
+    memcpy(cfg + 16 + token_len, f->args, f->args_len);
+    size_t cfg_len = 16 + token_len + f->args_len;
+    g_mutex_lock(&app->history_mutex);
+    f->start_wall = start_wall;
+    f->version++;
+    g_mutex_unlock(&app->history_mutex);
+    int connected = 0;
+    for (int i = 0; i < f->n; i++) {
+        fleet_node_t *node = &f->nodes[i];
+        if (node->sock == FLEET_BAD_SOCKET) continue;
+        if (send_frame(node->sock, FLEET_MSG_CONFIG, cfg, cfg_len) != 0) {
+            node_fail(app, f, node, "falha ao enviar a configuração");
+            continue;
+        }
+        connected++;
+    }
+    gui_log(app, "[FLEET] %d de %d nó(s) conectado(s); largada em %.1f s\n", connected, f->n, f->lead_sec);
+
+    // Prazos: a resposta à configuração vem antes da largada; o resumo, até pouco depois do fim ou da parada.
+    const double t0 = now_sec();
+    const double ready_deadline = t0 + f->lead_sec + FLEET_STOP_GRACE_SEC;
+    const double end_deadline = app->duration_sec > 0 ? t0 + f->lead_sec + app->duration_sec + FLEET_STOP_GRACE_SEC : 0.0;
+    double stop_deadline = 0.0;
+    unsigned long long drawn_version = 0;
+    for (;;) {
+        double now = now_sec();
+        if (!atomic_load(&app->running) && stop_deadline == 0.0) {
+            int stopped = 0;
+            for (int i = 0; i < f->n; i++) {
+                fleet_node_t *node = &f->nodes[i];
+                if (node->sock == FLEET_BAD_SOCKET) continue;
+                if (send_frame(node->sock, FLEET_MSG_STOP, NULL, 0) != 0) node_fail(app, f, node, "falha ao enviar a parada");
+                else stopped++;
+            }
+            gui_log(app, "[FLEET] Parada enviada a %d nó(s)\n", stopped);
+            stop_deadline = now + FLEET_STOP_GRACE_SEC;
+        }
+
+        // poll, e não select: com até FLEET_MAX_NODES sockets dentro da GUI, os descritores podem passar de FD_SETSIZE.
+        sock_pollfd_t pfd[FLEET_MAX_NODES];
+        int pfd_node[FLEET_MAX_NODES];
+        int active = 0;
+        for (int i = 0; i < f->n; i++) {
+            fleet_node_t *node = &f->nodes[i];
+            if (node->sock == FLEET_BAD_SOCKET) continue;
+            if (node->state == FLEET_NODE_CONNECTING && now > ready_deadline) {
+                node_fail(app, f, node, "sem resposta à configuração");
+                continue;
+            }
+            if ((end_deadline > 0.0 && now > end_deadline) || (stop_deadline > 0.0 && now > stop_deadline)) {
+                node_fail(app, f, node, "sem resumo no prazo");
+                continue;
+            }
+            pfd[active] = (sock_pollfd_t){ .fd = node->sock, .events = POLLIN };
+            pfd_node[active] = i;
+            active++;
+        }
+        if (active == 0) break;
+
+        int r = sock_poll(pfd, active, 200);
+        if (r < 0 && SOCK_ERRNO() != EINTR) {
+            gui_log(app, "[FLEET] Falha ao aguardar os nós.\n");
+            atomic_fetch_add(&app->errors, 1);
+            break;
+        }
+        for (int k = 0; r > 0 && k < active; k++) {
+            fleet_node_t *node = &f->nodes[pfd_node[k]];
+            if (node->sock != FLEET_BAD_SOCKET && pfd[k].revents) node_receive(app, f, node);
+        }
+
+        g_mutex_lock(&app->history_mutex);
+        unsigned long long version = f->version;
+        g_mutex_unlock(&app->history_mutex);
+        if (version != drawn_version && !app->headless) {
+            g_idle_add((GSourceFunc)gtk_widget_queue_draw, app->iters_drawing);
+        }
+        drawn_version = version;
+    }
+
+    for (int i = 0; i < f->n; i++) {
+        fleet_socket_close(f->nodes[i].sock);
+        f->nodes[i].sock = FLEET_BAD_SOCKET;
+    }
+    report_fleet_summary(app, f);
+    net_cleanup();
+
+done:
+    atomic_store(&app->running, 0);
+    // Sinaliza para a UI que o teste terminou
+    if (!app->headless) g_idle_add((GSourceFunc)gui_update_stopped, app);
+    return 0;
+}
+
+void fleet_format_status(AppContext *app, char *buf, size_t len){
+    if (!buf || len == 0) return;
+    buf[0] = '\0';
+    if (!app->fleet) return;
+    int running = 0, failed = 0, n = app->fleet->n;
+    double iters = 0.0, temp = TEMP_UNAVAILABLE;
+    g_mutex_lock(&app->history_mutex);
+    for (int i = 0; i < n; i++) {
+        const fleet_node_t *node = &app->fleet->nodes[i];
+        if (node->state == FLEET_NODE_FAILED) failed++;
+        if (node->state != FLEET_NODE_RUNNING) continue;
+        running++;
+        iters += node->last.rate[THREAD_METRIC_PROGRESS];
+        if (node->last.temp_c > temp) temp = node->last.temp_c;
+    }
+    g_mutex_unlock(&app->history_mutex);
+    size_t k = (size_t)snprintf(buf, len, "Frota: %d/%d nó(s) em execução | %.0f iters/s", running, n, iters);
+    if (temp > TEMP_UNAVAILABLE && k < len) k += snprintf(buf + k, len - k, " | Temp máx. %.1f°C", temp);
+    if (failed > 0 && k < len) snprintf(buf + k, len - k, " | %d nó(s) com falha", failed);
+}
+
+/* --- Agente --- */
+
+fleet_socket_t fleet_listen(const char *addr, int port, int *bound_port, char *err, size_t err_len){
+    char port_str[16];
+    snprintf(port_str, sizeof(port_str), "%d", port);
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    int gai = getaddrinfo(addr && addr[0] ? addr : NULL, port_str, &hints, &res);
+    if (gai != 0) {
+        snprintf(err, err_len, "endereço de escuta inválido (%s)", gai_strerror(gai));
+        return FLEET_BAD_SOCKET;
+    }
+    fleet_socket_t s = FLEET_BAD_SOCKET;
+    int e = 0;
+    for (struct addrinfo *ai = res; ai; ai = ai->ai_next) {
+        s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s == FLEET_BAD_SOCKET) {
+            e = SOCK_ERRNO();
+            continue;
+        }
+        int one = 1;
+        setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&one, sizeof(one));
+        if (bind(s, ai->ai_addr, (sock_len_t)ai->ai_addrlen) == 0 && listen(s, 4) == 0) break;
+        e = SOCK_ERRNO();
+        fleet_socket_close(s);
+        s = FLEET_BAD_SOCKET;
+    }
+    freeaddrinfo(res);
+    if (s == FLEET_BAD_SOCKET) {
+        char why[128];
+        sock_error_text(e, why, sizeof(why));
+        snprintf(err, err_len, "falha ao escutar na porta %d (%s)", port, why);
+        return FLEET_BAD_SOCKET;
+    }
+    if (bound_port) {
+        struct sockaddr_storage ss;
+        sock_len_t ss_len = sizeof(ss);
+        *bound_port = port;
+        if (getsockname(s, (struct sockaddr*)&ss, &ss_len) == 0) {
+            if (ss.ss_family == AF_INET) *bound_port = ntohs(((struct sockaddr_in*)&ss)->sin_port);
+            else if (ss.ss_family == AF_INET6) *bound_port = ntohs(((struct sockaddr_in6*)&ss)->sin6_port);
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief Envia um quadro de erro ao coordenador; a sessão termina em seguida.
+ */
+static void agent_send_error(fleet_socket_t s, const char *msg){
+    send_frame(s, FLEET_MSG_ERROR, msg, strlen(msg));
+    printf("[FLEET] Sessão recusada: %s\n", msg);
+    fflush(stdout);
+}
+
+/**
+ * @brief Verifica se o socket de escuta está preso a um endereço de loopback.
+ */
+static int sock_is_loopback(fleet_socket_t s){
+    struct sockaddr_storage ss;
+    sock_len_t ss_len = sizeof(ss);
+    if (getsockname(s, (struct sockaddr*)&ss, &ss_len) != 0) return 0;
+    if (ss.ss_family == AF_INET) {
+        return (ntohl(((struct sockaddr_in*)&ss)->sin_addr.s_addr) >> 24) == 127;
+    }
+    if (ss.ss_family == AF_INET6) {
+        const struct in6_addr *a = &((struct sockaddr_in6*)&ss)->sin6_addr;
+        return IN6_IS_ADDR_LOOPBACK(a) || (IN6_IS_ADDR_V4MAPPED(a) && a->s6_addr[12] == 127);
+    }
+    return 0;
+}
+
+/**
+ * @brief Compara dois tokens sem parar na primeira diferença (o tempo não revela o prefixo correto).
+ */
+static int token_equal(const char *a, const char *b){
+    size_t la = strlen(a), lb = strlen(b);
+    unsigned char diff = la != lb;
+    for (size_t i = 0; i < la && i < lb; i++) diff |= (unsigned char)(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+/**
+ * @brief Verifica se o alvo de `--io` fica em `dir` ou abaixo dele.
+ *
+ * Um alvo existente é resolvido inteiro (com os links simbólicos, no POSIX);
+ * um alvo novo, pelo diretório que o contém, e o nome final não pode ser "."
+ * nem "..".
+ */
+static int io_target_allowed(const char *dir, const char *target){
+    char *root = resolve_path(dir);
+    char *real = resolve_path(target);
+    if (!real) {
+        size_t n = strlen(target);
+        char *parent = malloc(n + 2);
+        if (parent) {
+            memcpy(parent, target, n + 1);
+            char *base = parent + n;
+            while (base > parent && !path_is_sep(base[-1])) base--;
+            if (base[0] != '\0' && strcmp(base, ".") != 0 && strcmp(base, "..") != 0) {
+                if (base == parent) strcpy(parent, ".");
+                else if (base - 1 == parent) *base = '\0'; // "/alvo": o diretório é a raiz.
+                else base[-1] = '\0';
+                real = resolve_path(parent);
+            }
+            free(parent);
+        }
+    }
+    int ok = 0;
+    if (root && real) {
+        size_t rl = strlen(root);
+        while (rl > 0 && path_is_sep(root[rl - 1])) rl--;
+        ok = path_ncmp(real, root, rl) == 0 && (real[rl] == '\0' || path_is_sep(real[rl]));
+    }
+    free(root);
+    free(real);
+    return ok;
+}
+
+/**
+ * @brief Confere os argumentos recebidos contra as opções que `fleet_config_args` gera.
+ *
+ * Qualquer outra opção (como `--export` ou `--io-destructive`) é recusada, e
+ * `--io` só é aceito com um alvo dentro de `policy->io_dir`.
+ *
+ * @return 0 se os argumentos são aceitos, -1 com o motivo em `why`.
+ */
+static int agent_check_args(int argc, char **argv, const fleet_agent_policy_t *policy, char *why, size_t why_len){
+    static const struct { const char *name; int has_value; } allowed[] = {
+        { "-t", 1 }, { "-m", 1 }, { "-d", 1 }, { "--interval", 1 }, { "-k", 1 }, { "--no-pin", 0 },
+        { "--cpus", 1 }, { "--affinity", 1 }, { "--numa", 1 }, { "--pages", 1 }, { "--ptr-chains", 1 },
+        { "--fp-block", 1 }, { "--stream-nt", 0 }, { "--stream-prefetch", 1 }, { "--perf", 0 },
+        { "--degrade-baseline", 1 }, { "--degrade-pct", 1 }, { "--profile", 1 }, { "--roles", 1 },
+        { "--io", 1 }, { "--io-size", 1 }, { "--io-qd", 1 }, { "--io-bs", 1 }, { "--io-read", 1 },
+        { "--jitter-us", 1 }, { "--verify", 0 },
+    };
+    for (int i = 1; i < argc; i++) {
+        size_t k = 0;
+        while (k < sizeof(allowed) / sizeof(allowed[0]) && strcmp(argv[i], allowed[k].name) != 0) k++;
+        if (k == sizeof(allowed) / sizeof(allowed[0])) {
+            snprintf(why, why_len, "Opção não permitida pela frota: %.100s", argv[i]);
+            return -1;
+        }
+        if (!allowed[k].has_value) continue;
+        if (i + 1 >= argc) {
+            snprintf(why, why_len, "Falta o valor de %s", argv[i]);
+            return -1;
+        }
+        if (strcmp(argv[i], "--io") == 0) {
+            if (!policy || !policy->io_dir || !policy->io_dir[0]) {
+                snprintf(why, why_len, "O agente não libera --io (inicie-o com --io-dir)");
+                return -1;
+            }
+            if (!io_target_allowed(policy->io_dir, argv[i + 1])) {
+                snprintf(why, why_len, "Alvo de --io fora do diretório liberado no agente: %.80s", argv[i + 1]);
+                return -1;
+            }
+        }
+        i++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Lê o que o coordenador enviou durante o teste.
+ * @return 1 se o teste deve parar (parada pedida ou conexão perdida), 0 caso contrário.
+ */
+static int agent_poll(AppContext *app, agent_session_t *s){
+    while (wait_socket(s->sock, 0, 0.0) == 1) {
+        int n = (int)recv(s->sock, (char*)s->rx + s->rx_len, (int)(sizeof(s->rx) - s->rx_len), 0);
+        if (n < 0 && SOCK_WOULD_BLOCK(SOCK_ERRNO())) break;
+        if (n <= 0) {
+            gui_log(app, "[FLEET] Conexão com o coordenador perdida. Parando...\n");
+            s->lost = 1;
+            return 1;
+        }
+        s->rx_len += (size_t)n;
+        int type;
+        size_t len;
+        long total;
+        while ((total = fleet_frame_parse(s->rx, s->rx_len, &type, &len)) > 0) {
+            if (type == FLEET_MSG_STOP) {
+                gui_log(app, "[FLEET] Parada pedida pelo coordenador.\n");
+                return 1;
+            }
+            memmove(s->rx, s->rx + total, s->rx_len - (size_t)total);
+            s->rx_len -= (size_t)total;
+        }
+        if (total < 0) {
+            gui_log(app, "[FLEET] Quadro inválido do coordenador. Parando...\n");
+            s->lost = 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Monta a amostra mais recente do amostrador, se houver uma nova desde a última enviada.
+ * @return 1 se `out` foi preenchida, 0 se não há amostra nova.
+ */
+static int agent_collect(AppContext *app, agent_session_t *s, fleet_sample_t *out){
+    g_mutex_lock(&app->history_mutex);
+    unsigned long long seq = app->history_seq;
+    if (seq == s->last_seq) {
+        g_mutex_unlock(&app->history_mutex);
+        return 0;
+    }
+    out->seq = seq;
+    out->rate[THREAD_METRIC_PROGRESS] = app->iters_per_sec;
+    out->rate[THREAD_METRIC_FLOPS] = app->gflops;
+    out->rate[THREAD_METRIC_INT_OPS] = app->int_gops;
+    out->rate[THREAD_METRIC_STREAM_BYTES] = app->stream_gbps;
+    out->rate[THREAD_METRIC_PTR_LOADS] = app->ptr_mloads;
+    out->rate[THREAD_METRIC_ATOMIC_OPS] = app->atomic_mops;
+    g_mutex_unlock(&app->history_mutex);
+    s->last_seq = seq;
+
+    g_mutex_lock(&app->temp_mutex);
+    out->temp_c = app->temp_celsius;
+    g_mutex_unlock(&app->temp_mutex);
+
+    double usage = 0.0, freq_sum = 0.0;
+    int freq_known = 0;
+    g_mutex_lock(&app->cpu_mutex);
+    for (int c = 0; app->cpu_usage && c < app->cpu_count; c++) usage += app->cpu_usage[c];
+    for (int c = 0; app->cpu_freq_mhz && c < app->cpu_count; c++) {
+        if (app->cpu_freq_mhz[c] > 0.0) { freq_sum += app->cpu_freq_mhz[c]; freq_known++; }
+    }
+    int cpus = app->cpu_count;
+    g_mutex_unlock(&app->cpu_mutex);
+    out->cpu_usage = cpus > 0 ? usage / cpus : 0.0;
+    out->freq_mhz = freq_known > 0 ? freq_sum / freq_known : 0.0;
+    out->errors = (unsigned)atomic_load(&app->errors);
+    out->elapsed = s->started_at > 0.0 ? now_sec() - s->started_at : 0.0;
+    return 1;
+}
+
+/**
+ * @brief Passo de `headless_run` no agente: atende a parada, anuncia a largada e envia as amostras novas.
+ */
+static int agent_tick(AppContext *app, void *ctx){
+    agent_session_t *s = (agent_session_t*)ctx;
+    s->last_tick = now_sec();
+    if (agent_poll(app, s) != 0) return 1;
+
+    if (s->started_at == 0.0 && atomic_load(&app->workers_go)) {
+        s->started_at = now_sec();
+        unsigned char p[4];
+        put_u32(p, (uint32_t)(int32_t)lround((app->start_time - app->start_at) * 1e3));
+        if (send_frame(s->sock, FLEET_MSG_STARTED, p, sizeof(p)) != 0) {
+            gui_log(app, "[FLEET] Falha ao enviar ao coordenador. Parando...\n");
+            s->lost = 1;
+            return 1;
+        }
+    }
+
+    fleet_sample_t sample;
+    if (s->started_at > 0.0 && agent_collect(app, s, &sample)) {
+        unsigned char p[FLEET_SAMPLE_PAYLOAD];
+        fleet_sample_encode(&sample, p);
+        if (send_frame(s->sock, FLEET_MSG_SAMPLE, p, sizeof(p)) != 0) {
+            gui_log(app, "[FLEET] Falha ao enviar ao coordenador. Parando...\n");
+            s->lost = 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int fleet_agent_serve(fleet_socket_t listener, double timeout_sec, const fleet_agent_policy_t *policy){
+    if (wait_socket(listener, 0, timeout_sec) != 1) return -1;
+    struct sockaddr_storage peer;
+    sock_len_t peer_len = sizeof(peer);
+    fleet_socket_t sock = accept(listener, (struct sockaddr*)&peer, &peer_len);
+    if (sock == FLEET_BAD_SOCKET) return -1;
+    char peer_name[NI_MAXHOST] = "?";
+    getnameinfo((struct sockaddr*)&peer, peer_len, peer_name, sizeof(peer_name), NULL, 0, NI_NUMERICHOST);
+    // Sem bloqueio, como no coordenador: um coordenador que para de ler esgota o prazo de send_all
+    // e derruba a sessão, em vez de prender o amostrador do agente em send().
+    if (set_nonblocking(sock, 1) != 0) {
+        fleet_socket_close(sock);
+        return -1;
+    }
+    set_nodelay(sock);
+
+    unsigned char frame[FLEET_HEADER_BYTES + FLEET_MAX_PAYLOAD];
+    const unsigned char *p = frame + FLEET_HEADER_BYTES;
+    int type;
+    size_t len;
+    if (recv_frame(sock, frame, FLEET_CONFIG_TIMEOUT_SEC, &type, &len) != 0 || type != FLEET_MSG_CONFIG ||
+        len <= 16 || p[len - 1] != '\0') {
+        printf("[FLEET] Conexão de %s sem uma configuração válida.\n", peer_name);
+        fflush(stdout);
+        fleet_socket_close(sock);
+        return -1;
+    }
+    double start_wall = get_u64(p) / 1e3;
+    double offset_ms = (wall_now() - get_u64(p + 8) / 1e3) * 1e3;
+    const char *token = (const char*)p + 16;
+    if (policy && policy->token && policy->token[0] && !token_equal(token, policy->token)) {
+        agent_send_error(sock, "Token da frota inválido");
+        fleet_socket_close(sock);
+        return 1;
+    }
+
+    char *argv[FLEET_MAX_ARGS + 1];
+    int argc = 0;
+    argv[argc++] = "HardStress";
+    for (size_t off = 16 + strlen(token) + 1; off < len && argc < FLEET_MAX_ARGS; off += strlen((const char*)p + off) + 1) {
+        argv[argc++] = (char*)p + off;
+    }
+    argv[argc] = NULL;
+    char why[160];
+    if (agent_check_args(argc, argv, policy, why, sizeof(why)) != 0) {
+        agent_send_error(sock, why);
+        fleet_socket_close(sock);
+        return 1;
+    }
+
+    AppContext *app = app_context_create();
+    if (!app) {
+        agent_send_error(sock, "Falta de memória no agente");
+        fleet_socket_close(sock);
+        return 1;
+    }
+    app->headless = 1;
+    int rc = headless_parse_args(app, argc, argv);
+    const char *refusal = NULL;
+    if (rc != 0) refusal = "Configuração recusada pelo agente (detalhes na saída do agente)";
+    else if (app->sweep_max_mib > 0 || app->c2c_en) refusal = "A frota executa apenas o teste de estresse, sem --sweep nem --c2c";
+    else if (start_wall - wall_now() > FLEET_MAX_LEAD_SEC) refusal = "Largada combinada longe demais no futuro";
+    if (refusal) {
+        agent_send_error(sock, refusal);
+        fleet_socket_close(sock);
+        app_context_free(app);
+        return 1;
+    }
+    // O instante combinado passa para o relógio monotônico local; se já passou, a largada é imediata.
+    double start_at = now_sec() + (start_wall - wall_now());
+    app->start_at = start_at > 0.0 ? start_at : now_sec();
+
+    unsigned char ready[12 + 64];
+    char host[64] = "";
+    gethostname(host, sizeof(host) - 1);
+    size_t host_len = strlen(host);
+    put_u32(ready, (uint32_t)app->threads);
+    put_u32(ready + 4, (uint32_t)detect_cpu_count());
+    put_u32(ready + 8, (uint32_t)(int32_t)lround(offset_ms));
+    memcpy(ready + 12, host, host_len);
+    if (send_frame(sock, FLEET_MSG_READY, ready, 12 + host_len) != 0) {
+        fleet_socket_close(sock);
+        app_context_free(app);
+        return -1;
+    }
+    gui_log(app, "[FLEET] Teste pedido por %s; largada em %.1f s (relógio %+.0f ms em relação ao coordenador)\n",
+            peer_name, app->start_at - now_sec(), offset_ms);
+
+    agent_session_t *s = calloc(1, sizeof(*s));
+    if (!s) {
+        agent_send_error(sock, "Falta de memória no agente");
+        fleet_socket_close(sock);
+        app_context_free(app);
+        return 1;
+    }
+    s->sock = sock;
+    rc = headless_run(app, agent_tick, s);
+    if (rc == 1) {
+        agent_send_error(sock, "Memória insuficiente no agente para a configuração pedida");
+    } else if (!s->lost) {
+        unsigned char sum[20];
+        put_u64(sum, atomic_load(&app->total_iters));
+        double ms = s->started_at > 0.0 ? (s->last_tick - s->started_at) * 1e3 : 0.0;
+        put_u32(sum + 8, (uint32_t)ms);
+        put_u32(sum + 12, (uint32_t)atomic_load(&app->errors));
+        put_u32(sum + 16, (uint32_t)rc);
+        send_frame(sock, FLEET_MSG_SUMMARY, sum, sizeof(sum));
+    }
+    fleet_socket_close(sock);
+    free(s);
+    app_context_free(app);
+    return rc;
+}
+
+int fleet_agent_requested(int argc, char **argv){
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--agent") == 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Interpreta "[ENDEREÇO:]PORTA" (ou "[ipv6]:PORTA") de `--agent`; só com a porta, `addr` fica como está.
+ * @return 0 em caso de sucesso, -1 se for inválido.
+ */
+static int parse_listen_spec(const char *spec, char *addr, size_t addr_len, int *port){
+    char host[256], err[128];
+    const char *p = spec;
+    // Só a porta: um número sem ':'.
+    char *end;
+    long v = strtol(spec, &end, 10);
+    if (*spec != '\0' && *end == '\0') {
+        if (v < 1 || v > 65535) return -1;
+        *port = (int)v;
+        return 0;
+    }
+    if (next_node(&p, host, sizeof(host), port, err, sizeof(err)) != 1 || *p != '\0' || strlen(host) >= addr_len) return -1;
+    snprintf(addr, addr_len, "%s", host);
+    return 0;
+}
+
+int fleet_agent_main(int argc, char **argv){
+#ifdef _WIN32
+    // O binário é ligado com -mwindows; reanexa ao console do processo pai para que o stdout apareça.
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        freopen("CONOUT$", "w", stdout);
+        freopen("CONOUT$", "w", stderr);
+    }
+#endif
+    // Sem endereço, só o loopback; escutar na rede é uma escolha explícita e exige o token.
+    char addr[256] = "127.0.0.1";
+    int port = FLEET_DEFAULT_PORT;
+    fleet_agent_policy_t policy = { getenv(FLEET_TOKEN_ENV), NULL };
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--agent") == 0) {
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                if (parse_listen_spec(argv[i + 1], addr, sizeof(addr), &port) != 0) {
+                    fprintf(stderr, "Endereço de escuta inválido para --agent: %s\n", argv[i + 1]);
+                    return 1;
+                }
+                i++;
+            }
+        } else if (strcmp(argv[i], "--io-dir") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Falta o diretório de --io-dir.\n");
+                return 1;
+            }
+            policy.io_dir = argv[++i];
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            printf("Uso: %s --agent [ENDEREÇO:]PORTA [--io-dir DIR]\n"
+                   "  Escuta na porta TCP (padrão %d) e executa os testes enviados por um coordenador\n"
+                   "  (a GUI, com a lista de nós preenchida), transmitindo as amostras a ele.\n"
+                   "  Sem ENDEREÇO, escuta só no loopback (127.0.0.1). Fora do loopback, o agente exige\n"
+                   "  o token em %s, que o coordenador envia a partir da mesma variável.\n"
+                   "  --io-dir DIR  Aceita alvos de --io dentro de DIR (sem ela, --io é recusado).\n"
+                   "  --export e --io-destructive nunca são aceitos de um coordenador.\n",
+                   argv[0], FLEET_DEFAULT_PORT, FLEET_TOKEN_ENV);
+            return 0;
+        } else if (strcmp(argv[i], "--headless") != 0) {
+            fprintf(stderr, "Opção desconhecida no modo agente: %s (a configuração vem do coordenador)\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (net_init() != 0) {
+        fprintf(stderr, "ERRO: Falha ao iniciar a pilha de rede.\n");
+        return 1;
+    }
+    if (policy.token && strlen(policy.token) >= FLEET_TOKEN_MAX) {
+        fprintf(stderr, "ERRO: token em %s longo demais (máximo de %d bytes).\n", FLEET_TOKEN_ENV, FLEET_TOKEN_MAX - 1);
+        net_cleanup();
+        return 1;
+    }
+    char err[256];
+    int bound = port;
+    fleet_socket_t listener = fleet_listen(addr, port, &bound, err, sizeof(err));
+    if (listener == FLEET_BAD_SOCKET) {
+        fprintf(stderr, "ERRO: %s.\n", err);
+        net_cleanup();
+        return 1;
+    }
+    if ((!policy.token || !policy.token[0]) && !sock_is_loopback(listener)) {
+        fprintf(stderr, "ERRO: escutar em %s, fora do loopback, exige um token em %s.\n", addr, FLEET_TOKEN_ENV);
+        fleet_socket_close(listener);
+        net_cleanup();
+        return 1;
+    }
+    headless_install_signals();
+    printf("[FLEET] Agente escutando em %s:%d%s\n", addr, bound, policy.token && policy.token[0] ? " (com token)" : "");
+    if (policy.io_dir) printf("[FLEET] Alvos de --io liberados em %s\n", policy.io_dir);
+    fflush(stdout);
+    while (!headless_stop_requested()) fleet_agent_serve(listener, 1.0, &policy);
+    fleet_socket_close(listener);
+    net_cleanup();
+    printf("[FLEET] Agente encerrado.\n");
+    return 0;
+}
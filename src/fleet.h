@@ -0,0 +1,265 @@
+#ifndef FLEET_H
+#define FLEET_H
+
+/**
+ * @file fleet.h
+ * @brief Declara o modo frota: agentes que executam o teste headless e um coordenador que os sincroniza.
+ *
+ * Um agente (`--agent [ENDEREÇO:]PORTA`) escuta em uma porta TCP e atende um
+ * coordenador por vez. O coordenador (a GUI, com uma lista de nós) envia a cada
+ * agente a configuração como argumentos de `--headless` e um instante de
+ * largada em tempo Unix; o agente prepara os buffers, segura a largada até o
+ * instante (`AppContext::start_at`) e, a cada amostra do amostrador, devolve um
+ * quadro binário com as taxas de cada kernel, a temperatura, o uso e o clock
+ * médios e os erros. No fim, um quadro de resumo traz os totais. Os relógios
+ * dos nós devem estar sincronizados (NTP/PTP); cada agente informa a sua
+ * diferença para o relógio do coordenador.
+ *
+ * O agente escuta no loopback salvo pedido explícito, e fora dele exige um
+ * token compartilhado (`FLEET_TOKEN_ENV`), enviado pelo coordenador na
+ * configuração. Os argumentos recebidos são conferidos contra as opções que
+ * `fleet_config_args` gera: `--export`, `--io-destructive` e alvos de `--io`
+ * fora do diretório liberado no agente (`--io-dir`) são recusados.
+ *
+ * Cada quadro tem um cabeçalho de `FLEET_HEADER_BYTES` bytes ("HS", versão,
+ * tipo e o tamanho da carga em 32 bits) seguido da carga, com inteiros em
+ * little-endian. Um quadro de amostra tem `FLEET_SAMPLE_PAYLOAD` bytes de
+ * carga, de modo que um agente envia algumas dezenas de bytes por segundo.
+ */
+
+#include "hardstress.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+typedef SOCKET fleet_socket_t;          ///< Socket do agente ou do coordenador (Windows).
+#define FLEET_BAD_SOCKET INVALID_SOCKET ///< Socket inválido (Windows).
+#else
+typedef int fleet_socket_t;             ///< Socket do agente ou do coordenador (POSIX).
+#define FLEET_BAD_SOCKET (-1)           ///< Socket inválido (POSIX).
+#endif
+
+/** @brief Porta TCP padrão do agente. */
+#define FLEET_DEFAULT_PORT 7878
+/** @brief Máximo de nós de um coordenador. */
+#define FLEET_MAX_NODES 256
+/** @brief Antecedência da largada em relação ao envio da configuração, em segundos (cobre a inicialização dos buffers). */
+#define FLEET_DEFAULT_LEAD_SEC 5.0
+/** @brief Prazo para conectar a todos os nós, em segundos. */
+#define FLEET_CONNECT_TIMEOUT_SEC 5.0
+/** @brief Espera pelos resumos depois da parada ou do fim da duração, em segundos. */
+#define FLEET_STOP_GRACE_SEC 15.0
+/** @brief Versão do protocolo, conferida em cada quadro. */
+#define FLEET_PROTOCOL_VERSION 2
+/** @brief Tamanho do cabeçalho de um quadro, em bytes. */
+#define FLEET_HEADER_BYTES 8
+/** @brief Maior carga aceita em um quadro, em bytes. */
+#define FLEET_MAX_PAYLOAD 4096
+/** @brief Maior token da frota, em bytes, com o NUL. */
+#define FLEET_TOKEN_MAX 128
+/** @brief Variável de ambiente com o token da frota, lida pelo agente e pelo coordenador. */
+#define FLEET_TOKEN_ENV "HARDSTRESS_FLEET_TOKEN"
+/** @brief Carga de um quadro de amostra, em bytes. */
+#define FLEET_SAMPLE_PAYLOAD 42
+/** @brief Métrica do heatmap da frota para a temperatura; as anteriores são as de `thread_metric_t`. */
+#define FLEET_METRIC_TEMP THREAD_METRIC_COUNT
+/** @brief Métricas do heatmap da frota. */
+#define FLEET_METRIC_COUNT (THREAD_METRIC_COUNT + 1)
+
+/**
+ * @enum fleet_msg_t
+ * @brief Tipos de quadro.
+ */
+typedef enum {
+    FLEET_MSG_CONFIG = 1,   ///< Coordenador -> agente: largada (ms Unix), relógio do coordenador, token e os argumentos.
+    FLEET_MSG_STOP,         ///< Coordenador -> agente: parar o teste (sem carga).
+    FLEET_MSG_READY,        ///< Agente -> coordenador: configuração aceita; threads, CPUs, diferença de relógio e nome.
+    FLEET_MSG_ERROR,        ///< Agente -> coordenador: mensagem de erro; a sessão termina.
+    FLEET_MSG_STARTED,      ///< Agente -> coordenador: largada dada, com o atraso em relação ao instante combinado.
+    FLEET_MSG_SAMPLE,       ///< Agente -> coordenador: uma amostra (`fleet_sample_t`).
+    FLEET_MSG_SUMMARY       ///< Agente -> coordenador: totais do teste; a sessão termina.
+} fleet_msg_t;
+
+/**
+ * @struct fleet_sample_t
+ * @brief Uma amostra de um nó, como transmitida (com a precisão do quadro).
+ */
+typedef struct {
+    unsigned long long seq; ///< Número da amostra desde a largada (`history_seq` do agente).
+    double elapsed;         ///< Segundos desde a largada, com resolução de 1 ms.
+    double rate[THREAD_METRIC_COUNT]; ///< Taxa de cada métrica somada sobre os workers (it/s, GFLOP/s, Gops/s, GB/s, Mcargas/s, Mops/s).
+    double temp_c;          ///< Temperatura da CPU em °C, com resolução de 0,1 °C (`TEMP_UNAVAILABLE` se desconhecida).
+    double cpu_usage;       ///< Uso médio das CPUs, de 0 a 1.
+    double freq_mhz;        ///< Clock médio das CPUs, em MHz (0 = indisponível).
+    unsigned errors;        ///< Erros registrados até a amostra.
+} fleet_sample_t;
+
+/**
+ * @enum fleet_node_state_t
+ * @brief Estado de um nó no coordenador.
+ */
+typedef enum {
+    FLEET_NODE_CONNECTING = 0, ///< Conectando ou aguardando a resposta à configuração.
+    FLEET_NODE_READY,       ///< Configuração aceita; aguardando a largada.
+    FLEET_NODE_RUNNING,     ///< Teste em execução.
+    FLEET_NODE_DONE,        ///< Resumo recebido.
+    FLEET_NODE_FAILED       ///< Sem conexão, configuração recusada ou sessão interrompida (ver `error`).
+} fleet_node_state_t;
+
+/**
+ * @struct fleet_node_t
+ * @brief Um nó da frota. Os campos publicados são protegidos por `history_mutex`; `sock` e `rx*` são do coordenador.
+ */
+typedef struct {
+    char host[256];         ///< Endereço ou nome do nó, como informado.
+    int port;               ///< Porta TCP do agente.
+    char name[64];          ///< Nome do nó informado pelo agente (o endereço até lá).
+    int state;              ///< `fleet_node_state_t`.
+    char error[160];        ///< Motivo da falha, quando `FLEET_NODE_FAILED`.
+    int threads;            ///< Workers do agente.
+    int cpus;               ///< CPUs lógicas do agente.
+    double clock_offset_ms; ///< Relógio do agente menos o do coordenador, em ms (sem descontar a latência da rede).
+    double start_late_ms;   ///< Atraso da largada do agente em relação ao instante combinado, em ms.
+    fleet_sample_t last;    ///< Última amostra recebida.
+    fleet_sample_t ring[HISTORY_SAMPLES]; ///< Amostras recentes, na posição `seq % HISTORY_SAMPLES`.
+    unsigned long long samples; ///< Amostras recebidas.
+    unsigned long long total_iters; ///< Iterações do teste inteiro (resumo).
+    double seconds;         ///< Duração do teste no agente (resumo).
+    unsigned summary_errors;///< Erros do teste inteiro (resumo).
+    int exit_code;          ///< Código de saída do teste no agente (resumo).
+
+    /* --- Uso exclusivo do coordenador --- */
+    fleet_socket_t sock;    ///< Conexão com o agente, ou `FLEET_BAD_SOCKET`.
+    unsigned char rx[FLEET_HEADER_BYTES + FLEET_MAX_PAYLOAD]; ///< Bytes recebidos ainda não consumidos.
+    size_t rx_len;          ///< Bytes válidos em `rx`.
+    unsigned long long rx_bytes; ///< Bytes recebidos na sessão.
+} fleet_node_t;
+
+/**
+ * @struct fleet_t
+ * @brief Os nós de um coordenador e a configuração enviada a eles.
+ */
+struct fleet_t {
+    int n;                  ///< Nós.
+    fleet_node_t *nodes;    ///< `n` nós.
+    double lead_sec;        ///< Antecedência da largada, em segundos.
+    char token[FLEET_TOKEN_MAX]; ///< Token enviado aos agentes (de `FLEET_TOKEN_ENV`; vazio = nenhum).
+    char args[FLEET_MAX_PAYLOAD - 16 - FLEET_TOKEN_MAX]; ///< Argumentos de `headless_parse_args`, cada um terminado em NUL.
+    size_t args_len;        ///< Bytes usados em `args`.
+    double start_wall;      ///< Instante combinado da largada, em tempo Unix (s); 0 até o envio.
+    unsigned long long max_seq; ///< Maior número de amostra recebido de qualquer nó.
+    unsigned long long version; ///< Incrementado a cada mudança publicada (para o heatmap).
+};
+
+/**
+ * @brief Cria a frota a partir de uma lista de nós ("host[:porta]", separados por vírgula ou espaço).
+ *
+ * Endereços IPv6 com porta vão entre colchetes ("[::1]:7878"). O token vem de
+ * `FLEET_TOKEN_ENV`, se definida.
+ *
+ * @return A frota, sem conexões, ou NULL com a causa em `err`.
+ */
+fleet_t *fleet_create(const char *list, char *err, size_t err_len);
+
+/**
+ * @brief Libera a frota (depois que o coordenador terminou); NULL é ignorado.
+ */
+void fleet_free(fleet_t *f);
+
+/**
+ * @brief Grava em `buf` a configuração de teste de `app` como argumentos de `headless_parse_args`.
+ *
+ * Cada argumento termina em NUL. `app->threads` é repassado como está (0 = cada
+ * nó usa todas as suas CPUs); o número de workers é decidido no agente.
+ *
+ * @return Os bytes gravados, ou -1 se não couberem em `cap`.
+ */
+int fleet_config_args(const AppContext *app, char *buf, size_t cap);
+
+/**
+ * @brief Grava o cabeçalho de um quadro em `buf` (`FLEET_HEADER_BYTES` bytes).
+ */
+void fleet_frame_header(unsigned char *buf, int type, size_t payload_len);
+
+/**
+ * @brief Verifica se `buf` começa com um quadro completo.
+ * @param type Recebe o tipo do quadro.
+ * @param payload_len Recebe o tamanho da carga.
+ * @return O tamanho total do quadro, 0 se faltam bytes, ou -1 se o cabeçalho for inválido.
+ */
+long fleet_frame_parse(const unsigned char *buf, size_t len, int *type, size_t *payload_len);
+
+/**
+ * @brief Codifica uma amostra em `FLEET_SAMPLE_PAYLOAD` bytes.
+ */
+void fleet_sample_encode(const fleet_sample_t *s, unsigned char *payload);
+
+/**
+ * @brief Decodifica uma carga de `FLEET_SAMPLE_PAYLOAD` bytes.
+ */
+void fleet_sample_decode(const unsigned char *payload, fleet_sample_t *s);
+
+/**
+ * @brief Thread do coordenador: conecta aos nós de `app->fleet`, envia a configuração e recebe as amostras.
+ *
+ * Faz o papel da controladora no modo frota: marca `running`, termina quando
+ * todos os nós entregaram o resumo ou falharam (ou o prazo depois da parada
+ * acaba), soma os erros dos nós em `errors` e sinaliza a UI. Zerar `running`
+ * envia a parada a todos os nós.
+ *
+ * @param arg O `AppContext`, com `fleet` preenchido.
+ */
+thread_return_t THREAD_CALL fleet_coordinator_thread_func(void *arg);
+
+/**
+ * @brief Formata a linha de status da frota: nós em execução, vazão somada, maior temperatura e erros.
+ */
+void fleet_format_status(AppContext *app, char *buf, size_t len);
+
+/**
+ * @brief Abre o socket de escuta do agente.
+ * @param addr Endereço local (NULL ou vazio = todos).
+ * @param bound_port Recebe a porta efetiva (útil com `port` 0), ou NULL.
+ * @return O socket, ou `FLEET_BAD_SOCKET` com a causa em `err`.
+ */
+fleet_socket_t fleet_listen(const char *addr, int port, int *bound_port, char *err, size_t err_len);
+
+/**
+ * @brief Fecha um socket; `FLEET_BAD_SOCKET` é ignorado.
+ */
+void fleet_socket_close(fleet_socket_t s);
+
+/**
+ * @struct fleet_agent_policy_t
+ * @brief O que o agente aceita de um coordenador, definido na linha de comando do agente.
+ */
+typedef struct {
+    const char *token;      ///< Token exigido na configuração (NULL ou vazio = qualquer um, só no loopback).
+    const char *io_dir;     ///< Diretório em que os alvos de `--io` devem ficar (NULL = `--io` recusado).
+} fleet_agent_policy_t;
+
+/**
+ * @brief Atende uma sessão de coordenador no agente: aguarda uma conexão por até `timeout_sec` e executa o teste pedido.
+ *
+ * A configuração é recusada com um quadro de erro se o token não confere com o
+ * de `policy` ou se os argumentos saem do que `fleet_config_args` gera.
+ *
+ * @return O código de saída do teste (como `headless_main`), 1 se a configuração foi recusada, ou -1 se nenhuma sessão foi atendida.
+ */
+int fleet_agent_serve(fleet_socket_t listener, double timeout_sec, const fleet_agent_policy_t *policy);
+
+/**
+ * @brief Verifica se `--agent` foi passado na linha de comando.
+ */
+int fleet_agent_requested(int argc, char **argv);
+
+/**
+ * @brief Ponto de entrada do agente: escuta na porta de `--agent` e atende coordenadores até SIGINT/SIGTERM.
+ *
+ * Sem endereço, escuta só no loopback; um endereço fora do loopback exige o
+ * token em `FLEET_TOKEN_ENV`. `--io-dir DIR` libera alvos de `--io` em DIR.
+ *
+ * @return 0 ao encerrar normalmente, 1 em caso de uso inválido, sem token fora do loopback ou se a porta não puder ser aberta.
+ */
+int fleet_agent_main(int argc, char **argv);
+
+#endif // FLEET_H
@@ -36,11 +36,21 @@ typedef struct { unsigned long long user,nice,system,idle,iowait,irq,softirq,ste
 /* --- CONSTANTES DE CONFIGURAÇÃO --- */
 #define DEFAULT_MEM_MIB 256             ///< Memória padrão a ser alocada por thread de trabalho em MiB.
 #define DEFAULT_DURATION_SEC 300        ///< Duração padrão do teste de estresse em segundos (5 minutos).
-#define CPU_SAMPLE_INTERVAL_MS 1000     ///< Intervalo para amostragem de uso de CPU e temperatura em milissegundos.
-#define HISTORY_SAMPLES 240             ///< Número de pontos de dados históricos a serem armazenados para gráficos de desempenho.
+#define CPU_SAMPLE_INTERVAL_MS 1000     ///< Intervalo padrão para amostragem de uso de CPU e temperatura em milissegundos.
+#define SAMPLE_INTERVAL_MIN_MS 50       ///< Menor intervalo de amostragem aceito, em milissegundos.
+#define SAMPLE_INTERVAL_MAX_MS 10000    ///< Maior intervalo de amostragem aceito, em milissegundos.
+#define DEFAULT_DEGRADE_BASELINE_SEC 60 ///< Janela inicial que define a linha de base da detecção de degradação, em segundos.
+#define DEFAULT_DEGRADE_PCT 10          ///< Queda de vazão, em %, que abre um episódio de degradação.
+#define HISTORY_SAMPLES 240             ///< Amostras em resolução total do histórico por thread (a janela recente do heatmap).
 #define CPU_HISTORY_SAMPLES 60          ///< Número de amostras mantidas para o gráfico de histórico de uso da CPU.
 #define ITER_SCALE 1000.0               ///< Divisor para escalar contagens de iteração para exibição.
 #define TEMP_UNAVAILABLE -274.0         ///< Valor sentinela que indica que os dados de temperatura não estão disponíveis.
+#define CACHE_LINE_SIZE 64              ///< Tamanho de uma linha de cache nas CPUs alvo, em bytes.
+#define WORKER_ALIGN 128                ///< Alinhamento dos blocos de `worker_t` (duas linhas, cobrindo o prefetcher de linha adjacente).
+#define ITER_PROGRESS_SCALE 1000        ///< Resolução de `worker_t::progress`: milésimos de iteração.
+#define STREAM_OPS 4                    ///< Número de operações STREAM (Copy, Scale, Add, Triad).
+#define PTR_MAX_CHAINS 16               ///< Número máximo de cadeias paralelas do kernel de perseguição de ponteiro.
+#define FP_BLOCK_MAX_KIB (64 * 1024)    ///< Maior bloco residente em cache aceito para o motor de ponto flutuante, em KiB.
 
 /* --- TEMA --- */
 /** @struct color_t
@@ -66,6 +76,19 @@ typedef thread_return_t (THREAD_CALL *thread_func_t)(void *); ///< Definição d
 /* --- FORWARD DECLARATIONS --- */
 typedef struct AppContext AppContext;
 typedef struct worker_t worker_t;
+typedef struct cpu_topology_t cpu_topology_t;
+typedef struct fp_engine_t fp_engine_t;
+typedef struct heatmap_t heatmap_t;
+typedef struct history_archive_t history_archive_t;
+typedef struct telemetry_t telemetry_t;
+typedef struct sweep_result_t sweep_result_t;
+typedef struct c2c_result_t c2c_result_t;
+typedef struct io_engine_t io_engine_t;
+typedef struct jitter_t jitter_t;
+typedef struct jitter_result_t jitter_result_t;
+typedef struct fleet_t fleet_t;
+typedef struct verify_pattern_t verify_pattern_t;
+typedef struct verify_edac_t verify_edac_t;
 
 /* --- WORKER --- */
 /**
@@ -77,20 +100,164 @@ typedef enum {
     WORKER_ALLOC_FAIL       ///< O worker falhou em alocar seu buffer de memória.
 } worker_status_t;
 
+/**
+ * @enum numa_mode_t
+ * @brief Política de posicionamento dos buffers dos workers em sistemas NUMA.
+ */
+typedef enum {
+    NUMA_MODE_OFF = 0,      ///< Sem tratamento explícito (apenas first-touch após a fixação, se houver).
+    NUMA_MODE_LOCAL,        ///< Buffers tocados pela própria CPU do worker, no seu nó local.
+    NUMA_MODE_REMOTE        ///< Buffers tocados a partir de uma CPU de outro nó (acesso remoto deliberado).
+} numa_mode_t;
+
+/**
+ * @enum affinity_policy_t
+ * @brief Ordem em que os workers fixados ocupam as CPUs lógicas.
+ */
+typedef enum {
+    AFFINITY_PHYSICAL_FIRST = 0, ///< Um worker por núcleo físico; irmãos SMT só depois que todos os núcleos estão ocupados.
+    AFFINITY_LINEAR,        ///< CPUs lógicas em ordem numérica (worker i na CPU i).
+    AFFINITY_SCATTER,       ///< Núcleos físicos alternando entre sockets e domínios de L3.
+    AFFINITY_COMPACT,       ///< Enche cada núcleo (todos os irmãos SMT), depois o domínio de L3 e o socket.
+    AFFINITY_SMT_PAIRS,     ///< Irmãos SMT juntos, núcleos espalhados entre sockets e domínios de L3.
+    AFFINITY_LIST           ///< Lista explícita de CPUs (`AppContext::affinity_list`).
+} affinity_policy_t;
+
+/**
+ * @enum page_mode_t
+ * @brief Tamanho de página preferido para os buffers dos workers.
+ */
+typedef enum {
+    PAGE_MODE_DEFAULT = 0,  ///< Páginas base do sistema (normalmente 4 KiB).
+    PAGE_MODE_THP,          ///< Transparent Huge Pages via `madvise(MADV_HUGEPAGE)`.
+    PAGE_MODE_HUGE_2M,      ///< Páginas hugetlb explícitas de 2 MiB (páginas grandes no Windows).
+    PAGE_MODE_HUGE_1G       ///< Páginas hugetlb explícitas de 1 GiB.
+} page_mode_t;
+
+/**
+ * @struct mem_region_t
+ * @brief Uma região de memória alocada por `region_alloc`.
+ */
+typedef struct {
+    void *ptr;              ///< Início da região (NULL se não alocada).
+    size_t bytes;           ///< Tamanho solicitado, em bytes.
+    size_t map_bytes;       ///< Tamanho efetivamente reservado (arredondado para o tamanho de página).
+    size_t page_size;       ///< Tamanho de página obtido, em bytes.
+    int mode;               ///< Modo efetivamente obtido (`page_mode_t`).
+    int kind;               ///< Mecanismo de alocação usado, para a liberação (interno).
+} mem_region_t;
+
+/**
+ * @enum kernel_id_t
+ * @brief Os kernels de estresse, na ordem em que um worker os executa.
+ */
+typedef enum {
+    KERNEL_FPU = 0,         ///< Motor de ponto flutuante.
+    KERNEL_INT,             ///< Kernel de inteiros.
+    KERNEL_STREAM,          ///< Kernel STREAM.
+    KERNEL_PTR,             ///< Perseguição de ponteiro.
+    KERNEL_ATOMIC,          ///< Contenção atômica em linhas de cache compartilhadas.
+    KERNEL_COUNT
+} kernel_id_t;
+
+/**
+ * @enum perf_counter_t
+ * @brief Contadores de hardware lidos via `perf_event_open` em cada worker.
+ */
+typedef enum {
+    PERF_CYCLES = 0,        ///< Ciclos de CPU.
+    PERF_INSTRUCTIONS,      ///< Instruções retiradas.
+    PERF_LLC_MISSES,        ///< Falhas de leitura no último nível de cache.
+    PERF_DTLB_MISSES,       ///< Falhas de leitura no TLB de dados.
+    PERF_BRANCH_MISSES,     ///< Desvios mal previstos.
+    PERF_COUNTER_COUNT
+} perf_counter_t;
+
+/**
+ * @enum thread_metric_t
+ * @brief Contadores de cada worker guardados no histórico e exibidos no heatmap.
+ */
+typedef enum {
+    THREAD_METRIC_PROGRESS = 0, ///< Progresso, em milésimos de iteração.
+    THREAD_METRIC_FLOPS,        ///< Operações de ponto flutuante do kernel FPU.
+    THREAD_METRIC_INT_OPS,      ///< Operações de inteiros do kernel INT.
+    THREAD_METRIC_STREAM_BYTES, ///< Bytes movidos pelo kernel STREAM.
+    THREAD_METRIC_PTR_LOADS,    ///< Cargas do kernel PTR (passos de todas as cadeias).
+    THREAD_METRIC_ATOMIC_OPS,   ///< Operações atômicas do kernel ATOMIC.
+    THREAD_METRIC_COUNT
+} thread_metric_t;
+
+/**
+ * @struct thread_sample_t
+ * @brief Instantâneo dos contadores cumulativos de um worker, indexado por `thread_metric_t`.
+ */
+typedef struct {
+    unsigned long long v[THREAD_METRIC_COUNT];
+} thread_sample_t;
+
 /**
  * @struct worker_t
  * @brief Encapsula o estado e os recursos para uma única thread de trabalho de teste de estresse.
+ *
+ * A struct é dividida em dois blocos alinhados a `WORKER_ALIGN`: a configuração,
+ * que é somente leitura depois que a thread inicia, e o estado quente que muda
+ * durante o teste. Como `sizeof(worker_t)` é múltiplo do alinhamento, workers
+ * vizinhos no array `AppContext::workers` nunca compartilham linhas de cache.
  */
 struct worker_t {
-    int tid;                ///< ID da thread (0 a N-1).
+    /* --- Configuração (somente leitura durante o teste) --- */
+    _Alignas(WORKER_ALIGN) int tid; ///< ID da thread (0 a N-1).
     size_t buf_bytes;       ///< Tamanho do buffer de memória a ser alocado, em bytes.
     uint8_t *buf;           ///< Ponteiro para o buffer de memória alocado para padrões de acesso à memória.
     uint32_t *idx;          ///< Array de índices para acesso aleatório à memória.
     size_t idx_len;         ///< Número de elementos no array `idx`.
+    mem_region_t buf_region;///< Região que contém `buf` (tamanho de página obtido, para a liberação).
+    mem_region_t idx_region;///< Região que contém `idx`.
+    double *st_a, *st_b, *st_c; ///< Arrays do kernel STREAM, dentro de `buf` e alinhados a uma linha de cache.
+    size_t st_n;            ///< Elementos em cada array STREAM.
+    uint64_t *vf_base;      ///< Buffer conferido pelo kernel STREAM no modo de verificação (o próprio `buf`, alinhado), ou NULL.
+    size_t vf_n;            ///< Palavras de 64 bits em `vf_base`, múltiplo de `VERIFY_BLOCK_ELEMS`.
+    verify_pattern_t *vf_pat;   ///< Padrões esperado e seguinte da passagem corrente (2 entradas; regravados pela própria thread).
+    size_t ptr_nodes;       ///< Nós (um por linha de cache) no ciclo de perseguição de ponteiro em `idx`.
+    int ptr_chains;         ///< Cadeias independentes percorridas em paralelo pelo kernel de ponteiro.
+    double *fp_x, *fp_y;    ///< Vetores do bloco residente em cache do motor de ponto flutuante (NULL = só registradores).
+    size_t fp_len;          ///< Número de elementos de `fp_x` e `fp_y`.
+    int cpu;                ///< CPU lógica em que o worker executa (-1 = sem fixação).
+    int mem_cpu;            ///< CPU a partir da qual os buffers são tocados pela primeira vez (-1 = sem fixação).
+    int node;               ///< Nó NUMA de `cpu`.
+    int mem_node;           ///< Nó NUMA de `mem_cpu`, onde os buffers residem.
+    unsigned kernels;       ///< Kernels deste worker (bits `1u << kernel_id_t`), definidos pelos papéis.
+    int atomic_pair;        ///< Par de ping-pong do kernel ATOMIC (-1 = sem par).
+    int atomic_side;        ///< Vez deste worker no par (0 ou 1).
+    unsigned perf_mask;     ///< Contadores de hardware (bits de `perf_counter_t`) abertos pela própria thread ao iniciar o laço (lido após o join).
+    AppContext *app;        ///< Um ponteiro de volta para o contexto principal da aplicação.
+
+    /* --- Estado quente (escrito durante o teste) --- */
+    _Alignas(WORKER_ALIGN) atomic_ullong iters; ///< Iterações concluídas; escrito apenas pela própria thread e lido pelo amostrador.
+    atomic_ullong progress; ///< Progresso em milésimos de iteração, atualizado a cada quantum de trabalho.
     atomic_int running;     ///< Flag para sinalizar à thread para continuar executando ou terminar.
-    atomic_uint iters;      ///< Contador para o número de iterações concluídas.
     atomic_int status;      ///< O status do worker (por exemplo, `WORKER_OK`).
-    AppContext *app;        ///< Um ponteiro de volta para o contexto principal da aplicação.
+    atomic_ullong flops;    ///< Operações de ponto flutuante concluídas; escrito apenas pela própria thread.
+    atomic_ullong int_ops;  ///< Operações de inteiros concluídas pelo kernel INT.
+    atomic_ullong ptr_steps;///< Passos (cargas dependentes) concluídos por cadeia do kernel de ponteiro.
+    atomic_ullong ptr_ns;   ///< Tempo acumulado dentro do kernel de ponteiro, em nanossegundos.
+    atomic_ullong stream_bytes; ///< Bytes movidos pelo kernel STREAM, contados como no STREAM.
+    atomic_ullong stream_ns;///< Tempo acumulado dentro do kernel STREAM, em nanossegundos.
+    atomic_ullong atomic_ops;   ///< Operações atômicas concluídas pelo kernel ATOMIC.
+    unsigned long long cas_fails;   ///< CAS do kernel ATOMIC que falharam por disputa (lido após o join).
+    unsigned long long pp_rounds;   ///< Idas e voltas do ping-pong do kernel ATOMIC (lido após o join).
+    unsigned long long pp_ns;       ///< Tempo dessas idas e voltas, em ns (lido após o join).
+    unsigned long long stream_op_bytes[STREAM_OPS]; ///< Bytes por operação STREAM (lidos após o join).
+    unsigned long long stream_op_ns[STREAM_OPS];    ///< Tempo por operação STREAM, em ns (lido após o join).
+    unsigned long long verify_passes;     ///< Passagens completas de verificação pelo buffer (lido após o join).
+    unsigned long long verify_mismatches; ///< Palavras divergentes encontradas pela verificação (lido após o join).
+    atomic_ullong perf[KERNEL_COUNT][PERF_COUNTER_COUNT]; ///< Contadores de hardware atribuídos a cada kernel; escritos apenas pela própria thread.
+    uint32_t ptr_pos[PTR_MAX_CHAINS]; ///< Posição atual de cada cadeia; regravada a cada chamada (sink do kernel).
+    double init_sec;        ///< Tempo de alocação e inicialização dos buffers, em segundos; escrito antes de sinalizar `workers_ready`.
+    double run_start;       ///< Instante (`now_sec`) em que o laço de estresse começou; escrito uma vez pela thread.
+    double run_end;         ///< Instante em que o laço de estresse terminou; escrito uma vez pela thread.
+    double idle_sec;        ///< Tempo ocioso imposto pelo perfil de carga, em segundos; escrito no fim do laço.
+    double edge_lag_max;    ///< Maior atraso observado entre uma subida do perfil e a retomada do trabalho, em segundos.
 };
 
 /* --- CONTEXTO DA APLICAÇÃO --- */
@@ -107,17 +274,81 @@ struct AppContext {
     int threads;                    ///< Número de threads de trabalho a serem geradas.
     size_t mem_mib_per_thread;      ///< Memória a ser alocada por thread (em MiB).
     int duration_sec;               ///< Duração total do teste em segundos (0 para indefinido).
+    int sample_interval_ms;         ///< Período da thread de amostragem em milissegundos (0 = `CPU_SAMPLE_INTERVAL_MS`).
     int pin_affinity;               ///< Flag booleana para habilitar a fixação de núcleos de CPU.
+    int affinity_policy;            ///< Ordem de ocupação das CPUs quando as threads são fixadas (`affinity_policy_t`).
+    char affinity_list[512];        ///< CPUs da política `AFFINITY_LIST`, no formato do kernel (por exemplo, "0-3,8").
     int kernel_fpu_en;              ///< Flag booleana para habilitar o kernel de estresse de FPU.
     int kernel_int_en;              ///< Flag booleana para habilitar o kernel de estresse de inteiros.
     int kernel_stream_en;           ///< Flag booleana para habilitar o kernel de streaming de memória.
     int kernel_ptr_en;              ///< Flag booleana para habilitar o kernel de perseguição de ponteiro.
+    int kernel_atomic_en;           ///< Flag booleana para habilitar o kernel de contenção atômica.
+    int headless;                   ///< Flag booleana: executando sem GUI (logs vão para o stdout, sem chamadas GTK).
+    int numa_mode;                  ///< Política de posicionamento de memória (`numa_mode_t`).
+    int page_mode;                  ///< Tamanho de página preferido para os buffers (`page_mode_t`).
+    int stream_nt;                  ///< Flag booleana: usar stores não-temporais no kernel STREAM.
+    size_t stream_prefetch;         ///< Distância do prefetch de software do kernel STREAM, em bytes (0 = desligado).
+    int ptr_chains;                 ///< Cadeias paralelas do kernel de perseguição de ponteiro (1 = latência pura).
+    size_t fp_block_kib;            ///< Bloco residente em cache do motor de ponto flutuante, em KiB (0 = só registradores).
+    int perf_en;                    ///< Flag booleana: ler contadores de hardware (`perf_event_open`) em cada worker.
+    char export_path[512];          ///< Arquivo para onde cada amostra é exportada (vazio = sem exportação).
+    int export_format;              ///< Formato do arquivo de exportação (`telemetry_format_t`).
+    int degrade_baseline_sec;       ///< Janela da linha de base da detecção de degradação, em segundos (0 = desligada).
+    int degrade_pct;                ///< Queda de vazão, em %, que abre um episódio de degradação.
+    char worker_roles[256];         ///< Papéis dos workers no formato de `roles_assign` (vazio = todos executam todos os kernels).
+    char load_profile[128];         ///< Perfil de carga no formato de `profile_parse` (vazio = carga contínua).
+    size_t sweep_max_mib;           ///< Maior conjunto de trabalho da varredura de caches, em MiB (0 = teste de estresse normal).
+    int c2c_en;                     ///< Flag booleana: medir a matriz de latência entre núcleos no lugar do teste de estresse.
+    char io_path[512];              ///< Alvo do motor de E/S: arquivo, diretório ou dispositivo (vazio = sem E/S).
+    size_t io_file_mib;             ///< Tamanho do arquivo de teste criado pelo motor de E/S, em MiB.
+    size_t io_block_kib;            ///< Tamanho de cada operação de E/S, em KiB.
+    int io_qd;                      ///< Operações de E/S em voo (profundidade de fila).
+    int io_read_pct;                ///< Proporção de leituras da E/S, em %.
+    int io_destructive;             ///< Flag booleana: permite escritas em um arquivo ou dispositivo de bloco que já existia.
+    int jitter_en;                  ///< Flag booleana: rodar a sonda de latência de escalonamento em cada CPU.
+    int jitter_interval_us;         ///< Intervalo entre despertares da sonda de jitter, em µs.
+    int verify_en;                  ///< Flag booleana: o kernel STREAM confere o padrão que gravou (verificação de memória).
+    double start_at;                ///< Instante (`now_sec`) da largada combinada com a frota (0 = assim que os workers estão prontos).
 
     /* --- Estado de Tempo de Execução --- */
     atomic_int running;             ///< Flag que indica se um teste de estresse está atualmente ativo.
     atomic_int errors;              ///< Contador de erros encontrados durante o teste.
-    atomic_uint total_iters;        ///< Contagem de iterações agregadas em todas as threads.
+    atomic_int workers_ready;       ///< Workers que terminaram a inicialização (ou falharam) e aguardam a largada.
+    atomic_int workers_go;          ///< Largada: liberada pela controladora quando todos os workers estão prontos.
+    int profile_active;             ///< Não-zero quando um perfil de carga modula os workers neste teste.
+    atomic_uint load_gate;          ///< Borda corrente do perfil: bit 0 = trabalhar, demais bits = número da borda.
+    atomic_ullong load_rise_ns;     ///< Próxima subida possível da carga, em ns de `now_sec`; dica para os workers ociosos.
+    atomic_ullong total_iters;      ///< Iterações agregadas em todas as threads (soma dos workers, atualizada pelo amostrador).
+    double iters_per_sec;           ///< Vazão agregada no último intervalo de amostragem (protegida por `history_mutex`).
+    double gflops;                  ///< GFLOP/s agregados no último intervalo de amostragem (protegido por `history_mutex`).
+    double *thread_gflops;          ///< GFLOP/s de cada worker no último intervalo (protegido por `history_mutex`).
+    double int_gops;                ///< Bilhões de operações de inteiros por segundo no último intervalo (protegido por `history_mutex`).
+    unsigned long long int_ops_last;///< Total de operações de inteiros na amostra anterior (uso exclusivo do amostrador).
+    double stream_gbps;             ///< Banda STREAM do sistema no último intervalo, em GB/s (protegida por `history_mutex`).
+    unsigned long long stream_bytes_last, stream_ns_last; ///< Totais do kernel STREAM na amostra anterior (uso exclusivo do amostrador).
+    double ptr_ns_per_load;         ///< Latência média por carga dependente no último intervalo (protegida por `history_mutex`).
+    double ptr_mloads;              ///< Milhões de cargas do kernel PTR por segundo, somando todas as cadeias (protegido por `history_mutex`).
+    unsigned long long ptr_loads_last; ///< Total de cargas do kernel PTR na amostra anterior (uso exclusivo do amostrador).
+    unsigned long long ptr_steps_last, ptr_ns_last; ///< Totais do kernel de ponteiro na amostra anterior (uso exclusivo do amostrador).
+    double atomic_mops;             ///< Milhões de operações atômicas por segundo no último intervalo (protegido por `history_mutex`).
+    unsigned long long atomic_ops_last; ///< Total de operações atômicas na amostra anterior (uso exclusivo do amostrador).
+    void *atomic_lines;             ///< Linhas compartilhadas do kernel ATOMIC (`shared_line_t`), alocadas pela controladora.
+    io_engine_t *io;                ///< Motor de E/S, ou NULL; aberto e fechado pela controladora.
+    double io_iops, io_mbps;        ///< Operações de E/S por segundo e MB/s no último intervalo (protegidos por `history_mutex`).
+    double io_p50_us, io_p99_us, io_p999_us; ///< Percentis da latência de E/S no último intervalo, em µs (idem).
+    jitter_t *jitter;               ///< Sondas de jitter, ou NULL; criadas e liberadas pela controladora.
+    verify_edac_t *verify_edac;     ///< Contadores do EDAC no início do teste, ou NULL; lidos e liberados pela controladora.
+    atomic_int verify_logged;       ///< Divergências da verificação já escritas no log neste teste.
+    jitter_result_t *jitter_live;   ///< Jitter por CPU no último intervalo e, após o teste, do teste inteiro (protegido por `history_mutex`).
+    unsigned long long *thread_flops_last; ///< Último total de FLOPs lido de cada worker (uso exclusivo do amostrador).
+    unsigned long long perf_last[KERNEL_COUNT][PERF_COUNTER_COUNT];     ///< Contadores de hardware somados na amostra anterior (uso exclusivo do amostrador).
+    unsigned long long perf_interval[KERNEL_COUNT][PERF_COUNTER_COUNT]; ///< Contadores de cada kernel no último intervalo (protegidos por `history_mutex`).
+    telemetry_t *telemetry;         ///< Exportador das amostras, ou NULL; aberto e fechado pela controladora.
+    const fp_engine_t *fp_engine;   ///< Implementação do motor de ponto flutuante escolhida no início do teste.
     double start_time;              ///< Timestamp (de `now_sec`) quando o teste começou.
+    sweep_result_t *sweep;          ///< Curva da varredura de caches (protegida por `history_mutex`); mantida após o teste para o gráfico.
+    c2c_result_t *c2c;              ///< Matriz de latência entre núcleos (protegida por `history_mutex`); mantida após o teste para o gráfico.
+    fleet_t *fleet;                 ///< Nós da frota no modo coordenador, ou NULL; criado pela UI, conteúdo protegido por `history_mutex`.
 
     /* --- Workers & Threads --- */
     worker_t *workers;              ///< Array de contextos de thread de trabalho.
@@ -127,6 +358,7 @@ struct AppContext {
 
     /* --- Monitoramento de Uso da CPU --- */
     int cpu_count;                  ///< Número de núcleos de CPU lógicos detectados.
+    cpu_topology_t *topology;       ///< Topologia de CPUs/nós NUMA detectada no início do teste.
     double *cpu_usage;              ///< Array para armazenar a utilização de cada núcleo de CPU (0.0 a 1.0).
     GMutex cpu_mutex;               ///< Mutex para proteger o acesso ao array `cpu_usage`.
 #ifdef _WIN32
@@ -143,11 +375,17 @@ struct AppContext {
     int cpu_history_pos;            ///< Índice da entrada mais recente no buffer de histórico da CPU.
     int cpu_history_len;            ///< Capacidade total do buffer de histórico da CPU.
     int cpu_history_filled;         ///< Número de amostras válidas atualmente armazenadas no buffer de histórico.
+    double *cpu_freq_mhz;           ///< MHz efetivo de cada núcleo na última amostra (0 = indisponível).
+    double **freq_history;          ///< Histórico circular do MHz efetivo por núcleo, indexado como `cpu_history`.
+    double freq_max_mhz;            ///< Frequência máxima das CPUs (MHz), usada para escalar o gráfico; 0 se desconhecida.
 
     /* --- Histórico de Desempenho por Thread --- */
-    unsigned **thread_history;      ///< Um buffer circular 2D para armazenar o histórico de iterações por thread.
+    thread_sample_t **thread_history; ///< Buffer circular 2D com instantâneos cumulativos dos contadores de cada thread.
+    double *history_time;           ///< Instante (`now_sec`) de cada amostra de `thread_history`, indexado da mesma forma.
+    unsigned long long history_seq; ///< Número de amostras gravadas em `thread_history` desde o início do teste.
+    history_archive_t *history_archive; ///< Buckets agregados do teste inteiro (protegidos por `history_mutex`).
     int history_pos;                ///< A posição de escrita atual no buffer circular.
-    int history_len;                ///< O número de amostras válidas atualmente no buffer.
+    int history_len;                ///< Capacidade do buffer circular (`HISTORY_SAMPLES`), independente da duração.
     GMutex history_mutex;           ///< Mutex para proteger o acesso ao buffer de histórico.
 
     /* --- Monitoramento de Temperatura --- */
@@ -160,6 +398,10 @@ struct AppContext {
     /* --- Histórico de Métricas do Sistema --- */
     double *temp_history;           ///< Buffer de histórico circular para a temperatura geral da CPU.
     double *avg_cpu_history;        ///< Buffer de histórico circular para o uso médio de CPU.
+    double *avg_freq_history;       ///< Buffer de histórico circular para o MHz efetivo médio (0 = indisponível).
+    int *throttle_thermal_history;  ///< Buffer de histórico circular: CPUs com limitação térmica em cada amostra.
+    int *throttle_power_history;    ///< Buffer de histórico circular: CPUs com limite de potência em cada amostra.
+    double *io_mbps_history;        ///< Buffer de histórico circular: MB/s do motor de E/S em cada amostra.
     int system_history_pos;         ///< Posição de escrita atual nos buffers de histórico do sistema.
     int system_history_len;         ///< Capacidade total dos buffers de histórico do sistema.
     int system_history_filled;      ///< Número de amostras válidas nos buffers de histórico.
@@ -171,12 +413,36 @@ struct AppContext {
     GtkWidget *cpu_frame;           ///< O frame que contém a área de desenho do gráfico de sistema.
     GtkWidget *entry_threads, *entry_dur; ///< Campos de entrada para parâmetros de teste.
     GtkWidget *check_pin;           ///< Checkbox para habilitar a fixação de CPU.
-    GtkWidget *check_fpu, *check_int, *check_stream, *check_ptr; ///< Checkboxes para kernels de estresse.
+    GtkWidget *combo_heat_metric;   ///< Seletor da métrica exibida no heatmap de threads.
+    int heat_metric;                ///< Métrica exibida no heatmap (`thread_metric_t`); usada apenas na thread da UI.
+    heatmap_t *heatmap;             ///< Imagem incremental do heatmap; usada apenas na thread da UI.
+    heatmap_t *heatmap_run;         ///< Imagem do heatmap do teste inteiro, a partir do arquivo; usada apenas na thread da UI.
+    heatmap_t *heatmap_fleet;       ///< Imagem do heatmap por nó da frota; usada apenas na thread da UI.
+    int heat_span;                  ///< 0 = janela recente, 1 = teste inteiro; usado apenas na thread da UI.
+    GtkWidget *combo_heat_span;     ///< Seletor da janela exibida no heatmap.
+    GtkWidget *check_stream_nt;     ///< Checkbox para habilitar stores não-temporais no kernel STREAM.
+    GtkWidget *check_verify;        ///< Checkbox para conferir a memória no kernel STREAM.
+    GtkWidget *check_perf;          ///< Checkbox para habilitar os contadores de hardware.
+    GtkWidget *check_sweep;         ///< Checkbox para executar a varredura de caches no lugar do teste de estresse.
+    GtkWidget *check_c2c;           ///< Checkbox para medir a latência entre núcleos no lugar do teste de estresse.
+    GtkWidget *check_jitter;        ///< Checkbox para rodar a sonda de jitter.
+    GtkWidget *combo_affinity;      ///< Combo de seleção da política de posicionamento das threads.
+    GtkWidget *combo_interval;      ///< Combo de seleção do intervalo de amostragem.
+    GtkWidget *combo_numa;          ///< Combo de seleção do modo NUMA.
+    GtkWidget *combo_pages;         ///< Combo de seleção do tamanho de página.
+    GtkWidget *combo_ptr_chains;    ///< Combo de seleção do número de cadeias do kernel de ponteiro.
+    GtkWidget *combo_fp_block;      ///< Combo de seleção do bloco residente em cache do motor de ponto flutuante.
+    GtkWidget *entry_io_path;       ///< Campo do alvo do motor de E/S.
+    GtkWidget *combo_io_mix;        ///< Combo de seleção da mistura leitura/escrita da E/S.
+    GtkWidget *entry_fleet;         ///< Campo dos nós da frota (vazio = teste local).
+    GtkWidget *check_fpu, *check_int, *check_stream, *check_ptr, *check_atomic; ///< Checkboxes para kernels de estresse.
     GtkWidget *btn_start, *btn_stop, *btn_defaults, *btn_clear_log; ///< Botões de controle.
     GtkTextBuffer *log_buffer;      ///< Buffer de texto para o painel de log de eventos.
     GtkWidget *log_view;            ///< Widget de visualização de texto para o log de eventos.
     GtkWidget *cpu_drawing;         ///< Área de desenho para o gráfico de utilização de CPU por núcleo.
     GtkWidget *iters_drawing;       ///< Área de desenho para o gráfico de histórico de desempenho por thread.
+    GtkWidget *sweep_drawing;       ///< Área de desenho para a curva da varredura de caches.
+    GtkWidget *c2c_drawing;         ///< Área de desenho para a matriz de latência entre núcleos.
     GtkWidget *status_label;        ///< Rótulo para exibir o status atual da aplicação.
     guint status_tick_id;           ///< ID da fonte para o temporizador de atualização periódica do rótulo de status.
 };
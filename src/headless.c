@@ -0,0 +1,560 @@
+#include "headless.h"
+#include "core.h"
+#include "metrics.h"
+#include "utils.h"
+#include "ui.h" // Para gui_log
+#include "pages.h"
+#include "topology.h"
+#include "telemetry.h"
+#include "profile.h"
+#include "roles.h"
+#include "sweep.h"
+#include "coherence.h"
+#include "storage.h"
+#include "jitter.h"
+#include <errno.h>
+#include <signal.h>
+
+/* --- Static Function Prototypes --- */
+static void print_usage(const char *prog);
+static int parse_long(const char *s, long min, long *out);
+static int parse_kernels(AppContext *app, const char *list);
+static int validate_roles(AppContext *app);
+static void on_stop_signal(int sig);
+static void print_progress(AppContext *app, double elapsed);
+static void print_summary(AppContext *app, double elapsed);
+
+static volatile sig_atomic_t g_stop_requested = 0;
+
+/* --- Análise de Argumentos --- */
+
+int headless_requested(int argc, char **argv){
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0) return 1;
+    }
+    return 0;
+}
+
+static void print_usage(const char *prog){
+    printf("Uso: %s --headless [opções]\n"
+           "  -t, --threads N      Número de threads de trabalho (0 = auto)\n"
+           "  -m, --mem MiB        Memória por thread em MiB (padrão %d)\n"
+           "  -d, --duration S     Duração em segundos (0 = indefinido, padrão %d)\n"
+           "      --interval MS    Intervalo de amostragem em milissegundos (%d a %d, padrão %d)\n"
+           "  -k, --kernels LISTA  Kernels separados por vírgula: fpu,int,stream,ptr,atomic ou all\n"
+           "                       (padrão: todos exceto atomic)\n"
+           "      --pin            Fixa as threads em CPUs (padrão)\n"
+           "      --no-pin         Não fixa as threads em CPUs\n"
+           "      --affinity POL   Ordem de fixação: physical (padrão), linear, scatter, compact ou smt-pairs\n"
+           "      --cpus LISTA     Fixa as threads nas CPUs listadas, em ordem (por exemplo, 0-3,8)\n"
+           "      --numa MODO      Posicionamento NUMA: off, local ou remote (implica --pin)\n"
+           "      --pages MODO     Tamanho de página dos buffers: default, thp, 2m ou 1g\n"
+           "      --ptr-chains N   Cadeias paralelas do kernel ptr (1 = latência pura, máx. %d)\n"
+           "      --fp-block KiB   Bloco em cache para o kernel FPU (0 = só registradores, padrão)\n"
+           "      --stream-nt      Usa stores não-temporais no kernel stream (x86)\n"
+           "      --stream-prefetch BYTES  Distância do prefetch de software do kernel stream (0 = desligado)\n"
+           "      --verify         O kernel stream confere os padrões que grava (uns andando, endereço, aleatório);\n"
+           "                       cada divergência conta como erro e é registrada com o endereço físico\n"
+           "      --perf           Lê contadores de hardware (perf_event_open): IPC e MPKI por worker e kernel\n"
+           "      --export ARQUIVO Grava cada amostra e um resumo final em ARQUIVO (.csv ou .jsonl)\n"
+           "      --export-format F  Formato da exportação: csv ou jsonl (padrão: pela extensão)\n"
+           "      --degrade-baseline S  Janela inicial da linha de base da detecção de degradação (0 = desligada, padrão %d)\n"
+           "      --degrade-pct P  Queda de vazão, em %%, que abre um episódio de degradação (padrão %d)\n"
+           "      --profile PERFIL Modula a carga de todos os workers juntos: duty:PCT[:MS], square[:MS],\n"
+           "                       ramp:DE:ATE:S[:MS] ou step:N1,N2,...:S[:MS] (níveis em %%, janelas de %d ms)\n"
+           "      --roles PAPÉIS   Kernels por grupo de workers (fpu+int=0-7;stream=8-15) ou smt\n"
+           "                       (computação na 1ª thread de cada núcleo, memória nas irmãs)\n"
+           "      --sweep          Em vez do teste, mede latência e banda de 4 KiB a %d MiB (curva dos caches)\n"
+           "      --sweep-max MiB  Como --sweep, até MiB (1 a %d; limitado a 1/4 da memória)\n"
+           "      --c2c            Em vez do teste, mede a latência de ida e volta entre as CPUs dos workers (implica --pin)\n"
+           "      --io ALVO        Estressa o armazenamento junto com os workers: um diretório (recebe um arquivo\n"
+           "                       temporário), um arquivo ou um dispositivo de bloco (só lidos, sem --io-destructive)\n"
+           "      --io-size MiB    Tamanho do arquivo de teste criado ou estendido (padrão %d)\n"
+           "      --io-qd N        Operações de E/S em voo (1 a %d, padrão %d)\n"
+           "      --io-bs KiB      Tamanho de cada operação, múltiplo de 4 (4 a %d, padrão %d)\n"
+           "      --io-read PCT    Proporção de leituras, em %% (0 a 100, padrão %d)\n"
+           "      --io-destructive Permite escritas em um arquivo ou dispositivo que já existia (DESTRÓI o\n"
+           "                       conteúdo); sem ela, só o arquivo temporário é escrito e um alvo existente só é lido\n"
+           "      --jitter         Mede a latência de despertar em cada CPU com sondas de tempo real (cyclictest)\n"
+           "      --jitter-us N    Como --jitter, com N µs entre despertares (%d a %d, padrão %d)\n"
+           "  -h, --help           Mostra esta ajuda\n",
+           prog, DEFAULT_MEM_MIB, DEFAULT_DURATION_SEC,
+           SAMPLE_INTERVAL_MIN_MS, SAMPLE_INTERVAL_MAX_MS, CPU_SAMPLE_INTERVAL_MS, PTR_MAX_CHAINS,
+           DEFAULT_DEGRADE_BASELINE_SEC, DEFAULT_DEGRADE_PCT, PROFILE_DEFAULT_PERIOD_MS,
+           DEFAULT_SWEEP_MAX_MIB, SWEEP_MAX_MIB, IO_DEFAULT_FILE_MIB, IO_MAX_QD, IO_DEFAULT_QD,
+           IO_MAX_BLOCK_KIB, IO_DEFAULT_BLOCK_KIB, IO_DEFAULT_READ_PCT,
+           JITTER_MIN_INTERVAL_US, JITTER_MAX_INTERVAL_US, JITTER_DEFAULT_INTERVAL_US);
+}
+
+/**
+ * @brief Converte uma string decimal em `long`, validando-a completamente.
+ * @return 0 em caso de sucesso, -1 se a string for inválida ou menor que `min`.
+ */
+static int parse_long(const char *s, long min, long *out){
+    if (!s || *s == '\0') return -1;
+    char *end;
+    errno = 0;
+    long v = strtol(s, &end, 10);
+    if (*end != '\0' || errno == ERANGE || v < min) return -1;
+    *out = v;
+    return 0;
+}
+
+/**
+ * @brief Habilita os kernels listados em `list` (e desabilita os demais).
+ * @return 0 em caso de sucesso, -1 se um nome for desconhecido ou a lista estiver vazia.
+ */
+static int parse_kernels(AppContext *app, const char *list){
+    int fpu = 0, integer = 0, stream = 0, ptr = 0, atomic = 0;
+    const char *p = list;
+    while (*p) {
+        const char *comma = strchr(p, ',');
+        size_t len = comma ? (size_t)(comma - p) : strlen(p);
+        if (len == 3 && strncmp(p, "all", 3) == 0) { fpu = integer = stream = ptr = atomic = 1; }
+        else if (len == 3 && strncmp(p, "fpu", 3) == 0) fpu = 1;
+        else if (len == 3 && strncmp(p, "int", 3) == 0) integer = 1;
+        else if (len == 6 && strncmp(p, "stream", 6) == 0) stream = 1;
+        else if (len == 3 && strncmp(p, "ptr", 3) == 0) ptr = 1;
+        else if (len == 6 && strncmp(p, "atomic", 6) == 0) atomic = 1;
+        else {
+            fprintf(stderr, "Kernel desconhecido: '%.*s'\n", (int)len, p);
+            return -1;
+        }
+        p += len;
+        if (*p == ',') p++;
+    }
+
+    if (!fpu && !integer && !stream && !ptr && !atomic) return -1;
+    app->kernel_fpu_en = fpu;
+    app->kernel_int_en = integer;
+    app->kernel_stream_en = stream;
+    app->kernel_ptr_en = ptr;
+    app->kernel_atomic_en = atomic;
+    return 0;
+}
+
+/**
+ * @brief Valida a sintaxe de `--roles` contra o número de workers e os kernels de `-k`.
+ *
+ * A divisão `smt` depende da fixação e é refeita no início do teste; aqui os
+ * workers são tratados como sem fixação.
+ */
+static int validate_roles(AppContext *app){
+    unsigned defaults = (app->kernel_fpu_en ? 1u << KERNEL_FPU : 0) | (app->kernel_int_en ? 1u << KERNEL_INT : 0) |
+                        (app->kernel_stream_en ? 1u << KERNEL_STREAM : 0) | (app->kernel_ptr_en ? 1u << KERNEL_PTR : 0) |
+                        (app->kernel_atomic_en ? 1u << KERNEL_ATOMIC : 0);
+    unsigned *masks = calloc(app->threads > 0 ? (size_t)app->threads : 1, sizeof(unsigned));
+    char err[160] = "";
+    int rc = masks ? roles_assign(app->worker_roles, defaults, NULL, NULL, app->threads, masks, err, sizeof(err)) : -1;
+    if (rc != 0) fprintf(stderr, "Papéis inválidos para --roles: %s\n", err[0] ? err : "falta de memória");
+    free(masks);
+    return rc;
+}
+
+int headless_parse_args(AppContext *app, int argc, char **argv){
+    long threads = 0;
+    int export_format = -1;
+    app->threads = 0;
+    app->kernel_fpu_en = app->kernel_int_en = app->kernel_stream_en = app->kernel_ptr_en = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        long v;
+
+        if (strcmp(a, "--headless") == 0) {
+            continue;
+        } else if (strcmp(a, "-h") == 0 || strcmp(a, "--help") == 0) {
+            return 1;
+        } else if (strcmp(a, "--pin") == 0) {
+            app->pin_affinity = 1;
+        } else if (strcmp(a, "--no-pin") == 0) {
+            app->pin_affinity = 0;
+        } else if (strcmp(a, "--affinity") == 0) {
+            int policy = affinity_policy_parse(val);
+            if (policy < 0) {
+                fprintf(stderr, "Política de posicionamento inválida para %s\n", a);
+                return -1;
+            }
+            app->affinity_policy = policy;
+            app->pin_affinity = 1;
+            i++;
+        } else if (strcmp(a, "--cpus") == 0) {
+            int probe[1];
+            if (!val || strlen(val) >= sizeof(app->affinity_list) || parse_cpu_list(val, probe, 1) <= 0) {
+                fprintf(stderr, "Lista de CPUs inválida para %s\n", a);
+                return -1;
+            }
+            snprintf(app->affinity_list, sizeof(app->affinity_list), "%s", val);
+            app->affinity_policy = AFFINITY_LIST;
+            app->pin_affinity = 1;
+            i++;
+        } else if (strcmp(a, "--stream-nt") == 0) {
+            app->stream_nt = 1;
+        } else if (strcmp(a, "--verify") == 0) {
+            app->verify_en = 1;
+        } else if (strcmp(a, "--perf") == 0) {
+            app->perf_en = 1;
+        } else if (strcmp(a, "--export") == 0) {
+            if (!val || *val == '\0' || strlen(val) >= sizeof(app->export_path)) {
+                fprintf(stderr, "Arquivo inválido para %s\n", a);
+                return -1;
+            }
+            snprintf(app->export_path, sizeof(app->export_path), "%s", val);
+            i++;
+        } else if (strcmp(a, "--export-format") == 0) {
+            export_format = telemetry_format_parse(val);
+            if (export_format < 0) {
+                fprintf(stderr, "Formato inválido para %s\n", a);
+                return -1;
+            }
+            i++;
+        } else if (strcmp(a, "--stream-prefetch") == 0) {
+            if (parse_long(val, 0, &v) != 0 || v > (1L << 20)) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->stream_prefetch = (size_t)v;
+            i++;
+        } else if (strcmp(a, "--numa") == 0) {
+            if (val && strcmp(val, "off") == 0) app->numa_mode = NUMA_MODE_OFF;
+            else if (val && strcmp(val, "local") == 0) app->numa_mode = NUMA_MODE_LOCAL;
+            else if (val && strcmp(val, "remote") == 0) app->numa_mode = NUMA_MODE_REMOTE;
+            else {
+                fprintf(stderr, "Modo NUMA inválido para %s\n", a);
+                return -1;
+            }
+            i++;
+        } else if (strcmp(a, "--pages") == 0) {
+            int mode = page_mode_parse(val);
+            if (mode < 0) {
+                fprintf(stderr, "Modo de página inválido para %s\n", a);
+                return -1;
+            }
+            app->page_mode = mode;
+            i++;
+        } else if (strcmp(a, "--ptr-chains") == 0) {
+            if (parse_long(val, 1, &v) != 0 || v > PTR_MAX_CHAINS) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->ptr_chains = (int)v;
+            i++;
+        } else if (strcmp(a, "--fp-block") == 0) {
+            if (parse_long(val, 0, &v) != 0 || v > FP_BLOCK_MAX_KIB) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->fp_block_kib = (size_t)v;
+            i++;
+        } else if (strcmp(a, "-t") == 0 || strcmp(a, "--threads") == 0) {
+            if (parse_long(val, 0, &threads) != 0 || threads > 65536) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            i++;
+        } else if (strcmp(a, "-m") == 0 || strcmp(a, "--mem") == 0) {
+            if (parse_long(val, 1, &v) != 0) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->mem_mib_per_thread = (size_t)v;
+            i++;
+        } else if (strcmp(a, "-d") == 0 || strcmp(a, "--duration") == 0) {
+            if (parse_long(val, 0, &v) != 0 || v > INT32_MAX) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->duration_sec = (int)v;
+            i++;
+        } else if (strcmp(a, "--interval") == 0) {
+            if (parse_long(val, SAMPLE_INTERVAL_MIN_MS, &v) != 0 || v > SAMPLE_INTERVAL_MAX_MS) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->sample_interval_ms = (int)v;
+            i++;
+        } else if (strcmp(a, "--degrade-baseline") == 0) {
+            if (parse_long(val, 0, &v) != 0 || v > INT32_MAX) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->degrade_baseline_sec = (int)v;
+            i++;
+        } else if (strcmp(a, "--degrade-pct") == 0) {
+            if (parse_long(val, 1, &v) != 0 || v > 99) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->degrade_pct = (int)v;
+            i++;
+        } else if (strcmp(a, "--profile") == 0) {
+            load_profile_t profile;
+            if (!val || strlen(val) >= sizeof(app->load_profile) || profile_parse(val, &profile) != 0) {
+                fprintf(stderr, "Perfil de carga inválido para %s\n", a);
+                return -1;
+            }
+            snprintf(app->load_profile, sizeof(app->load_profile), "%s", val);
+            i++;
+        } else if (strcmp(a, "--roles") == 0) {
+            if (!val || *val == '\0' || strlen(val) >= sizeof(app->worker_roles)) {
+                fprintf(stderr, "Papéis inválidos para %s\n", a);
+                return -1;
+            }
+            snprintf(app->worker_roles, sizeof(app->worker_roles), "%s", val);
+            i++;
+        } else if (strcmp(a, "--sweep") == 0) {
+            app->sweep_max_mib = DEFAULT_SWEEP_MAX_MIB;
+        } else if (strcmp(a, "--sweep-max") == 0) {
+            if (parse_long(val, 1, &v) != 0 || v > SWEEP_MAX_MIB) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->sweep_max_mib = (size_t)v;
+            i++;
+        } else if (strcmp(a, "--c2c") == 0) {
+            app->c2c_en = 1;
+        } else if (strcmp(a, "--io") == 0) {
+            if (!val || *val == '\0' || strlen(val) >= sizeof(app->io_path)) {
+                fprintf(stderr, "Alvo inválido para %s\n", a);
+                return -1;
+            }
+            snprintf(app->io_path, sizeof(app->io_path), "%s", val);
+            i++;
+        } else if (strcmp(a, "--io-size") == 0) {
+            if (parse_long(val, 1, &v) != 0 || v > (1L << 30)) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->io_file_mib = (size_t)v;
+            i++;
+        } else if (strcmp(a, "--io-qd") == 0) {
+            if (parse_long(val, 1, &v) != 0 || v > IO_MAX_QD) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->io_qd = (int)v;
+            i++;
+        } else if (strcmp(a, "--io-bs") == 0) {
+            if (parse_long(val, 4, &v) != 0 || v > IO_MAX_BLOCK_KIB || v % 4 != 0) {
+                fprintf(stderr, "Valor inválido para %s (múltiplo de 4 KiB)\n", a);
+                return -1;
+            }
+            app->io_block_kib = (size_t)v;
+            i++;
+        } else if (strcmp(a, "--io-read") == 0) {
+            if (parse_long(val, 0, &v) != 0 || v > 100) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->io_read_pct = (int)v;
+            i++;
+        } else if (strcmp(a, "--io-destructive") == 0) {
+            app->io_destructive = 1;
+        } else if (strcmp(a, "--jitter") == 0) {
+            app->jitter_en = 1;
+        } else if (strcmp(a, "--jitter-us") == 0) {
+            if (parse_long(val, JITTER_MIN_INTERVAL_US, &v) != 0 || v > JITTER_MAX_INTERVAL_US) {
+                fprintf(stderr, "Valor inválido para %s\n", a);
+                return -1;
+            }
+            app->jitter_en = 1;
+            app->jitter_interval_us = (int)v;
+            i++;
+        } else if (strcmp(a, "-k") == 0 || strcmp(a, "--kernels") == 0) {
+            if (!val || parse_kernels(app, val) != 0) {
+                fprintf(stderr, "Lista de kernels inválida para %s\n", a);
+                return -1;
+            }
+            i++;
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", a);
+            return -1;
+        }
+    }
+
+    if (app->c2c_en && app->sweep_max_mib > 0) {
+        fprintf(stderr, "--c2c e --sweep não podem ser usados juntos\n");
+        return -1;
+    }
+    if (app->io_path[0] && (app->c2c_en || app->sweep_max_mib > 0)) {
+        fprintf(stderr, "--io acompanha o teste de estresse e não pode ser usado com --sweep ou --c2c\n");
+        return -1;
+    }
+    if (app->jitter_en && (app->c2c_en || app->sweep_max_mib > 0)) {
+        fprintf(stderr, "--jitter acompanha o teste de estresse e não pode ser usado com --sweep ou --c2c\n");
+        return -1;
+    }
+    if (app->verify_en && (!app->kernel_stream_en || app->c2c_en || app->sweep_max_mib > 0)) {
+        fprintf(stderr, "--verify usa o kernel stream do teste de estresse e não pode ser usado sem ele, com --sweep ou --c2c\n");
+        return -1;
+    }
+    app->threads = (threads == 0) ? detect_cpu_count() : (int)threads;
+    if (app->worker_roles[0] && validate_roles(app) != 0) return -1;
+    app->export_format = export_format >= 0 ? export_format : telemetry_format_from_path(app->export_path);
+    return 0;
+}
+
+/* --- Execução --- */
+
+static void on_stop_signal(int sig){
+    (void)sig;
+    g_stop_requested = 1;
+}
+
+/**
+ * @brief Imprime uma linha de progresso com a vazão e as métricas do sistema.
+ */
+static void print_progress(AppContext *app, double elapsed){
+    double avg_usage = 0.0;
+    g_mutex_lock(&app->cpu_mutex);
+    if (app->cpu_usage && app->cpu_count > 0) {
+        for (int c = 0; c < app->cpu_count; c++) avg_usage += app->cpu_usage[c];
+        avg_usage /= app->cpu_count;
+    }
+    double freq_sum = 0.0;
+    int freq_known = 0;
+    for (int c = 0; app->cpu_freq_mhz && c < app->cpu_count; c++) {
+        if (app->cpu_freq_mhz[c] > 0.0) { freq_sum += app->cpu_freq_mhz[c]; freq_known++; }
+    }
+    g_mutex_unlock(&app->cpu_mutex);
+
+    g_mutex_lock(&app->temp_mutex);
+    double temp = app->temp_celsius;
+    g_mutex_unlock(&app->temp_mutex);
+
+    char temp_buf[32];
+    if (temp > TEMP_UNAVAILABLE) snprintf(temp_buf, sizeof(temp_buf), "%.1f°C", temp);
+    else snprintf(temp_buf, sizeof(temp_buf), "n/d");
+
+    char freq_buf[32];
+    if (freq_known > 0) snprintf(freq_buf, sizeof(freq_buf), "%.0f MHz", freq_sum / freq_known);
+    else snprintf(freq_buf, sizeof(freq_buf), "n/d");
+
+    char rates[256];
+    format_kernel_rates(app, rates, sizeof(rates));
+
+    printf("[%6.0fs] %s | CPU %.1f%% | Freq %s | Temp %s | Erros %d\n",
+           elapsed, rates, avg_usage * 100.0, freq_buf, temp_buf, atomic_load(&app->errors));
+    char perf[320];
+    if (format_perf_rates(app, perf, sizeof(perf))) printf("          %s\n", perf);
+    fflush(stdout);
+}
+
+/**
+ * @brief Imprime o resumo final do teste.
+ */
+static void print_summary(AppContext *app, double elapsed){
+    unsigned long long total = atomic_load(&app->total_iters);
+    printf("\n=== Resumo HardStress ===\n");
+    if (app->sweep_max_mib > 0) {
+        // A curva já saiu no log, ponto a ponto.
+        printf("Varredura:        %d ponto(s), até %zu MiB\n", app->sweep ? app->sweep->count : 0, app->sweep_max_mib);
+        printf("Erros:            %d\n", atomic_load(&app->errors));
+        fflush(stdout);
+        return;
+    }
+    if (app->c2c_en) {
+        // A matriz e o par mais lento já saíram no log.
+        printf("Latência c2c:     %d de %d par(es) medido(s)\n", app->c2c ? app->c2c->done : 0,
+               app->c2c ? app->c2c->n * (app->c2c->n - 1) / 2 : 0);
+        printf("Erros:            %d\n", atomic_load(&app->errors));
+        fflush(stdout);
+        return;
+    }
+    printf("Duração:          %.1f s\n", elapsed);
+    printf("Threads:          %d\n", app->threads);
+    printf("Memória/thread:   %zu MiB\n", app->mem_mib_per_thread);
+    printf("Iterações totais: %llu\n", total);
+    printf("Média:            %.1f iters/s\n", elapsed > 0.0 ? (double)total / elapsed : 0.0);
+    printf("Erros:            %d\n", atomic_load(&app->errors));
+    fflush(stdout);
+}
+
+void headless_install_signals(void){
+    signal(SIGINT, on_stop_signal);
+    signal(SIGTERM, on_stop_signal);
+}
+
+int headless_stop_requested(void){
+    return g_stop_requested != 0;
+}
+
+int headless_main(AppContext *app, int argc, char **argv){
+#ifdef _WIN32
+    // O binário é ligado com -mwindows; reanexa ao console do processo pai para que o stdout apareça.
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        freopen("CONOUT$", "w", stdout);
+        freopen("CONOUT$", "w", stderr);
+    }
+#endif
+    app->headless = 1;
+
+    int rc = headless_parse_args(app, argc, argv);
+    if (rc != 0) {
+        print_usage(argv[0]);
+        app_context_free(app);
+        return rc > 0 ? 0 : 1;
+    }
+
+    headless_install_signals();
+    rc = headless_run(app, NULL, NULL);
+    app_context_free(app);
+    return rc;
+}
+
+int headless_run(AppContext *app, headless_tick_fn tick, void *ctx){
+    // A varredura usa um único buffer, limitado pela controladora a um quarto da memória; a matriz c2c, nenhum.
+    unsigned long long total_mem_bytes = get_total_system_memory();
+    if (total_mem_bytes > 0 && app->sweep_max_mib == 0 && !app->c2c_en) {
+        unsigned long long required_bytes = app->mem_mib_per_thread * 1024ULL * 1024ULL * (unsigned long long)app->threads;
+        if ((long double)required_bytes / (long double)total_mem_bytes >= 0.90L) {
+            fprintf(stderr, "ERRO: A configuração reservaria ~%llu MiB, mas apenas %llu MiB estão disponíveis.\n",
+                    required_bytes / (1024ULL * 1024ULL), total_mem_bytes / (1024ULL * 1024ULL));
+            return 1;
+        }
+    }
+
+    gui_log(app, "[Headless] Teste iniciado: threads=%d mem/thread=%zu dur=%ds pin=%d numa=%d\n",
+            app->threads, app->mem_mib_per_thread, app->duration_sec, app->pin_affinity, app->numa_mode);
+
+    // Marca como em execução antes de criar a controladora para que o laço abaixo não termine prematuramente.
+    atomic_store(&app->running, 1);
+    if (thread_create(&app->controller_thread, controller_thread_func, app) != 0) {
+        fprintf(stderr, "ERRO: Falha ao iniciar a thread controladora.\n");
+        return 2;
+    }
+
+    // A linha de progresso sai a cada segundo, ou a cada amostra se o intervalo for maior.
+    double report_sec = app->sample_interval_ms > CPU_SAMPLE_INTERVAL_MS ? app->sample_interval_ms / 1000.0
+                                                                         : CPU_SAMPLE_INTERVAL_MS / 1000.0;
+    // O relógio do progresso e do resumo parte da largada dos workers, não da inicialização dos buffers.
+    double start = 0.0, next_report = 0.0;
+    while (atomic_load(&app->running)) {
+        if (g_stop_requested) {
+            gui_log(app, "[Headless] Sinal recebido. Parando...\n");
+            atomic_store(&app->running, 0);
+            break;
+        }
+        double now = now_sec();
+        if (start == 0.0 && atomic_load(&app->workers_go)) {
+            start = now;
+            next_report = start + report_sec;
+        }
+        if (start > 0.0 && now >= next_report) {
+            print_progress(app, now - start);
+            next_report += report_sec;
+        }
+        if (tick && tick(app, ctx) != 0) {
+            atomic_store(&app->running, 0);
+            break;
+        }
+        struct timespec r = {0, 100 * 1000000}; nanosleep(&r, NULL);
+    }
+
+    thread_join(app->controller_thread);
+    app->controller_thread = 0;
+    print_summary(app, start > 0.0 ? now_sec() - start : 0.0);
+
+    return (atomic_load(&app->errors) > 0) ? 2 : 0;
+}
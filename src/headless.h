@@ -0,0 +1,84 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+/**
+ * @file headless.h
+ * @brief Declara o modo de execução sem interface gráfica (linha de comando).
+ *
+ * Este módulo permite executar o pipeline controlador/workers/amostrador sem
+ * inicializar o GTK, lendo a configuração a partir da linha de comando e
+ * imprimindo o desempenho periódico e um resumo final no stdout. É destinado
+ * a servidores sem display e a execuções em larga escala.
+ */
+
+#include "hardstress.h"
+
+/**
+ * @brief Verifica se `--headless` foi passado na linha de comando.
+ *
+ * Deve ser chamada antes de `gtk_init`, pois o modo headless não inicializa o GTK.
+ *
+ * @param argc O número de argumentos da linha de comando.
+ * @param argv O array de argumentos da linha de comando.
+ * @return 1 se o modo headless foi solicitado, 0 caso contrário.
+ */
+int headless_requested(int argc, char **argv);
+
+/**
+ * @brief Analisa os argumentos da linha de comando do modo headless.
+ *
+ * Preenche a configuração de `app` (threads, memória, duração, kernels e
+ * afinidade) a partir de `argv`. Opções não informadas mantêm o valor atual
+ * de `app`, que deve ter sido inicializado com os padrões.
+ *
+ * @param app O contexto da aplicação a ser configurado.
+ * @param argc O número de argumentos da linha de comando.
+ * @param argv O array de argumentos da linha de comando.
+ * @return 0 em caso de sucesso, 1 se a ajuda foi solicitada, -1 em caso de argumento inválido.
+ */
+int headless_parse_args(AppContext *app, int argc, char **argv);
+
+/**
+ * @brief Ponto de entrada do modo headless.
+ *
+ * Analisa os argumentos, executa a thread controladora até o fim da duração
+ * (ou até SIGINT/SIGTERM), imprime o desempenho a cada intervalo de amostragem
+ * e um resumo final, e libera os recursos de `app`, incluindo a própria struct.
+ *
+ * @param app O contexto da aplicação, já inicializado com os padrões.
+ * @param argc O número de argumentos da linha de comando.
+ * @param argv O array de argumentos da linha de comando.
+ * @return 0 se o teste terminou sem erros, 1 em caso de uso inválido, 2 se erros foram registrados.
+ */
+int headless_main(AppContext *app, int argc, char **argv);
+
+/**
+ * @brief Chamada a cada passo (~100 ms) do laço de `headless_run`.
+ * @return Não-zero para parar o teste.
+ */
+typedef int (*headless_tick_fn)(AppContext *app, void *ctx);
+
+/**
+ * @brief Executa um teste já configurado em `app`, como `headless_main`, sem liberar `app`.
+ *
+ * Verifica a memória, roda a controladora até o fim da duração, de um sinal ou
+ * de um pedido de `tick`, imprimindo o progresso e o resumo. O agente da frota
+ * usa `tick` para transmitir as amostras e atender à parada do coordenador.
+ *
+ * @param tick Chamada a cada passo do laço, ou NULL.
+ * @param ctx Repassado a `tick`.
+ * @return 0 se o teste terminou sem erros, 1 se a memória não basta, 2 se erros foram registrados.
+ */
+int headless_run(AppContext *app, headless_tick_fn tick, void *ctx);
+
+/**
+ * @brief Instala os tratadores de SIGINT/SIGTERM, que pedem o fim do teste em curso.
+ */
+void headless_install_signals(void);
+
+/**
+ * @brief Indica se SIGINT ou SIGTERM foi recebido desde o início do processo.
+ */
+int headless_stop_requested(void);
+
+#endif // HEADLESS_H
@@ -0,0 +1,238 @@
+#include "heatmap.h"
+#include "history.h"
+#include "fleet.h"
+#include <float.h>
+
+/** @brief Cor das células sem dado (o fundo do heatmap), em RGB24. */
+#define HEATMAP_EMPTY_PIXEL 0x00323246u
+
+/** @brief Folga somada à escala a cada repintura, para que pequenas variações não repintem tudo. */
+#define HEATMAP_SCALE_HEADROOM 0.05
+
+/* --- Static Function Prototypes --- */
+static void compute_column(heatmap_t *h, const AppContext *app, int col);
+static void paint_column(heatmap_t *h, int col);
+static void window_range(const heatmap_t *h, double *lo, double *hi);
+static void paint_all(heatmap_t *h);
+static uint32_t pack_rgb(double normalized);
+
+heatmap_t *heatmap_create(int threads, int len){
+    if (threads <= 0 || len <= 0) return NULL;
+    heatmap_t *h = calloc(1, sizeof(*h));
+    if (!h) return NULL;
+    size_t cells = (size_t)threads * (size_t)len;
+    h->threads = threads;
+    h->len = len;
+    h->metric = -1;
+    h->values = malloc(cells * sizeof(double));
+    h->col_min = malloc((size_t)len * sizeof(double));
+    h->col_max = malloc((size_t)len * sizeof(double));
+    h->active = calloc((size_t)threads, sizeof(int));
+    h->pixels = malloc(cells * sizeof(uint32_t));
+    if (!h->values || !h->col_min || !h->col_max || !h->active || !h->pixels) {
+        heatmap_free(h);
+        return NULL;
+    }
+    return h;
+}
+
+void heatmap_free(heatmap_t *h){
+    if (!h) return;
+    free(h->values);
+    free(h->col_min);
+    free(h->col_max);
+    free(h->active);
+    free(h->pixels);
+    free(h);
+}
+
+void heatmap_color(double normalized, double rgb[3]){
+    static const double cold[3] = {0.047, 0.203, 0.725};
+    static const double warm[3] = {1.0, 0.933, 0.0};
+    static const double hot[3] = {0.913, 0.231, 0.231};
+
+    double n = normalized < 0.0 ? 0.0 : (normalized > 1.0 ? 1.0 : normalized);
+    const double *a = n <= 0.5 ? cold : warm;
+    const double *b = n <= 0.5 ? warm : hot;
+    double t = n <= 0.5 ? n / 0.5 : (n - 0.5) / 0.5;
+    for (int i = 0; i < 3; i++) rgb[i] = a[i] + (b[i] - a[i]) * t;
+}
+
+/**
+ * @brief Converte um valor normalizado em um pixel RGB24.
+ */
+static uint32_t pack_rgb(double normalized){
+    double rgb[3];
+    heatmap_color(normalized, rgb);
+    return ((uint32_t)(rgb[0] * 255.0 + 0.5) << 16) | ((uint32_t)(rgb[1] * 255.0 + 0.5) << 8) |
+           (uint32_t)(rgb[2] * 255.0 + 0.5);
+}
+
+/**
+ * @brief Recalcula a taxa de cada thread na coluna `col` a partir de duas amostras consecutivas.
+ *
+ * A taxa é dividida pelo tempo real entre as amostras (`history_time`); a coluna
+ * fica sem dado se a amostra anterior ainda não existe.
+ */
+static void compute_column(heatmap_t *h, const AppContext *app, int col){
+    int prev = (col + h->len - 1) % h->len;
+    double dt = app->history_time ? app->history_time[col] - app->history_time[prev] : 0.0;
+    int valid = dt > 0.0 && app->history_time[prev] != 0.0;
+    double lo = DBL_MAX, hi = 0.0;
+    for (int t = 0; t < h->threads; t++) {
+        double *cell = &h->values[(size_t)t * h->len + col];
+        if (*cell > 0.0) h->active[t]--;
+        double rate = -1.0;
+        if (valid) {
+            unsigned long long cur = app->thread_history[t][col].v[h->metric];
+            unsigned long long old = app->thread_history[t][prev].v[h->metric];
+            rate = (double)(cur > old ? cur - old : 0) * h->unit_scale / dt;
+        }
+        *cell = rate;
+        if (rate > 0.0) {
+            h->active[t]++;
+            if (rate < lo) lo = rate;
+            if (rate > hi) hi = rate;
+        }
+    }
+    h->col_min[col] = lo;
+    h->col_max[col] = hi;
+}
+
+/**
+ * @brief Pinta a coluna `col` da imagem com a escala atual.
+ */
+static void paint_column(heatmap_t *h, int col){
+    double range = h->hi > h->lo ? h->hi - h->lo : 1.0;
+    for (int t = 0; t < h->threads; t++) {
+        size_t i = (size_t)t * h->len + col;
+        double v = h->values[i];
+        h->pixels[i] = v < 0.0 ? HEATMAP_EMPTY_PIXEL : pack_rgb((v - h->lo) / range);
+    }
+}
+
+/**
+ * @brief Calcula a menor taxa positiva e a maior taxa da janela a partir dos extremos por coluna.
+ */
+static void window_range(const heatmap_t *h, double *lo, double *hi){
+    double l = DBL_MAX, u = 0.0;
+    for (int c = 0; c < h->len; c++) {
+        if (h->col_min[c] < l) l = h->col_min[c];
+        if (h->col_max[c] > u) u = h->col_max[c];
+    }
+    if (l == DBL_MAX) l = 0.0;
+    if (u < l) u = l;
+    *lo = l;
+    *hi = u;
+}
+
+/**
+ * @brief Refaz a escala pela janela inteira e repinta todas as colunas.
+ */
+static void paint_all(heatmap_t *h){
+    window_range(h, &h->lo, &h->hi);
+    for (int c = 0; c < h->len; c++) paint_column(h, c);
+    h->repaints++;
+}
+
+int heatmap_update(heatmap_t *h, const AppContext *app, int metric, double unit_scale){
+    if (!h || !app->thread_history || app->history_len != h->len || app->threads != h->threads) return 0;
+
+    unsigned long long seq = app->history_seq;
+    int rebuild = metric != h->metric || seq < h->seq || seq - h->seq >= (unsigned long long)h->len;
+    int fresh;
+    if (rebuild) {
+        h->metric = metric;
+        h->unit_scale = unit_scale;
+        for (size_t i = 0; i < (size_t)h->threads * h->len; i++) h->values[i] = -1.0;
+        for (int t = 0; t < h->threads; t++) h->active[t] = 0;
+        for (int c = 0; c < h->len; c++) compute_column(h, app, c);
+        fresh = h->len;
+    } else {
+        fresh = (int)(seq - h->seq);
+        for (int k = fresh - 1; k >= 0; k--) {
+            compute_column(h, app, (app->history_pos - k + h->len) % h->len);
+        }
+    }
+    h->seq = seq;
+    if (fresh == 0) return 0;
+
+    // A escala só é refeita (com folga) quando a janela sai dela ou encolhe bastante;
+    // no caso comum apenas as colunas novas são pintadas.
+    double lo, hi;
+    window_range(h, &lo, &hi);
+    double painted = h->hi - h->lo;
+    if (rebuild || hi > h->hi || lo < h->lo || (hi - lo) < 0.8 * painted) {
+        double pad = (hi - lo) * HEATMAP_SCALE_HEADROOM;
+        h->lo = lo - pad > 0.0 ? lo - pad : 0.0;
+        h->hi = hi + pad;
+        for (int c = 0; c < h->len; c++) paint_column(h, c);
+        h->repaints++;
+    } else {
+        for (int k = 0; k < fresh; k++) paint_column(h, (app->history_pos - k + h->len) % h->len);
+    }
+    return fresh;
+}
+
+int heatmap_update_archive(heatmap_t *h, const history_archive_t *a, int metric, double unit_scale){
+    if (!h || !a || a->threads != h->threads || a->count > h->len) return 0;
+    if (metric == h->metric && a->version == h->seq) return 0;
+
+    // O arquivo muda apenas quando um bucket fecha, e aí todos podem ter sido fundidos:
+    // as colunas são sempre recalculadas, o que custa no máximo threads x HISTORY_ARCHIVE_BUCKETS.
+    h->metric = metric;
+    h->unit_scale = unit_scale;
+    h->seq = a->version;
+    for (int c = 0; c < h->len; c++) {
+        h->col_min[c] = DBL_MAX;
+        h->col_max[c] = 0.0;
+    }
+    for (int t = 0; t < h->threads; t++) {
+        h->active[t] = 0;
+        for (int c = 0; c < h->len; c++) {
+            double rate = c < a->count ? history_archive_avg(a, t, c, metric) * unit_scale : -1.0;
+            h->values[(size_t)t * h->len + c] = rate;
+            if (rate > 0.0) {
+                h->active[t]++;
+                if (rate < h->col_min[c]) h->col_min[c] = rate;
+                if (rate > h->col_max[c]) h->col_max[c] = rate;
+            }
+        }
+    }
+    paint_all(h);
+    return a->count;
+}
+
+int heatmap_update_fleet(heatmap_t *h, const fleet_t *f, int metric){
+    if (!h || !f || f->n != h->threads) return 0;
+    if (metric == h->metric && f->version == h->seq) return 0;
+
+    // As amostras dos nós chegam fora de ordem e a qualquer momento; com no máximo
+    // FLEET_MAX_NODES linhas, reconstruir a imagem inteira a cada mudança é barato.
+    h->metric = metric;
+    h->unit_scale = 1.0;
+    h->seq = f->version;
+    for (int c = 0; c < h->len; c++) {
+        h->col_min[c] = DBL_MAX;
+        h->col_max[c] = 0.0;
+    }
+    for (int t = 0; t < h->threads; t++) {
+        const fleet_node_t *node = &f->nodes[t];
+        h->active[t] = 0;
+        for (int c = 0; c < h->len; c++) {
+            const fleet_sample_t *s = &node->ring[c];
+            int valid = s->seq > 0 && f->max_seq - s->seq < (unsigned long long)h->len;
+            double v = -1.0;
+            if (valid && metric == FLEET_METRIC_TEMP) v = s->temp_c > TEMP_UNAVAILABLE ? s->temp_c : -1.0;
+            else if (valid && metric >= 0 && metric < THREAD_METRIC_COUNT) v = s->rate[metric];
+            h->values[(size_t)t * h->len + c] = v;
+            if (v > 0.0) {
+                h->active[t]++;
+                if (v < h->col_min[c]) h->col_min[c] = v;
+                if (v > h->col_max[c]) h->col_max[c] = v;
+            }
+        }
+    }
+    paint_all(h);
+    return h->len;
+}
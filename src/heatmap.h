@@ -0,0 +1,91 @@
+#ifndef HEATMAP_H
+#define HEATMAP_H
+
+/**
+ * @file heatmap.h
+ * @brief Declara o cache incremental do heatmap de desempenho por thread.
+ *
+ * O heatmap é mantido como uma imagem RGB24 com um pixel por célula (linhas =
+ * threads, colunas = posições do buffer circular `thread_history`). A cada nova
+ * amostra apenas a coluna correspondente é recalculada e pintada; a imagem inteira
+ * só é repintada quando a escala de cores precisa mudar. A UI apenas amplia a
+ * imagem na tela, de modo que o custo de um redesenho não cresce com o número de
+ * threads nem com a duração do teste. A visão do teste inteiro usa a mesma imagem,
+ * preenchida com os buckets de `history.h`.
+ */
+
+#include "hardstress.h"
+
+/**
+ * @struct heatmap_t
+ * @brief Estado do heatmap incremental; usado apenas pela thread da UI.
+ */
+struct heatmap_t {
+    int threads;            ///< Número de linhas (threads).
+    int len;                ///< Número de colunas (amostras do histórico).
+    int metric;             ///< `thread_metric_t` exibido.
+    double unit_scale;      ///< Fator que converte contador/s para a unidade exibida.
+    unsigned long long seq; ///< Último `history_seq` incorporado.
+    double *values;         ///< Taxa de cada célula (`t * len + coluna`); negativa se não há dado.
+    double *col_min;        ///< Menor taxa positiva de cada coluna (`DBL_MAX` se nenhuma).
+    double *col_max;        ///< Maior taxa de cada coluna.
+    int *active;            ///< Quantas células com taxa positiva cada thread tem na janela.
+    double lo, hi;          ///< Escala de cores com que `pixels` foi pintado.
+    uint32_t *pixels;       ///< Imagem RGB24 (`0x00RRGGBB`), `threads` linhas de `len` pixels.
+    unsigned long long repaints; ///< Quantas vezes a imagem inteira foi repintada.
+};
+
+/**
+ * @brief Cria um heatmap vazio para `threads` x `len` células.
+ * @return O heatmap, ou NULL em caso de falha de alocação.
+ */
+heatmap_t *heatmap_create(int threads, int len);
+
+/**
+ * @brief Libera o heatmap; NULL é ignorado.
+ */
+void heatmap_free(heatmap_t *h);
+
+/**
+ * @brief Incorpora as amostras novas de `thread_history` ao heatmap.
+ *
+ * Deve ser chamada com `history_mutex` travado. Recalcula apenas as colunas cujas
+ * amostras chegaram desde a última chamada; se a métrica mudou, se o histórico foi
+ * reiniciado ou se a UI perdeu uma janela inteira, reconstrói todas as colunas.
+ *
+ * @param unit_scale Fator que converte a taxa do contador por segundo para a unidade exibida.
+ * @return O número de colunas recalculadas.
+ */
+int heatmap_update(heatmap_t *h, const AppContext *app, int metric, double unit_scale);
+
+/**
+ * @brief Reconstrói o heatmap a partir dos buckets do arquivo do teste inteiro.
+ *
+ * Deve ser chamada com `history_mutex` travado, com um heatmap de
+ * `HISTORY_ARCHIVE_BUCKETS` colunas; a coluna `i` é a taxa média do bucket `i` e as
+ * colunas além de `count` ficam vazias. Só recalcula quando o arquivo mudou.
+ *
+ * @return O número de colunas com dados recalculadas (0 se nada mudou).
+ */
+int heatmap_update_archive(heatmap_t *h, const history_archive_t *a, int metric, double unit_scale);
+
+/**
+ * @brief Reconstrói o heatmap da frota: uma linha por nó, uma coluna por amostra recente.
+ *
+ * Deve ser chamada com `history_mutex` travado, com um heatmap de `f->n` linhas e
+ * `HISTORY_SAMPLES` colunas; a coluna `i` é a amostra `seq % HISTORY_SAMPLES == i` de
+ * cada nó, vazia se for mais antiga que a janela de `f->max_seq`. As taxas já chegam
+ * na unidade exibida. Só recalcula quando a frota ou a métrica mudou.
+ *
+ * @param metric Um `thread_metric_t` ou `FLEET_METRIC_TEMP`.
+ * @return O número de colunas recalculadas (0 se nada mudou).
+ */
+int heatmap_update_fleet(heatmap_t *h, const fleet_t *f, int metric);
+
+/**
+ * @brief Converte um valor normalizado (0..1) na cor do heatmap (azul, amarelo, vermelho).
+ * @param rgb Recebe os componentes vermelho, verde e azul, em 0..1.
+ */
+void heatmap_color(double normalized, double rgb[3]);
+
+#endif // HEATMAP_H
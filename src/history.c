@@ -0,0 +1,105 @@
+#include "history.h"
+
+/* --- Static Function Prototypes --- */
+static history_bucket_t *bucket_at(const history_archive_t *a, int t, int i);
+static void merge_pairs(history_archive_t *a);
+
+history_archive_t *history_archive_create(int threads){
+    if (threads <= 0) return NULL;
+    history_archive_t *a = calloc(1, sizeof(*a));
+    if (!a) return NULL;
+    a->threads = threads;
+    a->width = 1;
+    a->base = calloc((size_t)threads, sizeof(thread_sample_t));
+    a->last = calloc((size_t)threads, sizeof(thread_sample_t));
+    a->buckets = calloc((size_t)threads * (HISTORY_ARCHIVE_BUCKETS + 1), sizeof(history_bucket_t));
+    if (!a->base || !a->last || !a->buckets) {
+        history_archive_free(a);
+        return NULL;
+    }
+    return a;
+}
+
+void history_archive_free(history_archive_t *a){
+    if (!a) return;
+    free(a->base);
+    free(a->last);
+    free(a->buckets);
+    free(a);
+}
+
+/**
+ * @brief Endereço do bucket `i` do worker `t`, incluindo o bucket aberto.
+ */
+static history_bucket_t *bucket_at(const history_archive_t *a, int t, int i){
+    return &a->buckets[(size_t)t * (HISTORY_ARCHIVE_BUCKETS + 1) + i];
+}
+
+const history_bucket_t *history_archive_bucket(const history_archive_t *a, int t, int i){
+    return bucket_at(a, t, i);
+}
+
+/**
+ * @brief Funde os buckets fechados dois a dois, dobrando a largura de cada um.
+ */
+static void merge_pairs(history_archive_t *a){
+    int half = a->count / 2;
+    for (int t = 0; t < a->threads; t++) {
+        for (int i = 0; i < half; i++) {
+            const history_bucket_t *x = bucket_at(a, t, 2 * i);
+            const history_bucket_t *y = bucket_at(a, t, 2 * i + 1);
+            history_bucket_t merged;
+            merged.end = y->end;
+            for (int m = 0; m < THREAD_METRIC_COUNT; m++) {
+                merged.min_rate[m] = x->min_rate[m] < y->min_rate[m] ? x->min_rate[m] : y->min_rate[m];
+                merged.max_rate[m] = x->max_rate[m] > y->max_rate[m] ? x->max_rate[m] : y->max_rate[m];
+            }
+            *bucket_at(a, t, i) = merged;
+        }
+    }
+    for (int i = 0; i < half; i++) a->end_time[i] = a->end_time[2 * i + 1];
+    a->count = half;
+    a->width *= 2;
+}
+
+void history_archive_push(history_archive_t *a, thread_sample_t *const *ring, int pos, double now){
+    if (!a || !ring) return;
+    if (a->start_time == 0.0) {
+        a->start_time = a->last_time = now;
+        for (int t = 0; t < a->threads; t++) a->base[t] = a->last[t] = ring[t][pos];
+        return;
+    }
+    double dt = now - a->last_time;
+    if (dt <= 0.0) return;
+
+    for (int t = 0; t < a->threads; t++) {
+        const thread_sample_t *cur = &ring[t][pos];
+        history_bucket_t *b = bucket_at(a, t, a->count);
+        for (int m = 0; m < THREAD_METRIC_COUNT; m++) {
+            unsigned long long prev = a->last[t].v[m];
+            float rate = (float)((double)(cur->v[m] > prev ? cur->v[m] - prev : 0) / dt);
+            if (a->pending == 0 || rate < b->min_rate[m]) b->min_rate[m] = rate;
+            if (a->pending == 0 || rate > b->max_rate[m]) b->max_rate[m] = rate;
+        }
+        b->end = *cur;
+        a->last[t] = *cur;
+    }
+    a->end_time[a->count] = now;
+    a->last_time = now;
+
+    if (++a->pending == a->width) {
+        a->pending = 0;
+        a->count++;
+        if (a->count == HISTORY_ARCHIVE_BUCKETS) merge_pairs(a);
+        a->version++;
+    }
+}
+
+double history_archive_avg(const history_archive_t *a, int t, int i, int metric){
+    const thread_sample_t *prev = i > 0 ? &bucket_at(a, t, i - 1)->end : &a->base[t];
+    double t0 = i > 0 ? a->end_time[i - 1] : a->start_time;
+    double dt = a->end_time[i] - t0;
+    unsigned long long cur = bucket_at(a, t, i)->end.v[metric];
+    unsigned long long old = prev->v[metric];
+    return dt > 0.0 && cur > old ? (double)(cur - old) / dt : 0.0;
+}
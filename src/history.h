@@ -0,0 +1,78 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+/**
+ * @file history.h
+ * @brief Declara o arquivo de longo prazo do histórico por thread.
+ *
+ * O histórico em resolução total (`thread_history`) cobre apenas a janela recente
+ * de `HISTORY_SAMPLES` amostras. Cada amostra também entra neste arquivo, que a
+ * agrega em buckets com a taxa mínima, máxima e média de cada contador. Quando os
+ * buckets se esgotam, pares vizinhos são fundidos e a largura de cada bucket dobra;
+ * assim a memória fica limitada a `HISTORY_ARCHIVE_BUCKETS` por thread qualquer que
+ * seja a duração, e o teste inteiro continua visível.
+ */
+
+#include "hardstress.h"
+
+/** @brief Número máximo de buckets por thread no arquivo (par, para permitir a fusão). */
+#define HISTORY_ARCHIVE_BUCKETS 240
+
+/**
+ * @struct history_bucket_t
+ * @brief Um intervalo agregado do histórico de um worker.
+ */
+typedef struct {
+    thread_sample_t end;                 ///< Contadores cumulativos no fim do bucket (a média sai da diferença).
+    float min_rate[THREAD_METRIC_COUNT]; ///< Menor taxa por segundo de uma amostra do bucket.
+    float max_rate[THREAD_METRIC_COUNT]; ///< Maior taxa por segundo de uma amostra do bucket.
+} history_bucket_t;
+
+/**
+ * @struct history_archive_t
+ * @brief Buckets de todos os workers, com resolução que diminui conforme o teste avança.
+ */
+struct history_archive_t {
+    int threads;              ///< Número de workers.
+    int count;                ///< Buckets fechados.
+    int width;                ///< Amostras por bucket (sempre uma potência de 2).
+    int pending;              ///< Amostras já somadas ao bucket aberto (índice `count`).
+    unsigned long long version; ///< Incrementado a cada bucket fechado ou fusão.
+    double start_time;        ///< Instante da primeira amostra (`now_sec`), ou 0 antes dela.
+    double last_time;         ///< Instante da última amostra.
+    double end_time[HISTORY_ARCHIVE_BUCKETS + 1]; ///< Instante do fim de cada bucket (inclui o aberto).
+    thread_sample_t *base;    ///< Contadores de cada worker na primeira amostra.
+    thread_sample_t *last;    ///< Contadores de cada worker na última amostra.
+    history_bucket_t *buckets; ///< `threads` x (`HISTORY_ARCHIVE_BUCKETS` + 1) buckets, por worker.
+};
+
+/**
+ * @brief Cria um arquivo vazio para `threads` workers.
+ * @return O arquivo, ou NULL em caso de falha de alocação.
+ */
+history_archive_t *history_archive_create(int threads);
+
+/**
+ * @brief Libera o arquivo; NULL é ignorado.
+ */
+void history_archive_free(history_archive_t *a);
+
+/**
+ * @brief Acrescenta a amostra `pos` do histórico recente ao arquivo.
+ *
+ * Deve ser chamada com `history_mutex` travado, logo após a amostra ser gravada.
+ * A primeira chamada apenas registra a referência; as seguintes somam uma taxa.
+ */
+void history_archive_push(history_archive_t *a, thread_sample_t *const *ring, int pos, double now);
+
+/**
+ * @brief Retorna o bucket `i` do worker `t` (0 <= i < `count`).
+ */
+const history_bucket_t *history_archive_bucket(const history_archive_t *a, int t, int i);
+
+/**
+ * @brief Taxa média por segundo do contador `metric` do worker `t` no bucket `i`.
+ */
+double history_archive_avg(const history_archive_t *a, int t, int i, int metric);
+
+#endif // HISTORY_H
@@ -0,0 +1,401 @@
+#include "hwmon.h"
+#include <ctype.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#endif
+
+/** @brief Maior índice `temp<I>_input` procurado em cada dispositivo hwmon. */
+#define HWMON_TEMP_INDEX_MAX 64
+/** @brief Número máximo de diretórios `hwmon<N>`/`thermal_zone<N>` considerados. */
+#define SYSFS_DIRS_MAX 256
+/** @brief Endereços dos MSRs IA32_MPERF e IA32_APERF. */
+#define MSR_MPERF 0xE7
+#define MSR_APERF 0xE8
+
+#ifndef _WIN32
+/* --- Static Function Prototypes --- */
+static int read_text(const char *path, char *buf, size_t len);
+static int list_indexed(const char *dir, const char *prefix, int *out, int max);
+static int cmp_int(const void *a, const void *b);
+static int is_cpu_driver(const char *name);
+static void add_sensor(temp_sensors_t *ts, const char *path, const char *label, int is_core);
+static void discover_hwmon(temp_sensors_t *ts, const char *root, int *cpu_driver_first);
+static void discover_thermal(temp_sensors_t *ts, const char *root);
+static int pread_ull(int fd, unsigned long long *out);
+static double read_khz_as_mhz(const char *path);
+static int open_msr(int cpu);
+
+/**
+ * @brief Lê um pequeno arquivo de texto do sysfs, sem o '\n' final.
+ * @return 0 em caso de sucesso, -1 em caso de falha.
+ */
+static int read_text(const char *path, char *buf, size_t len){
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char *ok = fgets(buf, (int)len, f);
+    fclose(f);
+    if (!ok) return -1;
+    buf[strcspn(buf, "\n")] = '\0';
+    return 0;
+}
+
+static int cmp_int(const void *a, const void *b){
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Lista os índices N das entradas `<prefix><N>` de `dir`, em ordem crescente.
+ * @return Quantos índices foram gravados em `out`.
+ */
+static int list_indexed(const char *dir, const char *prefix, int *out, int max){
+    DIR *d = opendir(dir);
+    if (!d) return 0;
+    size_t plen = strlen(prefix);
+    int n = 0;
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL && n < max) {
+        if (strncmp(de->d_name, prefix, plen) != 0 || !isdigit((unsigned char)de->d_name[plen])) continue;
+        out[n++] = atoi(de->d_name + plen);
+    }
+    closedir(d);
+    qsort(out, n, sizeof(int), cmp_int);
+    return n;
+}
+
+/**
+ * @brief Indica se um driver hwmon mede a temperatura da CPU.
+ */
+static int is_cpu_driver(const char *name){
+    static const char *drivers[] = { "coretemp", "k10temp", "zenpower", "cpu_thermal", "x86_pkg_temp" };
+    for (size_t i = 0; i < sizeof(drivers) / sizeof(drivers[0]); i++) {
+        if (strcmp(name, drivers[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Abre `path` e o acrescenta ao conjunto, se houver espaço.
+ */
+static void add_sensor(temp_sensors_t *ts, const char *path, const char *label, int is_core){
+    if (ts->count >= TEMP_SENSORS_MAX) return;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    temp_sensor_t *s = &ts->sensors[ts->count++];
+    s->fd = fd;
+    snprintf(s->label, sizeof(s->label), "%s", label);
+    s->is_core = is_core;
+    if (is_core) ts->core_count++;
+}
+
+/**
+ * @brief Descobre `class/hwmon/hwmon<N>/temp<I>_input` (ou em `device/`, em kernels antigos).
+ * @param cpu_driver_first Recebe o índice do primeiro sensor de um driver de CPU, se ainda for -1.
+ */
+static void discover_hwmon(temp_sensors_t *ts, const char *root, int *cpu_driver_first){
+    char dir[256], base[320], path[400], name[64], label[48], full[128];
+    int idx[SYSFS_DIRS_MAX];
+    snprintf(dir, sizeof(dir), "%s/class/hwmon", root);
+    int n = list_indexed(dir, "hwmon", idx, SYSFS_DIRS_MAX);
+    for (int h = 0; h < n; h++) {
+        snprintf(base, sizeof(base), "%s/hwmon%d", dir, idx[h]);
+        snprintf(path, sizeof(path), "%s/name", base);
+        if (read_text(path, name, sizeof(name)) != 0) {
+            strncat(base, "/device", sizeof(base) - strlen(base) - 1);
+            snprintf(path, sizeof(path), "%s/name", base);
+            if (read_text(path, name, sizeof(name)) != 0) snprintf(name, sizeof(name), "hwmon%d", idx[h]);
+        }
+        int cpu_driver = is_cpu_driver(name);
+        for (int i = 1; i <= HWMON_TEMP_INDEX_MAX; i++) {
+            snprintf(path, sizeof(path), "%s/temp%d_label", base, i);
+            if (read_text(path, label, sizeof(label)) != 0) snprintf(label, sizeof(label), "temp%d", i);
+            int is_core = strncmp(label, "Core ", 5) == 0;
+            // Núcleos mantêm o rótulo curto usado no painel; os demais levam o nome do driver.
+            if (is_core) snprintf(full, sizeof(full), "%s", label);
+            else snprintf(full, sizeof(full), "%s %s", name, label);
+
+            snprintf(path, sizeof(path), "%s/temp%d_input", base, i);
+            int before = ts->count;
+            add_sensor(ts, path, full, is_core);
+            if (ts->count > before && cpu_driver && *cpu_driver_first < 0) *cpu_driver_first = before;
+        }
+    }
+}
+
+/**
+ * @brief Descobre `class/thermal/thermal_zone<N>/temp`, rotulados pelo `type` da zona.
+ */
+static void discover_thermal(temp_sensors_t *ts, const char *root){
+    char dir[256], path[400], type[48];
+    int idx[SYSFS_DIRS_MAX];
+    snprintf(dir, sizeof(dir), "%s/class/thermal", root);
+    int n = list_indexed(dir, "thermal_zone", idx, SYSFS_DIRS_MAX);
+    for (int z = 0; z < n; z++) {
+        snprintf(path, sizeof(path), "%s/thermal_zone%d/type", dir, idx[z]);
+        if (read_text(path, type, sizeof(type)) != 0) snprintf(type, sizeof(type), "zona %d", idx[z]);
+        char label[64];
+        snprintf(label, sizeof(label), "thermal %s", type);
+        snprintf(path, sizeof(path), "%s/thermal_zone%d/temp", dir, idx[z]);
+        add_sensor(ts, path, label, 0);
+    }
+}
+
+temp_sensors_t *temp_sensors_open(const char *sysfs_root){
+    if (!sysfs_root) sysfs_root = "/sys";
+    temp_sensors_t *ts = calloc(1, sizeof(temp_sensors_t));
+    if (!ts) return NULL;
+    ts->sensors = calloc(TEMP_SENSORS_MAX, sizeof(temp_sensor_t));
+    ts->values = calloc(TEMP_SENSORS_MAX, sizeof(double));
+    if (!ts->sensors || !ts->values) {
+        temp_sensors_close(ts);
+        return NULL;
+    }
+
+    int cpu_driver_first = -1;
+    discover_hwmon(ts, sysfs_root, &cpu_driver_first);
+    discover_thermal(ts, sysfs_root);
+    if (ts->count == 0) {
+        temp_sensors_close(ts);
+        return NULL;
+    }
+
+    ts->primary = cpu_driver_first >= 0 ? cpu_driver_first : 0;
+    for (int i = 0; i < ts->count; i++) {
+        if (ts->sensors[i].is_core) { ts->primary = i; break; }
+    }
+    for (int i = 0; i < ts->count; i++) ts->values[i] = TEMP_UNAVAILABLE;
+    return ts;
+}
+
+int temp_sensors_read(temp_sensors_t *ts){
+    if (!ts) return 0;
+    int ok = 0;
+    for (int i = 0; i < ts->count; i++) {
+        char buf[32];
+        ssize_t n = pread(ts->sensors[i].fd, buf, sizeof(buf) - 1, 0);
+        char *end = buf;
+        long milli = 0;
+        if (n > 0) {
+            buf[n] = '\0';
+            milli = strtol(buf, &end, 10);
+        }
+        // O sysfs reporta milésimos de grau; alguns sensores falham com EAGAIN/ENODATA.
+        if (n > 0 && end != buf) {
+            ts->values[i] = milli / 1000.0;
+            ok++;
+        } else {
+            ts->values[i] = TEMP_UNAVAILABLE;
+        }
+    }
+    return ok;
+}
+
+void temp_sensors_close(temp_sensors_t *ts){
+    if (!ts) return;
+    if (ts->sensors) {
+        for (int i = 0; i < ts->count; i++) close(ts->sensors[i].fd);
+    }
+    free(ts->sensors);
+    free(ts->values);
+    free(ts);
+}
+
+/**
+ * @brief Lê um inteiro decimal de um descritor sysfs aberto, a partir do início.
+ * @return 0 em caso de sucesso, -1 em caso de falha.
+ */
+static int pread_ull(int fd, unsigned long long *out){
+    if (fd < 0) return -1;
+    char buf[32];
+    ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return -1;
+    buf[n] = '\0';
+    char *end = buf;
+    unsigned long long v = strtoull(buf, &end, 10);
+    if (end == buf) return -1;
+    *out = v;
+    return 0;
+}
+
+/**
+ * @brief Lê um arquivo cpufreq em kHz e o converte para MHz.
+ * @return O valor em MHz, ou 0 se o arquivo não existe ou é inválido.
+ */
+static double read_khz_as_mhz(const char *path){
+    char buf[32];
+    if (read_text(path, buf, sizeof(buf)) != 0) return 0.0;
+    char *end = buf;
+    unsigned long long khz = strtoull(buf, &end, 10);
+    return end == buf ? 0.0 : khz / 1000.0;
+}
+
+/**
+ * @brief Abre o MSR de uma CPU e confirma que APERF pode ser lido.
+ * @return O descritor, ou -1 se os MSRs não estão disponíveis (sem x86, sem módulo msr ou sem root).
+ */
+static int open_msr(int cpu){
+#if defined(__x86_64__) || defined(__i386__)
+    char path[64];
+    snprintf(path, sizeof(path), "/dev/cpu/%d/msr", cpu);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    uint64_t v;
+    if (pread(fd, &v, sizeof(v), MSR_APERF) != (ssize_t)sizeof(v)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+cpu_freq_t *cpu_freq_open(const char *sysfs_root, int cpu_count){
+    static const char *throttle_files[CPU_THROTTLE_FILES] = {
+        "core_throttle_count", "package_throttle_count", "core_power_limit_count", "package_power_limit_count"
+    };
+    int use_msr = sysfs_root == NULL;
+    if (!sysfs_root) sysfs_root = "/sys";
+    if (cpu_count <= 0) return NULL;
+    cpu_freq_t *cf = calloc(1, sizeof(cpu_freq_t));
+    if (!cf) return NULL;
+    cf->cpu_count = cpu_count;
+    cf->cpus = calloc(cpu_count, sizeof(cpu_freq_cpu_t));
+    cf->mhz = calloc(cpu_count, sizeof(double));
+    if (!cf->cpus || !cf->mhz) {
+        free(cf->cpus);
+        free(cf->mhz);
+        free(cf);
+        return NULL;
+    }
+
+    char base[300], path[400];
+    for (int c = 0; c < cpu_count; c++) {
+        cpu_freq_cpu_t *p = &cf->cpus[c];
+        snprintf(base, sizeof(base), "%s/devices/system/cpu/cpu%d", sysfs_root, c);
+
+        snprintf(path, sizeof(path), "%s/cpufreq/scaling_cur_freq", base);
+        p->cur_fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (p->cur_fd >= 0) cf->cur_count++;
+
+        snprintf(path, sizeof(path), "%s/cpufreq/cpuinfo_max_freq", base);
+        double max_mhz = read_khz_as_mhz(path);
+        if (max_mhz > cf->max_mhz) cf->max_mhz = max_mhz;
+        // base_frequency (intel_pstate) é o clock nominal; na falta dele, o máximo do cpufreq.
+        snprintf(path, sizeof(path), "%s/cpufreq/base_frequency", base);
+        p->base_mhz = read_khz_as_mhz(path);
+        if (p->base_mhz <= 0.0) p->base_mhz = max_mhz;
+
+        p->msr_fd = (use_msr && p->base_mhz > 0.0) ? open_msr(c) : -1;
+        if (p->msr_fd >= 0) cf->msr_count++;
+
+        int any_throttle = 0;
+        for (int t = 0; t < CPU_THROTTLE_FILES; t++) {
+            snprintf(path, sizeof(path), "%s/thermal_throttle/%s", base, throttle_files[t]);
+            p->throttle_fd[t] = open(path, O_RDONLY | O_CLOEXEC);
+            if (p->throttle_fd[t] >= 0) {
+                any_throttle = 1;
+                pread_ull(p->throttle_fd[t], &p->throttle_last[t]);
+            }
+        }
+        if (any_throttle) cf->throttle_count++;
+    }
+
+    if (cf->cur_count == 0 && cf->msr_count == 0 && cf->throttle_count == 0) {
+        cpu_freq_close(cf);
+        return NULL;
+    }
+    return cf;
+}
+
+int cpu_freq_read(cpu_freq_t *cf){
+    if (!cf) return 0;
+    int known = 0;
+    cf->thermal_cpus = 0;
+    cf->power_cpus = 0;
+    for (int c = 0; c < cf->cpu_count; c++) {
+        cpu_freq_cpu_t *p = &cf->cpus[c];
+        double mhz = 0.0;
+        if (p->msr_fd >= 0) {
+            uint64_t aperf, mperf;
+            if (pread(p->msr_fd, &aperf, sizeof(aperf), MSR_APERF) == (ssize_t)sizeof(aperf) &&
+                pread(p->msr_fd, &mperf, sizeof(mperf), MSR_MPERF) == (ssize_t)sizeof(mperf)) {
+                uint64_t da = aperf - p->aperf, dm = mperf - p->mperf;
+                if (p->mperf != 0 && dm > 0) mhz = p->base_mhz * (double)da / (double)dm;
+                p->aperf = aperf;
+                p->mperf = mperf;
+            }
+        }
+        // Sem MSR, ou na primeira leitura (ainda sem delta), usa o valor do cpufreq.
+        unsigned long long khz;
+        if (mhz <= 0.0 && pread_ull(p->cur_fd, &khz) == 0) mhz = khz / 1000.0;
+        cf->mhz[c] = mhz;
+        if (mhz > 0.0) known++;
+
+        int advanced[CPU_THROTTLE_FILES] = {0};
+        for (int t = 0; t < CPU_THROTTLE_FILES; t++) {
+            unsigned long long v;
+            if (pread_ull(p->throttle_fd[t], &v) != 0) continue;
+            advanced[t] = v != p->throttle_last[t];
+            p->throttle_last[t] = v;
+        }
+        if (advanced[0] || advanced[1]) cf->thermal_cpus++;
+        if (advanced[2] || advanced[3]) cf->power_cpus++;
+    }
+    return known;
+}
+
+void cpu_freq_close(cpu_freq_t *cf){
+    if (!cf) return;
+    if (cf->cpus) {
+        for (int c = 0; c < cf->cpu_count; c++) {
+            cpu_freq_cpu_t *p = &cf->cpus[c];
+            if (p->cur_fd >= 0) close(p->cur_fd);
+            if (p->msr_fd >= 0) close(p->msr_fd);
+            for (int t = 0; t < CPU_THROTTLE_FILES; t++) {
+                if (p->throttle_fd[t] >= 0) close(p->throttle_fd[t]);
+            }
+        }
+    }
+    free(cf->cpus);
+    free(cf->mhz);
+    free(cf);
+}
+
+#else /* --- WINDOWS IMPLEMENTATION --- */
+
+// No Windows a temperatura vem do WMI (ver metrics.c); não há sysfs a descobrir.
+temp_sensors_t *temp_sensors_open(const char *sysfs_root){
+    (void)sysfs_root;
+    return NULL;
+}
+
+int temp_sensors_read(temp_sensors_t *ts){
+    (void)ts;
+    return 0;
+}
+
+void temp_sensors_close(temp_sensors_t *ts){
+    (void)ts;
+}
+
+// A frequência por CPU não é amostrada no Windows.
+cpu_freq_t *cpu_freq_open(const char *sysfs_root, int cpu_count){
+    (void)sysfs_root;
+    (void)cpu_count;
+    return NULL;
+}
+
+int cpu_freq_read(cpu_freq_t *cf){
+    (void)cf;
+    return 0;
+}
+
+void cpu_freq_close(cpu_freq_t *cf){
+    (void)cf;
+}
+
+#endif
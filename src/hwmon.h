@@ -0,0 +1,130 @@
+#ifndef HWMON_H
+#define HWMON_H
+
+/**
+ * @file hwmon.h
+ * @brief Declara a leitura direta dos sensores de temperatura do kernel (hwmon e thermal).
+ *
+ * Os sensores são descobertos uma única vez em `/sys/class/hwmon/hwmon<N>/temp<I>_input`
+ * e `/sys/class/thermal/thermal_zone<N>/temp`; os descritores ficam abertos e cada
+ * amostra é um `pread` por sensor em arrays pré-alocados. Assim a amostragem não
+ * aloca memória nem cria processos nos núcleos sob estresse, e não depende do
+ * lm-sensors. No Windows a descoberta não encontra sensores.
+ *
+ * O mesmo esquema vale para o clock de cada CPU lógica: o MHz efetivo vem de
+ * APERF/MPERF (`/dev/cpu/<N>/msr`) quando o módulo msr está acessível, ou de
+ * `cpufreq/scaling_cur_freq`; os contadores `thermal_throttle/` indicam quais CPUs
+ * sofreram limitação térmica ou de potência no intervalo.
+ */
+
+#include "hardstress.h"
+
+/** @brief Número máximo de sensores de temperatura acompanhados. */
+#define TEMP_SENSORS_MAX 128
+
+/**
+ * @struct temp_sensor_t
+ * @brief Um arquivo de temperatura do sysfs mantido aberto.
+ */
+typedef struct {
+    int fd;                 ///< Descritor aberto do arquivo `*_input`/`temp`.
+    char label[128];        ///< Rótulo legível (por exemplo, "Core 0" ou "coretemp Package id 0").
+    int is_core;            ///< Não-zero se o sensor mede um núcleo físico ("Core N").
+} temp_sensor_t;
+
+/**
+ * @struct temp_sensors_t
+ * @brief O conjunto de sensores descobertos e suas últimas leituras.
+ */
+typedef struct {
+    int count;              ///< Número de sensores em `sensors`/`values`.
+    int core_count;         ///< Quantos sensores têm `is_core`.
+    int primary;            ///< Índice do sensor usado como temperatura da CPU, ou -1.
+    temp_sensor_t *sensors; ///< Os sensores, na ordem de descoberta.
+    double *values;         ///< Última leitura de cada sensor em °C (`TEMP_UNAVAILABLE` se a leitura falhou).
+} temp_sensors_t;
+
+/**
+ * @brief Descobre os sensores de temperatura e abre seus arquivos.
+ *
+ * A temperatura principal é o primeiro sensor de núcleo; na falta dele, o primeiro
+ * sensor de um driver de CPU conhecido (coretemp, k10temp, ...) e, por fim, o
+ * primeiro sensor encontrado.
+ *
+ * @param sysfs_root A raiz do sysfs, ou NULL para "/sys" (outro valor é útil em testes).
+ * @return O conjunto de sensores, ou NULL se nenhum sensor foi encontrado.
+ */
+temp_sensors_t *temp_sensors_open(const char *sysfs_root);
+
+/**
+ * @brief Lê todos os sensores com `pread`, sem alocar memória.
+ * @return O número de sensores lidos com sucesso.
+ */
+int temp_sensors_read(temp_sensors_t *ts);
+
+/**
+ * @brief Fecha os descritores e libera o conjunto de sensores.
+ */
+void temp_sensors_close(temp_sensors_t *ts);
+
+/** @brief Arquivos `thermal_throttle/` acompanhados por CPU (núcleo/pacote x térmico/potência). */
+#define CPU_THROTTLE_FILES 4
+
+/**
+ * @struct cpu_freq_cpu_t
+ * @brief Os descritores abertos e as últimas leituras brutas de uma CPU lógica.
+ */
+typedef struct {
+    int cur_fd;             ///< `cpufreq/scaling_cur_freq` (kHz), ou -1.
+    int msr_fd;             ///< `/dev/cpu/<N>/msr`, ou -1 se APERF/MPERF não está acessível.
+    int throttle_fd[CPU_THROTTLE_FILES]; ///< `thermal_throttle/{core,package}_{throttle,power_limit}_count`, ou -1.
+    double base_mhz;        ///< Frequência nominal que escala a razão APERF/MPERF.
+    uint64_t aperf, mperf;  ///< Última leitura de APERF/MPERF (0 = ainda sem leitura).
+    unsigned long long throttle_last[CPU_THROTTLE_FILES]; ///< Última leitura de cada contador.
+} cpu_freq_cpu_t;
+
+/**
+ * @struct cpu_freq_t
+ * @brief O leitor de frequência e de limitação das CPUs e suas últimas leituras.
+ */
+typedef struct {
+    int cpu_count;          ///< Número de CPUs em `cpus`/`mhz`.
+    int msr_count;          ///< Quantas CPUs usam APERF/MPERF.
+    int cur_count;          ///< Quantas CPUs têm `scaling_cur_freq`.
+    int throttle_count;     ///< Quantas CPUs têm contadores `thermal_throttle/`.
+    double max_mhz;         ///< Maior `cpuinfo_max_freq` encontrado, em MHz (0 se desconhecido).
+    cpu_freq_cpu_t *cpus;   ///< Estado por CPU.
+    double *mhz;            ///< Último MHz efetivo de cada CPU (0 = indisponível).
+    int thermal_cpus;       ///< CPUs cujos contadores de limitação térmica avançaram na última leitura.
+    int power_cpus;         ///< CPUs cujos contadores de limite de potência avançaram na última leitura.
+} cpu_freq_t;
+
+/**
+ * @brief Abre os arquivos de frequência e de limitação de `cpu_count` CPUs.
+ *
+ * APERF/MPERF exige o módulo `msr` e permissão de leitura em `/dev/cpu/<N>/msr`
+ * (normalmente root); sem isso, cada CPU recai em `scaling_cur_freq`, que é o
+ * pedido do governador e não o clock efetivo.
+ *
+ * @param sysfs_root A raiz do sysfs, ou NULL para "/sys". Com outra raiz os MSRs não são abertos.
+ * @param cpu_count O número de CPUs lógicas.
+ * @return O leitor, ou NULL se nenhuma CPU expõe frequência nem contadores de limitação.
+ */
+cpu_freq_t *cpu_freq_open(const char *sysfs_root, int cpu_count);
+
+/**
+ * @brief Atualiza `mhz`, `thermal_cpus` e `power_cpus` com `pread`, sem alocar memória.
+ *
+ * Com APERF/MPERF, o MHz é a média do intervalo desde a leitura anterior
+ * (`base_mhz * ΔAPERF / ΔMPERF`), contada apenas enquanto a CPU não está ociosa.
+ *
+ * @return O número de CPUs com frequência conhecida.
+ */
+int cpu_freq_read(cpu_freq_t *cf);
+
+/**
+ * @brief Fecha os descritores e libera o leitor.
+ */
+void cpu_freq_close(cpu_freq_t *cf);
+
+#endif // HWMON_H
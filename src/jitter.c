@@ -0,0 +1,146 @@
+#include "jitter.h"
+#include "utils.h"   // Para now_sec, ticker_t, aligned_calloc e as threads
+
+/* --- Static Function Prototypes --- */
+static thread_return_t THREAD_CALL probe_main(void *arg);
+static void fill_stats(jitter_stats_t *st, const unsigned long long *hist, double max_ns);
+
+/* --- Sondas --- */
+
+jitter_t *jitter_create(const int *cpus, int n, int interval_us, atomic_int *running){
+    if (!cpus || n < 1 || n > JITTER_MAX_CPUS ||
+        interval_us < JITTER_MIN_INTERVAL_US || interval_us > JITTER_MAX_INTERVAL_US) return NULL;
+    jitter_t *j = calloc(1, sizeof(*j));
+    if (!j) return NULL;
+    j->probes = aligned_calloc((size_t)n, sizeof(jitter_probe_t), WORKER_ALIGN);
+    if (!j->probes) {
+        free(j);
+        return NULL;
+    }
+    j->n = n;
+    j->interval = interval_us * 1e-6;
+    j->running = running;
+    for (int i = 0; i < n; i++) {
+        j->probes[i].cpu = cpus[i];
+        j->probes[i].owner = j;
+    }
+    return j;
+}
+
+int jitter_start(jitter_t *j){
+    int started = 0;
+    for (int i = 0; j && i < j->n; i++) {
+        if (thread_create(&j->probes[i].thread, probe_main, &j->probes[i]) != 0) continue;
+        j->probes[i].started = 1;
+        started++;
+    }
+    return started;
+}
+
+void jitter_join(jitter_t *j){
+    for (int i = 0; j && i < j->n; i++) {
+        if (!j->probes[i].started) continue;
+        thread_join(j->probes[i].thread);
+        j->probes[i].started = 0;
+    }
+}
+
+void jitter_destroy(jitter_t *j){
+    if (!j) return;
+    aligned_free(j->probes);
+    free(j);
+}
+
+/**
+ * @brief Thread de uma sonda: fixa-se na CPU, pede tempo real e mede cada despertar.
+ *
+ * O `ticker_t` dorme até prazos absolutos, então o atraso de um despertar não
+ * desloca os seguintes; prazos perdidos por um atraso maior que o intervalo são
+ * descartados, e o atraso medido é o do prazo original.
+ */
+static thread_return_t THREAD_CALL probe_main(void *arg){
+    jitter_probe_t *p = (jitter_probe_t*)arg;
+    jitter_t *j = p->owner;
+    atomic_store(&p->pinned, thread_pin_self(p->cpu) == 0 ? 1 : 0);
+    atomic_store(&p->realtime, thread_set_realtime() == 0 ? 1 : 0);
+
+    ticker_t t;
+    ticker_start(&t, j->interval);
+    unsigned long long wakeups = 0, max_ns = 0;
+    while (atomic_load_explicit(j->running, memory_order_relaxed)) {
+        double deadline = t.next;
+        ticker_wait(&t);
+        double late = (now_sec() - deadline) * 1e9;
+        unsigned long long ns = late > 0.0 ? (unsigned long long)late : 0;
+        lat_hist_record(p->hist, ns);
+        if (ns > max_ns) {
+            max_ns = ns;
+            atomic_store_explicit(&p->max_ns, ns, memory_order_relaxed);
+        }
+        atomic_store_explicit(&p->wakeups, ++wakeups, memory_order_relaxed);
+    }
+    ticker_stop(&t);
+    return 0;
+}
+
+/* --- Resultados --- */
+
+jitter_result_t *jitter_result_create(const jitter_t *j){
+    if (!j) return NULL;
+    jitter_result_t *r = calloc(1, sizeof(*r) + (size_t)j->n * sizeof(jitter_stats_t));
+    if (!r) return NULL;
+    r->n = j->n;
+    r->interval_us = j->interval * 1e6;
+    r->all.cpu = -1;
+    for (int i = 0; i < j->n; i++) r->cpu[i].cpu = j->probes[i].cpu;
+    return r;
+}
+
+/**
+ * @brief Preenche os percentis de `st` a partir de um histograma; `max_ns` <= 0 usa o maior bucket.
+ */
+static void fill_stats(jitter_stats_t *st, const unsigned long long *hist, double max_ns){
+    st->wakeups = 0;
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++) st->wakeups += hist[i];
+    st->p50_us = lat_hist_percentile(hist, 50.0) / 1e3;
+    st->p99_us = lat_hist_percentile(hist, 99.0) / 1e3;
+    st->p999_us = lat_hist_percentile(hist, 99.9) / 1e3;
+    st->max_us = (max_ns > 0.0 ? max_ns : lat_hist_max(hist)) / 1e3;
+}
+
+void jitter_sample(jitter_t *j, jitter_result_t *r){
+    if (!j || !r || r->n != j->n) return;
+    memset(j->merged, 0, sizeof(j->merged));
+    int realtime = 0;
+    for (int i = 0; i < j->n; i++) {
+        jitter_probe_t *p = &j->probes[i];
+        lat_hist_delta(p->hist, p->hist_last, p->hist_interval);
+        for (int b = 0; b < LAT_HIST_BUCKETS; b++) j->merged[b] += p->hist_interval[b];
+        // O máximo do intervalo é o limite do maior bucket; o exato só existe para o teste inteiro.
+        fill_stats(&r->cpu[i], p->hist_interval, 0.0);
+        realtime += atomic_load(&p->realtime);
+    }
+    fill_stats(&r->all, j->merged, 0.0);
+    r->realtime = realtime;
+}
+
+void jitter_totals(jitter_t *j, jitter_result_t *r){
+    if (!j || !r || r->n != j->n) return;
+    memset(j->merged, 0, sizeof(j->merged));
+    unsigned long long hist[LAT_HIST_BUCKETS];
+    double worst = 0.0;
+    int realtime = 0;
+    for (int i = 0; i < j->n; i++) {
+        jitter_probe_t *p = &j->probes[i];
+        for (int b = 0; b < LAT_HIST_BUCKETS; b++) {
+            hist[b] = atomic_load(&p->hist[b]);
+            j->merged[b] += hist[b];
+        }
+        double max_ns = (double)atomic_load(&p->max_ns);
+        if (max_ns > worst) worst = max_ns;
+        fill_stats(&r->cpu[i], hist, max_ns);
+        realtime += atomic_load(&p->realtime);
+    }
+    fill_stats(&r->all, j->merged, worst);
+    r->realtime = realtime;
+}
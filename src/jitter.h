@@ -0,0 +1,125 @@
+#ifndef JITTER_H
+#define JITTER_H
+
+/**
+ * @file jitter.h
+ * @brief Declara a sonda de latência de escalonamento (jitter), no estilo do cyclictest.
+ *
+ * Os kernels medem vazão; serviços sensíveis à latência se importam com quanto
+ * tempo uma thread leva para voltar a rodar depois que o seu timer dispara. A
+ * sonda põe em cada CPU uma thread fixada, com prioridade de tempo real, que
+ * dorme até prazos absolutos espaçados de `interval` e mede o atraso de cada
+ * despertar (o instante em que voltou a rodar menos o prazo). Os atrasos vão
+ * para um histograma log-linear por CPU (`lathist.h`), escrito sem travas pela
+ * própria sonda; o amostrador calcula p50/p99/p99.9/máximo de cada intervalo.
+ */
+
+#include "hardstress.h"
+#include "lathist.h"
+
+/** @brief Intervalo padrão entre despertares, em µs (o padrão do cyclictest). */
+#define JITTER_DEFAULT_INTERVAL_US 1000
+/** @brief Menor intervalo aceito, em µs. */
+#define JITTER_MIN_INTERVAL_US 100
+/** @brief Maior intervalo aceito, em µs. */
+#define JITTER_MAX_INTERVAL_US 100000
+/** @brief Máximo de CPUs sondadas. */
+#define JITTER_MAX_CPUS 1024
+
+/**
+ * @struct jitter_stats_t
+ * @brief Latência de despertar de uma CPU (ou de todas) em um intervalo ou no teste inteiro.
+ */
+typedef struct {
+    int cpu;                ///< CPU lógica sondada (-1 = todas).
+    unsigned long long wakeups; ///< Despertares medidos.
+    double p50_us, p99_us, p999_us; ///< Percentis do atraso de despertar, em µs (0 sem despertares).
+    double max_us;          ///< Maior atraso, em µs.
+} jitter_stats_t;
+
+/**
+ * @struct jitter_result_t
+ * @brief Resultado publicado para a GUI e a exportação (protegido por `history_mutex` em `AppContext`).
+ */
+struct jitter_result_t {
+    int n;                  ///< CPUs sondadas.
+    int realtime;           ///< Sondas que obtiveram prioridade de tempo real.
+    double interval_us;     ///< Intervalo entre despertares, em µs.
+    jitter_stats_t all;     ///< Todas as CPUs juntas.
+    jitter_stats_t cpu[];   ///< Uma entrada por CPU sondada.
+};
+
+/**
+ * @struct jitter_probe_t
+ * @brief Estado de uma sonda.
+ */
+typedef struct {
+    int cpu;                ///< CPU em que a sonda é fixada.
+    struct jitter_t *owner; ///< Conjunto a que a sonda pertence.
+    thread_handle_t thread; ///< Thread da sonda.
+    int started;            ///< 1 depois que a thread foi criada.
+    atomic_int pinned;      ///< 1 se a fixação na CPU funcionou (publicado pela sonda).
+    atomic_int realtime;    ///< 1 se a prioridade de tempo real foi concedida (idem).
+
+    /* --- Estado quente (escrito apenas pela sonda) --- */
+    _Alignas(WORKER_ALIGN) atomic_ullong wakeups; ///< Despertares medidos.
+    atomic_ullong max_ns;   ///< Maior atraso exato, em ns.
+    atomic_ullong hist[LAT_HIST_BUCKETS]; ///< Atrasos por bucket de `lat_hist_index`.
+
+    /* --- Uso exclusivo do amostrador --- */
+    unsigned long long hist_last[LAT_HIST_BUCKETS]; ///< Histograma na amostra anterior.
+    unsigned long long hist_interval[LAT_HIST_BUCKETS]; ///< Rascunho: histograma do último intervalo.
+} jitter_probe_t;
+
+/**
+ * @struct jitter_t
+ * @brief Conjunto de sondas, uma por CPU.
+ */
+struct jitter_t {
+    int n;                  ///< Sondas.
+    double interval;        ///< Intervalo entre despertares, em segundos.
+    atomic_int *running;    ///< Flag de execução do teste, observada pelas sondas.
+    jitter_probe_t *probes; ///< `n` sondas, alinhadas a `WORKER_ALIGN`.
+    unsigned long long merged[LAT_HIST_BUCKETS]; ///< Rascunho do amostrador: soma dos histogramas.
+};
+
+/**
+ * @brief Prepara uma sonda por CPU de `cpus`, sem iniciá-las.
+ * @param interval_us Intervalo entre despertares, em µs.
+ * @param running As sondas param quando zerado.
+ * @return O conjunto, ou NULL se os parâmetros forem inválidos ou faltar memória.
+ */
+jitter_t *jitter_create(const int *cpus, int n, int interval_us, atomic_int *running);
+
+/**
+ * @brief Inicia as threads das sondas.
+ * @return O número de sondas iniciadas.
+ */
+int jitter_start(jitter_t *j);
+
+/**
+ * @brief Espera as sondas terminarem; cada uma sai no primeiro despertar depois que `running` é zerado.
+ */
+void jitter_join(jitter_t *j);
+
+/**
+ * @brief Libera o conjunto (depois de `jitter_join`).
+ */
+void jitter_destroy(jitter_t *j);
+
+/**
+ * @brief Aloca um resultado com uma entrada por sonda de `j`, zerado.
+ */
+jitter_result_t *jitter_result_create(const jitter_t *j);
+
+/**
+ * @brief Grava em `r` a latência de cada CPU desde a chamada anterior. Uso exclusivo do amostrador.
+ */
+void jitter_sample(jitter_t *j, jitter_result_t *r);
+
+/**
+ * @brief Grava em `r` a latência do teste inteiro. Deve ser chamada depois de `jitter_join`.
+ */
+void jitter_totals(jitter_t *j, jitter_result_t *r);
+
+#endif // JITTER_H
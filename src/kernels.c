@@ -0,0 +1,546 @@
+#include "kernels.h"
+#include "utils.h"
+#include <stdlib.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FP_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define FP_HAVE_NEON 1
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+/*
+ * Cada cadeia faz `a = a * FP_MUL + FP_ADD`, cujo ponto fixo é FP_ADD / (1 - FP_MUL) = 1.0.
+ * Partindo de valores próximos de 1.0 os acumuladores nunca crescem nem viram
+ * denormais, então a vazão medida é a da unidade de FMA e não a de um caso lento.
+ */
+#define FP_MUL 0.9999999
+#define FP_ADD 1e-7
+#define FP_BLOCK_MUL 0.5
+
+/** @brief Expande `X(i)` para cada uma das `FP_CHAINS` cadeias, mantendo-as em registradores. */
+#define FP_EACH_CHAIN(X) X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11)
+
+_Static_assert(FP_CHAINS == 12, "FP_EACH_CHAIN deve expandir exatamente FP_CHAINS cadeias");
+_Static_assert(STREAM_OP_COUNT == STREAM_OPS, "STREAM_OPS deve acompanhar stream_op_t");
+
+/* --- Static Function Prototypes --- */
+static inline uint64_t mix64(uint64_t x);
+static int isa_supported(int isa);
+static uint64_t chain_scalar(double *s);
+static uint64_t block_scalar(const double *x, double *y, size_t n, int passes);
+#ifdef FP_HAVE_X86
+static uint64_t chain_sse2(double *s);
+static uint64_t block_sse2(const double *x, double *y, size_t n, int passes);
+static uint64_t chain_avx2(double *s);
+static uint64_t block_avx2(const double *x, double *y, size_t n, int passes);
+static uint64_t chain_avx512(double *s);
+static uint64_t block_avx512(const double *x, double *y, size_t n, int passes);
+#endif
+#ifdef FP_HAVE_NEON
+static uint64_t chain_neon(double *s);
+static uint64_t block_neon(const double *x, double *y, size_t n, int passes);
+#endif
+static void stream_regular(int op, double *a, double *b, double *c, size_t n, size_t pf);
+#ifdef FP_HAVE_X86
+static void stream_nt(int op, double *a, double *b, double *c, size_t n, size_t pf);
+#endif
+static inline uint64_t splitmix_at(uint64_t seed, uint64_t i);
+static void fill_u64_scalar(uint64_t *dst, size_t n, uint64_t seed, uint64_t first);
+#ifdef FP_HAVE_X86
+static void fill_u64_avx512(uint64_t *dst, size_t n, uint64_t seed, uint64_t first);
+#endif
+static int perm_blocked(uint32_t *perm, size_t n, uint64_t *seed);
+
+/** @brief Implementações compiladas, da menos para a mais capaz. */
+static const fp_engine_t g_fp_engines[] = {
+    { FP_ISA_SCALAR, "escalar",  1, chain_scalar, block_scalar },
+#ifdef FP_HAVE_X86
+    { FP_ISA_SSE2,   "SSE2",     2, chain_sse2,   block_sse2   },
+    { FP_ISA_AVX2,   "AVX2+FMA", 4, chain_avx2,   block_avx2   },
+    { FP_ISA_AVX512, "AVX-512F", 8, chain_avx512, block_avx512 },
+#endif
+#ifdef FP_HAVE_NEON
+    { FP_ISA_NEON,   "NEON",     2, chain_neon,   block_neon   },
+#endif
+};
+#define FP_ENGINE_COUNT (sizeof(g_fp_engines) / sizeof(g_fp_engines[0]))
+
+/* --- Seleção em Tempo de Execução --- */
+
+/**
+ * @brief Verifica se a CPU (e o SO, para o estado estendido dos registradores) suporta `isa`.
+ *
+ * `__builtin_cpu_supports` consulta o CPUID e o XCR0, de modo que AVX/AVX-512
+ * só são relatados quando o SO salva os registradores correspondentes.
+ */
+static int isa_supported(int isa){
+    switch (isa) {
+        case FP_ISA_SCALAR: return 1;
+#ifdef FP_HAVE_X86
+        case FP_ISA_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case FP_ISA_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case FP_ISA_AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+#ifdef FP_HAVE_NEON
+        case FP_ISA_NEON:
+#if defined(__linux__) && defined(HWCAP_ASIMD)
+            return (getauxval(AT_HWCAP) & HWCAP_ASIMD) != 0;
+#else
+            return 1; // ASIMD é obrigatório no AArch64
+#endif
+#endif
+        default: return 0;
+    }
+}
+
+const fp_engine_t *fp_engine_get(int isa){
+    for (size_t i = 0; i < FP_ENGINE_COUNT; i++) {
+        if (g_fp_engines[i].isa == isa) return isa_supported(isa) ? &g_fp_engines[i] : NULL;
+    }
+    return NULL;
+}
+
+const fp_engine_t *fp_engine_select(void){
+    const fp_engine_t *best = &g_fp_engines[0];
+    for (size_t i = 1; i < FP_ENGINE_COUNT; i++) {
+        if (isa_supported(g_fp_engines[i].isa)) best = &g_fp_engines[i];
+    }
+    return best;
+}
+
+void fp_state_init(double *state){
+    for (int i = 0; i < FP_CHAINS * 8; i++) state[i] = 1.0 + (i + 1) * 1e-3;
+}
+
+/* --- Motor de Ponto Flutuante: Escalar --- */
+
+static uint64_t chain_scalar(double *s){
+    const double m = FP_MUL, c = FP_ADD;
+#define X(i) double a##i = s[i];
+    FP_EACH_CHAIN(X)
+#undef X
+    for (uint32_t r = 0; r < FP_CHAIN_REPS; r++) {
+#define X(i) a##i = a##i * m + c;
+        FP_EACH_CHAIN(X)
+#undef X
+    }
+#define X(i) s[i] = a##i;
+    FP_EACH_CHAIN(X)
+#undef X
+    return (uint64_t)FP_CHAIN_REPS * FP_CHAINS * 2;
+}
+
+static uint64_t block_scalar(const double *x, double *y, size_t n, int passes){
+    for (int p = 0; p < passes; p++) {
+        for (size_t i = 0; i < n; i++) y[i] = y[i] * FP_BLOCK_MUL + x[i];
+    }
+    return (uint64_t)passes * n * 2;
+}
+
+#ifdef FP_HAVE_X86
+/* --- Motor de Ponto Flutuante: SSE2 --- */
+
+__attribute__((target("sse2")))
+static uint64_t chain_sse2(double *s){
+    const __m128d m = _mm_set1_pd(FP_MUL), c = _mm_set1_pd(FP_ADD);
+#define X(i) __m128d a##i = _mm_loadu_pd(s + 2 * i);
+    FP_EACH_CHAIN(X)
+#undef X
+    for (uint32_t r = 0; r < FP_CHAIN_REPS; r++) {
+#define X(i) a##i = _mm_add_pd(_mm_mul_pd(a##i, m), c);
+        FP_EACH_CHAIN(X)
+#undef X
+    }
+#define X(i) _mm_storeu_pd(s + 2 * i, a##i);
+    FP_EACH_CHAIN(X)
+#undef X
+    return (uint64_t)FP_CHAIN_REPS * FP_CHAINS * 2 * 2;
+}
+
+__attribute__((target("sse2")))
+static uint64_t block_sse2(const double *x, double *y, size_t n, int passes){
+    const __m128d m = _mm_set1_pd(FP_BLOCK_MUL);
+    for (int p = 0; p < passes; p++) {
+        for (size_t i = 0; i < n; i += 2) {
+            __m128d v = _mm_load_pd(y + i);
+            _mm_store_pd(y + i, _mm_add_pd(_mm_mul_pd(v, m), _mm_load_pd(x + i)));
+        }
+    }
+    return (uint64_t)passes * n * 2;
+}
+
+/* --- Motor de Ponto Flutuante: AVX2 + FMA --- */
+
+__attribute__((target("avx2,fma")))
+static uint64_t chain_avx2(double *s){
+    const __m256d m = _mm256_set1_pd(FP_MUL), c = _mm256_set1_pd(FP_ADD);
+#define X(i) __m256d a##i = _mm256_loadu_pd(s + 4 * i);
+    FP_EACH_CHAIN(X)
+#undef X
+    for (uint32_t r = 0; r < FP_CHAIN_REPS; r++) {
+#define X(i) a##i = _mm256_fmadd_pd(a##i, m, c);
+        FP_EACH_CHAIN(X)
+#undef X
+    }
+#define X(i) _mm256_storeu_pd(s + 4 * i, a##i);
+    FP_EACH_CHAIN(X)
+#undef X
+    _mm256_zeroupper();
+    return (uint64_t)FP_CHAIN_REPS * FP_CHAINS * 4 * 2;
+}
+
+__attribute__((target("avx2,fma")))
+static uint64_t block_avx2(const double *x, double *y, size_t n, int passes){
+    const __m256d m = _mm256_set1_pd(FP_BLOCK_MUL);
+    for (int p = 0; p < passes; p++) {
+        for (size_t i = 0; i < n; i += 4) {
+            _mm256_store_pd(y + i, _mm256_fmadd_pd(_mm256_load_pd(y + i), m, _mm256_load_pd(x + i)));
+        }
+    }
+    _mm256_zeroupper();
+    return (uint64_t)passes * n * 2;
+}
+
+/* --- Motor de Ponto Flutuante: AVX-512F --- */
+
+__attribute__((target("avx512f")))
+static uint64_t chain_avx512(double *s){
+    const __m512d m = _mm512_set1_pd(FP_MUL), c = _mm512_set1_pd(FP_ADD);
+#define X(i) __m512d a##i = _mm512_loadu_pd(s + 8 * i);
+    FP_EACH_CHAIN(X)
+#undef X
+    for (uint32_t r = 0; r < FP_CHAIN_REPS; r++) {
+#define X(i) a##i = _mm512_fmadd_pd(a##i, m, c);
+        FP_EACH_CHAIN(X)
+#undef X
+    }
+#define X(i) _mm512_storeu_pd(s + 8 * i, a##i);
+    FP_EACH_CHAIN(X)
+#undef X
+    _mm256_zeroupper();
+    return (uint64_t)FP_CHAIN_REPS * FP_CHAINS * 8 * 2;
+}
+
+__attribute__((target("avx512f")))
+static uint64_t block_avx512(const double *x, double *y, size_t n, int passes){
+    const __m512d m = _mm512_set1_pd(FP_BLOCK_MUL);
+    for (int p = 0; p < passes; p++) {
+        for (size_t i = 0; i < n; i += 8) {
+            _mm512_store_pd(y + i, _mm512_fmadd_pd(_mm512_load_pd(y + i), m, _mm512_load_pd(x + i)));
+        }
+    }
+    _mm256_zeroupper();
+    return (uint64_t)passes * n * 2;
+}
+#endif // FP_HAVE_X86
+
+#ifdef FP_HAVE_NEON
+/* --- Motor de Ponto Flutuante: NEON --- */
+
+static uint64_t chain_neon(double *s){
+    const float64x2_t m = vdupq_n_f64(FP_MUL), c = vdupq_n_f64(FP_ADD);
+#define X(i) float64x2_t a##i = vld1q_f64(s + 2 * i);
+    FP_EACH_CHAIN(X)
+#undef X
+    for (uint32_t r = 0; r < FP_CHAIN_REPS; r++) {
+#define X(i) a##i = vfmaq_f64(c, a##i, m);
+        FP_EACH_CHAIN(X)
+#undef X
+    }
+#define X(i) vst1q_f64(s + 2 * i, a##i);
+    FP_EACH_CHAIN(X)
+#undef X
+    return (uint64_t)FP_CHAIN_REPS * FP_CHAINS * 2 * 2;
+}
+
+static uint64_t block_neon(const double *x, double *y, size_t n, int passes){
+    const float64x2_t m = vdupq_n_f64(FP_BLOCK_MUL);
+    for (int p = 0; p < passes; p++) {
+        for (size_t i = 0; i < n; i += 2) {
+            vst1q_f64(y + i, vfmaq_f64(vld1q_f64(x + i), vld1q_f64(y + i), m));
+        }
+    }
+    return (uint64_t)passes * n * 2;
+}
+#endif // FP_HAVE_NEON
+
+/* --- Kernels de Inteiros e Memória --- */
+
+const char *kernel_name(int kernel){
+    static const char *names[KERNEL_COUNT] = { "FPU", "INT", "STREAM", "PTR", "ATOMIC" };
+    return (kernel >= 0 && kernel < KERNEL_COUNT) ? names[kernel] : "?";
+}
+
+/**
+ * @brief Uma função de mistura de 64 bits para gerar comportamento pseudoaleatório.
+ * Usado pelo kernel de inteiros.
+ */
+static inline uint64_t mix64(uint64_t x){
+    x ^= x >> 33; x *= 0xff51afd7ed558ccdULL; x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL; x ^= x >> 33;
+    return x;
+}
+
+uint64_t kernel_int(uint64_t *dst, size_t n, int iters){
+    uint64_t acc = 0xC0FFEE;
+    for (int k=0;k<iters;k++){
+        for (size_t i=0;i<n;i++){
+            acc ^= mix64(dst[i] + i);
+            dst[i] = acc + (dst[i] << 1) + (dst[i] >> 3);
+        }
+    }
+    // 8 operações em mix64, 1 soma e 1 XOR no acumulador, 2 deslocamentos e 2 somas na regravação.
+    return (uint64_t)n * (uint64_t)(iters > 0 ? iters : 0) * INT_OPS_PER_ELEM;
+}
+
+/* --- Kernels STREAM --- */
+
+const char *stream_op_name(int op){
+    static const char *names[STREAM_OP_COUNT] = { "Copy", "Scale", "Add", "Triad" };
+    return (op >= 0 && op < STREAM_OP_COUNT) ? names[op] : "?";
+}
+
+uint64_t stream_op_bytes(int op, size_t n){
+    int arrays = (op == STREAM_ADD || op == STREAM_TRIAD) ? 3 : 2;
+    return (uint64_t)arrays * sizeof(double) * n;
+}
+
+int stream_nt_supported(void){
+#ifdef FP_HAVE_X86
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/** @brief Emite um prefetch de leitura por linha de cache, `pf` elementos à frente. */
+#define STREAM_PREFETCH(p, i, pf) \
+    do { if ((pf) && ((i) % (CACHE_LINE_SIZE / sizeof(double))) == 0) __builtin_prefetch((p) + (i) + (pf), 0, 0); } while (0)
+
+/**
+ * @brief Implementação com stores comuns; o compilador vetoriza os laços.
+ */
+static void stream_regular(int op, double *a, double *b, double *c, size_t n, size_t pf){
+    const double s = STREAM_SCALAR;
+    switch (op) {
+        case STREAM_COPY:
+            for (size_t i = 0; i < n; i++) { STREAM_PREFETCH(a, i, pf); c[i] = a[i]; }
+            break;
+        case STREAM_SCALE:
+            for (size_t i = 0; i < n; i++) { STREAM_PREFETCH(c, i, pf); b[i] = s * c[i]; }
+            break;
+        case STREAM_ADD:
+            for (size_t i = 0; i < n; i++) { STREAM_PREFETCH(a, i, pf); STREAM_PREFETCH(b, i, pf); c[i] = a[i] + b[i]; }
+            break;
+        case STREAM_TRIAD:
+            for (size_t i = 0; i < n; i++) { STREAM_PREFETCH(b, i, pf); STREAM_PREFETCH(c, i, pf); a[i] = b[i] + s * c[i]; }
+            break;
+    }
+}
+
+#ifdef FP_HAVE_X86
+/**
+ * @brief Implementação com stores não-temporais (`movntpd`).
+ *
+ * `kernel_stream` só escolhe este caminho com arrays alinhados a 16 bytes e `n`
+ * par, então todo o laço pode usar stores alinhados de 16 bytes. O `sfence` final garante que
+ * os stores fracamente ordenados estejam visíveis antes da próxima operação.
+ */
+__attribute__((target("sse2")))
+static void stream_nt(int op, double *a, double *b, double *c, size_t n, size_t pf){
+    const __m128d s = _mm_set1_pd(STREAM_SCALAR);
+    switch (op) {
+        case STREAM_COPY:
+            for (size_t i = 0; i < n; i += 2) { STREAM_PREFETCH(a, i, pf); _mm_stream_pd(c + i, _mm_load_pd(a + i)); }
+            break;
+        case STREAM_SCALE:
+            for (size_t i = 0; i < n; i += 2) { STREAM_PREFETCH(c, i, pf); _mm_stream_pd(b + i, _mm_mul_pd(s, _mm_load_pd(c + i))); }
+            break;
+        case STREAM_ADD:
+            for (size_t i = 0; i < n; i += 2) {
+                STREAM_PREFETCH(a, i, pf); STREAM_PREFETCH(b, i, pf);
+                _mm_stream_pd(c + i, _mm_add_pd(_mm_load_pd(a + i), _mm_load_pd(b + i)));
+            }
+            break;
+        case STREAM_TRIAD:
+            for (size_t i = 0; i < n; i += 2) {
+                STREAM_PREFETCH(b, i, pf); STREAM_PREFETCH(c, i, pf);
+                _mm_stream_pd(a + i, _mm_add_pd(_mm_load_pd(b + i), _mm_mul_pd(s, _mm_load_pd(c + i))));
+            }
+            break;
+    }
+    _mm_sfence();
+}
+#endif
+
+uint64_t kernel_stream(int op, double *a, double *b, double *c, size_t n, int nt, size_t prefetch_bytes){
+    if (!a || !b || !c || n == 0 || op < 0 || op >= STREAM_OP_COUNT) return 0;
+    size_t pf = prefetch_bytes / sizeof(double);
+#ifdef FP_HAVE_X86
+    if (nt && n % 2 == 0 && ((uintptr_t)a | (uintptr_t)b | (uintptr_t)c) % 16 == 0) {
+        stream_nt(op, a, b, c, n, pf);
+        return stream_op_bytes(op, n);
+    }
+#else
+    (void)nt;
+#endif
+    stream_regular(op, a, b, c, n, pf);
+    return stream_op_bytes(op, n);
+}
+
+/* --- Inicialização dos Buffers --- */
+
+/** @brief Incremento de Weyl do splitmix64. */
+#define FILL_GAMMA 0x9E3779B97F4A7C15ULL
+/** @brief Elementos de cada balde do embaralhamento em blocos (256 KiB de `uint32_t`, cabe na L2). */
+#define PERM_BUCKET_ELEMS ((size_t)1 << 16)
+/** @brief Limite de baldes (em bits): cada balde é um fluxo de escrita durante o espalhamento. */
+#define PERM_MAX_BUCKET_BITS 8
+
+/**
+ * @brief Retorna o valor `i` da sequência splitmix64 que parte do estado `seed`.
+ */
+static inline uint64_t splitmix_at(uint64_t seed, uint64_t i){
+    uint64_t z = seed + (i + 1) * FILL_GAMMA;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void fill_u64_scalar(uint64_t *dst, size_t n, uint64_t seed, uint64_t first){
+    for (size_t i = 0; i < n; i++) dst[i] = splitmix_at(seed, first + i);
+}
+
+#ifdef FP_HAVE_X86
+__attribute__((target("avx512f,avx512dq")))
+static void fill_u64_avx512(uint64_t *dst, size_t n, uint64_t seed, uint64_t first){
+    const __m512i m1 = _mm512_set1_epi64((long long)0xBF58476D1CE4E5B9ULL);
+    const __m512i m2 = _mm512_set1_epi64((long long)0x94D049BB133111EBULL);
+    const __m512i step = _mm512_set1_epi64((long long)(8 * FILL_GAMMA));
+    uint64_t lane[8];
+    for (int k = 0; k < 8; k++) lane[k] = seed + (first + (uint64_t)k + 1) * FILL_GAMMA;
+    __m512i ctr = _mm512_loadu_si512((const void*)lane);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i z = ctr;
+        z = _mm512_mullo_epi64(_mm512_xor_si512(z, _mm512_srli_epi64(z, 30)), m1);
+        z = _mm512_mullo_epi64(_mm512_xor_si512(z, _mm512_srli_epi64(z, 27)), m2);
+        z = _mm512_xor_si512(z, _mm512_srli_epi64(z, 31));
+        _mm512_storeu_si512((void*)(dst + i), z);
+        ctr = _mm512_add_epi64(ctr, step);
+    }
+    fill_u64_scalar(dst + i, n - i, seed, first + i);
+}
+#endif
+
+void fill_random_u64(uint64_t *dst, size_t n, uint64_t seed, uint64_t first){
+    if (!dst || n == 0) return;
+#ifdef FP_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        fill_u64_avx512(dst, n, seed, first);
+        return;
+    }
+#endif
+    fill_u64_scalar(dst, n, seed, first);
+}
+
+void fill_random_unit(double *dst, size_t n, uint64_t seed){
+    uint64_t tmp[256];
+    for (size_t i = 0; i < n; i += 256) {
+        size_t c = n - i < 256 ? n - i : 256;
+        fill_random_u64(tmp, c, seed, i);
+        for (size_t k = 0; k < c; k++) dst[i + k] = (double)(tmp[k] & 0xFFFF) / 65535.0;
+    }
+}
+
+/**
+ * @brief Sorteia uma permutação uniforme de {0, ..., n-1} sem escritas aleatórias fora da cache.
+ *
+ * Cada elemento recebe um balde sorteado (Rao-Sandelius): uma passada conta os
+ * baldes e outra, que recalcula os mesmos sorteios pelo contador, espalha os
+ * elementos em `perm` com um fluxo de escrita sequencial por balde. Depois, cada
+ * balde, que cabe na L2, é embaralhado por Fisher-Yates. O resultado tem a mesma
+ * distribuição de um Fisher-Yates sobre o array inteiro.
+ *
+ * @return 0 em caso de sucesso, -1 se a tabela de baldes não puder ser alocada.
+ */
+static int perm_blocked(uint32_t *perm, size_t n, uint64_t *seed){
+    int bits = 0;
+    while (bits < PERM_MAX_BUCKET_BITS && (PERM_BUCKET_ELEMS << bits) < n) bits++;
+    size_t buckets = (size_t)1 << bits;
+    size_t *start = calloc(2 * buckets + 1, sizeof(size_t));
+    if (!start) return -1;
+    size_t *cursor = start + buckets + 1;
+    uint64_t key = splitmix64(seed);
+
+    for (size_t i = 0; i < n; i++) start[(bits ? splitmix_at(key, i) >> (64 - bits) : 0) + 1]++;
+    for (size_t b = 0; b < buckets; b++) { start[b + 1] += start[b]; cursor[b] = start[b]; }
+    for (size_t i = 0; i < n; i++) perm[cursor[bits ? splitmix_at(key, i) >> (64 - bits) : 0]++] = (uint32_t)i;
+    for (size_t b = 0; b < buckets; b++) shuffle32(perm + start[b], start[b + 1] - start[b], seed);
+    free(start);
+    return 0;
+}
+
+void ptrchase_build(uint32_t *idx, size_t nodes, int chains, uint32_t *pos, uint64_t *seed){
+    if (!idx || nodes == 0) return;
+    if (chains < 1) chains = 1;
+    if (chains > PTR_MAX_CHAINS) chains = PTR_MAX_CHAINS;
+    size_t spacing = nodes / (size_t)chains;
+
+    uint32_t *order = malloc(nodes * sizeof(uint32_t));
+    if (order && perm_blocked(order, nodes, seed) == 0) {
+        // Cada ligação é um store independente (o Sattolo faz trocas de leitura e
+        // escrita), e as cadeias partem direto das posições espaçadas da ordem, sem
+        // percorrer o ciclo com cargas dependentes.
+        for (size_t k = 0; k < nodes; k++) {
+            idx[(size_t)order[k] * PTR_STRIDE] = order[k + 1 < nodes ? k + 1 : 0] * (uint32_t)PTR_STRIDE;
+        }
+        for (int k = 0; k < chains; k++) pos[k] = order[(size_t)k * spacing] * (uint32_t)PTR_STRIDE;
+        free(order);
+        return;
+    }
+    free(order);
+
+    sattolo32(idx, nodes, PTR_STRIDE, seed);
+    pos[0] = 0;
+    // Percorre o ciclo uma vez, registrando uma posição a cada nodes/chains passos.
+    uint32_t p = 0;
+    for (int k = 1; k < chains; k++) {
+        for (size_t s = 0; s < spacing; s++) p = idx[p];
+        pos[k] = p;
+    }
+}
+
+uint32_t kernel_ptrchase(const uint32_t *idx, uint32_t *pos, int chains, size_t steps){
+    if (chains <= 1) {
+        // Caminho dedicado: a posição fica em registrador e cada passo é uma única carga dependente.
+        uint32_t p = pos[0];
+        for (size_t s = 0; s < steps; s++) p = idx[p];
+        pos[0] = p;
+        return p;
+    }
+
+    if (chains > PTR_MAX_CHAINS) chains = PTR_MAX_CHAINS;
+    uint32_t p[PTR_MAX_CHAINS];
+    for (int k = 0; k < chains; k++) p[k] = pos[k];
+    for (size_t s = 0; s < steps; s++) {
+        for (int k = 0; k < chains; k++) p[k] = idx[p[k]];
+    }
+    uint32_t sink = 0;
+    for (int k = 0; k < chains; k++) { pos[k] = p[k]; sink ^= p[k]; }
+    return sink;
+}
@@ -0,0 +1,203 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+/**
+ * @file kernels.h
+ * @brief Declara os kernels de estresse executados pelas threads de trabalho.
+ *
+ * Além dos kernels de inteiros, streaming e perseguição de ponteiro, este módulo
+ * contém o motor de ponto flutuante: cadeias de FMA independentes mantidas em
+ * registradores, com uma implementação por conjunto de instruções
+ * (escalar, SSE2, AVX2+FMA, AVX-512, NEON) escolhida em tempo de execução via
+ * CPUID/HWCAP. Assim o mesmo binário atinge o pico de FPU em qualquer máquina
+ * da frota, sem depender de `-march=native`.
+ */
+
+#include "hardstress.h"
+
+/** @brief Repetições de cada cadeia de FMA por chamada de `fp_engine_t::chain` (~1 ms). */
+#define FP_CHAIN_REPS (1u << 20)
+/** @brief Passagens sobre o bloco residente em cache em uma iteração do worker. */
+#define FP_BLOCK_PASSES 64
+/** @brief Atualizações de elemento do bloco por quantum de trabalho (~1 ms). */
+#define FP_BLOCK_QUANTUM_ELEMS (1u << 21)
+/** @brief Número de cadeias independentes; cobre a latência de FMA em duas portas. */
+#define FP_CHAINS 12
+/** @brief Granularidade, em elementos, do tamanho do bloco residente em cache. */
+#define FP_BLOCK_ALIGN_ELEMS 32
+
+/**
+ * @enum fp_isa_t
+ * @brief Conjuntos de instruções suportados pelo motor de ponto flutuante.
+ */
+typedef enum {
+    FP_ISA_SCALAR = 0,      ///< Código escalar portátil (multiplicação + soma).
+    FP_ISA_SSE2,            ///< SSE2, 2 doubles por vetor, sem FMA.
+    FP_ISA_AVX2,            ///< AVX2 + FMA3, 4 doubles por vetor.
+    FP_ISA_AVX512,          ///< AVX-512F, 8 doubles por vetor.
+    FP_ISA_NEON,            ///< NEON (AArch64), 2 doubles por vetor com FMA.
+    FP_ISA_COUNT
+} fp_isa_t;
+
+/**
+ * @struct fp_engine_t
+ * @brief Uma implementação do motor de ponto flutuante para um conjunto de instruções.
+ */
+struct fp_engine_t {
+    int isa;                ///< O conjunto de instruções (`fp_isa_t`).
+    const char *name;       ///< Nome legível (por exemplo, "AVX2+FMA").
+    int lanes;              ///< Doubles por vetor.
+    /**
+     * @brief Executa `FP_CHAIN_REPS` passos de cada cadeia de FMA em registradores.
+     * @param state Estado das cadeias (`lanes * FP_CHAINS` doubles), lido e regravado.
+     * @return O número de operações de ponto flutuante executadas.
+     */
+    uint64_t (*chain)(double *state);
+    /**
+     * @brief Executa `passes` passagens de `y = y * m + x` sobre um bloco.
+     * @param x, y Vetores de `n` doubles alinhados a 64 bytes.
+     * @param n Número de elementos (múltiplo de `FP_BLOCK_ALIGN_ELEMS`).
+     * @param passes Número de passagens sobre o bloco.
+     * @return O número de operações de ponto flutuante executadas.
+     */
+    uint64_t (*block)(const double *x, double *y, size_t n, int passes);
+};
+
+/**
+ * @brief Retorna a melhor implementação suportada pela CPU e pelo SO atuais.
+ */
+const fp_engine_t *fp_engine_select(void);
+
+/**
+ * @brief Retorna a implementação de um conjunto de instruções específico.
+ * @return A implementação, ou NULL se ela não foi compilada ou não é suportada nesta CPU.
+ */
+const fp_engine_t *fp_engine_get(int isa);
+
+/**
+ * @brief Inicializa o estado das cadeias com valores no ponto fixo das FMAs.
+ * @param state Buffer de `FP_CHAINS * 8` doubles (suficiente para qualquer conjunto).
+ */
+void fp_state_init(double *state);
+
+/**
+ * @brief Retorna o nome curto de um kernel (`kernel_id_t`): "FPU", "INT", "STREAM", "PTR" ou "ATOMIC".
+ */
+const char *kernel_name(int kernel);
+
+/** @brief Operações de inteiros (somas, XORs, deslocamentos e multiplicações) por elemento em `kernel_int`. */
+#define INT_OPS_PER_ELEM 14
+
+/**
+ * @brief Realiza uma série de operações complexas de inteiros e bitwise.
+ * Estressa as Unidades Lógicas e Aritméticas (ALUs).
+ * @return O número de operações de inteiros executadas.
+ */
+uint64_t kernel_int(uint64_t *dst, size_t n, int iters);
+
+/** @brief Escalar usado por Scale e Triad, como no STREAM. */
+#define STREAM_SCALAR 3.0
+/** @brief Elementos de cada array processados por quantum de trabalho (~1 ms na DRAM). */
+#define STREAM_QUANTUM_ELEMS (1u << 18)
+
+/**
+ * @enum stream_op_t
+ * @brief As quatro operações do benchmark STREAM.
+ */
+typedef enum {
+    STREAM_COPY = 0,        ///< c = a            (16 bytes por elemento)
+    STREAM_SCALE,           ///< b = s * c        (16 bytes por elemento)
+    STREAM_ADD,             ///< c = a + b        (24 bytes por elemento)
+    STREAM_TRIAD,           ///< a = b + s * c    (24 bytes por elemento)
+    STREAM_OP_COUNT
+} stream_op_t;
+
+/**
+ * @brief Retorna o nome de uma operação STREAM ("Copy", "Scale", "Add", "Triad").
+ */
+const char *stream_op_name(int op);
+
+/**
+ * @brief Retorna quantos bytes uma operação move para `n` elementos, contados como no STREAM.
+ *
+ * Cada array lido ou escrito conta uma vez por elemento; o tráfego extra de
+ * leitura-para-posse das escritas comuns não é contado.
+ */
+uint64_t stream_op_bytes(int op, size_t n);
+
+/**
+ * @brief Executa uma operação STREAM sobre os arrays `a`, `b` e `c` de `n` doubles.
+ *
+ * @param op A operação (`stream_op_t`).
+ * @param nt Se não-zero, usa stores não-temporais (streaming), que não alocam a
+ *           linha no cache; disponível em x86 e ignorado nas demais arquiteturas.
+ * @param prefetch_bytes Distância do prefetch de software à frente das leituras,
+ *           em bytes (0 = apenas o prefetcher de hardware).
+ * @return Os bytes movidos, contados por `stream_op_bytes`.
+ */
+uint64_t kernel_stream(int op, double *a, double *b, double *c, size_t n, int nt, size_t prefetch_bytes);
+
+/**
+ * @brief Indica se `kernel_stream` suporta stores não-temporais nesta compilação.
+ */
+int stream_nt_supported(void);
+
+/**
+ * @brief Preenche `dst[i]`, para `i < n`, com o valor `first + i` da sequência splitmix64 de `seed`.
+ *
+ * O splitmix64 é um gerador baseado em contador: o i-ésimo valor depende só de
+ * `seed` e de `i`, então trechos do buffer podem ser preenchidos de forma
+ * independente e cada elemento é calculado sem esperar o anterior (8 por
+ * instrução com AVX-512DQ, selecionado em tempo de execução). Com `first = 0`, o
+ * resultado é idêntico a `n` chamadas de `splitmix64` a partir do estado `seed`.
+ */
+void fill_random_u64(uint64_t *dst, size_t n, uint64_t seed, uint64_t first);
+
+/**
+ * @brief Preenche `dst` com valores em [0, 1] derivados da sequência splitmix64 de `seed`.
+ *
+ * Cada elemento é `(valor & 0xFFFF) / 65535`, como nos vetores do motor de ponto flutuante.
+ */
+void fill_random_unit(double *dst, size_t n, uint64_t seed);
+
+/** @brief Distância, em elementos de `uint32_t`, entre nós do ciclo: um nó por linha de cache. */
+#define PTR_STRIDE (CACHE_LINE_SIZE / sizeof(uint32_t))
+/** @brief Passos de cada cadeia em uma iteração do worker. */
+#define PTR_STEPS_PER_ITER (1u << 16)
+/** @brief Passos de cada cadeia por quantum de trabalho (~1 ms com a latência da DRAM). */
+#define PTR_STEPS_PER_QUANTUM (1u << 12)
+
+/**
+ * @brief Monta o ciclo de perseguição de ponteiro e as posições iniciais das cadeias.
+ *
+ * O ciclo é único, uniformemente aleatório, e tem um nó por linha de cache, de
+ * modo que cada passo é uma carga dependente em uma linha diferente. A ordem de
+ * visita é sorteada em blocos (espalhamento em baldes que cabem na L2, seguido de
+ * Fisher-Yates dentro de cada balde) em um array temporário de 4 bytes por nó, e
+ * cada ligação é gravada com um store independente; sem memória para esse array,
+ * usa-se o Sattolo, cujas trocas fazem leituras e escritas aleatórias sobre todo
+ * o `idx`. Com várias cadeias, as posições iniciais são espaçadas igualmente ao
+ * longo do ciclo, para que as cadeias nunca se alcancem.
+ *
+ * @param idx O array do ciclo, com pelo menos `nodes * PTR_STRIDE` elementos.
+ * @param nodes O número de nós.
+ * @param chains O número de cadeias (1 a `PTR_MAX_CHAINS`).
+ * @param pos Recebe a posição inicial de cada cadeia.
+ * @param seed O estado do PRNG.
+ */
+void ptrchase_build(uint32_t *idx, size_t nodes, int chains, uint32_t *pos, uint64_t *seed);
+
+/**
+ * @brief Avança `chains` cadeias independentes `steps` passos cada pelo ciclo `idx`.
+ *
+ * As posições finais são regravadas em `pos`, que pertence ao worker e continua
+ * de onde parou na próxima chamada; como elas são observáveis fora da função, o
+ * compilador não pode eliminar as cargas. Com uma cadeia, cada carga depende da
+ * anterior e o tempo por passo é a latência de memória; com N cadeias, mede-se o
+ * paralelismo de memória (MLP).
+ *
+ * @return O XOR das posições finais.
+ */
+uint32_t kernel_ptrchase(const uint32_t *idx, uint32_t *pos, int chains, size_t steps);
+
+#endif // KERNELS_H
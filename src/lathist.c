@@ -0,0 +1,48 @@
+#include "lathist.h"
+
+int lat_hist_index(unsigned long long ns){
+    if (ns < (1ull << LAT_HIST_SUB_BITS)) return (int)ns;
+    int e = 63 - __builtin_clzll(ns);
+    if (e > LAT_HIST_MAX_EXP) return LAT_HIST_BUCKETS - 1;
+    return ((e - LAT_HIST_SUB_BITS + 1) << LAT_HIST_SUB_BITS) +
+           (int)((ns >> (e - LAT_HIST_SUB_BITS)) - (1ull << LAT_HIST_SUB_BITS));
+}
+
+unsigned long long lat_hist_upper(int idx){
+    if (idx < (1 << LAT_HIST_SUB_BITS)) return (unsigned long long)(idx > 0 ? idx : 0);
+    int shift = (idx >> LAT_HIST_SUB_BITS) - 1;
+    unsigned long long sub = (unsigned long long)(idx & ((1 << LAT_HIST_SUB_BITS) - 1));
+    unsigned long long lower = ((1ull << LAT_HIST_SUB_BITS) + sub) << shift;
+    return lower + (1ull << shift) - 1;
+}
+
+void lat_hist_delta(atomic_ullong *hist, unsigned long long *last, unsigned long long *interval){
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++) {
+        unsigned long long v = atomic_load_explicit(&hist[i], memory_order_relaxed);
+        interval[i] = v - last[i];
+        last[i] = v;
+    }
+}
+
+double lat_hist_percentile(const unsigned long long *hist, double pct){
+    unsigned long long total = 0;
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++) total += hist[i];
+    if (total == 0) return 0.0;
+    // Posição da amostra do percentil, contada a partir de 1 (o p100 é a maior).
+    unsigned long long rank = (unsigned long long)(pct / 100.0 * (double)total + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+    unsigned long long seen = 0;
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++) {
+        seen += hist[i];
+        if (seen >= rank) return (double)lat_hist_upper(i);
+    }
+    return (double)lat_hist_upper(LAT_HIST_BUCKETS - 1);
+}
+
+double lat_hist_max(const unsigned long long *hist){
+    for (int i = LAT_HIST_BUCKETS - 1; i >= 0; i--) {
+        if (hist[i]) return (double)lat_hist_upper(i);
+    }
+    return 0.0;
+}
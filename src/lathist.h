@@ -0,0 +1,57 @@
+#ifndef LATHIST_H
+#define LATHIST_H
+
+/**
+ * @file lathist.h
+ * @brief Declara o histograma log-linear de latências usado pela E/S e pela sonda de jitter.
+ *
+ * Cada potência de 2 de nanossegundos é dividida em 2^`LAT_HIST_SUB_BITS`
+ * buckets iguais, como no HdrHistogram: o erro relativo fica abaixo de 1/16 de
+ * 1 ns a ~18 min em 608 contadores. O histograma é um vetor de `atomic_ullong`
+ * escrito por uma única thread com stores relaxados, sem travas; quem o lê
+ * calcula os percentis de um intervalo pela diferença entre duas leituras.
+ */
+
+#include "hardstress.h"
+
+/** @brief Bits de sub-buckets por potência de 2 do histograma (16 = erro relativo de até ~6%). */
+#define LAT_HIST_SUB_BITS 4
+/** @brief Maior expoente de latência representado, em ns (2^40 ns ≈ 18 min). */
+#define LAT_HIST_MAX_EXP 40
+/** @brief Buckets do histograma de latências. */
+#define LAT_HIST_BUCKETS ((LAT_HIST_MAX_EXP - LAT_HIST_SUB_BITS + 2) << LAT_HIST_SUB_BITS)
+
+/**
+ * @brief Bucket do histograma de uma latência em ns: exato até 2^`LAT_HIST_SUB_BITS`, depois log-linear.
+ */
+int lat_hist_index(unsigned long long ns);
+
+/**
+ * @brief Maior latência, em ns, contada no bucket `idx`.
+ */
+unsigned long long lat_hist_upper(int idx);
+
+/**
+ * @brief Conta uma latência em `hist`. Só a thread dona do histograma pode chamá-la.
+ */
+static inline void lat_hist_record(atomic_ullong *hist, unsigned long long ns){
+    atomic_ullong *c = &hist[lat_hist_index(ns)];
+    atomic_store_explicit(c, atomic_load_explicit(c, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Lê `hist`, grava em `interval` o que foi contado desde a leitura anterior e guarda a leitura em `last`.
+ */
+void lat_hist_delta(atomic_ullong *hist, unsigned long long *last, unsigned long long *interval);
+
+/**
+ * @brief Percentil `pct` (0 a 100) de um histograma, em ns (0 se estiver vazio).
+ */
+double lat_hist_percentile(const unsigned long long *hist, double pct);
+
+/**
+ * @brief Limite superior, em ns, do maior bucket não vazio (0 se o histograma estiver vazio).
+ */
+double lat_hist_max(const unsigned long long *hist);
+
+#endif // LATHIST_H
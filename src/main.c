@@ -8,6 +8,10 @@
  */
 #include "hardstress.h"
 #include "ui.h" // Necessário para create_main_window
+#include "headless.h" // Necessário para headless_main
+#include "bench.h"    // Necessário para bench_main
+#include "core.h"     // Necessário para app_context_create
+#include "fleet.h"    // Necessário para fleet_agent_main
 
 // Define as cores globais que foram declaradas no cabeçalho.
 const color_t COLOR_BG = {0.12, 0.12, 0.12};
@@ -21,7 +25,7 @@ const color_t COLOR_TEMP = {1.0, 1.0, 0.8};
  * @brief O ponto de entrada principal da aplicação HardStress.
  *
  * Esta função executa os seguintes passos:
- * 1. Inicializa o toolkit GTK.
+ * 1. Inicializa o toolkit GTK (exceto no modo `--headless`).
  * 2. Aloca e inicializa a estrutura principal `AppContext`, que mantém
  *    todo o estado da aplicação.
  * 3. Inicializa mutexes para acesso seguro aos dados por threads.
@@ -29,47 +33,35 @@ const color_t COLOR_TEMP = {1.0, 1.0, 0.8};
  * 5. Chama `create_main_window` para construir a GUI.
  * 6. Mostra a janela principal e inicia o loop principal de eventos do GTK.
  *
- * A limpeza de recursos é tratada no callback `on_window_destroy` em `ui.c`.
+ * Com `--bench`, apenas a suíte de benchmarks (`bench_main`) é executada, sem GTK
+ * nem `AppContext`. Com `--agent`, o processo vira um agente da frota
+ * (`fleet_agent_main`), que cria um `AppContext` para cada teste recebido.
+ *
+ * No modo `--headless` os passos 5 e 6 são substituídos por `headless_main`,
+ * que executa o teste a partir da linha de comando sem tocar no GTK.
+ *
+ * A limpeza de recursos é tratada no callback `on_window_destroy` em `ui.c`
+ * (ou em `headless_main` no modo headless).
  *
  * @param argc O número de argumentos da linha de comando.
  * @param argv Um array de strings de argumentos da linha de comando.
  * @return 0 em caso de execução bem-sucedida, 1 em caso de falha.
  */
 int main(int argc, char **argv){
-    gtk_init(&argc, &argv);
+    if (bench_requested(argc, argv)) return bench_main(argc, argv);
+    if (fleet_agent_requested(argc, argv)) return fleet_agent_main(argc, argv);
+    int headless = headless_requested(argc, argv);
+    if (!headless) gtk_init(&argc, &argv);
     
-    // Allocate and zero out the main application structure
-    AppContext *app = calloc(1, sizeof(AppContext));
+    // Allocate the main application structure with the default configuration
+    AppContext *app = app_context_create();
     if (!app) {
         fprintf(stderr, "Failed to allocate AppContext. Exiting.\n");
         return 1;
     }
 
-    // Initialize mutexes
-    g_mutex_init(&app->cpu_mutex);
-    g_mutex_init(&app->history_mutex);
-    g_mutex_init(&app->temp_mutex);
-    g_mutex_init(&app->system_history_mutex);
-    
-    // Set default configuration
-    app->mem_mib_per_thread = DEFAULT_MEM_MIB;
-    app->duration_sec = DEFAULT_DURATION_SEC;
-    app->pin_affinity = 1;
-    app->history_len = HISTORY_SAMPLES;
-    app->temp_celsius = TEMP_UNAVAILABLE;
-    app->temp_visibility_state = -1; // -1 = unknown
-
-    // Allocate and initialize system metrics history buffers
-    app->system_history_len = CPU_HISTORY_SAMPLES;
-    app->temp_history = calloc(app->system_history_len, sizeof(double));
-    app->avg_cpu_history = calloc(app->system_history_len, sizeof(double));
-    if (!app->temp_history || !app->avg_cpu_history) {
-        fprintf(stderr, "Failed to allocate system history buffers. Exiting.\n");
-        // Perform cleanup before exiting
-        free(app->temp_history);
-        free(app->avg_cpu_history);
-        free(app);
-        return 1;
+    if (headless) {
+        return headless_main(app, argc, argv);
     }
 
     // Create the main window
@@ -1,10 +1,24 @@
 #include "metrics.h"
 #include "ui.h" // For gui_log
-#include <ctype.h>
+#include "utils.h" // For now_sec, cpu_to_group
+#include "hwmon.h" // For temp_sensors_open, temp_sensors_read
+#include "perfctr.h" // For perf_ipc, perf_mpki
+#include "kernels.h" // For kernel_name
+#include "history.h" // For history_archive_push
+#include "telemetry.h" // For telemetry_sample
+#include "degrade.h" // For degrade_update
+#include "topology.h" // For cpu_topology_t
+#include "storage.h" // For io_engine_sample
+#include "jitter.h" // For jitter_sample
 
 /* --- Static Function Prototypes --- */
 static void update_temp_cache(AppContext *app, char **labels, double *values, int count, double fallback);
 static void free_temp_entries(char **labels, int count);
+static void sample_worker_iters(AppContext *app, unsigned long long *last_progress, double *last_time);
+static void sample_freq(AppContext *app, cpu_freq_t *cf);
+static void sample_io(AppContext *app, double *last_time);
+static void sample_jitter(AppContext *app);
+static void analyze_degradation(AppContext *app, degrade_t *d, degrade_event_t *ev, const cpu_freq_t *cf);
 #ifdef _WIN32
 static int pdh_init_query(AppContext *app);
 static void pdh_close_query(AppContext *app);
@@ -14,7 +28,8 @@ static void wmi_deinit(AppContext *app);
 static void sample_temp_windows(AppContext *app);
 #else
 static void sample_cpu_linux(AppContext *app);
-static void sample_temp_linux(AppContext *app);
+static void install_temp_sensors(AppContext *app, const temp_sensors_t *ts);
+static void sample_temp_linux(AppContext *app, temp_sensors_t *ts);
 #endif
 
 /* --- Sampler Thread Implementation --- */
@@ -31,6 +46,11 @@ static void sample_temp_linux(AppContext *app);
  */
 thread_return_t THREAD_CALL cpu_sampler_thread_func(void *arg){
     AppContext *app = (AppContext*)arg;
+    unsigned long long last_progress = 0;
+    double last_sample_time = now_sec();
+    double last_io_time = last_sample_time;
+    int interval_ms = app->sample_interval_ms > 0 ? app->sample_interval_ms : CPU_SAMPLE_INTERVAL_MS;
+    unsigned long long missed_ticks = 0;
 
 #ifdef _WIN32
     // On Windows, initialize COM for WMI and the PDH query for CPU usage.
@@ -38,17 +58,67 @@ thread_return_t THREAD_CALL cpu_sampler_thread_func(void *arg){
     if(pdh_init_query(app) != ERROR_SUCCESS) {
         gui_log(app, "[ERROR] Failed to initialize PDH for CPU monitoring.\n");
     }
+#else
+    // Sensors are discovered once; each tick is then one pread() per open sysfs file.
+    temp_sensors_t *sensors = temp_sensors_open(NULL);
+    if (sensors) {
+        gui_log(app, "[TEMP] %d sensor(es) de temperatura no sysfs (%d de núcleo), principal: %s\n",
+                sensors->count, sensors->core_count, sensors->sensors[sensors->primary].label);
+    } else {
+        gui_log(app, "[TEMP] Nenhum sensor de temperatura encontrado em /sys/class/hwmon ou /sys/class/thermal\n");
+    }
+    install_temp_sensors(app, sensors);
 #endif
 
+    // Frequency and throttle files are opened once as well; cf is NULL where nothing is exposed.
+    cpu_freq_t *freq = cpu_freq_open(NULL, app->cpu_count);
+    unsigned long long thermal_samples = 0, power_samples = 0;
+    if (freq) {
+        gui_log(app, "[FREQ] APERF/MPERF em %d CPU(s), scaling_cur_freq em %d, contadores de limitação em %d\n",
+                freq->msr_count, freq->cur_count, freq->throttle_count);
+        g_mutex_lock(&app->cpu_mutex);
+        app->freq_max_mhz = freq->max_mhz;
+        g_mutex_unlock(&app->cpu_mutex);
+    } else {
+        gui_log(app, "[FREQ] Frequência e limitação das CPUs indisponíveis\n");
+    }
+
+    // Throughput is checked against an early-run baseline and against the other workers.
+    degrade_t *degrade = NULL;
+    degrade_event_t *degrade_ev = NULL;
+    if (app->degrade_baseline_sec > 0 && app->profile_active) {
+        // The profile varies the throughput on purpose; every low phase would read as a degradation.
+        gui_log(app, "[DEGRADE] Detecção de degradação desligada sob perfil de carga\n");
+    } else if (app->degrade_baseline_sec > 0 && app->workers && app->threads > 0) {
+        degrade = degrade_create(app->threads, app->degrade_baseline_sec, app->degrade_pct);
+        degrade_ev = calloc(2 * (size_t)app->threads + 1, sizeof(degrade_event_t));
+        if (!degrade || !degrade_ev) {
+            gui_log(app, "[DEGRADE] Falha de memória; detecção de degradação desligada\n");
+            degrade_free(degrade);
+            degrade = NULL;
+        } else {
+            gui_log(app, "[DEGRADE] Linha de base nos primeiros %d s; episódios a partir de %d%% de queda\n",
+                    app->degrade_baseline_sec, app->degrade_pct);
+        }
+    }
+
+    // Samples are scheduled on absolute deadlines, so the time spent sampling does not stretch the period.
+    ticker_t ticker;
+    ticker_start(&ticker, interval_ms / 1000.0);
+    gui_log(app, "[SAMPLER] Intervalo de amostragem de %d ms\n", interval_ms);
+
     while (atomic_load(&app->running)){
         // Select the correct sampling functions based on the OS
 #ifndef _WIN32
         sample_cpu_linux(app);
-        sample_temp_linux(app);
+        sample_temp_linux(app, sensors);
 #else
         sample_cpu_windows(app);
         sample_temp_windows(app);
 #endif
+        sample_freq(app, freq);
+        sample_io(app, &last_io_time);
+        sample_jitter(app);
 
         g_mutex_lock(&app->cpu_mutex);
         if (app->cpu_history && app->cpu_history_len > 0 && app->cpu_count > 0) {
@@ -58,6 +128,7 @@ thread_return_t THREAD_CALL cpu_sampler_thread_func(void *arg){
                 if (usage < 0.0) usage = 0.0;
                 if (usage > 1.0) usage = 1.0;
                 app->cpu_history[c][app->cpu_history_pos] = usage;
+                if (app->freq_history) app->freq_history[c][app->cpu_history_pos] = app->cpu_freq_mhz[c];
             }
             if (app->cpu_history_filled < app->cpu_history_len) {
                 app->cpu_history_filled++;
@@ -65,11 +136,16 @@ thread_return_t THREAD_CALL cpu_sampler_thread_func(void *arg){
         }
         g_mutex_unlock(&app->cpu_mutex);
         // Request the UI thread to redraw the graph widgets
-        g_idle_add((GSourceFunc)gtk_widget_queue_draw, app->cpu_drawing);
-        g_idle_add((GSourceFunc)gtk_widget_queue_draw, app->iters_drawing);
+        if (!app->headless) {
+            g_idle_add((GSourceFunc)gtk_widget_queue_draw, app->cpu_drawing);
+            g_idle_add((GSourceFunc)gtk_widget_queue_draw, app->iters_drawing);
+        }
 
         // --- Update System-wide Metrics History ---
-        if (app->temp_history && app->avg_cpu_history && app->system_history_len > 0) {
+        g_mutex_lock(&app->system_history_mutex);
+        if (app->temp_history && app->avg_cpu_history && app->avg_freq_history &&
+            app->throttle_thermal_history && app->throttle_power_history && app->io_mbps_history &&
+            app->system_history_len > 0) {
             // Advance circular buffer position
             app->system_history_pos = (app->system_history_pos + 1) % app->system_history_len;
 
@@ -91,37 +167,302 @@ thread_return_t THREAD_CALL cpu_sampler_thread_func(void *arg){
                 app->avg_cpu_history[app->system_history_pos] = 0.0;
             }
 
+            // Average clock over the CPUs that report one, and how many CPUs were throttled
+            double freq_sum = 0.0;
+            int freq_known = 0;
+            g_mutex_lock(&app->cpu_mutex);
+            for (int c = 0; app->cpu_freq_mhz && c < app->cpu_count; c++) {
+                if (app->cpu_freq_mhz[c] > 0.0) { freq_sum += app->cpu_freq_mhz[c]; freq_known++; }
+            }
+            g_mutex_unlock(&app->cpu_mutex);
+            app->avg_freq_history[app->system_history_pos] = freq_known > 0 ? freq_sum / freq_known : 0.0;
+            app->throttle_thermal_history[app->system_history_pos] = freq ? freq->thermal_cpus : 0;
+            app->throttle_power_history[app->system_history_pos] = freq ? freq->power_cpus : 0;
+            // The sampler is the only writer of io_mbps, so it can read it back without history_mutex.
+            app->io_mbps_history[app->system_history_pos] = app->io ? app->io_mbps : 0.0;
+
             // Increment filled count until buffer is full
             if (app->system_history_filled < app->system_history_len) {
                 app->system_history_filled++;
             }
         }
+        g_mutex_unlock(&app->system_history_mutex);
+        if (freq && freq->thermal_cpus > 0) thermal_samples++;
+        if (freq && freq->power_cpus > 0) power_samples++;
         
-        // Advance the circular buffer for the performance history graph
-        g_mutex_lock(&app->history_mutex);
-        app->history_pos = (app->history_pos + 1) % app->history_len;
-        if (app->thread_history){
-            for (int t=0; t<app->threads; t++){
-                // Zero out the current position for the next sampling cycle.
-                // The value will be filled in by the worker thread.
-                app->thread_history[t][app->history_pos] = 0;
-            }
-        }
-        g_mutex_unlock(&app->history_mutex);
-
-        // Wait for the defined sample interval
-        struct timespec r = {0, CPU_SAMPLE_INTERVAL_MS * 1000000};
-        nanosleep(&r,NULL);
+        // Snapshot the per-worker counters into the performance history graph.
+        // Workers never take this lock; only the sampler and the UI do.
+        sample_worker_iters(app, &last_progress, &last_sample_time);
+        analyze_degradation(app, degrade, degrade_ev, freq);
+        // The record is only queued here; the exporter's own thread does the disk I/O.
+        telemetry_sample(app->telemetry, app);
+
+        missed_ticks += (unsigned long long)ticker_wait(&ticker);
+    }
+    ticker_stop(&ticker);
+    if (missed_ticks > 0) {
+        gui_log(app, "[SAMPLER] %llu amostra(s) perdida(s): a coleta levou mais que o intervalo de %d ms\n",
+                missed_ticks, interval_ms);
     }
 
 #ifdef _WIN32
     // Clean up Windows-specific handles
     pdh_close_query(app);
     wmi_deinit(app);
+#else
+    temp_sensors_close(sensors);
 #endif
+    if (freq && freq->throttle_count > 0) {
+        gui_log(app, "[FREQ] Limitação térmica em %llu amostra(s), limite de potência em %llu amostra(s)\n",
+                thermal_samples, power_samples);
+    }
+    cpu_freq_close(freq);
+    if (degrade) {
+        gui_log(app, "[DEGRADE] %llu episódio(s) de degradação detectado(s), %d ainda aberto(s) no fim\n",
+                degrade->events, degrade_open_count(degrade));
+    }
+    degrade_free(degrade);
+    free(degrade_ev);
     return 0;
 }
 
+/**
+ * @brief Calcula IOPS, MB/s e percentis de latência do motor de E/S no último intervalo.
+ */
+static void sample_io(AppContext *app, double *last_time){
+    if (!app->io) return;
+    double now = now_sec();
+    io_stats_t st;
+    io_engine_sample(app->io, now - *last_time, &st);
+    *last_time = now;
+    g_mutex_lock(&app->history_mutex);
+    app->io_iops = st.iops;
+    app->io_mbps = st.mbps;
+    app->io_p50_us = st.p50_us;
+    app->io_p99_us = st.p99_us;
+    app->io_p999_us = st.p999_us;
+    g_mutex_unlock(&app->history_mutex);
+}
+
+/**
+ * @brief Publica em `app->jitter_live` a latência de despertar de cada sonda no último intervalo.
+ */
+static void sample_jitter(AppContext *app){
+    if (!app->jitter) return;
+    g_mutex_lock(&app->history_mutex);
+    jitter_sample(app->jitter, app->jitter_live);
+    g_mutex_unlock(&app->history_mutex);
+}
+
+/**
+ * @brief Alimenta a detecção de degradação com a amostra corrente e registra os eventos.
+ *
+ * A temperatura de cada worker é a do seu núcleo físico quando há um sensor por
+ * núcleo; caso contrário, a temperatura principal. `ev` comporta os dois episódios
+ * de cada worker e o do sistema.
+ */
+static void analyze_degradation(AppContext *app, degrade_t *d, degrade_event_t *ev, const cpu_freq_t *cf){
+    if (!d) return;
+    const cpu_topology_t *topo = app->topology;
+    for (int t = 0; t < d->threads; t++) {
+        d->progress[t] = atomic_load_explicit(&app->workers[t].progress, memory_order_relaxed);
+        d->group[t] = (int)app->workers[t].kernels; // Workers with different roles are not peers.
+    }
+    g_mutex_lock(&app->temp_mutex);
+    int per_core = app->core_temps && topo && app->core_temp_count == topo->core_count;
+    for (int t = 0; t < d->threads; t++) {
+        int cpu = app->workers[t].cpu;
+        d->temp_c[t] = (per_core && cpu >= 0 && cpu < topo->cpu_count) ? app->core_temps[topo->cpu_core[cpu]]
+                                                                       : app->temp_celsius;
+    }
+    g_mutex_unlock(&app->temp_mutex);
+    g_mutex_lock(&app->cpu_mutex);
+    for (int t = 0; t < d->threads; t++) {
+        int cpu = app->workers[t].cpu;
+        d->mhz[t] = (app->cpu_freq_mhz && cpu >= 0 && cpu < app->cpu_count) ? app->cpu_freq_mhz[cpu] : 0.0;
+    }
+    g_mutex_unlock(&app->cpu_mutex);
+
+    int was_ready = d->ready;
+    int n = degrade_update(d, now_sec() - app->start_time, cf ? cf->thermal_cpus : 0, cf ? cf->power_cpus : 0,
+                           ev, 2 * d->threads + 1);
+    if (!was_ready && d->ready) {
+        gui_log(app, "[DEGRADE] Linha de base fechada: %.1f iters/s no total\n", d->tracks[d->threads].base);
+    }
+    for (int i = 0; i < n; i++) {
+        char line[384];
+        degrade_format_event(&ev[i], line, sizeof(line));
+        gui_log(app, "%s", line);
+        telemetry_event(app->telemetry, &ev[i]);
+    }
+}
+
+/**
+ * @brief Lê a frequência efetiva e os contadores de limitação de cada CPU.
+ *
+ * Os valores por CPU são publicados em `cpu_freq_mhz`; a maior frequência
+ * observada amplia `freq_max_mhz`, já que o turbo pode superar o máximo do cpufreq.
+ */
+static void sample_freq(AppContext *app, cpu_freq_t *cf){
+    if (!cf) return;
+    cpu_freq_read(cf);
+    g_mutex_lock(&app->cpu_mutex);
+    for (int c = 0; app->cpu_freq_mhz && c < app->cpu_count && c < cf->cpu_count; c++) {
+        app->cpu_freq_mhz[c] = cf->mhz[c];
+        if (cf->mhz[c] > app->freq_max_mhz) app->freq_max_mhz = cf->mhz[c];
+    }
+    g_mutex_unlock(&app->cpu_mutex);
+}
+
+/**
+ * @brief Copia os contadores de cada worker para o histórico de desempenho.
+ *
+ * Avança a posição do buffer circular, grava um instantâneo cumulativo dos
+ * contadores de cada worker (progresso, FLOPs, operações de inteiros, bytes e
+ * cargas) e atualiza o total de iterações inteiras e as taxas de cada kernel em
+ * unidades físicas no último intervalo. Os workers escrevem apenas seus próprios contadores, então esta é a
+ * única leitura cruzada por intervalo.
+ */
+static void sample_worker_iters(AppContext *app, unsigned long long *last_progress, double *last_time) {
+    if (!app->workers || app->threads <= 0) return;
+
+    unsigned long long total = 0;
+    unsigned long long stream_ns = 0, ptr_steps = 0, ptr_ns = 0;
+    int stream_workers = 0;
+    thread_sample_t sum = {{0}};
+    double now = now_sec();
+    double dt = now - *last_time;
+
+    g_mutex_lock(&app->history_mutex);
+    if (app->history_len > 0) app->history_pos = (app->history_pos + 1) % app->history_len;
+    if (app->history_time && app->history_len > 0) app->history_time[app->history_pos] = now;
+    app->history_seq++;
+    double gflops = 0.0;
+    for (int t = 0; t < app->threads; t++) {
+        worker_t *w = &app->workers[t];
+        thread_sample_t s;
+        total += atomic_load_explicit(&w->iters, memory_order_relaxed);
+        s.v[THREAD_METRIC_PROGRESS] = atomic_load_explicit(&w->progress, memory_order_relaxed);
+        s.v[THREAD_METRIC_FLOPS] = atomic_load_explicit(&w->flops, memory_order_relaxed);
+        s.v[THREAD_METRIC_INT_OPS] = atomic_load_explicit(&w->int_ops, memory_order_relaxed);
+        s.v[THREAD_METRIC_STREAM_BYTES] = atomic_load_explicit(&w->stream_bytes, memory_order_relaxed);
+        unsigned long long steps = atomic_load_explicit(&w->ptr_steps, memory_order_relaxed);
+        s.v[THREAD_METRIC_PTR_LOADS] = steps * (unsigned long long)(w->ptr_chains > 0 ? w->ptr_chains : 1);
+        s.v[THREAD_METRIC_ATOMIC_OPS] = atomic_load_explicit(&w->atomic_ops, memory_order_relaxed);
+        for (int m = 0; m < THREAD_METRIC_COUNT; m++) sum.v[m] += s.v[m];
+        stream_ns += atomic_load_explicit(&w->stream_ns, memory_order_relaxed);
+        stream_workers += (w->kernels >> KERNEL_STREAM) & 1u;
+        ptr_steps += steps;
+        ptr_ns += atomic_load_explicit(&w->ptr_ns, memory_order_relaxed);
+        if (app->thread_history && app->history_len > 0) app->thread_history[t][app->history_pos] = s;
+        if (app->thread_gflops && app->thread_flops_last) {
+            unsigned long long f = s.v[THREAD_METRIC_FLOPS];
+            app->thread_gflops[t] = (dt > 0.0) ? (double)(f - app->thread_flops_last[t]) / dt / 1e9 : 0.0;
+            app->thread_flops_last[t] = f;
+            gflops += app->thread_gflops[t];
+        }
+    }
+    app->gflops = gflops;
+    if (app->thread_history && app->history_len > 0) {
+        history_archive_push(app->history_archive, app->thread_history, app->history_pos, now);
+    }
+
+    // A vazão usa o progresso fracionário, para não ser quantizada em iterações inteiras
+    // quando uma iteração leva uma fração considerável do intervalo de amostragem.
+    unsigned long long progress = sum.v[THREAD_METRIC_PROGRESS];
+    app->iters_per_sec = (dt > 0.0) ? (double)(progress - *last_progress) / ITER_PROGRESS_SCALE / dt : 0.0;
+
+    unsigned long long int_ops = sum.v[THREAD_METRIC_INT_OPS];
+    app->int_gops = (dt > 0.0) ? (double)(int_ops - app->int_ops_last) / dt / 1e9 : 0.0;
+    app->int_ops_last = int_ops;
+
+    // Os workers executam o STREAM concorrentemente: a banda do sistema é o total de bytes
+    // dividido pelo tempo médio que cada worker do STREAM passou dentro do kernel.
+    unsigned long long stream_bytes = sum.v[THREAD_METRIC_STREAM_BYTES];
+    if (stream_ns > app->stream_ns_last) {
+        app->stream_gbps = (double)(stream_bytes - app->stream_bytes_last) * stream_workers
+                           / (double)(stream_ns - app->stream_ns_last);
+    }
+    app->stream_bytes_last = stream_bytes;
+    app->stream_ns_last = stream_ns;
+
+    unsigned long long ptr_loads = sum.v[THREAD_METRIC_PTR_LOADS];
+    if (ptr_steps > app->ptr_steps_last) {
+        app->ptr_ns_per_load = (double)(ptr_ns - app->ptr_ns_last) / (double)(ptr_steps - app->ptr_steps_last);
+    }
+    app->ptr_mloads = (dt > 0.0) ? (double)(ptr_loads - app->ptr_loads_last) / dt / 1e6 : 0.0;
+    app->ptr_loads_last = ptr_loads;
+    app->ptr_steps_last = ptr_steps;
+    app->ptr_ns_last = ptr_ns;
+
+    unsigned long long atomic_ops = sum.v[THREAD_METRIC_ATOMIC_OPS];
+    app->atomic_mops = (dt > 0.0) ? (double)(atomic_ops - app->atomic_ops_last) / dt / 1e6 : 0.0;
+    app->atomic_ops_last = atomic_ops;
+
+    // Contadores de hardware de cada kernel, somados sobre os workers, no último intervalo.
+    if (app->perf_en) {
+        for (int k = 0; k < KERNEL_COUNT; k++) {
+            for (int e = 0; e < PERF_COUNTER_COUNT; e++) {
+                unsigned long long v = 0;
+                for (int t = 0; t < app->threads; t++) v += atomic_load_explicit(&app->workers[t].perf[k][e], memory_order_relaxed);
+                app->perf_interval[k][e] = v - app->perf_last[k][e];
+                app->perf_last[k][e] = v;
+            }
+        }
+    }
+    g_mutex_unlock(&app->history_mutex);
+
+    atomic_store(&app->total_iters, total);
+    *last_progress = progress;
+    *last_time = now;
+}
+
+void format_kernel_rates(AppContext *app, char *buf, size_t len){
+    if (!buf || len == 0) return;
+    g_mutex_lock(&app->history_mutex);
+    double rate = app->iters_per_sec;
+    double gflops = app->gflops;
+    double int_gops = app->int_gops;
+    double stream_gbps = app->stream_gbps;
+    double ptr_mloads = app->ptr_mloads;
+    double ptr_ns = app->ptr_ns_per_load;
+    double atomic_mops = app->atomic_mops;
+    double io_iops = app->io_iops, io_mbps = app->io_mbps, io_p99 = app->io_p99_us;
+    int jitter = app->jitter_live != NULL;
+    double jitter_p99 = jitter ? app->jitter_live->all.p99_us : 0.0, jitter_max = jitter ? app->jitter_live->all.max_us : 0.0;
+    g_mutex_unlock(&app->history_mutex);
+
+    size_t n = 0;
+    buf[0] = '\0';
+    if (app->kernel_fpu_en && n < len) n += snprintf(buf + n, len - n, "%sFPU %.1f GFLOP/s", n ? " | " : "", gflops);
+    if (app->kernel_int_en && n < len) n += snprintf(buf + n, len - n, "%sINT %.2f Gops/s", n ? " | " : "", int_gops);
+    if (app->kernel_stream_en && n < len) n += snprintf(buf + n, len - n, "%sSTREAM %.1f GB/s", n ? " | " : "", stream_gbps);
+    if (app->kernel_ptr_en && n < len) n += snprintf(buf + n, len - n, "%sPTR %.1f Mcargas/s (%.1f ns/carga)", n ? " | " : "", ptr_mloads, ptr_ns);
+    if (app->kernel_atomic_en && n < len) n += snprintf(buf + n, len - n, "%sATOMIC %.1f Mops/s", n ? " | " : "", atomic_mops);
+    if (app->io_path[0] && n < len) n += snprintf(buf + n, len - n, "%sIO %.0f IOPS %.1f MB/s (p99 %.0f µs)", n ? " | " : "", io_iops, io_mbps, io_p99);
+    if (jitter && n < len) n += snprintf(buf + n, len - n, "%sJitter p99 %.0f µs (máx. %.0f µs)", n ? " | " : "", jitter_p99, jitter_max);
+    if (n == 0) snprintf(buf, len, "%.0f iters/s", rate);
+}
+
+int format_perf_rates(AppContext *app, char *buf, size_t len){
+    if (!buf || len == 0) return 0;
+    buf[0] = '\0';
+    if (!app->perf_en) return 0;
+    unsigned long long c[KERNEL_COUNT][PERF_COUNTER_COUNT];
+    g_mutex_lock(&app->history_mutex);
+    memcpy(c, app->perf_interval, sizeof(c));
+    g_mutex_unlock(&app->history_mutex);
+
+    size_t n = 0;
+    for (int k = 0; k < KERNEL_COUNT && n < len; k++) {
+        if (c[k][PERF_CYCLES] == 0) continue;
+        n += snprintf(buf + n, len - n, "%s%s IPC %.2f (LLC %.1f, dTLB %.1f, desvios %.1f MPKI)", n ? " | " : "",
+                      kernel_name(k), perf_ipc(c[k]), perf_mpki(c[k], PERF_LLC_MISSES),
+                      perf_mpki(c[k], PERF_DTLB_MISSES), perf_mpki(c[k], PERF_BRANCH_MISSES));
+    }
+    return n > 0;
+}
+
 static void update_temp_cache(AppContext *app, char **labels, double *values, int count, double fallback) {
     g_mutex_lock(&app->temp_mutex);
 
@@ -172,7 +513,8 @@ static void free_temp_entries(char **labels, int count) {
 
 int detect_cpu_count(void){
 #ifdef _WIN32
-    SYSTEM_INFO si; GetSystemInfo(&si); return (int)si.dwNumberOfProcessors;
+    // Soma todos os grupos de processadores; GetSystemInfo só enxerga o grupo atual.
+    DWORD n = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS); return n > 0 ? (int)n : 1;
 #else
     long n = sysconf(_SC_NPROCESSORS_ONLN); return n > 0 ? (int)n : 1;
 #endif
@@ -258,77 +600,55 @@ static void sample_cpu_linux(AppContext *app) {
 }
 
 /**
- * @brief Amostra a temperatura da CPU no Linux executando `sensors`.
+ * @brief Publica o cache de temperaturas por núcleo para os sensores descobertos.
  *
- * Analisa a saída de `sensors -u` para encontrar a primeira leitura de sensor térmico disponível.
- * Requer que o pacote `lm-sensors` esteja instalado.
+ * É a única alocação do caminho de temperatura no Linux: os rótulos e o array de
+ * valores são criados uma vez, no início da amostragem, e depois apenas regravados
+ * por `sample_temp_linux`.
  */
-static void sample_temp_linux(AppContext *app){
-    FILE *p = popen("sensors -u 2>/dev/null", "r");
-    if (!p){
+static void install_temp_sensors(AppContext *app, const temp_sensors_t *ts){
+    if (!ts || ts->core_count == 0) {
         update_temp_cache(app, NULL, NULL, 0, TEMP_UNAVAILABLE);
         return;
     }
-
-    char line[256];
-    char current_label[128] = {0};
-    double fallback = TEMP_UNAVAILABLE;
-    char **labels = NULL;
-    double *values = NULL;
+    char **labels = g_new0(char*, ts->core_count);
+    double *values = g_new(double, ts->core_count);
     int count = 0;
-
-    while (fgets(line, sizeof(line), p)){
-        char *trim = line;
-        while (*trim && isspace((unsigned char)*trim)) trim++;
-        if (*trim == '\0') continue;
-
-        if (trim == line) {
-            char *colon = strchr(trim, ':');
-            if (!colon) continue;
-            size_t len = (size_t)(colon - trim);
-            if (len >= sizeof(current_label)) len = sizeof(current_label) - 1;
-            memcpy(current_label, trim, len);
-            current_label[len] = '\0';
-        } else {
-            char *input = strstr(trim, "_input:");
-            if (!input) continue;
-            double value;
-            if (sscanf(input + 7, "%lf", &value) != 1) continue;
-            if (fallback <= TEMP_UNAVAILABLE) fallback = value;
-            if (strncmp(current_label, "Core ", 5) != 0) continue;
-
-            char **tmp_labels = g_realloc(labels, sizeof(char*) * (count + 1));
-            if (!tmp_labels) {
-                pclose(p);
-                free_temp_entries(labels, count);
-                g_free(values);
-                update_temp_cache(app, NULL, NULL, 0, fallback);
-                return;
-            }
-            labels = tmp_labels;
-            double *tmp_values = g_realloc(values, sizeof(double) * (count + 1));
-            if (!tmp_values) {
-                pclose(p);
-                free_temp_entries(labels, count);
-                g_free(values);
-                update_temp_cache(app, NULL, NULL, 0, fallback);
-                return;
-            }
-            values = tmp_values;
-            labels[count] = g_strdup(current_label);
-            if (!labels[count]) {
-                pclose(p);
-                free_temp_entries(labels, count);
-                g_free(values);
-                update_temp_cache(app, NULL, NULL, 0, fallback);
-                return;
-            }
-            values[count] = value;
-            count++;
+    if (labels && values) {
+        for (int i = 0; i < ts->count; i++) {
+            if (!ts->sensors[i].is_core) continue;
+            labels[count] = g_strdup(ts->sensors[i].label);
+            if (!labels[count]) break;
+            values[count++] = TEMP_UNAVAILABLE;
         }
     }
-    pclose(p);
-    update_temp_cache(app, labels, values, count, fallback);
+    if (count == 0) {
+        g_free(labels);
+        g_free(values);
+        labels = NULL;
+        values = NULL;
+    }
+    update_temp_cache(app, labels, values, count, TEMP_UNAVAILABLE);
+}
+
+/**
+ * @brief Amostra a temperatura da CPU no Linux a partir dos sensores do sysfs.
+ *
+ * Cada sensor é lido com um `pread` no descritor aberto na descoberta e os valores
+ * são copiados para o cache pré-alocado, sem alocar memória nem criar processos.
+ */
+static void sample_temp_linux(AppContext *app, temp_sensors_t *ts){
+    if (!ts) return;
+    temp_sensors_read(ts);
+
+    g_mutex_lock(&app->temp_mutex);
+    int k = 0;
+    for (int i = 0; i < ts->count && k < app->core_temp_count; i++) {
+        if (ts->sensors[i].is_core && app->core_temps) app->core_temps[k++] = ts->values[i];
+    }
+    app->temp_celsius = (ts->primary >= 0) ? ts->values[ts->primary] : TEMP_UNAVAILABLE;
+    gui_set_temp_panel_visibility(app, app->temp_celsius > TEMP_UNAVAILABLE);
+    g_mutex_unlock(&app->temp_mutex);
 }
 
 #else /* --- WINDOWS IMPLEMENTATION --- */
@@ -337,7 +657,8 @@ static void sample_temp_linux(AppContext *app){
  * @brief Inicializa a consulta PDH (Performance Data Helper) para uso da CPU.
  *
  * Configura uma consulta PDH e adiciona um contador para "% Processor Time" para cada
- * processador lógico no sistema.
+ * processador lógico no sistema. O objeto "Processor Information" é indexado por
+ * "grupo,número", o que cobre máquinas com mais de um grupo de processadores.
  */
 static int pdh_init_query(AppContext *app){
     if (PdhOpenQuery(NULL, 0, &app->pdh_query) != ERROR_SUCCESS) return -1;
@@ -348,7 +669,10 @@ static int pdh_init_query(AppContext *app){
     }
     for (int i = 0; i < app->cpu_count; i++) {
         char path[256];
-        snprintf(path, sizeof(path), "\\Processor(%d)\\%% Processor Time", i);
+        unsigned short group = 0;
+        unsigned char number = 0;
+        cpu_to_group(i, &group, &number);
+        snprintf(path, sizeof(path), "\\Processor Information(%u,%u)\\%% Processor Time", group, number);
         if (PdhAddEnglishCounterA(app->pdh_query, path, 0, &app->pdh_counters[i]) != ERROR_SUCCESS) {
             // Cleanup on failure
             for (int j = 0; j < i; j++) PdhRemoveCounter(app->pdh_counters[j]);
@@ -480,9 +804,3 @@ static void sample_temp_windows(AppContext *app) {
 }
 
 #endif
-
-/* --- CSV LOGGING --- */
-
-/**
- * @brief Writes the header row to the real-time CSV log file.
- */
\ No newline at end of file
@@ -35,6 +35,25 @@ thread_return_t THREAD_CALL cpu_sampler_thread_func(void *arg);
  */
 int detect_cpu_count(void);
 
+/**
+ * @brief Formata as taxas do último intervalo de cada kernel habilitado, em unidades físicas.
+ *
+ * Produz, por exemplo, "FPU 12.3 GFLOP/s | INT 4.56 Gops/s | STREAM 13.6 GB/s |
+ * PTR 45.0 Mcargas/s (21.0 ns/carga)". Sem kernels habilitados, mostra a vazão
+ * em iterações por segundo. Adquire `history_mutex`.
+ */
+void format_kernel_rates(AppContext *app, char *buf, size_t len);
+
+/**
+ * @brief Formata IPC e MPKI do último intervalo de cada kernel com contadores de hardware.
+ *
+ * Produz, por exemplo, "STREAM IPC 0.45 (LLC 12.3, dTLB 0.8, desvios 0.0 MPKI)".
+ * Adquire `history_mutex`.
+ *
+ * @return 1 se algum kernel foi medido, 0 se os contadores estão desligados ou sem dados.
+ */
+int format_perf_rates(AppContext *app, char *buf, size_t len);
+
 #ifndef _WIN32
 int read_proc_stat(cpu_sample_t *out, int maxcpu, const char *path);
 double compute_usage(const cpu_sample_t *a, const cpu_sample_t *b);
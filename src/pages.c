@@ -0,0 +1,268 @@
+#include "pages.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#endif
+
+#define SIZE_2M (2ULL * 1024 * 1024)
+#define SIZE_1G (1024ULL * 1024 * 1024)
+
+/** @brief Mecanismo usado para obter uma região, que determina como liberá-la. */
+enum { REGION_KIND_NONE = 0, REGION_KIND_MALLOC, REGION_KIND_MMAP, REGION_KIND_VIRTUAL };
+
+/* --- Static Function Prototypes --- */
+static size_t base_page_size(void);
+static int round_up(size_t bytes, size_t align, size_t *out);
+static int alloc_default(mem_region_t *r, size_t bytes);
+#ifndef _WIN32
+static int alloc_hugetlb(mem_region_t *r, size_t bytes, size_t page, int page_shift, int mode);
+static int alloc_thp(mem_region_t *r, size_t bytes);
+static size_t thp_page_size(void);
+#else
+static int enable_lock_memory_privilege(void);
+static int alloc_large_pages(mem_region_t *r, size_t bytes);
+#endif
+
+/* --- Funções Independentes de Plataforma --- */
+
+int page_mode_parse(const char *s){
+    if (!s) return -1;
+    if (strcmp(s, "default") == 0) return PAGE_MODE_DEFAULT;
+    if (strcmp(s, "thp") == 0) return PAGE_MODE_THP;
+    if (strcmp(s, "2m") == 0) return PAGE_MODE_HUGE_2M;
+    if (strcmp(s, "1g") == 0) return PAGE_MODE_HUGE_1G;
+    return -1;
+}
+
+const char *page_mode_name(int mode){
+    switch (mode) {
+        case PAGE_MODE_THP:     return "THP";
+        case PAGE_MODE_HUGE_2M: return "hugetlb 2 MiB";
+        case PAGE_MODE_HUGE_1G: return "hugetlb 1 GiB";
+        default:                return "padrão";
+    }
+}
+
+void format_page_size(size_t bytes, char *buf, size_t len){
+    if (bytes >= SIZE_1G && bytes % SIZE_1G == 0) snprintf(buf, len, "%zu GiB", bytes / (size_t)SIZE_1G);
+    else if (bytes >= 1024 * 1024 && bytes % (1024 * 1024) == 0) snprintf(buf, len, "%zu MiB", bytes / (1024 * 1024));
+    else snprintf(buf, len, "%zu KiB", bytes / 1024);
+}
+
+/**
+ * @brief Arredonda `bytes` para cima até um múltiplo de `align`.
+ * @return 0 em caso de sucesso, -1 em caso de overflow.
+ */
+static int round_up(size_t bytes, size_t align, size_t *out){
+    if (bytes > SIZE_MAX - (align - 1)) return -1;
+    *out = (bytes + align - 1) / align * align;
+    return 0;
+}
+
+/**
+ * @brief Aloca com o alocador padrão (páginas base do sistema).
+ */
+static int alloc_default(mem_region_t *r, size_t bytes){
+    r->ptr = malloc(bytes);
+    if (!r->ptr) return -1;
+    r->map_bytes = bytes;
+    r->page_size = base_page_size();
+    r->mode = PAGE_MODE_DEFAULT;
+    r->kind = REGION_KIND_MALLOC;
+    return 0;
+}
+
+void *region_alloc(mem_region_t *r, size_t bytes, int mode){
+    memset(r, 0, sizeof(*r));
+    if (bytes == 0) return NULL;
+
+#ifndef _WIN32
+    switch (mode) {
+        case PAGE_MODE_HUGE_1G:
+            if (alloc_hugetlb(r, bytes, SIZE_1G, 30, PAGE_MODE_HUGE_1G) == 0) break;
+            /* fall through */
+        case PAGE_MODE_HUGE_2M:
+            if (alloc_hugetlb(r, bytes, SIZE_2M, 21, PAGE_MODE_HUGE_2M) == 0) break;
+            /* fall through */
+        case PAGE_MODE_THP:
+            if (alloc_thp(r, bytes) == 0) break;
+            /* fall through */
+        default:
+            alloc_default(r, bytes);
+            break;
+    }
+#else
+    // O Windows não tem equivalente ao THP nem permite escolher 1 GiB via VirtualAlloc:
+    // os modos explícitos usam o tamanho de página grande do sistema.
+    if (mode == PAGE_MODE_HUGE_1G || mode == PAGE_MODE_HUGE_2M) {
+        if (alloc_large_pages(r, bytes) != 0) alloc_default(r, bytes);
+    } else {
+        alloc_default(r, bytes);
+    }
+#endif
+    if (r->ptr) r->bytes = bytes;
+    return r->ptr;
+}
+
+void region_free(mem_region_t *r){
+    if (!r || !r->ptr) return;
+    switch (r->kind) {
+#ifndef _WIN32
+        case REGION_KIND_MMAP:    munmap(r->ptr, r->map_bytes); break;
+#else
+        case REGION_KIND_VIRTUAL: VirtualFree(r->ptr, 0, MEM_RELEASE); break;
+#endif
+        default:                  free(r->ptr); break;
+    }
+    memset(r, 0, sizeof(*r));
+}
+
+#ifndef _WIN32 /* LINUX IMPLEMENTATION */
+
+static size_t base_page_size(void){
+    long ps = sysconf(_SC_PAGESIZE);
+    return ps > 0 ? (size_t)ps : 4096;
+}
+
+/**
+ * @brief Mapeia a região com páginas hugetlb explícitas do tamanho `page`.
+ *
+ * Sem `MAP_NORESERVE` o kernel reserva as páginas do pool no `mmap`, de modo
+ * que a falta de páginas é detectada aqui e não como SIGBUS no primeiro acesso.
+ */
+static int alloc_hugetlb(mem_region_t *r, size_t bytes, size_t page, int page_shift, int mode){
+    size_t map;
+    if (round_up(bytes, page, &map) != 0) return -1;
+    void *p = mmap(NULL, map, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (page_shift << MAP_HUGE_SHIFT), -1, 0);
+    if (p == MAP_FAILED) return -1;
+    r->ptr = p;
+    r->map_bytes = map;
+    r->page_size = page;
+    r->mode = mode;
+    r->kind = REGION_KIND_MMAP;
+    return 0;
+}
+
+/**
+ * @brief Lê o tamanho de página usado pelo THP, ou 0 se o THP estiver desabilitado.
+ */
+static size_t thp_page_size(void){
+    char line[128];
+    FILE *f = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (!f) return 0;
+    char *ok = fgets(line, sizeof(line), f);
+    fclose(f);
+    if (!ok || strstr(line, "[never]")) return 0;
+
+    size_t size = SIZE_2M;
+    f = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+    if (f) {
+        unsigned long long v;
+        if (fscanf(f, "%llu", &v) == 1 && v > 0) size = (size_t)v;
+        fclose(f);
+    }
+    return size;
+}
+
+/**
+ * @brief Mapeia uma região alinhada ao tamanho de página do THP e pede `MADV_HUGEPAGE`.
+ *
+ * O alinhamento é necessário para que o kernel possa promover cada trecho a uma
+ * página grande; o excesso reservado nas pontas é devolvido com `munmap`.
+ */
+static int alloc_thp(mem_region_t *r, size_t bytes){
+#ifdef MADV_HUGEPAGE
+    size_t page = thp_page_size();
+    if (page == 0) return -1;
+    size_t map;
+    if (round_up(bytes, page, &map) != 0 || map > SIZE_MAX - page) return -1;
+
+    uint8_t *raw = mmap(NULL, map + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return -1;
+    uint8_t *aligned = (uint8_t*)(((uintptr_t)raw + page - 1) & ~(uintptr_t)(page - 1));
+    size_t head = (size_t)(aligned - raw);
+    size_t tail = page - head;
+    if (head) munmap(raw, head);
+    if (tail) munmap(aligned + map, tail);
+
+    if (madvise(aligned, map, MADV_HUGEPAGE) != 0) {
+        munmap(aligned, map);
+        return -1;
+    }
+    r->ptr = aligned;
+    r->map_bytes = map;
+    r->page_size = page;
+    r->mode = PAGE_MODE_THP;
+    r->kind = REGION_KIND_MMAP;
+    return 0;
+#else
+    (void)r; (void)bytes;
+    return -1;
+#endif
+}
+
+#else /* --- WINDOWS IMPLEMENTATION --- */
+
+static size_t base_page_size(void){
+    SYSTEM_INFO si; GetSystemInfo(&si);
+    return si.dwPageSize;
+}
+
+/**
+ * @brief Habilita `SeLockMemoryPrivilege` no token do processo (uma única vez).
+ *
+ * O privilégio precisa ter sido concedido à conta ("Bloquear páginas na memória");
+ * aqui ele apenas é ativado.
+ * @return 1 se o privilégio está ativo, 0 caso contrário.
+ */
+static int enable_lock_memory_privilege(void){
+    static volatile LONG state = 0; // 0 = não tentado, 1 = ativo, -1 = indisponível
+    if (state != 0) return state > 0;
+
+    int ok = 0;
+    HANDLE token;
+    if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+        TOKEN_PRIVILEGES tp;
+        tp.PrivilegeCount = 1;
+        tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        if (LookupPrivilegeValue(NULL, SE_LOCK_MEMORY_NAME, &tp.Privileges[0].Luid) &&
+            AdjustTokenPrivileges(token, FALSE, &tp, 0, NULL, NULL) &&
+            GetLastError() == ERROR_SUCCESS) {
+            ok = 1;
+        }
+        CloseHandle(token);
+    }
+    InterlockedExchange(&state, ok ? 1 : -1);
+    return ok;
+}
+
+/**
+ * @brief Aloca a região com `VirtualAlloc(MEM_LARGE_PAGES)`.
+ *
+ * Páginas grandes são confirmadas e travadas na alocação, no nó da CPU em que a
+ * thread chamadora está fixada.
+ */
+static int alloc_large_pages(mem_region_t *r, size_t bytes){
+    size_t page = GetLargePageMinimum();
+    if (page == 0 || !enable_lock_memory_privilege()) return -1;
+    size_t map;
+    if (round_up(bytes, page, &map) != 0) return -1;
+    void *p = VirtualAlloc(NULL, map, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    if (!p) return -1;
+    r->ptr = p;
+    r->map_bytes = map;
+    r->page_size = page;
+    r->mode = (page >= SIZE_1G) ? PAGE_MODE_HUGE_1G : PAGE_MODE_HUGE_2M;
+    r->kind = REGION_KIND_VIRTUAL;
+    return 0;
+}
+
+#endif
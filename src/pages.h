@@ -0,0 +1,53 @@
+#ifndef PAGES_H
+#define PAGES_H
+
+/**
+ * @file pages.h
+ * @brief Declara a alocação dos buffers dos workers com páginas grandes (huge pages).
+ *
+ * Com páginas de 4 KiB, um percurso aleatório por um buffer de centenas de MiB
+ * mede principalmente faltas de TLB. Este módulo aloca regiões com páginas
+ * hugetlb explícitas (2 MiB/1 GiB), com Transparent Huge Pages via `madvise`
+ * ou com `VirtualAlloc(MEM_LARGE_PAGES)` no Windows, recuando para o modo
+ * seguinte quando o pedido não pode ser atendido e registrando o tamanho de
+ * página realmente obtido.
+ */
+
+#include "hardstress.h"
+
+/**
+ * @brief Aloca uma região de `bytes` bytes tentando o modo de página `mode`.
+ *
+ * A ordem de recuo é 1 GiB -> 2 MiB -> THP -> páginas padrão. A memória não é
+ * tocada aqui, para que o first-touch aconteça na CPU do worker.
+ *
+ * @param r A região a ser preenchida; em caso de falha, `r->ptr` é NULL.
+ * @param bytes O tamanho desejado, em bytes.
+ * @param mode O modo preferido (`page_mode_t`).
+ * @return `r->ptr`, ou NULL se nem a alocação com páginas padrão foi possível.
+ */
+void *region_alloc(mem_region_t *r, size_t bytes, int mode);
+
+/**
+ * @brief Libera uma região obtida com `region_alloc` e a zera.
+ * @param r A região; regiões vazias são ignoradas.
+ */
+void region_free(mem_region_t *r);
+
+/**
+ * @brief Converte um nome de modo ("default", "thp", "2m", "1g") em `page_mode_t`.
+ * @return O modo correspondente, ou -1 se o nome for desconhecido.
+ */
+int page_mode_parse(const char *s);
+
+/**
+ * @brief Retorna um nome legível para um modo de página.
+ */
+const char *page_mode_name(int mode);
+
+/**
+ * @brief Formata um tamanho de página (por exemplo, "4 KiB", "2 MiB", "1 GiB").
+ */
+void format_page_size(size_t bytes, char *buf, size_t len);
+
+#endif // PAGES_H
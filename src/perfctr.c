@@ -0,0 +1,146 @@
+#include "perfctr.h"
+#include <errno.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+static const char *counter_names[PERF_COUNTER_COUNT] = {
+    [PERF_CYCLES]        = "cycles",
+    [PERF_INSTRUCTIONS]  = "instructions",
+    [PERF_LLC_MISSES]    = "LLC-load-misses",
+    [PERF_DTLB_MISSES]   = "dTLB-load-misses",
+    [PERF_BRANCH_MISSES] = "branch-misses",
+};
+
+const char *perf_counter_name(int counter){
+    return (counter >= 0 && counter < PERF_COUNTER_COUNT) ? counter_names[counter] : "?";
+}
+
+double perf_ipc(const unsigned long long *counters){
+    return counters[PERF_CYCLES] > 0 ? (double)counters[PERF_INSTRUCTIONS] / (double)counters[PERF_CYCLES] : 0.0;
+}
+
+double perf_mpki(const unsigned long long *counters, int counter){
+    return counters[PERF_INSTRUCTIONS] > 0 ? 1000.0 * (double)counters[counter] / (double)counters[PERF_INSTRUCTIONS] : 0.0;
+}
+
+#ifdef __linux__
+/* --- Static Function Prototypes --- */
+static void counter_attr(int counter, struct perf_event_attr *attr);
+static int open_counter(const struct perf_event_attr *attr, int group_fd);
+
+/**
+ * @brief Preenche os atributos de um contador, medido apenas em modo usuário.
+ */
+static void counter_attr(int counter, struct perf_event_attr *attr){
+    memset(attr, 0, sizeof(*attr));
+    attr->size = sizeof(*attr);
+    attr->exclude_kernel = 1;
+    attr->exclude_hv = 1;
+    attr->read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    switch (counter) {
+    case PERF_CYCLES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        attr->disabled = 1; // o líder habilita o grupo inteiro de uma vez
+        break;
+    case PERF_INSTRUCTIONS:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PERF_LLC_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case PERF_DTLB_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    default:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    }
+}
+
+/**
+ * @brief Abre um contador para a thread chamadora, em qualquer CPU.
+ */
+static int open_counter(const struct perf_event_attr *attr, int group_fd){
+    return (int)syscall(SYS_perf_event_open, attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+unsigned perf_group_open(perf_group_t *g){
+    memset(g, 0, sizeof(*g));
+    g->leader = -1;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) g->fd[i] = -1;
+
+    unsigned mask = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        struct perf_event_attr attr;
+        counter_attr(i, &attr);
+        int fd = open_counter(&attr, g->leader);
+        if (fd < 0) {
+            // Sem o líder não há grupo; os demais contadores são opcionais.
+            if (i == PERF_CYCLES) { g->err = errno; return 0; }
+            continue;
+        }
+        if (g->leader < 0) g->leader = fd;
+        g->fd[i] = fd;
+        g->order[g->count++] = i;
+        mask |= 1u << i;
+    }
+    ioctl(g->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(g->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return mask;
+}
+
+int perf_group_read(const perf_group_t *g, unsigned long long *out){
+    if (g->leader < 0) return -1;
+    // Formato de PERF_FORMAT_GROUP: nr, time_enabled, time_running, valores[nr].
+    uint64_t buf[3 + PERF_COUNTER_COUNT];
+    ssize_t n = read(g->leader, buf, sizeof(buf));
+    if (n < (ssize_t)(3 * sizeof(uint64_t)) || buf[0] != (uint64_t)g->count) return -1;
+    uint64_t enabled = buf[1], running = buf[2];
+    double scale = (running > 0 && running < enabled) ? (double)enabled / (double)running : 1.0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) out[i] = 0;
+    for (int i = 0; i < g->count; i++) {
+        out[g->order[i]] = (unsigned long long)((double)buf[3 + i] * scale);
+    }
+    return 0;
+}
+
+void perf_group_close(perf_group_t *g){
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (g->fd[i] >= 0) close(g->fd[i]);
+        g->fd[i] = -1;
+    }
+    g->leader = -1;
+    g->count = 0;
+}
+
+#else /* --- SEM perf_event_open --- */
+
+// Fora do Linux não há backend de PMU; os workers seguem sem contadores de hardware.
+unsigned perf_group_open(perf_group_t *g){
+    memset(g, 0, sizeof(*g));
+    g->leader = -1;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) g->fd[i] = -1;
+    g->err = ENOSYS;
+    return 0;
+}
+
+int perf_group_read(const perf_group_t *g, unsigned long long *out){
+    (void)g;
+    (void)out;
+    return -1;
+}
+
+void perf_group_close(perf_group_t *g){
+    (void)g;
+}
+
+#endif
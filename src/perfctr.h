@@ -0,0 +1,66 @@
+#ifndef PERFCTR_H
+#define PERFCTR_H
+
+/**
+ * @file perfctr.h
+ * @brief Declara a leitura de contadores de hardware por thread via `perf_event_open`.
+ *
+ * Cada worker abre, para si mesmo, um grupo com ciclos, instruções, falhas de
+ * LLC, falhas de dTLB e desvios mal previstos, contados apenas em modo usuário.
+ * O grupo é lido com um único `read` e os valores são corrigidos pela fração de
+ * tempo em que os contadores estiveram de fato escalonados (multiplexação). No
+ * Windows, e onde o kernel não expõe a PMU (várias VMs), nenhum contador é aberto.
+ */
+
+#include "hardstress.h"
+
+/**
+ * @struct perf_group_t
+ * @brief Um grupo de contadores de hardware da thread chamadora.
+ */
+typedef struct {
+    int fd[PERF_COUNTER_COUNT]; ///< Descritor de cada contador, ou -1 se ele não pôde ser aberto.
+    int leader;             ///< Descritor do líder do grupo, ou -1 se nenhum contador foi aberto.
+    int count;              ///< Quantos contadores fazem parte do grupo.
+    int order[PERF_COUNTER_COUNT]; ///< `perf_counter_t` de cada posição da leitura do grupo.
+    int err;                ///< `errno` da abertura do primeiro contador, quando ela falhou.
+} perf_group_t;
+
+/**
+ * @brief Retorna o nome curto de um contador ("cycles", "instructions", ...).
+ */
+const char *perf_counter_name(int counter);
+
+/**
+ * @brief Abre o grupo de contadores para a thread chamadora e o habilita.
+ *
+ * Contadores que a CPU não oferece são omitidos; se nem o líder (ciclos) pode ser
+ * aberto, o grupo fica vazio e `err` guarda o motivo.
+ *
+ * @return A máscara dos contadores abertos (bits de `perf_counter_t`), 0 se nenhum.
+ */
+unsigned perf_group_open(perf_group_t *g);
+
+/**
+ * @brief Lê os valores cumulativos do grupo, escalados pela multiplexação.
+ * @param out Recebe `PERF_COUNTER_COUNT` valores; contadores ausentes ficam em 0.
+ * @return 0 em caso de sucesso, -1 se o grupo está vazio ou a leitura falhou.
+ */
+int perf_group_read(const perf_group_t *g, unsigned long long *out);
+
+/**
+ * @brief Fecha os descritores do grupo.
+ */
+void perf_group_close(perf_group_t *g);
+
+/**
+ * @brief Instruções por ciclo de um conjunto de contadores (0 se não há ciclos).
+ */
+double perf_ipc(const unsigned long long *counters);
+
+/**
+ * @brief Eventos de `counter` por mil instruções (MPKI) de um conjunto de contadores.
+ */
+double perf_mpki(const unsigned long long *counters, int counter);
+
+#endif // PERFCTR_H
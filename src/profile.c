@@ -0,0 +1,144 @@
+#include "profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Máximo de campos separados por ':' em uma especificação. */
+#define PROFILE_MAX_FIELDS 5
+
+/* --- Static Function Prototypes --- */
+static int parse_num(const char *s, double min, double max, double *out);
+static int parse_period(char **f, int n, int at, load_profile_t *p);
+static int parse_levels(char *s, load_profile_t *p);
+
+/**
+ * @brief Converte um número decimal, validando-o por completo e pelo intervalo [min, max].
+ */
+static int parse_num(const char *s, double min, double max, double *out){
+    if (!s || *s == '\0') return -1;
+    char *end;
+    double v = strtod(s, &end);
+    if (*end != '\0' || v != v || v < min || v > max) return -1;
+    *out = v;
+    return 0;
+}
+
+/**
+ * @brief Aplica o período opcional no campo `at` (ausente = padrão); campos além dele são inválidos.
+ */
+static int parse_period(char **f, int n, int at, load_profile_t *p){
+    double ms = PROFILE_DEFAULT_PERIOD_MS;
+    if (n > at + 1) return -1;
+    if (n == at + 1 && parse_num(f[at], PROFILE_MIN_PERIOD_MS, PROFILE_MAX_PERIOD_MS, &ms) != 0) return -1;
+    p->period = ms / 1000.0;
+    return 0;
+}
+
+/**
+ * @brief Interpreta a lista de níveis de um perfil em degraus ("25,50,100").
+ */
+static int parse_levels(char *s, load_profile_t *p){
+    p->level_count = 0;
+    for (char *tok = s, *next; tok; tok = next) {
+        next = strchr(tok, ',');
+        if (next) *next++ = '\0';
+        double pct;
+        if (p->level_count == PROFILE_MAX_STEPS || parse_num(tok, 0, 100, &pct) != 0) return -1;
+        p->levels[p->level_count++] = pct / 100.0;
+    }
+    return p->level_count > 0 ? 0 : -1;
+}
+
+int profile_parse(const char *spec, load_profile_t *p){
+    char buf[256];
+    if (!spec || !p || strlen(spec) >= sizeof(buf)) return -1;
+    memset(p, 0, sizeof(*p));
+    snprintf(buf, sizeof(buf), "%s", spec);
+
+    char *f[PROFILE_MAX_FIELDS];
+    int n = 0;
+    for (char *tok = buf, *next; tok; tok = next) {
+        if (n == PROFILE_MAX_FIELDS) return -1;
+        next = strchr(tok, ':');
+        if (next) *next++ = '\0';
+        f[n++] = tok;
+    }
+
+    double pct, to;
+    if (strcmp(f[0], "duty") == 0) {
+        if (n < 2 || parse_num(f[1], 0, 100, &pct) != 0) return -1;
+        p->kind = PROFILE_DUTY;
+        p->duty = pct / 100.0;
+        return parse_period(f, n, 2, p);
+    }
+    if (strcmp(f[0], "square") == 0) {
+        p->kind = PROFILE_SQUARE;
+        p->duty = 0.5;
+        return parse_period(f, n, 1, p);
+    }
+    if (strcmp(f[0], "ramp") == 0) {
+        if (n < 4 || parse_num(f[1], 0, 100, &pct) != 0 || parse_num(f[2], 0, 100, &to) != 0 ||
+            parse_num(f[3], 0, 1e9, &p->ramp_sec) != 0 || p->ramp_sec <= 0.0) {
+            return -1;
+        }
+        p->kind = PROFILE_RAMP;
+        p->from = pct / 100.0;
+        p->to = to / 100.0;
+        return parse_period(f, n, 4, p);
+    }
+    if (strcmp(f[0], "step") == 0) {
+        if (n < 3 || parse_levels(f[1], p) != 0 || parse_num(f[2], 0, 1e9, &p->hold_sec) != 0) return -1;
+        p->kind = PROFILE_STEP;
+        if (parse_period(f, n, 3, p) != 0) return -1;
+        return p->hold_sec >= p->period ? 0 : -1;
+    }
+    return -1;
+}
+
+double profile_level(const load_profile_t *p, double t){
+    if (!p) return 1.0;
+    if (t < 0.0) t = 0.0;
+    switch (p->kind) {
+        case PROFILE_DUTY:
+        case PROFILE_SQUARE:
+            return p->duty;
+        case PROFILE_RAMP:
+            if (t >= p->ramp_sec) return p->to;
+            return p->from + (p->to - p->from) * t / p->ramp_sec;
+        case PROFILE_STEP: {
+            // O instante de uma janela é k * period; a folga evita cair no degrau anterior por arredondamento.
+            unsigned long long step = (unsigned long long)(t / p->hold_sec + 1e-9);
+            return p->levels[step % (unsigned long long)p->level_count];
+        }
+        default:
+            return 1.0;
+    }
+}
+
+void profile_describe(const load_profile_t *p, char *buf, size_t len){
+    if (!buf || len == 0) return;
+    int ms = p ? (int)(p->period * 1000.0 + 0.5) : 0;
+    switch (p ? p->kind : PROFILE_NONE) {
+        case PROFILE_DUTY:
+            snprintf(buf, len, "ciclo de trabalho de %.0f%% em janelas de %d ms", p->duty * 100.0, ms);
+            break;
+        case PROFILE_SQUARE:
+            snprintf(buf, len, "onda quadrada de %d ms (50%%)", ms);
+            break;
+        case PROFILE_RAMP:
+            snprintf(buf, len, "rampa de %.0f%% a %.0f%% em %.0f s, janelas de %d ms",
+                     p->from * 100.0, p->to * 100.0, p->ramp_sec, ms);
+            break;
+        case PROFILE_STEP: {
+            size_t n = (size_t)snprintf(buf, len, "degraus de %.0f s:", p->hold_sec);
+            for (int i = 0; i < p->level_count && n < len; i++) {
+                n += (size_t)snprintf(buf + n, len - n, "%s%.0f%%", i ? "," : " ", p->levels[i] * 100.0);
+            }
+            if (n < len) snprintf(buf + n, len - n, ", janelas de %d ms", ms);
+            break;
+        }
+        default:
+            snprintf(buf, len, "carga contínua");
+            break;
+    }
+}
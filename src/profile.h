@@ -0,0 +1,78 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+/**
+ * @file profile.h
+ * @brief Declara os perfis de carga: ciclo de trabalho, rampa, degraus e onda quadrada.
+ *
+ * Um perfil define, a cada instante, o nível de carga entre 0 e 1. O nível é
+ * aplicado por modulação em janelas de `period` segundos alinhadas ao início do
+ * teste: em cada janela, todos os workers trabalham durante a fração `nível` do
+ * período e ficam ociosos no resto. As bordas são publicadas pela controladora
+ * (ver `core.c`), de modo que todos os workers sobem e descem juntos e a carga
+ * do sistema varia em degrau, como exige a validação de fontes e VRMs.
+ */
+
+#include "hardstress.h"
+
+/** @brief Máximo de níveis de um perfil em degraus. */
+#define PROFILE_MAX_STEPS 32
+/** @brief Período padrão das janelas de modulação, em milissegundos. */
+#define PROFILE_DEFAULT_PERIOD_MS 100
+/** @brief Menor período aceito, em milissegundos (um quantum de trabalho dura ~1 ms). */
+#define PROFILE_MIN_PERIOD_MS 10
+/** @brief Maior período aceito, em milissegundos. */
+#define PROFILE_MAX_PERIOD_MS 10000
+/** @brief Espera ativa antes de cada borda, em segundos, para absorver o atraso do timer do SO. */
+#define PROFILE_SPIN_SEC 200e-6
+/** @brief Maior sono contínuo de quem espera uma borda, para notar o fim do teste. */
+#define PROFILE_POLL_SEC 0.05
+
+/**
+ * @enum profile_kind_t
+ * @brief A forma do perfil.
+ */
+typedef enum {
+    PROFILE_NONE = 0,       ///< Carga contínua (sem perfil).
+    PROFILE_DUTY,           ///< Nível constante.
+    PROFILE_SQUARE,         ///< Onda quadrada: nível constante de 50%.
+    PROFILE_RAMP,           ///< Rampa linear de `from` a `to` em `ramp_sec`, mantendo `to` depois.
+    PROFILE_STEP            ///< Níveis em sequência, `hold_sec` cada, repetidos em ciclo.
+} profile_kind_t;
+
+/**
+ * @struct load_profile_t
+ * @brief Um perfil de carga já validado.
+ */
+typedef struct {
+    int kind;               ///< `profile_kind_t`.
+    double period;          ///< Período das janelas de modulação, em segundos.
+    double duty;            ///< Nível de `PROFILE_DUTY` e `PROFILE_SQUARE`.
+    double from, to;        ///< Níveis inicial e final de `PROFILE_RAMP`.
+    double ramp_sec;        ///< Duração da rampa, em segundos.
+    double levels[PROFILE_MAX_STEPS]; ///< Níveis de `PROFILE_STEP`.
+    int level_count;        ///< Entradas válidas em `levels`.
+    double hold_sec;        ///< Duração de cada degrau, em segundos.
+} load_profile_t;
+
+/**
+ * @brief Interpreta a especificação de um perfil.
+ *
+ * Formatos, com níveis em % e o período opcional em ms:
+ * `duty:PCT[:MS]`, `square[:MS]`, `ramp:DE:ATE:SEGUNDOS[:MS]` e
+ * `step:N1,N2,...:SEGUNDOS[:MS]`. Um degrau não pode ser mais curto que uma janela.
+ * @return 0 em caso de sucesso, -1 se a especificação for inválida.
+ */
+int profile_parse(const char *spec, load_profile_t *p);
+
+/**
+ * @brief O nível de carga (0 a 1) no instante `t`, em segundos desde a largada.
+ */
+double profile_level(const load_profile_t *p, double t);
+
+/**
+ * @brief Descreve o perfil em uma linha legível.
+ */
+void profile_describe(const load_profile_t *p, char *buf, size_t len);
+
+#endif // PROFILE_H
@@ -0,0 +1,147 @@
+#include "roles.h"
+#include "topology.h" // Para parse_cpu_list
+#include "kernels.h"  // Para kernel_name
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Nomes dos kernels na especificação, na ordem de `kernel_id_t`. */
+static const char *const ROLE_KERNELS[KERNEL_COUNT] = { "fpu", "int", "stream", "ptr", "atomic" };
+
+/* --- Static Function Prototypes --- */
+static int parse_kernel_set(const char *s, size_t len, unsigned *mask);
+static int assign_groups(char *spec, int threads, unsigned *masks, int *list, char *err, size_t err_len);
+static int assign_smt(unsigned defaults, const cpu_topology_t *topo, const int *cpus, int threads,
+                      unsigned *masks, char *err, size_t err_len);
+
+/**
+ * @brief Interpreta os `len` primeiros caracteres de `s` como nomes de kernels unidos por '+'.
+ */
+static int parse_kernel_set(const char *s, size_t len, unsigned *mask){
+    *mask = 0;
+    const char *end = s + len;
+    while (s < end) {
+        const char *plus = memchr(s, '+', (size_t)(end - s));
+        size_t n = plus ? (size_t)(plus - s) : (size_t)(end - s);
+        int k = 0;
+        while (k < KERNEL_COUNT && !(strlen(ROLE_KERNELS[k]) == n && strncmp(s, ROLE_KERNELS[k], n) == 0)) k++;
+        if (k == KERNEL_COUNT) return -1;
+        *mask |= 1u << k;
+        s += n + (plus ? 1 : 0);
+        if (plus && s == end) return -1;
+    }
+    return *mask ? 0 : -1;
+}
+
+/**
+ * @brief Aplica os grupos `KERNELS=WORKERS` separados por ';'; cada worker pode aparecer uma vez.
+ * @param list Espaço para `threads` + 1 índices.
+ */
+static int assign_groups(char *spec, int threads, unsigned *masks, int *list, char *err, size_t err_len){
+    unsigned *seen = calloc((size_t)threads, sizeof(unsigned));
+    if (!seen) {
+        snprintf(err, err_len, "falta de memória");
+        return -1;
+    }
+    int rc = -1;
+    for (char *group = spec, *next; group; group = next) {
+        next = strchr(group, ';');
+        if (next) *next++ = '\0';
+        char *eq = strchr(group, '=');
+        unsigned mask;
+        if (!eq || parse_kernel_set(group, (size_t)(eq - group), &mask) != 0) {
+            snprintf(err, err_len, "grupo inválido '%s' (esperado KERNELS=WORKERS, por exemplo fpu+int=0-7)", group);
+            goto done;
+        }
+        int n = parse_cpu_list(eq + 1, list, threads + 1);
+        if (n <= 0) {
+            snprintf(err, err_len, "lista de workers inválida '%s'", eq + 1);
+            goto done;
+        }
+        for (int i = 0; i < n; i++) {
+            if (list[i] >= threads) {
+                snprintf(err, err_len, "worker %d inexistente (há %d worker(s))", list[i], threads);
+                goto done;
+            }
+            if (seen[list[i]]) {
+                snprintf(err, err_len, "worker %d em mais de um grupo", list[i]);
+                goto done;
+            }
+            seen[list[i]] = 1;
+            masks[list[i]] = mask;
+        }
+    }
+    rc = 0;
+done:
+    free(seen);
+    return rc;
+}
+
+/**
+ * @brief Divide os kernels de `defaults` entre as threads SMT de cada núcleo.
+ */
+static int assign_smt(unsigned defaults, const cpu_topology_t *topo, const int *cpus, int threads,
+                      unsigned *masks, char *err, size_t err_len){
+    unsigned compute = defaults & ROLE_COMPUTE, memory = defaults & ROLE_MEMORY;
+    if (!compute || !memory) {
+        snprintf(err, err_len, "'smt' requer um kernel de computação (fpu, int) e um de memória (stream, ptr, atomic)");
+        return -1;
+    }
+    // Sem irmãos SMT entre os workers, a alternância pelo índice ainda mistura as cargas.
+    int siblings = 0;
+    for (int i = 0; topo && cpus && i < threads; i++) {
+        if (cpus[i] >= 0 && cpus[i] < topo->cpu_count && topo->cpu_smt[cpus[i]] > 0) siblings = 1;
+    }
+    for (int i = 0; i < threads; i++) {
+        int second = siblings ? (cpus[i] >= 0 && cpus[i] < topo->cpu_count && topo->cpu_smt[cpus[i]] > 0) : (i % 2);
+        masks[i] = second ? memory : compute;
+    }
+    return 0;
+}
+
+int roles_assign(const char *spec, unsigned defaults, const cpu_topology_t *topo, const int *cpus,
+                 int threads, unsigned *masks, char *err, size_t err_len){
+    if (!spec || !masks || threads <= 0 || !defaults) {
+        snprintf(err, err_len, "argumentos inválidos");
+        return -1;
+    }
+    for (int i = 0; i < threads; i++) masks[i] = defaults;
+    if (strcmp(spec, "smt") == 0) return assign_smt(defaults, topo, cpus, threads, masks, err, err_len);
+
+    char *copy = strdup(spec);
+    int *list = malloc(((size_t)threads + 1) * sizeof(int));
+    int rc = -1;
+    if (!copy || !list) snprintf(err, err_len, "falta de memória");
+    else rc = assign_groups(copy, threads, masks, list, err, err_len);
+    free(copy);
+    free(list);
+    return rc;
+}
+
+void roles_format(const unsigned *masks, int threads, char *buf, size_t len){
+    if (!buf || len == 0) return;
+    buf[0] = '\0';
+    size_t n = 0;
+    for (int i = 0; i < threads && n < len; i++) {
+        int first = 1;
+        for (int j = 0; j < i; j++) {
+            if (masks[j] == masks[i]) { first = 0; break; }
+        }
+        if (!first) continue;
+        n += (size_t)snprintf(buf + n, len - n, "%s", n ? " | " : "");
+        for (int k = 0, m = 0; k < KERNEL_COUNT && n < len; k++) {
+            if (masks[i] & (1u << k)) n += (size_t)snprintf(buf + n, len - n, "%s%s", m++ ? "+" : "", kernel_name(k));
+        }
+        // Os workers do grupo, com sequências consecutivas abreviadas em intervalos.
+        const char *sep = ": T";
+        for (int j = i; j < threads && n < len; j++) {
+            if (masks[j] != masks[i]) continue;
+            int last = j;
+            while (last + 1 < threads && masks[last + 1] == masks[i]) last++;
+            if (last > j) n += (size_t)snprintf(buf + n, len - n, "%s%d-%d", sep, j, last);
+            else n += (size_t)snprintf(buf + n, len - n, "%s%d", sep, j);
+            sep = ",";
+            j = last;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef ROLES_H
+#define ROLES_H
+
+/**
+ * @file roles.h
+ * @brief Declara os papéis dos workers: que kernels cada worker executa.
+ *
+ * Sem papéis, todo worker executa todos os kernels habilitados, um após o outro,
+ * e em cada instante todos os núcleos fazem a mesma coisa. Com papéis, conjuntos
+ * de workers recebem grupos de kernels diferentes (por exemplo, FPU em uns e
+ * STREAM em outros), de modo que as unidades de ponto flutuante, o controlador
+ * de memória e os caches são saturados ao mesmo tempo.
+ *
+ * Os papéis são descritos como máscaras de bits `1u << kernel_id_t`.
+ */
+
+#include "hardstress.h"
+
+/** @brief Kernels de computação, usados pela divisão automática `smt`. */
+#define ROLE_COMPUTE ((1u << KERNEL_FPU) | (1u << KERNEL_INT))
+/** @brief Kernels de memória, usados pela divisão automática `smt`. */
+#define ROLE_MEMORY ((1u << KERNEL_STREAM) | (1u << KERNEL_PTR) | (1u << KERNEL_ATOMIC))
+
+/**
+ * @brief Atribui os kernels de cada worker a partir da especificação de papéis.
+ *
+ * A especificação é `smt` ou uma lista de grupos separados por ';', cada um no
+ * formato `KERNELS=WORKERS`, em que KERNELS são nomes unidos por '+' (fpu, int,
+ * stream, ptr, atomic) e WORKERS é uma lista de índices de workers no formato de
+ * `parse_cpu_list` (por exemplo, `fpu=0-15;stream=16-31;ptr+int=32-47`). Workers
+ * fora de todos os grupos executam `defaults`.
+ *
+ * Com `smt`, os kernels de computação de `defaults` vão para a primeira thread de
+ * cada núcleo e os de memória para as demais; se nenhum par de workers dividir um
+ * núcleo (ou sem fixação), os workers alternam pelo índice.
+ *
+ * @param spec A especificação.
+ * @param defaults Os kernels dos workers sem papel (máscara não vazia).
+ * @param topo A topologia, ou NULL para tratar os workers como sem fixação.
+ * @param cpus A CPU de cada worker (-1 = sem fixação), ou NULL.
+ * @param threads O número de workers.
+ * @param masks Recebe os kernels de cada worker (`threads` entradas).
+ * @param err Recebe a descrição do erro.
+ * @return 0 em caso de sucesso, -1 se a especificação for inválida.
+ */
+int roles_assign(const char *spec, unsigned defaults, const cpu_topology_t *topo, const int *cpus,
+                 int threads, unsigned *masks, char *err, size_t err_len);
+
+/**
+ * @brief Formata os papéis, agrupando os workers de mesma máscara ("FPU+INT: T0-15 | STREAM: T16-31").
+ */
+void roles_format(const unsigned *masks, int threads, char *buf, size_t len);
+
+#endif // ROLES_H
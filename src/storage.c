@@ -0,0 +1,666 @@
+#include "storage.h"
+#include "utils.h"   // Para now_sec, splitmix64, aligned_calloc e as threads
+#include <errno.h>
+
+#ifdef _WIN32
+#include <winioctl.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#if defined(__linux__)
+#include <linux/fs.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define HAVE_IO_URING 1
+#endif
+#endif
+#endif
+#ifndef O_DIRECT
+#define O_DIRECT 0
+#endif
+#endif
+
+/** @brief Erros de E/S após os quais o motor para de submeter (o alvo provavelmente falhou). */
+#define IO_ERROR_LIMIT 1000
+
+/**
+ * @brief Uma operação em voo.
+ */
+typedef struct {
+#ifdef _WIN32
+    OVERLAPPED ov;          ///< Primeiro membro: a conclusão devolve o endereço da operação.
+#endif
+    double t0;              ///< Instante da submissão (`now_sec`).
+    int write;              ///< 1 = escrita, 0 = leitura.
+    unsigned long long off; ///< Offset no alvo, em bytes.
+#ifdef HAVE_IO_URING
+    struct iovec iov;       ///< Buffer da operação, para as variantes vetoriais sem buffers registrados.
+#endif
+} io_slot_t;
+
+/**
+ * @brief Estado do sistema operacional do motor (`io_engine_t::sys`).
+ */
+typedef struct {
+#ifdef _WIN32
+    HANDLE h;               ///< Arquivo ou dispositivo.
+    HANDLE port;            ///< Porta de conclusão.
+#else
+    int fd;                 ///< Arquivo ou dispositivo.
+#endif
+#ifdef HAVE_IO_URING
+    int ring_fd;            ///< Descritor do io_uring (-1 = sem io_uring).
+    void *sq_ring, *cq_ring;///< Anéis de submissão e de conclusão mapeados.
+    size_t sq_ring_sz, cq_ring_sz;
+    struct io_uring_sqe *sqes; ///< Entradas de submissão mapeadas.
+    size_t sqes_sz;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+#endif
+    io_slot_t *slots;       ///< `qd` operações.
+    int *free_slots;        ///< Pilha de operações livres.
+    int free_count;
+    uint64_t rng;           ///< Estado do gerador de offsets e da mistura leitura/escrita.
+} io_sys_t;
+
+/* --- Static Function Prototypes --- */
+static void count(atomic_ullong *c, unsigned long long n);
+static void next_op(io_engine_t *e, io_sys_t *s, io_slot_t *slot);
+static void complete_op(io_engine_t *e, io_slot_t *slot, long long res, int err);
+static int open_target(io_engine_t *e, io_sys_t *s, const io_options_t *o, unsigned long long *have, char *err, size_t err_len);
+static int write_at(io_sys_t *s, const void *buf, size_t len, unsigned long long off);
+static int prefill(io_engine_t *e, io_sys_t *s, unsigned long long from, atomic_int *running);
+static void close_target(io_sys_t *s);
+static thread_return_t THREAD_CALL engine_main(void *arg);
+#ifdef _WIN32
+static void run_iocp(io_engine_t *e, io_sys_t *s);
+#else
+static void run_sync(io_engine_t *e, io_sys_t *s);
+#endif
+#ifdef HAVE_IO_URING
+static int uring_setup(io_engine_t *e, io_sys_t *s);
+static void uring_teardown(io_sys_t *s);
+static void run_uring(io_engine_t *e, io_sys_t *s);
+#endif
+
+/* --- Operações --- */
+
+/**
+ * @brief Incrementa um contador escrito apenas pela thread do motor.
+ */
+static void count(atomic_ullong *c, unsigned long long n){
+    atomic_store_explicit(c, atomic_load_explicit(c, memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+/**
+ * @brief Sorteia o offset e o tipo da próxima operação e marca o instante da submissão.
+ */
+static void next_op(io_engine_t *e, io_sys_t *s, io_slot_t *slot){
+    uint64_t r = splitmix64(&s->rng);
+    unsigned long long blocks = e->size / e->block;
+    slot->off = (r % blocks) * e->block;
+    slot->write = (int)((r >> 40) % 100) >= e->read_pct;
+    slot->t0 = now_sec();
+}
+
+/**
+ * @brief Contabiliza uma operação concluída.
+ * @param res Bytes transferidos (negativo em caso de erro).
+ * @param err Código de erro do sistema quando `res` < 0.
+ */
+static void complete_op(io_engine_t *e, io_slot_t *slot, long long res, int err){
+    double ns = (now_sec() - slot->t0) * 1e9;
+    if (res != (long long)e->block) {
+        if (res < 0) e->last_errno = err;
+        count(&e->errors, 1);
+        return;
+    }
+    count(slot->write ? &e->writes : &e->reads, 1);
+    count(&e->bytes, e->block);
+    lat_hist_record(e->hist, ns > 0.0 ? (unsigned long long)ns : 0);
+}
+
+/* --- Alvo --- */
+
+#ifdef _WIN32
+
+static int open_target(io_engine_t *e, io_sys_t *s, const io_options_t *o, unsigned long long *have, char *err, size_t err_len){
+    DWORD attr = GetFileAttributesA(o->path);
+    e->device = strncmp(o->path, "\\\\.\\", 4) == 0;
+    if (!e->device && attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY)) {
+        snprintf(e->path, sizeof(e->path), "%s\\hardstress-io-%lu.dat", o->path, (unsigned long)GetCurrentProcessId());
+        attr = INVALID_FILE_ATTRIBUTES;
+    } else {
+        snprintf(e->path, sizeof(e->path), "%s", o->path);
+    }
+    e->created = !e->device && attr == INVALID_FILE_ATTRIBUTES;
+    // Só o arquivo criado pelo motor é escrito livremente; escrever em um alvo que já existia destrói o conteúdo.
+    if (!e->created && o->read_pct < 100 && !o->destructive_writes) {
+        snprintf(err, err_len, "escritas em '%s' destruiriam o conteúdo %s", e->path, e->device ? "do dispositivo" : "do arquivo");
+        return -1;
+    }
+    DWORD access = GENERIC_READ | (o->read_pct < 100 || e->created ? GENERIC_WRITE : 0);
+    // O arquivo criado pelo motor some quando o handle é fechado, mesmo se o processo for interrompido.
+    DWORD flags = FILE_FLAG_OVERLAPPED | FILE_FLAG_NO_BUFFERING | (e->created ? FILE_FLAG_DELETE_ON_CLOSE : 0);
+    DWORD disposition = e->created ? CREATE_NEW : OPEN_EXISTING;
+    e->direct = 1;
+    s->h = CreateFileA(e->path, access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, disposition, flags, NULL);
+    if (s->h == INVALID_HANDLE_VALUE && GetLastError() == ERROR_INVALID_PARAMETER) {
+        e->direct = 0;
+        s->h = CreateFileA(e->path, access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, disposition,
+                           flags & ~(DWORD)FILE_FLAG_NO_BUFFERING, NULL);
+    }
+    if (s->h == INVALID_HANDLE_VALUE) {
+        snprintf(err, err_len, "não foi possível abrir '%s' (erro %lu)", e->path, (unsigned long)GetLastError());
+        return -1;
+    }
+
+    if (e->device) {
+        GET_LENGTH_INFORMATION len;
+        DWORD got;
+        if (!DeviceIoControl(s->h, IOCTL_DISK_GET_LENGTH_INFO, NULL, 0, &len, sizeof(len), &got, NULL)) {
+            snprintf(err, err_len, "não foi possível obter o tamanho de '%s'", e->path);
+            return -1;
+        }
+        e->size = (unsigned long long)len.Length.QuadPart;
+        *have = e->size;
+        return 0;
+    }
+    LARGE_INTEGER cur;
+    *have = GetFileSizeEx(s->h, &cur) ? (unsigned long long)cur.QuadPart : 0;
+    if (!e->created && o->read_pct == 100) {
+        // Um arquivo existente só lido é usado como está, sem estender.
+        e->size = *have;
+        return 0;
+    }
+    e->size = o->file_mib * 1024ull * 1024ull;
+    if (*have >= e->size) return 0;
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)e->size;
+    if (!SetFilePointerEx(s->h, end, NULL, FILE_BEGIN) || !SetEndOfFile(s->h)) {
+        snprintf(err, err_len, "não foi possível estender '%s' para %zu MiB", e->path, o->file_mib);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Escrita síncrona usada no preenchimento, antes de o handle ser associado à porta.
+ */
+static int write_at(io_sys_t *s, const void *buf, size_t len, unsigned long long off){
+    OVERLAPPED ov;
+    memset(&ov, 0, sizeof(ov));
+    ov.Offset = (DWORD)off;
+    ov.OffsetHigh = (DWORD)(off >> 32);
+    DWORD done = 0;
+    if (!WriteFile(s->h, buf, (DWORD)len, NULL, &ov) && GetLastError() != ERROR_IO_PENDING) return -1;
+    if (!GetOverlappedResult(s->h, &ov, &done, TRUE) || done != len) return -1;
+    return 0;
+}
+
+static void close_target(io_sys_t *s){
+    if (s->port) CloseHandle(s->port);
+    if (s->h && s->h != INVALID_HANDLE_VALUE) CloseHandle(s->h);
+}
+
+#else
+
+static int open_target(io_engine_t *e, io_sys_t *s, const io_options_t *o, unsigned long long *have, char *err, size_t err_len){
+    struct stat st;
+    int exists = stat(o->path, &st) == 0;
+    if (exists && S_ISDIR(st.st_mode)) {
+        snprintf(e->path, sizeof(e->path), "%s/hardstress-io-%ld.dat", o->path, (long)getpid());
+        exists = 0;
+    } else {
+        snprintf(e->path, sizeof(e->path), "%s", o->path);
+    }
+    e->device = exists && S_ISBLK(st.st_mode);
+    if (exists && !e->device && !S_ISREG(st.st_mode)) {
+        snprintf(err, err_len, "'%s' não é um arquivo, diretório ou dispositivo de bloco", e->path);
+        return -1;
+    }
+    // Só o arquivo criado pelo motor é escrito livremente; escrever em um alvo que já existia destrói o conteúdo.
+    if (exists && o->read_pct < 100 && !o->destructive_writes) {
+        snprintf(err, err_len, "escritas em '%s' destruiriam o conteúdo %s", e->path, e->device ? "do dispositivo" : "do arquivo");
+        return -1;
+    }
+
+    int flags = (exists && o->read_pct == 100) ? O_RDONLY : O_RDWR;
+    if (!exists) flags |= O_CREAT | O_EXCL;
+    e->direct = O_DIRECT != 0;
+    s->fd = open(e->path, flags | O_DIRECT, 0600);
+    if (s->fd < 0 && errno == EINVAL && O_DIRECT != 0) {
+        // Sistemas de arquivos sem E/S direta recusam O_DIRECT; o arquivo pode já ter sido criado.
+        e->direct = 0;
+        s->fd = open(e->path, flags & ~O_EXCL, 0600);
+    }
+    if (s->fd < 0) {
+        snprintf(err, err_len, "não foi possível abrir '%s': %s", e->path, strerror(errno));
+        return -1;
+    }
+    if (!exists) {
+        // Removido já aberto: um teste interrompido não deixa o arquivo para trás.
+        unlink(e->path);
+        e->created = 1;
+    }
+
+    if (e->device) {
+#ifdef BLKGETSIZE64
+        uint64_t bytes = 0;
+        if (ioctl(s->fd, BLKGETSIZE64, &bytes) == 0) e->size = bytes;
+#endif
+        if (e->size == 0) {
+            off_t end = lseek(s->fd, 0, SEEK_END);
+            e->size = end > 0 ? (unsigned long long)end : 0;
+        }
+        *have = e->size;
+        return 0;
+    }
+    *have = exists ? (unsigned long long)st.st_size : 0;
+    if (exists && o->read_pct == 100) {
+        // Um arquivo existente só lido é usado como está, sem estender.
+        e->size = *have;
+        return 0;
+    }
+    e->size = o->file_mib * 1024ull * 1024ull;
+    if (*have < e->size && ftruncate(s->fd, (off_t)e->size) != 0) {
+        snprintf(err, err_len, "não foi possível estender '%s' para %zu MiB: %s", e->path, o->file_mib, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+static int write_at(io_sys_t *s, const void *buf, size_t len, unsigned long long off){
+    return pwrite(s->fd, buf, len, (off_t)off) == (ssize_t)len ? 0 : -1;
+}
+
+static void close_target(io_sys_t *s){
+    if (s->fd >= 0) close(s->fd);
+}
+
+#endif
+
+/**
+ * @brief Preenche o alvo de `from` até o fim, em blocos de `qd * block` bytes.
+ *
+ * Sem isso, as leituras de um arquivo recém-estendido caem em regiões esparsas,
+ * que o sistema de arquivos responde sem tocar o disco.
+ *
+ * @return 0 em caso de sucesso, -1 em erro de escrita ou se `running` foi zerado.
+ */
+static int prefill(io_engine_t *e, io_sys_t *s, unsigned long long from, atomic_int *running){
+    size_t chunk = (size_t)e->qd * e->block;
+    for (unsigned long long off = from - from % e->block; off < e->size; off += chunk) {
+        if (running && !atomic_load(running)) return -1;
+        size_t n = e->size - off < chunk ? (size_t)(e->size - off) : chunk;
+        if (write_at(s, e->bufs, n, off) != 0) return -1;
+    }
+    return 0;
+}
+
+/* --- Ciclo de Vida --- */
+
+io_engine_t *io_engine_open(const io_options_t *o, atomic_int *running, char *err, size_t err_len){
+    err[0] = '\0';
+    if (!o || !o->path || !*o->path || o->qd < 1 || o->qd > IO_MAX_QD || o->block_kib < 4 ||
+        o->block_kib > IO_MAX_BLOCK_KIB || o->block_kib % 4 != 0 || o->read_pct < 0 || o->read_pct > 100) {
+        snprintf(err, err_len, "parâmetros de E/S inválidos");
+        return NULL;
+    }
+    io_engine_t *e = aligned_calloc(1, sizeof(*e), WORKER_ALIGN);
+    io_sys_t *s = calloc(1, sizeof(*s));
+    if (!e || !s) {
+        aligned_free(e);
+        free(s);
+        snprintf(err, err_len, "falta de memória");
+        return NULL;
+    }
+    e->sys = s;
+    e->running = running;
+    e->block = o->block_kib * 1024;
+    e->qd = o->qd;
+    e->read_pct = o->read_pct;
+#ifdef _WIN32
+    s->h = INVALID_HANDLE_VALUE;
+    e->backend = IO_BACKEND_IOCP;
+#else
+    s->fd = -1;
+    e->backend = IO_BACKEND_SYNC;
+#endif
+#ifdef HAVE_IO_URING
+    s->ring_fd = -1;
+#endif
+    s->rng = (uint64_t)(now_sec() * 1e9) ^ (uint64_t)(uintptr_t)e;
+
+    e->bufs = aligned_calloc((size_t)e->qd, e->block, IO_ALIGN);
+    s->slots = calloc((size_t)e->qd, sizeof(io_slot_t));
+    s->free_slots = calloc((size_t)e->qd, sizeof(int));
+    if (!e->bufs || !s->slots || !s->free_slots) {
+        snprintf(err, err_len, "falta de memória para %d buffer(s) de %zu KiB", e->qd, o->block_kib);
+        io_engine_close(e);
+        return NULL;
+    }
+    // Conteúdo aleatório, para que controladores com compressão ou deduplicação não encurtem as escritas.
+    uint64_t fill = s->rng;
+    for (size_t i = 0; i + sizeof(uint64_t) <= (size_t)e->qd * e->block; i += sizeof(uint64_t)) {
+        uint64_t v = splitmix64(&fill);
+        memcpy(e->bufs + i, &v, sizeof(v));
+    }
+    for (int i = 0; i < e->qd; i++) s->free_slots[i] = e->qd - 1 - i;
+    s->free_count = e->qd;
+
+    unsigned long long have = 0;
+    if (open_target(e, s, o, &have, err, err_len) != 0) {
+        io_engine_close(e);
+        return NULL;
+    }
+    e->size -= e->size % e->block;
+    if (e->size < e->block) {
+        snprintf(err, err_len, "'%s' é menor que um bloco de %zu KiB", e->path, o->block_kib);
+        io_engine_close(e);
+        return NULL;
+    }
+    if (!e->device && have < e->size && prefill(e, s, have, running) != 0) {
+        snprintf(err, err_len, "falha ao preencher '%s'", e->path);
+        io_engine_close(e);
+        return NULL;
+    }
+
+#ifdef _WIN32
+    s->port = CreateIoCompletionPort(s->h, NULL, 0, 1);
+    if (!s->port) {
+        snprintf(err, err_len, "não foi possível criar a porta de conclusão (erro %lu)", (unsigned long)GetLastError());
+        io_engine_close(e);
+        return NULL;
+    }
+#elif defined(HAVE_IO_URING)
+    if (uring_setup(e, s) == 0) e->backend = IO_BACKEND_URING;
+#endif
+    return e;
+}
+
+int io_engine_start(io_engine_t *e){
+    if (!e) return -1;
+    if (thread_create(&e->thread, engine_main, e) != 0) return -1;
+    e->started = 1;
+    return 0;
+}
+
+void io_engine_join(io_engine_t *e){
+    if (!e || !e->started) return;
+    thread_join(e->thread);
+    e->started = 0;
+}
+
+void io_engine_close(io_engine_t *e){
+    if (!e) return;
+    io_engine_join(e);
+    io_sys_t *s = (io_sys_t*)e->sys;
+    if (s) {
+#ifdef HAVE_IO_URING
+        uring_teardown(s);
+#endif
+        close_target(s);
+        free(s->slots);
+        free(s->free_slots);
+        free(s);
+    }
+    aligned_free(e->bufs);
+    aligned_free(e);
+}
+
+void io_engine_sample(io_engine_t *e, double dt, io_stats_t *out){
+    memset(out, 0, sizeof(*out));
+    if (!e) return;
+    unsigned long long ops = atomic_load_explicit(&e->reads, memory_order_relaxed) +
+                             atomic_load_explicit(&e->writes, memory_order_relaxed);
+    unsigned long long bytes = atomic_load_explicit(&e->bytes, memory_order_relaxed);
+    lat_hist_delta(e->hist, e->hist_last, e->hist_interval);
+    if (dt > 0.0) {
+        out->iops = (double)(ops - e->ops_last) / dt;
+        out->mbps = (double)(bytes - e->bytes_last) / dt / 1e6;
+    }
+    e->ops_last = ops;
+    e->bytes_last = bytes;
+    out->p50_us = lat_hist_percentile(e->hist_interval, 50.0) / 1e3;
+    out->p99_us = lat_hist_percentile(e->hist_interval, 99.0) / 1e3;
+    out->p999_us = lat_hist_percentile(e->hist_interval, 99.9) / 1e3;
+}
+
+void io_engine_totals(io_engine_t *e, io_totals_t *out){
+    memset(out, 0, sizeof(*out));
+    if (!e) return;
+    unsigned long long hist[LAT_HIST_BUCKETS];
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++) hist[i] = atomic_load(&e->hist[i]);
+    out->reads = atomic_load(&e->reads);
+    out->writes = atomic_load(&e->writes);
+    out->errors = atomic_load(&e->errors);
+    out->seconds = e->run_end > e->run_start ? e->run_end - e->run_start : 0.0;
+    if (out->seconds > 0.0) {
+        out->rate.iops = (double)(out->reads + out->writes) / out->seconds;
+        out->rate.mbps = (double)atomic_load(&e->bytes) / out->seconds / 1e6;
+    }
+    out->rate.p50_us = lat_hist_percentile(hist, 50.0) / 1e3;
+    out->rate.p99_us = lat_hist_percentile(hist, 99.0) / 1e3;
+    out->rate.p999_us = lat_hist_percentile(hist, 99.9) / 1e3;
+    out->max_us = lat_hist_max(hist) / 1e3;
+}
+
+const char *io_backend_name(int backend){
+    switch (backend) {
+    case IO_BACKEND_URING: return "io_uring";
+    case IO_BACKEND_IOCP: return "IOCP";
+    default: return "pread/pwrite";
+    }
+}
+
+/* --- Thread do Motor --- */
+
+static thread_return_t THREAD_CALL engine_main(void *arg){
+    io_engine_t *e = (io_engine_t*)arg;
+    io_sys_t *s = (io_sys_t*)e->sys;
+    e->run_start = now_sec();
+#ifdef _WIN32
+    run_iocp(e, s);
+#elif defined(HAVE_IO_URING)
+    if (e->backend == IO_BACKEND_URING) run_uring(e, s);
+    else run_sync(e, s);
+#else
+    run_sync(e, s);
+#endif
+    e->run_end = now_sec();
+    return 0;
+}
+
+#ifdef _WIN32
+
+/**
+ * @brief Laço IOCP: mantém `qd` operações sobrepostas e colhe as conclusões da porta.
+ */
+static void run_iocp(io_engine_t *e, io_sys_t *s){
+    int inflight = 0;
+    for (;;) {
+        int run = atomic_load(e->running) && atomic_load_explicit(&e->errors, memory_order_relaxed) < IO_ERROR_LIMIT;
+        while (run && s->free_count > 0) {
+            int k = s->free_slots[--s->free_count];
+            io_slot_t *slot = &s->slots[k];
+            next_op(e, s, slot);
+            memset(&slot->ov, 0, sizeof(slot->ov));
+            slot->ov.Offset = (DWORD)slot->off;
+            slot->ov.OffsetHigh = (DWORD)(slot->off >> 32);
+            uint8_t *buf = e->bufs + (size_t)k * e->block;
+            BOOL ok = slot->write ? WriteFile(s->h, buf, (DWORD)e->block, NULL, &slot->ov)
+                                  : ReadFile(s->h, buf, (DWORD)e->block, NULL, &slot->ov);
+            if (!ok && GetLastError() != ERROR_IO_PENDING) {
+                // Falha na submissão: não haverá pacote de conclusão para esta operação.
+                complete_op(e, slot, -1, (int)GetLastError());
+                s->free_slots[s->free_count++] = k;
+                break;
+            }
+            inflight++;
+        }
+        if (inflight == 0) {
+            if (!run) break;
+            continue;
+        }
+        DWORD bytes = 0;
+        ULONG_PTR key;
+        LPOVERLAPPED ov = NULL;
+        BOOL ok = GetQueuedCompletionStatus(s->port, &bytes, &key, &ov, 100);
+        if (!ov) continue;
+        io_slot_t *slot = (io_slot_t*)ov;
+        complete_op(e, slot, ok ? (long long)bytes : -1, ok ? 0 : (int)GetLastError());
+        s->free_slots[s->free_count++] = (int)(slot - s->slots);
+        inflight--;
+    }
+}
+
+#else
+
+/**
+ * @brief Laço síncrono: uma operação por vez com `pread`/`pwrite`.
+ */
+static void run_sync(io_engine_t *e, io_sys_t *s){
+    io_slot_t *slot = &s->slots[0];
+    while (atomic_load(e->running) && atomic_load_explicit(&e->errors, memory_order_relaxed) < IO_ERROR_LIMIT) {
+        next_op(e, s, slot);
+        ssize_t r = slot->write ? pwrite(s->fd, e->bufs, e->block, (off_t)slot->off)
+                                : pread(s->fd, e->bufs, e->block, (off_t)slot->off);
+        complete_op(e, slot, (long long)r, r < 0 ? errno : 0);
+    }
+}
+
+#endif
+
+#ifdef HAVE_IO_URING
+
+/**
+ * @brief Cria o io_uring, mapeia os anéis e registra os buffers.
+ * @return 0 em caso de sucesso, -1 se o io_uring não estiver disponível.
+ */
+static int uring_setup(io_engine_t *e, io_sys_t *s){
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    s->ring_fd = (int)syscall(__NR_io_uring_setup, (unsigned)e->qd, &p);
+    if (s->ring_fd < 0) return -1;
+
+    s->sq_ring_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    s->cq_ring_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    int single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && s->cq_ring_sz > s->sq_ring_sz) s->sq_ring_sz = s->cq_ring_sz;
+    s->sq_ring = mmap(NULL, s->sq_ring_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, s->ring_fd, IORING_OFF_SQ_RING);
+    if (s->sq_ring == MAP_FAILED) { s->sq_ring = NULL; goto fail; }
+    if (single) {
+        s->cq_ring = s->sq_ring;
+        s->cq_ring_sz = 0;
+    } else {
+        s->cq_ring = mmap(NULL, s->cq_ring_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, s->ring_fd, IORING_OFF_CQ_RING);
+        if (s->cq_ring == MAP_FAILED) { s->cq_ring = NULL; goto fail; }
+    }
+    s->sqes_sz = p.sq_entries * sizeof(struct io_uring_sqe);
+    s->sqes = mmap(NULL, s->sqes_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, s->ring_fd, IORING_OFF_SQES);
+    if (s->sqes == MAP_FAILED) { s->sqes = NULL; goto fail; }
+
+    uint8_t *sq = (uint8_t*)s->sq_ring, *cq = (uint8_t*)s->cq_ring;
+    s->sq_tail = (unsigned*)(sq + p.sq_off.tail);
+    s->sq_mask = (unsigned*)(sq + p.sq_off.ring_mask);
+    s->sq_array = (unsigned*)(sq + p.sq_off.array);
+    s->cq_head = (unsigned*)(cq + p.cq_off.head);
+    s->cq_tail = (unsigned*)(cq + p.cq_off.tail);
+    s->cq_mask = (unsigned*)(cq + p.cq_off.ring_mask);
+    s->cqes = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+
+    // Buffers registrados evitam fixar as páginas a cada operação; sem limite de memória travada, usa iovecs.
+    for (int i = 0; i < e->qd; i++) {
+        s->slots[i].iov.iov_base = e->bufs + (size_t)i * e->block;
+        s->slots[i].iov.iov_len = e->block;
+    }
+    struct iovec *iov = calloc((size_t)e->qd, sizeof(struct iovec));
+    if (iov) {
+        for (int i = 0; i < e->qd; i++) iov[i] = s->slots[i].iov;
+        e->fixed_bufs = syscall(__NR_io_uring_register, s->ring_fd, IORING_REGISTER_BUFFERS, iov, (unsigned)e->qd) == 0;
+        free(iov);
+    }
+    return 0;
+
+fail:
+    uring_teardown(s);
+    return -1;
+}
+
+static void uring_teardown(io_sys_t *s){
+    if (s->sqes) munmap(s->sqes, s->sqes_sz);
+    if (s->cq_ring && s->cq_ring != s->sq_ring) munmap(s->cq_ring, s->cq_ring_sz);
+    if (s->sq_ring) munmap(s->sq_ring, s->sq_ring_sz);
+    s->sqes = NULL;
+    s->sq_ring = s->cq_ring = NULL;
+    if (s->ring_fd >= 0) close(s->ring_fd);
+    s->ring_fd = -1;
+}
+
+/**
+ * @brief Laço io_uring: enche o anel de submissão até `qd` operações e espera ao menos uma conclusão.
+ */
+static void run_uring(io_engine_t *e, io_sys_t *s){
+    unsigned inflight = 0, unsubmitted = 0;
+    for (;;) {
+        int run = atomic_load(e->running) && atomic_load_explicit(&e->errors, memory_order_relaxed) < IO_ERROR_LIMIT;
+        unsigned tail = *s->sq_tail;
+        while (run && s->free_count > 0) {
+            int k = s->free_slots[--s->free_count];
+            io_slot_t *slot = &s->slots[k];
+            next_op(e, s, slot);
+            unsigned idx = tail & *s->sq_mask;
+            struct io_uring_sqe *sqe = &s->sqes[idx];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->fd = s->fd;
+            sqe->off = slot->off;
+            sqe->user_data = (unsigned long long)k;
+            if (e->fixed_bufs) {
+                sqe->opcode = slot->write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+                sqe->addr = (unsigned long long)(uintptr_t)slot->iov.iov_base;
+                sqe->len = (unsigned)e->block;
+                sqe->buf_index = (unsigned short)k;
+            } else {
+                sqe->opcode = slot->write ? IORING_OP_WRITEV : IORING_OP_READV;
+                sqe->addr = (unsigned long long)(uintptr_t)&slot->iov;
+                sqe->len = 1;
+            }
+            s->sq_array[idx] = idx;
+            tail++;
+            unsubmitted++;
+            inflight++;
+        }
+        __atomic_store_n(s->sq_tail, tail, __ATOMIC_RELEASE);
+        if (inflight == 0) break;
+
+        int r = (int)syscall(__NR_io_uring_enter, s->ring_fd, unsubmitted, 1u, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (r < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+            // O anel deixou de funcionar; as operações em voo são canceladas ao fechá-lo.
+            e->last_errno = errno;
+            count(&e->errors, inflight);
+            break;
+        }
+        unsubmitted -= (unsigned)r < unsubmitted ? (unsigned)r : unsubmitted;
+
+        unsigned head = *s->cq_head;
+        unsigned ctail = __atomic_load_n(s->cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != ctail; head++) {
+            struct io_uring_cqe *cqe = &s->cqes[head & *s->cq_mask];
+            int k = (int)cqe->user_data;
+            complete_op(e, &s->slots[k], cqe->res, cqe->res < 0 ? -cqe->res : 0);
+            s->free_slots[s->free_count++] = k;
+            inflight--;
+        }
+        __atomic_store_n(s->cq_head, head, __ATOMIC_RELEASE);
+    }
+}
+
+#endif
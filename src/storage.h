@@ -0,0 +1,168 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+/**
+ * @file storage.h
+ * @brief Declara o motor de estresse de E/S de armazenamento.
+ *
+ * Os kernels dos workers só exercitam CPU e memória. O motor de E/S roda em uma
+ * thread própria, ao lado deles, e mantém `qd` operações de `block` bytes em voo
+ * sobre um arquivo ou dispositivo, em offsets aleatórios alinhados, com a
+ * proporção de leituras pedida. No Linux a submissão é assíncrona via io_uring
+ * (chamadas de sistema diretas, sem liburing), com os buffers registrados no
+ * kernel; no Windows, E/S sobreposta com uma porta de conclusão (IOCP). Em ambos
+ * o cache de páginas é contornado (`O_DIRECT` / `FILE_FLAG_NO_BUFFERING`), com
+ * buffers alinhados a `IO_ALIGN`. Onde o io_uring não está disponível (kernel
+ * antigo, seccomp), o motor recai em `pread`/`pwrite` síncronos, com uma
+ * operação em voo.
+ *
+ * Os contadores e o histograma de latências (`lathist.h`) são cumulativos e escritos apenas
+ * pela thread do motor; o amostrador calcula IOPS, MB/s e percentis de cada
+ * intervalo pela diferença entre duas leituras.
+ */
+
+#include "hardstress.h"
+#include "lathist.h"
+
+/** @brief Profundidade de fila padrão (operações em voo). */
+#define IO_DEFAULT_QD 32
+/** @brief Maior profundidade de fila aceita. */
+#define IO_MAX_QD 1024
+/** @brief Tamanho de bloco padrão, em KiB. */
+#define IO_DEFAULT_BLOCK_KIB 4
+/** @brief Maior tamanho de bloco aceito, em KiB. */
+#define IO_MAX_BLOCK_KIB 4096
+/** @brief Tamanho padrão do arquivo de teste criado pelo motor, em MiB. */
+#define IO_DEFAULT_FILE_MIB 1024
+/** @brief Proporção padrão de leituras, em %. */
+#define IO_DEFAULT_READ_PCT 70
+/** @brief Alinhamento de buffers, offsets e tamanhos exigido pela E/S direta. */
+#define IO_ALIGN 4096
+/**
+ * @enum io_backend_t
+ * @brief Mecanismo de submissão usado pelo motor.
+ */
+typedef enum {
+    IO_BACKEND_SYNC = 0,    ///< `pread`/`pwrite` síncronos, uma operação em voo.
+    IO_BACKEND_URING,       ///< io_uring (Linux).
+    IO_BACKEND_IOCP         ///< E/S sobreposta com porta de conclusão (Windows).
+} io_backend_t;
+
+/**
+ * @struct io_options_t
+ * @brief Parâmetros do motor de E/S.
+ */
+typedef struct {
+    const char *path;       ///< Arquivo, diretório (cria um arquivo temporário nele) ou dispositivo.
+    size_t file_mib;        ///< Tamanho do arquivo de teste, em MiB (ignorado para dispositivos e arquivos existentes só lidos).
+    size_t block_kib;       ///< Tamanho de cada operação, em KiB (múltiplo de 4).
+    int qd;                 ///< Operações em voo.
+    int read_pct;           ///< Proporção de leituras, em % (0 a 100).
+    int destructive_writes; ///< Não-zero permite escritas em um arquivo ou dispositivo que já existia (destrói o conteúdo).
+} io_options_t;
+
+/**
+ * @struct io_engine_t
+ * @brief Estado do motor de E/S.
+ */
+struct io_engine_t {
+    /* --- Configuração (somente leitura durante o teste) --- */
+    char path[512];         ///< Caminho efetivamente aberto.
+    int backend;            ///< `io_backend_t` em uso.
+    int direct;             ///< 1 se o cache de páginas é contornado.
+    int device;             ///< 1 se o alvo é um dispositivo de bloco.
+    int created;            ///< 1 se o arquivo foi criado pelo motor (e é removido ao fechar).
+    int fixed_bufs;         ///< 1 se os buffers estão registrados no io_uring.
+    unsigned long long size;///< Bytes do alvo usados pelos offsets.
+    size_t block;           ///< Bytes por operação.
+    int qd;                 ///< Operações em voo.
+    int read_pct;           ///< Proporção de leituras, em %.
+    uint8_t *bufs;          ///< `qd` buffers de `block` bytes, alinhados a `IO_ALIGN`.
+    void *sys;              ///< Estado do sistema operacional (descritor, anel ou porta; interno).
+    thread_handle_t thread; ///< Thread do motor.
+    int started;            ///< 1 depois que a thread foi criada.
+    atomic_int *running;    ///< Flag de execução do teste, observada pela thread.
+
+    /* --- Estado quente (escrito apenas pela thread do motor) --- */
+    _Alignas(WORKER_ALIGN) atomic_ullong reads;  ///< Leituras concluídas.
+    atomic_ullong writes;   ///< Escritas concluídas.
+    atomic_ullong bytes;    ///< Bytes transferidos.
+    atomic_ullong errors;   ///< Operações que falharam ou transferiram menos que `block`.
+    int last_errno;         ///< Último código de erro do sistema (lido após o join).
+    double run_start, run_end; ///< Instantes (`now_sec`) em que a E/S começou e terminou (lidos após o join).
+    atomic_ullong hist[LAT_HIST_BUCKETS]; ///< Latências, da submissão à conclusão, por bucket de `lat_hist_index`.
+
+    /* --- Uso exclusivo do amostrador --- */
+    unsigned long long ops_last, bytes_last; ///< Totais na amostra anterior.
+    unsigned long long hist_last[LAT_HIST_BUCKETS]; ///< Histograma na amostra anterior.
+    unsigned long long hist_interval[LAT_HIST_BUCKETS]; ///< Rascunho: histograma do último intervalo.
+};
+
+/**
+ * @struct io_stats_t
+ * @brief Taxas de um intervalo do motor.
+ */
+typedef struct {
+    double iops;            ///< Operações por segundo.
+    double mbps;            ///< MB/s (10^6 bytes).
+    double p50_us, p99_us, p999_us; ///< Percentis da latência, em µs (0 sem operações no intervalo).
+} io_stats_t;
+
+/**
+ * @struct io_totals_t
+ * @brief Totais do teste inteiro, lidos depois que a thread do motor terminou.
+ */
+typedef struct {
+    unsigned long long reads, writes, errors; ///< Operações concluídas e com falha.
+    double seconds;         ///< Duração da E/S.
+    io_stats_t rate;        ///< Taxas e percentis sobre o teste inteiro.
+    double max_us;          ///< Maior latência observada (limite superior do bucket), em µs.
+} io_totals_t;
+
+/**
+ * @brief Abre o alvo e prepara o motor, sem iniciar a E/S.
+ *
+ * Um diretório recebe um arquivo temporário; um arquivo inexistente ou menor que
+ * `file_mib` é criado ou estendido e preenchido antes do teste, para que as
+ * leituras toquem blocos reais. Se o sistema de arquivos recusar a E/S direta,
+ * o motor usa E/S com cache e marca `direct = 0`.
+ *
+ * @param running Interrompe o preenchimento e, depois, a E/S quando zerado.
+ * @param err Recebe a descrição do erro.
+ * @return O motor, ou NULL em caso de erro.
+ */
+io_engine_t *io_engine_open(const io_options_t *o, atomic_int *running, char *err, size_t err_len);
+
+/**
+ * @brief Inicia a thread do motor.
+ * @return 0 em caso de sucesso, -1 se a thread não pôde ser criada.
+ */
+int io_engine_start(io_engine_t *e);
+
+/**
+ * @brief Espera a thread terminar; ela para quando `running` é zerado e as operações em voo concluem.
+ */
+void io_engine_join(io_engine_t *e);
+
+/**
+ * @brief Fecha o alvo, remove o arquivo criado pelo motor e libera `e`.
+ */
+void io_engine_close(io_engine_t *e);
+
+/**
+ * @brief Calcula as taxas desde a chamada anterior. Uso exclusivo do amostrador.
+ * @param dt Segundos desde a chamada anterior.
+ */
+void io_engine_sample(io_engine_t *e, double dt, io_stats_t *out);
+
+/**
+ * @brief Calcula os totais do teste. Deve ser chamada depois de `io_engine_join`.
+ */
+void io_engine_totals(io_engine_t *e, io_totals_t *out);
+
+/**
+ * @brief Nome do mecanismo de submissão ("io_uring", "IOCP" ou "pread/pwrite").
+ */
+const char *io_backend_name(int backend);
+
+#endif // STORAGE_H
@@ -0,0 +1,106 @@
+#include "sweep.h"
+#include "kernels.h" // Para ptrchase_build, kernel_ptrchase e kernel_stream
+#include "bench.h"   // Para bench_stats
+#include "utils.h"   // Para now_sec
+#include <string.h>
+
+/** @brief Passos do aquecimento do ciclo; além disso o conjunto está na DRAM e não há o que aquecer. */
+#define SWEEP_WARM_STEPS ((size_t)1 << 20)
+
+/* --- Static Function Prototypes --- */
+static double measure_latency(const uint32_t *idx, uint32_t *pos, double rep_sec);
+static double measure_triad(double *a, double *b, double *c, size_t n, double rep_sec);
+
+int sweep_sizes(size_t max_bytes, size_t *out, int max){
+    int n = 0;
+    // Dois pontos por oitava: a potência de 2 e uma vez e meia ela.
+    for (size_t p = SWEEP_MIN_BYTES; p <= max_bytes && n < max; p *= 2) {
+        out[n++] = p;
+        if (p + p / 2 <= max_bytes && n < max) out[n++] = p + p / 2;
+        if (p > SIZE_MAX / 2) break;
+    }
+    return n;
+}
+
+int sweep_expected_level(const cpu_cache_t *caches, int n, size_t bytes){
+    for (int i = 0; caches && i < n; i++) {
+        if (bytes <= caches[i].bytes) return caches[i].level;
+    }
+    return 0;
+}
+
+/**
+ * @brief Percorre o ciclo por `rep_sec` segundos.
+ * @return A latência por carga, em ns.
+ */
+static double measure_latency(const uint32_t *idx, uint32_t *pos, double rep_sec){
+    uint64_t steps = 0;
+    double start = now_sec(), dt;
+    do {
+        kernel_ptrchase(idx, pos, 1, PTR_STEPS_PER_QUANTUM);
+        steps += PTR_STEPS_PER_QUANTUM;
+        dt = now_sec() - start;
+    } while (dt < rep_sec);
+    return dt * 1e9 / (double)steps;
+}
+
+/**
+ * @brief Executa o Triad sobre os arrays por `rep_sec` segundos.
+ *
+ * Arrays grandes são percorridos em quanta, e os pequenos em várias passagens
+ * por leitura do relógio, de modo que o custo de `now_sec` não entra na medida.
+ *
+ * @return A banda, em GB/s.
+ */
+static double measure_triad(double *a, double *b, double *c, size_t n, double rep_sec){
+    size_t chunk = n < STREAM_QUANTUM_ELEMS ? n : STREAM_QUANTUM_ELEMS;
+    size_t passes = n < STREAM_QUANTUM_ELEMS ? STREAM_QUANTUM_ELEMS / n : 1;
+    uint64_t bytes = 0;
+    size_t off = 0;
+    double start = now_sec(), dt;
+    do {
+        for (size_t p = 0; p < passes; p++) {
+            size_t len = n - off < chunk ? n - off : chunk;
+            bytes += kernel_stream(STREAM_TRIAD, a + off, b + off, c + off, len, 0, 0);
+            off = off + len == n ? 0 : off + len;
+        }
+        dt = now_sec() - start;
+    } while (dt < rep_sec);
+    return (double)bytes / dt / 1e9;
+}
+
+int sweep_measure(uint8_t *buf, size_t bytes, int reps, double rep_sec, atomic_int *running,
+                  uint64_t *seed, sweep_point_t *out){
+    double v[SWEEP_REPS * 4];
+    if (reps < 1) reps = 1;
+    if (reps > (int)(sizeof(v) / sizeof(v[0]))) reps = (int)(sizeof(v) / sizeof(v[0]));
+    bench_stats_t st;
+    memset(out, 0, sizeof(*out));
+    out->bytes = bytes;
+
+    uint32_t *idx = (uint32_t*)buf;
+    size_t nodes = bytes / CACHE_LINE_SIZE;
+    uint32_t pos[PTR_MAX_CHAINS];
+    ptrchase_build(idx, nodes, 1, pos, seed);
+    kernel_ptrchase(idx, pos, 1, nodes < SWEEP_WARM_STEPS ? nodes : SWEEP_WARM_STEPS);
+    for (int r = 0; r < reps; r++) {
+        if (running && !atomic_load(running)) return -1;
+        v[r] = measure_latency(idx, pos, rep_sec);
+    }
+    bench_stats(v, reps, 0, &st);
+    out->ns_per_load = st.median;
+
+    // Três arrays alinhados a uma linha de cache dividem o mesmo conjunto de trabalho.
+    size_t per_array = (bytes / 3) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    size_t n = per_array / sizeof(double);
+    double *a = (double*)buf, *b = (double*)(buf + per_array), *c = (double*)(buf + 2 * per_array);
+    for (size_t i = 0; i < n; i++) { a[i] = 1.0; b[i] = 2.0; c[i] = 0.0; }
+    kernel_stream(STREAM_TRIAD, a, b, c, n, 0, 0);
+    for (int r = 0; r < reps; r++) {
+        if (running && !atomic_load(running)) return -1;
+        v[r] = measure_triad(a, b, c, n, rep_sec);
+    }
+    bench_stats(v, reps, 1, &st);
+    out->gbps = st.median;
+    return 0;
+}
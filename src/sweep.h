@@ -0,0 +1,81 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+/**
+ * @file sweep.h
+ * @brief Declara a varredura da hierarquia de caches (`--sweep`).
+ *
+ * Em vez do teste de estresse, uma única thread mede a latência por carga
+ * dependente (perseguição de ponteiro com uma cadeia) e a banda do Triad do
+ * STREAM sobre conjuntos de trabalho de tamanho crescente, de 4 KiB até o
+ * máximo pedido, com dois pontos por oitava. A curva resultante mostra os
+ * degraus de L1, L2, L3 e DRAM; os caches descritos pelo SO marcam onde cada
+ * degrau é esperado.
+ */
+
+#include "hardstress.h"
+#include "topology.h"
+
+/** @brief Menor conjunto de trabalho da varredura, em bytes. */
+#define SWEEP_MIN_BYTES (4u << 10)
+/** @brief Maior conjunto de trabalho padrão, em MiB (limitado a um quarto da memória). */
+#define DEFAULT_SWEEP_MAX_MIB 2048
+/** @brief Maior conjunto de trabalho aceito, em MiB (os índices do ciclo são de 32 bits). */
+#define SWEEP_MAX_MIB 8192
+/** @brief Capacidade de pontos da curva (suficiente para dois por oitava de 4 KiB a `SWEEP_MAX_MIB`). */
+#define SWEEP_MAX_POINTS 64
+/** @brief Repetições medidas de cada métrica em cada ponto; o ponto guarda a mediana. */
+#define SWEEP_REPS 5
+/** @brief Duração de cada repetição, em segundos. */
+#define SWEEP_REP_SEC 0.02
+
+/**
+ * @struct sweep_point_t
+ * @brief Um ponto da curva.
+ */
+typedef struct {
+    size_t bytes;           ///< Conjunto de trabalho.
+    double ns_per_load;     ///< Latência por carga dependente, em ns.
+    double gbps;            ///< Banda do Triad, em GB/s.
+    int level;              ///< Nível de cache em que o conjunto cabe (1 = L1), ou 0 para a DRAM.
+} sweep_point_t;
+
+/**
+ * @struct sweep_result_t
+ * @brief A curva e os caches usados para anotá-la.
+ */
+struct sweep_result_t {
+    int cpu;                ///< CPU em que a varredura executou (-1 = sem fixação).
+    int count;              ///< Pontos medidos até agora.
+    sweep_point_t points[SWEEP_MAX_POINTS]; ///< Os pontos, em ordem crescente de tamanho.
+    int cache_count;        ///< Caches descritos pelo SO para `cpu`.
+    cpu_cache_t caches[CPU_CACHE_MAX]; ///< Os caches, do L1 ao último nível.
+};
+
+/**
+ * @brief Calcula os tamanhos da varredura: 4 KiB, 6 KiB, 8 KiB, 12 KiB... até `max_bytes`.
+ * @return O número de tamanhos escritos em `out`.
+ */
+int sweep_sizes(size_t max_bytes, size_t *out, int max);
+
+/**
+ * @brief Retorna o menor nível de cache com capacidade para `bytes`, ou 0 (DRAM).
+ */
+int sweep_expected_level(const cpu_cache_t *caches, int n, size_t bytes);
+
+/**
+ * @brief Mede um ponto da curva sobre os primeiros `bytes` de `buf`.
+ *
+ * Monta um ciclo de perseguição de ponteiro sobre o conjunto, percorre-o uma vez
+ * para aquecer, e mede `reps` repetições de `rep_sec`; depois faz o mesmo com o
+ * Triad sobre três arrays que dividem o conjunto.
+ *
+ * @param buf Buffer alinhado a uma linha de cache, com pelo menos `bytes` bytes.
+ * @param running Interrompe a medição quando zerado (NULL = nunca).
+ * @param seed Estado do PRNG do ciclo.
+ * @return 0 em caso de sucesso, -1 se a medição foi interrompida.
+ */
+int sweep_measure(uint8_t *buf, size_t bytes, int reps, double rep_sec, atomic_int *running,
+                  uint64_t *seed, sweep_point_t *out);
+
+#endif // SWEEP_H
@@ -0,0 +1,634 @@
+#include "telemetry.h"
+#include "utils.h"   // Para now_sec, thread_create, thread_join
+#include "perfctr.h" // Para perf_ipc
+#include "storage.h" // Para io_engine_totals
+#include "jitter.h"  // Para jitter_stats_t
+
+#include <stdarg.h>
+
+/** @brief Nomes das taxas de cada kernel (`kernel_id_t`) nos registros exportados. */
+static const char *const KERNEL_RATE_FIELDS[KERNEL_COUNT] = { "fpu_gflops", "int_gops", "stream_gbps", "ptr_mloads", "atomic_mops" };
+/** @brief Nomes curtos de cada kernel, usados nos campos de IPC e no cabeçalho. */
+static const char *const KERNEL_FIELDS[KERNEL_COUNT] = { "fpu", "int", "stream", "ptr", "atomic" };
+/** @brief Número de campos do motor de E/S. */
+#define IO_FIELD_COUNT 5
+/** @brief Campos do motor de E/S, presentes quando ele está ativo. */
+static const char *const IO_FIELDS[IO_FIELD_COUNT] = { "io_iops", "io_mbps", "io_p50_us", "io_p99_us", "io_p999_us" };
+/** @brief Número de campos da sonda de jitter. */
+#define JITTER_FIELD_COUNT 4
+/** @brief Campos da sonda de jitter (todas as CPUs juntas), presentes quando ela está ativa. */
+static const char *const JITTER_FIELDS[JITTER_FIELD_COUNT] = { "jitter_p50_us", "jitter_p99_us", "jitter_p999_us", "jitter_max_us" };
+
+/**
+ * @brief Valores de uma amostra, copiados do contexto antes da formatação.
+ */
+typedef struct {
+    double t;                       ///< Segundos desde o início do teste.
+    double wall;                    ///< Tempo Unix da amostra, em segundos.
+    double iters_s;                 ///< Vazão agregada, em iterações por segundo.
+    double kernel_rate[KERNEL_COUNT]; ///< Taxa de cada kernel na unidade de `KERNEL_RATE_FIELDS`.
+    double ptr_ns;                  ///< Latência por carga dependente do kernel PTR.
+    double ipc[KERNEL_COUNT];       ///< IPC de cada kernel no último intervalo (com `perf_en`).
+    double io[IO_FIELD_COUNT];      ///< Taxas e percentis do motor de E/S, na ordem de `IO_FIELDS`.
+    double jitter[JITTER_FIELD_COUNT]; ///< Latência de despertar da sonda de jitter, na ordem de `JITTER_FIELDS`.
+    double temp;                    ///< Temperatura principal (`TEMP_UNAVAILABLE` se não há sensor).
+    int thermal, power;             ///< CPUs com limitação térmica / de potência.
+    int cpus, threads, core_temps;  ///< Tamanho dos vetores abaixo.
+    double *usage, *mhz, *rate, *core_temp; ///< Fatias de `telemetry_t::scratch`.
+} sample_values_t;
+
+/* --- Static Function Prototypes --- */
+static thread_return_t THREAD_CALL writer_main(void *arg);
+static void line_add(telemetry_t *tm, const char *fmt, ...);
+static void line_num(telemetry_t *tm, double v);
+static int enqueue_line(telemetry_t *tm);
+static int collect_sample(telemetry_t *tm, AppContext *app, sample_values_t *s);
+static void format_header(telemetry_t *tm, const AppContext *app, const sample_values_t *s);
+static void format_sample(telemetry_t *tm, const AppContext *app, const sample_values_t *s);
+static void format_list(telemetry_t *tm, const char *name, const double *v, int n, double missing_below);
+static void format_event(telemetry_t *tm, const degrade_event_t *ev);
+static void format_sweep_row(telemetry_t *tm, const char *type, size_t bytes, double ns, double gbps, int level, int shared);
+
+int telemetry_format_parse(const char *name){
+    if (!name) return -1;
+    if (strcmp(name, "csv") == 0) return TELEMETRY_CSV;
+    if (strcmp(name, "jsonl") == 0 || strcmp(name, "json") == 0) return TELEMETRY_JSONL;
+    return -1;
+}
+
+int telemetry_format_from_path(const char *path){
+    const char *dot = path ? strrchr(path, '.') : NULL;
+    if (dot && (strcmp(dot, ".jsonl") == 0 || strcmp(dot, ".json") == 0)) return TELEMETRY_JSONL;
+    return TELEMETRY_CSV;
+}
+
+telemetry_t *telemetry_open(const char *path, int format){
+    if (!path || !*path) return NULL;
+    telemetry_t *tm = calloc(1, sizeof(*tm));
+    if (!tm) return NULL;
+    tm->format = format;
+    tm->ring = malloc(TELEMETRY_RING_BYTES);
+    tm->f = tm->ring ? fopen(path, "w") : NULL;
+    if (!tm->f) {
+        free(tm->ring);
+        free(tm);
+        return NULL;
+    }
+    // A thread de escrita entrega blocos grandes; o buffer do stdio só agrupa as pontas do anel.
+    setvbuf(tm->f, NULL, _IOFBF, 64 * 1024);
+    tm->wall_start = (double)g_get_real_time() / 1e6;
+    tm->mono_start = now_sec();
+    g_mutex_init(&tm->mutex);
+    g_cond_init(&tm->cond);
+    if (thread_create(&tm->writer, writer_main, tm) != 0) {
+        g_cond_clear(&tm->cond);
+        g_mutex_clear(&tm->mutex);
+        fclose(tm->f);
+        free(tm->ring);
+        free(tm);
+        return NULL;
+    }
+    return tm;
+}
+
+int telemetry_close(telemetry_t *tm){
+    if (!tm) return 0;
+    g_mutex_lock(&tm->mutex);
+    tm->stop = 1;
+    g_cond_signal(&tm->cond);
+    g_mutex_unlock(&tm->mutex);
+    thread_join(tm->writer);
+
+    int rc = tm->write_failed ? -1 : 0;
+    if (fflush(tm->f) != 0 || ferror(tm->f)) rc = -1;
+    if (fclose(tm->f) != 0) rc = -1;
+    g_cond_clear(&tm->cond);
+    g_mutex_clear(&tm->mutex);
+    free(tm->ring);
+    free(tm->line);
+    free(tm->scratch);
+    free(tm->events);
+    free(tm);
+    return rc;
+}
+
+/**
+ * @brief A thread de escrita: entrega ao arquivo o trecho contíguo pendente do anel.
+ *
+ * A escrita é feita fora do mutex, de modo que o amostrador só espera pela cópia
+ * de um registro. O arquivo é esvaziado (`fflush`) sempre que o anel fica vazio,
+ * para que um leitor externo veja cada amostra ao final do seu intervalo.
+ */
+static thread_return_t THREAD_CALL writer_main(void *arg){
+    telemetry_t *tm = (telemetry_t*)arg;
+    g_mutex_lock(&tm->mutex);
+    for (;;) {
+        while (tm->head == tm->tail && !tm->stop) g_cond_wait(&tm->cond, &tm->mutex);
+        if (tm->head == tm->tail) break;
+        size_t off = (size_t)(tm->tail % TELEMETRY_RING_BYTES);
+        size_t n = (size_t)(tm->head - tm->tail);
+        if (n > TELEMETRY_RING_BYTES - off) n = TELEMETRY_RING_BYTES - off;
+        g_mutex_unlock(&tm->mutex);
+
+        if (!tm->write_failed && fwrite(tm->ring + off, 1, n, tm->f) != n) tm->write_failed = 1;
+
+        g_mutex_lock(&tm->mutex);
+        tm->tail += n;
+        if (tm->head == tm->tail) {
+            g_mutex_unlock(&tm->mutex);
+            if (!tm->write_failed && fflush(tm->f) != 0) tm->write_failed = 1;
+            g_mutex_lock(&tm->mutex);
+        }
+    }
+    g_mutex_unlock(&tm->mutex);
+    return 0;
+}
+
+/**
+ * @brief Acrescenta texto formatado ao registro corrente, ampliando `line` se preciso.
+ *
+ * Uma falha de alocação marca `line_oom`, o que faz `enqueue_line` descartar o registro.
+ */
+static void line_add(telemetry_t *tm, const char *fmt, ...){
+    if (tm->line_oom) return;
+    for (;;) {
+        if (tm->line_cap > 0) {
+            va_list ap;
+            va_start(ap, fmt);
+            int n = vsnprintf(tm->line + tm->line_len, tm->line_cap - tm->line_len, fmt, ap);
+            va_end(ap);
+            if (n < 0) return;
+            if (tm->line_len + (size_t)n < tm->line_cap) {
+                tm->line_len += (size_t)n;
+                return;
+            }
+        }
+        size_t cap = tm->line_cap ? tm->line_cap * 2 : 4096;
+        char *p = realloc(tm->line, cap);
+        if (!p) {
+            tm->line_oom = 1;
+            return;
+        }
+        tm->line = p;
+        tm->line_cap = cap;
+    }
+}
+
+/**
+ * @brief Acrescenta um número; valores não finitos viram `null` (JSON) ou campo vazio (CSV).
+ */
+static void line_num(telemetry_t *tm, double v){
+    if (v != v || v > 1e300 || v < -1e300) {
+        if (tm->format == TELEMETRY_JSONL) line_add(tm, "null");
+        return;
+    }
+    line_add(tm, "%.6g", v);
+}
+
+/**
+ * @brief Copia o registro corrente para o anel, ou o descarta se não houver espaço.
+ * @return 0 se o registro foi enfileirado, -1 se foi descartado.
+ */
+static int enqueue_line(telemetry_t *tm){
+    size_t n = tm->line_len;
+    int oom = tm->line_oom;
+    tm->line_len = 0;
+    tm->line_oom = 0;
+    g_mutex_lock(&tm->mutex);
+    if (oom || tm->head - tm->tail + n > TELEMETRY_RING_BYTES) {
+        g_mutex_unlock(&tm->mutex);
+        return -1;
+    }
+    size_t off = (size_t)(tm->head % TELEMETRY_RING_BYTES);
+    size_t first = n < TELEMETRY_RING_BYTES - off ? n : TELEMETRY_RING_BYTES - off;
+    memcpy(tm->ring + off, tm->line, first);
+    memcpy(tm->ring, tm->line + first, n - first);
+    tm->head += n;
+    g_cond_signal(&tm->cond);
+    g_mutex_unlock(&tm->mutex);
+    return 0;
+}
+
+/**
+ * @brief Copia do contexto os valores da amostra mais recente.
+ * @return 0 em caso de sucesso, -1 se faltar memória para os vetores.
+ */
+static int collect_sample(telemetry_t *tm, AppContext *app, sample_values_t *s){
+    memset(s, 0, sizeof(*s));
+    double now = now_sec();
+    s->t = now - app->start_time;
+    s->wall = tm->wall_start + (now - tm->mono_start);
+    s->cpus = app->cpu_count > 0 ? app->cpu_count : 0;
+    s->threads = app->threads > 0 ? app->threads : 0;
+
+    g_mutex_lock(&app->temp_mutex);
+    s->temp = app->temp_celsius;
+    s->core_temps = tm->header_done ? tm->core_temps : app->core_temp_count;
+    size_t need = 2 * (size_t)s->cpus + (size_t)s->threads + (size_t)s->core_temps;
+    if (need > tm->scratch_cap) {
+        double *p = realloc(tm->scratch, need * sizeof(double));
+        if (!p) {
+            g_mutex_unlock(&app->temp_mutex);
+            return -1;
+        }
+        tm->scratch = p;
+        tm->scratch_cap = need;
+    }
+    s->usage = tm->scratch;
+    s->mhz = s->usage + s->cpus;
+    s->rate = s->mhz + s->cpus;
+    s->core_temp = s->rate + s->threads;
+    for (int i = 0; i < s->core_temps; i++) {
+        s->core_temp[i] = (app->core_temps && i < app->core_temp_count) ? app->core_temps[i] : TEMP_UNAVAILABLE;
+    }
+    g_mutex_unlock(&app->temp_mutex);
+
+    g_mutex_lock(&app->cpu_mutex);
+    for (int c = 0; c < s->cpus; c++) {
+        s->usage[c] = app->cpu_usage ? app->cpu_usage[c] : 0.0;
+        s->mhz[c] = app->cpu_freq_mhz ? app->cpu_freq_mhz[c] : 0.0;
+    }
+    g_mutex_unlock(&app->cpu_mutex);
+
+    g_mutex_lock(&app->system_history_mutex);
+    if (app->system_history_filled > 0 && app->throttle_thermal_history && app->throttle_power_history) {
+        s->thermal = app->throttle_thermal_history[app->system_history_pos];
+        s->power = app->throttle_power_history[app->system_history_pos];
+    }
+    g_mutex_unlock(&app->system_history_mutex);
+
+    g_mutex_lock(&app->history_mutex);
+    s->iters_s = app->iters_per_sec;
+    s->kernel_rate[KERNEL_FPU] = app->gflops;
+    s->kernel_rate[KERNEL_INT] = app->int_gops;
+    s->kernel_rate[KERNEL_STREAM] = app->stream_gbps;
+    s->kernel_rate[KERNEL_PTR] = app->ptr_mloads;
+    s->kernel_rate[KERNEL_ATOMIC] = app->atomic_mops;
+    s->ptr_ns = app->ptr_ns_per_load;
+    for (int k = 0; k < KERNEL_COUNT; k++) s->ipc[k] = perf_ipc(app->perf_interval[k]);
+    const double io[IO_FIELD_COUNT] = { app->io_iops, app->io_mbps, app->io_p50_us, app->io_p99_us, app->io_p999_us };
+    memcpy(s->io, io, sizeof(io));
+    const jitter_stats_t *js = app->jitter_live ? &app->jitter_live->all : NULL;
+    const double jitter[JITTER_FIELD_COUNT] = { js ? js->p50_us : 0.0, js ? js->p99_us : 0.0,
+                                                js ? js->p999_us : 0.0, js ? js->max_us : 0.0 };
+    memcpy(s->jitter, jitter, sizeof(jitter));
+    // A taxa de cada worker usa as duas últimas amostras do histórico e o tempo real entre elas.
+    int pos = app->history_pos;
+    int prev = app->history_len > 0 ? (pos + app->history_len - 1) % app->history_len : 0;
+    double dt = (app->history_seq >= 2 && app->history_time) ? app->history_time[pos] - app->history_time[prev] : 0.0;
+    for (int t = 0; t < s->threads; t++) {
+        s->rate[t] = 0.0;
+        if (dt > 0.0 && app->thread_history) {
+            unsigned long long a = app->thread_history[t][prev].v[THREAD_METRIC_PROGRESS];
+            unsigned long long b = app->thread_history[t][pos].v[THREAD_METRIC_PROGRESS];
+            s->rate[t] = b > a ? (double)(b - a) / ITER_PROGRESS_SCALE / dt : 0.0;
+        }
+    }
+    g_mutex_unlock(&app->history_mutex);
+    return 0;
+}
+
+/**
+ * @brief Emite o cabeçalho: nomes das colunas (CSV) ou um registro "header" (JSON Lines).
+ */
+static void format_header(telemetry_t *tm, const AppContext *app, const sample_values_t *s){
+    if (tm->format == TELEMETRY_JSONL) {
+        line_add(tm, "{\"type\":\"header\",\"version\":1,\"start\":%.3f,\"interval_ms\":%d,\"threads\":%d,\"cpus\":%d,\"kernels\":[",
+                 tm->wall_start, app->sample_interval_ms > 0 ? app->sample_interval_ms : CPU_SAMPLE_INTERVAL_MS,
+                 s->threads, s->cpus);
+        const int enabled[KERNEL_COUNT] = { app->kernel_fpu_en, app->kernel_int_en, app->kernel_stream_en,
+                                            app->kernel_ptr_en, app->kernel_atomic_en };
+        int n = 0;
+        for (int k = 0; k < KERNEL_COUNT; k++) {
+            if (enabled[k]) line_add(tm, "%s\"%s\"", n++ ? "," : "", KERNEL_FIELDS[k]);
+        }
+        line_add(tm, "],\"perf\":%d,\"io\":%d,\"jitter\":%d,\"core_temps\":%d}\n", app->perf_en ? 1 : 0,
+                 app->io ? 1 : 0, app->jitter ? 1 : 0, s->core_temps);
+        return;
+    }
+    line_add(tm, "type,t,wall,iters_s");
+    for (int k = 0; k < KERNEL_COUNT; k++) line_add(tm, ",%s", KERNEL_RATE_FIELDS[k]);
+    line_add(tm, ",ptr_ns,temp_c,throttle_thermal,throttle_power");
+    if (app->io) {
+        for (int i = 0; i < IO_FIELD_COUNT; i++) line_add(tm, ",%s", IO_FIELDS[i]);
+    }
+    if (app->jitter) {
+        for (int i = 0; i < JITTER_FIELD_COUNT; i++) line_add(tm, ",%s", JITTER_FIELDS[i]);
+    }
+    if (app->perf_en) {
+        for (int k = 0; k < KERNEL_COUNT; k++) line_add(tm, ",ipc_%s", KERNEL_FIELDS[k]);
+    }
+    for (int c = 0; c < s->cpus; c++) line_add(tm, ",cpu%d_usage", c);
+    for (int c = 0; c < s->cpus; c++) line_add(tm, ",cpu%d_mhz", c);
+    for (int t = 0; t < s->threads; t++) line_add(tm, ",t%d_iters_s", t);
+    for (int i = 0; i < s->core_temps; i++) line_add(tm, ",core%d_temp_c", i);
+    line_add(tm, "\n");
+}
+
+/**
+ * @brief Acrescenta um vetor: `"name":[...]` em JSON ou uma coluna por elemento em CSV.
+ *
+ * Valores menores ou iguais a `missing_below` são gravados como ausentes.
+ */
+static void format_list(telemetry_t *tm, const char *name, const double *v, int n, double missing_below){
+    int json = tm->format == TELEMETRY_JSONL;
+    if (json) line_add(tm, ",\"%s\":[", name);
+    for (int i = 0; i < n; i++) {
+        if (!json || i > 0) line_add(tm, ",");
+        if (v[i] > missing_below) line_num(tm, v[i]);
+        else if (json) line_add(tm, "null");
+    }
+    if (json) line_add(tm, "]");
+}
+
+/**
+ * @brief Formata o registro de uma amostra na ordem das colunas do cabeçalho.
+ */
+static void format_sample(telemetry_t *tm, const AppContext *app, const sample_values_t *s){
+    int json = tm->format == TELEMETRY_JSONL;
+    if (json) line_add(tm, "{\"type\":\"sample\",\"t\":%.3f,\"wall\":%.3f,\"iters_s\":", s->t, s->wall);
+    else line_add(tm, "sample,%.3f,%.3f,", s->t, s->wall);
+    line_num(tm, s->iters_s);
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        if (json) line_add(tm, ",\"%s\":", KERNEL_RATE_FIELDS[k]);
+        else line_add(tm, ",");
+        line_num(tm, s->kernel_rate[k]);
+    }
+    line_add(tm, json ? ",\"ptr_ns\":" : ",");
+    line_num(tm, s->ptr_ns);
+    line_add(tm, json ? ",\"temp_c\":" : ",");
+    if (s->temp > TEMP_UNAVAILABLE) line_num(tm, s->temp);
+    else if (json) line_add(tm, "null");
+    if (json) line_add(tm, ",\"throttle_thermal\":%d,\"throttle_power\":%d", s->thermal, s->power);
+    else line_add(tm, ",%d,%d", s->thermal, s->power);
+    if (app->io) {
+        for (int i = 0; i < IO_FIELD_COUNT; i++) {
+            if (json) line_add(tm, ",\"%s\":", IO_FIELDS[i]);
+            else line_add(tm, ",");
+            line_num(tm, s->io[i]);
+        }
+    }
+    if (app->jitter) {
+        for (int i = 0; i < JITTER_FIELD_COUNT; i++) {
+            if (json) line_add(tm, ",\"%s\":", JITTER_FIELDS[i]);
+            else line_add(tm, ",");
+            line_num(tm, s->jitter[i]);
+        }
+    }
+    if (app->perf_en) {
+        if (json) line_add(tm, ",\"ipc\":{");
+        for (int k = 0; k < KERNEL_COUNT; k++) {
+            if (json) line_add(tm, "%s\"%s\":", k ? "," : "", KERNEL_FIELDS[k]);
+            else line_add(tm, ",");
+            line_num(tm, s->ipc[k]);
+        }
+        if (json) line_add(tm, "}");
+    }
+    format_list(tm, "cpu_usage", s->usage, s->cpus, -1);
+    format_list(tm, "cpu_mhz", s->mhz, s->cpus, 0);
+    format_list(tm, "thread_iters_s", s->rate, s->threads, -1);
+    format_list(tm, "core_temps_c", s->core_temp, s->core_temps, TEMP_UNAVAILABLE);
+    line_add(tm, json ? "}\n" : "\n");
+}
+
+void telemetry_sample(telemetry_t *tm, AppContext *app){
+    if (!tm || !app) return;
+    sample_values_t s;
+    if (collect_sample(tm, app, &s) != 0) {
+        tm->dropped++;
+        return;
+    }
+    if (!tm->header_done) {
+        // O número de sensores de núcleo só é conhecido depois que o amostrador os abre.
+        tm->core_temps = s.core_temps;
+        tm->header_done = 1;
+        format_header(tm, app, &s);
+    }
+    format_sample(tm, app, &s);
+    if (enqueue_line(tm) == 0) tm->samples++;
+    else tm->dropped++;
+}
+
+/**
+ * @brief Formata um evento; no CSV, as colunas seguem o cabeçalho do bloco de eventos.
+ */
+static void format_event(telemetry_t *tm, const degrade_event_t *ev){
+    int json = tm->format == TELEMETRY_JSONL;
+    const char *kind = degrade_is_throttle(ev->cause) ? "throttle" : "degradation";
+    const char *scope = ev->scope == DEGRADE_PEERS ? "peers" : "self";
+    const char *phase = ev->begin ? "begin" : "end";
+    double wall = tm->wall_start + (now_sec() - tm->mono_start);
+    if (json) {
+        line_add(tm, "{\"type\":\"event\",\"t\":%.3f,\"wall\":%.3f,\"worker\":%d,\"event\":\"%s\",\"scope\":\"%s\","
+                 "\"phase\":\"%s\",\"cause\":\"%s\",\"iters_s\":",
+                 ev->t, wall, ev->worker, kind, scope, phase, degrade_cause_name(ev->cause));
+    } else {
+        line_add(tm, "event,%.3f,%.3f,%d,%s,%s,%s,%s,", ev->t, wall, ev->worker, kind, scope, phase,
+                 degrade_cause_name(ev->cause));
+    }
+    line_num(tm, ev->rate);
+    line_add(tm, json ? ",\"ref_iters_s\":" : ",");
+    line_num(tm, ev->ref);
+    line_add(tm, json ? ",\"drop_pct\":" : ",");
+    line_num(tm, ev->drop_pct);
+    const double v[4] = { ev->temp_c, ev->temp_ref, ev->mhz, ev->mhz_ref };
+    const double missing[4] = { TEMP_UNAVAILABLE, TEMP_UNAVAILABLE, 0.0, 0.0 };
+    const char *names[4] = { "temp_c", "ref_temp_c", "mhz", "ref_mhz" };
+    for (int i = 0; i < 4; i++) {
+        if (json) line_add(tm, ",\"%s\":", names[i]);
+        else line_add(tm, ",");
+        if (v[i] > missing[i]) line_num(tm, v[i]);
+        else if (json) line_add(tm, "null");
+    }
+    line_add(tm, json ? ",\"duration_s\":" : ",");
+    line_num(tm, ev->duration);
+    line_add(tm, json ? "}\n" : "\n");
+}
+
+void telemetry_event(telemetry_t *tm, const degrade_event_t *ev){
+    if (!tm || !ev) return;
+    format_event(tm, ev);
+    if (tm->format == TELEMETRY_JSONL) {
+        if (enqueue_line(tm) == 0) tm->event_count++;
+        return;
+    }
+    // O CSV tem colunas fixas por bloco; os eventos esperam o fim do teste em um bloco próprio.
+    char *p = tm->line_oom ? NULL : realloc(tm->events, tm->events_len + tm->line_len);
+    if (p) {
+        memcpy(p + tm->events_len, tm->line, tm->line_len);
+        tm->events = p;
+        tm->events_len += tm->line_len;
+        tm->event_count++;
+    }
+    tm->line_len = 0;
+    tm->line_oom = 0;
+}
+
+/**
+ * @brief Formata uma linha da varredura ("cache" ou "sweep"); no CSV os dois tipos dividem as colunas.
+ */
+static void format_sweep_row(telemetry_t *tm, const char *type, size_t bytes, double ns, double gbps, int level, int shared){
+    if (tm->format == TELEMETRY_JSONL) {
+        if (strcmp(type, "cache") == 0) {
+            line_add(tm, "{\"type\":\"cache\",\"level\":%d,\"bytes\":%zu,\"shared_cpus\":%d}\n", level, bytes, shared);
+            return;
+        }
+        line_add(tm, "{\"type\":\"sweep\",\"bytes\":%zu,\"ns_per_load\":", bytes);
+        line_num(tm, ns);
+        line_add(tm, ",\"gbps\":");
+        line_num(tm, gbps);
+        line_add(tm, ",\"level\":%d}\n", level);
+        return;
+    }
+    line_add(tm, "%s,%zu,", type, bytes);
+    if (ns > 0.0) line_num(tm, ns);
+    line_add(tm, ",");
+    if (gbps > 0.0) line_num(tm, gbps);
+    line_add(tm, ",%d,", level);
+    if (shared > 0) line_add(tm, "%d", shared);
+    line_add(tm, "\n");
+}
+
+void telemetry_sweep(telemetry_t *tm, const sweep_result_t *r, int i){
+    if (!tm || !r || i < 0 || i >= r->count) return;
+    if (!tm->header_done) {
+        // O primeiro ponto leva o cabeçalho e os caches que anotam a curva.
+        if (tm->format == TELEMETRY_CSV) line_add(tm, "type,bytes,ns_per_load,gbps,level,shared_cpus\n");
+        for (int c = 0; c < r->cache_count; c++) {
+            format_sweep_row(tm, "cache", r->caches[c].bytes, 0.0, 0.0, r->caches[c].level, r->caches[c].shared_cpus);
+        }
+        tm->header_done = 1;
+    }
+    const sweep_point_t *p = &r->points[i];
+    format_sweep_row(tm, "sweep", p->bytes, p->ns_per_load, p->gbps, p->level, 0);
+    if (enqueue_line(tm) == 0) tm->samples++;
+    else tm->dropped++;
+}
+
+void telemetry_c2c(telemetry_t *tm, const c2c_result_t *r, int i, int j){
+    if (!tm || !r || i < 0 || j < 0 || i >= r->n || j >= r->n) return;
+    int json = tm->format == TELEMETRY_JSONL;
+    if (!tm->header_done) {
+        if (!json) line_add(tm, "type,cpu_a,cpu_b,package_a,package_b,round_trip_ns\n");
+        tm->header_done = 1;
+    }
+    if (json) {
+        line_add(tm, "{\"type\":\"c2c\",\"cpu_a\":%d,\"cpu_b\":%d,\"package_a\":%d,\"package_b\":%d,\"round_trip_ns\":",
+                 r->cpus[i], r->cpus[j], r->package[i], r->package[j]);
+    } else {
+        line_add(tm, "c2c,%d,%d,%d,%d,", r->cpus[i], r->cpus[j], r->package[i], r->package[j]);
+    }
+    line_num(tm, r->ns[i * r->n + j]);
+    line_add(tm, json ? "}\n" : "\n");
+    if (enqueue_line(tm) == 0) tm->samples++;
+    else tm->dropped++;
+}
+
+void telemetry_summary(telemetry_t *tm, AppContext *app){
+    if (!tm || !app) return;
+    if (tm->format == TELEMETRY_CSV && tm->events_len > 0) {
+        line_add(tm, "type,t,wall,worker,event,scope,phase,cause,iters_s,ref_iters_s,drop_pct,"
+                 "temp_c,ref_temp_c,mhz,ref_mhz,duration_s\n");
+        line_add(tm, "%.*s", (int)tm->events_len, tm->events);
+        enqueue_line(tm);
+    }
+    double elapsed = now_sec() - app->start_time;
+    unsigned long long sum[THREAD_METRIC_COUNT] = {0};
+    unsigned long long stream_ns = 0, ptr_steps = 0, ptr_ns = 0;
+    int stream_workers = 0;
+    unsigned long long verify_passes = 0, verify_mismatches = 0;
+    const int verify = app->verify_en && app->kernel_stream_en;
+    for (int t = 0; app->workers && t < app->threads; t++) {
+        worker_t *w = &app->workers[t];
+        unsigned long long steps = atomic_load(&w->ptr_steps);
+        sum[THREAD_METRIC_FLOPS] += atomic_load(&w->flops);
+        sum[THREAD_METRIC_INT_OPS] += atomic_load(&w->int_ops);
+        sum[THREAD_METRIC_STREAM_BYTES] += atomic_load(&w->stream_bytes);
+        sum[THREAD_METRIC_PTR_LOADS] += steps * (unsigned long long)(w->ptr_chains > 0 ? w->ptr_chains : 1);
+        sum[THREAD_METRIC_ATOMIC_OPS] += atomic_load(&w->atomic_ops);
+        stream_ns += atomic_load(&w->stream_ns);
+        stream_workers += (w->kernels >> KERNEL_STREAM) & 1u;
+        verify_passes += w->verify_passes;
+        verify_mismatches += w->verify_mismatches;
+        ptr_steps += steps;
+        ptr_ns += atomic_load(&w->ptr_ns);
+    }
+    unsigned long long iters = atomic_load(&app->total_iters);
+    double rate[KERNEL_COUNT] = {0};
+    if (elapsed > 0.0) {
+        rate[KERNEL_FPU] = (double)sum[THREAD_METRIC_FLOPS] / elapsed / 1e9;
+        rate[KERNEL_INT] = (double)sum[THREAD_METRIC_INT_OPS] / elapsed / 1e9;
+        rate[KERNEL_PTR] = (double)sum[THREAD_METRIC_PTR_LOADS] / elapsed / 1e6;
+        rate[KERNEL_ATOMIC] = (double)sum[THREAD_METRIC_ATOMIC_OPS] / elapsed / 1e6;
+    }
+    // Mesma convenção do amostrador: bytes totais sobre o tempo médio de cada worker do STREAM no kernel.
+    if (stream_ns > 0) rate[KERNEL_STREAM] = (double)sum[THREAD_METRIC_STREAM_BYTES] * stream_workers / (double)stream_ns;
+    double ns_per_load = ptr_steps > 0 ? (double)ptr_ns / (double)ptr_steps : 0.0;
+    // A thread de E/S já terminou: os totais são os do teste inteiro.
+    io_totals_t io;
+    io_engine_totals(app->io, &io);
+    const double io_v[IO_FIELD_COUNT] = { io.rate.iops, io.rate.mbps, io.rate.p50_us, io.rate.p99_us, io.rate.p999_us };
+    // A controladora já gravou em jitter_live os totais do teste inteiro.
+    g_mutex_lock(&app->history_mutex);
+    jitter_stats_t js = { .cpu = -1 };
+    if (app->jitter_live) js = app->jitter_live->all;
+    g_mutex_unlock(&app->history_mutex);
+    const double jitter_v[JITTER_FIELD_COUNT] = { js.p50_us, js.p99_us, js.p999_us, js.max_us };
+
+    int json = tm->format == TELEMETRY_JSONL;
+    if (json) {
+        line_add(tm, "{\"type\":\"summary\",\"elapsed_s\":%.3f,\"threads\":%d,\"total_iters\":%llu,\"iters_s\":",
+                 elapsed, app->threads, iters);
+    } else {
+        line_add(tm, "type,elapsed_s,threads,total_iters,iters_s");
+        for (int k = 0; k < KERNEL_COUNT; k++) line_add(tm, ",%s", KERNEL_RATE_FIELDS[k]);
+        line_add(tm, ",ptr_ns");
+        if (app->io) {
+            for (int i = 0; i < IO_FIELD_COUNT; i++) line_add(tm, ",%s", IO_FIELDS[i]);
+            line_add(tm, ",io_max_us,io_errors");
+        }
+        if (app->jitter) {
+            for (int i = 0; i < JITTER_FIELD_COUNT; i++) line_add(tm, ",%s", JITTER_FIELDS[i]);
+            line_add(tm, ",jitter_wakeups");
+        }
+        if (verify) line_add(tm, ",verify_passes,verify_mismatches");
+        line_add(tm, ",errors,samples,dropped\n");
+        line_add(tm, "summary,%.3f,%d,%llu,", elapsed, app->threads, iters);
+    }
+    line_num(tm, elapsed > 0.0 ? (double)iters / elapsed : 0.0);
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        if (json) line_add(tm, ",\"%s\":", KERNEL_RATE_FIELDS[k]);
+        else line_add(tm, ",");
+        line_num(tm, rate[k]);
+    }
+    line_add(tm, json ? ",\"ptr_ns\":" : ",");
+    line_num(tm, ns_per_load);
+    if (app->io) {
+        for (int i = 0; i < IO_FIELD_COUNT; i++) {
+            if (json) line_add(tm, ",\"%s\":", IO_FIELDS[i]);
+            else line_add(tm, ",");
+            line_num(tm, io_v[i]);
+        }
+        line_add(tm, json ? ",\"io_max_us\":" : ",");
+        line_num(tm, io.max_us);
+        line_add(tm, json ? ",\"io_errors\":%llu" : ",%llu", io.errors);
+    }
+    if (app->jitter) {
+        for (int i = 0; i < JITTER_FIELD_COUNT; i++) {
+            if (json) line_add(tm, ",\"%s\":", JITTER_FIELDS[i]);
+            else line_add(tm, ",");
+            line_num(tm, jitter_v[i]);
+        }
+        line_add(tm, json ? ",\"jitter_wakeups\":%llu" : ",%llu", js.wakeups);
+    }
+    if (verify) {
+        line_add(tm, json ? ",\"verify_passes\":%llu,\"verify_mismatches\":%llu" : ",%llu,%llu",
+                 verify_passes, verify_mismatches);
+    }
+    if (json) {
+        line_add(tm, ",\"errors\":%d,\"samples\":%llu,\"dropped\":%llu}\n", atomic_load(&app->errors), tm->samples, tm->dropped);
+    } else {
+        line_add(tm, ",%d,%llu,%llu\n", atomic_load(&app->errors), tm->samples, tm->dropped);
+    }
+    enqueue_line(tm);
+}
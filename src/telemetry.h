@@ -0,0 +1,138 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/**
+ * @file telemetry.h
+ * @brief Declara a exportação contínua das amostras para um arquivo CSV ou JSON Lines.
+ *
+ * A cada intervalo, a thread de amostragem formata um registro com o instante, o
+ * uso e o clock de cada CPU, a taxa de cada worker, as temperaturas, as taxas de
+ * cada kernel, os contadores de limitação e, com o motor de E/S (`--io`), IOPS,
+ * MB/s e percentis de latência, e o copia para um buffer circular em
+ * memória. Uma thread de escrita dedicada esvazia o buffer no disco; nem os workers
+ * nem o amostrador esperam pela E/S. Se o disco não acompanhar e o buffer encher,
+ * o registro é descartado e contado, em vez de atrasar a amostragem. Os episódios
+ * de limitação e degradação detectados pelo amostrador entram como registros
+ * "event": no JSON Lines, intercalados com as amostras; no CSV, acumulados em um
+ * bloco próprio, com seu cabeçalho, gravado antes do resumo. Ao final, um
+ * registro de resumo com os totais do teste e as contagens de amostras gravadas e
+ * descartadas é acrescentado. Na varredura de caches (`--sweep`) não há amostras:
+ * o arquivo traz os caches detectados ("cache") e um registro por ponto da curva
+ * ("sweep"), gravados à medida que são medidos. Da mesma forma, a matriz de
+ * latência entre núcleos (`--c2c`) grava um registro "c2c" por par de CPUs.
+ */
+
+#include "hardstress.h"
+#include "degrade.h"
+#include "sweep.h"
+#include "coherence.h"
+
+/** @brief Capacidade do buffer entre o amostrador e a thread de escrita, em bytes. */
+#define TELEMETRY_RING_BYTES (4u << 20)
+
+/**
+ * @enum telemetry_format_t
+ * @brief Formato do arquivo de exportação.
+ */
+typedef enum {
+    TELEMETRY_CSV = 0,      ///< Uma linha de cabeçalho e uma linha por amostra; o resumo vem em um segundo bloco.
+    TELEMETRY_JSONL         ///< Um objeto JSON por linha, com o campo "type" (header, sample, event, summary, cache, sweep ou c2c).
+} telemetry_format_t;
+
+/**
+ * @struct telemetry_t
+ * @brief Estado da exportação: arquivo, buffer circular e thread de escrita.
+ */
+struct telemetry_t {
+    FILE *f;                ///< Arquivo de destino (escrito apenas pela thread de escrita).
+    int format;             ///< `telemetry_format_t`.
+    int header_done;        ///< 1 depois que o cabeçalho foi emitido (uso exclusivo do amostrador).
+    int core_temps;         ///< Colunas de temperatura por núcleo fixadas no cabeçalho CSV.
+    char *ring;             ///< Buffer circular de `TELEMETRY_RING_BYTES` bytes.
+    unsigned long long head;///< Bytes já enfileirados (protegido por `mutex`).
+    unsigned long long tail;///< Bytes já entregues ao arquivo (protegido por `mutex`).
+    GMutex mutex;           ///< Protege `head`, `tail` e `stop`.
+    GCond cond;             ///< Sinaliza a thread de escrita quando há dados ou ao encerrar.
+    int stop;               ///< 1 quando a thread de escrita deve esvaziar o buffer e terminar.
+    int write_failed;       ///< 1 se uma escrita no arquivo falhou (escrito apenas pela thread de escrita).
+    thread_handle_t writer; ///< Thread de escrita.
+    unsigned long long samples;  ///< Amostras enfileiradas (uso exclusivo do amostrador, lido após o join).
+    unsigned long long dropped;  ///< Amostras descartadas por falta de espaço no buffer (idem).
+    char *line;             ///< Registro em formatação (uso exclusivo do amostrador).
+    size_t line_len;        ///< Bytes usados em `line`.
+    size_t line_cap;        ///< Capacidade de `line`.
+    int line_oom;           ///< 1 se faltou memória ao formatar o registro corrente, que será descartado.
+    double *scratch;        ///< Cópia dos valores por CPU, por worker e por núcleo de uma amostra (uso exclusivo do amostrador).
+    size_t scratch_cap;     ///< Capacidade de `scratch`, em elementos.
+    char *events;           ///< Linhas de evento do CSV, gravadas no fim (uso exclusivo do amostrador).
+    size_t events_len;      ///< Bytes usados em `events`.
+    unsigned long long event_count; ///< Eventos exportados (idem).
+    double wall_start;      ///< Instante de início em tempo Unix (s), para o campo "wall".
+    double mono_start;      ///< `now_sec()` correspondente a `wall_start`.
+};
+
+/**
+ * @brief Converte o nome de um formato ("csv" ou "jsonl") em `telemetry_format_t`.
+ * @return O formato, ou -1 se o nome for desconhecido.
+ */
+int telemetry_format_parse(const char *name);
+
+/**
+ * @brief Deduz o formato pela extensão do arquivo (".jsonl"/".json" = JSON Lines, demais = CSV).
+ */
+int telemetry_format_from_path(const char *path);
+
+/**
+ * @brief Abre o arquivo de exportação e inicia a thread de escrita.
+ * @return O exportador, ou NULL se o arquivo não puder ser criado ou faltar memória.
+ */
+telemetry_t *telemetry_open(const char *path, int format);
+
+/**
+ * @brief Formata e enfileira um registro de amostra, sem bloquear na E/S.
+ *
+ * Deve ser chamada pela thread de amostragem logo após a amostra ser gravada no
+ * histórico; adquire `cpu_mutex`, `temp_mutex`, `system_history_mutex` e
+ * `history_mutex`, um de cada vez. O primeiro registro também emite o cabeçalho.
+ */
+void telemetry_sample(telemetry_t *tm, AppContext *app);
+
+/**
+ * @brief Exporta um evento de limitação ou degradação.
+ *
+ * Deve ser chamada pela thread de amostragem. No JSON Lines o registro é
+ * enfileirado de imediato; no CSV ele é guardado para o bloco de eventos.
+ */
+void telemetry_event(telemetry_t *tm, const degrade_event_t *ev);
+
+/**
+ * @brief Exporta o ponto `i` da varredura de caches.
+ *
+ * Deve ser chamada pela controladora, que executa a varredura, na ordem dos
+ * pontos. O primeiro ponto também emite o cabeçalho e os caches de `r`.
+ */
+void telemetry_sweep(telemetry_t *tm, const sweep_result_t *r, int i);
+
+/**
+ * @brief Exporta a ida e volta medida entre as CPUs `i` e `j` da matriz de latência.
+ *
+ * Deve ser chamada pela controladora, logo após medir o par. O primeiro par
+ * também emite o cabeçalho do CSV.
+ */
+void telemetry_c2c(telemetry_t *tm, const c2c_result_t *r, int i, int j);
+
+/**
+ * @brief Enfileira o registro de resumo com os totais do teste.
+ *
+ * Deve ser chamada depois que os workers e o amostrador terminaram. No CSV, o
+ * bloco de eventos, se houver, é enfileirado antes.
+ */
+void telemetry_summary(telemetry_t *tm, AppContext *app);
+
+/**
+ * @brief Esvazia o buffer, encerra a thread de escrita e fecha o arquivo.
+ * @return 0 se todos os registros aceitos foram gravados, -1 se houve erro de escrita.
+ */
+int telemetry_close(telemetry_t *tm);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,535 @@
+#include "topology.h"
+#include "utils.h"
+#include <ctype.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+
+/** @brief Maior índice `cache/index<N>` procurado ao buscar o L3 de uma CPU. */
+#define CACHE_INDEX_MAX 16
+
+/**
+ * @struct place_key_t
+ * @brief Chave de ordenação de uma CPU em `topology_place` (comparada campo a campo).
+ */
+typedef struct {
+    int k[4];
+    int cpu;
+} place_key_t;
+
+/* --- Static Function Prototypes --- */
+static int densify(int *ids, int n);
+static int cmp_place_key(const void *a, const void *b);
+#ifndef _WIN32
+static int read_sysfs_line(const char *path, char *buf, size_t len);
+static int read_sysfs_int(const char *path, int fallback);
+static int list_first_cpu(const char *path, int cpu, int *scratch, int max, int *rank);
+static void detect_nodes_linux(cpu_topology_t *topo, const char *root);
+static void detect_cpus_linux(cpu_topology_t *topo, const char *root);
+static int detect_caches_linux(const char *root, int cpu, cpu_cache_t *out, int max);
+#else
+static void detect_nodes_windows(cpu_topology_t *topo);
+static void mark_group_mask(cpu_topology_t *topo, const GROUP_AFFINITY *ga, int *target, int id, int *smt);
+static void detect_cpus_windows(cpu_topology_t *topo);
+static int detect_caches_windows(int cpu, cpu_cache_t *out, int max);
+#endif
+
+/* --- Funções Independentes de Plataforma --- */
+
+int parse_cpu_list(const char *s, int *out, int max){
+    if (!s || !out || max <= 0) return -1;
+    int count = 0;
+    const char *p = s;
+    while (*p) {
+        while (*p == ',' || isspace((unsigned char)*p)) p++;
+        if (*p == '\0') break;
+        if (!isdigit((unsigned char)*p)) return -1;
+
+        char *end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            p++;
+            if (!isdigit((unsigned char)*p)) return -1;
+            last = strtol(p, &end, 10);
+            p = end;
+        }
+        if (last < first) return -1;
+        for (long c = first; c <= last && count < max; c++) out[count++] = (int)c;
+        if (*p != '\0' && *p != ',' && !isspace((unsigned char)*p)) return -1;
+    }
+    return count;
+}
+
+cpu_topology_t *topology_detect(int cpu_count){
+    return topology_detect_at(cpu_count, "/sys");
+}
+
+cpu_topology_t *topology_detect_at(int cpu_count, const char *sysfs_root){
+    if (cpu_count <= 0) cpu_count = 1;
+    cpu_topology_t *topo = calloc(1, sizeof(cpu_topology_t));
+    if (!topo) return NULL;
+    topo->cpu_count = cpu_count;
+    topo->node_count = 1;
+    topo->cpu_node = calloc(cpu_count, sizeof(int));
+    topo->cpu_package = calloc(cpu_count, sizeof(int));
+    topo->cpu_l3 = calloc(cpu_count, sizeof(int));
+    topo->cpu_core = calloc(cpu_count, sizeof(int));
+    topo->cpu_smt = calloc(cpu_count, sizeof(int));
+    if (!topo->cpu_node || !topo->cpu_package || !topo->cpu_l3 || !topo->cpu_core || !topo->cpu_smt) {
+        topology_free(topo);
+        return NULL;
+    }
+    // Sem informação do SO, cada CPU lógica é um núcleo de um único socket com um único L3.
+    for (int c = 0; c < cpu_count; c++) topo->cpu_core[c] = c;
+#ifndef _WIN32
+    detect_nodes_linux(topo, sysfs_root);
+    detect_cpus_linux(topo, sysfs_root);
+#else
+    (void)sysfs_root;
+    detect_nodes_windows(topo);
+    detect_cpus_windows(topo);
+#endif
+    topo->package_count = densify(topo->cpu_package, cpu_count);
+    topo->l3_count = densify(topo->cpu_l3, cpu_count);
+    topo->core_count = densify(topo->cpu_core, cpu_count);
+    return topo;
+}
+
+void topology_free(cpu_topology_t *topo){
+    if (!topo) return;
+    free(topo->cpu_node);
+    free(topo->cpu_package);
+    free(topo->cpu_l3);
+    free(topo->cpu_core);
+    free(topo->cpu_smt);
+    free(topo);
+}
+
+/**
+ * @brief Substitui identificadores arbitrários por índices densos, na ordem da primeira ocorrência.
+ * @return O número de identificadores distintos.
+ */
+static int densify(int *ids, int n){
+    int *seen = malloc(n * sizeof(int));
+    if (!seen) return 1;
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        int j = 0;
+        while (j < count && seen[j] != ids[i]) j++;
+        if (j == count) seen[count++] = ids[i];
+        ids[i] = j;
+    }
+    free(seen);
+    return count;
+}
+
+int topology_caches(int cpu, cpu_cache_t *out, int max){
+    return topology_caches_at("/sys", cpu, out, max);
+}
+
+int topology_caches_at(const char *sysfs_root, int cpu, cpu_cache_t *out, int max){
+    if (!out || max <= 0 || cpu < 0) return 0;
+#ifndef _WIN32
+    int n = detect_caches_linux(sysfs_root, cpu, out, max);
+#else
+    (void)sysfs_root;
+    int n = detect_caches_windows(cpu, out, max);
+#endif
+    // Ordem crescente de nível (as entradas do SO vêm em qualquer ordem).
+    for (int i = 1; i < n; i++) {
+        cpu_cache_t c = out[i];
+        int j = i;
+        for (; j > 0 && out[j - 1].level > c.level; j--) out[j] = out[j - 1];
+        out[j] = c;
+    }
+    return n;
+}
+
+int topology_cpu_node(const cpu_topology_t *topo, int cpu){
+    if (!topo || cpu < 0 || cpu >= topo->cpu_count) return 0;
+    return topo->cpu_node[cpu];
+}
+
+int topology_remote_cpu(const cpu_topology_t *topo, int cpu){
+    if (!topo || topo->node_count <= 1 || cpu < 0 || cpu >= topo->cpu_count) return -1;
+    int home = topo->cpu_node[cpu];
+
+    // Posição de `cpu` entre as CPUs do seu próprio nó.
+    int rank = 0;
+    for (int c = 0; c < cpu; c++) {
+        if (topo->cpu_node[c] == home) rank++;
+    }
+
+    for (int step = 1; step < topo->node_count; step++) {
+        int target = (home + step) % topo->node_count;
+        int in_target = 0;
+        for (int c = 0; c < topo->cpu_count; c++) {
+            if (topo->cpu_node[c] == target) in_target++;
+        }
+        if (in_target == 0) continue; // Nó apenas com memória
+
+        int want = rank % in_target;
+        for (int c = 0; c < topo->cpu_count; c++) {
+            if (topo->cpu_node[c] != target) continue;
+            if (want-- == 0) return c;
+        }
+    }
+    return -1;
+}
+
+int affinity_policy_parse(const char *s){
+    if (!s) return -1;
+    if (strcmp(s, "physical") == 0) return AFFINITY_PHYSICAL_FIRST;
+    if (strcmp(s, "linear") == 0) return AFFINITY_LINEAR;
+    if (strcmp(s, "scatter") == 0) return AFFINITY_SCATTER;
+    if (strcmp(s, "compact") == 0) return AFFINITY_COMPACT;
+    if (strcmp(s, "smt-pairs") == 0) return AFFINITY_SMT_PAIRS;
+    return -1;
+}
+
+const char *affinity_policy_name(int policy){
+    switch (policy) {
+        case AFFINITY_LINEAR:    return "linear";
+        case AFFINITY_SCATTER:   return "espalhada (sockets/L3)";
+        case AFFINITY_COMPACT:   return "compacta";
+        case AFFINITY_SMT_PAIRS: return "pares SMT";
+        case AFFINITY_LIST:      return "lista de CPUs";
+        default:                 return "núcleos físicos primeiro";
+    }
+}
+
+static int cmp_place_key(const void *a, const void *b){
+    const place_key_t *x = a, *y = b;
+    for (int i = 0; i < 4; i++) {
+        if (x->k[i] != y->k[i]) return x->k[i] < y->k[i] ? -1 : 1;
+    }
+    return (x->cpu > y->cpu) - (x->cpu < y->cpu);
+}
+
+int topology_place(const cpu_topology_t *topo, int policy, const int *list, int list_count, int threads, int *out){
+    if (!topo || !out || threads <= 0) return -1;
+    if (policy == AFFINITY_LIST) {
+        if (!list || list_count <= 0) return -1;
+        for (int i = 0; i < list_count; i++) {
+            if (list[i] < 0 || list[i] >= topo->cpu_count) return -1;
+        }
+        for (int i = 0; i < threads; i++) out[i] = list[i % list_count];
+        return 0;
+    }
+
+    int n = topo->cpu_count;
+    place_key_t *keys = calloc(n, sizeof(place_key_t));
+    int *core_rank = calloc(topo->core_count, sizeof(int));   // posição do núcleo dentro do seu L3
+    int *l3_rank = calloc(topo->l3_count, sizeof(int));       // posição do L3 dentro do seu socket
+    int *per_l3 = calloc(topo->l3_count, sizeof(int));
+    int *per_package = calloc(topo->package_count, sizeof(int));
+    int *core_done = calloc(topo->core_count, sizeof(int));
+    int *l3_done = calloc(topo->l3_count, sizeof(int));
+    int ok = keys && core_rank && l3_rank && per_l3 && per_package && core_done && l3_done;
+    if (ok) {
+        // Numera os núcleos dentro de cada L3 e os L3 dentro de cada socket.
+        for (int c = 0; c < n; c++) {
+            int core = topo->cpu_core[c], l3 = topo->cpu_l3[c];
+            if (!core_done[core]) { core_done[core] = 1; core_rank[core] = per_l3[l3]++; }
+            if (!l3_done[l3]) { l3_done[l3] = 1; l3_rank[l3] = per_package[topo->cpu_package[c]]++; }
+        }
+        for (int c = 0; c < n; c++) {
+            int pkg = topo->cpu_package[c], l3 = topo->cpu_l3[c], core = topo->cpu_core[c], smt = topo->cpu_smt[c];
+            place_key_t *k = &keys[c];
+            k->cpu = c;
+            switch (policy) {
+                case AFFINITY_LINEAR:
+                    break;
+                case AFFINITY_COMPACT:
+                    k->k[0] = pkg; k->k[1] = l3; k->k[2] = core; k->k[3] = smt;
+                    break;
+                case AFFINITY_SCATTER:
+                    k->k[0] = smt; k->k[1] = core_rank[core]; k->k[2] = l3_rank[l3]; k->k[3] = pkg;
+                    break;
+                case AFFINITY_SMT_PAIRS:
+                    k->k[0] = core_rank[core]; k->k[1] = l3_rank[l3]; k->k[2] = pkg; k->k[3] = smt;
+                    break;
+                default: // AFFINITY_PHYSICAL_FIRST
+                    k->k[0] = smt; k->k[1] = core;
+                    break;
+            }
+        }
+        qsort(keys, n, sizeof(place_key_t), cmp_place_key);
+        for (int i = 0; i < threads; i++) out[i] = keys[i % n].cpu;
+    }
+    free(keys);
+    free(core_rank);
+    free(l3_rank);
+    free(per_l3);
+    free(per_package);
+    free(core_done);
+    free(l3_done);
+    return ok ? 0 : -1;
+}
+
+#ifndef _WIN32 /* LINUX IMPLEMENTATION */
+
+/**
+ * @brief Lê a primeira linha de um arquivo do sysfs.
+ * @return 0 em caso de sucesso, -1 em caso de falha.
+ */
+static int read_sysfs_line(const char *path, char *buf, size_t len){
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char *ok = fgets(buf, (int)len, f);
+    fclose(f);
+    return ok ? 0 : -1;
+}
+
+/**
+ * @brief Lê um inteiro de um arquivo do sysfs.
+ * @return O valor, ou `fallback` se o arquivo não existe ou é inválido.
+ */
+static int read_sysfs_int(const char *path, int fallback){
+    char line[64];
+    if (read_sysfs_line(path, line, sizeof(line)) != 0) return fallback;
+    char *end;
+    long v = strtol(line, &end, 10);
+    return end == line ? fallback : (int)v;
+}
+
+/**
+ * @brief Lê uma lista de CPUs e retorna sua menor CPU, que identifica o grupo (núcleo, L3).
+ * @param rank Se não-NULL, recebe quantas CPUs da lista são menores que `cpu`.
+ * @return A menor CPU da lista, ou -1 se o arquivo não existe ou é inválido.
+ */
+static int list_first_cpu(const char *path, int cpu, int *scratch, int max, int *rank){
+    char line[4096];
+    if (read_sysfs_line(path, line, sizeof(line)) != 0) return -1;
+    int n = parse_cpu_list(line, scratch, max);
+    if (n <= 0) return -1;
+    int first = scratch[0], below = 0;
+    for (int i = 0; i < n; i++) {
+        if (scratch[i] < first) first = scratch[i];
+        if (scratch[i] < cpu) below++;
+    }
+    if (rank) *rank = below;
+    return first;
+}
+
+/**
+ * @brief Preenche socket, núcleo, posição SMT e L3 a partir de `cpu<N>/topology` e `cpu<N>/cache`.
+ *
+ * Os núcleos e domínios de L3 são identificados pela menor CPU de `thread_siblings_list`
+ * e de `shared_cpu_list`; `densify` os renumera depois. Sem descrição de L3, o
+ * domínio é o socket.
+ */
+static void detect_cpus_linux(cpu_topology_t *topo, const char *root){
+    int max = 4096;
+    int *scratch = calloc(max, sizeof(int));
+    if (!scratch) return;
+    char base[256], path[384];
+    for (int c = 0; c < topo->cpu_count; c++) {
+        snprintf(base, sizeof(base), "%s/devices/system/cpu/cpu%d", root, c);
+
+        snprintf(path, sizeof(path), "%s/topology/physical_package_id", base);
+        int pkg = read_sysfs_int(path, 0);
+        if (pkg < 0) pkg = 0;
+        topo->cpu_package[c] = pkg;
+
+        int rank = 0;
+        snprintf(path, sizeof(path), "%s/topology/thread_siblings_list", base);
+        int core = list_first_cpu(path, c, scratch, max, &rank);
+        if (core < 0) {
+            snprintf(path, sizeof(path), "%s/topology/core_cpus_list", base);
+            core = list_first_cpu(path, c, scratch, max, &rank);
+        }
+        topo->cpu_core[c] = core >= 0 ? core : c;
+        topo->cpu_smt[c] = core >= 0 ? rank : 0;
+
+        int l3 = -1;
+        for (int i = 0; i < CACHE_INDEX_MAX && l3 < 0; i++) {
+            snprintf(path, sizeof(path), "%s/cache/index%d/level", base, i);
+            int level = read_sysfs_int(path, -1);
+            if (level < 0) break;
+            if (level != 3) continue;
+            snprintf(path, sizeof(path), "%s/cache/index%d/shared_cpu_list", base, i);
+            l3 = list_first_cpu(path, c, scratch, max, NULL);
+        }
+        topo->cpu_l3[c] = l3 >= 0 ? l3 : -1 - pkg;
+    }
+    free(scratch);
+}
+
+/**
+ * @brief Lê os caches de dados e unificados de `cpu<N>/cache/index<K>`.
+ *
+ * O tamanho vem como "48K", "2048K" ou "32M".
+ */
+static int detect_caches_linux(const char *root, int cpu, cpu_cache_t *out, int max){
+    int *scratch = calloc(4096, sizeof(int));
+    if (!scratch) return 0;
+    char base[256], path[384], line[64];
+    snprintf(base, sizeof(base), "%s/devices/system/cpu/cpu%d/cache", root, cpu);
+    int n = 0;
+    for (int i = 0; i < CACHE_INDEX_MAX && n < max; i++) {
+        snprintf(path, sizeof(path), "%s/index%d/level", base, i);
+        int level = read_sysfs_int(path, -1);
+        if (level < 0) break;
+        snprintf(path, sizeof(path), "%s/index%d/type", base, i);
+        if (read_sysfs_line(path, line, sizeof(line)) == 0 && strncmp(line, "Instruction", 11) == 0) continue;
+        snprintf(path, sizeof(path), "%s/index%d/size", base, i);
+        if (read_sysfs_line(path, line, sizeof(line)) != 0) continue;
+        char *end;
+        unsigned long long size = strtoull(line, &end, 10);
+        if (*end == 'K') size <<= 10;
+        else if (*end == 'M') size <<= 20;
+        else if (*end == 'G') size <<= 30;
+        if (size == 0) continue;
+        snprintf(path, sizeof(path), "%s/index%d/shared_cpu_list", base, i);
+        int shared = 0;
+        char list[4096];
+        if (read_sysfs_line(path, list, sizeof(list)) == 0) shared = parse_cpu_list(list, scratch, 4096);
+        out[n++] = (cpu_cache_t){ .level = level, .bytes = (size_t)size, .shared_cpus = shared > 0 ? shared : 0 };
+    }
+    free(scratch);
+    return n;
+}
+
+/**
+ * @brief Preenche `cpu_node` a partir de `<root>/devices/system/node/node<N>/cpulist`.
+ */
+static void detect_nodes_linux(cpu_topology_t *topo, const char *root){
+    char node_dir[256];
+    snprintf(node_dir, sizeof(node_dir), "%s/devices/system/node", root);
+    DIR *dir = opendir(node_dir);
+    if (!dir) return;
+
+    int *cpus = calloc(topo->cpu_count, sizeof(int));
+    if (!cpus) { closedir(dir); return; }
+
+    int max_node = 0;
+    struct dirent *de;
+    while ((de = readdir(dir)) != NULL) {
+        if (strncmp(de->d_name, "node", 4) != 0 || !isdigit((unsigned char)de->d_name[4])) continue;
+        int node = atoi(de->d_name + 4);
+
+        char path[600], line[4096];
+        snprintf(path, sizeof(path), "%s/%s/cpulist", node_dir, de->d_name);
+        if (read_sysfs_line(path, line, sizeof(line)) != 0) continue;
+
+        int n = parse_cpu_list(line, cpus, topo->cpu_count);
+        for (int i = 0; i < n; i++) {
+            if (cpus[i] >= 0 && cpus[i] < topo->cpu_count) topo->cpu_node[cpus[i]] = node;
+        }
+        if (n > 0 && node > max_node) max_node = node;
+    }
+    closedir(dir);
+    free(cpus);
+    topo->node_count = max_node + 1;
+}
+
+#else /* --- WINDOWS IMPLEMENTATION --- */
+
+/**
+ * @brief Preenche `cpu_node` usando `GetNumaProcessorNodeEx`, que aceita CPUs de qualquer grupo.
+ */
+static void detect_nodes_windows(cpu_topology_t *topo){
+    ULONG highest = 0;
+    if (!GetNumaHighestNodeNumber(&highest)) return;
+    int max_node = 0;
+    for (int c = 0; c < topo->cpu_count; c++) {
+        PROCESSOR_NUMBER pn = {0};
+        USHORT node = 0;
+        unsigned short group;
+        unsigned char number;
+        if (cpu_to_group(c, &group, &number) != 0) continue;
+        pn.Group = group;
+        pn.Number = number;
+        if (GetNumaProcessorNodeEx(&pn, &node) && node != 0xFFFF) {
+            topo->cpu_node[c] = node;
+            if (node > max_node) max_node = node;
+        }
+    }
+    topo->node_count = max_node + 1;
+}
+
+/**
+ * @brief Marca com `id` as CPUs de uma máscara de grupo, convertidas para o índice global.
+ */
+static void mark_group_mask(cpu_topology_t *topo, const GROUP_AFFINITY *ga, int *target, int id, int *smt){
+    for (int b = 0; b < 64; b++) {
+        if (!(ga->Mask & ((KAFFINITY)1 << b))) continue;
+        int c = cpu_from_group(ga->Group, (unsigned char)b);
+        if (c < 0 || c >= topo->cpu_count) continue;
+        target[c] = id;
+        if (smt) topo->cpu_smt[c] = (*smt)++;
+    }
+}
+
+/**
+ * @brief Preenche socket, núcleo, posição SMT e L3 com `GetLogicalProcessorInformationEx`.
+ *
+ * Um socket pode se estender por vários grupos de processadores; todas as máscaras
+ * de grupo de cada entrada são percorridas.
+ */
+static void detect_cpus_windows(cpu_topology_t *topo){
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(RelationAll, NULL, &len);
+    if (len == 0) return;
+    uint8_t *buf = malloc(len);
+    if (!buf) return;
+    if (!GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buf, &len)) {
+        free(buf);
+        return;
+    }
+    int core = 0, package = 0, l3 = 0;
+    for (DWORD off = 0; off < len; ) {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buf + off);
+        if (info->Relationship == RelationProcessorCore) {
+            int smt = 0, id = core++;
+            for (WORD g = 0; g < info->Processor.GroupCount; g++) {
+                mark_group_mask(topo, &info->Processor.GroupMask[g], topo->cpu_core, id, &smt);
+            }
+        } else if (info->Relationship == RelationProcessorPackage) {
+            int id = package++;
+            for (WORD g = 0; g < info->Processor.GroupCount; g++) {
+                mark_group_mask(topo, &info->Processor.GroupMask[g], topo->cpu_package, id, NULL);
+            }
+        } else if (info->Relationship == RelationCache && info->Cache.Level == 3) {
+            mark_group_mask(topo, &info->Cache.GroupMask, topo->cpu_l3, l3++, NULL);
+        }
+        off += info->Size;
+    }
+    free(buf);
+}
+
+/**
+ * @brief Lê os caches de dados e unificados que contêm `cpu` com `GetLogicalProcessorInformationEx`.
+ */
+static int detect_caches_windows(int cpu, cpu_cache_t *out, int max){
+    unsigned short group;
+    unsigned char number;
+    if (cpu_to_group(cpu, &group, &number) != 0) return 0;
+    DWORD len = 0;
+    GetLogicalProcessorInformationEx(RelationCache, NULL, &len);
+    if (len == 0) return 0;
+    uint8_t *buf = malloc(len);
+    if (!buf) return 0;
+    int n = 0;
+    if (GetLogicalProcessorInformationEx(RelationCache, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buf, &len)) {
+        for (DWORD off = 0; off < len && n < max; ) {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buf + off);
+            const CACHE_RELATIONSHIP *c = &info->Cache;
+            if (info->Relationship == RelationCache && c->Type != CacheInstruction &&
+                c->GroupMask.Group == group && (c->GroupMask.Mask & ((KAFFINITY)1 << number))) {
+                int shared = 0;
+                for (int b = 0; b < 64; b++) shared += (c->GroupMask.Mask >> b) & 1;
+                out[n++] = (cpu_cache_t){ .level = c->Level, .bytes = c->CacheSize, .shared_cpus = shared };
+            }
+            off += info->Size;
+        }
+    }
+    free(buf);
+    return n;
+}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+/**
+ * @file topology.h
+ * @brief Declara a detecção da topologia de CPUs e nós NUMA do sistema.
+ *
+ * Este módulo descobre a qual nó NUMA, socket, domínio de L3 e núcleo físico
+ * cada CPU lógica pertence, para que os workers possam ser fixados segundo uma
+ * política de posicionamento e ter seus buffers posicionados de forma
+ * determinística (memória local ou deliberadamente remota). Usa o sysfs
+ * (`/sys/devices/system/node` e `/sys/devices/system/cpu/cpu<N>/{topology,cache}`)
+ * no Linux e `GetLogicalProcessorInformationEx` e a API NUMA do Win32 no Windows.
+ */
+
+#include "hardstress.h"
+
+/**
+ * @struct cpu_topology_t
+ * @brief Mapeamento das CPUs lógicas para nós NUMA, sockets, domínios de L3 e núcleos físicos.
+ *
+ * Os índices de socket, L3 e núcleo são densos (0 a `*_count - 1`) e numerados na
+ * ordem da primeira CPU de cada um.
+ */
+struct cpu_topology_t {
+    int cpu_count;          ///< Número de CPUs lógicas descritas.
+    int node_count;         ///< Número de nós NUMA (1 em sistemas UMA ou quando a detecção falha).
+    int *cpu_node;          ///< Nó NUMA de cada CPU lógica (`cpu_count` entradas).
+    int package_count;      ///< Número de sockets.
+    int l3_count;           ///< Número de domínios de L3 (um por socket quando o cache não é descrito).
+    int core_count;         ///< Número de núcleos físicos.
+    int *cpu_package;       ///< Socket de cada CPU lógica.
+    int *cpu_l3;            ///< Domínio de L3 de cada CPU lógica.
+    int *cpu_core;          ///< Núcleo físico de cada CPU lógica.
+    int *cpu_smt;           ///< Posição da CPU entre os irmãos SMT do seu núcleo (0 = primeira thread).
+};
+
+/** @brief Máximo de níveis de cache descritos por `topology_caches`. */
+#define CPU_CACHE_MAX 8
+
+/**
+ * @struct cpu_cache_t
+ * @brief Um cache de dados (ou unificado) visto por uma CPU.
+ */
+typedef struct {
+    int level;              ///< Nível (1 = L1).
+    size_t bytes;           ///< Capacidade, em bytes.
+    int shared_cpus;        ///< CPUs lógicas que compartilham o cache (0 se desconhecido).
+} cpu_cache_t;
+
+/**
+ * @brief Detecta a topologia NUMA das CPUs lógicas.
+ *
+ * Nunca falha por falta de informação do SO: se os nós não puderem ser lidos,
+ * todas as CPUs são atribuídas ao nó 0.
+ *
+ * @param cpu_count O número de CPUs lógicas a descrever.
+ * @return Uma topologia alocada (liberar com `topology_free`), ou NULL se a alocação falhar.
+ */
+cpu_topology_t *topology_detect(int cpu_count);
+
+/**
+ * @brief Detecta a topologia a partir de uma raiz de sysfs alternativa.
+ *
+ * Igual a `topology_detect`, mas lê `<sysfs_root>/devices/system/{node,cpu}`; útil em
+ * testes com uma árvore sintética. No Windows a raiz é ignorada.
+ */
+cpu_topology_t *topology_detect_at(int cpu_count, const char *sysfs_root);
+
+/**
+ * @brief Lista os caches de dados e unificados de uma CPU, do L1 ao último nível.
+ *
+ * Usa `cpu<N>/cache/index<K>/{level,type,size,shared_cpu_list}` no Linux e as
+ * entradas `RelationCache` de `GetLogicalProcessorInformationEx` no Windows. Os
+ * caches de instruções são ignorados.
+ *
+ * @param cpu A CPU lógica.
+ * @param out Recebe os caches, em ordem crescente de nível.
+ * @param max A capacidade de `out`.
+ * @return O número de caches escritos (0 se o SO não os descreve).
+ */
+int topology_caches(int cpu, cpu_cache_t *out, int max);
+
+/**
+ * @brief Igual a `topology_caches`, mas lê `<sysfs_root>/devices/system/cpu`; no Windows a raiz é ignorada.
+ */
+int topology_caches_at(const char *sysfs_root, int cpu, cpu_cache_t *out, int max);
+
+/**
+ * @brief Libera uma topologia obtida com `topology_detect`.
+ * @param topo A topologia a ser liberada; NULL é ignorado.
+ */
+void topology_free(cpu_topology_t *topo);
+
+/**
+ * @brief Retorna o nó NUMA de uma CPU, ou 0 se a CPU estiver fora do intervalo.
+ */
+int topology_cpu_node(const cpu_topology_t *topo, int cpu);
+
+/**
+ * @brief Escolhe uma CPU em um nó NUMA diferente do nó de `cpu`.
+ *
+ * Usa o próximo nó (em ordem circular) e distribui as CPUs de origem entre as
+ * CPUs desse nó, para que workers diferentes não toquem a memória sempre a partir
+ * da mesma CPU remota.
+ *
+ * @param topo A topologia do sistema.
+ * @param cpu A CPU de origem.
+ * @return Uma CPU em outro nó, ou -1 se houver apenas um nó.
+ */
+int topology_remote_cpu(const cpu_topology_t *topo, int cpu);
+
+/**
+ * @brief Converte o nome de uma política ("physical", "linear", "scatter", "compact", "smt-pairs").
+ * @return A política (`affinity_policy_t`), ou -1 se o nome for desconhecido.
+ */
+int affinity_policy_parse(const char *s);
+
+/**
+ * @brief Retorna o nome legível de uma política de posicionamento.
+ */
+const char *affinity_policy_name(int policy);
+
+/**
+ * @brief Escolhe a CPU de cada worker segundo uma política de posicionamento.
+ *
+ * As CPUs são ordenadas pela política e os workers as ocupam nessa ordem; com mais
+ * workers do que CPUs, a ordem recomeça do início.
+ *
+ * @param topo A topologia do sistema.
+ * @param policy A política (`affinity_policy_t`).
+ * @param list As CPUs de `AFFINITY_LIST`, na ordem desejada (ignorado nas demais políticas).
+ * @param list_count O número de CPUs em `list`.
+ * @param threads O número de workers.
+ * @param out Recebe a CPU de cada worker (`threads` entradas).
+ * @return 0 em caso de sucesso, -1 se a lista for vazia, tiver CPUs fora da topologia ou faltar memória.
+ */
+int topology_place(const cpu_topology_t *topo, int policy, const int *list, int list_count, int threads, int *out);
+
+/**
+ * @brief Analisa uma lista de CPUs no formato do kernel (por exemplo, "0-3,8,10-11").
+ *
+ * @param s A string a ser analisada.
+ * @param out Array que recebe as CPUs, na ordem em que aparecem.
+ * @param max A capacidade de `out`.
+ * @return O número de CPUs escritas em `out`, ou -1 se a string for inválida.
+ */
+int parse_cpu_list(const char *s, int *out, int max);
+
+#endif // TOPOLOGY_H
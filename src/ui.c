@@ -3,11 +3,19 @@
 #include "core.h"
 #include "metrics.h"
 #include "utils.h"
+#include "kernels.h"
+#include "heatmap.h"
+#include "history.h"
+#include "sweep.h"
+#include "coherence.h"
+#include "pages.h"
+#include "storage.h"
+#include "jitter.h"
+#include "fleet.h"
 #include <math.h>
 #include <time.h>
 #include <errno.h>
 #include <stdarg.h>
-#include <float.h>
 
 /* --- Dark Theme Color Definitions --- */
 typedef struct {
@@ -29,10 +37,17 @@ static const rgba_t THEME_GRID = {0.235, 0.235, 0.314, 0.5};            // Subtl
 /* --- Static Function Prototypes --- */
 static gboolean on_draw_system_graph(GtkWidget *widget, cairo_t *cr, gpointer user_data);
 static gboolean on_draw_iters(GtkWidget *widget, cairo_t *cr, gpointer user_data);
+static gboolean draw_fleet_heatmap(GtkWidget *widget, cairo_t *cr, AppContext *app);
+static void draw_heat_cells(cairo_t *cr, const heatmap_t *heat, double x, double y, double w, double h, int cols, int oldest);
+static void draw_heat_legend(cairo_t *cr, double x, double y, double h, const heatmap_t *heat, const char *unit);
+static gboolean on_draw_sweep(GtkWidget *widget, cairo_t *cr, gpointer user_data);
+static gboolean on_draw_c2c(GtkWidget *widget, cairo_t *cr, gpointer user_data);
 static void on_btn_start_clicked(GtkButton *b, gpointer ud);
 static void on_btn_stop_clicked(GtkButton *b, gpointer ud);
 static void on_btn_defaults_clicked(GtkButton *b, gpointer ud);
 static void on_btn_clear_log_clicked(GtkButton *b, gpointer ud);
+static void on_heat_metric_changed(GtkComboBox *combo, gpointer ud);
+static void on_heat_span_changed(GtkComboBox *combo, gpointer ud);
 static gboolean on_window_delete(GtkWidget *w, GdkEvent *e, gpointer ud);
 static void on_window_destroy(GtkWidget *w, gpointer ud);
 static gboolean ui_tick(gpointer ud);
@@ -41,12 +56,29 @@ static gboolean gui_update_started(gpointer ud);
 static void apply_css_theme(GtkWidget *window);
 static void draw_rounded_rect(cairo_t *cr, double x, double y, double w, double h, double r);
 static void draw_grid_background(cairo_t *cr, int width, int height, int spacing);
-static double clamp01(double v);
-static rgba_t lerp_color(rgba_t a, rgba_t b, double t);
-static rgba_t heatmap_color(double normalized);
+static void draw_jitter_panel(cairo_t *cr, const jitter_result_t *r, double x, double y, double w, double h);
+static void draw_latency_cell(cairo_t *cr, double right, double y, double us);
 
 gboolean gui_update_stopped(gpointer ud);
 
+/** @brief Rótulo, unidade e fator de escala (contador por segundo -> unidade) de cada `thread_metric_t`. */
+static const struct { const char *label; const char *unit; double scale; } HEAT_METRICS[FLEET_METRIC_COUNT] = {
+    [THREAD_METRIC_PROGRESS]     = { "Progresso",   "it/s",      1.0 / ITER_PROGRESS_SCALE },
+    [THREAD_METRIC_FLOPS]        = { "FPU",         "GFLOP/s",   1e-9 },
+    [THREAD_METRIC_INT_OPS]      = { "INT",         "Gops/s",    1e-9 },
+    [THREAD_METRIC_STREAM_BYTES] = { "STREAM",      "GB/s",      1e-9 },
+    [THREAD_METRIC_PTR_LOADS]    = { "PTR",         "Mcargas/s", 1e-6 },
+    [THREAD_METRIC_ATOMIC_OPS]   = { "ATOMIC",      "Mops/s",    1e-6 },
+    [FLEET_METRIC_TEMP]          = { "Temperatura", "°C, frota", 1.0 },
+};
+
+/** @brief Intervalos de amostragem oferecidos na GUI, em milissegundos. */
+static const int INTERVAL_CHOICES_MS[] = { SAMPLE_INTERVAL_MIN_MS, 100, 250, 500, CPU_SAMPLE_INTERVAL_MS };
+#define INTERVAL_DEFAULT_CHOICE 4 ///< Índice de `CPU_SAMPLE_INTERVAL_MS` em `INTERVAL_CHOICES_MS`.
+
+/** @brief Proporções de leitura da E/S oferecidas na GUI, em %; a primeira é `IO_DEFAULT_READ_PCT`. */
+static const int IO_MIX_CHOICES[] = { IO_DEFAULT_READ_PCT, 100, 0, 50 };
+
 #ifndef TESTING_BUILD
 typedef struct {
     AppContext *app;
@@ -113,6 +145,91 @@ static void draw_rounded_rect(cairo_t *cr, double x, double y, double w, double
     cairo_close_path(cr);
 }
 
+/**
+ * @brief Escreve uma latência em µs alinhada à direita em `right`, colorida pelo tamanho (> 100 µs âmbar, > 1 ms vermelho).
+ */
+static void draw_latency_cell(cairo_t *cr, double right, double y, double us) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%.*f", us < 100.0 ? 1 : 0, us);
+    if (us > 1000.0) cairo_set_source_rgba(cr, THEME_ERROR.r, THEME_ERROR.g, THEME_ERROR.b, 1.0);
+    else if (us > 100.0) cairo_set_source_rgba(cr, THEME_WARN.r, THEME_WARN.g, THEME_WARN.b, 1.0);
+    else cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 0.9);
+    cairo_text_extents_t ext;
+    cairo_text_extents(cr, buf, &ext);
+    cairo_move_to(cr, right - ext.x_advance, y);
+    cairo_show_text(cr, buf);
+}
+
+/**
+ * @brief Desenha, ao lado do gráfico do sistema, a latência de despertar da sonda de jitter por CPU.
+ *
+ * Com mais CPUs do que linhas, mostra as de maior p99; a última linha reúne todas as CPUs.
+ */
+static void draw_jitter_panel(cairo_t *cr, const jitter_result_t *r, double x, double y, double w, double h) {
+    const double row_h = 14.0;
+    const double right[4] = { x + 100.0, x + 150.0, x + 200.0, x + w - 8.0 }; // p50, p99, p99.9, máx.
+    cairo_set_source_rgba(cr, THEME_BG_TERTIARY.r, THEME_BG_TERTIARY.g, THEME_BG_TERTIARY.b, 0.7);
+    draw_rounded_rect(cr, x, y, w, h, 6.0);
+    cairo_fill(cr);
+
+    int rows = (int)((h - 44.0) / row_h) - 1; // Reserva a linha de todas as CPUs.
+    if (rows < 0) rows = 0;
+    int shown = r->n < rows ? r->n : rows;
+    char title[64];
+    if (shown < r->n) snprintf(title, sizeof(title), "Jitter (µs), %d piores de %d CPUs", shown, r->n);
+    else snprintf(title, sizeof(title), "Jitter de despertar (µs)");
+    cairo_select_font_face(cr, "Inter", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+    cairo_set_font_size(cr, 12);
+    cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 1.0);
+    cairo_move_to(cr, x + 8.0, y + 17.0);
+    cairo_show_text(cr, title);
+
+    cairo_select_font_face(cr, "Inter", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 10.5);
+    const char *heads[4] = { "p50", "p99", "p99.9", "máx." };
+    double ty = y + 34.0;
+    cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.9);
+    cairo_move_to(cr, x + 8.0, ty);
+    cairo_show_text(cr, "CPU");
+    for (int c = 0; c < 4; c++) {
+        cairo_text_extents_t ext;
+        cairo_text_extents(cr, heads[c], &ext);
+        cairo_move_to(cr, right[c] - ext.x_advance, ty);
+        cairo_show_text(cr, heads[c]);
+    }
+
+    // Seleção das linhas: todas as CPUs em ordem ou, sem espaço, as de maior p99.
+    unsigned char *used = shown < r->n ? calloc((size_t)r->n, 1) : NULL;
+    if (shown < r->n && !used) shown = 0;
+    for (int k = 0; k < shown; k++) {
+        int i = k;
+        if (used) {
+            i = -1;
+            for (int c = 0; c < r->n; c++) {
+                if (!used[c] && (i < 0 || r->cpu[c].p99_us > r->cpu[i].p99_us)) i = c;
+            }
+            used[i] = 1;
+        }
+        const jitter_stats_t *st = &r->cpu[i];
+        ty += row_h;
+        char label[16];
+        snprintf(label, sizeof(label), "%d", st->cpu);
+        cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.9);
+        cairo_move_to(cr, x + 8.0, ty);
+        cairo_show_text(cr, label);
+        const double v[4] = { st->p50_us, st->p99_us, st->p999_us, st->max_us };
+        for (int c = 0; c < 4; c++) draw_latency_cell(cr, right[c], ty, v[c]);
+    }
+    free(used);
+
+    ty += row_h + 2.0;
+    cairo_set_source_rgba(cr, THEME_ACCENT.r, THEME_ACCENT.g, THEME_ACCENT.b, 0.9);
+    cairo_move_to(cr, x + 8.0, ty);
+    cairo_show_text(cr, "Todas");
+    const double v[4] = { r->all.p50_us, r->all.p99_us, r->all.p999_us, r->all.max_us };
+    for (int c = 0; c < 4; c++) draw_latency_cell(cr, right[c], ty, v[c]);
+}
+
 /**
  * @brief Função auxiliar do Cairo para desenhar um padrão de fundo de grade.
  */
@@ -135,34 +252,6 @@ static void G_GNUC_UNUSED draw_grid_background(cairo_t *cr, int width, int heigh
     cairo_stroke(cr);
 }
 
-static double clamp01(double v) {
-    if (v < 0.0) return 0.0;
-    if (v > 1.0) return 1.0;
-    return v;
-}
-
-static rgba_t lerp_color(rgba_t a, rgba_t b, double t) {
-    rgba_t r = {
-        a.r + (b.r - a.r) * t,
-        a.g + (b.g - a.g) * t,
-        a.b + (b.b - a.b) * t,
-        a.a + (b.a - a.a) * t
-    };
-    return r;
-}
-
-static rgba_t heatmap_color(double normalized) {
-    static const rgba_t cold = {0.047, 0.203, 0.725, 1.0};
-    static const rgba_t warm = {1.0, 0.933, 0.0, 1.0};
-    static const rgba_t hot = {0.913, 0.231, 0.231, 1.0};
-
-    double n = clamp01(normalized);
-    if (n <= 0.5) {
-        return lerp_color(cold, warm, n / 0.5);
-    }
-    return lerp_color(warm, hot, (n - 0.5) / 0.5);
-}
-
 /**
  * @brief Callback para o evento "destroy" da janela.
  *
@@ -199,6 +288,20 @@ static void on_window_destroy(GtkWidget *w, gpointer ud) {
     app->core_temps = NULL;
     app->core_temp_count = 0;
     g_mutex_unlock(&app->temp_mutex);
+    heatmap_free(app->heatmap);
+    app->heatmap = NULL;
+    heatmap_free(app->heatmap_run);
+    app->heatmap_run = NULL;
+    free(app->sweep);
+    app->sweep = NULL;
+    free(app->c2c);
+    app->c2c = NULL;
+    free(app->jitter_live);
+    app->jitter_live = NULL;
+    heatmap_free(app->heatmap_fleet);
+    app->heatmap_fleet = NULL;
+    fleet_free(app->fleet);
+    app->fleet = NULL;
     g_mutex_clear(&app->cpu_mutex);
     g_mutex_clear(&app->history_mutex);
     g_mutex_clear(&app->temp_mutex);
@@ -209,6 +312,14 @@ static void on_window_destroy(GtkWidget *w, gpointer ud) {
     app->temp_history = NULL;
     free(app->avg_cpu_history);
     app->avg_cpu_history = NULL;
+    free(app->avg_freq_history);
+    app->avg_freq_history = NULL;
+    free(app->throttle_thermal_history);
+    app->throttle_thermal_history = NULL;
+    free(app->throttle_power_history);
+    app->throttle_power_history = NULL;
+    free(app->io_mbps_history);
+    app->io_mbps_history = NULL;
 
     free(app);
 
@@ -235,7 +346,7 @@ static gboolean gui_set_temp_panel_visibility_dispatch(gpointer data) {
  * @param visible TRUE para mostrar o painel, FALSE para ocultá-lo.
  */
 void gui_set_temp_panel_visibility(AppContext *app, gboolean visible) {
-    if (!app) return;
+    if (!app || app->headless) return;
 
     // Verifica se o estado já é o solicitado para evitar atualizações redundantes da interface do usuário
     if (app->temp_visibility_state == (int)visible) {
@@ -257,6 +368,29 @@ void gui_set_temp_panel_visibility(AppContext *app, gboolean visible) {
 void gui_log(AppContext *app, const char *fmt, ...){
     if (!app || !fmt) return;
 
+    if (app->headless) {
+        // Sem loop principal do GTK: escreve diretamente no stdout com o mesmo carimbo de data/hora.
+        time_t now = time(NULL);
+        struct tm t;
+#ifdef _WIN32
+        localtime_s(&t, &now);
+#else
+        localtime_r(&now, &t);
+#endif
+        char timestamp[32];
+        strftime(timestamp, sizeof(timestamp), "[%H:%M:%S]", &t);
+        va_list ap;
+        va_start(ap, fmt);
+        char *formatted = g_strdup_vprintf(fmt, ap);
+        va_end(ap);
+        if (!formatted) return;
+        // Uma única chamada de stdio por linha para não intercalar mensagens de threads diferentes.
+        fprintf(stdout, "%s %s", timestamp, formatted);
+        fflush(stdout);
+        g_free(formatted);
+        return;
+    }
+
     va_list ap;
     va_start(ap, fmt);
     char *formatted = g_strdup_vprintf(fmt, ap);
@@ -331,8 +465,8 @@ static gboolean gui_update_started(gpointer ud){
     AppContext *app = (AppContext*)ud;
     gtk_widget_set_sensitive(app->btn_stop, TRUE);
     gtk_label_set_text(GTK_LABEL(app->status_label), "🚀 Executando...");
-    gui_log(app, "[GUI] Teste iniciado: threads=%d mem/thread=%zu dur=%ds pin=%d\n",
-            app->threads, app->mem_mib_per_thread, app->duration_sec, app->pin_affinity);
+    gui_log(app, "[GUI] Teste iniciado: threads=%d mem/thread=%zu dur=%ds pin=%d numa=%d\n",
+            app->threads, app->mem_mib_per_thread, app->duration_sec, app->pin_affinity, app->numa_mode);
     return G_SOURCE_REMOVE;
 }
 
@@ -396,19 +530,89 @@ static void on_btn_start_clicked(GtkButton *b, gpointer ud){
     app->threads = (threads == 0) ? detect_cpu_count() : (int)threads;
     app->mem_mib_per_thread = DEFAULT_MEM_MIB;
     app->duration_sec = (int)dur;
+    int interval_choice = gtk_combo_box_get_active(GTK_COMBO_BOX(app->combo_interval));
+    app->sample_interval_ms = (interval_choice >= 0 && interval_choice < (int)(sizeof(INTERVAL_CHOICES_MS) / sizeof(INTERVAL_CHOICES_MS[0])))
+                              ? INTERVAL_CHOICES_MS[interval_choice] : CPU_SAMPLE_INTERVAL_MS;
     app->pin_affinity = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_pin));
+    app->affinity_policy = gtk_combo_box_get_active(GTK_COMBO_BOX(app->combo_affinity));
+    if (app->affinity_policy < AFFINITY_PHYSICAL_FIRST || app->affinity_policy > AFFINITY_SMT_PAIRS) app->affinity_policy = AFFINITY_PHYSICAL_FIRST;
+    app->stream_nt = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_stream_nt));
+    app->perf_en = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_perf));
+    app->sweep_max_mib = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_sweep)) ? DEFAULT_SWEEP_MAX_MIB : 0;
+    app->c2c_en = !app->sweep_max_mib && gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_c2c));
+    app->jitter_en = !app->sweep_max_mib && !app->c2c_en && gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_jitter));
+    app->verify_en = !app->sweep_max_mib && !app->c2c_en && gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_verify));
+    app->numa_mode = gtk_combo_box_get_active(GTK_COMBO_BOX(app->combo_numa));
+    if (app->numa_mode < NUMA_MODE_OFF || app->numa_mode > NUMA_MODE_REMOTE) app->numa_mode = NUMA_MODE_OFF;
+    app->page_mode = gtk_combo_box_get_active(GTK_COMBO_BOX(app->combo_pages));
+    if (app->page_mode < PAGE_MODE_DEFAULT || app->page_mode > PAGE_MODE_HUGE_1G) app->page_mode = PAGE_MODE_DEFAULT;
+    static const size_t fp_block_choices[] = { 0, 32, 256 };
+    int chains_choice = gtk_combo_box_get_active(GTK_COMBO_BOX(app->combo_ptr_chains));
+    app->ptr_chains = (chains_choice >= 0 && chains_choice < 5) ? 1 << chains_choice : 1;
+    int fp_choice = gtk_combo_box_get_active(GTK_COMBO_BOX(app->combo_fp_block));
+    app->fp_block_kib = (fp_choice >= 0 && fp_choice < 3) ? fp_block_choices[fp_choice] : 0;
     app->kernel_fpu_en = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_fpu));
     app->kernel_int_en = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_int));
     app->kernel_stream_en = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_stream));
     app->kernel_ptr_en = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_ptr));
-
-    if (!app->kernel_fpu_en && !app->kernel_int_en && !app->kernel_stream_en && !app->kernel_ptr_en) {
+    app->kernel_atomic_en = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->check_atomic));
+    const char *io_path = gtk_entry_get_text(GTK_ENTRY(app->entry_io_path));
+    if (strlen(io_path) >= sizeof(app->io_path)) {
+        gui_log(app, "[GUI] ERRO: Caminho de E/S longo demais.\n");
+        return;
+    }
+    // A E/S acompanha o teste de estresse; a varredura e a matriz c2c a ignoram.
+    snprintf(app->io_path, sizeof(app->io_path), "%s", (app->sweep_max_mib || app->c2c_en) ? "" : io_path);
+    int mix_choice = gtk_combo_box_get_active(GTK_COMBO_BOX(app->combo_io_mix));
+    app->io_read_pct = (mix_choice >= 0 && mix_choice < (int)(sizeof(IO_MIX_CHOICES) / sizeof(IO_MIX_CHOICES[0])))
+                       ? IO_MIX_CHOICES[mix_choice] : IO_DEFAULT_READ_PCT;
+    // Escritas em arquivos e dispositivos existentes só pela linha de comando (--io-destructive).
+    app->io_destructive = 0;
+
+    if (!app->sweep_max_mib && !app->c2c_en && !app->kernel_fpu_en && !app->kernel_int_en && !app->kernel_stream_en &&
+        !app->kernel_ptr_en && !app->kernel_atomic_en) {
         gui_log(app, "[GUI] ERRO: Pelo menos um kernel de estresse deve ser selecionado.\n");
         return;
     }
 
+    // Com nós informados a GUI coordena a frota: a configuração vai para os agentes e nada roda aqui.
+    fleet_free(app->fleet);
+    app->fleet = NULL;
+    heatmap_free(app->heatmap_fleet);
+    app->heatmap_fleet = NULL;
+    const char *nodes = gtk_entry_get_text(GTK_ENTRY(app->entry_fleet));
+    if (nodes[strspn(nodes, " \t,")] != '\0') {
+        if (app->sweep_max_mib || app->c2c_en) {
+            gui_log(app, "[GUI] ERRO: A frota executa apenas o teste de estresse, sem varredura nem matriz c2c.\n");
+            return;
+        }
+        char err[160];
+        fleet_t *f = fleet_create(nodes, err, sizeof(err));
+        if (!f) {
+            gui_log(app, "[GUI] ERRO: Lista de nós inválida: %s.\n", err);
+            return;
+        }
+        // Cada agente resolve "Auto" com as suas próprias CPUs.
+        app->threads = (int)threads;
+        int len = fleet_config_args(app, f->args, sizeof(f->args));
+        if (len < 0) {
+            gui_log(app, "[GUI] ERRO: A configuração não cabe em uma mensagem da frota.\n");
+            fleet_free(f);
+            return;
+        }
+        f->args_len = (size_t)len;
+        app->fleet = f;
+        set_controls_sensitive(app, FALSE);
+        gtk_widget_set_sensitive(app->btn_stop, TRUE);
+        gtk_label_set_text(GTK_LABEL(app->status_label), "🌐 Coordenando a frota...");
+        gui_log(app, "[GUI] Coordenando %d nó(s): %s\n", f->n, nodes);
+        thread_create(&app->controller_thread, fleet_coordinator_thread_func, app);
+        return;
+    }
+
+    // A varredura usa um único buffer, limitado pela controladora a um quarto da memória; a matriz c2c, nenhum.
     unsigned long long total_mem_bytes = get_total_system_memory();
-    if (total_mem_bytes > 0 && app->threads > 0) {
+    if (total_mem_bytes > 0 && app->threads > 0 && !app->sweep_max_mib && !app->c2c_en) {
         unsigned long long required_bytes = app->mem_mib_per_thread * 1024ULL * 1024ULL;
         required_bytes *= (unsigned long long)app->threads;
         long double usage_ratio = (long double)required_bytes / (long double)total_mem_bytes;
@@ -451,14 +655,30 @@ static void on_btn_defaults_clicked(GtkButton *b, gpointer ud) {
     gtk_combo_box_set_active(GTK_COMBO_BOX(app->entry_threads), 0);
 
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_pin), TRUE);
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_affinity), AFFINITY_PHYSICAL_FIRST);
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_numa), NUMA_MODE_OFF);
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_pages), PAGE_MODE_DEFAULT);
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_fp_block), 0);
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_stream_nt), FALSE);
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_verify), FALSE);
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_perf), FALSE);
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_sweep), FALSE);
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_c2c), FALSE);
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_jitter), FALSE);
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_ptr_chains), 0);
+    gtk_entry_set_text(GTK_ENTRY(app->entry_io_path), "");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_io_mix), 0);
+    gtk_entry_set_text(GTK_ENTRY(app->entry_fleet), "");
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_fpu), TRUE);
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_int), TRUE);
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_stream), TRUE);
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_ptr), TRUE);
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_atomic), FALSE);
 
     char dur_buf[32];
     snprintf(dur_buf, sizeof(dur_buf), "%d", DEFAULT_DURATION_SEC);
     gtk_entry_set_text(GTK_ENTRY(app->entry_dur), dur_buf);
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_interval), INTERVAL_DEFAULT_CHOICE);
 
     gui_log(app, "[GUI] Settings restored to defaults.\n");
 }
@@ -473,6 +693,20 @@ static void on_btn_clear_log_clicked(GtkButton *b, gpointer ud) {
     gui_log(app, "[GUI] Log cleared.\n");
 }
 
+static void on_heat_metric_changed(GtkComboBox *combo, gpointer ud) {
+    AppContext *app = (AppContext*)ud;
+    int m = gtk_combo_box_get_active(combo);
+    // A temperatura só existe por nó; no teste local o heatmap mostra o progresso.
+    app->heat_metric = (m >= 0 && m < FLEET_METRIC_COUNT) ? m : THREAD_METRIC_PROGRESS;
+    gtk_widget_queue_draw(app->iters_drawing);
+}
+
+static void on_heat_span_changed(GtkComboBox *combo, gpointer ud) {
+    AppContext *app = (AppContext*)ud;
+    app->heat_span = gtk_combo_box_get_active(combo) == 1 ? 1 : 0;
+    gtk_widget_queue_draw(app->iters_drawing);
+}
+
 static gboolean check_if_stopped_and_close(gpointer user_data) {
     AppContext *app = (AppContext*)user_data;
 
@@ -516,12 +750,22 @@ static gboolean ui_tick(gpointer ud){
         }
         return TRUE;
     }
-    static unsigned long long last_total = 0;
-    unsigned long long cur = atomic_load(&app->total_iters);
-    unsigned long long diff = cur - last_total;
-    last_total = cur;
-    char buf[256];
-    snprintf(buf, sizeof(buf), "⚡ Desempenho: %llu iters/s | Erros: %d", diff, atomic_load(&app->errors));
+    if (app->fleet) {
+        char status[256];
+        fleet_format_status(app, status, sizeof(status));
+        char buf[300];
+        snprintf(buf, sizeof(buf), "🌐 %s | Erros: %d", status, atomic_load(&app->errors));
+        gtk_label_set_text(GTK_LABEL(app->status_label), buf);
+        return TRUE;
+    }
+    char rates[256];
+    format_kernel_rates(app, rates, sizeof(rates));
+    char perf[320];
+    int have_perf = format_perf_rates(app, perf, sizeof(perf));
+    char buf[600];
+    size_t len = (size_t)snprintf(buf, sizeof(buf), "⚡ %s", rates);
+    if (len < sizeof(buf)) len += snprintf(buf + len, sizeof(buf) - len, " | Erros: %d", atomic_load(&app->errors));
+    if (have_perf && len < sizeof(buf)) snprintf(buf + len, sizeof(buf) - len, "\n🔬 %s", perf);
     gtk_label_set_text(GTK_LABEL(app->status_label), buf);
     return TRUE;
 }
@@ -612,6 +856,20 @@ GtkWidget* create_main_window(AppContext *app) {
     gtk_entry_set_placeholder_text(GTK_ENTRY(app->entry_dur), "Tempo em segundos");
     gtk_grid_attach(GTK_GRID(config_grid), app->entry_dur, 1, row++, 1, 1);
 
+    // Sampling interval
+    GtkWidget *interval_label = gtk_label_new("Amostragem:");
+    gtk_widget_set_halign(interval_label, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(config_grid), interval_label, 0, row, 1, 1);
+    app->combo_interval = gtk_combo_box_text_new();
+    for (size_t i = 0; i < sizeof(INTERVAL_CHOICES_MS) / sizeof(INTERVAL_CHOICES_MS[0]); i++) {
+        char buf[16];
+        if (INTERVAL_CHOICES_MS[i] >= 1000) snprintf(buf, sizeof(buf), "%d s", INTERVAL_CHOICES_MS[i] / 1000);
+        else snprintf(buf, sizeof(buf), "%d ms", INTERVAL_CHOICES_MS[i]);
+        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_interval), buf);
+    }
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_interval), INTERVAL_DEFAULT_CHOICE);
+    gtk_grid_attach(GTK_GRID(config_grid), app->combo_interval, 1, row++, 1, 1);
+
     // Kernels Frame
     GtkWidget *kernel_frame = gtk_frame_new("Kernels de Estresse");
     GtkWidget *kernel_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 8);
@@ -623,6 +881,7 @@ GtkWidget* create_main_window(AppContext *app) {
     app->check_int = gtk_check_button_new_with_label("ALU (Inteiros)");
     app->check_stream = gtk_check_button_new_with_label("Fluxo de Memória");
     app->check_ptr = gtk_check_button_new_with_label("Perseguição de Ponteiro");
+    app->check_atomic = gtk_check_button_new_with_label("Contenção Atômica (linhas compartilhadas)");
     
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_fpu), TRUE);
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->check_int), TRUE);
@@ -633,6 +892,7 @@ GtkWidget* create_main_window(AppContext *app) {
     gtk_box_pack_start(GTK_BOX(kernel_box), app->check_int, FALSE, FALSE, 0);
     gtk_box_pack_start(GTK_BOX(kernel_box), app->check_stream, FALSE, FALSE, 0);
     gtk_box_pack_start(GTK_BOX(kernel_box), app->check_ptr, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(kernel_box), app->check_atomic, FALSE, FALSE, 0);
 
     // Additional Options
     GtkWidget *options_frame = gtk_frame_new("Opções");
@@ -646,6 +906,122 @@ GtkWidget* create_main_window(AppContext *app) {
 
     gtk_box_pack_start(GTK_BOX(options_box), app->check_pin, FALSE, FALSE, 0);
 
+    GtkWidget *affinity_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    GtkWidget *affinity_label = gtk_label_new("Posicionamento:");
+    gtk_widget_set_halign(affinity_label, GTK_ALIGN_START);
+    app->combo_affinity = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_affinity), "Núcleos físicos primeiro");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_affinity), "Linear");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_affinity), "Espalhar (sockets/L3)");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_affinity), "Compacto");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_affinity), "Pares SMT");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_affinity), AFFINITY_PHYSICAL_FIRST);
+    gtk_box_pack_start(GTK_BOX(affinity_row), affinity_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(affinity_row), app->combo_affinity, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(options_box), affinity_row, FALSE, FALSE, 0);
+
+    app->check_stream_nt = gtk_check_button_new_with_label("Stores não-temporais (stream)");
+    gtk_widget_set_sensitive(app->check_stream_nt, stream_nt_supported());
+    gtk_box_pack_start(GTK_BOX(options_box), app->check_stream_nt, FALSE, FALSE, 0);
+
+    app->check_verify = gtk_check_button_new_with_label("Verificar a memória (stream confere os padrões)");
+    gtk_box_pack_start(GTK_BOX(options_box), app->check_verify, FALSE, FALSE, 0);
+
+    app->check_perf = gtk_check_button_new_with_label("Contadores de hardware (IPC/MPKI)");
+    gtk_box_pack_start(GTK_BOX(options_box), app->check_perf, FALSE, FALSE, 0);
+
+    app->check_sweep = gtk_check_button_new_with_label("Varredura de caches (em vez do teste)");
+    gtk_box_pack_start(GTK_BOX(options_box), app->check_sweep, FALSE, FALSE, 0);
+
+    app->check_c2c = gtk_check_button_new_with_label("Latência entre núcleos (em vez do teste)");
+    gtk_box_pack_start(GTK_BOX(options_box), app->check_c2c, FALSE, FALSE, 0);
+
+    app->check_jitter = gtk_check_button_new_with_label("Sonda de jitter (latência de despertar por CPU)");
+    gtk_box_pack_start(GTK_BOX(options_box), app->check_jitter, FALSE, FALSE, 0);
+
+    GtkWidget *numa_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    GtkWidget *numa_label = gtk_label_new("NUMA:");
+    gtk_widget_set_halign(numa_label, GTK_ALIGN_START);
+    app->combo_numa = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_numa), "Desligado");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_numa), "Memória local");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_numa), "Memória remota");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_numa), NUMA_MODE_OFF);
+    gtk_box_pack_start(GTK_BOX(numa_row), numa_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(numa_row), app->combo_numa, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(options_box), numa_row, FALSE, FALSE, 0);
+
+    GtkWidget *pages_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    GtkWidget *pages_label = gtk_label_new("Páginas:");
+    gtk_widget_set_halign(pages_label, GTK_ALIGN_START);
+    app->combo_pages = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_pages), "Padrão (4 KiB)");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_pages), "THP (madvise)");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_pages), "Huge 2 MiB");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_pages), "Huge 1 GiB");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_pages), PAGE_MODE_DEFAULT);
+    gtk_box_pack_start(GTK_BOX(pages_row), pages_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(pages_row), app->combo_pages, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(options_box), pages_row, FALSE, FALSE, 0);
+
+    GtkWidget *fp_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    GtkWidget *fp_label = gtk_label_new("FPU:");
+    gtk_widget_set_halign(fp_label, GTK_ALIGN_START);
+    app->combo_fp_block = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_fp_block), "Registradores");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_fp_block), "Bloco 32 KiB (L1)");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_fp_block), "Bloco 256 KiB (L2)");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_fp_block), 0);
+    gtk_box_pack_start(GTK_BOX(fp_row), fp_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(fp_row), app->combo_fp_block, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(options_box), fp_row, FALSE, FALSE, 0);
+
+    GtkWidget *ptr_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    GtkWidget *ptr_label = gtk_label_new("Cadeias ptr:");
+    gtk_widget_set_halign(ptr_label, GTK_ALIGN_START);
+    app->combo_ptr_chains = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_ptr_chains), "1 (latência)");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_ptr_chains), "2");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_ptr_chains), "4");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_ptr_chains), "8");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_ptr_chains), "16");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_ptr_chains), 0);
+    gtk_box_pack_start(GTK_BOX(ptr_row), ptr_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(ptr_row), app->combo_ptr_chains, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(options_box), ptr_row, FALSE, FALSE, 0);
+
+    GtkWidget *io_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    GtkWidget *io_label = gtk_label_new("E/S:");
+    gtk_widget_set_halign(io_label, GTK_ALIGN_START);
+    app->entry_io_path = gtk_entry_new();
+    gtk_entry_set_placeholder_text(GTK_ENTRY(app->entry_io_path), "Arquivo ou diretório (vazio = sem E/S)");
+    gtk_box_pack_start(GTK_BOX(io_row), io_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(io_row), app->entry_io_path, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(options_box), io_row, FALSE, FALSE, 0);
+
+    GtkWidget *io_mix_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    GtkWidget *io_mix_label = gtk_label_new("Mistura E/S:");
+    gtk_widget_set_halign(io_mix_label, GTK_ALIGN_START);
+    app->combo_io_mix = gtk_combo_box_text_new();
+    for (size_t i = 0; i < sizeof(IO_MIX_CHOICES) / sizeof(IO_MIX_CHOICES[0]); i++) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%d%% leituras, fila %d, %d KiB", IO_MIX_CHOICES[i], IO_DEFAULT_QD, IO_DEFAULT_BLOCK_KIB);
+        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_io_mix), buf);
+    }
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_io_mix), 0);
+    gtk_box_pack_start(GTK_BOX(io_mix_row), io_mix_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(io_mix_row), app->combo_io_mix, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(options_box), io_mix_row, FALSE, FALSE, 0);
+
+    GtkWidget *fleet_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    GtkWidget *fleet_label = gtk_label_new("Nós:");
+    gtk_widget_set_halign(fleet_label, GTK_ALIGN_START);
+    app->entry_fleet = gtk_entry_new();
+    gtk_entry_set_placeholder_text(GTK_ENTRY(app->entry_fleet), "host[:porta], ... (vazio = teste local)");
+    gtk_box_pack_start(GTK_BOX(fleet_row), fleet_label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(fleet_row), app->entry_fleet, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(options_box), fleet_row, FALSE, FALSE, 0);
+
     // Control Buttons
     GtkWidget *button_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
     app->btn_start = gtk_button_new_with_label("▶ Start");
@@ -685,9 +1061,28 @@ GtkWidget* create_main_window(AppContext *app) {
 
     // Iterations Graph
     GtkWidget *iters_frame = gtk_frame_new("Thread Heatmap");
+    GtkWidget *iters_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 4);
+    gtk_container_add(GTK_CONTAINER(iters_frame), iters_box);
+    GtkWidget *metric_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    gtk_box_pack_start(GTK_BOX(metric_row), gtk_label_new("Métrica:"), FALSE, FALSE, 0);
+    app->combo_heat_metric = gtk_combo_box_text_new();
+    for (int m = 0; m < FLEET_METRIC_COUNT; m++) {
+        char item[64];
+        snprintf(item, sizeof(item), "%s (%s)", HEAT_METRICS[m].label, HEAT_METRICS[m].unit);
+        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_heat_metric), item);
+    }
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_heat_metric), app->heat_metric);
+    gtk_box_pack_start(GTK_BOX(metric_row), app->combo_heat_metric, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(metric_row), gtk_label_new("Janela:"), FALSE, FALSE, 0);
+    app->combo_heat_span = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_heat_span), "Recente (resolução total)");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(app->combo_heat_span), "Teste inteiro (médias)");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(app->combo_heat_span), app->heat_span);
+    gtk_box_pack_start(GTK_BOX(metric_row), app->combo_heat_span, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(iters_box), metric_row, FALSE, FALSE, 0);
     app->iters_drawing = gtk_drawing_area_new();
     gtk_widget_set_size_request(app->iters_drawing, -1, 300);
-    gtk_container_add(GTK_CONTAINER(iters_frame), app->iters_drawing);
+    gtk_box_pack_start(GTK_BOX(iters_box), app->iters_drawing, TRUE, TRUE, 0);
     gtk_box_pack_start(GTK_BOX(main_area), iters_frame, FALSE, FALSE, 0);
 
     // Heatmap Legend
@@ -696,12 +1091,26 @@ GtkWidget* create_main_window(AppContext *app) {
         "<b>Como ler o Heatmap:</b>\n"
         "• <b>Eixo Vertical (Y):</b> Cada linha representa uma thread de trabalho individual (T0, T1, etc.).\n"
         "• <b>Eixo Horizontal (X):</b> Representa o tempo, com os dados mais recentes sendo exibidos à direita.\n"
-        "• <b>Cores:</b> A cor de cada célula indica a intensidade da atividade (iterações por segundo). Cores mais quentes (amarelo, vermelho) significam maior desempenho, enquanto cores frias (azul) indicam menor atividade.");
+        "• <b>Cores:</b> A cor de cada célula indica a taxa da métrica selecionada (progresso, GFLOP/s, Gops/s, GB/s, cargas/s ou operações atômicas/s) da thread naquele segundo. Cores mais quentes (amarelo, vermelho) significam maior desempenho, enquanto cores frias (azul) indicam menor atividade.");
     gtk_label_set_xalign(GTK_LABEL(heatmap_legend), 0.0);
     gtk_label_set_line_wrap(GTK_LABEL(heatmap_legend), TRUE);
     gtk_style_context_add_class(gtk_widget_get_style_context(heatmap_legend), "legend-label");
     gtk_box_pack_start(GTK_BOX(main_area), heatmap_legend, FALSE, FALSE, 0);
 
+    // Cache Sweep Curve
+    GtkWidget *sweep_frame = gtk_frame_new("Curva de Caches");
+    app->sweep_drawing = gtk_drawing_area_new();
+    gtk_widget_set_size_request(app->sweep_drawing, -1, 260);
+    gtk_container_add(GTK_CONTAINER(sweep_frame), app->sweep_drawing);
+    gtk_box_pack_start(GTK_BOX(main_area), sweep_frame, FALSE, FALSE, 0);
+
+    // Core-to-Core Latency Matrix
+    GtkWidget *c2c_frame = gtk_frame_new("Latência entre Núcleos");
+    app->c2c_drawing = gtk_drawing_area_new();
+    gtk_widget_set_size_request(app->c2c_drawing, -1, 320);
+    gtk_container_add(GTK_CONTAINER(c2c_frame), app->c2c_drawing);
+    gtk_box_pack_start(GTK_BOX(main_area), c2c_frame, FALSE, FALSE, 0);
+
     // System Log
     GtkWidget *log_frame = gtk_frame_new("Log de Sistema");
     GtkWidget *log_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 6);
@@ -732,6 +1141,10 @@ GtkWidget* create_main_window(AppContext *app) {
     g_signal_connect(app->btn_clear_log, "clicked", G_CALLBACK(on_btn_clear_log_clicked), app);
     g_signal_connect(app->cpu_drawing, "draw", G_CALLBACK(on_draw_system_graph), app);
     g_signal_connect(app->iters_drawing, "draw", G_CALLBACK(on_draw_iters), app);
+    g_signal_connect(app->sweep_drawing, "draw", G_CALLBACK(on_draw_sweep), app);
+    g_signal_connect(app->c2c_drawing, "draw", G_CALLBACK(on_draw_c2c), app);
+    g_signal_connect(app->combo_heat_metric, "changed", G_CALLBACK(on_heat_metric_changed), app);
+    g_signal_connect(app->combo_heat_span, "changed", G_CALLBACK(on_heat_span_changed), app);
 
     // Timer to update the status label
     app->status_tick_id = g_timeout_add(1000, ui_tick, app);
@@ -750,11 +1163,27 @@ GtkWidget* create_main_window(AppContext *app) {
 static void set_controls_sensitive(AppContext *app, gboolean state){
     gtk_widget_set_sensitive(app->entry_threads, state);
     gtk_widget_set_sensitive(app->entry_dur, state);
+    gtk_widget_set_sensitive(app->combo_interval, state);
     gtk_widget_set_sensitive(app->check_pin, state);
+    gtk_widget_set_sensitive(app->combo_affinity, state);
+    gtk_widget_set_sensitive(app->combo_numa, state);
+    gtk_widget_set_sensitive(app->combo_pages, state);
+    gtk_widget_set_sensitive(app->combo_fp_block, state);
+    gtk_widget_set_sensitive(app->combo_ptr_chains, state);
+    gtk_widget_set_sensitive(app->entry_io_path, state);
+    gtk_widget_set_sensitive(app->combo_io_mix, state);
+    gtk_widget_set_sensitive(app->entry_fleet, state);
+    gtk_widget_set_sensitive(app->check_stream_nt, state && stream_nt_supported());
+    gtk_widget_set_sensitive(app->check_verify, state);
+    gtk_widget_set_sensitive(app->check_perf, state);
+    gtk_widget_set_sensitive(app->check_sweep, state);
+    gtk_widget_set_sensitive(app->check_c2c, state);
+    gtk_widget_set_sensitive(app->check_jitter, state);
     gtk_widget_set_sensitive(app->check_fpu, state);
     gtk_widget_set_sensitive(app->check_int, state);
     gtk_widget_set_sensitive(app->check_stream, state);
     gtk_widget_set_sensitive(app->check_ptr, state);
+    gtk_widget_set_sensitive(app->check_atomic, state);
     gtk_widget_set_sensitive(app->btn_start, state);
 }
 
@@ -792,8 +1221,20 @@ static gboolean on_draw_system_graph(GtkWidget *widget, cairo_t *cr, gpointer us
         return FALSE;
     }
 
+    // Cópia local do jitter por CPU: o amostrador a atualiza a cada intervalo.
+    jitter_result_t *jitter = NULL;
+    g_mutex_lock(&app->history_mutex);
+    if (app->jitter_live && app->jitter_live->n > 0) {
+        size_t bytes = sizeof(*jitter) + (size_t)app->jitter_live->n * sizeof(jitter_stats_t);
+        jitter = malloc(bytes);
+        if (jitter) memcpy(jitter, app->jitter_live, bytes);
+    }
+    g_mutex_unlock(&app->history_mutex);
+    // O painel do jitter ocupa a direita do gráfico quando há espaço para ele.
+    const double jitter_w = (jitter && w >= 640) ? 250.0 : 0.0;
+
     // --- Configuração do Gráfico ---
-    const double margin_top = 30.0, margin_bottom = 20.0, margin_left = 50.0, margin_right = 50.0;
+    const double margin_top = 30.0, margin_bottom = 20.0, margin_left = 50.0, margin_right = 50.0 + jitter_w;
     const double chart_w = w - margin_left - margin_right;
     const double chart_h = h - margin_top - margin_bottom;
     const int num_x_labels = 6; // Rótulos no eixo X
@@ -805,21 +1246,41 @@ static gboolean on_draw_system_graph(GtkWidget *widget, cairo_t *cr, gpointer us
     int len = app->system_history_filled;
     double *temp_data = malloc(len * sizeof(double));
     double *cpu_data = malloc(len * sizeof(double));
-    if (!temp_data || !cpu_data) {
-        if(temp_data) free(temp_data);
-        if(cpu_data) free(cpu_data);
+    double *freq_data = malloc(len * sizeof(double));
+    int *throttle_data = malloc(len * sizeof(int)); // bit 0 = térmico, bit 1 = potência
+    double *io_data = malloc(len * sizeof(double));
+    if (!temp_data || !cpu_data || !freq_data || !throttle_data || !io_data) {
+        free(temp_data);
+        free(cpu_data);
+        free(freq_data);
+        free(throttle_data);
+        free(io_data);
+        free(jitter);
         g_mutex_unlock(&app->system_history_mutex);
         return FALSE; // Falha na alocação de memória
     }
 
     int start_pos = (app->system_history_pos + 1) % app->system_history_len;
+    double freq_seen = 0.0, io_max = 0.0;
     for (int i = 0; i < len; i++) {
         int idx = (start_pos + i) % app->system_history_len;
         temp_data[i] = app->temp_history[idx];
         cpu_data[i] = app->avg_cpu_history[idx];
+        freq_data[i] = app->avg_freq_history[idx];
+        throttle_data[i] = (app->throttle_thermal_history[idx] > 0 ? 1 : 0) |
+                           (app->throttle_power_history[idx] > 0 ? 2 : 0);
+        if (freq_data[i] > freq_seen) freq_seen = freq_data[i];
+        io_data[i] = app->io_mbps_history[idx];
+        if (io_data[i] > io_max) io_max = io_data[i];
     }
     g_mutex_unlock(&app->system_history_mutex);
 
+    // A frequência é desenhada como fração do máximo, no mesmo eixo percentual da CPU.
+    g_mutex_lock(&app->cpu_mutex);
+    double freq_max = app->freq_max_mhz;
+    g_mutex_unlock(&app->cpu_mutex);
+    if (freq_max < freq_seen) freq_max = freq_seen;
+
     // Encontra os valores mínimo e máximo para a temperatura para escalar o eixo Y esquerdo
     double temp_min = 120.0, temp_max = 0.0;
     for (int i = 0; i < len; i++) {
@@ -874,6 +1335,17 @@ static gboolean on_draw_system_graph(GtkWidget *widget, cairo_t *cr, gpointer us
         cairo_show_text(cr, label);
     }
 
+    // --- Faixas de Limitação (térmica em vermelho, potência em âmbar) ---
+    const double step_w = chart_w / (app->system_history_len - 1);
+    for (int i = 0; i < len; i++) {
+        if (!throttle_data[i]) continue;
+        double x = margin_left + chart_w * (double)i / (app->system_history_len - 1);
+        if (throttle_data[i] & 1) cairo_set_source_rgba(cr, 1.0, 0.2, 0.2, 0.18);
+        else cairo_set_source_rgba(cr, 1.0, 0.7, 0.1, 0.18);
+        cairo_rectangle(cr, x - step_w / 2.0, margin_top, step_w, chart_h);
+        cairo_fill(cr);
+    }
+
     // --- Desenho das Linhas do Gráfico ---
     cairo_set_line_width(cr, 2.0);
     cairo_set_line_join(cr, CAIRO_LINE_JOIN_ROUND);
@@ -898,6 +1370,33 @@ static gboolean on_draw_system_graph(GtkWidget *widget, cairo_t *cr, gpointer us
     }
     cairo_stroke(cr);
 
+    // Linha de Frequência Média (Verde), como fração de freq_max; amostras sem leitura interrompem a linha
+    if (freq_max > 0.0) {
+        cairo_set_source_rgba(cr, 0.2, 0.8, 0.3, 0.9);
+        gboolean drawing = FALSE;
+        for (int i = 0; i < len; i++) {
+            if (freq_data[i] <= 0.0) { drawing = FALSE; continue; }
+            double x = margin_left + chart_w * (double)i / (app->system_history_len - 1);
+            double y = margin_top + chart_h * (1.0 - freq_data[i] / freq_max);
+            if (!drawing) cairo_move_to(cr, x, y);
+            else cairo_line_to(cr, x, y);
+            drawing = TRUE;
+        }
+        cairo_stroke(cr);
+    }
+
+    // Linha de Vazão do Disco (Ciano), como fração do maior MB/s da janela
+    if (io_max > 0.0) {
+        cairo_set_source_rgba(cr, 0.2, 0.8, 0.9, 0.9);
+        for (int i = 0; i < len; i++) {
+            double x = margin_left + chart_w * (double)i / (app->system_history_len - 1);
+            double y = margin_top + chart_h * (1.0 - io_data[i] / io_max);
+            if (i == 0) cairo_move_to(cr, x, y);
+            else cairo_line_to(cr, x, y);
+        }
+        cairo_stroke(cr);
+    }
+
     // --- Título e Legenda ---
     cairo_select_font_face(cr, "Inter", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
     cairo_set_font_size(cr, 14);
@@ -905,13 +1404,225 @@ static gboolean on_draw_system_graph(GtkWidget *widget, cairo_t *cr, gpointer us
     cairo_move_to(cr, margin_left, margin_top - 10);
     cairo_show_text(cr, "Monitor do Sistema");
 
+    char freq_legend[48];
+    if (freq_max > 0.0) snprintf(freq_legend, sizeof(freq_legend), "Freq. (%% de %.0f MHz)", freq_max);
+    else snprintf(freq_legend, sizeof(freq_legend), "Freq. n/d");
+    char io_legend[48];
+    snprintf(io_legend, sizeof(io_legend), "Disco (%% de %.0f MB/s)", io_max);
+    const struct { const char *text; double r, g, b; } legend[] = {
+        { "Temp",              1.0, 0.2, 0.2 },
+        { "CPU",               0.2, 0.2, 1.0 },
+        { freq_legend,         0.2, 0.8, 0.3 },
+        { "Lim. térmico",      1.0, 0.4, 0.4 },
+        { "Lim. potência",     1.0, 0.7, 0.1 },
+        { io_legend,           0.2, 0.8, 0.9 },
+    };
+    // A entrada do disco só aparece com o motor de E/S ativo.
+    int legend_count = (int)(sizeof(legend) / sizeof(legend[0])) - (io_max > 0.0 ? 0 : 1);
+    cairo_select_font_face(cr, "Inter", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 11);
+    double lx = margin_left + chart_w;
+    for (int i = legend_count - 1; i >= 0; i--) {
+        cairo_text_extents_t ext;
+        cairo_text_extents(cr, legend[i].text, &ext);
+        lx -= ext.x_advance;
+        cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.9);
+        cairo_move_to(cr, lx, margin_top - 10);
+        cairo_show_text(cr, legend[i].text);
+        lx -= 14.0;
+        cairo_set_source_rgba(cr, legend[i].r, legend[i].g, legend[i].b, 0.9);
+        cairo_rectangle(cr, lx, margin_top - 18, 9, 9);
+        cairo_fill(cr);
+        lx -= 12.0;
+    }
+
+    if (jitter_w > 0.0) draw_jitter_panel(cr, jitter, w - jitter_w, margin_top - 22.0, jitter_w - 8.0, chart_h + 22.0);
+
     // Libera a memória alocada para os dados do gráfico
     free(temp_data);
     free(cpu_data);
+    free(freq_data);
+    free(throttle_data);
+    free(io_data);
+    free(jitter);
 
     return FALSE;
 }
 
+/**
+ * @brief Desenha as células do heatmap ampliadas para o retângulo dado, com a grade.
+ *
+ * As colunas da imagem seguem o buffer circular; `oldest` é a coluna exibida à esquerda.
+ */
+static void draw_heat_cells(cairo_t *cr, const heatmap_t *heat, double x, double y, double w, double h, int cols, int oldest){
+    const int rows = heat->threads;
+    const double cell_w = w / cols;
+    const double cell_h = h / rows;
+    cairo_save(cr);
+    cairo_rectangle(cr, x, y, w, h);
+    cairo_clip(cr);
+    cairo_set_source_rgba(cr, THEME_BG_TERTIARY.r, THEME_BG_TERTIARY.g, THEME_BG_TERTIARY.b, 0.8);
+    cairo_paint(cr);
+
+    // Pixel columns follow the ring buffer; two blits put the oldest sample on the left.
+    cairo_surface_t *img = cairo_image_surface_create_for_data((unsigned char*)heat->pixels, CAIRO_FORMAT_RGB24,
+                                                               heat->len, rows, heat->len * (int)sizeof(uint32_t));
+    cairo_translate(cr, x, y);
+    cairo_scale(cr, cell_w, cell_h);
+    cairo_set_source_surface(cr, img, -oldest, 0);
+    cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
+    cairo_rectangle(cr, 0, 0, cols - oldest, rows);
+    cairo_fill(cr);
+    if (oldest > 0) {
+        cairo_set_source_surface(cr, img, cols - oldest, 0);
+        cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
+        cairo_rectangle(cr, cols - oldest, 0, oldest, rows);
+        cairo_fill(cr);
+    }
+    cairo_surface_destroy(img);
+    cairo_restore(cr);
+
+    // Grid lines only while cells are wide enough to tell apart.
+    cairo_save(cr);
+    cairo_set_source_rgba(cr, THEME_GRID.r, THEME_GRID.g, THEME_GRID.b, 0.4);
+    cairo_set_line_width(cr, 0.5);
+    if (cell_h >= 4.0) {
+        for (int t = 0; t <= rows; t++) {
+            double ly = y + t * cell_h;
+            cairo_move_to(cr, x, ly + 0.5);
+            cairo_line_to(cr, x + w, ly + 0.5);
+        }
+    }
+    if (cell_w >= 4.0) {
+        for (int c = 0; c <= cols; c++) {
+            double lx = x + c * cell_w;
+            cairo_move_to(cr, lx + 0.5, y);
+            cairo_line_to(cr, lx + 0.5, y + h);
+        }
+    }
+    cairo_stroke(cr);
+    cairo_restore(cr);
+}
+
+/**
+ * @brief Desenha a barra de cores do heatmap com os extremos da escala.
+ */
+static void draw_heat_legend(cairo_t *cr, double x, double y, double h, const heatmap_t *heat, const char *unit){
+    const double legend_w = 20.0;
+    for (int i = 0; i < (int)h; i++) {
+        double ratio = 1.0 - ((double)i / h);
+        double rgb[3];
+        heatmap_color(ratio, rgb);
+        cairo_set_source_rgba(cr, rgb[0], rgb[1], rgb[2], 1.0);
+        cairo_rectangle(cr, x, y + i, legend_w, 1.0);
+        cairo_fill(cr);
+    }
+    cairo_rectangle(cr, x, y, legend_w, h);
+    cairo_set_source_rgba(cr, THEME_GRID.r, THEME_GRID.g, THEME_GRID.b, 1.0);
+    cairo_stroke(cr);
+
+    cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 1.0);
+    cairo_set_font_size(cr, 11);
+    char max_label[64];
+    char min_label[64];
+    snprintf(max_label, sizeof(max_label), "%.1f %s", heat->hi, unit);
+    snprintf(min_label, sizeof(min_label), "%.1f %s", heat->lo, unit);
+    cairo_move_to(cr, x + legend_w + 8, y + 10);
+    cairo_show_text(cr, max_label);
+    cairo_move_to(cr, x + legend_w + 8, y + h);
+    cairo_show_text(cr, min_label);
+}
+
+/**
+ * @brief Desenha o heatmap da frota: uma linha por nó, com as amostras recentes de cada um.
+ *
+ * Os nomes e estados dos nós são copiados sob `history_mutex`, pois a thread
+ * coordenadora os atualiza enquanto as amostras chegam.
+ */
+static gboolean draw_fleet_heatmap(GtkWidget *widget, cairo_t *cr, AppContext *app){
+    GtkAllocation alloc;
+    gtk_widget_get_allocation(widget, &alloc);
+    const double W = alloc.width;
+    const double H = alloc.height;
+    const fleet_t *f = app->fleet;
+    const int nodes = f->n;
+    const int metric = app->heat_metric;
+
+    cairo_set_antialias(cr, CAIRO_ANTIALIAS_DEFAULT);
+    cairo_set_source_rgba(cr, THEME_BG_SECONDARY.r, THEME_BG_SECONDARY.g, THEME_BG_SECONDARY.b, THEME_BG_SECONDARY.a);
+    draw_rounded_rect(cr, 0, 0, W, H, 8.0);
+    cairo_fill(cr);
+
+    const double margin_left = 170.0;
+    const double margin_right = 120.0;
+    const double margin_top = 24.0;
+    const double margin_bottom = 36.0;
+    const double heat_w = fmax(1.0, W - margin_left - margin_right);
+    const double heat_h = fmax(1.0, H - margin_top - margin_bottom);
+    const double cell_h = heat_h / nodes;
+    const int label_step = cell_h >= 14.0 ? 1 : (int)ceil(14.0 / cell_h);
+
+    char (*labels)[96] = calloc((size_t)nodes, sizeof(*labels));
+    int *failed = calloc((size_t)nodes, sizeof(int));
+    double span = 0.0;
+    g_mutex_lock(&app->history_mutex);
+    if (app->heatmap_fleet && app->heatmap_fleet->threads != nodes) {
+        heatmap_free(app->heatmap_fleet);
+        app->heatmap_fleet = NULL;
+    }
+    if (!app->heatmap_fleet) app->heatmap_fleet = heatmap_create(nodes, HISTORY_SAMPLES);
+    heatmap_t *heat = app->heatmap_fleet;
+    if (heat) heatmap_update_fleet(heat, f, metric);
+    const int oldest = (int)((f->max_seq + 1) % HISTORY_SAMPLES);
+    for (int i = 0; labels && failed && i < nodes; i += label_step) {
+        const fleet_node_t *node = &f->nodes[i];
+        const char *state = node->state == FLEET_NODE_FAILED ? "falhou"
+                          : node->state == FLEET_NODE_CONNECTING || node->state == FLEET_NODE_READY ? "aguardando"
+                          : NULL;
+        failed[i] = node->state == FLEET_NODE_FAILED;
+        if (state) snprintf(labels[i], sizeof(labels[i]), "%.24s  %s", node->name, state);
+        else if (node->last.temp_c > TEMP_UNAVAILABLE) snprintf(labels[i], sizeof(labels[i]), "%.24s  %.0f°C", node->name, node->last.temp_c);
+        else snprintf(labels[i], sizeof(labels[i]), "%.24s", node->name);
+        if (node->last.elapsed > span) span = node->last.elapsed;
+    }
+    g_mutex_unlock(&app->history_mutex);
+    if (!heat || !labels || !failed) {
+        free(labels);
+        free(failed);
+        return FALSE;
+    }
+
+    draw_heat_cells(cr, heat, margin_left, margin_top, heat_w, heat_h, HISTORY_SAMPLES, oldest);
+
+    cairo_select_font_face(cr, "Inter", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 12);
+    for (int i = 0; i < nodes; i += label_step) {
+        const rgba_t *c = failed[i] ? &THEME_ERROR : &THEME_TEXT_PRIMARY;
+        cairo_set_source_rgba(cr, c->r, c->g, c->b, 1.0);
+        cairo_move_to(cr, 12, margin_top + (i + 0.5) * cell_h + 4);
+        cairo_show_text(cr, labels[i]);
+    }
+    free(labels);
+    free(failed);
+
+    cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.9);
+    cairo_set_font_size(cr, 11);
+    char time_label[96];
+    snprintf(time_label, sizeof(time_label), "Últimas %d amostras de cada nó (%.0f s de teste)", HISTORY_SAMPLES, span);
+    cairo_move_to(cr, margin_left, H - 12);
+    cairo_show_text(cr, time_label);
+
+    cairo_set_font_size(cr, 13);
+    cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 1.0);
+    cairo_move_to(cr, margin_left, margin_top - 6);
+    char title[96];
+    snprintf(title, sizeof(title), "%s por nó (mais recente à direita)", HEAT_METRICS[metric].label);
+    cairo_show_text(cr, title);
+
+    draw_heat_legend(cr, margin_left + heat_w + 20.0, margin_top, heat_h, heat, HEAT_METRICS[metric].unit);
+    return FALSE;
+}
+
 /**
  * @brief Manipulador de desenho do Cairo para o gráfico de desempenho por thread.
  *
@@ -921,6 +1632,7 @@ static gboolean on_draw_system_graph(GtkWidget *widget, cairo_t *cr, gpointer us
  */
 static gboolean on_draw_iters(GtkWidget *widget, cairo_t *cr, gpointer user_data){
     AppContext *app = (AppContext*)user_data;
+    if (app && app->fleet) return draw_fleet_heatmap(widget, cr, app);
     if (!app || !app->workers) return FALSE;
 
     GtkAllocation alloc;
@@ -947,89 +1659,53 @@ static gboolean on_draw_iters(GtkWidget *widget, cairo_t *cr, gpointer user_data
     }
 
     const double margin_left = 70.0;
-    const double margin_right = 90.0;
+    const double margin_right = 120.0;
     const double margin_top = 24.0;
     const double margin_bottom = 36.0;
 
     const double heat_w = fmax(1.0, W - margin_left - margin_right);
     const double heat_h = fmax(1.0, H - margin_top - margin_bottom);
-    const double cell_w = heat_w / app->history_len;
     const double cell_h = heat_h / app->threads;
 
-    const int samples = app->history_len;
     const int threads = app->threads;
-    const double sample_interval_sec = (double)CPU_SAMPLE_INTERVAL_MS / 1000.0;
-
-    double *values = calloc((size_t)threads * samples, sizeof(double));
-    gboolean *thread_active = calloc(threads, sizeof(gboolean));
-    double min_val = DBL_MAX;
-    double max_val = 0.0;
-
+    const int interval_ms = app->sample_interval_ms > 0 ? app->sample_interval_ms : CPU_SAMPLE_INTERVAL_MS;
+    const int metric = app->heat_metric < THREAD_METRIC_COUNT ? app->heat_metric : THREAD_METRIC_PROGRESS;
+    const int whole_run = app->heat_span == 1;
+
+    // The heatmap image is kept across frames: only the columns of new samples are
+    // recomputed, so a redraw costs one scaled blit regardless of threads x history.
+    // The whole-run view is built from the archive buckets and changes only when one closes.
+    heatmap_t **slot = whole_run ? &app->heatmap_run : &app->heatmap;
+    const int samples = whole_run ? HISTORY_ARCHIVE_BUCKETS : app->history_len;
+    int cols = samples, oldest = 0, bucket_width = 1;
+    double time_span = ((double)samples * interval_ms) / 1000.0;
     g_mutex_lock(&app->history_mutex);
-    int start_idx = (app->history_pos + 1) % samples;
-    for (int t = 0; t < threads; t++) {
-        for (int s = 0; s < samples; s++) {
-            int idx = (start_idx + s) % samples;
-            int prev_idx = (idx + samples - 1) % samples;
-            unsigned current_v = app->thread_history[t][idx];
-            unsigned prev_v = app->thread_history[t][prev_idx];
-            unsigned diff = (current_v > prev_v) ? (current_v - prev_v) : 0;
-            double metric = diff / sample_interval_sec;
-            values[t * samples + s] = metric;
-            if (metric > 0.0) {
-                thread_active[t] = TRUE;
-                if (metric > max_val) max_val = metric;
-                if (metric < min_val) min_val = metric;
-            }
-        }
+    if (*slot && ((*slot)->threads != threads || (*slot)->len != samples)) {
+        heatmap_free(*slot);
+        *slot = NULL;
     }
-    g_mutex_unlock(&app->history_mutex);
-
-    if (min_val == DBL_MAX) {
-        min_val = 0.0;
-    }
-    if (max_val < min_val) {
-        max_val = min_val;
-    }
-    double range = (max_val > min_val) ? (max_val - min_val) : 1.0;
-
-    cairo_save(cr);
-    cairo_rectangle(cr, margin_left, margin_top, heat_w, heat_h);
-    cairo_clip(cr);
-    cairo_set_source_rgba(cr, THEME_BG_TERTIARY.r, THEME_BG_TERTIARY.g, THEME_BG_TERTIARY.b, 0.8);
-    cairo_paint(cr);
-
-    for (int t = 0; t < threads; t++) {
-        for (int s = 0; s < samples; s++) {
-            double value = values[t * samples + s];
-            double normalized = (value - min_val) / range;
-            rgba_t c = heatmap_color(normalized);
-            cairo_set_source_rgba(cr, c.r, c.g, c.b, c.a);
-            double x = margin_left + s * cell_w;
-            double y = margin_top + t * cell_h;
-            cairo_rectangle(cr, x, y, ceil(cell_w) + 1, ceil(cell_h) + 1);
-            cairo_fill(cr);
-        }
+    if (!*slot) *slot = heatmap_create(threads, samples);
+    heatmap_t *heat = *slot;
+    if (whole_run && app->history_archive) {
+        const history_archive_t *arch = app->history_archive;
+        heatmap_update_archive(heat, arch, metric, HEAT_METRICS[metric].scale);
+        cols = arch->count > 0 ? arch->count : 1;
+        bucket_width = arch->width;
+        time_span = arch->count > 0 ? arch->end_time[arch->count - 1] - arch->start_time : 0.0;
+    } else if (!whole_run) {
+        heatmap_update(heat, app, metric, HEAT_METRICS[metric].scale);
+        oldest = (app->history_pos + 1) % samples;
     }
+    g_mutex_unlock(&app->history_mutex);
+    if (!heat) return FALSE;
 
-    cairo_set_source_rgba(cr, THEME_GRID.r, THEME_GRID.g, THEME_GRID.b, 0.4);
-    cairo_set_line_width(cr, 0.5);
-    for (int t = 0; t <= threads; t++) {
-        double y = margin_top + t * cell_h;
-        cairo_move_to(cr, margin_left, y + 0.5);
-        cairo_line_to(cr, margin_left + heat_w, y + 0.5);
-    }
-    for (int s = 0; s <= samples; s++) {
-        double x = margin_left + s * cell_w;
-        cairo_move_to(cr, x + 0.5, margin_top);
-        cairo_line_to(cr, x + 0.5, margin_top + heat_h);
-    }
-    cairo_stroke(cr);
-    cairo_restore(cr);
+    draw_heat_cells(cr, heat, margin_left, margin_top, heat_w, heat_h, cols, oldest);
 
     cairo_select_font_face(cr, "Inter", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
     cairo_set_font_size(cr, 12);
-    for (int t = 0; t < threads; t++) {
+    // With many threads, label every label_step-th row so the text stays legible.
+    int label_step = cell_h >= 14.0 ? 1 : (int)ceil(14.0 / cell_h);
+    for (int t = 0; t < threads; t += label_step) {
         double text_y = margin_top + (t + 0.5) * cell_h + 4;
         cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 1.0);
         char label[32];
@@ -1042,7 +1718,7 @@ static gboolean on_draw_iters(GtkWidget *widget, cairo_t *cr, gpointer user_data
             cairo_set_source_rgba(cr, THEME_ERROR.r, THEME_ERROR.g, THEME_ERROR.b, 0.9);
             cairo_move_to(cr, 35, text_y);
             cairo_show_text(cr, "erro");
-        } else if (!thread_active[t]) {
+        } else if (heat->active[t] == 0) {
             cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.8);
             cairo_move_to(cr, 35, text_y);
             cairo_show_text(cr, "ocioso");
@@ -1051,9 +1727,11 @@ static gboolean on_draw_iters(GtkWidget *widget, cairo_t *cr, gpointer user_data
 
     cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.9);
     cairo_set_font_size(cr, 11);
-    double time_span = ((double)samples * CPU_SAMPLE_INTERVAL_MS) / 1000.0;
-    char time_label[64];
-    if (time_span >= 10.0) snprintf(time_label, sizeof(time_label), "Janela de %.0f s", time_span);
+    char time_label[96];
+    if (whole_run) {
+        snprintf(time_label, sizeof(time_label), "Teste inteiro: %.0f s (média de %d amostra(s) por coluna)",
+                 time_span, bucket_width);
+    } else if (time_span >= 10.0) snprintf(time_label, sizeof(time_label), "Janela de %.0f s", time_span);
     else snprintf(time_label, sizeof(time_label), "Janela de %.1f s", time_span);
     cairo_move_to(cr, margin_left, H - 12);
     cairo_show_text(cr, time_label);
@@ -1061,35 +1739,295 @@ static gboolean on_draw_iters(GtkWidget *widget, cairo_t *cr, gpointer user_data
     cairo_set_font_size(cr, 13);
     cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 1.0);
     cairo_move_to(cr, margin_left, margin_top - 6);
-    cairo_show_text(cr, "Histórico (mais recente à direita)");
+    char title[96];
+    snprintf(title, sizeof(title), "%s por thread (mais recente à direita)", HEAT_METRICS[metric].label);
+    cairo_show_text(cr, title);
+
+    draw_heat_legend(cr, margin_left + heat_w + 20.0, margin_top, heat_h, heat, HEAT_METRICS[metric].unit);
+    return FALSE;
+}
+
+/**
+ * @brief Manipulador de desenho do Cairo para a curva da varredura de caches.
+ *
+ * O eixo X é o conjunto de trabalho em escala logarítmica; a latência por carga
+ * usa o eixo esquerdo (logarítmico) e a banda do Triad o direito (linear). Linhas
+ * tracejadas marcam o tamanho de cada cache informado pelo SO, onde os degraus
+ * da curva são esperados.
+ */
+static gboolean on_draw_sweep(GtkWidget *widget, cairo_t *cr, gpointer user_data){
+    AppContext *app = (AppContext*)user_data;
+    GtkAllocation alloc;
+    gtk_widget_get_allocation(widget, &alloc);
+    const double W = alloc.width;
+    const double H = alloc.height;
+
+    cairo_set_antialias(cr, CAIRO_ANTIALIAS_DEFAULT);
+    cairo_set_source_rgba(cr, THEME_BG_SECONDARY.r, THEME_BG_SECONDARY.g, THEME_BG_SECONDARY.b, THEME_BG_SECONDARY.a);
+    draw_rounded_rect(cr, 0, 0, W, H, 8.0);
+    cairo_fill(cr);
+    cairo_select_font_face(cr, "Inter", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+
+    // Cópia local: a controladora acrescenta pontos enquanto a varredura avança.
+    sweep_result_t r;
+    g_mutex_lock(&app->history_mutex);
+    if (app->sweep) r = *app->sweep;
+    else r.count = 0;
+    g_mutex_unlock(&app->history_mutex);
+
+    if (r.count == 0) {
+        cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.8);
+        cairo_set_font_size(cr, 14);
+        cairo_text_extents_t ext;
+        const char *msg = "Marque \"Varredura de caches\" e inicie para medir a curva...";
+        cairo_text_extents(cr, msg, &ext);
+        cairo_move_to(cr, (W - ext.width) / 2.0, (H + ext.height) / 2.0);
+        cairo_show_text(cr, msg);
+        return FALSE;
+    }
+
+    const double margin_left = 60.0, margin_right = 60.0, margin_top = 30.0, margin_bottom = 30.0;
+    const double chart_w = fmax(1.0, W - margin_left - margin_right);
+    const double chart_h = fmax(1.0, H - margin_top - margin_bottom);
+
+    double x_min = log2((double)SWEEP_MIN_BYTES);
+    double x_max = fmax(x_min + 1.0, log2((double)r.points[r.count - 1].bytes));
+    double lat_min = 1e300, lat_max = 0.0, bw_max = 0.0;
+    for (int i = 0; i < r.count; i++) {
+        if (r.points[i].ns_per_load > 0.0) {
+            lat_min = fmin(lat_min, r.points[i].ns_per_load);
+            lat_max = fmax(lat_max, r.points[i].ns_per_load);
+        }
+        bw_max = fmax(bw_max, r.points[i].gbps);
+    }
+    if (lat_max <= 0.0) lat_min = lat_max = 1.0;
+    double y_lo = floor(log10(lat_min)), y_hi = ceil(log10(lat_max));
+    if (y_hi <= y_lo) y_hi = y_lo + 1.0;
+    bw_max = bw_max > 0.0 ? bw_max * 1.1 : 1.0;
+
+#define SWEEP_X(bytes) (margin_left + (log2((double)(bytes)) - x_min) / (x_max - x_min) * chart_w)
+#define SWEEP_Y_LAT(ns) (margin_top + chart_h - (log10(ns) - y_lo) / (y_hi - y_lo) * chart_h)
+#define SWEEP_Y_BW(gbps) (margin_top + chart_h - (gbps) / bw_max * chart_h)
+
+    // Grade e rótulos: uma década de latência por linha, um tamanho a cada fator 4.
+    char label[48];
+    cairo_set_font_size(cr, 11);
+    cairo_set_line_width(cr, 0.5);
+    for (double d = y_lo; d <= y_hi + 1e-9; d += 1.0) {
+        double y = SWEEP_Y_LAT(pow(10.0, d));
+        cairo_set_source_rgba(cr, THEME_GRID.r, THEME_GRID.g, THEME_GRID.b, THEME_GRID.a);
+        cairo_move_to(cr, margin_left, y);
+        cairo_line_to(cr, margin_left + chart_w, y);
+        cairo_stroke(cr);
+        cairo_set_source_rgba(cr, THEME_ACCENT.r, THEME_ACCENT.g, THEME_ACCENT.b, 0.9);
+        snprintf(label, sizeof(label), "%g ns", pow(10.0, d));
+        cairo_move_to(cr, 8, y + 4);
+        cairo_show_text(cr, label);
+    }
+    for (int k = 0; k <= 4; k++) {
+        double v = bw_max * k / 4.0;
+        cairo_set_source_rgba(cr, THEME_WARN.r, THEME_WARN.g, THEME_WARN.b, 0.9);
+        snprintf(label, sizeof(label), "%.0f GB/s", v);
+        cairo_move_to(cr, margin_left + chart_w + 6, SWEEP_Y_BW(v) + 4);
+        cairo_show_text(cr, label);
+    }
+    for (size_t b = SWEEP_MIN_BYTES; log2((double)b) <= x_max + 1e-9; b *= 4) {
+        double x = SWEEP_X(b);
+        cairo_set_source_rgba(cr, THEME_GRID.r, THEME_GRID.g, THEME_GRID.b, THEME_GRID.a);
+        cairo_move_to(cr, x, margin_top);
+        cairo_line_to(cr, x, margin_top + chart_h);
+        cairo_stroke(cr);
+        cairo_text_extents_t ext;
+        format_page_size(b, label, sizeof(label));
+        cairo_text_extents(cr, label, &ext);
+        cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.9);
+        cairo_move_to(cr, x - ext.width / 2.0, H - 10);
+        cairo_show_text(cr, label);
+    }
 
-    double legend_x = margin_left + heat_w + 20.0;
-    double legend_y = margin_top;
+    // Tamanhos dos caches: os degraus esperados da curva.
+    const double dash[] = { 4.0, 4.0 };
+    for (int c = 0; c < r.cache_count; c++) {
+        if (log2((double)r.caches[c].bytes) > x_max) continue;
+        double x = SWEEP_X(r.caches[c].bytes);
+        cairo_save(cr);
+        cairo_set_dash(cr, dash, 2, 0);
+        cairo_set_line_width(cr, 1.0);
+        cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 0.5);
+        cairo_move_to(cr, x, margin_top);
+        cairo_line_to(cr, x, margin_top + chart_h);
+        cairo_stroke(cr);
+        cairo_restore(cr);
+        char size[32];
+        format_page_size(r.caches[c].bytes, size, sizeof(size));
+        snprintf(label, sizeof(label), "L%d %s", r.caches[c].level, size);
+        cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 0.9);
+        cairo_move_to(cr, x + 4, margin_top + 12 + 14 * c);
+        cairo_show_text(cr, label);
+    }
+
+    // As duas curvas, com um marcador em cada ponto medido.
+    cairo_set_line_width(cr, 2.0);
+    const rgba_t *colors[2] = { &THEME_ACCENT, &THEME_WARN };
+    for (int s = 0; s < 2; s++) {
+        cairo_set_source_rgba(cr, colors[s]->r, colors[s]->g, colors[s]->b, 1.0);
+        for (int i = 0; i < r.count; i++) {
+            const sweep_point_t *p = &r.points[i];
+            double y = s == 0 ? SWEEP_Y_LAT(p->ns_per_load > 0.0 ? p->ns_per_load : lat_min) : SWEEP_Y_BW(p->gbps);
+            if (i == 0) cairo_move_to(cr, SWEEP_X(p->bytes), y);
+            else cairo_line_to(cr, SWEEP_X(p->bytes), y);
+        }
+        cairo_stroke(cr);
+        for (int i = 0; i < r.count; i++) {
+            const sweep_point_t *p = &r.points[i];
+            double y = s == 0 ? SWEEP_Y_LAT(p->ns_per_load > 0.0 ? p->ns_per_load : lat_min) : SWEEP_Y_BW(p->gbps);
+            cairo_arc(cr, SWEEP_X(p->bytes), y, 2.5, 0, 2 * M_PI);
+            cairo_fill(cr);
+        }
+    }
+#undef SWEEP_X
+#undef SWEEP_Y_LAT
+#undef SWEEP_Y_BW
+
+    cairo_set_font_size(cr, 13);
+    cairo_set_source_rgba(cr, THEME_ACCENT.r, THEME_ACCENT.g, THEME_ACCENT.b, 1.0);
+    cairo_move_to(cr, margin_left, margin_top - 10);
+    cairo_show_text(cr, "Latência por carga (ns, log)");
+    cairo_text_extents_t ext;
+    const char *bw_title = "Banda Triad (GB/s)";
+    cairo_text_extents(cr, bw_title, &ext);
+    cairo_set_source_rgba(cr, THEME_WARN.r, THEME_WARN.g, THEME_WARN.b, 1.0);
+    cairo_move_to(cr, margin_left + chart_w - ext.width, margin_top - 10);
+    cairo_show_text(cr, bw_title);
+    return FALSE;
+}
+
+/**
+ * @brief Manipulador de desenho do Cairo para a matriz de latência entre núcleos.
+ *
+ * Cada célula (i, j) é a ida e volta de uma linha de cache entre as CPUs da
+ * linha e da coluna, nas cores do heatmap de threads: cores quentes são os pares
+ * mais lentos. Linhas mais claras separam os sockets, onde a latência costuma
+ * saltar; células ainda não medidas ficam no fundo.
+ */
+static gboolean on_draw_c2c(GtkWidget *widget, cairo_t *cr, gpointer user_data){
+    AppContext *app = (AppContext*)user_data;
+    GtkAllocation alloc;
+    gtk_widget_get_allocation(widget, &alloc);
+    const double W = alloc.width;
+    const double H = alloc.height;
+
+    cairo_set_antialias(cr, CAIRO_ANTIALIAS_DEFAULT);
+    cairo_set_source_rgba(cr, THEME_BG_SECONDARY.r, THEME_BG_SECONDARY.g, THEME_BG_SECONDARY.b, THEME_BG_SECONDARY.a);
+    draw_rounded_rect(cr, 0, 0, W, H, 8.0);
+    cairo_fill(cr);
+    cairo_select_font_face(cr, "Inter", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+
+    // Cópia local: a controladora preenche os pares enquanto a medição avança.
+    c2c_result_t *r = NULL;
+    g_mutex_lock(&app->history_mutex);
+    if (app->c2c && app->c2c->done > 0) {
+        size_t bytes = sizeof(*r) + (size_t)app->c2c->n * app->c2c->n * sizeof(double);
+        r = malloc(bytes);
+        if (r) memcpy(r, app->c2c, bytes);
+    }
+    g_mutex_unlock(&app->history_mutex);
+
+    if (!r) {
+        cairo_set_source_rgba(cr, THEME_TEXT_SECONDARY.r, THEME_TEXT_SECONDARY.g, THEME_TEXT_SECONDARY.b, 0.8);
+        cairo_set_font_size(cr, 14);
+        cairo_text_extents_t ext;
+        const char *msg = "Marque \"Latência entre núcleos\" e inicie para medir a matriz...";
+        cairo_text_extents(cr, msg, &ext);
+        cairo_move_to(cr, (W - ext.width) / 2.0, (H + ext.height) / 2.0);
+        cairo_show_text(cr, msg);
+        return FALSE;
+    }
+
+    const int n = r->n;
+    c2c_stats_t st;
+    c2c_summarize(r, &st);
+    const double margin_left = 50.0, margin_right = 120.0, margin_top = 30.0, margin_bottom = 20.0;
+    const double side = fmax(1.0, fmin(W - margin_left - margin_right, H - margin_top - margin_bottom));
+    const double cell = side / n;
+    const double span = st.max > st.min ? st.max - st.min : 1.0;
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double ns = r->ns[i * n + j];
+            if (i == j || ns <= 0.0) {
+                cairo_set_source_rgba(cr, THEME_BG_TERTIARY.r, THEME_BG_TERTIARY.g, THEME_BG_TERTIARY.b, THEME_BG_TERTIARY.a);
+            } else {
+                double rgb[3];
+                heatmap_color((ns - st.min) / span, rgb);
+                cairo_set_source_rgba(cr, rgb[0], rgb[1], rgb[2], 1.0);
+            }
+            cairo_rectangle(cr, margin_left + j * cell, margin_top + i * cell, cell, cell);
+            cairo_fill(cr);
+        }
+    }
+
+    // Fronteiras de socket.
+    cairo_set_line_width(cr, 1.5);
+    cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 0.7);
+    for (int i = 1; i < n; i++) {
+        if (r->package[i] == r->package[i - 1]) continue;
+        cairo_move_to(cr, margin_left + i * cell, margin_top);
+        cairo_line_to(cr, margin_left + i * cell, margin_top + side);
+        cairo_move_to(cr, margin_left, margin_top + i * cell);
+        cairo_line_to(cr, margin_left + side, margin_top + i * cell);
+    }
+    cairo_stroke(cr);
+    cairo_set_line_width(cr, 1.0);
+    cairo_rectangle(cr, margin_left, margin_top, side, side);
+    cairo_set_source_rgba(cr, THEME_GRID.r, THEME_GRID.g, THEME_GRID.b, 1.0);
+    cairo_stroke(cr);
+
+    // With many CPUs, label every label_step-th row and column so the text stays legible.
+    char label[64];
+    cairo_set_font_size(cr, 11);
+    cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 1.0);
+    int label_step = cell >= 16.0 ? 1 : (int)ceil(16.0 / cell);
+    for (int i = 0; i < n; i += label_step) {
+        snprintf(label, sizeof(label), "%d", r->cpus[i]);
+        cairo_move_to(cr, 12, margin_top + (i + 0.5) * cell + 4);
+        cairo_show_text(cr, label);
+        cairo_text_extents_t ext;
+        cairo_text_extents(cr, label, &ext);
+        cairo_move_to(cr, margin_left + (i + 0.5) * cell - ext.width / 2.0, margin_top + side + 14);
+        cairo_show_text(cr, label);
+    }
+
+    cairo_set_font_size(cr, 13);
+    cairo_move_to(cr, margin_left, margin_top - 10);
+    snprintf(label, sizeof(label), "Ida e volta entre CPUs (%d de %d pares)", r->done, n * (n - 1) / 2);
+    cairo_show_text(cr, label);
+
+    double legend_x = margin_left + side + 20.0;
     double legend_w = 20.0;
-    double legend_h = heat_h;
-    for (int i = 0; i < (int)legend_h; i++) {
-        double ratio = 1.0 - ((double)i / legend_h);
-        rgba_t c = heatmap_color(ratio);
-        cairo_set_source_rgba(cr, c.r, c.g, c.b, c.a);
-        cairo_rectangle(cr, legend_x, legend_y + i, legend_w, 1.0);
+    for (int i = 0; i < (int)side; i++) {
+        double rgb[3];
+        heatmap_color(1.0 - (double)i / side, rgb);
+        cairo_set_source_rgba(cr, rgb[0], rgb[1], rgb[2], 1.0);
+        cairo_rectangle(cr, legend_x, margin_top + i, legend_w, 1.0);
         cairo_fill(cr);
     }
-    cairo_rectangle(cr, legend_x, legend_y, legend_w, legend_h);
+    cairo_rectangle(cr, legend_x, margin_top, legend_w, side);
     cairo_set_source_rgba(cr, THEME_GRID.r, THEME_GRID.g, THEME_GRID.b, 1.0);
     cairo_stroke(cr);
-
     cairo_set_source_rgba(cr, THEME_TEXT_PRIMARY.r, THEME_TEXT_PRIMARY.g, THEME_TEXT_PRIMARY.b, 1.0);
     cairo_set_font_size(cr, 11);
-    char max_label[64];
-    char min_label[64];
-    snprintf(max_label, sizeof(max_label), "%.0f it/s", max_val);
-    snprintf(min_label, sizeof(min_label), "%.0f it/s", min_val);
-    cairo_move_to(cr, legend_x + legend_w + 8, legend_y + 10);
-    cairo_show_text(cr, max_label);
-    cairo_move_to(cr, legend_x + legend_w + 8, legend_y + legend_h);
-    cairo_show_text(cr, min_label);
-
-    free(values);
-    free(thread_active);
+    snprintf(label, sizeof(label), "%.0f ns", st.max);
+    cairo_move_to(cr, legend_x + legend_w + 8, margin_top + 10);
+    cairo_show_text(cr, label);
+    snprintf(label, sizeof(label), "%.0f ns", st.min);
+    cairo_move_to(cr, legend_x + legend_w + 8, margin_top + side);
+    cairo_show_text(cr, label);
+    if (st.cross_socket > 0.0) {
+        snprintf(label, sizeof(label), "entre sockets %.0f ns", st.cross_socket);
+        cairo_move_to(cr, legend_x, margin_top + side + 14);
+        cairo_show_text(cr, label);
+    }
+    free(r);
     return FALSE;
 }
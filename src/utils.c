@@ -3,11 +3,17 @@
 
 #ifdef _WIN32
 #include <windows.h>
+#include <malloc.h>
 #else
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <sched.h>
 #endif
 
+/* --- Static Function Prototypes --- */
+static size_t rand_below(uint64_t *seed, size_t bound);
+
 /* --- Funções Utilitárias Independentes de Plataforma --- */
 
 /**
@@ -20,14 +26,12 @@
  */
 #ifdef _WIN32
 double now_sec(void){
-    FILETIME ft;
-    GetSystemTimeAsFileTime(&ft);
-    uint64_t ns100 = (((uint64_t)ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
-    // The timestamp is in 100-nanosecond intervals since January 1, 1601.
-    // To convert to seconds, we first subtract the epoch difference and then
-    // divide by 10^7.
-    // Epoch difference (1970-1601) in 100-nanosecond intervals: 116444736000000000
-    return ((double)(ns100 - 116444736000000000ULL)) / 10000000.0;
+    // QueryPerformanceCounter é monotônico; GetSystemTimeAsFileTime acompanha ajustes do relógio.
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
 }
 #else
 double now_sec(void){
@@ -36,6 +40,90 @@ double now_sec(void){
 }
 #endif
 
+/**
+ * @brief Inicia o temporizador periódico; o primeiro prazo é um período após a chamada.
+ */
+void ticker_start(ticker_t *t, double period_sec){
+    t->period = period_sec;
+    t->next = now_sec() + period_sec;
+#ifdef _WIN32
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+    t->timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!t->timer) t->timer = CreateWaitableTimerW(NULL, TRUE, NULL); // Windows anterior ao 10 1803
+#endif
+}
+
+/**
+ * @brief Dorme até o próximo prazo absoluto, descartando os prazos já perdidos.
+ * @return O número de prazos perdidos.
+ */
+int ticker_wait(ticker_t *t){
+    double now = now_sec();
+    if (t->next > now) {
+#ifdef _WIN32
+        // O prazo é absoluto em now_sec; o timer recebe o tempo restante até ele (unidades de 100 ns).
+        LARGE_INTEGER due;
+        due.QuadPart = -(LONGLONG)((t->next - now) * 1e7);
+        if (t->timer && SetWaitableTimer(t->timer, &due, 0, NULL, NULL, FALSE)) {
+            WaitForSingleObject(t->timer, INFINITE);
+        } else {
+            Sleep((DWORD)((t->next - now) * 1000.0));
+        }
+#else
+        struct timespec ts;
+        ts.tv_sec = (time_t)t->next;
+        ts.tv_nsec = (long)((t->next - (double)ts.tv_sec) * 1e9);
+        if (ts.tv_nsec >= 1000000000L) ts.tv_nsec = 999999999L;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+#endif
+    }
+    t->next += t->period;
+    now = now_sec();
+    if (now < t->next) return 0;
+    int missed = (int)((now - t->next) / t->period) + 1;
+    t->next += missed * t->period;
+    return missed;
+}
+
+/**
+ * @brief Libera o waitable timer (Windows); no POSIX não há recursos.
+ */
+void ticker_stop(ticker_t *t){
+#ifdef _WIN32
+    if (t->timer) CloseHandle(t->timer);
+    t->timer = NULL;
+#else
+    (void)t;
+#endif
+}
+
+/**
+ * @brief Dorme até um instante absoluto de `now_sec`.
+ */
+void sleep_until(double deadline){
+    double now = now_sec();
+    if (deadline <= now) return;
+#ifdef _WIN32
+    HANDLE timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    LARGE_INTEGER due;
+    due.QuadPart = -(LONGLONG)((deadline - now) * 1e7);
+    if (timer && SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE)) {
+        WaitForSingleObject(timer, INFINITE);
+    } else {
+        Sleep((DWORD)((deadline - now) * 1000.0));
+    }
+    if (timer) CloseHandle(timer);
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t)deadline;
+    ts.tv_nsec = (long)((deadline - (double)ts.tv_sec) * 1e9);
+    if (ts.tv_nsec >= 1000000000L) ts.tv_nsec = 999999999L;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+#endif
+}
+
 /**
  * @brief Um gerador de números pseudoaleatórios (PRNG) de 64 bits rápido e de alta qualidade.
  *
@@ -56,6 +144,32 @@ uint64_t splitmix64(uint64_t *x){
 
 #include <stdint.h>
 
+/**
+ * @brief Sorteia um inteiro uniforme em [0, bound) a partir do PRNG `splitmix64`.
+ *
+ * Até 2^32, usa a multiplicação de Lemire: os 32 bits altos do produto de um
+ * sorteio de 32 bits por `bound` já são o resultado, e só uma fração de
+ * `bound / 2^32` dos sorteios é rejeitada, sem nenhuma divisão no caso comum.
+ * Limites maiores usam rejeição com módulo.
+ */
+static size_t rand_below(uint64_t *seed, size_t bound){
+    if (bound <= UINT32_MAX) {
+        uint32_t range = (uint32_t)bound;
+        uint64_t m = (splitmix64(seed) >> 32) * (uint64_t)range;
+        if ((uint32_t)m < range) {
+            uint32_t threshold = (uint32_t)(-range) % range;
+            while ((uint32_t)m < threshold) m = (splitmix64(seed) >> 32) * (uint64_t)range;
+        }
+        return (size_t)(m >> 32);
+    }
+    uint64_t limit = UINT64_MAX - (UINT64_MAX % bound);
+    uint64_t r;
+    do {
+        r = splitmix64(seed);
+    } while (r >= limit);
+    return (size_t)(r % bound);
+}
+
 /**
  * @brief Embaralha um array de inteiros de 32 bits usando o algoritmo de Fisher-Yates.
  *
@@ -69,19 +183,35 @@ uint64_t splitmix64(uint64_t *x){
 void shuffle32(uint32_t *a, size_t n, uint64_t *seed){
     if (a == NULL || n <= 1) return;
     for (size_t i = n - 1; i > 0; --i){
-        // Use rejection sampling to avoid modulo bias.
-        // This ensures that the selection of j is uniformly distributed.
-        uint64_t limit = UINT64_MAX - (UINT64_MAX % (i + 1));
-        uint64_t r;
-        do {
-            r = splitmix64(seed);
-        } while (r >= limit);
-
-        size_t j = (size_t)(r % (i + 1));
+        // Unbiased draw of j in [0, i] (see rand_below).
+        size_t j = rand_below(seed, i + 1);
         uint32_t tmp = a[i]; a[i] = a[j]; a[j] = tmp;
     }
 }
 
+/**
+ * @brief Constrói um ciclo único aleatório com o algoritmo de Sattolo.
+ *
+ * Preenche `a[k * stride]`, para `k < n`, com deslocamentos do conjunto
+ * {0, stride, ..., (n-1) * stride}, de modo que seguir `p = a[p]` a partir de
+ * qualquer posição visita todos os `n` elementos antes de voltar ao início.
+ * Diferente do Fisher-Yates, `j` é sorteado em [0, i), o que impede pontos fixos
+ * e ciclos curtos.
+ *
+ * @param a O array a ser preenchido; deve ter pelo menos `(n-1) * stride + 1` elementos.
+ * @param n O número de elementos no ciclo.
+ * @param stride A distância, em elementos, entre posições consecutivas do ciclo.
+ * @param seed Um ponteiro para o estado da semente de 64 bits usado pelo PRNG `splitmix64`.
+ */
+void sattolo32(uint32_t *a, size_t n, size_t stride, uint64_t *seed){
+    if (a == NULL || n == 0 || stride == 0) return;
+    for (size_t i = 0; i < n; i++) a[i * stride] = (uint32_t)(i * stride);
+    for (size_t i = n - 1; i > 0; --i){
+        size_t j = rand_below(seed, i);
+        uint32_t tmp = a[i * stride]; a[i * stride] = a[j * stride]; a[j * stride] = tmp;
+    }
+}
+
 /**
  * @brief Recupera a quantidade total de RAM física no sistema.
  *
@@ -120,6 +250,44 @@ unsigned long long get_total_system_memory() {
 }
 
 
+/**
+ * @brief Aloca um array zerado cujo endereço inicial é múltiplo de `alignment`.
+ *
+ * Usa `_aligned_malloc` no Windows e `posix_memalign` nos demais sistemas.
+ *
+ * @param nmemb O número de elementos.
+ * @param size O tamanho de cada elemento, em bytes.
+ * @param alignment O alinhamento desejado; deve ser uma potência de dois múltipla de `sizeof(void*)`.
+ * @return Um ponteiro para a memória zerada, ou NULL em caso de falha.
+ */
+void *aligned_calloc(size_t nmemb, size_t size, size_t alignment) {
+    if (nmemb == 0 || size == 0) return NULL;
+    if (nmemb > SIZE_MAX / size) return NULL;
+    size_t bytes = nmemb * size;
+    void *p = NULL;
+#ifdef _WIN32
+    p = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&p, alignment, bytes) != 0) p = NULL;
+#endif
+    if (p) memset(p, 0, bytes);
+    return p;
+}
+
+/**
+ * @brief Libera memória obtida com `aligned_calloc` (multiplataforma).
+ * @param p O ponteiro a ser liberado; NULL é ignorado.
+ */
+void aligned_free(void *p) {
+    if (!p) return;
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+
 /* --- Implementação da Abstração de Thread --- */
 
 #ifdef _WIN32
@@ -175,6 +343,67 @@ int thread_detach(thread_handle_t t) {
     if(t) CloseHandle(t); 
     return 0;
 }
+
+void thread_yield(void) {
+    SwitchToThread();
+}
+
+int thread_set_realtime(void) {
+    return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) ? 0 : -1;
+}
+
+/**
+ * @brief Fixa a thread chamadora em uma CPU lógica (multiplataforma).
+ *
+ * Este é um wrapper em torno de `pthread_setaffinity_np` (POSIX) e `SetThreadGroupAffinity` (Windows).
+ *
+ * @param cpu O índice da CPU lógica.
+ * @return 0 em caso de sucesso, não-zero em caso de falha.
+ */
+int thread_pin_self(int cpu) {
+    GROUP_AFFINITY ga = {0};
+    unsigned short group;
+    unsigned char number;
+    if (cpu_to_group(cpu, &group, &number) != 0) return -1;
+    ga.Group = group;
+    ga.Mask = (KAFFINITY)1 << number;
+    return SetThreadGroupAffinity(GetCurrentThread(), &ga, NULL) ? 0 : -1;
+}
+
+/**
+ * @brief Converte o índice global de uma CPU lógica em (grupo de processadores, número no grupo).
+ *
+ * O índice global numera as CPUs ativas grupo a grupo, na ordem dos grupos, de modo
+ * que máquinas com mais de 64 CPUs lógicas sejam vistas como uma faixa contínua.
+ *
+ * @return 0 em caso de sucesso, -1 se `cpu` está fora da faixa.
+ */
+int cpu_to_group(int cpu, unsigned short *group, unsigned char *number) {
+    if (cpu < 0) return -1;
+    WORD groups = GetActiveProcessorGroupCount();
+    for (WORD g = 0; g < groups; g++) {
+        int n = (int)GetActiveProcessorCount(g);
+        if (cpu < n) {
+            *group = g;
+            *number = (unsigned char)cpu;
+            return 0;
+        }
+        cpu -= n;
+    }
+    return -1;
+}
+
+/**
+ * @brief Converte (grupo de processadores, número no grupo) no índice global da CPU lógica.
+ * @return O índice global, ou -1 se o grupo ou o número não existem.
+ */
+int cpu_from_group(unsigned short group, unsigned char number) {
+    WORD groups = GetActiveProcessorGroupCount();
+    if (group >= groups || number >= GetActiveProcessorCount(group)) return -1;
+    int base = 0;
+    for (WORD g = 0; g < group; g++) base += (int)GetActiveProcessorCount(g);
+    return base + number;
+}
 #else
 // POSIX-specific implementation using pthreads
 
@@ -217,4 +446,42 @@ int thread_join(thread_handle_t t) {
 int thread_detach(thread_handle_t t) {
     return pthread_detach(t);
 }
+
+void thread_yield(void) {
+    sched_yield();
+}
+
+int thread_set_realtime(void) {
+    // Um nível abaixo do máximo, que fica para as threads de migração e watchdog do kernel.
+    int prio = sched_get_priority_max(SCHED_FIFO) - 1;
+    if (prio < sched_get_priority_min(SCHED_FIFO)) return -1;
+    struct sched_param sp = { .sched_priority = prio };
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp) == 0 ? 0 : -1;
+}
+
+/**
+ * @brief Fixa a thread chamadora em uma CPU lógica (multiplataforma).
+ *
+ * Este é um wrapper em torno de `pthread_setaffinity_np` (POSIX) e `SetThreadGroupAffinity` (Windows).
+ *
+ * @param cpu O índice da CPU lógica.
+ * @return 0 em caso de sucesso, não-zero em caso de falha.
+ */
+int thread_pin_self(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return -1;
+    cpu_set_t set; CPU_ZERO(&set); CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+}
+
+// No POSIX não há grupos de processadores; a conversão usa blocos de 64 CPUs, como o Windows.
+int cpu_to_group(int cpu, unsigned short *group, unsigned char *number) {
+    if (cpu < 0) return -1;
+    *group = (unsigned short)(cpu / 64);
+    *number = (unsigned char)(cpu % 64);
+    return 0;
+}
+
+int cpu_from_group(unsigned short group, unsigned char number) {
+    return number < 64 ? (int)group * 64 + number : -1;
+}
 #endif
@@ -23,6 +23,58 @@
  */
 double now_sec(void);
 
+/**
+ * @struct ticker_t
+ * @brief Temporizador periódico com prazos absolutos, que não acumula o atraso de cada período.
+ */
+typedef struct {
+    double period;  ///< Período em segundos.
+    double next;    ///< Próximo prazo, na escala de `now_sec`.
+#ifdef _WIN32
+    HANDLE timer;   ///< Waitable timer de alta resolução, ou NULL para recorrer a `Sleep`.
+#endif
+} ticker_t;
+
+/**
+ * @brief Inicia o temporizador; o primeiro prazo é um período após a chamada.
+ */
+void ticker_start(ticker_t *t, double period_sec);
+
+/**
+ * @brief Dorme até o próximo prazo absoluto e agenda o seguinte.
+ *
+ * Usa `clock_nanosleep(TIMER_ABSTIME)` no POSIX e um waitable timer no Windows. Se o
+ * chamador se atrasou além de um ou mais prazos, eles são descartados em vez de
+ * disparados em rajada.
+ *
+ * @return O número de prazos perdidos desde a última chamada (0 no caso normal).
+ */
+int ticker_wait(ticker_t *t);
+
+/**
+ * @brief Libera os recursos do temporizador.
+ */
+void ticker_stop(ticker_t *t);
+
+/**
+ * @brief Dorme até o instante absoluto `deadline`, na escala de `now_sec`.
+ *
+ * Retorna imediatamente se o instante já passou. A precisão é a do timer do SO;
+ * quem precisa de mais deve dormir até um pouco antes e esperar ativamente o resto.
+ */
+void sleep_until(double deadline);
+
+/**
+ * @brief Dica à CPU de que o chamador está em espera ativa (`pause` no x86, `yield` no ARM).
+ */
+static inline void cpu_relax(void){
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
 /**
  * @brief Um gerador de números pseudoaleatórios (PRNG) de 64 bits rápido e de alta qualidade.
  *
@@ -48,6 +100,20 @@ uint64_t splitmix64(uint64_t *x);
  */
 void shuffle32(uint32_t *a, size_t n, uint64_t *seed);
 
+/**
+ * @brief Constrói um ciclo único aleatório com o algoritmo de Sattolo.
+ *
+ * Preenche `a[k * stride]`, para `k < n`, de modo que seguir `p = a[p]` visita
+ * todos os `n` elementos em um único ciclo. Usado para montar a cadeia do kernel
+ * de perseguição de ponteiro, em que cada passo é uma carga dependente.
+ *
+ * @param a O array a ser preenchido; deve ter pelo menos `(n-1) * stride + 1` elementos.
+ * @param n O número de elementos no ciclo (no máximo `UINT32_MAX / stride`).
+ * @param stride A distância, em elementos, entre posições consecutivas do ciclo.
+ * @param seed Um ponteiro para o estado da semente de 64 bits usado pelo PRNG `splitmix64`.
+ */
+void sattolo32(uint32_t *a, size_t n, size_t stride, uint64_t *seed);
+
 /**
  * @brief Recupera a quantidade total de RAM física no sistema.
  *
@@ -58,6 +124,53 @@ void shuffle32(uint32_t *a, size_t n, uint64_t *seed);
  */
 unsigned long long get_total_system_memory(void);
 
+/**
+ * @brief Aloca um array zerado cujo endereço inicial é múltiplo de `alignment`.
+ *
+ * Usado para estruturas compartilhadas entre threads que precisam começar em uma
+ * fronteira de linha de cache (por exemplo, o array de `worker_t`). A memória
+ * deve ser liberada com `aligned_free`.
+ *
+ * @param nmemb O número de elementos.
+ * @param size O tamanho de cada elemento, em bytes.
+ * @param alignment O alinhamento desejado; deve ser uma potência de dois múltipla de `sizeof(void*)`.
+ * @return Um ponteiro para a memória zerada, ou NULL em caso de falha.
+ */
+void *aligned_calloc(size_t nmemb, size_t size, size_t alignment);
+
+/**
+ * @brief Libera memória obtida com `aligned_calloc` (multiplataforma).
+ * @param p O ponteiro a ser liberado; NULL é ignorado.
+ */
+void aligned_free(void *p);
+
+/**
+ * @brief Fixa a thread chamadora em uma CPU lógica (multiplataforma).
+ *
+ * Este é um wrapper em torno de `pthread_setaffinity_np` (POSIX) e `SetThreadGroupAffinity` (Windows).
+ * Ao ser chamada pela própria thread, garante que a fixação acontece antes de qualquer alocação.
+ *
+ * @param cpu O índice da CPU lógica.
+ * @return 0 em caso de sucesso, não-zero em caso de falha.
+ */
+int thread_pin_self(int cpu);
+
+/**
+ * @brief Converte o índice global de uma CPU lógica em (grupo de processadores, número no grupo).
+ *
+ * No Windows, cada grupo tem até 64 CPUs e o índice global as numera grupo a grupo;
+ * no POSIX, os grupos são apenas blocos de 64 CPUs.
+ *
+ * @return 0 em caso de sucesso, -1 se `cpu` está fora da faixa.
+ */
+int cpu_to_group(int cpu, unsigned short *group, unsigned char *number);
+
+/**
+ * @brief Converte (grupo de processadores, número no grupo) no índice global da CPU lógica.
+ * @return O índice global, ou -1 se o grupo ou o número não existem.
+ */
+int cpu_from_group(unsigned short group, unsigned char number);
+
 /**
  * @brief Cria uma nova thread (multiplataforma).
  *
@@ -80,6 +193,23 @@ int thread_create(thread_handle_t *t, thread_func_t func, void *arg);
  */
 int thread_join(thread_handle_t t);
 
+/**
+ * @brief Cede o restante da fatia de tempo da thread chamadora (`sched_yield` / `SwitchToThread`).
+ *
+ * Usado nas esperas ativas entre threads que podem dividir a mesma CPU.
+ */
+void thread_yield(void);
+
+/**
+ * @brief Eleva a thread chamadora à prioridade de tempo real (`SCHED_FIFO` / `THREAD_PRIORITY_TIME_CRITICAL`).
+ *
+ * No Linux exige `CAP_SYS_NICE` (ou um limite `RLIMIT_RTPRIO`); sem ele, a thread
+ * continua com a prioridade normal.
+ *
+ * @return 0 em caso de sucesso, -1 se o sistema recusou.
+ */
+int thread_set_realtime(void);
+
 /**
  * @brief Desanexa uma thread, permitindo que ela execute de forma independente e tenha seus recursos liberados na finalização (multiplataforma).
  *
@@ -0,0 +1,378 @@
+#include "verify.h"
+#include "kernels.h"
+#include <ctype.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VERIFY_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#endif
+
+/** @brief Constante que separa a semente das chaves de bloco da semente do molde aleatório. */
+#define VERIFY_KEY_SALT 0xD1B54A32D192ED03ULL
+
+/** @brief Uma implementação de `verify_pass`. */
+typedef size_t (*verify_pass_fn)(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                                 const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out);
+
+/* --- Static Function Prototypes --- */
+static inline uint64_t mix(uint64_t z);
+static inline void block_consts(const verify_pattern_t *p, const uint64_t *base, size_t blk, uint64_t *add, uint64_t *xr);
+static inline void record(verify_mismatch_t *out, size_t max_out, size_t *bad, size_t index, uint64_t e, uint64_t a);
+static int best_isa(void);
+static verify_pass_fn pass_impl(int isa);
+static size_t pass_scalar(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                          const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out);
+#ifdef VERIFY_HAVE_X86
+static size_t pass_avx2(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                        const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out);
+static size_t pass_avx512(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                          const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out);
+#endif
+#ifndef _WIN32
+static int list_indexed(const char *dir, const char *prefix, int *out, int max);
+static int read_text(const char *path, char *buf, size_t len);
+#endif
+
+/* --- Padrões --- */
+
+const char *verify_kind_name(int kind){
+    static const char *names[VERIFY_KIND_COUNT] = { "uns andando", "endereço", "aleatório" };
+    return (kind >= 0 && kind < VERIFY_KIND_COUNT) ? names[kind] : "?";
+}
+
+/**
+ * @brief Finalizador do splitmix64: espalha os bits de `z`.
+ */
+static inline uint64_t mix(uint64_t z){
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void verify_pattern_init(verify_pattern_t *p, unsigned long long pass, uint64_t seed){
+    p->kind = (int)(pass % VERIFY_KIND_COUNT);
+    p->inverted = (int)((pass / VERIFY_KIND_COUNT) & 1);
+    p->seed = mix(seed + (pass + 1) * 0x9E3779B97F4A7C15ULL);
+    switch (p->kind) {
+        case VERIFY_WALKING_ONES: {
+            // O período de 64 palavras divide o bloco, então o bit anda sem salto entre blocos.
+            unsigned shift = (unsigned)(p->seed & 63);
+            for (size_t k = 0; k < VERIFY_BLOCK_ELEMS; k++) p->tmpl[k] = 1ULL << ((k + shift) & 63);
+            break;
+        }
+        case VERIFY_ADDRESS:
+            for (size_t k = 0; k < VERIFY_BLOCK_ELEMS; k++) p->tmpl[k] = (uint64_t)(k * sizeof(uint64_t));
+            break;
+        default:
+            fill_random_u64(p->tmpl, VERIFY_BLOCK_ELEMS, p->seed, 0);
+            break;
+    }
+}
+
+/**
+ * @brief Calcula a soma e o XOR que o bloco `blk` aplica sobre o molde.
+ */
+static inline void block_consts(const verify_pattern_t *p, const uint64_t *base, size_t blk, uint64_t *add, uint64_t *xr){
+    uint64_t inv = p->inverted ? ~0ULL : 0ULL;
+    *add = p->kind == VERIFY_ADDRESS ? (uint64_t)(uintptr_t)(base + blk * VERIFY_BLOCK_ELEMS) : 0;
+    *xr = p->kind == VERIFY_RANDOM ? mix((p->seed ^ VERIFY_KEY_SALT) + blk) ^ inv : inv;
+}
+
+uint64_t verify_expected(const verify_pattern_t *p, const uint64_t *base, size_t i){
+    uint64_t add, xr;
+    block_consts(p, base, i / VERIFY_BLOCK_ELEMS, &add, &xr);
+    return (p->tmpl[i % VERIFY_BLOCK_ELEMS] + add) ^ xr;
+}
+
+/* --- Passagens de Leitura-Comparação-Escrita --- */
+
+/**
+ * @brief Conta uma divergência e guarda os detalhes enquanto houver espaço em `out`.
+ */
+static inline void record(verify_mismatch_t *out, size_t max_out, size_t *bad, size_t index, uint64_t e, uint64_t a){
+    if (*bad < max_out) out[*bad] = (verify_mismatch_t){ .index = index, .expected = e, .actual = a };
+    (*bad)++;
+}
+
+/**
+ * @brief Implementação escalar, também a referência dos testes.
+ */
+static size_t pass_scalar(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                          const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out){
+    size_t bad = 0;
+    for (size_t blk = first / VERIFY_BLOCK_ELEMS; blk < (first + n) / VERIFY_BLOCK_ELEMS; blk++) {
+        uint64_t *p = base + blk * VERIFY_BLOCK_ELEMS;
+        uint64_t fa, fx, ca = 0, cx = 0;
+        block_consts(fill, base, blk, &fa, &fx);
+        if (!check) {
+            for (size_t k = 0; k < VERIFY_BLOCK_ELEMS; k++) p[k] = (fill->tmpl[k] + fa) ^ fx;
+            continue;
+        }
+        block_consts(check, base, blk, &ca, &cx);
+        for (size_t k = 0; k < VERIFY_BLOCK_ELEMS; k++) {
+            uint64_t e = (check->tmpl[k] + ca) ^ cx;
+            uint64_t a = p[k];
+            if (a != e) record(out, max_out, &bad, blk * VERIFY_BLOCK_ELEMS + k, e, a);
+            p[k] = (fill->tmpl[k] + fa) ^ fx;
+        }
+    }
+    return bad;
+}
+
+#ifdef VERIFY_HAVE_X86
+/**
+ * @brief Implementação AVX2: 4 palavras por vetor.
+ *
+ * A comparação de cada vetor termina em um desvio que quase nunca é tomado; só
+ * um vetor divergente é reexaminado palavra a palavra, antes de ser regravado.
+ */
+__attribute__((target("avx2")))
+static size_t pass_avx2(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                        const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out){
+    size_t bad = 0;
+    for (size_t blk = first / VERIFY_BLOCK_ELEMS; blk < (first + n) / VERIFY_BLOCK_ELEMS; blk++) {
+        uint64_t *p = base + blk * VERIFY_BLOCK_ELEMS;
+        uint64_t fa, fx, ca = 0, cx = 0;
+        block_consts(fill, base, blk, &fa, &fx);
+        const __m256i vfa = _mm256_set1_epi64x((long long)fa), vfx = _mm256_set1_epi64x((long long)fx);
+        if (!check) {
+            for (size_t k = 0; k < VERIFY_BLOCK_ELEMS; k += 4) {
+                __m256i w = _mm256_xor_si256(_mm256_add_epi64(_mm256_load_si256((const __m256i*)(fill->tmpl + k)), vfa), vfx);
+                _mm256_storeu_si256((__m256i*)(p + k), w);
+            }
+            continue;
+        }
+        block_consts(check, base, blk, &ca, &cx);
+        const __m256i vca = _mm256_set1_epi64x((long long)ca), vcx = _mm256_set1_epi64x((long long)cx);
+        for (size_t k = 0; k < VERIFY_BLOCK_ELEMS; k += 4) {
+            __m256i e = _mm256_xor_si256(_mm256_add_epi64(_mm256_load_si256((const __m256i*)(check->tmpl + k)), vca), vcx);
+            __m256i a = _mm256_loadu_si256((const __m256i*)(p + k));
+            __m256i d = _mm256_xor_si256(a, e);
+            if (__builtin_expect(!_mm256_testz_si256(d, d), 0)) {
+                uint64_t ev[4], av[4];
+                _mm256_storeu_si256((__m256i*)ev, e);
+                _mm256_storeu_si256((__m256i*)av, a);
+                for (int l = 0; l < 4; l++) {
+                    if (ev[l] != av[l]) record(out, max_out, &bad, blk * VERIFY_BLOCK_ELEMS + k + l, ev[l], av[l]);
+                }
+            }
+            __m256i w = _mm256_xor_si256(_mm256_add_epi64(_mm256_load_si256((const __m256i*)(fill->tmpl + k)), vfa), vfx);
+            _mm256_storeu_si256((__m256i*)(p + k), w);
+        }
+    }
+    return bad;
+}
+
+/**
+ * @brief Implementação AVX-512F: 8 palavras por vetor, com a comparação em uma máscara.
+ */
+__attribute__((target("avx512f")))
+static size_t pass_avx512(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                          const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out){
+    size_t bad = 0;
+    for (size_t blk = first / VERIFY_BLOCK_ELEMS; blk < (first + n) / VERIFY_BLOCK_ELEMS; blk++) {
+        uint64_t *p = base + blk * VERIFY_BLOCK_ELEMS;
+        uint64_t fa, fx, ca = 0, cx = 0;
+        block_consts(fill, base, blk, &fa, &fx);
+        const __m512i vfa = _mm512_set1_epi64((long long)fa), vfx = _mm512_set1_epi64((long long)fx);
+        if (!check) {
+            for (size_t k = 0; k < VERIFY_BLOCK_ELEMS; k += 8) {
+                __m512i w = _mm512_xor_si512(_mm512_add_epi64(_mm512_load_si512((const void*)(fill->tmpl + k)), vfa), vfx);
+                _mm512_storeu_si512((void*)(p + k), w);
+            }
+            continue;
+        }
+        block_consts(check, base, blk, &ca, &cx);
+        const __m512i vca = _mm512_set1_epi64((long long)ca), vcx = _mm512_set1_epi64((long long)cx);
+        for (size_t k = 0; k < VERIFY_BLOCK_ELEMS; k += 8) {
+            __m512i e = _mm512_xor_si512(_mm512_add_epi64(_mm512_load_si512((const void*)(check->tmpl + k)), vca), vcx);
+            __m512i a = _mm512_loadu_si512((const void*)(p + k));
+            __mmask8 m = _mm512_cmpneq_epu64_mask(a, e);
+            if (__builtin_expect(m != 0, 0)) {
+                uint64_t ev[8], av[8];
+                _mm512_storeu_si512((void*)ev, e);
+                _mm512_storeu_si512((void*)av, a);
+                for (int l = 0; l < 8; l++) {
+                    if (m & (1u << l)) record(out, max_out, &bad, blk * VERIFY_BLOCK_ELEMS + k + l, ev[l], av[l]);
+                }
+            }
+            __m512i w = _mm512_xor_si512(_mm512_add_epi64(_mm512_load_si512((const void*)(fill->tmpl + k)), vfa), vfx);
+            _mm512_storeu_si512((void*)(p + k), w);
+        }
+    }
+    return bad;
+}
+#endif
+
+/**
+ * @brief Escolhe a implementação mais larga que a CPU e o SO suportam.
+ *
+ * A sondagem é feita na primeira chamada e guardada; chamadas concorrentes
+ * nesse instante chegam ao mesmo resultado.
+ */
+static int best_isa(void){
+    static atomic_int cached = -1;
+    int isa = atomic_load_explicit(&cached, memory_order_relaxed);
+    if (isa >= 0) return isa;
+    isa = FP_ISA_SCALAR;
+#ifdef VERIFY_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) isa = FP_ISA_AVX512;
+    else if (__builtin_cpu_supports("avx2")) isa = FP_ISA_AVX2;
+#endif
+    atomic_store_explicit(&cached, isa, memory_order_relaxed);
+    return isa;
+}
+
+/**
+ * @brief Retorna a implementação de um conjunto de instruções, ou NULL se não há uma.
+ */
+static verify_pass_fn pass_impl(int isa){
+    switch (isa) {
+        case FP_ISA_SCALAR: return pass_scalar;
+#ifdef VERIFY_HAVE_X86
+        case FP_ISA_AVX2: return pass_avx2;
+        case FP_ISA_AVX512: return pass_avx512;
+#endif
+        default: return NULL;
+    }
+}
+
+size_t verify_pass_isa(int isa, uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                       const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out){
+    verify_pass_fn fn = pass_impl(isa);
+#ifdef VERIFY_HAVE_X86
+    __builtin_cpu_init();
+    if (isa == FP_ISA_AVX2 && !__builtin_cpu_supports("avx2")) fn = NULL;
+    if (isa == FP_ISA_AVX512 && !__builtin_cpu_supports("avx512f")) fn = NULL;
+#endif
+    if (!fn) return (size_t)-1;
+    if (!base || !fill || first % VERIFY_BLOCK_ELEMS != 0 || n % VERIFY_BLOCK_ELEMS != 0) return 0;
+    return fn(base, first, n, check, fill, out, max_out);
+}
+
+size_t verify_pass(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                   const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out){
+    // Chamada a cada quantum: a implementação já foi resolvida por best_isa.
+    if (!base || !fill || first % VERIFY_BLOCK_ELEMS != 0 || n % VERIFY_BLOCK_ELEMS != 0) return 0;
+    return pass_impl(best_isa())(base, first, n, check, fill, out, max_out);
+}
+
+const char *verify_impl_name(void){
+    switch (best_isa()) {
+        case FP_ISA_AVX512: return "AVX-512F";
+        case FP_ISA_AVX2: return "AVX2";
+        default: return "escalar";
+    }
+}
+
+/* --- Localização das Divergências --- */
+
+int verify_phys_addr(const void *p, uint64_t *phys){
+#ifdef __linux__
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0 || !phys) return -1;
+    int fd = open("/proc/self/pagemap", O_RDONLY);
+    if (fd < 0) return -1;
+    uintptr_t v = (uintptr_t)p;
+    uint64_t entry = 0;
+    ssize_t r = pread(fd, &entry, sizeof(entry), (off_t)(v / (uintptr_t)page) * (off_t)sizeof(entry));
+    close(fd);
+    // Bit 63: página presente; bits 0-54: número do quadro, zerado para quem não tem CAP_SYS_ADMIN.
+    uint64_t pfn = entry & ((1ULL << 55) - 1);
+    if (r != (ssize_t)sizeof(entry) || !(entry >> 63) || pfn == 0) return -1;
+    *phys = pfn * (uint64_t)page + v % (uintptr_t)page;
+    return 0;
+#else
+    (void)p; (void)phys;
+    return -1;
+#endif
+}
+
+#ifndef _WIN32
+/**
+ * @brief Lê um pequeno arquivo de texto do sysfs, sem o '\n' final.
+ * @return 0 em caso de sucesso, -1 em caso de falha.
+ */
+static int read_text(const char *path, char *buf, size_t len){
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char *ok = fgets(buf, (int)len, f);
+    fclose(f);
+    if (!ok) return -1;
+    buf[strcspn(buf, "\n")] = '\0';
+    return 0;
+}
+
+static int cmp_int(const void *a, const void *b){
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Lista os índices N das entradas `<prefix><N>` de `dir`, em ordem crescente.
+ * @return Quantos índices foram gravados em `out`.
+ */
+static int list_indexed(const char *dir, const char *prefix, int *out, int max){
+    DIR *d = opendir(dir);
+    if (!d) return 0;
+    size_t plen = strlen(prefix);
+    int n = 0;
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL && n < max) {
+        if (strncmp(de->d_name, prefix, plen) != 0 || !isdigit((unsigned char)de->d_name[plen])) continue;
+        out[n++] = atoi(de->d_name + plen);
+    }
+    closedir(d);
+    qsort(out, n, sizeof(int), cmp_int);
+    return n;
+}
+#endif
+
+verify_edac_t *verify_edac_read(const char *sysfs_root){
+#ifdef _WIN32
+    (void)sysfs_root;
+    return NULL;
+#else
+    const char *root = sysfs_root ? sysfs_root : "/sys";
+    char dir[512];
+    snprintf(dir, sizeof(dir), "%s/devices/system/edac/mc", root);
+    int mcs[64];
+    int n_mc = list_indexed(dir, "mc", mcs, 64);
+    if (n_mc == 0) return NULL;
+    verify_edac_t *e = calloc(1, sizeof(verify_edac_t) + VERIFY_EDAC_MAX_DIMMS * sizeof(verify_dimm_t));
+    if (!e) return NULL;
+    for (int m = 0; m < n_mc; m++) {
+        char mc_dir[600];
+        snprintf(mc_dir, sizeof(mc_dir), "%s/mc%d", dir, mcs[m]);
+        int dimms[VERIFY_EDAC_MAX_DIMMS];
+        int n_dimm = list_indexed(mc_dir, "dimm", dimms, VERIFY_EDAC_MAX_DIMMS);
+        for (int d = 0; d < n_dimm && e->n < VERIFY_EDAC_MAX_DIMMS; d++) {
+            char path[700], text[64];
+            unsigned long long ce, ue;
+            snprintf(path, sizeof(path), "%s/dimm%d/dimm_ce_count", mc_dir, dimms[d]);
+            if (read_text(path, text, sizeof(text)) != 0 || sscanf(text, "%llu", &ce) != 1) continue;
+            snprintf(path, sizeof(path), "%s/dimm%d/dimm_ue_count", mc_dir, dimms[d]);
+            if (read_text(path, text, sizeof(text)) != 0 || sscanf(text, "%llu", &ue) != 1) ue = 0;
+            verify_dimm_t *dm = &e->dimm[e->n++];
+            snprintf(dm->name, sizeof(dm->name), "mc%d/dimm%d", mcs[m], dimms[d]);
+            snprintf(path, sizeof(path), "%s/dimm%d/dimm_label", mc_dir, dimms[d]);
+            if (read_text(path, dm->label, sizeof(dm->label)) != 0 || dm->label[0] == '\0') {
+                memcpy(dm->label, dm->name, sizeof(dm->name));
+            }
+            dm->ce = ce;
+            dm->ue = ue;
+        }
+    }
+    if (e->n == 0) {
+        free(e);
+        return NULL;
+    }
+    return e;
+#endif
+}
@@ -0,0 +1,155 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+/**
+ * @file verify.h
+ * @brief Declara a verificação de integridade da memória feita pelo kernel STREAM.
+ *
+ * Com a verificação ligada, o kernel STREAM deixa de copiar doubles e passa a
+ * percorrer todo o seu buffer em passagens de leitura-comparação-escrita: cada
+ * palavra de 64 bits é lida, comparada com o padrão gravado na passagem
+ * anterior e regravada com o padrão da próxima, em um único laço vetorizado.
+ * Como a escrita cai na linha que acabou de ser lida, não há leitura para posse
+ * extra, e cada elemento move 16 bytes, como o Copy do STREAM; a carga de
+ * memória fica próxima da banda do STREAM.
+ *
+ * Os padrões se alternam a cada passagem: uns andando (um bit aceso que anda
+ * pelas 64 linhas de dados de palavra em palavra), endereço no endereço (cada
+ * palavra guarda o próprio endereço virtual, o que denuncia falhas de
+ * endereçamento) e blocos aleatórios (um bloco de `VERIFY_BLOCK_ELEMS` palavras
+ * sorteado da semente, combinado com uma chave por bloco). A cada três
+ * passagens os padrões voltam complementados, para que cada bit seja testado
+ * nos dois sentidos.
+ *
+ * Uma divergência é localizada pelo endereço virtual e, quando o SO o expõe
+ * (`/proc/self/pagemap`, que exige CAP_SYS_ADMIN), pelo físico. O Linux não
+ * traduz um endereço físico para o pente; os contadores do EDAC por DIMM, lidos
+ * antes e depois do teste, identificam os pentes em que o controlador de
+ * memória corrigiu (ou não) erros durante o teste.
+ */
+
+#include "hardstress.h"
+
+/** @brief Palavras de 64 bits do molde de um padrão (4 KiB); o buffer é verificado em múltiplos disto. */
+#define VERIFY_BLOCK_ELEMS 512
+/** @brief Divergências detalhadas por quantum de verificação; as demais são apenas contadas. */
+#define VERIFY_QUANTUM_RECORDS 8
+/** @brief Divergências registradas no log por teste, somando todos os workers. */
+#define VERIFY_LOG_MAX 64
+/** @brief Máximo de DIMMs acompanhados pelo EDAC. */
+#define VERIFY_EDAC_MAX_DIMMS 256
+
+/**
+ * @enum verify_kind_t
+ * @brief Padrões gravados e conferidos, na ordem em que as passagens os usam.
+ */
+typedef enum {
+    VERIFY_WALKING_ONES = 0, ///< Um bit aceso por palavra, deslocado de uma posição a cada palavra.
+    VERIFY_ADDRESS,         ///< Cada palavra guarda o seu endereço virtual.
+    VERIFY_RANDOM,          ///< Bloco aleatório da semente, com uma chave por bloco.
+    VERIFY_KIND_COUNT
+} verify_kind_t;
+
+/**
+ * @struct verify_pattern_t
+ * @brief Um padrão de uma passagem: a palavra `i` do buffer vale `(tmpl[i % B] + add) ^ xor`.
+ *
+ * `add` e `xor` dependem apenas do bloco `i / B` (ver `verify_expected`), de modo
+ * que o laço de verificação só faz uma soma e um XOR por palavra sobre um molde
+ * que fica no cache L1.
+ */
+struct verify_pattern_t {
+    _Alignas(CACHE_LINE_SIZE) uint64_t tmpl[VERIFY_BLOCK_ELEMS]; ///< Molde de um bloco.
+    int kind;               ///< `verify_kind_t`.
+    int inverted;           ///< 1 se o padrão é o complemento (passagens 3 a 5 de cada ciclo de 6).
+    uint64_t seed;          ///< Semente da passagem (chaves dos blocos aleatórios).
+};
+
+/**
+ * @struct verify_mismatch_t
+ * @brief Uma palavra lida diferente da esperada.
+ */
+typedef struct {
+    size_t index;           ///< Palavra, contada do início do buffer verificado.
+    uint64_t expected;      ///< Valor gravado na passagem anterior.
+    uint64_t actual;        ///< Valor lido.
+} verify_mismatch_t;
+
+/**
+ * @struct verify_dimm_t
+ * @brief Contadores de erros de um DIMM no EDAC.
+ */
+typedef struct {
+    char name[32];          ///< Controlador e DIMM no sysfs (por exemplo, "mc0/dimm3").
+    char label[64];         ///< Rótulo do pente (`dimm_label`, normalmente o slot da placa).
+    unsigned long long ce;  ///< Erros corrigidos.
+    unsigned long long ue;  ///< Erros não corrigidos.
+} verify_dimm_t;
+
+/**
+ * @struct verify_edac_t
+ * @brief Instantâneo dos contadores do EDAC de todos os DIMMs.
+ */
+struct verify_edac_t {
+    int n;                  ///< DIMMs.
+    verify_dimm_t dimm[];   ///< Um por DIMM, na ordem dos controladores.
+};
+
+/**
+ * @brief Retorna o nome de um padrão ("uns andando", "endereço", "aleatório").
+ */
+const char *verify_kind_name(int kind);
+
+/**
+ * @brief Prepara o padrão da passagem `pass`.
+ *
+ * A passagem `pass` usa o padrão `pass % VERIFY_KIND_COUNT`, complementado quando
+ * `(pass / VERIFY_KIND_COUNT)` é ímpar, com uma semente derivada de `seed` e de `pass`.
+ */
+void verify_pattern_init(verify_pattern_t *p, unsigned long long pass, uint64_t seed);
+
+/**
+ * @brief Retorna o valor esperado da palavra `i` de um buffer que começa em `base` (referência escalar).
+ */
+uint64_t verify_expected(const verify_pattern_t *p, const uint64_t *base, size_t i);
+
+/**
+ * @brief Confere e regrava as palavras `[first, first + n)` de `base`, com a melhor implementação da CPU.
+ *
+ * @param base Início do buffer verificado (o padrão de endereço usa os endereços reais).
+ * @param first, n Primeira palavra e número de palavras; múltiplos de `VERIFY_BLOCK_ELEMS`.
+ * @param check Padrão esperado, ou NULL para apenas gravar (preenchimento inicial).
+ * @param fill Padrão gravado em cada palavra depois da leitura.
+ * @param out Recebe as primeiras `max_out` divergências, em ordem de endereço.
+ * @return O número de palavras divergentes.
+ */
+size_t verify_pass(uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                   const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out);
+
+/**
+ * @brief Como `verify_pass`, com uma implementação específica (`fp_isa_t`).
+ * @return O número de palavras divergentes, ou `(size_t)-1` se a implementação não existe nesta CPU.
+ */
+size_t verify_pass_isa(int isa, uint64_t *base, size_t first, size_t n, const verify_pattern_t *check,
+                       const verify_pattern_t *fill, verify_mismatch_t *out, size_t max_out);
+
+/**
+ * @brief Retorna o nome da implementação usada por `verify_pass` ("escalar", "AVX2", "AVX-512F").
+ */
+const char *verify_impl_name(void);
+
+/**
+ * @brief Traduz um endereço virtual do processo para o físico.
+ * @param phys Recebe o endereço físico.
+ * @return 0 em caso de sucesso, -1 se o SO não o expõe (sem permissão, página ausente ou outro SO).
+ */
+int verify_phys_addr(const void *p, uint64_t *phys);
+
+/**
+ * @brief Lê os contadores de erros de cada DIMM no EDAC (`devices/system/edac/mc/mcN/dimmM`).
+ * @param sysfs_root A raiz do sysfs, ou NULL para "/sys" (outro valor é útil em testes).
+ * @return O instantâneo, ou NULL se o EDAC não está disponível. Liberar com `free`.
+ */
+verify_edac_t *verify_edac_read(const char *sysfs_root);
+
+#endif // VERIFY_H
@@ -4,6 +4,8 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+void *__real_calloc(size_t nmemb, size_t size);
+
 // Variáveis de controle para a simulação de falha do calloc
 static bool g_calloc_will_fail = false;
 static int g_calloc_fail_countdown = -1;
@@ -38,7 +40,7 @@ void *__wrap_calloc(size_t nmemb, size_t size) {
             return NULL;
         }
     }
-    return calloc(nmemb, size);
+    return __real_calloc(nmemb, size);
 }
 
 /**
@@ -0,0 +1,70 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "hardstress.h"
+#include "bench.h"
+
+/**
+ * @brief Testa a suíte de benchmarks: opções, mediana/p95, arquivo de pontuação e comparação com a base.
+ */
+void test_bench_scores(void) {
+    printf("\n- Running test_bench_scores...\n");
+    bench_opts_t o;
+    char *argv_ok[] = {"HardStress", "--bench", "--reps", "3", "--threads", "1,all", "--threshold", "2.5", "--filter", "ptr"};
+    assert(bench_parse_args(&o, 10, argv_ok) == 0);
+    assert(o.reps == 3 && o.warmup == 2 && o.threshold_pct == 2.5 && strcmp(o.filter, "ptr") == 0);
+    assert(o.thread_count_n == 2 && o.thread_counts[0] == 1 && o.thread_counts[1] == 0);
+    char *argv_bad[] = {"HardStress", "--bench", "--threads", "1,,2"};
+    assert(bench_parse_args(&o, 4, argv_bad) == -1);
+    char *argv_reps[] = {"HardStress", "--bench", "--reps", "0"};
+    assert(bench_parse_args(&o, 4, argv_reps) == -1);
+    printf("  - PASSED: Options are parsed and invalid values rejected.\n");
+
+    double rates[10] = {9, 3, 7, 1, 5, 10, 2, 8, 4, 6};
+    bench_stats_t st;
+    bench_stats(rates, 10, 1, &st);
+    assert(st.median == 5.5 && st.min == 1 && st.max == 10 && st.p95 == 1);
+    double lat[20];
+    for (int i = 0; i < 20; i++) lat[i] = 20 - i;
+    bench_stats(lat, 20, 0, &st);
+    assert(st.median == 10.5 && st.p95 == 19);
+    printf("  - PASSED: The p95 is taken from the bad tail: low rates, high latencies.\n");
+
+    char path[] = "/tmp/hardstress_bench_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    bench_score_t cur[2] = {
+        { "stream.triad.dram", 1, "GB/s", 1, { 9.0, 8.5, 8.0, 9.5 } },
+        { "ptr.lat.dram", 1, "ns/carga", 0, { 100.0, 110.0, 95.0, 120.0 } },
+    };
+    assert(bench_write_scores(path, &o, cur, 2) == 0);
+    bench_score_t *base = NULL;
+    assert(bench_load_scores(path, &base) == 2);
+    assert(strcmp(base[1].name, "ptr.lat.dram") == 0 && strcmp(base[1].unit, "ns/carga") == 0);
+    assert(base[1].higher_is_better == 0 && base[1].stats.p95 == 110.0 && base[0].stats.median == 9.0);
+    printf("  - PASSED: Scores round-trip through the JSON Lines file.\n");
+
+    double d;
+    cur[0].stats.median = 8.0;   // 11% less bandwidth
+    cur[1].stats.median = 104.0; // 4% more latency
+    assert(bench_compare(&cur[0], &base[0], 5.0, &d) == 1 && d < -11.0);
+    assert(bench_compare(&cur[1], &base[1], 5.0, &d) == 0 && d > -4.1 && d < -3.9);
+    cur[1].stats.median = 90.0;  // lower latency is an improvement
+    assert(bench_compare(&cur[1], &base[1], 5.0, &d) == 0 && d > 9.9);
+    printf("  - PASSED: Regressions beyond the threshold are flagged in the direction of each metric.\n");
+    free(base);
+
+    // A short real run of one case, written and compared against itself.
+    char *argv_run[] = {"HardStress", "--bench", "--filter", "fpu.reg", "--threads", "1", "--reps", "3", "--warmup", "0",
+                        "--rep-ms", "10", "--out", path, "--baseline", path, "--threshold", "99"};
+    assert(bench_main(18, argv_run) == 0);
+    assert(bench_load_scores(path, &base) == 1);
+    assert(strcmp(base[0].name, "fpu.reg") == 0 && base[0].threads == 1 && base[0].stats.median > 0.0);
+    assert(base[0].stats.p95 <= base[0].stats.median);
+    printf("  - PASSED: A filtered run measures the case and writes its score.\n");
+    free(base);
+    unlink(path);
+}
@@ -0,0 +1,79 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "hardstress.h"
+#include "utils.h"
+#include "coherence.h"
+
+/** @brief Um lado do ping-pong executado em uma thread do teste. */
+typedef struct {
+    shared_line_t *lines;
+    int side;
+    atomic_counts_t counts;
+} pp_side_t;
+
+static thread_return_t THREAD_CALL run_side(void *arg){
+    pp_side_t *s = (pp_side_t*)arg;
+    kernel_atomic(&s->lines[ATOMIC_LINE_ADD], &s->lines[ATOMIC_LINE_CAS], &s->lines[ATOMIC_LINE_PAIRS], s->side, 64, &s->counts);
+    return 0;
+}
+
+/**
+ * @brief Testa o kernel ATOMIC, o ping-pong entre dois lados e o resumo da matriz de latência.
+ */
+void test_coherence(void) {
+    printf("\n- Running test_coherence...\n");
+    shared_line_t *lines = aligned_calloc(ATOMIC_LINE_PAIRS + 1, sizeof(shared_line_t), WORKER_ALIGN);
+    assert(lines != NULL);
+    assert(sizeof(shared_line_t) == WORKER_ALIGN);
+
+    atomic_counts_t solo = {0};
+    kernel_atomic(&lines[ATOMIC_LINE_ADD], &lines[ATOMIC_LINE_CAS], NULL, 0, 64, &solo);
+    assert(solo.ops == 64 && solo.cas_fails == 0 && solo.rounds == 0);
+    assert(atomic_load(&lines[ATOMIC_LINE_ADD].v) == 48 && atomic_load(&lines[ATOMIC_LINE_CAS].v) == 16);
+    printf("  - PASSED: An unpaired worker splits its quantum between fetch-add and CAS.\n");
+
+    // Os dois lados se revezam mesmo que dividam uma única CPU.
+    pp_side_t sides[2] = { { lines, 0, {0} }, { lines, 1, {0} } };
+    thread_handle_t t[2];
+    for (int i = 0; i < 2; i++) assert(thread_create(&t[i], run_side, &sides[i]) == 0);
+    for (int i = 0; i < 2; i++) thread_join(t[i]);
+    assert(atomic_load(&lines[ATOMIC_LINE_PAIRS].v) == 32);
+    for (int i = 0; i < 2; i++) {
+        assert(sides[i].counts.ops == 64 && sides[i].counts.rounds == 15);
+    }
+    assert(atomic_load(&lines[ATOMIC_LINE_ADD].v) == 48 + 2 * 32);
+    assert(atomic_load(&lines[ATOMIC_LINE_CAS].v) == 16 + 2 * 16);
+    printf("  - PASSED: Paired sides alternate on the shared line and count their round trips.\n");
+
+    // Sem o parceiro, a espera é limitada e o resto do ping-pong é abandonado.
+    atomic_counts_t absent = {0};
+    kernel_atomic(&lines[ATOMIC_LINE_ADD], &lines[ATOMIC_LINE_CAS], &lines[ATOMIC_LINE_PAIRS], 1, 64, &absent);
+    assert(absent.ops == 48 && absent.rounds == 0);
+    aligned_free(lines);
+    printf("  - PASSED: A missing partner abandons the ping-pong instead of hanging.\n");
+
+    assert(c2c_round_trip(-1, -1, 50, NULL) > 0.0);
+    atomic_int stopped;
+    atomic_init(&stopped, 0);
+    assert(c2c_round_trip(-1, -1, 50000, &stopped) < 0.0);
+    printf("  - PASSED: The round trip is measured, and stops when running is cleared.\n");
+
+    int cpus[4] = { 0, 1, 8, 9 }, package[4] = { 0, 0, 1, 1 };
+    assert(c2c_create(cpus, package, 0) == NULL);
+    c2c_result_t *r = c2c_create(cpus, package, 4);
+    assert(r != NULL && r->n == 4 && r->package[2] == 1);
+    const double ns[4][4] = { { 0, 40, 120, 130 }, { 40, 0, 140, 110 }, { 120, 140, 0, 50 }, { 130, 110, 50, 0 } };
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) r->ns[i * 4 + j] = ns[i][j];
+    }
+    c2c_stats_t st;
+    c2c_summarize(r, &st);
+    assert(st.min == 40 && st.max == 140 && st.worst_a == 1 && st.worst_b == 8);
+    assert(st.same_socket == 45 && st.cross_socket == 125);
+    r->ns[1 * 4 + 2] = r->ns[2 * 4 + 1] = 0.0;
+    c2c_summarize(r, &st);
+    assert(st.max == 130 && st.worst_a == 0 && st.worst_b == 9);
+    free(r);
+    printf("  - PASSED: The summary splits same-socket and cross-socket pairs and skips unmeasured ones.\n");
+}
@@ -0,0 +1,92 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "hardstress.h"
+#include "degrade.h"
+
+/**
+ * @brief Alimenta o analisador com uma amostra por segundo de `t0` a `t1`, com taxas fixas por worker.
+ * @return O número de eventos acumulados em `ev` (a partir de `n`).
+ */
+static int feed(degrade_t *d, int t0, int t1, const double *rates, double temp, int thermal,
+                degrade_event_t *ev, int n, int max) {
+    for (int t = t0; t <= t1; t++) {
+        for (int w = 0; w < d->threads; w++) {
+            d->progress[w] += (unsigned long long)(rates[w] * ITER_PROGRESS_SCALE);
+            d->temp_c[w] = temp;
+            d->mhz[w] = 3000.0;
+        }
+        n += degrade_update(d, t, thermal, 0, ev + n, max - n);
+    }
+    return n;
+}
+
+/**
+ * @brief Testa a detecção de degradação: núcleo mais lento que os pares, recuperação e limitação térmica.
+ */
+void test_degrade_events(void) {
+    printf("\n- Running test_degrade_events...\n");
+    degrade_event_t ev[32];
+    double rates[4] = {1000, 1000, 1000, 1000};
+
+    degrade_t *d = degrade_create(4, 5.0, 10.0);
+    assert(d != NULL);
+    int n = feed(d, 0, 9, rates, 60.0, 0, ev, 0, 32);
+    assert(n == 0 && d->ready && d->tracks[0].base > 999.0 && d->tracks[0].base_temp == 60.0);
+    printf("  - PASSED: A steady run closes the baseline without events.\n");
+
+    rates[3] = 500;
+    n = feed(d, 10, 19, rates, 60.0, 0, ev, 0, 32);
+    int peers = -1, self = -1;
+    for (int i = 0; i < n; i++) {
+        assert(ev[i].begin);
+        if (ev[i].scope == DEGRADE_PEERS) peers = i;
+        if (ev[i].scope == DEGRADE_SELF && ev[i].worker == 3) self = i;
+        assert(ev[i].worker == 3 || ev[i].worker == -1);
+    }
+    assert(peers >= 0 && ev[peers].cause == DEGRADE_CAUSE_CORE && ev[peers].ref == 1000.0);
+    assert(self >= 0 && ev[self].cause == DEGRADE_CAUSE_UNKNOWN && !degrade_is_throttle(ev[self].cause));
+    assert(ev[peers].t >= 10 + DEGRADE_HOLD_SAMPLES - 1);
+    char line[384];
+    degrade_format_event(&ev[peers], line, sizeof(line));
+    assert(strstr(line, "T3") && strstr(line, "núcleo lento"));
+    printf("  - PASSED: A slow worker at the same temperature is flagged against its baseline and its peers.\n");
+
+    rates[3] = 1000;
+    int open = degrade_open_count(d);
+    n = feed(d, 20, 39, rates, 60.0, 0, ev, 0, 32);
+    assert(n == open && degrade_open_count(d) == 0);
+    for (int i = 0; i < n; i++) assert(!ev[i].begin && ev[i].duration > 0.0);
+    printf("  - PASSED: Recovery closes every episode with its duration.\n");
+    degrade_free(d);
+
+    double all[4] = {1000, 1000, 1000, 1000};
+    d = degrade_create(4, 5.0, 10.0);
+    assert(d != NULL);
+    feed(d, 0, 9, all, 60.0, 0, ev, 0, 32);
+    for (int w = 0; w < 4; w++) all[w] = 800;
+    n = feed(d, 10, 19, all, 90.0, 2, ev, 0, 32);
+    assert(n == 5);
+    for (int i = 0; i < n; i++) {
+        assert(ev[i].scope == DEGRADE_SELF && ev[i].cause == DEGRADE_CAUSE_THERMAL && degrade_is_throttle(ev[i].cause));
+    }
+    printf("  - PASSED: A uniform slowdown with thermal throttling is attributed to it, without peer outliers.\n");
+    degrade_free(d);
+
+    // Dois papéis com taxas diferentes: cada worker só é comparado com o próprio grupo.
+    double mixed[6] = {1000, 1000, 1000, 200, 200, 200};
+    d = degrade_create(6, 5.0, 10.0);
+    assert(d != NULL);
+    for (int w = 3; w < 6; w++) d->group[w] = 1;
+    n = feed(d, 0, 19, mixed, 60.0, 0, ev, 0, 32);
+    assert(n == 0);
+    mixed[5] = 100;
+    n = feed(d, 20, 29, mixed, 60.0, 0, ev, 0, 32);
+    peers = -1;
+    for (int i = 0; i < n; i++) {
+        if (ev[i].scope == DEGRADE_PEERS) peers = i;
+    }
+    assert(peers >= 0 && ev[peers].worker == 5 && ev[peers].ref == 200.0);
+    printf("  - PASSED: Workers with different roles are only compared with peers of the same role.\n");
+    degrade_free(d);
+}
@@ -0,0 +1,177 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include "hardstress.h"
+#include "core.h"
+#include "headless.h"
+#include "utils.h"
+#include "fleet.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+static fleet_socket_t g_listener = FLEET_BAD_SOCKET;
+static fleet_agent_policy_t g_policy;
+
+static thread_return_t THREAD_CALL agent_thread(void *arg){
+    int *rc = (int*)arg;
+    *rc = fleet_agent_serve(g_listener, 5.0, &g_policy);
+    return 0;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Executa uma sessão entre o coordenador de `app` e um agente local na porta `port`.
+ * @return O código devolvido pelo agente.
+ */
+static int run_session(AppContext *app, int port){
+    int agent_rc = -1;
+    app->fleet->nodes[0].port = port;
+    app->fleet->lead_sec = 0.3;
+    thread_handle_t agent;
+    assert(thread_create(&agent, agent_thread, &agent_rc) == 0);
+    fleet_coordinator_thread_func(app);
+    thread_join(agent);
+    return agent_rc;
+}
+#endif
+
+/**
+ * @brief Testa o protocolo da frota e uma sessão completa entre o coordenador e um agente local.
+ */
+void test_fleet(void) {
+    printf("\n- Running test_fleet...\n");
+    unsigned char buf[FLEET_HEADER_BYTES + FLEET_SAMPLE_PAYLOAD];
+    int type;
+    size_t len;
+    fleet_frame_header(buf, FLEET_MSG_SAMPLE, FLEET_SAMPLE_PAYLOAD);
+    assert(fleet_frame_parse(buf, FLEET_HEADER_BYTES - 1, &type, &len) == 0);
+    assert(fleet_frame_parse(buf, FLEET_HEADER_BYTES + 10, &type, &len) == 0);
+    assert(fleet_frame_parse(buf, sizeof(buf), &type, &len) == (long)sizeof(buf));
+    assert(type == FLEET_MSG_SAMPLE && len == FLEET_SAMPLE_PAYLOAD);
+    buf[3] = 0;
+    assert(fleet_frame_parse(buf, sizeof(buf), &type, &len) == -1);
+    fleet_frame_header(buf, FLEET_MSG_STOP, FLEET_MAX_PAYLOAD + 1);
+    assert(fleet_frame_parse(buf, FLEET_HEADER_BYTES, &type, &len) == -1);
+    buf[0] = 'X';
+    assert(fleet_frame_parse(buf, FLEET_HEADER_BYTES, &type, &len) == -1);
+    printf("  - PASSED: Frames are split by length, and bad magic, types or sizes are rejected.\n");
+
+    fleet_sample_t in = { 1234, 12.3456, { 1500.0, 12.5, 3.25, 40.0, 180.0, 0.0 }, 71.26, 0.9731, 3412.0, 7 }, out;
+    fleet_sample_encode(&in, buf);
+    fleet_sample_decode(buf, &out);
+    assert(out.seq == 1234 && out.errors == 7 && out.freq_mhz == 3412.0);
+    assert(fabs(out.elapsed - 12.346) < 1e-9);
+    for (int m = 0; m < THREAD_METRIC_COUNT; m++) assert(fabs(out.rate[m] - in.rate[m]) <= in.rate[m] * 1e-6);
+    assert(fabs(out.temp_c - 71.3) < 1e-9 && fabs(out.cpu_usage - 0.9731) < 1e-9);
+    in.temp_c = TEMP_UNAVAILABLE;
+    fleet_sample_encode(&in, buf);
+    fleet_sample_decode(buf, &out);
+    assert(out.temp_c == TEMP_UNAVAILABLE);
+    printf("  - PASSED: Samples survive the wire format within its resolution.\n");
+
+    char err[160];
+    fleet_t *f = fleet_create("node1, node2:9000 [::1]:7000,10.0.0.5", err, sizeof(err));
+    assert(f != NULL && f->n == 4);
+    assert(strcmp(f->nodes[0].host, "node1") == 0 && f->nodes[0].port == FLEET_DEFAULT_PORT);
+    assert(strcmp(f->nodes[1].host, "node2") == 0 && f->nodes[1].port == 9000);
+    assert(strcmp(f->nodes[2].host, "::1") == 0 && f->nodes[2].port == 7000);
+    assert(strcmp(f->nodes[3].name, "10.0.0.5") == 0 && f->nodes[3].sock == FLEET_BAD_SOCKET);
+    fleet_free(f);
+    fleet_free(NULL);
+    assert(fleet_create("", err, sizeof(err)) == NULL && err[0] != '\0');
+    assert(fleet_create("node1:0", err, sizeof(err)) == NULL);
+    assert(fleet_create("node1:70000", err, sizeof(err)) == NULL);
+    assert(fleet_create("[::1", err, sizeof(err)) == NULL);
+    printf("  - PASSED: Node lists are parsed, with default ports and IPv6 brackets, and bad entries rejected.\n");
+
+    AppContext *app = app_context_create();
+    assert(app != NULL);
+    app->headless = 1;
+    app->threads = 1;
+    app->mem_mib_per_thread = 8;
+    app->duration_sec = 1;
+    app->sample_interval_ms = 100;
+    app->kernel_fpu_en = app->kernel_int_en = 1;
+    app->kernel_stream_en = app->kernel_ptr_en = app->kernel_atomic_en = 0;
+    app->pin_affinity = 0;
+    app->jitter_en = 1;
+    app->jitter_interval_us = 500;
+    f = app->fleet = fleet_create("127.0.0.1", err, sizeof(err));
+    assert(f != NULL);
+    int args_len = fleet_config_args(app, f->args, sizeof(f->args));
+    assert(args_len > 0 && f->args[args_len - 1] == '\0');
+    assert(fleet_config_args(app, f->args, 8) == -1);
+    f->args_len = (size_t)args_len;
+
+    // Os argumentos gerados devem reproduzir a configuração no agente.
+    char *argv[64] = { "HardStress" };
+    int argc = 1;
+    for (int off = 0; off < args_len && argc < 64; off += (int)strlen(f->args + off) + 1) argv[argc++] = f->args + off;
+    AppContext parsed = {0};
+    assert(headless_parse_args(&parsed, argc, argv) == 0);
+    assert(parsed.threads == 1 && parsed.mem_mib_per_thread == 8 && parsed.duration_sec == 1);
+    assert(parsed.sample_interval_ms == 100 && parsed.pin_affinity == 0);
+    assert(parsed.kernel_fpu_en && parsed.kernel_int_en && !parsed.kernel_stream_en && !parsed.kernel_ptr_en);
+    assert(parsed.jitter_en && parsed.jitter_interval_us == 500);
+    printf("  - PASSED: The configuration is sent as arguments the agent parses back to the same test.\n");
+
+#ifndef _WIN32
+    // No Windows a pilha de rede só é iniciada pela thread coordenadora; a sessão completa é testada no Linux.
+    app->jitter_en = 0;
+    f->args_len = (size_t)fleet_config_args(app, f->args, sizeof(f->args));
+    snprintf(f->token, sizeof(f->token), "segredo");
+    g_policy.token = "segredo";
+    int port = 0;
+    g_listener = fleet_listen("127.0.0.1", 0, &port, err, sizeof(err));
+    assert(g_listener != FLEET_BAD_SOCKET && port > 0);
+    int agent_rc = run_session(app, port);
+    const fleet_node_t *node = &f->nodes[0];
+    printf("  - Node %s: %llu samples, %llu iterations in %.2f s, start %+.0f ms\n",
+           node->name, node->samples, node->total_iters, node->seconds, node->start_late_ms);
+    assert(agent_rc == 0 && node->state == FLEET_NODE_DONE && node->exit_code == 0);
+    assert(node->samples > 0 && node->total_iters > 0 && node->seconds > 0.5);
+    assert(f->max_seq >= node->last.seq && node->ring[node->last.seq % HISTORY_SAMPLES].seq == node->last.seq);
+    assert(atomic_load(&app->errors) == 0 && !atomic_load(&app->running));
+    printf("  - PASSED: A local agent starts at the agreed instant, streams samples and reports its summary.\n");
+
+    // Token errado, opções fora da lista e alvos de --io fora do diretório liberado terminam em um quadro de erro.
+    char io_dir[] = "/tmp/hardstress-fleet-XXXXXX", escape[64];
+    assert(mkdtemp(io_dir) != NULL);
+    snprintf(escape, sizeof(escape), "%s/../hardstress-fleet-escape", io_dir);
+    g_policy.io_dir = io_dir;
+    const struct { const char *token, *opt, *val, *expect; } refused[] = {
+        { "errado", NULL, NULL, "Token da frota" },
+        { "segredo", "--export", "/tmp/hardstress-fleet.csv", "--export" },
+        { "segredo", "--io-destructive", NULL, "--io-destructive" },
+        { "segredo", "--io", "/etc/passwd", "/etc/passwd" },
+        { "segredo", "--io", escape, "fora do diretório" },
+    };
+    for (size_t c = 0; c < sizeof(refused) / sizeof(refused[0]); c++) {
+        fleet_t *bad = app->fleet = fleet_create("127.0.0.1", err, sizeof(err));
+        assert(bad != NULL);
+        snprintf(bad->token, sizeof(bad->token), "%s", refused[c].token);
+        memcpy(bad->args, f->args, f->args_len);
+        bad->args_len = f->args_len;
+        for (int a = 0; a < 2; a++) {
+            const char *extra = a == 0 ? refused[c].opt : refused[c].val;
+            if (!extra) continue;
+            memcpy(bad->args + bad->args_len, extra, strlen(extra) + 1);
+            bad->args_len += strlen(extra) + 1;
+        }
+        assert(run_session(app, port) == 1);
+        assert(bad->nodes[0].state == FLEET_NODE_FAILED && strstr(bad->nodes[0].error, refused[c].expect) != NULL);
+        assert(bad->nodes[0].samples == 0);
+        fleet_free(bad);
+    }
+    assert(access("/tmp/hardstress-fleet.csv", F_OK) != 0 && access(escape, F_OK) != 0);
+    rmdir(io_dir);
+    app->fleet = f;
+    fleet_socket_close(g_listener);
+    printf("  - PASSED: The agent refuses a wrong token, options outside the allowlist and --io outside --io-dir.\n");
+#endif
+    app_context_free(app);
+    fleet_free(f);
+}
@@ -0,0 +1,115 @@
+#include <assert.h>
+#include <stdio.h>
+#include "hardstress.h"
+#include "headless.h"
+#include "metrics.h"
+#include "telemetry.h"
+#include <string.h>
+
+/**
+ * @brief Testa a análise dos argumentos de linha de comando do modo headless.
+ */
+void test_headless_parse_args(void) {
+    printf("\n- Running test_headless_parse_args...\n");
+
+    AppContext app = {0};
+    app.mem_mib_per_thread = DEFAULT_MEM_MIB;
+    app.duration_sec = DEFAULT_DURATION_SEC;
+    app.pin_affinity = 1;
+    char *argv_ok[] = {"HardStress", "--headless", "-t", "2", "--mem", "64", "-d", "10", "-k", "fpu,ptr", "--no-pin", "--numa", "remote", "--pages", "2m", "--fp-block", "32", "--ptr-chains", "8", "--stream-nt", "--stream-prefetch", "512", "--perf", "--interval", "100", "--export", "run.csv", "--export-format", "jsonl", "--degrade-baseline", "30", "--degrade-pct", "15", "--profile", "square:50", "--roles", "fpu=0;ptr=1", "--sweep-max", "256"};
+    assert(headless_parse_args(&app, 39, argv_ok) == 0);
+    assert(app.threads == 2);
+    assert(app.mem_mib_per_thread == 64);
+    assert(app.duration_sec == 10);
+    assert(app.pin_affinity == 0);
+    assert(app.numa_mode == NUMA_MODE_REMOTE);
+    assert(app.page_mode == PAGE_MODE_HUGE_2M);
+    assert(app.fp_block_kib == 32);
+    assert(app.ptr_chains == 8);
+    assert(app.stream_nt == 1 && app.stream_prefetch == 512);
+    assert(app.perf_en == 1);
+    assert(app.sample_interval_ms == 100);
+    assert(app.degrade_baseline_sec == 30 && app.degrade_pct == 15);
+    assert(strcmp(app.load_profile, "square:50") == 0);
+    assert(strcmp(app.worker_roles, "fpu=0;ptr=1") == 0);
+    assert(app.sweep_max_mib == 256);
+    assert(strcmp(app.export_path, "run.csv") == 0 && app.export_format == TELEMETRY_JSONL);
+    assert(app.kernel_fpu_en && app.kernel_ptr_en);
+    assert(!app.kernel_int_en && !app.kernel_stream_en);
+    printf("  - PASSED: Valid arguments are applied to the context.\n");
+
+    AppContext defaults = {0};
+    char *argv_auto[] = {"HardStress", "--headless"};
+    assert(headless_parse_args(&defaults, 2, argv_auto) == 0);
+    assert(defaults.threads == detect_cpu_count());
+    assert(defaults.kernel_fpu_en && defaults.kernel_int_en && defaults.kernel_stream_en && defaults.kernel_ptr_en);
+    assert(defaults.export_path[0] == '\0');
+    assert(defaults.sweep_max_mib == 0);
+    assert(!defaults.kernel_atomic_en && !defaults.c2c_en);
+    printf("  - PASSED: Missing options fall back to auto threads and all kernels.\n");
+
+    AppContext coherence = {0};
+    char *argv_atomic[] = {"HardStress", "--headless", "-t", "2", "-k", "ptr,atomic", "--c2c"};
+    assert(headless_parse_args(&coherence, 7, argv_atomic) == 0);
+    assert(coherence.kernel_atomic_en && coherence.kernel_ptr_en && !coherence.kernel_fpu_en && coherence.c2c_en);
+    char *argv_all[] = {"HardStress", "--headless", "-k", "all"};
+    assert(headless_parse_args(&coherence, 4, argv_all) == 0);
+    assert(coherence.kernel_atomic_en && coherence.kernel_fpu_en);
+    printf("  - PASSED: The atomic kernel is opt-in, selected by name or by 'all'.\n");
+
+    AppContext io = {0};
+    char *argv_io[] = {"HardStress", "--headless", "--io", "/tmp", "--io-size", "64", "--io-qd", "8", "--io-bs", "16", "--io-read", "0", "--io-destructive"};
+    assert(headless_parse_args(&io, 13, argv_io) == 0);
+    assert(strcmp(io.io_path, "/tmp") == 0 && io.io_file_mib == 64 && io.io_qd == 8);
+    assert(io.io_block_kib == 16 && io.io_read_pct == 0 && io.io_destructive == 1);
+    printf("  - PASSED: Storage I/O options are applied to the context.\n");
+
+    AppContext jitter = {0};
+    char *argv_jitter[] = {"HardStress", "--headless", "--jitter-us", "250"};
+    assert(headless_parse_args(&jitter, 4, argv_jitter) == 0);
+    assert(jitter.jitter_en == 1 && jitter.jitter_interval_us == 250);
+    printf("  - PASSED: --jitter-us enables the jitter probe with its interval.\n");
+
+    AppContext verify = {0};
+    char *argv_verify[] = {"HardStress", "--headless", "-k", "stream", "--verify"};
+    assert(headless_parse_args(&verify, 5, argv_verify) == 0);
+    assert(verify.verify_en == 1 && verify.kernel_stream_en == 1);
+    printf("  - PASSED: --verify enables memory verification in the stream kernel.\n");
+
+    AppContext bad = {0};
+    char *argv_kernel[] = {"HardStress", "--headless", "-k", "fpu,gpu"};
+    assert(headless_parse_args(&bad, 4, argv_kernel) == -1);
+    char *argv_threads[] = {"HardStress", "--headless", "-t", "-3"};
+    assert(headless_parse_args(&bad, 4, argv_threads) == -1);
+    char *argv_interval[] = {"HardStress", "--headless", "--interval", "10"};
+    assert(headless_parse_args(&bad, 4, argv_interval) == -1);
+    char *argv_degrade[] = {"HardStress", "--headless", "--degrade-pct", "0"};
+    assert(headless_parse_args(&bad, 4, argv_degrade) == -1);
+    char *argv_profile[] = {"HardStress", "--headless", "--profile", "ramp:10:100"};
+    assert(headless_parse_args(&bad, 4, argv_profile) == -1);
+    char *argv_roles[] = {"HardStress", "--headless", "-t", "2", "--roles", "fpu=0-3"};
+    assert(headless_parse_args(&bad, 6, argv_roles) == -1);
+    char *argv_sweep[] = {"HardStress", "--headless", "--sweep-max", "0"};
+    assert(headless_parse_args(&bad, 4, argv_sweep) == -1);
+    char *argv_c2c[] = {"HardStress", "--headless", "--c2c", "--sweep"};
+    assert(headless_parse_args(&bad, 4, argv_c2c) == -1);
+    char *argv_io_bs[] = {"HardStress", "--headless", "--io", "/tmp", "--io-bs", "6"};
+    assert(headless_parse_args(&bad, 6, argv_io_bs) == -1);
+    char *argv_io_sweep[] = {"HardStress", "--headless", "--io", "/tmp", "--sweep"};
+    assert(headless_parse_args(&bad, 5, argv_io_sweep) == -1);
+    char *argv_jitter_us[] = {"HardStress", "--headless", "--jitter-us", "10"};
+    assert(headless_parse_args(&bad, 4, argv_jitter_us) == -1);
+    char *argv_jitter_c2c[] = {"HardStress", "--headless", "--jitter", "--c2c"};
+    assert(headless_parse_args(&bad, 4, argv_jitter_c2c) == -1);
+    char *argv_verify_fpu[] = {"HardStress", "--headless", "-k", "fpu", "--verify"};
+    assert(headless_parse_args(&bad, 5, argv_verify_fpu) == -1);
+    char *argv_verify_sweep[] = {"HardStress", "--headless", "--verify", "--sweep"};
+    assert(headless_parse_args(&bad, 4, argv_verify_sweep) == -1);
+    char *argv_export[] = {"HardStress", "--headless", "--export", "run.txt", "--export-format", "xml"};
+    assert(headless_parse_args(&bad, 6, argv_export) == -1);
+    char *argv_missing[] = {"HardStress", "--headless", "-d"};
+    assert(headless_parse_args(&bad, 3, argv_missing) == -1);
+    char *argv_help[] = {"HardStress", "--headless", "--help"};
+    assert(headless_parse_args(&bad, 3, argv_help) == 1);
+    printf("  - PASSED: Invalid arguments are rejected.\n");
+}
@@ -0,0 +1,69 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "hardstress.h"
+#include "heatmap.h"
+
+/**
+ * @brief Grava uma amostra no histórico como a thread de amostragem faria.
+ */
+static void push_sample(AppContext *app, double when, unsigned long long progress0, unsigned long long progress1) {
+    app->history_pos = (app->history_pos + 1) % app->history_len;
+    app->history_time[app->history_pos] = when;
+    app->thread_history[0][app->history_pos].v[THREAD_METRIC_PROGRESS] = progress0;
+    app->thread_history[1][app->history_pos].v[THREAD_METRIC_PROGRESS] = progress1;
+    app->thread_history[0][app->history_pos].v[THREAD_METRIC_FLOPS] = progress0 * 2;
+    app->history_seq++;
+}
+
+/**
+ * @brief Testa o cache incremental do heatmap: colunas novas, tempo real entre amostras e reconstruções.
+ */
+void test_heatmap_incremental(void) {
+    printf("\n- Running test_heatmap_incremental...\n");
+    enum { LEN = 8 };
+    AppContext app = {0};
+    app.threads = 2;
+    app.history_len = LEN;
+    app.history_time = calloc(LEN, sizeof(double));
+    app.thread_history = calloc(2, sizeof(thread_sample_t*));
+    app.thread_history[0] = calloc(LEN, sizeof(thread_sample_t));
+    app.thread_history[1] = calloc(LEN, sizeof(thread_sample_t));
+
+    heatmap_t *h = heatmap_create(2, LEN);
+    assert(h != NULL);
+    assert(heatmap_update(h, &app, THREAD_METRIC_PROGRESS, 1.0) == LEN);
+    assert(h->active[0] == 0 && h->active[1] == 0);
+
+    // T0 advances 100 units per second; the second interval is twice as long, so the rate stays equal.
+    push_sample(&app, 10.0, 0, 0);
+    push_sample(&app, 11.0, 100, 0);
+    push_sample(&app, 13.0, 300, 0);
+    assert(heatmap_update(h, &app, THREAD_METRIC_PROGRESS, 1.0) == 3);
+    assert(h->values[0 * LEN + 1] < 0.0); // the first sample has no predecessor
+    assert(h->values[0 * LEN + 2] == 100.0 && h->values[0 * LEN + 3] == 100.0);
+    assert(h->values[1 * LEN + 3] == 0.0);
+    assert(h->active[0] == 2 && h->active[1] == 0);
+    assert(h->pixels[0 * LEN + 1] == h->pixels[0 * LEN + 5]); // both empty cells use the background
+    printf("  - PASSED: New columns use the real time between samples; missing samples stay empty.\n");
+
+    unsigned long long repaints = h->repaints;
+    push_sample(&app, 14.0, 400, 0);
+    assert(heatmap_update(h, &app, THREAD_METRIC_PROGRESS, 1.0) == 1);
+    assert(heatmap_update(h, &app, THREAD_METRIC_PROGRESS, 1.0) == 0);
+    assert(h->repaints == repaints && h->active[0] == 3);
+    printf("  - PASSED: A sample within the color scale recomputes and repaints only its column.\n");
+
+    assert(heatmap_update(h, &app, THREAD_METRIC_FLOPS, 1e-2) == LEN);
+    assert(h->values[0 * LEN + 4] == 2.0);
+    for (int i = 0; i < LEN; i++) push_sample(&app, 15.0 + i, 500 + 100 * i, 0);
+    assert(heatmap_update(h, &app, THREAD_METRIC_FLOPS, 1e-2) == LEN);
+    assert(h->active[0] == LEN - 1 && h->active[1] == 0); // the oldest column has no predecessor
+    printf("  - PASSED: A metric change or a full window of missed samples rebuilds every column.\n");
+
+    heatmap_free(h);
+    free(app.thread_history[0]);
+    free(app.thread_history[1]);
+    free(app.thread_history);
+    free(app.history_time);
+}
@@ -0,0 +1,41 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "hardstress.h"
+#include "history.h"
+
+/**
+ * @brief Testa o arquivo do histórico: buckets, fusão ao esgotar a capacidade e mínimo/máximo/média.
+ */
+void test_history_archive(void) {
+    printf("\n- Running test_history_archive...\n");
+    enum { RING = 4 };
+    thread_sample_t *ring[1];
+    ring[0] = calloc(RING, sizeof(thread_sample_t));
+    history_archive_t *a = history_archive_create(1);
+    assert(a != NULL && a->width == 1 && a->count == 0);
+
+    // T0 runs at 100/s on even samples and 300/s on odd ones, one sample per second.
+    unsigned long long progress = 0;
+    int samples = 3 * HISTORY_ARCHIVE_BUCKETS + 1;
+    for (int i = 0; i < samples; i++) {
+        if (i > 0) progress += (i % 2) ? 300 : 100;
+        ring[0][i % RING].v[THREAD_METRIC_PROGRESS] = progress;
+        history_archive_push(a, ring, i % RING, 1.0 + i);
+    }
+    assert(a->count == 3 * HISTORY_ARCHIVE_BUCKETS / 4 && a->width == 4 && a->pending == 0);
+    assert(a->count <= HISTORY_ARCHIVE_BUCKETS);
+    printf("  - PASSED: Full buckets are merged in pairs, keeping the archive bounded.\n");
+
+    for (int i = 0; i < a->count; i++) {
+        const history_bucket_t *b = history_archive_bucket(a, 0, i);
+        assert(b->min_rate[THREAD_METRIC_PROGRESS] == 100.0f);
+        assert(b->max_rate[THREAD_METRIC_PROGRESS] == 300.0f);
+        assert(history_archive_avg(a, 0, i, THREAD_METRIC_PROGRESS) == 200.0);
+    }
+    assert(a->end_time[a->count - 1] - a->start_time == (double)(samples - 1));
+    printf("  - PASSED: Each bucket keeps the min, max and average rate of its samples.\n");
+
+    history_archive_free(a);
+    free(ring[0]);
+}
@@ -0,0 +1,108 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "hardstress.h"
+#include "hwmon.h"
+#include "test_sysfs.h"
+
+/**
+ * @brief Testa a descoberta e a leitura de sensores em uma árvore sysfs sintética.
+ */
+void test_temp_sensors_sysfs(void) {
+    printf("\n- Running test_temp_sensors_sysfs...\n");
+#ifndef _WIN32
+    char root[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(root) != NULL);
+    write_file(root, "class/hwmon/hwmon0/name", "acpitz\n");
+    write_file(root, "class/hwmon/hwmon0/temp1_input", "27800\n");
+    write_file(root, "class/hwmon/hwmon2/name", "coretemp\n");
+    write_file(root, "class/hwmon/hwmon2/temp1_label", "Package id 0\n");
+    write_file(root, "class/hwmon/hwmon2/temp1_input", "61000\n");
+    write_file(root, "class/hwmon/hwmon2/temp2_label", "Core 0\n");
+    write_file(root, "class/hwmon/hwmon2/temp2_input", "58000\n");
+    write_file(root, "class/hwmon/hwmon2/temp3_label", "Core 1\n");
+    write_file(root, "class/hwmon/hwmon2/temp3_input", "\n");
+    write_file(root, "class/thermal/thermal_zone0/type", "x86_pkg_temp\n");
+    write_file(root, "class/thermal/thermal_zone0/temp", "60000\n");
+
+    temp_sensors_t *ts = temp_sensors_open(root);
+    assert(ts != NULL);
+    assert(ts->count == 5 && ts->core_count == 2);
+    assert(strcmp(ts->sensors[0].label, "acpitz temp1") == 0);
+    assert(strcmp(ts->sensors[1].label, "coretemp Package id 0") == 0);
+    assert(strcmp(ts->sensors[2].label, "Core 0") == 0 && ts->sensors[2].is_core);
+    assert(strcmp(ts->sensors[4].label, "thermal x86_pkg_temp") == 0);
+    assert(ts->primary == 2);
+    printf("  - PASSED: hwmon and thermal sensors are discovered in order, with the first core as primary.\n");
+
+    assert(temp_sensors_read(ts) == 4);
+    assert(ts->values[0] == 27.8 && ts->values[2] == 58.0 && ts->values[4] == 60.0);
+    assert(ts->values[3] == TEMP_UNAVAILABLE);
+    printf("  - PASSED: Readings are converted from millidegrees; unreadable sensors are flagged.\n");
+
+    write_file(root, "class/hwmon/hwmon2/temp2_input", "71500\n");
+    assert(temp_sensors_read(ts) == 4);
+    assert(ts->values[2] == 71.5);
+    printf("  - PASSED: Each read re-reads the open descriptors from the start.\n");
+    temp_sensors_close(ts);
+
+    char empty[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(empty) != NULL);
+    assert(temp_sensors_open(empty) == NULL);
+    printf("  - PASSED: A tree without sensors yields no sensor set.\n");
+
+    remove_tree(root);
+    remove_tree(empty);
+#else
+    assert(temp_sensors_open(NULL) == NULL);
+    printf("  - PASSED: No sysfs sensors on Windows.\n");
+#endif
+}
+
+/**
+ * @brief Testa a leitura de frequência e dos contadores de limitação em uma árvore sysfs sintética.
+ */
+void test_cpu_freq_sysfs(void) {
+    printf("\n- Running test_cpu_freq_sysfs...\n");
+#ifndef _WIN32
+    char root[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(root) != NULL);
+    write_file(root, "devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", "2400000\n");
+    write_file(root, "devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq", "3600000\n");
+    write_file(root, "devices/system/cpu/cpu0/thermal_throttle/core_throttle_count", "5\n");
+    write_file(root, "devices/system/cpu/cpu0/thermal_throttle/package_power_limit_count", "0\n");
+    write_file(root, "devices/system/cpu/cpu1/cpufreq/scaling_cur_freq", "800000\n");
+    write_file(root, "devices/system/cpu/cpu1/cpufreq/cpuinfo_max_freq", "4000000\n");
+
+    cpu_freq_t *cf = cpu_freq_open(root, 3);
+    assert(cf != NULL);
+    assert(cf->cur_count == 2 && cf->msr_count == 0 && cf->throttle_count == 1);
+    assert(cf->max_mhz == 4000.0);
+    printf("  - PASSED: cpufreq and thermal_throttle files are discovered per CPU; fake roots skip MSRs.\n");
+
+    assert(cpu_freq_read(cf) == 2);
+    assert(cf->mhz[0] == 2400.0 && cf->mhz[1] == 800.0 && cf->mhz[2] == 0.0);
+    assert(cf->thermal_cpus == 0 && cf->power_cpus == 0);
+    printf("  - PASSED: scaling_cur_freq is converted from kHz; counters start from their opening value.\n");
+
+    write_file(root, "devices/system/cpu/cpu0/thermal_throttle/core_throttle_count", "7\n");
+    write_file(root, "devices/system/cpu/cpu0/thermal_throttle/package_power_limit_count", "1\n");
+    assert(cpu_freq_read(cf) == 2);
+    assert(cf->thermal_cpus == 1 && cf->power_cpus == 1);
+    assert(cpu_freq_read(cf) == 2);
+    assert(cf->thermal_cpus == 0 && cf->power_cpus == 0);
+    printf("  - PASSED: A CPU counts as throttled only in the interval its counters advanced.\n");
+    cpu_freq_close(cf);
+
+    char empty[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(empty) != NULL);
+    assert(cpu_freq_open(empty, 2) == NULL);
+    printf("  - PASSED: A tree without cpufreq or throttle files yields no reader.\n");
+
+    remove_tree(root);
+    remove_tree(empty);
+#else
+    assert(cpu_freq_open(NULL, 1) == NULL);
+    printf("  - PASSED: No frequency sampling on Windows.\n");
+#endif
+}
@@ -0,0 +1,50 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "hardstress.h"
+#include "utils.h"
+#include "jitter.h"
+
+/**
+ * @brief Testa a criação das sondas de jitter, a amostragem por intervalo e os totais do teste.
+ */
+void test_jitter(void) {
+    printf("\n- Running test_jitter...\n");
+    atomic_int running;
+    atomic_init(&running, 1);
+    int cpus[2] = { 0, 0 };
+    assert(jitter_create(cpus, 0, JITTER_DEFAULT_INTERVAL_US, &running) == NULL);
+    assert(jitter_create(cpus, 2, JITTER_MIN_INTERVAL_US - 1, &running) == NULL);
+    assert(jitter_create(cpus, 2, JITTER_MAX_INTERVAL_US + 1, &running) == NULL);
+    printf("  - PASSED: Invalid probe counts and intervals are rejected.\n");
+
+    jitter_t *j = jitter_create(cpus, 2, 1000, &running);
+    assert(j != NULL && j->n == 2);
+    jitter_result_t *r = jitter_result_create(j);
+    assert(r != NULL && r->n == 2 && r->all.cpu == -1 && r->cpu[1].cpu == 0 && r->interval_us == 1000.0);
+    assert(jitter_start(j) == 2);
+    sleep_until(now_sec() + 0.1);
+    jitter_sample(j, r);
+    for (int i = 0; i < 2; i++) {
+        assert(r->cpu[i].wakeups > 10 && r->cpu[i].wakeups <= 110);
+        assert(r->cpu[i].p50_us <= r->cpu[i].p99_us && r->cpu[i].p99_us <= r->cpu[i].p999_us);
+        assert(r->cpu[i].p999_us <= r->cpu[i].max_us);
+    }
+    assert(r->all.wakeups == r->cpu[0].wakeups + r->cpu[1].wakeups);
+    printf("  - %d probe(s) at real-time priority, p99 %.1f µs\n", r->realtime, r->all.p99_us);
+    printf("  - PASSED: Each probe wakes up about once per interval and the sample merges them.\n");
+
+    atomic_store(&running, 0);
+    jitter_join(j);
+    jitter_totals(j, r);
+    assert(r->all.wakeups == atomic_load(&j->probes[0].wakeups) + atomic_load(&j->probes[1].wakeups));
+    unsigned long long m0 = atomic_load(&j->probes[0].max_ns), m1 = atomic_load(&j->probes[1].max_ns);
+    assert(r->all.max_us == (double)(m0 > m1 ? m0 : m1) / 1e3);
+    // O máximo é exato; os percentis são o limite superior do bucket, até 1/16 acima do valor.
+    assert(r->all.p999_us <= r->all.max_us * (1.0 + 1.0 / (1 << LAT_HIST_SUB_BITS)) + 1e-3);
+    assert(atomic_load(&j->probes[0].pinned) == 1);
+    free(r);
+    jitter_destroy(j);
+    jitter_destroy(NULL);
+    printf("  - PASSED: Probes stop with running, and the totals carry the exact maximum.\n");
+}
@@ -0,0 +1,187 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hardstress.h"
+#include "kernels.h"
+#include "utils.h"
+
+/**
+ * @brief Testa que todas as implementações do motor de ponto flutuante são estáveis e contam FLOPs como a escalar.
+ */
+void test_fp_engines_agree(void) {
+    printf("\n- Running test_fp_engines_agree...\n");
+    const fp_engine_t *scalar = fp_engine_get(FP_ISA_SCALAR);
+    assert(scalar != NULL);
+    const fp_engine_t *best = fp_engine_select();
+    assert(best != NULL && best->lanes >= 1);
+    printf("  - INFO: Selected FP engine: %s\n", best->name);
+
+    double ref[FP_CHAINS * 8];
+    fp_state_init(ref);
+    uint64_t ref_flops = scalar->chain(ref);
+    assert(ref_flops == (uint64_t)FP_CHAIN_REPS * FP_CHAINS * 2);
+
+    for (int isa = 0; isa < FP_ISA_COUNT; isa++) {
+        const fp_engine_t *e = fp_engine_get(isa);
+        if (!e) continue;
+        double state[FP_CHAINS * 8];
+        fp_state_init(state);
+        uint64_t flops = e->chain(state);
+        assert(flops == ref_flops * (uint64_t)e->lanes);
+        // As cadeias se aproximam do ponto fixo 1.0 sem ultrapassá-lo nem divergir;
+        // FMA e mul+add diferem só no arredondamento.
+        double init[FP_CHAINS * 8];
+        fp_state_init(init);
+        for (int i = 0; i < FP_CHAINS * e->lanes; i++) {
+            assert(isfinite(state[i]) && state[i] >= 1.0 && state[i] < init[i]);
+        }
+    }
+    printf("  - PASSED: Every supported engine stays bounded and reports lanes * chains * 2 FLOPs per rep.\n");
+
+    const size_t n = 4 * FP_BLOCK_ALIGN_ELEMS;
+    double *x = aligned_calloc(2 * n, sizeof(double), CACHE_LINE_SIZE);
+    assert(x != NULL);
+    double *y = x + n;
+    for (size_t i = 0; i < n; i++) x[i] = (double)i / n;
+    uint64_t flops = best->block(x, y, n, FP_BLOCK_PASSES);
+    assert(flops == (uint64_t)FP_BLOCK_PASSES * n * 2);
+    for (size_t i = 0; i < n; i++) assert(fabs(y[i] - 2.0 * x[i]) < 1e-9);
+    printf("  - PASSED: Cache-resident block converges to y = 2x.\n");
+
+    // Fatiar as passagens em quanta (como faz o worker) deve dar exatamente o mesmo resultado.
+    double *expected = aligned_calloc(n, sizeof(double), CACHE_LINE_SIZE);
+    assert(expected != NULL);
+    memset(y, 0, n * sizeof(double));
+    best->block(x, y, n, 5);
+    memcpy(expected, y, n * sizeof(double));
+    memset(y, 0, n * sizeof(double));
+    assert(best->block(x, y, n / 2, 2) == 2 * (n / 2) * 2);
+    best->block(x + n / 2, y + n / 2, n / 2, 2);
+    best->block(x, y, n, 3);
+    assert(memcmp(expected, y, n * sizeof(double)) == 0);
+    aligned_free(expected);
+    aligned_free(x);
+    printf("  - PASSED: Splitting block passes into quanta is bit-identical to one call.\n");
+}
+
+/**
+ * @brief Testa o ciclo de perseguição de ponteiro e o espaçamento das cadeias paralelas.
+ */
+void test_ptrchase_chains(void) {
+    printf("\n- Running test_ptrchase_chains...\n");
+    const size_t nodes = 1024;
+    uint32_t *idx = calloc(nodes * PTR_STRIDE, sizeof(uint32_t));
+    assert(idx != NULL);
+    uint64_t seed = 42;
+    uint32_t pos[PTR_MAX_CHAINS] = {0};
+
+    ptrchase_build(idx, nodes, 1, pos, &seed);
+    uint32_t start = pos[0];
+    kernel_ptrchase(idx, pos, 1, nodes);
+    assert(pos[0] == start);
+    kernel_ptrchase(idx, pos, 1, nodes / 2);
+    assert(pos[0] != start);
+    printf("  - PASSED: A single chain returns to its start after exactly one full cycle.\n");
+
+    ptrchase_build(idx, nodes, 4, pos, &seed);
+    for (int k = 0; k < 4; k++) assert(pos[k] % PTR_STRIDE == 0);
+    // A cadeia k deve estar k * nodes/4 passos à frente da cadeia 0.
+    uint32_t p = pos[0];
+    for (int k = 1; k < 4; k++) {
+        for (size_t s = 0; s < nodes / 4; s++) p = idx[p];
+        assert(p == pos[k]);
+    }
+    uint32_t before[4];
+    memcpy(before, pos, sizeof(before));
+    kernel_ptrchase(idx, pos, 4, nodes);
+    assert(memcmp(before, pos, sizeof(before)) == 0);
+    printf("  - PASSED: Parallel chains are evenly spaced along the cycle and advance independently.\n");
+    free(idx);
+}
+
+/**
+ * @brief Testa o preenchimento por contador e o ciclo montado em blocos sobre vários baldes e janelas.
+ */
+void test_buffer_init(void) {
+    printf("\n- Running test_buffer_init...\n");
+    enum { N = 1003 };
+    uint64_t serial[N], filled[N], seed = 0x12340007;
+    for (int i = 0; i < N; i++) serial[i] = splitmix64(&seed);
+    fill_random_u64(filled, N, 0x12340007, 0);
+    assert(memcmp(serial, filled, sizeof(serial)) == 0);
+    fill_random_u64(filled, N - 501, 0x12340007, 501);
+    assert(memcmp(serial + 501, filled, (N - 501) * sizeof(uint64_t)) == 0);
+    double unit[N];
+    fill_random_unit(unit, N, 0x12340007);
+    for (int i = 0; i < N; i++) assert(unit[i] == (double)(serial[i] & 0xFFFF) / 65535.0);
+    printf("  - PASSED: The counter-based fill matches serial splitmix64, from any starting element.\n");
+
+    // Mais nós que um balde do embaralhamento em blocos.
+    const size_t nodes = 300000;
+    uint32_t *idx = calloc(nodes * PTR_STRIDE, sizeof(uint32_t));
+    uint8_t *seen = calloc(nodes, 1);
+    assert(idx != NULL && seen != NULL);
+    uint32_t pos[PTR_MAX_CHAINS];
+    seed = 7;
+    ptrchase_build(idx, nodes, 3, pos, &seed);
+    uint32_t p = pos[0];
+    for (size_t s = 0; s < nodes; s++) {
+        assert(p % PTR_STRIDE == 0 && p / PTR_STRIDE < nodes && !seen[p / PTR_STRIDE]);
+        seen[p / PTR_STRIDE] = 1;
+        if (s == nodes / 3) assert(p == pos[1]);
+        if (s == 2 * (nodes / 3)) assert(p == pos[2]);
+        p = idx[p];
+    }
+    assert(p == pos[0]);
+    printf("  - PASSED: The blocked builder yields one cycle through every node, with chains evenly spaced.\n");
+    free(seen);
+    free(idx);
+}
+
+/**
+ * @brief Testa os resultados e a contagem de bytes das quatro operações STREAM, com e sem stores não-temporais.
+ */
+void test_stream_ops(void) {
+    printf("\n- Running test_stream_ops...\n");
+    const size_t n = 1024;
+    double *a = aligned_calloc(n, sizeof(double), 64);
+    double *b = aligned_calloc(n, sizeof(double), 64);
+    double *c = aligned_calloc(n, sizeof(double), 64);
+    assert(a && b && c);
+
+    for (int nt = 0; nt <= 1; nt++) {
+        for (size_t i = 0; i < n; i++) { a[i] = 1.0; b[i] = 2.0; c[i] = 0.0; }
+        assert(kernel_stream(STREAM_COPY, a, b, c, n, nt, 256) == 16 * n);
+        assert(kernel_stream(STREAM_SCALE, a, b, c, n, nt, 256) == 16 * n);
+        assert(kernel_stream(STREAM_ADD, a, b, c, n, nt, 256) == 24 * n);
+        assert(kernel_stream(STREAM_TRIAD, a, b, c, n, nt, 0) == 24 * n);
+        // Copy: c = 1; Scale: b = 3; Add: c = 4; Triad: a = 3 + 3 * 4 = 15
+        for (size_t i = 0; i < n; i++) {
+            assert(c[i] == 4.0);
+            assert(b[i] == 3.0);
+            assert(a[i] == 15.0);
+        }
+    }
+    printf("  - PASSED: Copy/Scale/Add/Triad match the STREAM reference with %s non-temporal stores.\n",
+           stream_nt_supported() ? "and without" : "(unsupported, fallback)");
+
+    assert(stream_op_bytes(STREAM_COPY, 10) == 160 && stream_op_bytes(STREAM_TRIAD, 10) == 240);
+    assert(strcmp(stream_op_name(STREAM_ADD), "Add") == 0);
+    printf("  - PASSED: Byte accounting follows STREAM (16/16/24/24 bytes per element).\n");
+
+    aligned_free(a); aligned_free(b); aligned_free(c);
+}
+
+/**
+ * @brief Testa que o kernel de inteiros reporta as operações executadas.
+ */
+void test_kernel_int_ops(void) {
+    printf("\n- Running test_kernel_int_ops...\n");
+    uint64_t buf[256];
+    for (size_t i = 0; i < 256; i++) buf[i] = i;
+    assert(kernel_int(buf, 256, 4) == 256ull * 4 * INT_OPS_PER_ELEM);
+    assert(kernel_int(buf, 0, 4) == 0);
+    printf("  - PASSED: kernel_int returns n * iters * INT_OPS_PER_ELEM operations.\n");
+}
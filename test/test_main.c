@@ -1,9 +1,11 @@
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 #include "hardstress.h"
 #include "core.h"
 #include "metrics.h"
 #include "utils.h"
+#include "headless.h"
 #include <stdbool.h>
 
 // Declaração antecipada de funções de teste
@@ -15,7 +17,40 @@ void test_shuffle32();
 void test_shuffle32_null_robustness();
 void test_controller_thread_alloc_fail();
 void test_shuffle_bias();
+void test_sattolo32_single_cycle();
 void test_time_now_sec();
+void test_ticker();
+void test_heatmap_incremental();
+void test_history_archive();
+void test_telemetry_export();
+void test_bench_scores();
+void test_degrade_events();
+void test_load_profiles();
+void test_worker_roles();
+void test_cache_sweep();
+void test_coherence();
+void test_storage();
+void test_jitter();
+void test_fleet();
+void test_verify();
+void test_headless_parse_args();
+void test_aligned_calloc();
+void test_parse_cpu_list();
+void test_topology_remote_cpu();
+void test_topology_place();
+void test_cpu_groups();
+void test_page_mode_parse();
+void test_region_alloc_fallback();
+void test_fp_engines_agree();
+void test_ptrchase_chains();
+void test_buffer_init();
+void test_stream_ops();
+void test_kernel_int_ops();
+void test_format_kernel_rates();
+void test_temp_sensors_sysfs();
+void test_cpu_freq_sysfs();
+void test_perf_rates();
+void test_perf_group_self();
 
 // Declaração antecipada de funções de stubs
 void set_calloc_will_fail(bool fail);
@@ -31,11 +66,44 @@ int main() {
     test_get_total_system_memory();
     test_now_sec();
     test_time_now_sec();
+    test_ticker();
+    test_heatmap_incremental();
+    test_history_archive();
+    test_telemetry_export();
+    test_bench_scores();
+    test_degrade_events();
+    test_load_profiles();
+    test_worker_roles();
+    test_cache_sweep();
+    test_coherence();
+    test_storage();
+    test_jitter();
+    test_fleet();
+    test_verify();
     test_splitmix64();
     test_shuffle32();
     test_shuffle32_null_robustness();
     test_controller_thread_alloc_fail();
     test_shuffle_bias();
+    test_sattolo32_single_cycle();
+    test_headless_parse_args();
+    test_aligned_calloc();
+    test_parse_cpu_list();
+    test_topology_remote_cpu();
+    test_topology_place();
+    test_cpu_groups();
+    test_page_mode_parse();
+    test_region_alloc_fallback();
+    test_fp_engines_agree();
+    test_ptrchase_chains();
+    test_buffer_init();
+    test_stream_ops();
+    test_kernel_int_ops();
+    test_format_kernel_rates();
+    test_temp_sensors_sysfs();
+    test_cpu_freq_sysfs();
+    test_perf_rates();
+    test_perf_group_self();
 
     printf("\nAll tests passed!\n");
     return 0;
@@ -173,3 +241,51 @@ void test_controller_thread_alloc_fail() {
     // Reset calloc behavior for subsequent tests
     set_calloc_will_fail(false);
 }
+
+/**
+ * @brief Testa o alinhamento de aligned_calloc e o layout do array de workers.
+ */
+void test_aligned_calloc() {
+    printf("\n- Running test_aligned_calloc...\n");
+    worker_t *workers = aligned_calloc(4, sizeof(worker_t), WORKER_ALIGN);
+    assert(workers != NULL);
+    assert(((uintptr_t)workers % WORKER_ALIGN) == 0);
+    for (int i = 0; i < 4; i++) {
+        assert(((uintptr_t)&workers[i].iters % WORKER_ALIGN) == 0);
+        assert(workers[i].tid == 0 && atomic_load(&workers[i].iters) == 0);
+    }
+    printf("  - PASSED: Workers are zeroed and each hot block starts on its own %d-byte boundary.\n", WORKER_ALIGN);
+    aligned_free(workers);
+    aligned_free(NULL);
+}
+
+/**
+ * @brief Testa a formatação das taxas por kernel exibida na barra de status e no modo headless.
+ */
+void test_format_kernel_rates() {
+    printf("\n- Running test_format_kernel_rates...\n");
+    AppContext app = {0};
+    g_mutex_init(&app.history_mutex);
+    char buf[192];
+
+    app.iters_per_sec = 42.0;
+    format_kernel_rates(&app, buf, sizeof(buf));
+    assert(strcmp(buf, "42 iters/s") == 0);
+    printf("  - PASSED: Without kernels the iteration rate is shown.\n");
+
+    app.kernel_fpu_en = app.kernel_int_en = app.kernel_stream_en = app.kernel_ptr_en = 1;
+    app.gflops = 12.34;
+    app.int_gops = 4.5;
+    app.stream_gbps = 13.6;
+    app.ptr_mloads = 45.0;
+    app.ptr_ns_per_load = 21.04;
+    format_kernel_rates(&app, buf, sizeof(buf));
+    assert(strcmp(buf, "FPU 12.3 GFLOP/s | INT 4.50 Gops/s | STREAM 13.6 GB/s | PTR 45.0 Mcargas/s (21.0 ns/carga)") == 0);
+    printf("  - PASSED: Each enabled kernel is reported in its physical unit.\n");
+
+    app.kernel_fpu_en = app.kernel_int_en = 0;
+    format_kernel_rates(&app, buf, sizeof(buf));
+    assert(strcmp(buf, "STREAM 13.6 GB/s | PTR 45.0 Mcargas/s (21.0 ns/carga)") == 0);
+    printf("  - PASSED: Disabled kernels are omitted without a leading separator.\n");
+    g_mutex_clear(&app.history_mutex);
+}
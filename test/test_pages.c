@@ -0,0 +1,53 @@
+#include <assert.h>
+#include <stdio.h>
+#include "hardstress.h"
+#include "pages.h"
+
+/**
+ * @brief Testa a conversão dos nomes de modo de página.
+ */
+void test_page_mode_parse(void) {
+    printf("\n- Running test_page_mode_parse...\n");
+    assert(page_mode_parse("default") == PAGE_MODE_DEFAULT);
+    assert(page_mode_parse("thp") == PAGE_MODE_THP);
+    assert(page_mode_parse("2m") == PAGE_MODE_HUGE_2M);
+    assert(page_mode_parse("1g") == PAGE_MODE_HUGE_1G);
+    assert(page_mode_parse("4k") == -1);
+    assert(page_mode_parse(NULL) == -1);
+    printf("  - PASSED: Page mode names are parsed and unknown names rejected.\n");
+
+    char buf[32];
+    format_page_size(4096, buf, sizeof(buf));
+    assert(strcmp(buf, "4 KiB") == 0);
+    format_page_size(2 * 1024 * 1024, buf, sizeof(buf));
+    assert(strcmp(buf, "2 MiB") == 0);
+    format_page_size(1024ULL * 1024 * 1024, buf, sizeof(buf));
+    assert(strcmp(buf, "1 GiB") == 0);
+    printf("  - PASSED: Page sizes are formatted with binary units.\n");
+}
+
+/**
+ * @brief Testa que todos os modos de página produzem uma região utilizável, recuando se necessário.
+ */
+void test_region_alloc_fallback(void) {
+    printf("\n- Running test_region_alloc_fallback...\n");
+    const size_t bytes = 3 * 1024 * 1024 + 123;
+    for (int mode = PAGE_MODE_DEFAULT; mode <= PAGE_MODE_HUGE_1G; mode++) {
+        mem_region_t r;
+        uint8_t *p = region_alloc(&r, bytes, mode);
+        assert(p != NULL);
+        assert(r.mode <= mode);
+        assert(r.page_size >= 4096);
+        assert(r.map_bytes >= bytes);
+        p[0] = 1; p[bytes - 1] = 2;
+        assert(p[0] == 1 && p[bytes - 1] == 2);
+        region_free(&r);
+        assert(r.ptr == NULL);
+    }
+    printf("  - PASSED: Every mode yields writable memory, falling back to smaller pages when unavailable.\n");
+
+    mem_region_t empty;
+    assert(region_alloc(&empty, 0, PAGE_MODE_HUGE_2M) == NULL);
+    region_free(&empty);
+    printf("  - PASSED: Zero-sized requests return NULL and free safely.\n");
+}
@@ -0,0 +1,60 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "hardstress.h"
+#include "perfctr.h"
+#include "metrics.h"
+
+/**
+ * @brief Testa IPC, MPKI e a formatação por kernel dos contadores de hardware.
+ */
+void test_perf_rates() {
+    printf("\n- Running test_perf_rates...\n");
+    unsigned long long c[PERF_COUNTER_COUNT] = {0};
+    assert(perf_ipc(c) == 0.0 && perf_mpki(c, PERF_LLC_MISSES) == 0.0);
+    c[PERF_CYCLES] = 1000;
+    c[PERF_INSTRUCTIONS] = 2500;
+    c[PERF_LLC_MISSES] = 5;
+    assert(perf_ipc(c) == 2.5);
+    assert(perf_mpki(c, PERF_LLC_MISSES) == 2.0);
+    printf("  - PASSED: IPC and MPKI are derived from the raw counts, and are 0 without a denominator.\n");
+
+    AppContext app = {0};
+    g_mutex_init(&app.history_mutex);
+    char buf[320];
+    memcpy(app.perf_interval[KERNEL_STREAM], c, sizeof(c));
+    assert(format_perf_rates(&app, buf, sizeof(buf)) == 0 && buf[0] == '\0');
+    app.perf_en = 1;
+    assert(format_perf_rates(&app, buf, sizeof(buf)) == 1);
+    assert(strcmp(buf, "STREAM IPC 2.50 (LLC 2.0, dTLB 0.0, desvios 0.0 MPKI)") == 0);
+    printf("  - PASSED: Only kernels with cycles in the interval are reported, and only when enabled.\n");
+    g_mutex_clear(&app.history_mutex);
+}
+
+/**
+ * @brief Testa a abertura e a leitura do grupo de contadores da própria thread.
+ *
+ * VMs e kernels com `perf_event_paranoid` restritivo não expõem a PMU; nesse caso
+ * o teste verifica apenas que a falha é reportada sem descritores abertos.
+ */
+void test_perf_group_self() {
+    printf("\n- Running test_perf_group_self...\n");
+    perf_group_t g;
+    unsigned mask = perf_group_open(&g);
+    unsigned long long a[PERF_COUNTER_COUNT], b[PERF_COUNTER_COUNT];
+    if (!mask) {
+        assert(g.leader < 0 && g.count == 0 && g.err != 0);
+        assert(perf_group_read(&g, a) == -1);
+        printf("  - PASSED: Without a PMU the group is empty and the error is kept (%s).\n", strerror(g.err));
+        return;
+    }
+    assert(mask & (1u << PERF_CYCLES));
+    assert(perf_group_read(&g, a) == 0);
+    volatile uint64_t x = 1;
+    for (int i = 0; i < 1000000; i++) x = x * 3 + 1;
+    assert(perf_group_read(&g, b) == 0);
+    assert(b[PERF_CYCLES] > a[PERF_CYCLES]);
+    if (mask & (1u << PERF_INSTRUCTIONS)) assert(b[PERF_INSTRUCTIONS] - a[PERF_INSTRUCTIONS] >= 1000000);
+    perf_group_close(&g);
+    printf("  - PASSED: The group counts the calling thread's own work (mask 0x%x).\n", mask);
+}
@@ -0,0 +1,37 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "hardstress.h"
+#include "profile.h"
+
+/**
+ * @brief Testa os perfis de carga: especificações aceitas e rejeitadas e o nível ao longo do tempo.
+ */
+void test_load_profiles(void) {
+    printf("\n- Running test_load_profiles...\n");
+    load_profile_t p;
+    assert(profile_parse("duty:50", &p) == 0 && p.kind == PROFILE_DUTY && p.duty == 0.5);
+    assert(p.period == PROFILE_DEFAULT_PERIOD_MS / 1000.0);
+    assert(profile_parse("square:20", &p) == 0 && p.kind == PROFILE_SQUARE && p.duty == 0.5 && p.period == 0.02);
+    assert(profile_parse("ramp:10:100:60:50", &p) == 0 && p.kind == PROFILE_RAMP && p.period == 0.05);
+    assert(profile_parse("step:25,50,100:2", &p) == 0 && p.kind == PROFILE_STEP && p.level_count == 3);
+    printf("  - PASSED: Duty, square, ramp and step specifications are parsed.\n");
+
+    const char *bad[] = { "", "duty", "duty:150", "duty:50:5", "square:100:1", "ramp:10:100", "ramp:10:100:0",
+                          "step::1", "step:50,x:1", "step:50:0.01", "sine:50", "duty:50:100:1" };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) assert(profile_parse(bad[i], &p) == -1);
+    printf("  - PASSED: Malformed specifications, out-of-range levels and too-short steps are rejected.\n");
+
+    assert(profile_parse("ramp:10:100:60", &p) == 0);
+    assert(profile_level(&p, 0.0) == 0.1 && profile_level(&p, 60.0) == 1.0 && profile_level(&p, 600.0) == 1.0);
+    double mid = profile_level(&p, 30.0);
+    assert(mid > 0.549 && mid < 0.551);
+    assert(profile_parse("step:25,50,100:2:100", &p) == 0);
+    // Janelas de 100 ms: o degrau muda exatamente na janela 20.
+    assert(profile_level(&p, 19 * p.period) == 0.25 && profile_level(&p, 20 * p.period) == 0.5);
+    assert(profile_level(&p, 4.0) == 1.0 && profile_level(&p, 6.0) == 0.25);
+    char desc[128];
+    profile_describe(&p, desc, sizeof(desc));
+    assert(strstr(desc, "25%,50%,100%") && strstr(desc, "100 ms"));
+    printf("  - PASSED: Ramps interpolate then hold, and steps cycle on window boundaries.\n");
+}
@@ -0,0 +1,42 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "hardstress.h"
+#include "topology.h"
+#include "roles.h"
+
+/**
+ * @brief Testa os papéis dos workers: grupos explícitos, erros de especificação e a divisão SMT.
+ */
+void test_worker_roles(void) {
+    printf("\n- Running test_worker_roles...\n");
+    const unsigned all = ROLE_COMPUTE | ROLE_MEMORY;
+    const unsigned fpu = 1u << KERNEL_FPU, stream = 1u << KERNEL_STREAM, ptr = 1u << KERNEL_PTR;
+    unsigned masks[8];
+    char err[160], line[256];
+
+    assert(roles_assign("fpu=0-1;stream+ptr=2,3", all, NULL, NULL, 6, masks, err, sizeof(err)) == 0);
+    assert(masks[0] == fpu && masks[1] == fpu && masks[2] == (stream | ptr) && masks[3] == (stream | ptr));
+    assert(masks[4] == all && masks[5] == all);
+    roles_format(masks, 6, line, sizeof(line));
+    assert(strcmp(line, "FPU: T0-1 | STREAM+PTR: T2-3 | FPU+INT+STREAM+PTR+ATOMIC: T4-5") == 0);
+    printf("  - PASSED: Groups assign their kernels and unlisted workers keep the defaults.\n");
+
+    const char *bad[] = { "fpu=0;int=0", "fpu=6", "gpu=0", "fpu+=0", "fpu", "=0", "fpu=" };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        assert(roles_assign(bad[i], all, NULL, NULL, 6, masks, err, sizeof(err)) == -1 && err[0]);
+    }
+    assert(roles_assign("smt", fpu, NULL, NULL, 6, masks, err, sizeof(err)) == -1);
+    printf("  - PASSED: Overlapping groups, unknown workers or kernels and malformed groups are rejected.\n");
+
+    // Quatro CPUs em dois núcleos de duas threads; os workers 0-3 fixados em 0, 2, 1 e 3.
+    int smt[4] = {0, 1, 0, 1}, cpus[4] = {0, 2, 1, 3};
+    cpu_topology_t topo = {0};
+    topo.cpu_count = 4;
+    topo.cpu_smt = smt;
+    assert(roles_assign("smt", all, &topo, cpus, 4, masks, err, sizeof(err)) == 0);
+    assert(masks[0] == ROLE_COMPUTE && masks[1] == ROLE_COMPUTE && masks[2] == ROLE_MEMORY && masks[3] == ROLE_MEMORY);
+    assert(roles_assign("smt", fpu | ptr, NULL, NULL, 3, masks, err, sizeof(err)) == 0);
+    assert(masks[0] == fpu && masks[1] == ptr && masks[2] == fpu);
+    printf("  - PASSED: The smt split puts compute on first threads and memory on siblings, or alternates.\n");
+}
@@ -43,3 +43,33 @@ void test_shuffle_bias() {
     }
     printf("  - PASSED: Shuffle distribution is within tolerance.\n");
 }
+
+/**
+ * @brief Testa que sattolo32 sempre produz um único ciclo que visita todos os elementos.
+ */
+void test_sattolo32_single_cycle() {
+    printf("\n- Running test_sattolo32_single_cycle...\n");
+    uint64_t seed = 777;
+    const size_t strides[] = {1, 16};
+    for (size_t si = 0; si < 2; si++) {
+        size_t stride = strides[si];
+        for (size_t n = 1; n <= 64; n++) {
+            uint32_t *a = calloc(n * stride, sizeof(uint32_t));
+            char *seen = calloc(n, 1);
+            assert(a && seen);
+            sattolo32(a, n, stride, &seed);
+
+            uint32_t p = 0;
+            for (size_t step = 0; step < n; step++) {
+                assert(p % stride == 0 && p / stride < n);
+                assert(!seen[p / stride]);
+                seen[p / stride] = 1;
+                p = a[p];
+            }
+            assert(p == 0); // Volta ao início exatamente após n passos
+            free(a);
+            free(seen);
+        }
+    }
+    printf("  - PASSED: Every permutation is a single n-cycle (stride 1 and 16).\n");
+}
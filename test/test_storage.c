@@ -0,0 +1,95 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "hardstress.h"
+#include "utils.h"
+#include "storage.h"
+#include "lathist.h"
+
+/**
+ * @brief Testa o histograma de latências e uma execução curta do motor de E/S sobre um arquivo temporário.
+ */
+void test_storage(void) {
+    printf("\n- Running test_storage...\n");
+    const unsigned long long samples[] = { 0, 1, 15, 16, 17, 31, 32, 1000, 4095, 4096, 123456789ull, 1ull << 39 };
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        int idx = lat_hist_index(samples[i]);
+        assert(idx >= 0 && idx < LAT_HIST_BUCKETS);
+        assert(lat_hist_upper(idx) >= samples[i]);
+        assert(idx == 0 || lat_hist_upper(idx - 1) < samples[i]);
+        // O limite superior fica a menos de 1/16 do valor.
+        assert(lat_hist_upper(idx) - samples[i] <= samples[i] / (1u << LAT_HIST_SUB_BITS));
+    }
+    assert(lat_hist_index(~0ull) == LAT_HIST_BUCKETS - 1);
+    printf("  - PASSED: Latencies map to log-linear buckets whose upper bound is within 1/16.\n");
+
+    static unsigned long long hist[LAT_HIST_BUCKETS];
+    assert(lat_hist_percentile(hist, 99.0) == 0.0);
+    hist[lat_hist_index(1000)] = 990;
+    hist[lat_hist_index(1000000)] = 10;
+    assert(lat_hist_percentile(hist, 50.0) == (double)lat_hist_upper(lat_hist_index(1000)));
+    assert(lat_hist_percentile(hist, 99.0) == (double)lat_hist_upper(lat_hist_index(1000)));
+    assert(lat_hist_percentile(hist, 99.9) == (double)lat_hist_upper(lat_hist_index(1000000)));
+    assert(lat_hist_max(hist) == (double)lat_hist_upper(lat_hist_index(1000000)));
+    printf("  - PASSED: Percentiles pick the bucket holding the requested rank.\n");
+
+    char err[256];
+    atomic_int running;
+    atomic_init(&running, 1);
+    io_options_t bad = { "/tmp", 4, 6, 4, 50, 0 };
+    assert(io_engine_open(&bad, &running, err, sizeof(err)) == NULL && err[0] != '\0');
+    io_options_t missing = { "/nonexistent-hardstress-dir/io.dat", 4, 4, 4, 50, 0 };
+    assert(io_engine_open(&missing, &running, err, sizeof(err)) == NULL && err[0] != '\0');
+    printf("  - PASSED: Invalid parameters and unreachable targets are rejected with a message.\n");
+
+    io_options_t o = { "/tmp", 4, 4, 4, 50, 0 };
+    io_engine_t *e = io_engine_open(&o, &running, err, sizeof(err));
+    assert(e != NULL);
+    assert(e->created && e->size == 4ull << 20 && e->block == 4096);
+    assert(io_engine_start(e) == 0);
+    double t0 = now_sec();
+    sleep_until(t0 + 0.2);
+    io_stats_t st;
+    io_engine_sample(e, now_sec() - t0, &st);
+    atomic_store(&running, 0);
+    io_engine_join(e);
+    io_totals_t t;
+    io_engine_totals(e, &t);
+    printf("  - %s: %.0f IOPS, p99 %.1f µs\n", io_backend_name(e->backend), st.iops, st.p99_us);
+    assert(st.iops > 0.0 && st.p50_us > 0.0 && st.p99_us >= st.p50_us);
+    assert(t.reads > 0 && t.writes > 0 && t.errors == 0 && t.seconds > 0.0);
+    assert(t.max_us >= t.rate.p999_us && t.rate.p999_us >= t.rate.p50_us);
+    io_engine_close(e);
+    io_engine_close(NULL);
+    printf("  - PASSED: The engine keeps reads and writes in flight on a temporary file until stopped.\n");
+
+#ifndef _WIN32
+    // Um arquivo que já existia não é escrito nem estendido sem a permissão explícita.
+    char path[] = "/tmp/hardstress-io-XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    static unsigned char data[64 * 1024], back[64 * 1024];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (unsigned char)(i * 31 + 7);
+    assert(write(fd, data, sizeof(data)) == (ssize_t)sizeof(data));
+    close(fd);
+    atomic_store(&running, 1);
+    io_options_t existing = { path, 4, 4, 4, 50, 0 };
+    assert(io_engine_open(&existing, &running, err, sizeof(err)) == NULL && strstr(err, "destruiriam") != NULL);
+    existing.read_pct = 100;
+    e = io_engine_open(&existing, &running, err, sizeof(err));
+    assert(e != NULL && !e->created && e->size == sizeof(data));
+    assert(io_engine_start(e) == 0);
+    sleep_until(now_sec() + 0.05);
+    atomic_store(&running, 0);
+    io_engine_join(e);
+    io_engine_totals(e, &t);
+    assert(t.reads > 0 && t.writes == 0);
+    io_engine_close(e);
+    FILE *f = fopen(path, "rb");
+    assert(f != NULL && fread(back, 1, sizeof(back), f) == sizeof(back) && fgetc(f) == EOF);
+    fclose(f);
+    assert(memcmp(data, back, sizeof(data)) == 0);
+    unlink(path);
+    printf("  - PASSED: An existing file is only read, neither written nor extended, without --io-destructive.\n");
+#endif
+}
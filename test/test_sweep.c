@@ -0,0 +1,74 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hardstress.h"
+#include "utils.h"
+#include "sweep.h"
+#include "test_sysfs.h"
+
+/**
+ * @brief Testa a varredura de caches: os tamanhos, a leitura dos caches do sysfs e a medição de um ponto.
+ */
+void test_cache_sweep(void) {
+    printf("\n- Running test_cache_sweep...\n");
+    size_t sizes[SWEEP_MAX_POINTS];
+    int n = sweep_sizes(64u << 10, sizes, SWEEP_MAX_POINTS);
+    const size_t expect[] = { 4u << 10, 6u << 10, 8u << 10, 12u << 10, 16u << 10, 24u << 10, 32u << 10, 48u << 10, 64u << 10 };
+    assert(n == (int)(sizeof(expect) / sizeof(expect[0])));
+    for (int i = 0; i < n; i++) assert(sizes[i] == expect[i]);
+    assert(sweep_sizes((size_t)SWEEP_MAX_MIB << 20, sizes, SWEEP_MAX_POINTS) <= SWEEP_MAX_POINTS);
+    assert(sizes[0] == SWEEP_MIN_BYTES);
+    assert(sweep_sizes(5u << 10, sizes, SWEEP_MAX_POINTS) == 1);
+    assert(sweep_sizes(64u << 10, sizes, 3) == 3);
+    printf("  - PASSED: Sizes step by 2x and 1.5x from 4 KiB up to the cap.\n");
+
+#ifndef _WIN32
+    char root[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(root) != NULL);
+    // Fora de ordem, como alguns kernels expõem; o cache de instruções não entra na curva.
+    write_file(root, "devices/system/cpu/cpu0/cache/index0/level", "3\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index0/type", "Unified\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index0/size", "32M\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index0/shared_cpu_list", "0-15\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index1/level", "1\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index1/type", "Data\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index1/size", "48K\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index1/shared_cpu_list", "0,8\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index2/level", "1\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index2/type", "Instruction\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index2/size", "32K\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index3/level", "2\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index3/type", "Unified\n");
+    write_file(root, "devices/system/cpu/cpu0/cache/index3/size", "2048K\n");
+    cpu_cache_t caches[CPU_CACHE_MAX];
+    assert(topology_caches_at(root, 0, caches, CPU_CACHE_MAX) == 3);
+    assert(caches[0].level == 1 && caches[0].bytes == (48u << 10) && caches[0].shared_cpus == 2);
+    assert(caches[1].level == 2 && caches[1].bytes == (2048u << 10) && caches[1].shared_cpus == 0);
+    assert(caches[2].level == 3 && caches[2].bytes == (32u << 20) && caches[2].shared_cpus == 16);
+    assert(topology_caches_at(root, 1, caches, CPU_CACHE_MAX) == 0);
+    remove_tree(root);
+    printf("  - PASSED: Data and unified caches are read from sysfs and sorted by level.\n");
+
+    assert(sweep_expected_level(caches, 0, 4096) == 0);
+    cpu_cache_t hier[3] = { { 1, 48u << 10, 2 }, { 2, 2u << 20, 2 }, { 3, 32u << 20, 16 } };
+    assert(sweep_expected_level(hier, 3, 48u << 10) == 1);
+    assert(sweep_expected_level(hier, 3, 64u << 10) == 2);
+    assert(sweep_expected_level(hier, 3, 32u << 20) == 3);
+    assert(sweep_expected_level(hier, 3, 48u << 20) == 0);
+    printf("  - PASSED: Each size maps to the smallest cache that holds it, or DRAM.\n");
+#endif
+
+    const size_t bytes = 64u << 10;
+    uint8_t *buf = aligned_calloc(1, bytes, CACHE_LINE_SIZE);
+    assert(buf != NULL);
+    uint64_t seed = 42;
+    sweep_point_t p;
+    assert(sweep_measure(buf, bytes, 1, 0.002, NULL, &seed, &p) == 0);
+    assert(p.bytes == bytes && p.ns_per_load > 0.0 && p.gbps > 0.0);
+    atomic_int stopped;
+    atomic_init(&stopped, 0);
+    assert(sweep_measure(buf, bytes, 1, 0.002, &stopped, &seed, &p) == -1);
+    aligned_free(buf);
+    printf("  - PASSED: A point yields a latency and a bandwidth, and stops when running is cleared.\n");
+}
@@ -0,0 +1,41 @@
+#ifndef TEST_SYSFS_H
+#define TEST_SYSFS_H
+
+/**
+ * @file test_sysfs.h
+ * @brief Auxiliares para montar árvores sysfs sintéticas nos testes.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+/**
+ * @brief Cria `root/rel` (e os diretórios intermediários) com o conteúdo `text`.
+ */
+static void write_file(const char *root, const char *rel, const char *text) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", root, rel);
+    for (char *p = path + strlen(root) + 1; *p; p++) {
+        if (*p == '/') { *p = '\0'; mkdir(path, 0755); *p = '/'; }
+    }
+    FILE *f = fopen(path, "w");
+    assert(f != NULL);
+    fputs(text, f);
+    fclose(f);
+}
+
+/**
+ * @brief Remove a árvore sysfs sintética.
+ */
+static void remove_tree(const char *root) {
+    char cmd[600];
+    snprintf(cmd, sizeof(cmd), "rm -rf '%s'", root);
+    assert(system(cmd) == 0);
+}
+#endif
+
+#endif // TEST_SYSFS_H
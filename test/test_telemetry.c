@@ -0,0 +1,111 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "hardstress.h"
+#include "telemetry.h"
+#include "utils.h"
+
+/**
+ * @brief Conta as ocorrências de `c` em `s`.
+ */
+static int count_char(const char *s, char c) {
+    int n = 0;
+    for (; *s; s++) n += (*s == c);
+    return n;
+}
+
+/**
+ * @brief Exporta duas amostras e o resumo de um contexto sintético e lê o arquivo de volta.
+ * @return O número de linhas lidas em `lines`.
+ */
+static int export_run(AppContext *app, const char *path, int format, char lines[][1024], int max) {
+    telemetry_t *tm = telemetry_open(path, format);
+    assert(tm != NULL);
+    for (int i = 0; i < 2; i++) {
+        app->history_pos = i;
+        app->history_seq = (unsigned long long)i + 1;
+        telemetry_sample(tm, app);
+    }
+    telemetry_summary(tm, app);
+    assert(tm->samples == 2 && tm->dropped == 0);
+    assert(telemetry_close(tm) == 0);
+
+    FILE *f = fopen(path, "r");
+    assert(f != NULL);
+    int n = 0;
+    while (n < max && fgets(lines[n], 1024, f)) n++;
+    fclose(f);
+    unlink(path);
+    return n;
+}
+
+/**
+ * @brief Testa a exportação em JSON Lines e CSV: cabeçalho, taxas por thread, valores ausentes e resumo.
+ */
+void test_telemetry_export(void) {
+    printf("\n- Running test_telemetry_export...\n");
+    assert(telemetry_format_parse("jsonl") == TELEMETRY_JSONL && telemetry_format_parse("csv") == TELEMETRY_CSV);
+    assert(telemetry_format_parse("xml") == -1);
+    assert(telemetry_format_from_path("run.jsonl") == TELEMETRY_JSONL && telemetry_format_from_path("run.csv") == TELEMETRY_CSV);
+
+    AppContext app = {0};
+    g_mutex_init(&app.cpu_mutex);
+    g_mutex_init(&app.temp_mutex);
+    g_mutex_init(&app.history_mutex);
+    g_mutex_init(&app.system_history_mutex);
+    app.threads = 2;
+    app.cpu_count = 2;
+    app.kernel_fpu_en = 1;
+    app.start_time = now_sec();
+    double usage[2] = {0.5, 1.0}, mhz[2] = {3000.0, 0.0}, core_temps[1] = {61.5};
+    app.cpu_usage = usage;
+    app.cpu_freq_mhz = mhz;
+    app.temp_celsius = TEMP_UNAVAILABLE;
+    app.core_temps = core_temps;
+    app.core_temp_count = 1;
+    app.gflops = 12.5;
+
+    // T0 advances 2 iterations and T1 one iteration in the half second between the two samples.
+    enum { LEN = 4 };
+    double history_time[LEN] = {10.0, 10.5};
+    thread_sample_t h0[LEN] = {{{0}}}, h1[LEN] = {{{0}}};
+    h0[1].v[THREAD_METRIC_PROGRESS] = 2 * ITER_PROGRESS_SCALE;
+    h1[1].v[THREAD_METRIC_PROGRESS] = 1 * ITER_PROGRESS_SCALE;
+    thread_sample_t *history[2] = {h0, h1};
+    app.thread_history = history;
+    app.history_time = history_time;
+    app.history_len = LEN;
+
+    char path[] = "/tmp/hardstress_telemetry_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    char lines[8][1024];
+    int n = export_run(&app, path, TELEMETRY_JSONL, lines, 8);
+    assert(n == 4);
+    assert(strncmp(lines[0], "{\"type\":\"header\"", 16) == 0 && strstr(lines[0], "\"kernels\":[\"fpu\"]"));
+    assert(strstr(lines[1], "\"thread_iters_s\":[0,0]"));
+    assert(strstr(lines[2], "\"thread_iters_s\":[4,2]"));
+    assert(strstr(lines[2], "\"fpu_gflops\":12.5") && strstr(lines[2], "\"temp_c\":null"));
+    assert(strstr(lines[2], "\"cpu_usage\":[0.5,1]") && strstr(lines[2], "\"cpu_mhz\":[3000,null]"));
+    assert(strstr(lines[2], "\"core_temps_c\":[61.5]"));
+    assert(strncmp(lines[3], "{\"type\":\"summary\"", 17) == 0 && strstr(lines[3], "\"samples\":2,\"dropped\":0}"));
+    printf("  - PASSED: JSON Lines carries a header, one object per sample and the summary; missing values are null.\n");
+
+    n = export_run(&app, path, TELEMETRY_CSV, lines, 8);
+    assert(n == 5);
+    assert(strncmp(lines[0], "type,t,wall,iters_s,fpu_gflops", 30) == 0);
+    assert(count_char(lines[0], ',') == count_char(lines[1], ',') && count_char(lines[0], ',') == count_char(lines[2], ','));
+    assert(strstr(lines[2], ",0.5,1,3000,,4,2,61.5\n"));
+    assert(strncmp(lines[3], "type,elapsed_s", 14) == 0 && strncmp(lines[4], "summary,", 8) == 0);
+    assert(count_char(lines[3], ',') == count_char(lines[4], ','));
+    printf("  - PASSED: CSV rows match the header columns and the summary follows in its own block.\n");
+
+    g_mutex_clear(&app.cpu_mutex);
+    g_mutex_clear(&app.temp_mutex);
+    g_mutex_clear(&app.history_mutex);
+    g_mutex_clear(&app.system_history_mutex);
+}
@@ -20,3 +20,29 @@ void test_time_now_sec(void) {
     assert(end_time > start_time);
     printf("ok\n");
 }
+
+/**
+ * @brief Testa o temporizador de prazos absolutos: períodos não acumulam atraso e prazos perdidos são contados.
+ */
+void test_ticker(void) {
+    printf("Testing ticker_wait()... ");
+    ticker_t t;
+    double start = now_sec();
+    ticker_start(&t, 0.02);
+    for (int i = 0; i < 3; i++) assert(ticker_wait(&t) == 0);
+    double elapsed = now_sec() - start;
+    assert(elapsed >= 0.059);
+    // O prazo seguinte continua na grade de 20 ms, contada a partir do início.
+    assert(t.next - start > 0.079 && t.next - start < 0.081);
+
+    // Um atraso de mais de dois períodos descarta os prazos perdidos em vez de dispará-los em rajada.
+    #ifdef _WIN32
+    Sleep(50);
+    #else
+    usleep(50000);
+    #endif
+    assert(ticker_wait(&t) >= 1);
+    assert(t.next > now_sec());
+    ticker_stop(&t);
+    printf("ok\n");
+}
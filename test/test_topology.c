@@ -0,0 +1,147 @@
+#include <assert.h>
+#include <stdio.h>
+#include "hardstress.h"
+#include "topology.h"
+#include "metrics.h"
+#include "utils.h"
+#include "test_sysfs.h"
+
+/**
+ * @brief Testa a análise de listas de CPUs no formato do kernel.
+ */
+void test_parse_cpu_list(void) {
+    printf("\n- Running test_parse_cpu_list...\n");
+    int cpus[16];
+    int n = parse_cpu_list("0-3,8,10-11\n", cpus, 16);
+    assert(n == 7);
+    assert(cpus[0] == 0 && cpus[3] == 3 && cpus[4] == 8 && cpus[5] == 10 && cpus[6] == 11);
+    printf("  - PASSED: Ranges and single CPUs are expanded in order.\n");
+
+    assert(parse_cpu_list("0-63", cpus, 4) == 4);
+    printf("  - PASSED: Output is truncated to the array capacity.\n");
+
+    assert(parse_cpu_list("3-1", cpus, 16) == -1);
+    assert(parse_cpu_list("a,b", cpus, 16) == -1);
+    assert(parse_cpu_list("", cpus, 16) == 0);
+    printf("  - PASSED: Invalid lists are rejected.\n");
+}
+
+/**
+ * @brief Testa a escolha de CPUs remotas em uma topologia sintética de dois nós.
+ */
+void test_topology_remote_cpu(void) {
+    printf("\n- Running test_topology_remote_cpu...\n");
+    int nodes[8] = {0, 0, 0, 0, 1, 1, 1, 1};
+    cpu_topology_t topo = { .cpu_count = 8, .node_count = 2, .cpu_node = nodes };
+
+    for (int c = 0; c < 8; c++) {
+        int r = topology_remote_cpu(&topo, c);
+        assert(r >= 0 && r < 8);
+        assert(topology_cpu_node(&topo, r) != topology_cpu_node(&topo, c));
+    }
+    assert(topology_remote_cpu(&topo, 0) != topology_remote_cpu(&topo, 1));
+    printf("  - PASSED: Every CPU maps to a distinct CPU on the other node.\n");
+
+    topo.node_count = 1;
+    assert(topology_remote_cpu(&topo, 0) == -1);
+    printf("  - PASSED: Single-node systems have no remote CPU.\n");
+
+    cpu_topology_t *detected = topology_detect(detect_cpu_count());
+    assert(detected != NULL && detected->node_count >= 1);
+    topology_free(detected);
+    printf("  - PASSED: Topology detection on this host succeeded.\n");
+}
+
+/**
+ * @brief Testa a descoberta de sockets, L3 e irmãos SMT e as políticas de posicionamento.
+ *
+ * A árvore sintética tem 2 sockets x 2 núcleos x 2 threads, com a numeração usual
+ * da Intel (CPU c e c+4 são irmãs) e um L3 por socket.
+ */
+void test_topology_place(void) {
+    printf("\n- Running test_topology_place...\n");
+#ifndef _WIN32
+    char root[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(root) != NULL);
+    static const char *siblings[4] = { "0,4", "1,5", "2,6", "3,7" };
+    for (int c = 0; c < 8; c++) {
+        char rel[128], text[32];
+        snprintf(rel, sizeof(rel), "devices/system/cpu/cpu%d/topology/physical_package_id", c);
+        snprintf(text, sizeof(text), "%d\n", (c % 4) / 2);
+        write_file(root, rel, text);
+        snprintf(rel, sizeof(rel), "devices/system/cpu/cpu%d/topology/thread_siblings_list", c);
+        snprintf(text, sizeof(text), "%s\n", siblings[c % 4]);
+        write_file(root, rel, text);
+        snprintf(rel, sizeof(rel), "devices/system/cpu/cpu%d/cache/index0/level", c);
+        write_file(root, rel, "1\n");
+        snprintf(rel, sizeof(rel), "devices/system/cpu/cpu%d/cache/index1/level", c);
+        write_file(root, rel, "3\n");
+        snprintf(rel, sizeof(rel), "devices/system/cpu/cpu%d/cache/index1/shared_cpu_list", c);
+        write_file(root, rel, (c % 4) < 2 ? "0-1,4-5\n" : "2-3,6-7\n");
+    }
+    write_file(root, "devices/system/node/node0/cpulist", "0-1,4-5\n");
+    write_file(root, "devices/system/node/node1/cpulist", "2-3,6-7\n");
+
+    cpu_topology_t *topo = topology_detect_at(8, root);
+    assert(topo != NULL);
+    assert(topo->package_count == 2 && topo->l3_count == 2 && topo->core_count == 4 && topo->node_count == 2);
+    assert(topo->cpu_core[4] == topo->cpu_core[0] && topo->cpu_smt[0] == 0 && topo->cpu_smt[4] == 1);
+    assert(topo->cpu_package[2] == 1 && topo->cpu_l3[6] == topo->cpu_l3[2] && topo->cpu_l3[1] != topo->cpu_l3[2]);
+    printf("  - PASSED: Sockets, L3 domains, physical cores and SMT positions are read from sysfs.\n");
+
+    static const struct { int policy; int order[8]; } expected[] = {
+        { AFFINITY_PHYSICAL_FIRST, { 0, 1, 2, 3, 4, 5, 6, 7 } },
+        { AFFINITY_COMPACT,        { 0, 4, 1, 5, 2, 6, 3, 7 } },
+        { AFFINITY_SCATTER,        { 0, 2, 1, 3, 4, 6, 5, 7 } },
+        { AFFINITY_SMT_PAIRS,      { 0, 4, 2, 6, 1, 5, 3, 7 } },
+    };
+    int out[10];
+    for (size_t p = 0; p < sizeof(expected) / sizeof(expected[0]); p++) {
+        assert(topology_place(topo, expected[p].policy, NULL, 0, 8, out) == 0);
+        for (int i = 0; i < 8; i++) assert(out[i] == expected[p].order[i]);
+    }
+    printf("  - PASSED: Each policy orders the CPUs by SMT position, core, L3 and socket as documented.\n");
+
+    assert(topology_place(topo, AFFINITY_PHYSICAL_FIRST, NULL, 0, 10, out) == 0);
+    assert(out[8] == 0 && out[9] == 1);
+    int list[2] = { 7, 3 };
+    assert(topology_place(topo, AFFINITY_LIST, list, 2, 3, out) == 0);
+    assert(out[0] == 7 && out[1] == 3 && out[2] == 7);
+    list[0] = 9;
+    assert(topology_place(topo, AFFINITY_LIST, list, 2, 3, out) == -1);
+    printf("  - PASSED: Extra workers wrap around; explicit lists are followed and validated.\n");
+
+    assert(affinity_policy_parse("smt-pairs") == AFFINITY_SMT_PAIRS);
+    assert(affinity_policy_parse("physical") == AFFINITY_PHYSICAL_FIRST);
+    assert(affinity_policy_parse("bogus") == -1);
+    printf("  - PASSED: Policy names are parsed.\n");
+    topology_free(topo);
+
+    char empty[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(empty) != NULL);
+    topo = topology_detect_at(4, empty);
+    assert(topo != NULL && topo->package_count == 1 && topo->l3_count == 1 && topo->core_count == 4);
+    topology_free(topo);
+    printf("  - PASSED: Without sysfs data every CPU is its own core in one socket.\n");
+
+    remove_tree(root);
+    remove_tree(empty);
+#endif
+}
+
+/**
+ * @brief Testa a conversão entre o índice global de CPU e (grupo, número no grupo).
+ */
+void test_cpu_groups(void) {
+    printf("\n- Running test_cpu_groups...\n");
+    int count = detect_cpu_count();
+    unsigned short group;
+    unsigned char number;
+    for (int c = 0; c < count; c++) {
+        assert(cpu_to_group(c, &group, &number) == 0);
+        assert(number < 64);
+        assert(cpu_from_group(group, number) == c);
+    }
+    assert(cpu_to_group(-1, &group, &number) == -1);
+    printf("  - PASSED: Every online CPU maps to a (group, number) pair and back.\n");
+}
@@ -0,0 +1,108 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "hardstress.h"
+#include "utils.h"
+#include "kernels.h"
+#include "verify.h"
+#include "test_sysfs.h"
+
+#define TEST_VERIFY_WORDS (8 * VERIFY_BLOCK_ELEMS)
+
+/**
+ * @brief Testa os padrões, as passagens de leitura-comparação-escrita e a leitura do EDAC.
+ */
+void test_verify(void) {
+    printf("\n- Running test_verify...\n");
+    uint64_t *buf = aligned_calloc(TEST_VERIFY_WORDS, sizeof(uint64_t), CACHE_LINE_SIZE);
+    verify_pattern_t *pat = aligned_calloc(VERIFY_KIND_COUNT * 2 + 1, sizeof(verify_pattern_t), CACHE_LINE_SIZE);
+    assert(buf && pat);
+    for (int p = 0; p <= VERIFY_KIND_COUNT * 2; p++) verify_pattern_init(&pat[p], (unsigned long long)p, 42);
+
+    for (int p = 0; p < VERIFY_KIND_COUNT; p++) {
+        assert(pat[p].kind == p && !pat[p].inverted);
+        assert(pat[p + VERIFY_KIND_COUNT].kind == p && pat[p + VERIFY_KIND_COUNT].inverted);
+    }
+    for (size_t i = 0; i < TEST_VERIFY_WORDS; i++) {
+        assert(__builtin_popcountll(verify_expected(&pat[VERIFY_WALKING_ONES], buf, i)) == 1);
+        assert(verify_expected(&pat[VERIFY_ADDRESS], buf, i) == (uint64_t)(uintptr_t)&buf[i]);
+        assert(verify_expected(&pat[VERIFY_ADDRESS + VERIFY_KIND_COUNT], buf, i) == ~(uint64_t)(uintptr_t)&buf[i]);
+    }
+    // Blocos aleatórios com o mesmo molde devem diferir pela chave de cada bloco.
+    assert(verify_expected(&pat[VERIFY_RANDOM], buf, 0) != verify_expected(&pat[VERIFY_RANDOM], buf, VERIFY_BLOCK_ELEMS));
+    printf("  - PASSED: Patterns cycle walking ones, address and random, then repeat complemented.\n");
+
+    int isas = 0;
+    for (int isa = 0; isa < FP_ISA_COUNT; isa++) {
+        verify_mismatch_t bad[4];
+        if (verify_pass_isa(isa, buf, 0, TEST_VERIFY_WORDS, NULL, &pat[0], bad, 4) == (size_t)-1) continue;
+        isas++;
+        for (int p = 0; p < VERIFY_KIND_COUNT * 2; p++) {
+            assert(verify_pass_isa(isa, buf, 0, TEST_VERIFY_WORDS, &pat[p], &pat[p + 1], bad, 4) == 0);
+            for (size_t i = 0; i < TEST_VERIFY_WORDS; i++) assert(buf[i] == verify_expected(&pat[p + 1], buf, i));
+        }
+
+        // Dois bits trocados em palavras de blocos diferentes, e uma palavra trocada fora da faixa conferida.
+        size_t a = 3 * VERIFY_BLOCK_ELEMS + 5, b = 6 * VERIFY_BLOCK_ELEMS + 511;
+        uint64_t ea = buf[a], eb = buf[b];
+        buf[a] ^= 1ULL << 17;
+        buf[b] ^= 1ULL << 63;
+        buf[1] ^= 1;
+        size_t n = verify_pass_isa(isa, buf, VERIFY_BLOCK_ELEMS, TEST_VERIFY_WORDS - VERIFY_BLOCK_ELEMS,
+                                   &pat[VERIFY_KIND_COUNT * 2], &pat[0], bad, 4);
+        assert(n == 2);
+        assert(bad[0].index == a && bad[0].expected == ea && bad[0].actual == (ea ^ (1ULL << 17)));
+        assert(bad[1].index == b && bad[1].expected == eb && bad[1].actual == (eb ^ (1ULL << 63)));
+        assert(buf[a] == verify_expected(&pat[0], buf, a) && buf[b] == verify_expected(&pat[0], buf, b));
+
+        // Só as primeiras divergências são detalhadas; todas são contadas.
+        verify_pass_isa(isa, buf, 0, TEST_VERIFY_WORDS, NULL, &pat[1], NULL, 0);
+        assert(verify_pass_isa(isa, buf, 0, TEST_VERIFY_WORDS, &pat[2], &pat[1], bad, 1) == TEST_VERIFY_WORDS);
+        assert(bad[0].index == 0);
+    }
+    assert(isas >= 1);
+    printf("  - %d implementation(s), %s by default\n", isas, verify_impl_name());
+    printf("  - PASSED: Every implementation round-trips all patterns and reports injected bit flips exactly.\n");
+
+    uint64_t phys;
+    if (verify_phys_addr(buf, &phys) == 0) {
+        assert(phys % 4096 == ((uintptr_t)buf) % 4096);
+        printf("  - PASSED: Physical address translated (0x%llx).\n", (unsigned long long)phys);
+    } else {
+        printf("  - Physical address unavailable (pagemap needs CAP_SYS_ADMIN).\n");
+    }
+    aligned_free(pat);
+    aligned_free(buf);
+
+#ifndef _WIN32
+    char root[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(root) != NULL);
+    write_file(root, "devices/system/edac/mc/mc0/dimm0/dimm_label", "CPU_SrcID#0_Ha#0_Chan#0_DIMM#0\n");
+    write_file(root, "devices/system/edac/mc/mc0/dimm0/dimm_ce_count", "3\n");
+    write_file(root, "devices/system/edac/mc/mc0/dimm0/dimm_ue_count", "0\n");
+    write_file(root, "devices/system/edac/mc/mc0/dimm2/dimm_label", "\n");
+    write_file(root, "devices/system/edac/mc/mc0/dimm2/dimm_ce_count", "0\n");
+    write_file(root, "devices/system/edac/mc/mc0/dimm2/dimm_ue_count", "1\n");
+    write_file(root, "devices/system/edac/mc/mc1/dimm1/dimm_label", "DIMM_B1\n");
+    write_file(root, "devices/system/edac/mc/mc1/dimm1/dimm_ce_count", "7\n");
+    write_file(root, "devices/system/edac/mc/mc1/ce_count", "7\n");
+    verify_edac_t *e = verify_edac_read(root);
+    assert(e != NULL && e->n == 3);
+    assert(strcmp(e->dimm[0].name, "mc0/dimm0") == 0 && strcmp(e->dimm[0].label, "CPU_SrcID#0_Ha#0_Chan#0_DIMM#0") == 0);
+    assert(e->dimm[0].ce == 3 && e->dimm[0].ue == 0);
+    assert(strcmp(e->dimm[1].label, "mc0/dimm2") == 0 && e->dimm[1].ue == 1);
+    assert(strcmp(e->dimm[2].label, "DIMM_B1") == 0 && e->dimm[2].ce == 7 && e->dimm[2].ue == 0);
+    free(e);
+    printf("  - PASSED: EDAC counters are read per DIMM, labelled by slot or by controller and DIMM.\n");
+
+    char empty[] = "/tmp/hardstress-sysfs-XXXXXX";
+    assert(mkdtemp(empty) != NULL);
+    assert(verify_edac_read(empty) == NULL);
+    printf("  - PASSED: Without EDAC there is no snapshot.\n");
+    remove_tree(root);
+    remove_tree(empty);
+#else
+    assert(verify_edac_read(NULL) == NULL);
+    printf("  - PASSED: No EDAC on Windows.\n");
+#endif
+}